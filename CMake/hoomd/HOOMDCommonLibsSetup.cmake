@@ -17,9 +17,13 @@ if (UNIX AND NOT APPLE)
     endif (DL_LIB AND UTIL_LIB)
 endif (UNIX AND NOT APPLE)
 
+## std::thread requires the platform thread library
+find_package(Threads REQUIRED)
+
 set(HOOMD_COMMON_LIBS
         ${HOOMD_PYTHON_LIBRARY}
         ${ADDITIONAL_LIBS}
+        ${CMAKE_THREAD_LIBS_INIT}
         )
 
 if (ENABLE_CUDA)
@@ -38,6 +38,23 @@ else ()
 option (ENABLE_MPI "Enable the compilation of the MPI communication code" off)
 endif ()
 
+#################################
+## OpenMP related options
+option(ENABLE_OPENMP "Enable multithreaded CPU code paths using OpenMP" off)
+
+if (ENABLE_OPENMP)
+    find_package(OpenMP)
+    if (OPENMP_FOUND)
+        set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${OpenMP_C_FLAGS}")
+        set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}")
+        set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${OpenMP_CXX_FLAGS}")
+        set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} ${OpenMP_CXX_FLAGS}")
+        set(CMAKE_MODULE_LINKER_FLAGS "${CMAKE_MODULE_LINKER_FLAGS} ${OpenMP_CXX_FLAGS}")
+    else (OPENMP_FOUND)
+        message(SEND_ERROR "ENABLE_OPENMP is set, but the compiler does not support OpenMP")
+    endif (OPENMP_FOUND)
+endif (ENABLE_OPENMP)
+
 #################################
 ## Optionally enable documentation build
 OPTION(ENABLE_DOXYGEN "Enables building of documentation with doxygen" OFF)
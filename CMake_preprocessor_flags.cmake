@@ -28,6 +28,10 @@ if (ENABLE_MPI)
     endif(ENABLE_MPI_CUDA)
 endif(ENABLE_MPI)
 
+if (ENABLE_OPENMP)
+    add_definitions (-DENABLE_OPENMP)
+endif (ENABLE_OPENMP)
+
 # define Eigen should be MPL 2 only
 add_definitions(-DEIGEN_MPL2_ONLY)
 
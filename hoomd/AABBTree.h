@@ -77,6 +77,10 @@ struct AABBNode
                an update will only increase the volume of nodes. The tree should be rebuilt periodically instead of
                continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - Refit : Recompute the AABBs of all nodes from a complete set of AABBs, one for each particle, keeping the tree
+              topology. Runs in O(N) time. Unlike update(), nodes shrink as well as grow. The quality of the tree
+              degrades as particles move away from the positions the tree was built for, which can be monitored with
+              getSAHCost().
 
     **Implementation details**
 
@@ -115,6 +119,18 @@ class AABBTree
         //! Update the AABB of a particle
         inline void update(unsigned int idx, const AABB& aabb);
 
+        //! Refit the tree to a new list of AABBs
+        inline void refit(const AABB *aabbs, unsigned int N);
+
+        //! Compute the surface area heuristic cost of the tree
+        inline Scalar getSAHCost() const;
+
+        //! Get the number of particles in the tree
+        inline unsigned int getNumParticles() const
+            {
+            return m_mapping.size();
+            }
+
         //! Get the height of a given particle's leaf node
         inline unsigned int height(unsigned int idx);
 
@@ -298,6 +314,71 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle, indexed by particle
+    \param N Number of AABBs in the list, must match the number of particles the tree was built for
+
+    Recomputes the AABBs of all leaf nodes from the particles they contain, and then the AABBs of all internal nodes
+    from their children. buildNode() allocates every node before its children, so a single pass over the nodes in
+    reverse order visits all children before their parents.
+*/
+inline void AABBTree::refit(const AABB *aabbs, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    for (int node_idx = int(m_num_nodes) - 1; node_idx >= 0; node_idx--)
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (node.left == INVALID_NODE)
+            {
+            AABB my_aabb = aabbs[node.particles[0]];
+            node.particle_tags[0] = aabbs[node.particles[0]].tag;
+            for (unsigned int i = 1; i < node.num_particles; i++)
+                {
+                my_aabb = merge(my_aabb, aabbs[node.particles[i]]);
+                node.particle_tags[i] = aabbs[node.particles[i]].tag;
+                }
+            node.aabb = my_aabb;
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
+/*! \returns The surface area heuristic (SAH) cost of the tree
+
+    The SAH cost estimates the cost of a query with a randomly placed small box. It is the sum of the surface areas of
+    all internal nodes plus the surface areas of all leaf nodes weighted by the number of particles in the leaf,
+    relative to the surface area of the root node. A tight, well balanced tree has a low cost. The cost grows as
+    refit() stretches the nodes over particles that have moved apart.
+*/
+inline Scalar AABBTree::getSAHCost() const
+    {
+    if (m_num_nodes == 0)
+        return Scalar(0.0);
+
+    Scalar cost(0.0);
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        const AABBNode& node = m_nodes[node_idx];
+        vec3<Scalar> L = node.aabb.getUpper() - node.aabb.getLower();
+        Scalar area = Scalar(2.0) * (L.x*L.y + L.y*L.z + L.z*L.x);
+
+        if (node.left == INVALID_NODE)
+            cost += area * Scalar(node.num_particles);
+        else
+            cost += area;
+        }
+
+    vec3<Scalar> L = m_nodes[m_root].aabb.getUpper() - m_nodes[m_root].aabb.getLower();
+    Scalar root_area = Scalar(2.0) * (L.x*L.y + L.y*L.z + L.z*L.x);
+    if (root_area <= Scalar(0.0))
+        return Scalar(0.0);
+
+    return cost / root_area;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -53,6 +53,23 @@ union group_storage
     unsigned int idx[group_size];
     };
 
+//! Get the particle indices of all members of a group from an entry of the per-particle group table
+/*! \param entry Entry of particle \a idx in the table returned by BondedGroupData::getGPUTable()
+    \param cur_pos Position of particle \a idx in the group, from BondedGroupData::getGPUPosTable()
+    \param idx Index of the particle the entry belongs to
+    \param member_idx Set to the indices of the group members, in the order of the group definition
+
+    The table entry lists the other members in order, followed by the group type.
+*/
+template<unsigned int group_size>
+inline void get_group_members(const group_storage<group_size>& entry, unsigned int cur_pos, unsigned int idx,
+    unsigned int *member_idx)
+    {
+    unsigned int n = 0;
+    for (unsigned int j = 0; j < group_size; ++j)
+        member_idx[j] = (j == cur_pos) ? idx : entry.idx[n++];
+    }
+
 //! A union to allow storing a scalar constraint value or a type integer
 union typeval_union
     {
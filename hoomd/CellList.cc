@@ -22,7 +22,7 @@ namespace py = pybind11;
 CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     : Compute(sysdef),  m_nominal_width(Scalar(1.0)), m_radius(1), m_compute_tdb(false),
       m_compute_orientation(false), m_compute_idx(false), m_flag_charge(false), m_flag_type(false), m_sort_cell_list(false),
-      m_compute_adj_list(true)
+      m_compute_adj_list(true), m_compact(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing CellList" << endl;
 
@@ -38,6 +38,14 @@ CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     m_conditions.swap(conditions);
     resetConditions();
 
+    m_cell_size.setTag("CellList::m_cell_size");
+    m_cell_offset.setTag("CellList::m_cell_offset");
+    m_cell_adj.setTag("CellList::m_cell_adj");
+    m_xyzf.setTag("CellList::m_xyzf");
+    m_tdb.setTag("CellList::m_tdb");
+    m_orientation.setTag("CellList::m_orientation");
+    m_idx.setTag("CellList::m_idx");
+
     m_actual_width = make_scalar3(0.0,0.0,0.0);
     m_ghost_width = make_scalar3(0.0,0.0,0.0);
 
@@ -52,6 +60,22 @@ CellList::~CellList()
     m_pdata->getBoxChangeSignal().disconnect<CellList, &CellList::slotBoxChanged>(this);
     }
 
+/*! \param compact True to store the members of all cells back to back instead of in Nmax slots per cell
+
+    The compact layout is only implemented on the CPU, it is ignored when the GPU is enabled.
+*/
+void CellList::setCompact(bool compact)
+    {
+    if (compact && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "Compact cell list is not supported on the GPU, ignoring" << endl;
+        return;
+        }
+
+    m_compact = compact;
+    m_params_changed = true;
+    }
+
 //! Round down to the nearest multiple
 /*! \param v Value to ound
     \param m Multiple
@@ -295,6 +319,17 @@ void CellList::initializeMemory()
     GPUArray<unsigned int> cell_size(m_cell_indexer.getNumElements(), m_exec_conf);
     m_cell_size.swap(cell_size);
 
+    GPUArray<unsigned int> cell_offset(m_cell_indexer.getNumElements()+1, m_exec_conf);
+    m_cell_offset.swap(cell_offset);
+
+    if (!m_compact)
+        {
+        // cells start at fixed multiples of Nmax
+        ArrayHandle<unsigned int> h_cell_offset(m_cell_offset, access_location::host, access_mode::overwrite);
+        for (unsigned int cidx = 0; cidx <= m_cell_indexer.getNumElements(); cidx++)
+            h_cell_offset.data[cidx] = cidx*m_Nmax;
+        }
+
     if (m_compute_adj_list)
         {
         // if we have less than radius*2+1 cells in a direction, restrict to unique neighbors
@@ -323,12 +358,36 @@ void CellList::initializeMemory()
         m_cell_adj.swap(cell_adj);
         }
 
-    GPUArray<Scalar4> xyzf(m_cell_list_indexer.getNumElements(), m_exec_conf);
+    // the compact layout holds one element per particle (with some room for fluctuations in the ghost number)
+    if (m_compact)
+        {
+        unsigned int n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+        allocateMemberArrays(n_tot_particles + n_tot_particles/8 + 1);
+        }
+    else
+        {
+        allocateMemberArrays(m_cell_list_indexer.getNumElements());
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    // only initialize the adjacency list if requested
+    if (m_compute_adj_list)
+        initializeCellAdj();
+    }
+
+/*! \param n_members Number of elements to allocate in each per-member array
+    \post xyzf and the requested tdb, orientation and idx arrays hold \a n_members elements
+*/
+void CellList::allocateMemberArrays(unsigned int n_members)
+    {
+    GPUArray<Scalar4> xyzf(n_members, m_exec_conf);
     m_xyzf.swap(xyzf);
 
     if (m_compute_tdb)
         {
-        GPUArray<Scalar4> tdb(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GPUArray<Scalar4> tdb(n_members, m_exec_conf);
         m_tdb.swap(tdb);
         }
     else
@@ -340,7 +399,7 @@ void CellList::initializeMemory()
 
     if (m_compute_orientation)
         {
-        GPUArray<Scalar4> orientation(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GPUArray<Scalar4> orientation(n_members, m_exec_conf);
         m_orientation.swap(orientation);
         }
     else
@@ -352,7 +411,7 @@ void CellList::initializeMemory()
 
     if (m_compute_idx || m_sort_cell_list)
         {
-        GPUArray<unsigned int> idx(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GPUArray<unsigned int> idx(n_members, m_exec_conf);
         m_idx.swap(idx);
         }
     else
@@ -361,13 +420,6 @@ void CellList::initializeMemory()
         GPUArray<unsigned int> idx;
         m_idx.swap(idx);
         }
-
-    if (m_prof)
-        m_prof->pop();
-
-    // only initialize the adjacency list if requested
-    if (m_compute_adj_list)
-        initializeCellAdj();
     }
 
 void CellList::initializeCellAdj()
@@ -435,8 +487,74 @@ void CellList::initializeCellAdj()
         m_prof->pop();
     }
 
+/*! \param box Local simulation box
+    \param p Position of the particle
+    \param n Index of the particle
+    \param bin Output: index of the cell the particle belongs in
+    \param conditions Condition flags to set for particles with invalid positions
+    \returns false if the particle is not binned
+*/
+inline bool CellList::findBin(const BoxDim& box, const Scalar3& p, unsigned int n, unsigned int& bin, uint3& conditions)
+    {
+    if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+        {
+        conditions.y = n+1;
+        return false;
+        }
+
+    // find the bin each particle belongs in
+    Scalar3 f = box.makeFraction(p,m_ghost_width);
+    int ib = (int)(f.x * m_dim.x);
+    int jb = (int)(f.y * m_dim.y);
+    int kb = (int)(f.z * m_dim.z);
+
+    // check if the particle is inside the unit cell + ghost layer in all dimensions
+    if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
+        (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
+        (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
+        {
+        // if a ghost particle is out of bounds, silently ignore it
+        if (n < m_pdata->getN())
+            conditions.z = n+1;
+        return false;
+        }
+
+    // need to handle the case where the particle is exactly at the box hi
+    uchar3 periodic = box.getPeriodic();
+    if (ib == (int)m_dim.x && periodic.x)
+        ib = 0;
+    if (jb == (int)m_dim.y && periodic.y)
+        jb = 0;
+    if (kb == (int)m_dim.z && periodic.z)
+        kb = 0;
+
+    // sanity check
+    assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
+
+    // all particles should be in a valid cell
+    if (ib < 0 || ib >= (int)m_dim.x ||
+        jb < 0 || jb >= (int)m_dim.y ||
+        kb < 0 || kb >= (int)m_dim.z)
+        {
+        // but ghost particles that are out of range should not produce an error
+        if (n < m_pdata->getN())
+            conditions.z = n+1;
+        return false;
+        }
+
+    // record its bin
+    bin = m_cell_indexer(ib, jb, kb);
+    return true;
+    }
+
 void CellList::computeCellList()
     {
+    if (m_compact)
+        {
+        computeCellListCompact();
+        return;
+        }
+
     if (m_prof)
         m_prof->push("compute");
 
@@ -457,71 +575,20 @@ void CellList::computeCellList()
     uint3 conditions = make_uint3(0,0,0);
 
     // shorthand copies of the indexers
-    Index3D ci = m_cell_indexer;
     Index2D cli = m_cell_list_indexer;
 
     // clear the bin sizes to 0
     memset(h_cell_size.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
 
-    Scalar3 ghost_width = getGhostWidth();
-
-    // get periodic flags
-    uchar3 periodic = box.getPeriodic();
-
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
     for (unsigned int n = 0; n < n_tot_particles; n++)
         {
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
-            {
-            conditions.y = n+1;
+        unsigned int bin;
+        if (!findBin(box, p, n, bin, conditions))
             continue;
-            }
-
-
-        // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(p,ghost_width);
-        int ib = (int)(f.x * m_dim.x);
-        int jb = (int)(f.y * m_dim.y);
-        int kb = (int)(f.z * m_dim.z);
-
-        // check if the particle is inside the unit cell + ghost layer in all dimensions
-        if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001)) ||
-            (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001)) ||
-            (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
-            {
-            // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
-            }
-
-        // need to handle the case where the particle is exactly at the box hi
-        if (ib == (int)m_dim.x && periodic.x)
-            ib = 0;
-        if (jb == (int)m_dim.y && periodic.y)
-            jb = 0;
-        if (kb == (int)m_dim.z && periodic.z)
-            kb = 0;
-
-        // sanity check
-        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
-
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
-        // all particles should be in a valid cell
-        if (ib < 0 || ib >= (int)m_dim.x ||
-            jb < 0 || jb >= (int)m_dim.y ||
-            kb < 0 || kb >= (int)m_dim.z)
-            {
-            // but ghost particles that are out of range should not produce an error
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
-            continue;
-            }
 
         // setup the flag value to store
         Scalar flag;
@@ -572,6 +639,111 @@ void CellList::computeCellList()
         m_prof->pop();
     }
 
+/*! Builds the compact layout with a counting sort. The first pass finds the cell of every particle and counts the
+    members of each cell, the exclusive prefix sum of the counts gives the cell offsets and the second pass scatters the
+    particles to their slots. Within a cell, the members are stored in particle index order like in the padded layout.
+*/
+void CellList::computeCellListCompact()
+    {
+    if (m_prof)
+        m_prof->push("compute");
+
+    const unsigned int n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+
+    // make room for the members, with some room for fluctuations in the ghost number
+    if (m_xyzf.getNumElements() < n_tot_particles)
+        allocateMemberArrays(n_tot_particles + n_tot_particles/8 + 1);
+
+    // acquire the particle data
+    ArrayHandle< Scalar4 > h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar > h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_size(m_cell_size, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_offset(m_cell_offset, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_cell_orientation(m_orientation, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_tdb(m_tdb, access_location::host, access_mode::overwrite);
+    uint3 conditions = make_uint3(0,0,0);
+
+    const unsigned int NOT_BINNED = 0xffffffff;
+
+    // count the members of each cell
+    memset(h_cell_size.data, 0, sizeof(unsigned int) * n_cells);
+    m_particle_bin.resize(n_tot_particles);
+    for (unsigned int n = 0; n < n_tot_particles; n++)
+        {
+        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+        unsigned int bin;
+        if (!findBin(box, p, n, bin, conditions))
+            {
+            m_particle_bin[n] = NOT_BINNED;
+            continue;
+            }
+
+        m_particle_bin[n] = bin;
+        h_cell_size.data[bin]++;
+        }
+
+    // each cell starts after all members of the previous cells
+    unsigned int n_members = 0;
+    unsigned int n_max = 1;
+    for (unsigned int cidx = 0; cidx < n_cells; cidx++)
+        {
+        h_cell_offset.data[cidx] = n_members;
+        n_members += h_cell_size.data[cidx];
+        n_max = max(n_max, h_cell_size.data[cidx]);
+        }
+    h_cell_offset.data[n_cells] = n_members;
+
+    // scatter the members, counting the cell sizes up again
+    memset(h_cell_size.data, 0, sizeof(unsigned int) * n_cells);
+    for (unsigned int n = 0; n < n_tot_particles; n++)
+        {
+        unsigned int bin = m_particle_bin[n];
+        if (bin == NOT_BINNED)
+            continue;
+
+        // setup the flag value to store
+        Scalar flag;
+        if (m_flag_charge)
+            flag = h_charge.data[n];
+        else if (m_flag_type)
+            flag = h_pos.data[n].w;
+        else
+            flag = __int_as_scalar(n);
+
+        unsigned int k = h_cell_offset.data[bin] + h_cell_size.data[bin];
+        h_xyzf.data[k] = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
+        if (m_compute_tdb)
+            h_tdb.data[k] = make_scalar4(h_pos.data[n].w, h_diameter.data[n], __int_as_scalar(h_body.data[n]), Scalar(0.0));
+
+        if (m_compute_orientation)
+            h_cell_orientation.data[k] = h_orientation.data[n];
+
+        if (m_compute_idx)
+            h_cell_idx.data[k] = n;
+
+        h_cell_size.data[bin]++;
+        }
+
+    // the largest cell bounds the scratch space that consumers need per cell, there is no overflow
+    m_Nmax = n_max;
+    m_cell_list_indexer = Index2D(m_Nmax, n_cells);
+
+    // write out conditions
+    m_conditions.resetFlags(conditions);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 bool CellList::checkConditions()
     {
     bool result = false;
@@ -641,6 +813,7 @@ void CellList::printStats()
 
     m_exec_conf->msg->notice(1) << "-- Cell list stats:" << endl;
     m_exec_conf->msg->notice(1) << "Dimension: " << m_dim.x << ", " << m_dim.y << ", " << m_dim.z << "" << endl;
+    m_exec_conf->msg->notice(1) << "Layout: " << (m_compact ? "compact" : "padded") << ", Nmax: " << m_Nmax << endl;
 
     // access the number of cell members to generate stats
     ArrayHandle<unsigned int> h_cell_size(m_cell_size, access_location::host, access_mode::read);
@@ -678,6 +851,8 @@ void export_CellList(py::module& m)
         .def("setFlagCharge", &CellList::setFlagCharge)
         .def("setFlagIndex", &CellList::setFlagIndex)
         .def("setSortCellList", &CellList::setSortCellList)
+        .def("setCompact", &CellList::setCompact)
+        .def("getCompact", &CellList::getCompact)
         .def("getDim", &CellList::getDim, py::return_value_policy::reference_internal)
         .def("getNmax", &CellList::getNmax)
         .def("benchmark", &CellList::benchmark)
@@ -11,6 +11,7 @@
 #include "Compute.h"
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 /*! \file CellList.h
@@ -72,9 +73,20 @@
      - \c xyzf is Ncells x Nmax and <code>xyzf[cell_list_indexer(offset,cidx)]</code> is the data stored for particle
        \c offset in cell \c cidx (\c offset can vary from 0 to <code>cell_size[cidx]-1</code>)
      - \c tbd, idx, and orientation is structured identically to \c xyzf
+     - <code>cell_offset[cidx]</code> is the index of the first member of cell \c cidx in \c xyzf, \c tdb, \c idx and
+       \c orientation, so <code>xyzf[cell_offset[cidx] + offset]</code> is always the same element as above
      - <code>cell_adj[cell_adj_indexer(offset,cidx)]</code> is the cell index for neighboring cell \c offset to \c cidx.
        \c offset can vary from 0 to (radius*2+1)^3-1 (typically 26 with radius 1)
 
+    <b>Compact layout:</b>
+
+    With setCompact(true), the members of all cells are packed back to back in cell order (compressed sparse row
+    layout) with a counting sort: the cells are counted, \c cell_offset is their exclusive prefix sum and the members
+    are scattered in a second pass. The per-member arrays then hold one element per particle no matter how unevenly
+    the particles are distributed, and the cell list can not overflow. getCellListIndexer() is meaningless in this
+    layout, consumers must index through \c cell_offset. getNmax() is the largest cell occupancy, which is enough
+    to size per-cell scratch buffers. Only the CPU implementation supports the compact layout.
+
     <b>Parameters:</b>
      - \c width - minimum width of a cell in any x,y,z direction
      - \c radius - integer radius of cells to generate in \c cell_adj (1,2,3,4,...)
@@ -200,6 +212,9 @@ class CellList : public Compute
             m_params_changed = true;
             }
 
+        //! Select the compact (CSR) layout of the cell list
+        void setCompact(bool compact);
+
         // @}
         //! \name Get properties
         // @{
@@ -240,6 +255,12 @@ class CellList : public Compute
             return m_Nmax;
             }
 
+        //! Get whether the cell list uses the compact layout
+        bool getCompact() const
+            {
+            return m_compact;
+            }
+
         //! Get width of ghost cells
         const Scalar3 getGhostWidth() const
             {
@@ -262,6 +283,12 @@ class CellList : public Compute
             return m_cell_size;
             }
 
+        //! Get the index of the first member of each cell in the per-member arrays
+        const GPUArray<unsigned int>& getCellOffsetArray() const
+            {
+            return m_cell_offset;
+            }
+
         //! Get the adjacency list
         const GPUArray<unsigned int>& getCellAdjArray() const
             {
@@ -347,6 +374,7 @@ class CellList : public Compute
 
         // values computed by compute()
         GPUArray<unsigned int> m_cell_size;  //!< Number of members in each cell
+        GPUArray<unsigned int> m_cell_offset; //!< Index of the first member of each cell (Ncells+1 elements)
         GPUArray<unsigned int> m_cell_adj;   //!< Cell adjacency list
         GPUArray<Scalar4> m_xyzf;            //!< Cell list with position and flags
         GPUArray<Scalar4> m_tdb;             //!< Cell list with type,diameter,body
@@ -356,6 +384,8 @@ class CellList : public Compute
 
         bool m_sort_cell_list;               //!< If true, sort cell list
         bool m_compute_adj_list;            //!< If true, compute the cell adjacency lists
+        bool m_compact;                      //!< If true, use the compact (CSR) layout
+        std::vector<unsigned int> m_particle_bin; //!< Cell of each particle during the compact build
 
         //! Computes what the dimensions should me
         uint3 computeDimensions();
@@ -375,6 +405,15 @@ class CellList : public Compute
         //! Compute the cell list
         virtual void computeCellList();
 
+        //! Compute the cell list in the compact layout
+        void computeCellListCompact();
+
+        //! Allocate the per-member arrays with room for the given number of members
+        void allocateMemberArrays(unsigned int n_members);
+
+        //! Find the cell of a particle
+        bool findBin(const BoxDim& box, const Scalar3& p, unsigned int n, unsigned int& bin, uint3& conditions);
+
         //! Check the status of the conditions
         bool checkConditions();
 
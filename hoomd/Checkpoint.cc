@@ -0,0 +1,627 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file Checkpoint.cc
+    \brief Defines the CheckpointWriter and CheckpointReader classes
+*/
+
+#include "Checkpoint.h"
+#include "SnapshotSystemData.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <stdio.h>
+#include <string.h>
+
+namespace py = pybind11;
+
+using namespace std;
+
+//! Identifies a checkpoint file
+static const char checkpoint_magic[8] = {'H', 'O', 'O', 'M', 'D', 'C', 'K', 'P'};
+
+//! Version of the checkpoint format
+static const unsigned int checkpoint_version = 1;
+
+//! Get the number of ranks in the partition
+static unsigned int get_n_ranks(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    #ifdef ENABLE_MPI
+    return exec_conf->getNRanks();
+    #else
+    return 1;
+    #endif
+    }
+
+//! Write the first N elements of a GPUArray
+template<class T>
+static void write_array(std::ostream& out, const GPUArray<T>& array, unsigned int N, unsigned int n_rows=1)
+    {
+    ArrayHandle<T> h_array(array, access_location::host, access_mode::read);
+    for (unsigned int row = 0; row < n_rows; row++)
+        out.write(reinterpret_cast<const char *>(h_array.data + row*array.getPitch()), sizeof(T)*N);
+    }
+
+//! Read N elements into a vector
+template<class T>
+static void read_array(std::istream& in, std::vector<T>& v, unsigned int N)
+    {
+    v.resize(N);
+    if (N > 0)
+        in.read(reinterpret_cast<char *>(&v[0]), sizeof(T)*N);
+    }
+
+//! Copy a vector to the first elements of a GPUArray
+template<class T>
+static void copy_to_array(const std::vector<T>& v, const GPUArray<T>& array, unsigned int N, unsigned int n_rows=1)
+    {
+    ArrayHandle<T> h_array(array, access_location::host, access_mode::readwrite);
+    for (unsigned int row = 0; row < n_rows; row++)
+        std::copy(v.begin() + row*N, v.begin() + (row+1)*N, h_array.data + row*array.getPitch());
+    }
+
+/*! \param sysdef System to write
+    \param fname Base file name
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname)
+    : Analyzer(sysdef), m_fname(fname)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << fname << endl;
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << endl;
+    }
+
+/*! \param fname Base file name
+    \param exec_conf Execution configuration
+    \returns \a fname in a single rank simulation, "<fname>.<rank>" otherwise
+*/
+std::string CheckpointWriter::getRankFileName(const std::string& fname,
+                                              std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    if (get_n_ranks(exec_conf) == 1)
+        return fname;
+
+    ostringstream s;
+    s << fname << "." << exec_conf->getRank();
+    return s.str();
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Every rank writes its local particles to "<file>.tmp", where <file> is the name of its file. With a single rank,
+    renaming the file completes the checkpoint. With several ranks, the files are only renamed once all ranks have
+    written them: rank 0 then creates the marker "<fname>.commit", all ranks rename their files, and rank 0 removes
+    the marker again. The previous checkpoint is untouched until the marker exists, and CheckpointReader completes
+    the renames when the marker is found, so an interrupted write never leaves files of different time steps.
+*/
+void CheckpointWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("Checkpoint");
+
+    const string fname = getRankFileName(m_fname, m_exec_conf);
+    const string tmp_fname = fname + ".tmp";
+    unsigned int ok = writeFile(tmp_fname, timestep) ? 1 : 0;
+
+    #ifdef ENABLE_MPI
+    if (get_n_ranks(m_exec_conf) > 1)
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_UNSIGNED, MPI_MIN, mpi_comm);
+        if (!ok)
+            {
+            m_exec_conf->msg->error() << "dump.checkpoint: Not all ranks wrote their file, "
+                                      << "keeping the previous checkpoint" << endl;
+            throw runtime_error("Error writing checkpoint");
+            }
+
+        // all files are complete, commit them
+        const string marker_fname = m_fname + ".commit";
+        if (m_exec_conf->isRoot())
+            {
+            const string marker_tmp_fname = marker_fname + ".tmp";
+            ofstream marker(marker_tmp_fname.c_str(), ios::out | ios::trunc);
+            marker << timestep << endl;
+            marker.close();
+            ok = (!marker.fail() && rename(marker_tmp_fname.c_str(), marker_fname.c_str()) == 0) ? 1 : 0;
+            }
+        MPI_Bcast(&ok, 1, MPI_UNSIGNED, 0, mpi_comm);
+        if (!ok)
+            {
+            m_exec_conf->msg->error() << "dump.checkpoint: Unable to write " << marker_fname
+                                      << ", keeping the previous checkpoint" << endl;
+            throw runtime_error("Error writing checkpoint");
+            }
+
+        ok = (rename(tmp_fname.c_str(), fname.c_str()) == 0) ? 1 : 0;
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_UNSIGNED, MPI_MIN, mpi_comm);
+        if (!ok)
+            {
+            m_exec_conf->msg->error() << "dump.checkpoint: Unable to rename the files of all ranks, "
+                                      << marker_fname << " is kept to complete the checkpoint" << endl;
+            throw runtime_error("Error writing checkpoint");
+            }
+
+        if (m_exec_conf->isRoot())
+            remove(marker_fname.c_str());
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    if (!ok)
+        throw runtime_error("Error writing checkpoint");
+
+    if (rename(tmp_fname.c_str(), fname.c_str()) != 0)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Unable to rename " << tmp_fname << " to " << fname << endl;
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param tmp_fname File to write
+    \param timestep Current time step of the simulation
+    \returns true on success, false (after printing an error) otherwise
+*/
+bool CheckpointWriter::writeFile(const std::string& tmp_fname, unsigned int timestep)
+    {
+    ofstream out(tmp_fname.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!out.good())
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Unable to open file " << tmp_fname << endl;
+        return false;
+        }
+
+    // header
+    const unsigned int N = m_pdata->getN();
+    out.write(checkpoint_magic, sizeof(checkpoint_magic));
+    checkpoint_write(out, checkpoint_version);
+    checkpoint_write(out, (unsigned int)sizeof(Scalar));
+    checkpoint_write(out, get_n_ranks(m_exec_conf));
+    checkpoint_write(out, timestep);
+    checkpoint_write(out, m_pdata->getNGlobal());
+    checkpoint_write(out, N);
+
+    checkpoint_write(out, m_pdata->getNTypes());
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+        checkpoint_write_string(out, m_pdata->getNameByType(i));
+
+    checkpoint_write(out, m_pdata->getGlobalBox());
+
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        vector<Scalar> cum_frac;
+        #ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            cum_frac = m_pdata->getDomainDecomposition()->getCumulativeFractions(dir);
+        #endif
+        checkpoint_write_vector(out, cum_frac);
+        }
+
+    // local particles in memory order
+    write_array(out, m_pdata->getPositions(), N);
+    write_array(out, m_pdata->getVelocities(), N);
+    write_array(out, m_pdata->getAccelerations(), N);
+    write_array(out, m_pdata->getCharges(), N);
+    write_array(out, m_pdata->getDiameters(), N);
+    write_array(out, m_pdata->getImages(), N);
+    write_array(out, m_pdata->getTags(), N);
+    write_array(out, m_pdata->getBodies(), N);
+    write_array(out, m_pdata->getOrientationArray(), N);
+    write_array(out, m_pdata->getAngularMomentumArray(), N);
+    write_array(out, m_pdata->getMomentsOfInertiaArray(), N);
+    write_array(out, m_pdata->getNetForce(), N);
+    write_array(out, m_pdata->getNetTorqueArray(), N);
+    write_array(out, m_pdata->getNetVirial(), N, 6);
+
+    // integrator variables
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    checkpoint_write(out, integrator_data->getNumIntegrators());
+    for (unsigned int i = 0; i < integrator_data->getNumIntegrators(); i++)
+        {
+        const IntegratorVariables& v = integrator_data->getIntegratorVariables(i);
+        checkpoint_write_string(out, v.type);
+        checkpoint_write_vector(out, v.variable);
+        }
+
+    // additional state of the integrator
+    ostringstream integrator_state;
+    if (m_integrator)
+        m_integrator->writeCheckpoint(integrator_state);
+    checkpoint_write_string(out, integrator_state.str());
+
+    out.close();
+    if (out.fail())
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Error writing file " << tmp_fname << endl;
+        return false;
+        }
+
+    return true;
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname Base file name passed to CheckpointWriter
+
+    All ranks read their files. The read fails on all ranks if one of the files cannot be read, or if the files are
+    from different time steps or systems.
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname)
+    : m_exec_conf(exec_conf), m_fname(CheckpointWriter::getRankFileName(fname, exec_conf)), m_timestep(0),
+      m_n_global(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointReader: " << m_fname << endl;
+
+    completeCommit(m_exec_conf, fname);
+
+    unsigned int ok = readFile() ? 1 : 0;
+
+    #ifdef ENABLE_MPI
+    if (get_n_ranks(m_exec_conf) > 1)
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_UNSIGNED, MPI_MIN, mpi_comm);
+        if (!ok)
+            {
+            m_exec_conf->msg->error() << "init.read_gsd: Not all ranks could read their checkpoint file" << endl;
+            throw runtime_error("Error reading checkpoint");
+            }
+
+        // every rank must have read a file of the same checkpoint
+        unsigned int values[2] = {m_timestep, m_n_global};
+        unsigned int min_values[2];
+        unsigned int max_values[2];
+        MPI_Allreduce(values, min_values, 2, MPI_UNSIGNED, MPI_MIN, mpi_comm);
+        MPI_Allreduce(values, max_values, 2, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+        if (min_values[0] != max_values[0])
+            {
+            m_exec_conf->msg->error() << "init.read_gsd: The checkpoint files of the ranks are from different time "
+                                      << "steps (" << min_values[0] << " to " << max_values[0] << ")" << endl;
+            throw runtime_error("Error reading checkpoint");
+            }
+        if (min_values[1] != max_values[1])
+            {
+            m_exec_conf->msg->error() << "init.read_gsd: The checkpoint files of the ranks are from systems with "
+                                      << "different numbers of particles" << endl;
+            throw runtime_error("Error reading checkpoint");
+            }
+        }
+    #endif
+
+    if (!ok)
+        throw runtime_error("Error reading checkpoint");
+    }
+
+/*! \returns true on success, false (after printing an error) otherwise
+*/
+bool CheckpointReader::readFile()
+    {
+    ifstream in(m_fname.c_str(), ios::in | ios::binary);
+    if (!in.good())
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: Unable to open file " << m_fname << endl;
+        return false;
+        }
+
+    char magic[sizeof(checkpoint_magic)];
+    unsigned int version = 0;
+    unsigned int scalar_size = 0;
+    unsigned int n_ranks = 0;
+    in.read(magic, sizeof(magic));
+    checkpoint_read(in, version);
+    checkpoint_read(in, scalar_size);
+    checkpoint_read(in, n_ranks);
+    if (!in.good() || memcmp(magic, checkpoint_magic, sizeof(magic)) != 0 || version != checkpoint_version)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << m_fname << " is not a checkpoint file" << endl;
+        return false;
+        }
+    if (scalar_size != sizeof(Scalar))
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << m_fname << " was written by a "
+                                  << ((scalar_size == sizeof(double)) ? "double" : "single")
+                                  << " precision build" << endl;
+        return false;
+        }
+    if (n_ranks != get_n_ranks(m_exec_conf))
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << m_fname << " was written by " << n_ranks
+                                  << " ranks, restarts must use the same number of ranks" << endl;
+        return false;
+        }
+
+    unsigned int N = 0;
+    unsigned int n_types = 0;
+    checkpoint_read(in, m_timestep);
+    checkpoint_read(in, m_n_global);
+    checkpoint_read(in, N);
+    checkpoint_read(in, n_types);
+    m_type_mapping.resize(n_types);
+    for (unsigned int i = 0; i < n_types; i++)
+        checkpoint_read_string(in, m_type_mapping[i]);
+    checkpoint_read(in, m_global_box);
+    for (unsigned int dir = 0; dir < 3; dir++)
+        checkpoint_read_vector(in, m_cum_frac[dir]);
+
+    read_array(in, m_pos, N);
+    read_array(in, m_vel, N);
+    read_array(in, m_accel, N);
+    read_array(in, m_charge, N);
+    read_array(in, m_diameter, N);
+    read_array(in, m_image, N);
+    read_array(in, m_tag, N);
+    read_array(in, m_body, N);
+    read_array(in, m_orientation, N);
+    read_array(in, m_angmom, N);
+    read_array(in, m_inertia, N);
+    read_array(in, m_net_force, N);
+    read_array(in, m_net_torque, N);
+    read_array(in, m_net_virial, 6*N);
+
+    unsigned int n_integrators = 0;
+    checkpoint_read(in, n_integrators);
+    m_integrator_variables.resize(n_integrators);
+    for (unsigned int i = 0; i < n_integrators; i++)
+        {
+        checkpoint_read_string(in, m_integrator_variables[i].type);
+        checkpoint_read_vector(in, m_integrator_variables[i].variable);
+        }
+
+    checkpoint_read_string(in, m_integrator_state);
+
+    if (!in.good())
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << m_fname << " is truncated" << endl;
+        return false;
+        }
+
+    return true;
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname Base file name passed to CheckpointWriter
+
+    The marker "<fname>.commit" exists only while CheckpointWriter renames the files of a complete checkpoint. When
+    it is found, the write was interrupted after all ranks wrote their temporary files, and the renames are completed
+    here before the files are read.
+*/
+void CheckpointReader::completeCommit(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                      const std::string& fname)
+    {
+    #ifdef ENABLE_MPI
+    if (get_n_ranks(exec_conf) == 1)
+        return;
+
+    MPI_Comm mpi_comm = exec_conf->getMPICommunicator();
+    const string marker_fname = fname + ".commit";
+    unsigned int committed = 0;
+    if (exec_conf->isRoot())
+        committed = ifstream(marker_fname.c_str()).good() ? 1 : 0;
+    MPI_Bcast(&committed, 1, MPI_UNSIGNED, 0, mpi_comm);
+    if (!committed)
+        return;
+
+    exec_conf->msg->notice(2) << "init.read_gsd: Completing the interrupted checkpoint " << fname << endl;
+
+    // ranks that already renamed their file have no temporary file left
+    const string rank_fname = CheckpointWriter::getRankFileName(fname, exec_conf);
+    const string tmp_fname = rank_fname + ".tmp";
+    unsigned int ok = 1;
+    if (ifstream(tmp_fname.c_str()).good())
+        ok = (rename(tmp_fname.c_str(), rank_fname.c_str()) == 0) ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_UNSIGNED, MPI_MIN, mpi_comm);
+    if (!ok)
+        {
+        exec_conf->msg->error() << "init.read_gsd: Unable to complete the checkpoint " << fname << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    if (exec_conf->isRoot())
+        remove(marker_fname.c_str());
+    #endif
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname Base file name passed to CheckpointWriter
+    \returns true if the files of all ranks exist, so that all ranks agree on restoring
+
+    An interrupted checkpoint write is completed first (see completeCommit()).
+*/
+bool CheckpointReader::exists(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname)
+    {
+    completeCommit(exec_conf, fname);
+
+    ifstream in(CheckpointWriter::getRankFileName(fname, exec_conf).c_str(), ios::in | ios::binary);
+    unsigned int found = in.good() ? 1 : 0;
+
+    #ifdef ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_UNSIGNED, MPI_MIN, exec_conf->getMPICommunicator());
+    #endif
+
+    return found != 0;
+    }
+
+/*! \param sysdef System to restore
+
+    The system must have the same number of particles and the same types as the checkpoint.
+*/
+void CheckpointReader::restoreSystem(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    if (pdata->getNGlobal() != m_n_global)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: The checkpoint has " << m_n_global
+                                  << " particles, the system has " << pdata->getNGlobal() << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    bool types_match = (pdata->getNTypes() == m_type_mapping.size());
+    for (unsigned int i = 0; types_match && i < m_type_mapping.size(); i++)
+        types_match = (pdata->getNameByType(i) == m_type_mapping[i]);
+    if (!types_match)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: The particle types of the checkpoint and the system differ"
+                                  << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    #ifdef ENABLE_MPI
+    // the local particles only match with the same domain boundaries
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            if (decomposition->getCumulativeFractions(dir).size() != m_cum_frac[dir].size())
+                {
+                m_exec_conf->msg->error() << "init.read_gsd: The checkpoint was written with a different "
+                                          << "processor grid" << endl;
+                throw runtime_error("Error reading checkpoint");
+                }
+            decomposition->setCumulativeFractions(dir, m_cum_frac[dir], 0);
+            }
+        }
+    #endif
+
+    pdata->setGlobalBox(m_global_box);
+
+    #ifdef ENABLE_MPI
+    // the bonded groups of each rank follow the local particles, distribute them again after the particles moved
+    std::shared_ptr< SnapshotSystemData<Scalar> > bonded;
+    if (decomposition)
+        bonded = sysdef->takeSnapshot<Scalar>(false, true, true, true, true, true, false);
+    #endif
+
+    restoreParticles(pdata);
+
+    #ifdef ENABLE_MPI
+    if (bonded)
+        sysdef->initializeFromSnapshot(bonded);
+    #endif
+
+    // integrators read their variables when they register
+    std::shared_ptr<IntegratorData> integrator_data = sysdef->getIntegratorData();
+    integrator_data->load(m_integrator_variables.size());
+    for (unsigned int i = 0; i < m_integrator_variables.size(); i++)
+        integrator_data->setIntegratorVariables(i, m_integrator_variables[i]);
+    }
+
+/*! \param pdata Particle data to restore
+
+    Without domain decomposition, all particles are local and are overwritten in place. With domain decomposition,
+    each rank removes its current particles and adds the ones of its file, so every tag ends up on exactly one rank.
+*/
+void CheckpointReader::restoreParticles(std::shared_ptr<ParticleData> pdata)
+    {
+    const unsigned int N = m_pos.size();
+
+    #ifdef ENABLE_MPI
+    if (pdata->getDomainDecomposition())
+        {
+        pdata->removeAllGhostParticles();
+
+            {
+            ArrayHandle<unsigned int> h_comm_flags(pdata->getCommFlags(), access_location::host, access_mode::overwrite);
+            std::fill(h_comm_flags.data, h_comm_flags.data + pdata->getN(), 1);
+            }
+
+        std::vector<pdata_element> removed;
+        std::vector<unsigned int> comm_flags;
+        pdata->removeParticles(removed, comm_flags);
+
+        std::vector<pdata_element> in(N);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            in[i].pos = m_pos[i];
+            in[i].vel = m_vel[i];
+            in[i].accel = m_accel[i];
+            in[i].charge = m_charge[i];
+            in[i].diameter = m_diameter[i];
+            in[i].image = m_image[i];
+            in[i].body = m_body[i];
+            in[i].orientation = m_orientation[i];
+            in[i].angmom = m_angmom[i];
+            in[i].inertia = m_inertia[i];
+            in[i].tag = m_tag[i];
+            }
+        pdata->addParticles(in);
+        }
+    else
+    #endif
+        {
+        if (pdata->getN() != N)
+            {
+            m_exec_conf->msg->error() << "init.read_gsd: The checkpoint has " << N
+                                      << " local particles, the system has " << pdata->getN() << endl;
+            throw runtime_error("Error reading checkpoint");
+            }
+
+        copy_to_array(m_pos, pdata->getPositions(), N);
+        copy_to_array(m_vel, pdata->getVelocities(), N);
+        copy_to_array(m_accel, pdata->getAccelerations(), N);
+        copy_to_array(m_charge, pdata->getCharges(), N);
+        copy_to_array(m_diameter, pdata->getDiameters(), N);
+        copy_to_array(m_image, pdata->getImages(), N);
+        copy_to_array(m_tag, pdata->getTags(), N);
+        copy_to_array(m_body, pdata->getBodies(), N);
+        copy_to_array(m_orientation, pdata->getOrientationArray(), N);
+        copy_to_array(m_angmom, pdata->getAngularMomentumArray(), N);
+        copy_to_array(m_inertia, pdata->getMomentsOfInertiaArray(), N);
+
+            {
+            ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::readwrite);
+            for (unsigned int i = 0; i < N; i++)
+                h_rtag.data[m_tag[i]] = i;
+            }
+
+        pdata->notifyParticleSort();
+        }
+
+    assert(pdata->getN() == N);
+    copy_to_array(m_net_force, pdata->getNetForce(), N);
+    copy_to_array(m_net_torque, pdata->getNetTorqueArray(), N);
+    copy_to_array(m_net_virial, pdata->getNetVirial(), N, 6);
+    }
+
+/*! \param integrator Integrator to restore, it must be set up like the integrator that wrote the checkpoint
+*/
+void CheckpointReader::restoreIntegrator(std::shared_ptr<Integrator> integrator)
+    {
+    if (m_integrator_state.empty())
+        return;
+
+    istringstream in(m_integrator_state);
+    integrator->readCheckpoint(in);
+    if (in.fail())
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: The integrator does not match the one that wrote "
+                                  << m_fname << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+    }
+
+void export_Checkpoint(py::module& m)
+    {
+    py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter> >(m,"CheckpointWriter",py::base<Analyzer>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, const std::string& >())
+    .def("setIntegrator", &CheckpointWriter::setIntegrator)
+    ;
+
+    py::class_<CheckpointReader, std::shared_ptr<CheckpointReader> >(m,"CheckpointReader")
+    .def(py::init< std::shared_ptr<const ExecutionConfiguration>, const std::string& >())
+    .def("getTimeStep", &CheckpointReader::getTimeStep)
+    .def_static("exists", &CheckpointReader::exists)
+    .def("restoreSystem", &CheckpointReader::restoreSystem)
+    .def("restoreIntegrator", &CheckpointReader::restoreIntegrator)
+    ;
+    }
@@ -0,0 +1,197 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file Checkpoint.h
+    \brief Declares the CheckpointWriter and CheckpointReader classes
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_H__
+#define __CHECKPOINT_H__
+
+#include "Analyzer.h"
+#include "Integrator.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Write a plain value to a binary checkpoint stream
+template<class T>
+inline void checkpoint_write(std::ostream& out, const T& value)
+    {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+//! Read a plain value from a binary checkpoint stream
+template<class T>
+inline void checkpoint_read(std::istream& in, T& value)
+    {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    }
+
+//! Write a vector of plain values, preceded by its length
+template<class T>
+inline void checkpoint_write_vector(std::ostream& out, const std::vector<T>& v)
+    {
+    unsigned int n = v.size();
+    checkpoint_write(out, n);
+    if (n > 0)
+        out.write(reinterpret_cast<const char *>(&v[0]), sizeof(T)*n);
+    }
+
+//! Read a vector written by checkpoint_write_vector()
+template<class T>
+inline void checkpoint_read_vector(std::istream& in, std::vector<T>& v)
+    {
+    unsigned int n = 0;
+    checkpoint_read(in, n);
+    if (!in.good())
+        return;
+    v.resize(n);
+    if (n > 0)
+        in.read(reinterpret_cast<char *>(&v[0]), sizeof(T)*n);
+    }
+
+//! Write a string, preceded by its length
+inline void checkpoint_write_string(std::ostream& out, const std::string& s)
+    {
+    std::vector<char> v(s.begin(), s.end());
+    checkpoint_write_vector(out, v);
+    }
+
+//! Read a string written by checkpoint_write_string()
+inline void checkpoint_read_string(std::istream& in, std::string& s)
+    {
+    std::vector<char> v;
+    checkpoint_read_vector(in, v);
+    s.assign(v.begin(), v.end());
+    }
+
+//! Writes binary checkpoints for exact restarts
+/*! A checkpoint stores the state of the local particles of each rank exactly as it is in memory: in the precision
+    of the build (Scalar), in the current index order, and including the accelerations and net forces. It also stores
+    the box, the domain decomposition, all integrator variables in IntegratorData, and the additional state of the
+    integrator set with setIntegrator() (Integrator::writeCheckpoint()). The time step is stored as well, and the
+    random number streams of HOOMD are seeded with it, so a simulation restored with CheckpointReader continues
+    exactly like a simulation that ends its run() at the same step and starts a new one.
+
+    Every rank writes its own file: the file name is used as is in a single rank simulation and extended with
+    ".<rank>" otherwise. A file is first written to "<name>.tmp" and then renamed, so an interrupted write never
+    destroys the previous checkpoint. With several ranks, the renames are committed together (see analyze()), so
+    the files of all ranks always belong to the same checkpoint.
+
+    The bonded topology and the parameters of the forces and integration methods are not stored. They are set up
+    again by the job script, and the checkpoint is restored on top of them.
+
+    \ingroup analyzers
+*/
+class CheckpointWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname);
+
+        //! Destructor
+        virtual ~CheckpointWriter();
+
+        //! Write a checkpoint
+        virtual void analyze(unsigned int timestep);
+
+        //! Set the integrator whose additional state is stored
+        void setIntegrator(std::shared_ptr<Integrator> integrator)
+            {
+            m_integrator = integrator;
+            }
+
+        //! Get the name of the file written by this rank
+        static std::string getRankFileName(const std::string& fname, std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+    private:
+        std::string m_fname;                        //!< Base file name
+        std::shared_ptr<Integrator> m_integrator;   //!< Integrator to store the state of (may be NULL)
+
+        //! Write the file of this rank
+        bool writeFile(const std::string& tmp_fname, unsigned int timestep);
+    };
+
+//! Restores the state written by CheckpointWriter
+/*! The constructor reads the file of this rank and checks that the files of all ranks are from the same time step
+    and system. restoreSystem() then overwrites the particles, box, domain
+    decomposition, and integrator variables of a system that has been initialized with the same particles, types, and
+    number of ranks. It should be called right after initialization, before any integrator registers with
+    IntegratorData. restoreIntegrator() restores the additional integrator state once the integrator has been set up.
+
+    \ingroup data_structs
+*/
+class CheckpointReader
+    {
+    public:
+        //! Read the checkpoint file of this rank
+        CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname);
+
+        //! Test if the checkpoint files of all ranks exist
+        static bool exists(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname);
+
+        //! Get the time step at which the checkpoint was written
+        unsigned int getTimeStep() const
+            {
+            return m_timestep;
+            }
+
+        //! Restore the particles, box, domain decomposition, and integrator variables
+        void restoreSystem(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Restore the additional state of the integrator
+        void restoreIntegrator(std::shared_ptr<Integrator> integrator);
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf;  //!< The execution configuration
+        std::string m_fname;                        //!< Name of the file of this rank
+
+        unsigned int m_timestep;                    //!< Time step of the checkpoint
+        unsigned int m_n_global;                    //!< Global number of particles
+        std::vector<std::string> m_type_mapping;    //!< Type names
+        BoxDim m_global_box;                        //!< Global box
+        std::vector<Scalar> m_cum_frac[3];          //!< Cumulative domain fractions (empty without decomposition)
+
+        std::vector<Scalar4> m_pos;                 //!< Positions and types of the local particles
+        std::vector<Scalar4> m_vel;                 //!< Velocities and masses
+        std::vector<Scalar3> m_accel;               //!< Accelerations
+        std::vector<Scalar> m_charge;               //!< Charges
+        std::vector<Scalar> m_diameter;             //!< Diameters
+        std::vector<int3> m_image;                  //!< Images
+        std::vector<unsigned int> m_tag;            //!< Tags
+        std::vector<unsigned int> m_body;           //!< Body ids
+        std::vector<Scalar4> m_orientation;         //!< Orientations
+        std::vector<Scalar4> m_angmom;              //!< Angular momenta
+        std::vector<Scalar3> m_inertia;             //!< Moments of inertia
+        std::vector<Scalar4> m_net_force;           //!< Net forces
+        std::vector<Scalar4> m_net_torque;          //!< Net torques
+        std::vector<Scalar> m_net_virial;           //!< Net virials (6 rows of N)
+
+        std::vector<IntegratorVariables> m_integrator_variables;   //!< Contents of IntegratorData
+        std::string m_integrator_state;                             //!< State written by Integrator::writeCheckpoint()
+
+        //! Read the file of this rank
+        bool readFile();
+
+        //! Restore the local particles in the stored order
+        void restoreParticles(std::shared_ptr<ParticleData> pdata);
+
+        //! Complete the renames of a checkpoint write that was interrupted after all files were written
+        static void completeCommit(std::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string& fname);
+    };
+
+//! Exports CheckpointWriter and CheckpointReader to python
+void export_Checkpoint(pybind11::module& m);
+
+#endif
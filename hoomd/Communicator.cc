@@ -1095,16 +1095,34 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         m_is_at_boundary[dir] = m_decomposition->isAtBoundary(dir) ? 1 : 0;
+        m_ghost_update_pending[dir] = false;
+        m_ghost_update_start[dir] = 0;
         }
 
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         GPUVector<unsigned int> copy_ghosts(m_exec_conf);
         m_copy_ghosts[dir].swap(copy_ghosts);
+        m_copy_ghosts[dir].setTag("Communicator::m_copy_ghosts");
         m_num_copy_ghosts[dir] = 0;
         m_num_recv_ghosts[dir] = 0;
         }
 
+    m_pos_copybuf.setTag("Communicator::m_pos_copybuf");
+    m_charge_copybuf.setTag("Communicator::m_charge_copybuf");
+    m_diameter_copybuf.setTag("Communicator::m_diameter_copybuf");
+    m_body_copybuf.setTag("Communicator::m_body_copybuf");
+    m_image_copybuf.setTag("Communicator::m_image_copybuf");
+    m_velocity_copybuf.setTag("Communicator::m_velocity_copybuf");
+    m_orientation_copybuf.setTag("Communicator::m_orientation_copybuf");
+    m_plan_copybuf.setTag("Communicator::m_plan_copybuf");
+    m_tag_copybuf.setTag("Communicator::m_tag_copybuf");
+    m_netforce_copybuf.setTag("Communicator::m_netforce_copybuf");
+    m_nettorque_copybuf.setTag("Communicator::m_nettorque_copybuf");
+    m_netvirial_copybuf.setTag("Communicator::m_netvirial_copybuf");
+    m_netvirial_recvbuf.setTag("Communicator::m_netvirial_recvbuf");
+    m_plan.setTag("Communicator::m_plan");
+
     // connect to particle sort signal
     m_pdata->getParticleSortSignal().connect<Communicator, &Communicator::forceMigrate>(this);
 
@@ -1278,24 +1296,45 @@ void Communicator::communicate(unsigned int timestep)
 
     bool has_ghost_particles = !(m_force_migrate || m_is_first_step);
 
+    // distance check (synchronizes the GPU execution stream), needs to be called
+    // before any particle reorder
+    bool migrate_request = false;
+    bool distance_checked = false;
+
     if (!m_compute_callbacks.empty() && has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
         beginUpdateGhosts(timestep);
+
+        // the distance check only reads local particles, so with local compute subscribers it is done while the
+        // ghost update is in flight, and the local computations overlap with it on steps without migration
+        if (!m_local_compute_callbacks.empty())
+            {
+            m_migrate_requests.emit_accumulate( [&](bool r)
+                                                    {
+                                                    migrate_request = migrate_request || r;
+                                                    },
+                                                timestep);
+            distance_checked = true;
+
+            if (!migrate_request)
+                m_local_compute_callbacks.emit(timestep);
+            }
+
         finishUpdateGhosts(timestep);
 
         // call subscribers after ghost update, but before distance check
         m_compute_callbacks.emit(timestep);
         }
 
-    // distance check (synchronizes the GPU execution stream), needs to be called
-    // before any particle reorder
-    bool migrate_request = false;
-    m_migrate_requests.emit_accumulate( [&](bool r)
-                                            {
-                                            migrate_request = migrate_request || r;
-                                            },
-                                        timestep);
+    if (!distance_checked)
+        {
+        m_migrate_requests.emit_accumulate( [&](bool r)
+                                                {
+                                                migrate_request = migrate_request || r;
+                                                },
+                                            timestep);
+        }
 
     bool migrate = migrate_request || !has_ghost_particles;
 
@@ -1304,6 +1343,9 @@ void Communicator::communicate(unsigned int timestep)
         {
         beginUpdateGhosts(timestep);
 
+        // overlap computations on local particles with the ghost update in flight
+        m_local_compute_callbacks.emit(timestep);
+
         finishUpdateGhosts(timestep);
         }
 
@@ -2005,10 +2047,21 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
+    // if local computations are waiting to overlap with the update, leave the last dimension in flight
+    int overlap_dim = -1;
+    if (!m_local_compute_callbacks.empty())
+        {
+        for (unsigned int dir = 0; dir < 6; dir++)
+            if (isCommunicating(dir))
+                overlap_dim = dir/2;
+        }
+
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (! isCommunicating(dir) ) continue;
 
+        if ((int)(dir/2) == overlap_dim) continue;
+
         CommFlags flags = getFlags();
 
         if (flags[comm_flag::position])
@@ -2161,10 +2214,142 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
         } // end dir loop
 
+    if (overlap_dim >= 0)
+        {
+        CommFlags flags = getFlags();
+
+        // only non-permanent fields (position, velocity, orientation) need to be considered here
+        const GPUArray<Scalar4> *fields[3] = {&m_pdata->getPositions(),
+                                              &m_pdata->getVelocities(),
+                                              &m_pdata->getOrientationArray()};
+        const bool send_field[3] = {flags[comm_flag::position],
+                                    flags[comm_flag::velocity],
+                                    flags[comm_flag::orientation]};
+
+        // size the send buffer up front, it must not be reallocated while the messages are in flight
+        unsigned int n_send = 0;
+        for (unsigned int dir = 2*overlap_dim; dir < 2*(unsigned int)overlap_dim+2; dir++)
+            {
+            if (! isCommunicating(dir) ) continue;
+
+            for (unsigned int f = 0; f < 3; f++)
+                if (send_field[f])
+                    n_send += m_num_copy_ghosts[dir];
+            }
+        m_ghost_update_sendbuf.resize(n_send);
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        m_reqs.clear();
+        unsigned int offset = 0;
+        for (unsigned int dir = 2*overlap_dim; dir < 2*(unsigned int)overlap_dim+2; dir++)
+            {
+            if (! isCommunicating(dir) ) continue;
+
+            unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+            // we receive from the direction opposite to the one we send to
+            unsigned int recv_neighbor;
+            if (dir % 2 == 0)
+                recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+            else
+                recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+            unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+            num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+            m_ghost_update_pending[dir] = true;
+            m_ghost_update_start[dir] = start_idx;
+
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+            for (unsigned int f = 0; f < 3; f++)
+                {
+                if (! send_field[f]) continue;
+
+                ArrayHandle<Scalar4> h_field(*fields[f], access_location::host, access_mode::readwrite);
+                Scalar4 *sendbuf = m_ghost_update_sendbuf.data() + offset;
+
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                    {
+                    unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                    assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    sendbuf[ghost_idx] = h_field.data[idx];
+                    }
+
+                // use a separate tag per direction and field, both directions are in flight simultaneously
+                int tag = 3*dir + f + 1;
+                MPI_Request req;
+                MPI_Isend(sendbuf, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, tag, m_mpi_comm, &req);
+                m_reqs.push_back(req);
+                MPI_Irecv(h_field.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, tag,
+                    m_mpi_comm, &req);
+                m_reqs.push_back(req);
+
+                offset += m_num_copy_ghosts[dir];
+                }
+            }
+
+        if (m_prof)
+            m_prof->pop();
+
+        m_comm_pending = true;
+        }
+
         if (m_prof)
             m_prof->pop();
     }
 
+//! finish the ghost update stage left in flight by beginUpdateGhosts()
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (! m_comm_pending)
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    if (m_reqs.size())
+        {
+        std::vector<MPI_Status> stats(m_reqs.size());
+        MPI_Waitall(m_reqs.size(), &m_reqs.front(), &stats.front());
+        m_reqs.clear();
+        }
+
+    // wrap particle positions (only if copying positions)
+    CommFlags flags = getFlags();
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+        for (unsigned int dir = 0; dir < 6; dir++)
+            {
+            if (! m_ghost_update_pending[dir]) continue;
+
+            unsigned int start_idx = m_ghost_update_start[dir];
+            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+                {
+                // wrap particles received across a global boundary
+                int3 img = make_int3(0,0,0);
+                shifted_box.wrap(h_pos.data[idx], img);
+                }
+            }
+        }
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        m_ghost_update_pending[dir] = false;
+
+    m_comm_pending = false;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void Communicator::updateNetForce(unsigned int timestep)
     {
     CommFlags flags = getFlags();
@@ -237,6 +237,19 @@ class Communicator
             return m_compute_callbacks;
             }
 
+        //! Subscribe to list of call-backs for computation using only local particles
+        /*!
+         * Subscribe to a list of call-backs that compute quantities which do not depend on ghost particles.
+         * They are called after beginUpdateGhosts() and before finishUpdateGhosts(), while the last stage of the
+         * ghost update is still in flight, and only on time steps without particle migration.
+         *
+         * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+         */
+        Nano::Signal<void (unsigned int timestep)>& getLocalComputeCallbackSignal()
+            {
+            return m_local_compute_callbacks;
+            }
+
         //! Get the ghost communication flags
         CommFlags getFlags() { return m_flags; }
 
@@ -298,6 +311,10 @@ class Communicator
          * additional computation or communication during the update substep. To complete
          * the communication, call finishUpdateGhosts()
          *
+         * When call-backs are subscribed to getLocalComputeCallbackSignal(), the messages of the last
+         * communicating dimension are posted but not awaited. The earlier dimensions have to complete first,
+         * because they supply the edge and corner ghosts that are forwarded in the later ones.
+         *
          * \param timestep The time step
          *
          * \pre The ghost exchange list has been constructed in a previous time step, using exchangeGhosts().
@@ -309,11 +326,7 @@ class Communicator
          *
          * \param timestep The time step
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
 
         /*! Communicate the net particle force
          * \parm timestep The time step
@@ -519,6 +532,9 @@ class Communicator
         Nano::Signal<void (unsigned int timestep)>
             m_compute_callbacks;   //!< List of functions that are called after ghost communication
 
+        Nano::Signal<void (unsigned int timestep)>
+            m_local_compute_callbacks;   //!< List of functions that are called during the ghost update
+
         Nano::Signal<void (const GPUArray<unsigned int>& )>
             m_comm_callbacks;   //!< List of functions that are called after the compute callbacks
 
@@ -527,6 +543,9 @@ class Communicator
 
         bool m_comm_pending;                     //!< If true, a communication is in process
         std::vector<MPI_Request> m_reqs;         //!< List of pending MPI requests
+        std::vector<Scalar4> m_ghost_update_sendbuf; //!< Send buffer for the ghost update stage left in flight
+        bool m_ghost_update_pending[6];          //!< True if the ghost update in a direction is still in flight
+        unsigned int m_ghost_update_start[6];    //!< First ghost index received in a direction
 
         /* Bonds communication */
         bool m_bonds_changed;                          //!< True if bond information needs to be refreshed
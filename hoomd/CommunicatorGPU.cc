@@ -44,6 +44,15 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
     // allocate memory
     allocateBuffers();
 
+    m_gpu_sendbuf.setTag("CommunicatorGPU::m_gpu_sendbuf");
+    m_gpu_recvbuf.setTag("CommunicatorGPU::m_gpu_recvbuf");
+    m_tag_ghost_sendbuf.setTag("CommunicatorGPU::m_tag_ghost_sendbuf");
+    m_tag_ghost_recvbuf.setTag("CommunicatorGPU::m_tag_ghost_recvbuf");
+    m_pos_ghost_sendbuf.setTag("CommunicatorGPU::m_pos_ghost_sendbuf");
+    m_pos_ghost_recvbuf.setTag("CommunicatorGPU::m_pos_ghost_recvbuf");
+    m_vel_ghost_sendbuf.setTag("CommunicatorGPU::m_vel_ghost_sendbuf");
+    m_vel_ghost_recvbuf.setTag("CommunicatorGPU::m_vel_ghost_recvbuf");
+
     // initialize communciation stages
     initializeCommunicationStages();
 
@@ -48,7 +48,7 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                                                bool ignore_display,
                                                std::shared_ptr<Messenger> _msg,
                                                unsigned int n_ranks)
-    : m_cuda_error_checking(false), msg(_msg)
+    : m_cuda_error_checking(false), msg(_msg), m_memory_tracker(new MemoryTracker())
     {
     if (!msg)
         msg = std::shared_ptr<Messenger>(new Messenger());
@@ -20,6 +20,7 @@
 #endif
 
 #include "Messenger.h"
+#include "MemoryTracker.h"
 
 /*! \file ExecutionConfiguration.h
     \brief Declares ExecutionConfiguration and related classes
@@ -198,6 +199,12 @@ struct ExecutionConfiguration
         }
     #endif
 
+    //! Returns the tracker of the memory allocated by GPUArray and GPUVector on this rank
+    std::shared_ptr<MemoryTracker> getMemoryTracker() const
+        {
+        return m_memory_tracker;
+        }
+
 private:
 #ifdef ENABLE_CUDA
     //! Initialize the GPU with the given id
@@ -239,6 +246,8 @@ private:
     CachedAllocator *m_cached_alloc;       //!< Cached allocator for temporary allocations
     #endif
 
+    std::shared_ptr<MemoryTracker> m_memory_tracker;  //!< Registry of GPUArray allocations
+
     //! Setup and print out stats on the chosen CPUs/GPUs
     void setupStats();
     };
@@ -28,7 +28,9 @@ namespace py = pybind11;
     \post \c force and \c virial GPUarrays are initialized
     \post All forces are initialized to 0
 */
-ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef), m_particles_sorted(false)
+ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef), m_particles_sorted(false), m_compute_time(0),
+    m_accumulate(false), m_arrays_valid(true), m_arrays_requested(false), m_evaluated_step(0),
+    m_evaluation_stride(1)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -61,6 +63,10 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef) : Compute(s
  */
 void ForceCompute::reallocate()
     {
+    // released arrays are allocated with the right size when they are needed again
+    if (m_force.isNull())
+        return;
+
     m_force.resize(m_pdata->getMaxN());
     m_virial.resize(m_pdata->getMaxN(),6);
     m_torque.resize(m_pdata->getMaxN());
@@ -69,6 +75,38 @@ void ForceCompute::reallocate()
     m_virial_pitch = m_virial.getPitch();
     }
 
+/*! \post m_force, m_virial and m_torque are allocated for the current maximum particle number
+*/
+void ForceCompute::allocateArrays()
+    {
+    if (!m_force.isNull())
+        return;
+
+    unsigned int max_num_particles = m_pdata->getMaxN();
+    GPUArray<Scalar4>  force(max_num_particles,exec_conf);
+    GPUArray<Scalar>   virial(max_num_particles,6,exec_conf);
+    GPUArray<Scalar4>  torque(max_num_particles,exec_conf);
+    m_force.swap(force);
+    m_virial.swap(virial);
+    m_torque.swap(torque);
+
+    m_virial_pitch = m_virial.getPitch();
+    }
+
+/*! After accumulate() added the forces of the last computed time step only to the net force arrays, the forces are
+    evaluated again into m_force, m_virial and m_torque. Nothing is done if the arrays are up to date.
+*/
+void ForceCompute::materialize()
+    {
+    if (m_arrays_valid)
+        return;
+
+    m_arrays_requested = true;
+    allocateArrays();
+    evaluateForces(m_evaluated_step);
+    m_arrays_valid = true;
+    }
+
 /*! Frees allocated memory
 */
 ForceCompute::~ForceCompute()
@@ -81,6 +119,7 @@ ForceCompute::~ForceCompute()
 */
 Scalar ForceCompute::calcEnergySum()
     {
+    materialize();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
     // always perform the sum in double precision for better accuracy
     // this is cheating and is really just a temporary hack to get logging up and running
@@ -106,6 +145,7 @@ Scalar ForceCompute::calcEnergySum()
 Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
     {
     unsigned int group_size = group->getNumMembers();
+    materialize();
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
 
     double pe_total = 0.0;
@@ -136,12 +176,104 @@ Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
 
 void ForceCompute::compute(unsigned int timestep)
     {
-    // skip if we shouldn't compute this step
-    if (!m_particles_sorted && !shouldCompute(timestep))
+    // skip if we shouldn't compute this step, unless the arrays are stale because the particles were sorted or
+    // the last forces were only added to the net force
+    if (!shouldCompute(timestep) && !m_particles_sorted && m_arrays_valid)
+        return;
+
+    // someone needs the per-compute arrays after they were left out of date by accumulate()
+    if (!m_arrays_valid)
+        m_arrays_requested = true;
+
+    allocateArrays();
+    evaluateForces(timestep);
+    m_arrays_valid = true;
+    }
+
+/*! \param timestep Current time step
+
+    The caller must have zeroed the net force, virial and torque arrays before the first force compute accumulates.
+    If supportsAccumulate() is true, computeForces() is called with m_accumulate set and adds its results directly to
+    the net force arrays, skipping m_force, m_virial and m_torque. These arrays are released on the first such call
+    unless they have been requested since. Otherwise, compute() evaluates the forces as usual and they are added to
+    the net force here.
+
+    The external virial and energy are not part of the net force arrays, the caller sums them as before.
+
+    If the per-compute arrays already hold the forces of this time step, they are added without evaluating the
+    forces again.
+*/
+void ForceCompute::accumulate(unsigned int timestep)
+    {
+    if (!supportsAccumulate())
+        {
+        compute(timestep);
+        addToNetForce();
+        return;
+        }
+
+    // reuse the forces of this time step if they are already in the per-compute arrays
+    if (!shouldCompute(timestep) && !m_particles_sorted && m_arrays_valid)
+        {
+        addToNetForce();
         return;
+        }
+
+    if (!m_arrays_requested && !m_force.isNull())
+        {
+        m_exec_conf->msg->notice(6) << "ForceCompute: releasing per-compute force arrays" << endl;
+        GPUArray<Scalar4>().swap(m_force);
+        GPUArray<Scalar>().swap(m_virial);
+        GPUArray<Scalar4>().swap(m_torque);
+        }
 
+    m_accumulate = true;
+    evaluateForces(timestep);
+    m_accumulate = false;
+    m_arrays_valid = false;
+    }
+
+/*! \param timestep Current time step
+    \post The forces are computed and the time is added to the compute time
+*/
+void ForceCompute::evaluateForces(unsigned int timestep)
+    {
+    int64_t start_time = m_compute_clock.getTime();
     computeForces(timestep);
+    m_compute_time += m_compute_clock.getTime() - start_time;
     m_particles_sorted = false;
+    m_evaluated_step = timestep;
+    }
+
+/*! \post m_force, m_virial and m_torque of the local particles are added to the net force, virial and torque
+*/
+void ForceCompute::addToNetForce()
+    {
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::readwrite);
+
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(m_virial,access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_torque(m_torque,access_location::host,access_mode::read);
+
+    unsigned int nparticles = m_pdata->getN();
+    unsigned int net_virial_pitch = m_pdata->getNetVirial().getPitch();
+    for (unsigned int j = 0; j < nparticles; j++)
+        {
+        h_net_force.data[j].x += h_force.data[j].x;
+        h_net_force.data[j].y += h_force.data[j].y;
+        h_net_force.data[j].z += h_force.data[j].z;
+        h_net_force.data[j].w += h_force.data[j].w;
+
+        h_net_torque.data[j].x += h_torque.data[j].x;
+        h_net_torque.data[j].y += h_torque.data[j].y;
+        h_net_torque.data[j].z += h_torque.data[j].z;
+        h_net_torque.data[j].w += h_torque.data[j].w;
+
+        for (unsigned int k = 0; k < 6; k++)
+            h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*m_virial_pitch+j];
+        }
     }
 
 /*! \param num_iters Number of iterations to average for the benchmark
@@ -153,6 +285,8 @@ void ForceCompute::compute(unsigned int timestep)
 double ForceCompute::benchmark(unsigned int num_iters)
     {
     ClockSource t;
+    allocateArrays();
+
     // warm up run
     computeForces(0);
 
@@ -184,6 +318,7 @@ double ForceCompute::benchmark(unsigned int num_iters)
  */
 Scalar4 ForceCompute::getTorque(unsigned int tag)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar4 result = make_scalar4(0.0,0.0,0.0,0.0);
@@ -207,6 +342,7 @@ Scalar4 ForceCompute::getTorque(unsigned int tag)
  */
 Scalar3 ForceCompute::getForce(unsigned int tag)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar3 result = make_scalar3(0.0,0.0,0.0);
@@ -231,6 +367,7 @@ Scalar3 ForceCompute::getForce(unsigned int tag)
  */
 Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -254,6 +391,7 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
  */
 Scalar ForceCompute::getEnergy(unsigned int tag)
     {
+    materialize();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
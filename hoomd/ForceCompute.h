@@ -6,6 +6,7 @@
 #include "Compute.h"
 #include "Index1D.h"
 #include "ParticleGroup.h"
+#include "ClockSource.h"
 
 #ifdef ENABLE_CUDA
 #include "ParticleData.cuh"
@@ -42,6 +43,14 @@
     that
     \f$ \sum_k^N \left(\mathrm{virial}_{ij}\right)_k = \sum_k^N \sum_{l>k} \frac{1}{2} \left( \vec{f}_{kl,i} \vec{r}_{kl,j} \right) \f$
 
+    <b>Accumulate mode</b>
+
+    An Integrator may call accumulate() instead of compute(). Force computes that supportsAccumulate() then add their
+    results directly to the ParticleData net force arrays and m_force, m_virial and m_torque are left out of date.
+    They are released on the first such call and are recomputed by materialize() only when they are requested again,
+    through the per-particle getters, the energy sums or getForceArray(). Other force computes fall back to compute()
+    and add their arrays to the net force.
+
     \ingroup data_structs
 */
 
@@ -71,9 +80,46 @@ class ForceCompute : public Compute
         //! Computes the forces
         virtual void compute(unsigned int timestep);
 
+        //! Computes the forces and adds them to the net force, virial and torque
+        virtual void accumulate(unsigned int timestep);
+
+        //! Returns true if computeForces() can add its results directly to the net force arrays
+        /*! Sub-classes that return true must honor m_accumulate in computeForces(): when it is set, the forces,
+            energies, virials and torques are added to the ParticleData net force, net virial and net torque arrays
+            (without zeroing them first) instead of being written to m_force, m_virial and m_torque.
+        */
+        virtual bool supportsAccumulate()
+            {
+            return false;
+            }
+
+        //! Set the evaluation stride assigned by the Integrator for multiple time step integration
+        void setEvaluationStride(unsigned int stride)
+            {
+            m_evaluation_stride = stride;
+            }
+
+        //! Get the evaluation stride assigned by the Integrator
+        /*! Forces with a stride \a k are only evaluated on time steps that are a multiple of \a k, see
+            Integrator::setForceStride().
+        */
+        unsigned int getEvaluationStride() const
+            {
+            return m_evaluation_stride;
+            }
+
         //! Benchmark the force compute
         virtual double benchmark(unsigned int num_iters);
 
+        //! Get the total wall clock time spent computing the forces (in ns)
+        /*! The time accumulates over all calls to compute() that evaluate the forces. It measures the time the host
+            spends, which does not include asynchronous work on the GPU.
+        */
+        uint64_t getComputeTime() const
+            {
+            return m_compute_time;
+            }
+
         //! Total the potential energy
         Scalar calcEnergySum();
 
@@ -95,18 +141,21 @@ class ForceCompute : public Compute
         //! Get the array of computed forces
         GPUArray<Scalar4>& getForceArray()
             {
+            materialize();
             return m_force;
             }
 
         //! Get the array of computed virials
         GPUArray<Scalar>& getVirialArray()
             {
+            materialize();
             return m_virial;
             }
 
         //! Get the array of computed torques
         GPUArray<Scalar4>& getTorqueArray()
             {
+            materialize();
             return m_torque;
             }
 
@@ -143,6 +192,13 @@ class ForceCompute : public Compute
 
     protected:
         bool m_particles_sorted;    //!< Flag set to true when particles are resorted in memory
+        ClockSource m_compute_clock;    //!< Clock for measuring the time spent computing forces
+        uint64_t m_compute_time;        //!< Total time spent computing forces (in ns)
+        bool m_accumulate;              //!< True while computeForces() adds to the net force arrays
+        bool m_arrays_valid;            //!< False if the last forces were only added to the net force arrays
+        bool m_arrays_requested;        //!< True if the per-compute arrays were requested after an accumulate()
+        unsigned int m_evaluated_step;  //!< Time step of the last force evaluation
+        unsigned int m_evaluation_stride;   //!< Evaluation stride set by the Integrator
 
         //! Helper function called when particles are sorted
         /*! setParticlesSorted() is passed as a slot to the particle sort signal.
@@ -158,6 +214,18 @@ class ForceCompute : public Compute
         //! Reallocate internal arrays
         void reallocate();
 
+        //! Allocate m_force, m_virial and m_torque if they were released
+        void allocateArrays();
+
+        //! Bring m_force, m_virial and m_torque up to date with the last computed time step
+        void materialize();
+
+        //! Add m_force, m_virial and m_torque to the net force arrays
+        void addToNetForce();
+
+        //! Time a call to computeForces()
+        void evaluateForces(unsigned int timestep);
+
         Scalar m_deltaT;  //!< timestep size (required for some types of non-conservative forces)
 
         GPUArray<Scalar4> m_force;            //!< m_force.x,m_force.y,m_force.z are the x,y,z components of the force, m_force.u is the PE
@@ -25,6 +25,7 @@
 
 #include "ExecutionConfiguration.h"
 #include <string.h>
+#include <string>
 #include <iostream>
 #include <stdexcept>
 #include <algorithm>
@@ -273,6 +274,28 @@ template<class T> class GPUArray
         //! Resize a 2D GPUArray
         virtual void resize(unsigned int width, unsigned int height);
 
+        //! Set the tag under which the memory of this array is accounted for
+        /*! \param tag Owning class and name of the array, e.g. "NeighborList::m_nlist"
+
+            The MemoryTracker sums the current and peak memory of all arrays with the same tag, and the breakdown printed
+            at the end of run() lists it by tag. Classes that own large arrays tag them once after allocating them, so
+            that the largest consumers show up under their own names instead of the untagged total.
+
+            The tag stays with this GPUArray when its data is swapped with another one, so it only needs to be set
+            once for a member array.
+        */
+        void setTag(const std::string& tag)
+            {
+            m_tag = tag;
+            updateTrackerTag();
+            }
+
+        //! Get the tag under which the memory of this array is accounted for
+        const std::string& getTag() const
+            {
+            return m_tag;
+            }
+
     protected:
         //! Clear memory starting from a given element
         /*! \param first The first element to clear
@@ -302,6 +325,7 @@ template<class T> class GPUArray
 #ifdef ENABLE_CUDA
         mutable bool m_mapped;                          //!< True if we are using mapped memory
 #endif
+        std::string m_tag;                              //!< Tag for the memory tracker
 
     // ok, this looks weird, but I want m_exec_conf to be protected and not have to go reorder all of the initializers
     protected:
@@ -318,6 +342,13 @@ template<class T> class GPUArray
         //! Helper function to free memory
         inline void deallocate();
 
+        //! Register the current allocation with the memory tracker
+        inline void trackAllocation() const;
+        //! Remove the current allocation from the memory tracker
+        inline void untrackAllocation() const;
+        //! Assign the tag of this GPUArray to its current allocation in the memory tracker
+        inline void updateTrackerTag() const;
+
 #ifdef ENABLE_CUDA
         //! Helper function to copy memory from the device to host
         inline void memcpyDeviceToHost(bool async) const;
@@ -487,6 +518,8 @@ template<class T> GPUArray<T>::GPUArray(const GPUArray& from) : m_num_elements(f
         h_data(NULL),
         m_exec_conf(from.m_exec_conf)
     {
+    m_tag = from.m_tag;
+
     // allocate and clear new memory the same size as the data in from
     allocate();
     memclear();
@@ -520,6 +553,10 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs)
         // initialize state variables
         m_data_location = data_location::host;
 
+        // keep the tag of this array, if it has one
+        if (m_tag.empty())
+            m_tag = rhs.m_tag;
+
         // allocate and clear new memory the same size as the data in rhs
         allocate();
         memclear();
@@ -564,6 +601,10 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_mapped, from.m_mapped);
 #endif
     std::swap(h_data, from.h_data);
+
+    // the tags stay with the arrays, account the swapped data under them
+    updateTrackerTag();
+    from.updateTrackerTag();
     }
 
 //! Swap the pointers of two GPUArrays (const version)
@@ -583,6 +624,10 @@ template<class T> void GPUArray<T>::swap(GPUArray& from) const
     std::swap(m_mapped, from.m_mapped);
 #endif
     std::swap(h_data, from.h_data);
+
+    // the tags stay with the arrays, account the swapped data under them
+    updateTrackerTag();
+    from.updateTrackerTag();
     }
 
 /*! \pre m_num_elements is set
@@ -647,6 +692,8 @@ template<class T> void GPUArray<T>::allocate()
             }
         }
 #endif
+
+    trackAllocation();
     }
 
 /*! \pre allocate() has been called
@@ -662,6 +709,8 @@ template<class T> void GPUArray<T>::deallocate()
     assert(!m_acquired);
     assert(h_data);
 
+    untrackAllocation();
+
     // free memory
 
 #ifdef ENABLE_CUDA
@@ -688,6 +737,43 @@ template<class T> void GPUArray<T>::deallocate()
 #endif
     }
 
+/*! Registers the host pointer with the number of host bytes, and the number of device bytes that are allocated to
+    mirror it. Mapped memory only counts as host memory.
+*/
+template<class T> void GPUArray<T>::trackAllocation() const
+    {
+    if (!m_exec_conf || h_data == NULL)
+        return;
+
+    size_t bytes = size_t(m_num_elements)*sizeof(T);
+    size_t device_bytes = 0;
+#ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled() && !m_mapped)
+        device_bytes = bytes;
+#endif
+
+    m_exec_conf->getMemoryTracker()->registerAllocation(h_data, bytes, device_bytes, m_tag);
+    }
+
+template<class T> void GPUArray<T>::untrackAllocation() const
+    {
+    if (!m_exec_conf || h_data == NULL)
+        return;
+
+    m_exec_conf->getMemoryTracker()->unregisterAllocation(h_data);
+    }
+
+/*! Untagged arrays leave the tag of the allocation unchanged, so that data that is swapped into an untagged
+    temporary is still accounted for under the tag of the array that allocated it.
+*/
+template<class T> void GPUArray<T>::updateTrackerTag() const
+    {
+    if (m_tag.empty() || !m_exec_conf || h_data == NULL)
+        return;
+
+    m_exec_conf->getMemoryTracker()->updateTag(h_data, m_tag);
+    }
+
 /*! \pre allocate() has been called
     \post All allocated memory is set to 0
 */
@@ -1164,6 +1250,8 @@ template<class T> void GPUArray<T>::resize(unsigned int num_elements)
     if (m_exec_conf)
         m_exec_conf->msg->notice(7) << "GPUArray: Resizing to " << float(num_elements*sizeof(T))/1024.0f/1024.0f << " MB" << std::endl;
 
+    untrackAllocation();
+
     resizeHostArray(num_elements);
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1171,6 +1259,8 @@ template<class T> void GPUArray<T>::resize(unsigned int num_elements)
 #endif
     m_num_elements = num_elements;
     m_pitch = num_elements;
+
+    trackAllocation();
     }
 
 /*! \param width new width of array
@@ -1206,6 +1296,8 @@ template<class T> void GPUArray<T>::resize(unsigned int width, unsigned int heig
         m_exec_conf->msg->notice(7) << "GPUArray is trying to allocate a very large (>4GB) amount of memory." << std::endl;
         }
 
+    untrackAllocation();
+
     resize2DHostArray(m_pitch, new_pitch, m_height, height);
 #ifdef ENABLE_CUDA
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1216,5 +1308,7 @@ template<class T> void GPUArray<T>::resize(unsigned int width, unsigned int heig
     m_height = height;
     m_pitch  = new_pitch;
     m_num_elements = m_pitch * m_height;
+
+    trackAllocation();
     }
 #endif
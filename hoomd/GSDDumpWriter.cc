@@ -40,23 +40,31 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     : Analyzer(sysdef), m_fname(fname), m_overwrite(overwrite),
                         m_truncate(truncate),
                         m_is_initialized(false),
-                        m_group(group)
+                        m_nframes(0),
+                        m_group(group),
+                        m_cur_frame(0),
+                        m_async(false),
+                        m_writer_busy(false),
+                        m_writer_stop(false),
+                        m_writer_frame(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing GSDDumpWriter: " << m_fname << " " << overwrite << " " << truncate << endl;
     }
 
+/*! \param retval Return value of a gsd call
+
+    Throws an exception describing the error for common gsd error codes. Frames may be written on the writer thread,
+    so the error is not printed here; the caller reports the message of the exception on the main thread.
+*/
 void GSDDumpWriter::checkError(int retval)
     {
-    // checkError prints errors and then throws exceptions for common gsd error codes
     if (retval == -1)
         {
-        m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
-        throw runtime_error("Error writing GSD file");
+        throw runtime_error("dump.gsd: " + string(strerror(errno)) + " - " + m_fname);
         }
     else if (retval != 0)
         {
-        m_exec_conf->msg->error() << "dump.gsd: " << "Unknown error writing: " << m_fname << endl;
-        throw runtime_error("Error writing GSD file");
+        throw runtime_error("dump.gsd: Unknown error writing: " + m_fname);
         }
     }
 
@@ -129,13 +137,119 @@ void GSDDumpWriter::initFileIO()
         throw runtime_error("Error opening GSD file");
         }
 
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
     }
 
+/*! \param async True if frames should be written by a background thread
+
+    Disabling asynchronous writes waits for the pending frame to be written.
+*/
+void GSDDumpWriter::setAsync(bool async)
+    {
+    if (!async)
+        flush();
+
+    m_async = async;
+    }
+
+/*! Blocks until the writer thread has written the pending frame, and reports any error that occured on the
+    writer thread.
+*/
+void GSDDumpWriter::flush()
+    {
+    if (!m_writer_thread.joinable())
+        return;
+
+    std::exception_ptr error;
+        {
+        std::unique_lock<std::mutex> lock(m_writer_mutex);
+        m_writer_cv.wait(lock, [this] { return !m_writer_busy; });
+        error = m_writer_error;
+        m_writer_error = nullptr;
+        }
+
+    if (error)
+        reportWriteError(error);
+    }
+
+/*! \param error Exception thrown while writing a frame
+
+    The writer thread never prints messages, since the Messenger is not thread safe. Errors are printed here, on the
+    main thread, and rethrown.
+*/
+void GSDDumpWriter::reportWriteError(std::exception_ptr error)
+    {
+    try
+        {
+        std::rethrow_exception(error);
+        }
+    catch (const std::exception& e)
+        {
+        m_exec_conf->msg->error() << e.what() << endl;
+        throw runtime_error("Error writing GSD file");
+        }
+    }
+
+/*! The writer thread waits for frames handed to it by analyze() and writes them to the file one at a time. It exits
+    when m_writer_stop is set and there is no pending frame.
+*/
+void GSDDumpWriter::writerThread()
+    {
+    std::unique_lock<std::mutex> lock(m_writer_mutex);
+    while (true)
+        {
+        m_writer_cv.wait(lock, [this] { return m_writer_busy || m_writer_stop; });
+        if (!m_writer_busy)
+            return;
+
+        // write without holding the lock, the frame buffer is not touched by analyze() until m_writer_busy is reset
+        lock.unlock();
+        std::exception_ptr error;
+        try
+            {
+            writeFrame(m_frames[m_writer_frame]);
+            }
+        catch (...)
+            {
+            error = std::current_exception();
+            }
+        lock.lock();
+
+        if (error)
+            m_writer_error = error;
+        m_writer_busy = false;
+        m_writer_cv.notify_all();
+        }
+    }
+
 GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
 
+    // write out the pending frame and stop the writer thread
+    if (m_writer_thread.joinable())
+        {
+            {
+            std::lock_guard<std::mutex> lock(m_writer_mutex);
+            m_writer_stop = true;
+            }
+        m_writer_cv.notify_all();
+        m_writer_thread.join();
+
+        if (m_writer_error)
+            {
+            try
+                {
+                reportWriteError(m_writer_error);
+                }
+            catch (...)
+                {
+                m_exec_conf->msg->error() << "dump.gsd: the last frame was not written to " << m_fname << endl;
+                }
+            }
+        }
+
     bool root=true;
     #ifdef ENABLE_MPI
     root = m_exec_conf->isRoot();
@@ -152,70 +266,41 @@ GSDDumpWriter::~GSDDumpWriter()
 
     The first call to analyze() will create or overwrite the file and write out the current system configuration
     as frame 0. Subsequent calls will append frames to the file, or keep ovewriting frame 0 if m_truncate is true.
+
+    When asynchronous writes are enabled, the frame is written to the file by the writer thread after analyze()
+    returns.
 */
 void GSDDumpWriter::analyze(unsigned int timestep)
     {
-    int retval;
     bool root=true;
 
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
-
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
 #endif
 
+    // the writer thread only ever reads the other frame buffer
+    Frame& frame = m_frames[m_cur_frame];
+
+    // take particle data snapshot
+    m_exec_conf->msg->notice(10) << "dump.gsd: taking particle data snapshot" << endl;
+    frame.map = m_pdata->takeSnapshot<float>(frame.snapshot);
+
     // open the file if it is not yet opened
     if (! m_is_initialized && root)
         initFileIO();
 
-    // truncate the file if requested
+    // the file is truncated before writing this frame if requested
     if (m_truncate && root)
-        {
-        m_exec_conf->msg->notice(10) << "dump.gsd: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        if (retval == -1)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << strerror(errno) << " - " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -2)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << m_fname << " is not a valid GSD file" << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -3)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Invalid GSD file version in " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -4)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Corrupt GSD file: " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval == -5)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Out of memory opening: " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        else if (retval != 0)
-            {
-            m_exec_conf->msg->error() << "dump.gsd: " << "Unknown error opening: " << m_fname << endl;
-            throw runtime_error("Error opening GSD file");
-            }
-        }
+        m_nframes = 0;
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10) << "dump.gsd: " << m_fname << " has " << nframes << " frames" << endl;
         }
 
@@ -223,51 +308,127 @@ void GSDDumpWriter::analyze(unsigned int timestep)
     bcast(nframes, 0, m_exec_conf->getMPICommunicator());
     #endif
 
-    if (root)
-        {
-        // write out the frame header on all frames
-        writeFrameHeader(timestep);
+    frame.timestep = timestep;
+    frame.nframes = nframes;
+    frame.truncate = m_truncate;
 
-        // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
-        }
+    // only write out data chunk categories if requested, or if on frame 0
+    frame.write_attribute = m_write_attribute || nframes == 0;
+    frame.write_property = m_write_property || nframes == 0;
+    frame.write_momentum = m_write_momentum || nframes == 0;
 
     // topology is only meaningful if this is the all group
-    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal() && (m_write_topology || nframes == 0))
+    frame.write_topology = m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
+                           && (m_write_topology || nframes == 0);
+
+    if (frame.write_topology)
         {
-        BondData::Snapshot bdata_snapshot;
-        m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
+        m_sysdef->getBondData()->takeSnapshot(frame.bond);
+        m_sysdef->getAngleData()->takeSnapshot(frame.angle);
+        m_sysdef->getDihedralData()->takeSnapshot(frame.dihedral);
+        m_sysdef->getImproperData()->takeSnapshot(frame.improper);
+        m_sysdef->getConstraintData()->takeSnapshot(frame.constraint);
+        }
 
-        AngleData::Snapshot adata_snapshot;
-        m_sysdef->getAngleData()->takeSnapshot(adata_snapshot);
+    if (root)
+        {
+        // copy the state needed by the writer, it may change before the frame is written
+        frame.global_box = m_pdata->getGlobalBox();
 
-        DihedralData::Snapshot ddata_snapshot;
-        m_sysdef->getDihedralData()->takeSnapshot(ddata_snapshot);
+        unsigned int N = m_group->getNumMembersGlobal();
+        frame.tags.resize(N);
+        for (unsigned int group_idx = 0; group_idx < N; group_idx++)
+            frame.tags[group_idx] = m_group->getMemberTag(group_idx);
 
-        ImproperData::Snapshot idata_snapshot;
-        m_sysdef->getImproperData()->takeSnapshot(idata_snapshot);
+        m_nframes++;
 
-        ConstraintData::Snapshot cdata_snapshot;
-        m_sysdef->getConstraintData()->takeSnapshot(cdata_snapshot);
+        m_exec_conf->msg->notice(10) << "dump.gsd: writing frame " << nframes << " to " << m_fname << endl;
+        if (m_async)
+            {
+            // start the writer thread on first use
+            if (!m_writer_thread.joinable())
+                m_writer_thread = std::thread(&GSDDumpWriter::writerThread, this);
 
-        if (root)
-            writeTopology(bdata_snapshot, adata_snapshot, ddata_snapshot, idata_snapshot, cdata_snapshot);
+            // wait for the previous frame, then hand this one to the writer and fill the other buffer next time
+            flush();
+                {
+                std::lock_guard<std::mutex> lock(m_writer_mutex);
+                m_writer_frame = m_cur_frame;
+                m_writer_busy = true;
+                }
+            m_writer_cv.notify_all();
+            m_cur_frame ^= 1;
+            }
+        else
+            {
+            try
+                {
+                writeFrame(frame);
+                }
+            catch (...)
+                {
+                reportWriteError(std::current_exception());
+                }
+            }
         }
 
-    if (root)
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param frame Frame to write
+
+    Writes all chunks of \a frame and ends the frame. Only data in \a frame and the file handle are accessed, so this
+    method may be called on the writer thread.
+*/
+void GSDDumpWriter::writeFrame(const Frame& frame)
+    {
+    int retval;
+
+    // truncate the file if requested
+    if (frame.truncate)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        checkError(retval);
+        retval = gsd_truncate(&m_handle);
+        if (retval == -1)
+            {
+            throw runtime_error("dump.gsd: " + string(strerror(errno)) + " - " + m_fname);
+            }
+        else if (retval == -2)
+            {
+            throw runtime_error("dump.gsd: " + m_fname + " is not a valid GSD file");
+            }
+        else if (retval == -3)
+            {
+            throw runtime_error("dump.gsd: Invalid GSD file version in " + m_fname);
+            }
+        else if (retval == -4)
+            {
+            throw runtime_error("dump.gsd: Corrupt GSD file: " + m_fname);
+            }
+        else if (retval == -5)
+            {
+            throw runtime_error("dump.gsd: Out of memory opening: " + m_fname);
+            }
+        else if (retval != 0)
+            {
+            throw runtime_error("dump.gsd: Unknown error opening: " + m_fname);
+            }
         }
 
-    if (m_prof)
-        m_prof->pop();
+    // write out the frame header on all frames
+    writeFrameHeader(frame);
+
+    if (frame.write_attribute)
+        writeAttributes(frame);
+    if (frame.write_property)
+        writeProperties(frame);
+    if (frame.write_momentum)
+        writeMomenta(frame);
+    if (frame.write_topology)
+        writeTopology(frame.bond, frame.angle, frame.dihedral, frame.improper, frame.constraint);
+
+    retval = gsd_end_frame(&m_handle);
+    checkError(retval);
     }
 
 
@@ -281,7 +442,6 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
     max_len += 1;  // for null
 
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing " << chunk << endl;
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len*i], type_mapping[i].c_str(), max_len);
@@ -291,7 +451,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
 
     }
 
-/*! \param timestep
+/*! \param frame Frame to write
 
     Write the data chunks configuration/step, configuration/box, and particles/N. If this is frame 0, also write
     configuration/dimensions.
@@ -299,24 +459,21 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector< std::string
     N is not strictly necessary for constant N data, but is always written in case the user fails to select
     dynamic attributes with a variable N file.
 */
-void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
+void GSDDumpWriter::writeFrameHeader(const Frame& frame)
     {
     int retval;
-    m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/step" << endl;
-    uint64_t step = timestep;
+    uint64_t step = frame.timestep;
     retval = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void *)&step);
     checkError(retval);
 
     if (gsd_get_nframes(&m_handle) == 0)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/dimensions" << endl;
         uint8_t dimensions = m_sysdef->getNDimensions();
         retval = gsd_write_chunk(&m_handle, "configuration/dimensions", GSD_TYPE_UINT8, 1, 1, 0, (void *)&dimensions);
         checkError(retval);
         }
 
-    m_exec_conf->msg->notice(10) << "dump.gsd: writing configuration/box" << endl;
-    BoxDim box = m_pdata->getGlobalBox();
+    const BoxDim& box = frame.global_box;
     float box_a[6];
     box_a[0] = box.getL().x;
     box_a[1] = box.getL().y;
@@ -327,19 +484,20 @@ void GSDDumpWriter::writeFrameHeader(unsigned int timestep)
     retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void *)box_a);
     checkError(retval);
 
-    m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/N" << endl;
-    uint32_t N = m_group->getNumMembersGlobal();
+    uint32_t N = frame.tags.size();
     retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
     checkError(retval);
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param frame Frame to write
 
     Writes the data chunks types, typeid, mass, charge, diameter, body, moment_inertia in particles/.
 */
-void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeAttributes(const Frame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& snapshot = frame.snapshot;
+    const std::map<unsigned int, unsigned int>& map = frame.map;
+    uint32_t N = frame.tags.size();
     int retval;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
@@ -350,7 +508,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -364,7 +522,6 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/typeid" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&type[0]);
             checkError(retval);
             }
@@ -376,7 +533,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -390,7 +547,6 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/mass" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/mass", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
@@ -399,7 +555,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -412,7 +568,6 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/charge" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/charge", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
@@ -421,7 +576,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -435,7 +590,6 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/diameter" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/diameter", GSD_TYPE_FLOAT, N, 1, 0, (void *)&data[0]);
             checkError(retval);
             }
@@ -447,7 +601,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -461,7 +615,6 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/body" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/body", GSD_TYPE_INT32, N, 1, 0, (void *)&body[0]);
             checkError(retval);
             }
@@ -473,7 +626,7 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -493,20 +646,21 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/moment_inertia" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param frame Frame to write
 
     Writes the data chunks position and orientation in particles/.
 */
-void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeProperties(const Frame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& snapshot = frame.snapshot;
+    const std::map<unsigned int, unsigned int>& map = frame.map;
+    uint32_t N = frame.tags.size();
     int retval;
 
         {
@@ -514,7 +668,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -525,7 +679,6 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
             data[group_idx*3+2] = float(snapshot.pos[it->second].z);
             }
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/position" << endl;
         retval = gsd_write_chunk(&m_handle, "particles/position", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
         checkError(retval);
         }
@@ -536,7 +689,7 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -558,20 +711,21 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/orientation" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/orientation", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
             checkError(retval);
             }
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param frame Frame to write
 
     Writes the data chunks velocity, angmom, and image in particles/.
 */
-void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map)
+void GSDDumpWriter::writeMomenta(const Frame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& snapshot = frame.snapshot;
+    const std::map<unsigned int, unsigned int>& map = frame.map;
+    uint32_t N = frame.tags.size();
     int retval;
 
         {
@@ -580,7 +734,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -600,7 +754,6 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/velocity" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/velocity", GSD_TYPE_FLOAT, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             }
@@ -612,7 +765,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -634,7 +787,6 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/angmom" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/angmom", GSD_TYPE_FLOAT, N, 4, 0, (void *)&data[0]);
             checkError(retval);
             }
@@ -646,7 +798,7 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int t = frame.tags[group_idx];
 
             // look up tag in snapshot
             auto it = map.find(t);
@@ -666,7 +818,6 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
         if (! all_default)
             {
-            m_exec_conf->msg->notice(10) << "dump.gsd: writing particles/image" << endl;
             retval = gsd_write_chunk(&m_handle, "particles/image", GSD_TYPE_INT32, N, 3, 0, (void *)&data[0]);
             checkError(retval);
             }
@@ -681,89 +832,75 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot, co
 
     Write out all the snapshot data to the GSD file
 */
-void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
-                                  AngleData::Snapshot& angle,
-                                  DihedralData::Snapshot& dihedral,
-                                  ImproperData::Snapshot& improper,
-                                  ConstraintData::Snapshot& constraint)
+void GSDDumpWriter::writeTopology(const BondData::Snapshot& bond,
+                                  const AngleData::Snapshot& angle,
+                                  const DihedralData::Snapshot& dihedral,
+                                  const ImproperData::Snapshot& improper,
+                                  const ConstraintData::Snapshot& constraint)
     {
     if (bond.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/N" << endl;
         uint32_t N = bond.size;
         int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/typeid" << endl;
         retval = gsd_write_chunk(&m_handle, "bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&bond.type_id[0]);
         checkError(retval);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing bonds/group" << endl;
         retval = gsd_write_chunk(&m_handle, "bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&bond.groups[0]);
         checkError(retval);
         }
     if (angle.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/N" << endl;
         uint32_t N = angle.size;
         int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/typeid" << endl;
         retval = gsd_write_chunk(&m_handle, "angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&angle.type_id[0]);
         checkError(retval);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing angles/group" << endl;
         retval = gsd_write_chunk(&m_handle, "angles/group", GSD_TYPE_UINT32, N, 3, 0, (void *)&angle.groups[0]);
         checkError(retval);
         }
     if (dihedral.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
         int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/typeid" << endl;
         retval = gsd_write_chunk(&m_handle, "dihedrals/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&dihedral.type_id[0]);
         checkError(retval);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing dihedrals/group" << endl;
         retval = gsd_write_chunk(&m_handle, "dihedrals/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&dihedral.groups[0]);
         checkError(retval);
         }
     if (improper.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/N" << endl;
         uint32_t N = improper.size;
         int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/typeid" << endl;
         retval = gsd_write_chunk(&m_handle, "impropers/typeid", GSD_TYPE_UINT32, N, 1, 0, (void *)&improper.type_id[0]);
         checkError(retval);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing impropers/group" << endl;
         retval = gsd_write_chunk(&m_handle, "impropers/group", GSD_TYPE_UINT32, N, 4, 0, (void *)&improper.groups[0]);
         checkError(retval);
         }
 
     if (constraint.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/N" << endl;
         uint32_t N = constraint.size;
         int retval = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void *)&N);
         checkError(retval);
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/value" << endl;
             {
             std::vector<float> data(N);
             for (unsigned int i = 0; i < N; i++)
@@ -773,7 +910,6 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             checkError(retval);
             }
 
-        m_exec_conf->msg->notice(10) << "dump.gsd: writing constraints/group" << endl;
         retval = gsd_write_chunk(&m_handle, "constraints/group", GSD_TYPE_UINT32, N, 2, 0, (void *)&constraint.groups[0]);
         checkError(retval);
         }
@@ -787,5 +923,7 @@ void export_GSDDumpWriter(py::module& m)
         .def("setWriteProperty", &GSDDumpWriter::setWriteProperty)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
+        .def("setAsync", &GSDDumpWriter::setAsync)
+        .def("flush", &GSDDumpWriter::flush)
     ;
     }
@@ -10,6 +10,10 @@
 
 #include <string>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include "hoomd/extern/gsd.h"
 
 /*! \file GSDDumpWriter.h
@@ -30,6 +34,13 @@
     On the first call to analyze() \a fname is created with a dcd header. If it already
     exists, append to the file (unless the user specifies overwrite=True).
 
+    analyze() first copies everything it needs (snapshots, box, group member tags) into a Frame buffer and then writes
+    that buffer to the file. When asynchronous writes are enabled with setAsync(), the root rank hands the buffer to a
+    background writer thread and returns immediately, so that the reordering and file I/O of one frame overlap with the
+    simulation steps up to the next frame. Two Frame buffers are used alternately, and analyze() only waits for the
+    writer when the previous frame is still being written. Errors on the writer thread are rethrown by the next call to
+    analyze() or flush().
+
     \ingroup analyzers
 */
 class GSDDumpWriter : public Analyzer
@@ -66,6 +77,12 @@ class GSDDumpWriter : public Analyzer
             m_write_topology = b;
             }
 
+        //! Control asynchronous writes
+        void setAsync(bool async);
+
+        //! Wait until all frames are written to the file
+        void flush();
+
         //! Destructor
         ~GSDDumpWriter();
 
@@ -73,6 +90,27 @@ class GSDDumpWriter : public Analyzer
         void analyze(unsigned int timestep);
 
     private:
+        //! Data needed to write one frame of the file
+        struct Frame
+            {
+            unsigned int timestep;                      //!< Time step of the frame
+            uint64_t nframes;                           //!< Number of frames in the file before this one
+            bool truncate;                              //!< True if the file should be truncated before writing
+            bool write_attribute;                       //!< True if attributes should be written
+            bool write_property;                        //!< True if properties should be written
+            bool write_momentum;                        //!< True if momenta should be written
+            bool write_topology;                        //!< True if topology should be written
+            BoxDim global_box;                          //!< Global simulation box
+            std::vector<unsigned int> tags;             //!< Tags of the group members, in output order
+            SnapshotParticleData<float> snapshot;       //!< Particle data snapshot
+            std::map<unsigned int, unsigned int> map;   //!< Map from tags to snapshot indices
+            BondData::Snapshot bond;                    //!< Bond data snapshot
+            AngleData::Snapshot angle;                  //!< Angle data snapshot
+            DihedralData::Snapshot dihedral;            //!< Dihedral data snapshot
+            ImproperData::Snapshot improper;            //!< Improper data snapshot
+            ConstraintData::Snapshot constraint;        //!< Constraint data snapshot
+            };
+
         std::string m_fname;                //!< The file name we are writing to
         bool m_overwrite;                   //!< True if file should be overwritten
         bool m_truncate;                    //!< True if we should truncate the file on every analyze()
@@ -82,9 +120,31 @@ class GSDDumpWriter : public Analyzer
         bool m_write_momentum;              //!< True if momenta should be written
         bool m_write_topology;              //!< True if topology should be written
         gsd_handle m_handle;                //!< Handle to the file
+        uint64_t m_nframes;                 //!< Number of frames in the file, including frames not yet written
 
         std::shared_ptr<ParticleGroup> m_group;   //!< Group to write out to the file
 
+        Frame m_frames[2];                  //!< Frame buffers
+        unsigned int m_cur_frame;           //!< Index of the frame buffer to fill next
+
+        bool m_async;                               //!< True if frames are written by a background thread
+        std::thread m_writer_thread;                //!< Background writer thread
+        std::mutex m_writer_mutex;                  //!< Mutex protecting the writer state
+        std::condition_variable m_writer_cv;        //!< Signals changes of the writer state
+        bool m_writer_busy;                         //!< True while the writer thread has a frame to write
+        bool m_writer_stop;                         //!< True when the writer thread should exit
+        unsigned int m_writer_frame;                //!< Index of the frame buffer being written
+        std::exception_ptr m_writer_error;          //!< Exception thrown on the writer thread
+
+        //! Main loop of the background writer thread
+        void writerThread();
+
+        //! Write a buffered frame to the file
+        void writeFrame(const Frame& frame);
+
+        //! Print and rethrow an error that occured while writing a frame
+        void reportWriteError(std::exception_ptr error);
+
         //! Write a type mapping out to the file
         void writeTypeMapping(std::string chunk, std::vector< std::string > type_mapping);
 
@@ -92,23 +152,23 @@ class GSDDumpWriter : public Analyzer
         void initFileIO();
 
         //! Write frame header
-        void writeFrameHeader(unsigned int timestep);
+        void writeFrameHeader(const Frame& frame);
 
         //! Write particle attributes
-        void writeAttributes(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeAttributes(const Frame& frame);
 
         //! Write particle properties
-        void writeProperties(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeProperties(const Frame& frame);
 
         //! Write particle momenta
-        void writeMomenta(const SnapshotParticleData<float>& snapshot, const std::map<unsigned int, unsigned int> &map);
+        void writeMomenta(const Frame& frame);
 
         //! Write bond topology
-        void writeTopology(BondData::Snapshot& bond,
-                           AngleData::Snapshot& angle,
-                           DihedralData::Snapshot& dihedral,
-                           ImproperData::Snapshot& improper,
-                           ConstraintData::Snapshot& constraint);
+        void writeTopology(const BondData::Snapshot& bond,
+                           const AngleData::Snapshot& angle,
+                           const DihedralData::Snapshot& dihedral,
+                           const ImproperData::Snapshot& improper,
+                           const ConstraintData::Snapshot& constraint);
 
         //! Check and raise an exception if an error occurs
         void checkError(int retval);
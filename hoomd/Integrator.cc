@@ -25,7 +25,8 @@ using namespace std;
 /*! \param sysdef System to update
     \param deltaT Time step to use
 */
-Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
+Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT),
+    m_accumulate_forces(false)
     {
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
@@ -48,6 +49,8 @@ void Integrator::addForceCompute(std::shared_ptr<ForceCompute> fc)
     {
     assert(fc);
     m_forces.push_back(fc);
+    m_force_strides.push_back(1);
+    fc->setEvaluationStride(1);
     fc->setDeltaT(m_deltaT);
     }
 
@@ -66,9 +69,61 @@ void Integrator::addForceConstraint(std::shared_ptr<ForceConstraint> fc)
 void Integrator::removeForceComputes()
     {
     m_forces.clear();
+    m_force_strides.clear();
     m_constraint_forces.clear();
     }
 
+/*! \param fc ForceCompute previously added with addForceCompute()
+    \param stride Evaluate \a fc every \a stride time steps
+
+    See the class documentation for the multiple time step scheme. A stride of 1 evaluates \a fc every step.
+*/
+void Integrator::setForceStride(std::shared_ptr<ForceCompute> fc, unsigned int stride)
+    {
+    if (stride == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.*: The evaluation stride of a force must be at least 1" << endl;
+        throw runtime_error("Error setting force stride");
+        }
+
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (m_forces[i] == fc)
+            {
+            m_force_strides[i] = stride;
+            fc->setEvaluationStride(stride);
+            return;
+            }
+        }
+
+    m_exec_conf->msg->error() << "integrate.*: Cannot set the stride of a force that is not added to the integrator"
+                              << endl;
+    throw runtime_error("Error setting force stride");
+    }
+
+/*! \param fc ForceCompute previously added with addForceCompute()
+    \returns The evaluation stride of \a fc, 1 if \a fc is not added to the integrator
+*/
+unsigned int Integrator::getForceStride(std::shared_ptr<ForceCompute> fc)
+    {
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (m_forces[i] == fc)
+            return m_force_strides[i];
+        }
+    return 1;
+    }
+
+bool Integrator::hasForceStrides() const
+    {
+    for (unsigned int i = 0; i < m_force_strides.size(); i++)
+        {
+        if (m_force_strides[i] > 1)
+            return true;
+        }
+    return false;
+    }
+
 /*! \param deltaT New time step to set
 */
 void Integrator::setDeltaT(Scalar deltaT)
@@ -294,12 +349,47 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and \a m_net_virial
     \note The summation step is performed <b>on the CPU</b> and will result in a lot of data traffic back and forth
           if the forces and/or integrater are on the GPU. Call computeNetForcesGPU() to sum the forces on the GPU
+    \note With setAccumulateForces(), the net arrays are zeroed first and every force compute adds to them in
+          ForceCompute::accumulate(). Only the external virial and energy are summed here.
+    \note Forces with an evaluation stride (setForceStride()) are only computed on their outer steps, where their
+          force and torque are scaled by the stride. They are always summed from their own arrays.
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    // factor each force enters the net force with, 0 between the outer steps of a slow force
+    std::vector<Scalar> force_scale(m_forces.size());
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        force_scale[i] = getForceScale(i, timestep);
+
+    if (m_accumulate_forces)
+        {
+            {
+            // the force computes add to the net force arrays themselves, starting from zero
+            ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(), access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(), access_location::host, access_mode::overwrite);
+
+            memset((void *)h_net_force.data, 0, sizeof(Scalar4)*m_pdata->getNetForce().getNumElements());
+            memset((void *)h_net_virial.data, 0, sizeof(Scalar)*m_pdata->getNetVirial().getNumElements());
+            memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*m_pdata->getNetTorqueArray().getNumElements());
+            }
+
+        for (unsigned int i = 0; i < m_forces.size(); i++)
+            {
+            if (force_scale[i] == Scalar(1.0))
+                m_forces[i]->accumulate(timestep);
+            else if (force_scale[i] != Scalar(0.0))
+                m_forces[i]->compute(timestep);
+            }
+        }
+    else
+        {
+        for (unsigned int i = 0; i < m_forces.size(); i++)
+            {
+            if (force_scale[i] != Scalar(0.0))
+                m_forces[i]->compute(timestep);
+            }
+        }
 
     if (m_prof)
         {
@@ -314,14 +404,18 @@ void Integrator::computeNetForce(unsigned int timestep)
         const GPUArray<Scalar4>& net_force  = m_pdata->getNetForce();
         const GPUArray<Scalar>&  net_virial = m_pdata->getNetVirial();
         const GPUArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
-        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::overwrite);
+        const access_mode::Enum net_mode = m_accumulate_forces ? access_mode::readwrite : access_mode::overwrite;
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, net_mode);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, net_mode);
+        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, net_mode);
 
-        // start by zeroing the net force and virial arrays
-        memset((void *)h_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
-        memset((void *)h_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
-        memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
+        // start by zeroing the net force and virial arrays, unless the force computes already accumulated into them
+        if (!m_accumulate_forces)
+            {
+            memset((void *)h_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
+            memset((void *)h_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
+            memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
+            }
 
         for (unsigned int i = 0; i < 6; ++i)
            external_virial[i] = Scalar(0.0);
@@ -335,13 +429,25 @@ void Integrator::computeNetForce(unsigned int timestep)
         assert(6*nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        for (unsigned int i = 0; i < m_forces.size(); i++)
             {
+            Scalar scale = force_scale[i];
+            if (scale == Scalar(0.0))
+                continue;
+
+            for (unsigned int k = 0; k < 6; k++)
+                external_virial[k] += m_forces[i]->getExternalVirial(k);
+
+            external_energy += m_forces[i]->getExternalEnergy();
+
+            if (m_accumulate_forces && scale == Scalar(1.0))
+                continue;
+
             //phasing out ForceDataArrays
             //ForceDataArrays force_arrays = (*force_compute)->acquire();
-            GPUArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GPUArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GPUArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
+            GPUArray<Scalar4>& h_force_array = m_forces[i]->getForceArray();
+            GPUArray<Scalar>& h_virial_array = m_forces[i]->getVirialArray();
+            GPUArray<Scalar4>& h_torque_array = m_forces[i]->getTorqueArray();
 
             ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
             ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
@@ -350,14 +456,14 @@ void Integrator::computeNetForce(unsigned int timestep)
             unsigned int virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += scale*h_force.data[j].x;
+                h_net_force.data[j].y += scale*h_force.data[j].y;
+                h_net_force.data[j].z += scale*h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += scale*h_torque.data[j].x;
+                h_net_torque.data[j].y += scale*h_torque.data[j].y;
+                h_net_torque.data[j].z += scale*h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
                 for (unsigned int k = 0; k < 6; k++)
@@ -365,11 +471,6 @@ void Integrator::computeNetForce(unsigned int timestep)
                     h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
                     }
                 }
-
-            for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
-
-            external_energy += (*force_compute)->getExternalEnergy();
             }
         }
 
@@ -482,11 +583,19 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         throw runtime_error("Error computing accelerations");
         }
 
-    // compute all the normal forces first
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
+    // compute all the normal forces first, slow forces only on their outer steps
+    std::vector< std::shared_ptr<ForceCompute> > forces;
+    std::vector<Scalar> force_scale;
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        Scalar scale = getForceScale(i, timestep);
+        if (scale == Scalar(0.0))
+            continue;
 
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+        m_forces[i]->compute(timestep);
+        forces.push_back(m_forces[i]);
+        force_scale.push_back(scale);
+        }
 
     if (m_prof)
         {
@@ -522,7 +631,7 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the addition kernel
         // will do that
         // ahh!, but we do need to zer out the net force and virial if there are 0 forces!
-        if (m_forces.size() == 0)
+        if (forces.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             cudaMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
@@ -535,86 +644,92 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GPUArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GPUArray<Scalar4>& d_force_array0 = forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,access_location::device,access_mode::read);
-            const GPUArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GPUArray<Scalar>& d_virial_array0 = forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,access_location::device,access_mode::read);
-            const GPUArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GPUArray<Scalar4>& d_torque_array0 = forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,access_location::device,access_mode::read);
             force_list.f0 = d_force0.data;
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = force_scale[cur_force];
 
-            if (cur_force+1 < m_forces.size())
+            if (cur_force+1 < forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array1 = m_forces[cur_force+1]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array1 = forces[cur_force+1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array1 = m_forces[cur_force+1]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array1 = forces[cur_force+1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array1 = m_forces[cur_force+1]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array1 = forces[cur_force+1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,access_location::device,access_mode::read);
                 force_list.f1 = d_force1.data;
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = force_scale[cur_force+1];
                 }
-            if (cur_force+2 < m_forces.size())
+            if (cur_force+2 < forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array2 = m_forces[cur_force+2]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array2 = forces[cur_force+2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array2 = m_forces[cur_force+2]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array2 = forces[cur_force+2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array2 = m_forces[cur_force+2]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array2 = forces[cur_force+2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,access_location::device,access_mode::read);
                 force_list.f2 = d_force2.data;
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = force_scale[cur_force+2];
                 }
-            if (cur_force+3 < m_forces.size())
+            if (cur_force+3 < forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array3 = m_forces[cur_force+3]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array3 = forces[cur_force+3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array3 = m_forces[cur_force+3]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array3 = forces[cur_force+3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array3 = m_forces[cur_force+3]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array3 = forces[cur_force+3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,access_location::device,access_mode::read);
                 force_list.f3 = d_force3.data;
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = force_scale[cur_force+3];
                 }
-            if (cur_force+4 < m_forces.size())
+            if (cur_force+4 < forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array4 = m_forces[cur_force+4]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array4 = forces[cur_force+4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array4 = m_forces[cur_force+4]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array4 = forces[cur_force+4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array4 = m_forces[cur_force+4]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array4 = forces[cur_force+4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,access_location::device,access_mode::read);
                 force_list.f4 = d_force4.data;
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = force_scale[cur_force+4];
                 }
-            if (cur_force+5 < m_forces.size())
+            if (cur_force+5 < forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array5 = m_forces[cur_force+5]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array5 = forces[cur_force+5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array5 = m_forces[cur_force+5]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array5 = forces[cur_force+5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array5 = m_forces[cur_force+5]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array5 = forces[cur_force+5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,access_location::device,access_mode::read);
                 force_list.f5 = d_force5.data;
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = force_scale[cur_force+5];
                 }
 
             // clear on the first iteration only
@@ -638,11 +753,11 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         }
 
     // add up external virials and energies
-    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force ++)
+    for (unsigned int cur_force = 0; cur_force < forces.size(); cur_force ++)
         {
         for (unsigned int k = 0; k < 6; k++)
-            external_virial[k] += m_forces[cur_force]->getExternalVirial(k);
-        external_energy += m_forces[cur_force]->getExternalEnergy();
+            external_virial[k] += forces[cur_force]->getExternalVirial(k);
+        external_energy += forces[cur_force]->getExternalEnergy();
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -881,11 +996,12 @@ void Integrator::setCommunicator(std::shared_ptr<Communicator> comm)
 
 void Integrator::computeCallback(unsigned int timestep)
     {
-    // pre-compute all active forces
-    std::vector< std::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->preCompute(timestep);
+    // pre-compute all active forces, skipping slow forces between their outer steps
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (getForceScale(i, timestep) != Scalar(0.0))
+            m_forces[i]->preCompute(timestep);
+        }
     }
 #endif
 
@@ -914,6 +1030,10 @@ void export_Integrator(py::module& m)
     .def("addForceConstraint", &Integrator::addForceConstraint)
     .def("removeForceComputes", &Integrator::removeForceComputes)
     .def("setDeltaT", &Integrator::setDeltaT)
+    .def("setAccumulateForces", &Integrator::setAccumulateForces)
+    .def("getAccumulateForces", &Integrator::getAccumulateForces)
+    .def("setForceStride", &Integrator::setForceStride)
+    .def("getForceStride", &Integrator::getForceStride)
     .def("getNDOF", &Integrator::getNDOF)
     .def("getRotationalNDOF", &Integrator::getRotationalNDOF)
     ;
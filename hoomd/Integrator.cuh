@@ -16,7 +16,8 @@
 //! struct to pack up several force and virial arrays for addition
 /*! To keep the argument count down to gpu_integrator_sum_accel, up to 6 force/virial array pairs are packed up in this
     struct for addition to the net force/virial in a single kernel call. If there is not a multiple of 5 forces to sum,
-    set some of the pointers to NULL and they will be ignored.
+    set some of the pointers to NULL and they will be ignored. The force and torque of each array are multiplied by
+    its scale factor, the energy and virial are not.
 */
 struct gpu_force_list
     {
@@ -25,7 +26,8 @@ struct gpu_force_list
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL),
           t0(NULL), t1(NULL), t2(NULL), t3(NULL), t4(NULL), t5(NULL),
           v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0),
+          s0(1), s1(1), s2(1), s3(1), s4(1), s5(1)
           {
           }
 
@@ -56,6 +58,13 @@ struct gpu_force_list
     unsigned int vpitch3; //!< Pitch of virial array 3
     unsigned int vpitch4; //!< Pitch of virial array 4
     unsigned int vpitch5; //!< Pitch of virial array 5
+
+    Scalar s0; //!< Scale factor of force and torque array 0
+    Scalar s1; //!< Scale factor of force and torque array 1
+    Scalar s2; //!< Scale factor of force and torque array 2
+    Scalar s3; //!< Scale factor of force and torque array 3
+    Scalar s4; //!< Scale factor of force and torque array 4
+    Scalar s5; //!< Scale factor of force and torque array 5
  };
 
 //! Driver for gpu_integrator_sum_net_force_kernel()
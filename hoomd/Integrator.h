@@ -19,6 +19,7 @@
 #include "ForceCompute.h"
 #include "ForceConstraint.h"
 #include "ParticleGroup.h"
+#include <iostream>
 #include <string>
 #include <vector>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -49,6 +50,19 @@
     via the constraint forces can be totaled up with a call to getNDOFRemoved for convenience in derived classes
     implementing correct counting in getNDOF().
 
+    With setAccumulateForces(), computeNetForce() lets the force computes add their results directly to the net force
+    arrays through ForceCompute::accumulate(), which saves the per-compute arrays and the separate summation pass.
+    Only the CPU summation in computeNetForce() supports this, computeNetForceGPU() always sums the arrays.
+
+    For multiple time step (r-RESPA) integration, setForceStride() assigns an evaluation stride \a k to a force
+    compute. Such a slow force is evaluated only on time steps that are a multiple of \a k, where its force and torque
+    enter the net force multiplied by \a k. Because the velocity Verlet methods kick the velocities with the net force
+    at the end of one step and the beginning of the next, this applies the slow force as an impulse of \a k
+    \a deltaT at every outer step, while the fast forces are integrated with \a deltaT. The energy and virial of a
+    slow force are not scaled and only included in the net arrays on its outer steps. The stride is also passed to
+    the force compute (ForceCompute::setEvaluationStride()), so that work it starts outside of compute(), such as
+    the interior forces computed during the ghost update, follows the same schedule.
+
     Integrators take "ownership" of the particle's accellerations. Any other updater
     that modifies the particles accelerations will produce undefined results. If
     accelerations are to be modified, they must be done through forces, and added to
@@ -89,6 +103,24 @@ class Integrator : public Updater
         //! Return the timestep
         Scalar getDeltaT();
 
+        //! Set whether the force computes add their forces directly to the net force
+        void setAccumulateForces(bool accumulate)
+            {
+            m_accumulate_forces = accumulate;
+            }
+
+        //! Get whether the force computes add their forces directly to the net force
+        bool getAccumulateForces() const
+            {
+            return m_accumulate_forces;
+            }
+
+        //! Set the evaluation stride of a force compute for multiple time step integration
+        void setForceStride(std::shared_ptr<ForceCompute> fc, unsigned int stride);
+
+        //! Get the evaluation stride of a force compute
+        unsigned int getForceStride(std::shared_ptr<ForceCompute> fc);
+
         //! Get the number of degrees of freedom granted to a given group
         /*! \param group Group over which to count degrees of freedom.
             Base class Integrator returns 0. Derived classes should override.
@@ -122,6 +154,21 @@ class Integrator : public Updater
         //! Prepare for the run
         virtual void prepRun(unsigned int timestep);
 
+        //! Write the state needed for an exact restart to a binary checkpoint stream
+        /*! State that is kept in IntegratorData and ParticleData is written by CheckpointWriter itself. Derived
+            classes write any additional state that influences the trajectory here.
+        */
+        virtual void writeCheckpoint(std::ostream& out)
+            {
+            }
+
+        //! Read the state written by writeCheckpoint()
+        /*! Implementations set the failbit of \a in when the state does not match this integrator.
+        */
+        virtual void readCheckpoint(std::istream& in)
+            {
+            }
+
         #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm The Communicator
@@ -137,6 +184,20 @@ class Integrator : public Updater
         std::vector< std::shared_ptr<ForceCompute> > m_forces;    //!< List of all the force computes
 
         std::vector< std::shared_ptr<ForceConstraint> > m_constraint_forces;    //!< List of all the constraints
+        bool m_accumulate_forces;                                   //!< True if forces are accumulated in the net force
+        std::vector<unsigned int> m_force_strides;                  //!< Evaluation stride of each force in m_forces
+
+        //! Get the factor that the force of m_forces[i] enters the net force with at \a timestep
+        /*! \returns 0 if the force is not evaluated at \a timestep, its stride otherwise
+        */
+        Scalar getForceScale(unsigned int i, unsigned int timestep) const
+            {
+            unsigned int stride = m_force_strides[i];
+            return (timestep % stride == 0) ? Scalar(stride) : Scalar(0.0);
+            }
+
+        //! Test if any force compute has an evaluation stride larger than one
+        bool hasForceStrides() const;
 
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
@@ -32,7 +32,8 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<DomainDecomposition> decomposition)
         : Updater(sysdef), m_decomposition(decomposition), m_mpi_comm(m_exec_conf->getMPICommunicator()),
           m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
-          m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
+          m_needs_recount(false), m_cost_weighted(false), m_cost_measured(false), m_cost_per_particle(Scalar(1.0)),
+          m_hysteresis(Scalar(0.0)), m_balancing(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
           m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
           m_n_iterations(0), m_n_rebalances(0)
     {
@@ -79,12 +80,19 @@ void LoadBalancer::update(unsigned int timestep)
     Scalar3 L = box.getL();
     const Scalar3 min_domain_frac = Scalar(2.0)*m_comm->getGhostLayerMaxWidth()/box.getNearestPlaneDistance();
 
+    // measure the cost of the particles since the last update
+    if (m_cost_weighted)
+        updateCostPerParticle();
+
     // compute the current imbalance always for the average in printed stats
     m_total_max_imbalance += getMaxImbalance();
     ++m_n_calls;
 
+    // start balancing only above the hysteresis, but continue a started balancing down to the tolerance
+    bool balance = m_balancing || getMaxImbalance() > m_tolerance + m_hysteresis;
+
     // attempt load balancing
-    for (unsigned int cur_iter=0; cur_iter < m_maxiter && getMaxImbalance() > m_tolerance; ++cur_iter)
+    for (unsigned int cur_iter=0; balance && cur_iter < m_maxiter && getMaxImbalance() > m_tolerance; ++cur_iter)
         {
         // increment the number of attempted balances
         ++m_n_iterations;
@@ -112,10 +120,10 @@ void LoadBalancer::update(unsigned int timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> N_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
+            // reduce the load in the slice along dim
             bool active = reduce(N_i, dim, reduce_root);
 
             // attempt an adjustment
@@ -149,17 +157,75 @@ void LoadBalancer::update(unsigned int timestep)
             }
         }
 
+    m_balancing = balance && getMaxImbalance() > m_tolerance;
+
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all ranks.
+ * \param fc Force compute to add
+ */
+void LoadBalancer::addCostCompute(std::shared_ptr<ForceCompute> fc)
+    {
+    m_cost_computes.push_back(fc);
+    m_cost_compute_times.push_back(fc->getComputeTime());
+    }
+
+/*!
+ * \returns Wall clock time (in ns) the cost computes have spent on this rank since the last call
+ */
+double LoadBalancer::measureCost()
+    {
+    uint64_t cost = 0;
+    for (unsigned int i=0; i < m_cost_computes.size(); ++i)
+        {
+        const uint64_t cur_time = m_cost_computes[i]->getComputeTime();
+        cost += cur_time - m_cost_compute_times[i];
+        m_cost_compute_times[i] = cur_time;
+        }
+    return double(cost);
+    }
+
+/*!
+ * The cost per particle of the rank is normalized by the average cost per particle over all ranks, and averaged with
+ * the previous value. If no cost was measured on any rank (e.g. on the first update), the previous value is kept.
+ */
+void LoadBalancer::updateCostPerParticle()
+    {
+    double cost_N[2];
+    cost_N[0] = measureCost();
+    cost_N[1] = double(m_pdata->getN());
+
+    double total_cost_N[2];
+    MPI_Allreduce(cost_N, total_cost_N, 2, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+    if (total_cost_N[0] <= 0.0 || total_cost_N[1] <= 0.0)
+        return;
+
+    const double avg_cost = total_cost_N[0] / total_cost_N[1];
+    const Scalar cost_per_particle = (cost_N[1] > 0.0) ? Scalar(cost_N[0] / cost_N[1] / avg_cost) : Scalar(1.0);
+
+    if (m_cost_measured)
+        m_cost_per_particle = Scalar(0.5) * (m_cost_per_particle + cost_per_particle);
+    else
+        m_cost_per_particle = cost_per_particle;
+    m_cost_measured = true;
+    m_recompute_max_imbalance = true;
+    }
+
+/*!
+ * Computes the imbalance factor I = N / <N> for each rank (or the cost weighted equivalent), and computes the maximum
+ * among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn()) / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        const Scalar load = getLoad();
+        Scalar total_load = Scalar(m_pdata->getNGlobal());
+        if (m_cost_weighted)
+            MPI_Allreduce(&load, &total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+
+        Scalar cur_imb = load / (total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -174,7 +240,7 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param N_i Vector holding the total load (number of particles or their cost) in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
  * \returns true if the current rank holds the active \a N_i
@@ -190,18 +256,18 @@ Scalar LoadBalancer::getMaxImbalance()
  * down dimensions. Generally, load balancing should not be performed too frequently, and so we do not pursue this
  * optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
     if (N_i.size() == 1) return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> N_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    Scalar N_own = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&N_own, 1, MPI_HOOMD_SCALAR, &N_per_rank[0], 1, MPI_HOOMD_SCALAR, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -209,7 +275,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
     // rearrange the data from ranks to cartesian order in case it is jumbled around
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(), access_location::host, access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> N_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank=0; cur_rank < di.getNumElements(); ++cur_rank)
         {
         N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
@@ -221,7 +287,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getW());
         for (unsigned int i=0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            N_i[i] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int j=0; j < di.getH(); ++j)
@@ -236,7 +302,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getH());
         for (unsigned int j=0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            N_i[j] = Scalar(0.0);
             for (unsigned int k=0; k < di.getD(); ++k)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
@@ -251,7 +317,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
         N_i.clear(); N_i.resize(di.getD());
         for (unsigned int k=0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            N_i[k] = Scalar(0.0);
             for (unsigned int j=0; j < di.getH(); ++j)
                 {
                 for (unsigned int i=0; i < di.getW(); ++i)
@@ -272,7 +338,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param N_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -290,15 +356,15 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsi
  *     successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& N_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution (the total is the number of particles without cost weighting)
+    const Scalar target = std::accumulate(N_i.begin(), N_i.end(), Scalar(0.0)) / Scalar(N_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -312,7 +378,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     vector<Scalar> new_widths(N_i.size());
     for (unsigned int i=0; i < N_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
+        const Scalar imb_factor = N_i[i] / target;
         Scalar scale_factor = (N_i[i] > 0) ? Scalar(1.0) / imb_factor : (Scalar(1.0) + m_max_scale); // as in gromacs, use half the imbalance factor to scale
 
         // limit rescaling to 5% either direction
@@ -577,6 +643,12 @@ void export_LoadBalancer(py::module& m)
     .def("setTolerance", &LoadBalancer::setTolerance)
     .def("getMaxIterations", &LoadBalancer::getMaxIterations)
     .def("setMaxIterations", &LoadBalancer::setMaxIterations)
+    .def("getCostWeighted", &LoadBalancer::getCostWeighted)
+    .def("setCostWeighted", &LoadBalancer::setCostWeighted)
+    .def("getHysteresis", &LoadBalancer::getHysteresis)
+    .def("setHysteresis", &LoadBalancer::setHysteresis)
+    .def("addCostCompute", &LoadBalancer::addCostCompute)
+    .def("removeCostComputes", &LoadBalancer::removeCostComputes)
     ;
     }
 #endif // ENABLE_MPI
@@ -18,6 +18,7 @@
 #define __LOADBALANCER_H__
 
 #include "Updater.h"
+#include "ForceCompute.h"
 
 #include <memory>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
@@ -41,6 +42,19 @@
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost function is the
  * deviation of the domain sizes from the proposed rescaled width.
  *
+ * <b>Cost weighted balancing:</b>
+ *
+ * When the cost per particle varies across the box, equal particle counts still leave ranks idle. With
+ * setCostWeighted(), the load of a rank is instead the number of particles it owns times its cost per particle. The
+ * cost is the wall clock time spent in the ForceComputes added with addCostCompute() since the previous update,
+ * divided by the number of local particles and normalized by the average over all ranks, so that the loads still sum
+ * to about N. The cost per particle is averaged with the previous measurement to damp noise. During an update, the
+ * cost per particle of each rank is assumed to stay constant as particles move between domains.
+ *
+ * The measured cost fluctuates, so balancing has a hysteresis: an update starts balancing only when the maximum
+ * imbalance exceeds the tolerance plus the hysteresis. Once started, balancing continues in the following updates
+ * until the imbalance drops below the tolerance. This keeps the domains from oscillating around the tolerance.
+ *
  * \ingroup updaters
  */
 class LoadBalancer : public Updater
@@ -100,6 +114,52 @@ class LoadBalancer : public Updater
                 }
             }
 
+        //! Enable / disable balancing of the measured cost instead of the particle count
+        void setCostWeighted(bool enable)
+            {
+            m_cost_weighted = enable;
+            m_cost_measured = false;
+            m_cost_per_particle = Scalar(1.0);
+            m_recompute_max_imbalance = true;
+            }
+
+        //! Get whether the measured cost is balanced instead of the particle count
+        bool getCostWeighted() const
+            {
+            return m_cost_weighted;
+            }
+
+        //! Set the hysteresis for starting a balancing
+        /*!
+         * \param hysteresis Balancing starts when the imbalance exceeds tolerance + \a hysteresis and continues until it
+         *                   drops below the tolerance
+         */
+        void setHysteresis(Scalar hysteresis)
+            {
+            if (hysteresis < Scalar(0.0))
+                {
+                m_exec_conf->msg->error() << "comm.balance: hysteresis must be non-negative" << std::endl;
+                throw std::runtime_error("Error setting load balancer parameters");
+                }
+            m_hysteresis = hysteresis;
+            }
+
+        //! Get the hysteresis for starting a balancing
+        Scalar getHysteresis() const
+            {
+            return m_hysteresis;
+            }
+
+        //! Add a force compute whose run time counts toward the cost of a rank
+        void addCostCompute(std::shared_ptr<ForceCompute> fc);
+
+        //! Remove all force computes from the cost
+        void removeCostComputes()
+            {
+            m_cost_computes.clear();
+            m_cost_compute_times.clear();
+            }
+
         //! Take one timestep forward
         virtual void update(unsigned int timestep);
 
@@ -119,8 +179,8 @@ class LoadBalancer : public Updater
         Scalar m_max_imbalance;             //!< Maximum imbalance
         bool m_recompute_max_imbalance;     //!< Flag if maximum imbalance needs to be computed
 
-        //! Reduce the particle numbers per rank down to one dimension
-        bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+        //! Reduce the loads per rank down to one dimension
+        bool reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root);
 
         //! Set flags within the class that a resize has been performed
         void signalResize()
@@ -132,7 +192,7 @@ class LoadBalancer : public Updater
 
         //! Adjust the partitioning along a single dimension
         bool adjust(std::vector<Scalar>& cum_frac_i,
-                    const std::vector<unsigned int>& N_i,
+                    const std::vector<Scalar>& N_i,
                     Scalar L_i,
                     Scalar min_domain_frac);
         bool m_needs_migrate;   //!< Flag to signal that migration is necessary
@@ -162,6 +222,26 @@ class LoadBalancer : public Updater
             }
         bool m_needs_recount;   //!< Flag if a particle change needs to be computed
 
+        //! Gets the load of the rank, the number of owned particles weighted by their cost if enabled
+        Scalar getLoad()
+            {
+            return m_cost_weighted ? Scalar(getNOwn()) * m_cost_per_particle : Scalar(getNOwn());
+            }
+
+        //! Measure the cost of the rank since the last call
+        virtual double measureCost();
+
+        //! Update the cost per particle of the rank from a new measurement
+        void updateCostPerParticle();
+
+        bool m_cost_weighted;               //!< Flag to balance the measured cost instead of the particle count
+        bool m_cost_measured;               //!< Flag if the cost per particle has been measured
+        Scalar m_cost_per_particle;         //!< Normalized cost per particle of this rank
+        Scalar m_hysteresis;                //!< Excess imbalance over the tolerance required to start balancing
+        bool m_balancing;                   //!< Flag if balancing continues from the previous update
+        std::vector< std::shared_ptr<ForceCompute> > m_cost_computes;   //!< Force computes that make up the cost
+        std::vector<uint64_t> m_cost_compute_times;     //!< Compute times of m_cost_computes at the last measurement
+
         Scalar m_tolerance;     //!< Load imbalance to tolerate
         unsigned int m_maxiter; //!< Maximum number of iterations to attempt
         bool m_enable_x;        //!< Flag to enable balancing in x
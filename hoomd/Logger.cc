@@ -22,6 +22,7 @@ namespace py = pybind11;
 
 #include <stdexcept>
 #include <iomanip>
+#include <string.h>
 using namespace std;
 
 /*! \param sysdef Specified for Analyzer, but not used directly by Logger
@@ -39,7 +40,8 @@ Logger::Logger(std::shared_ptr<SystemDefinition> sysdef,
                const std::string& header_prefix,
                bool overwrite)
     : Analyzer(sysdef), m_delimiter("\t"), m_filename(fname), m_header_prefix(header_prefix), m_appending(!overwrite),
-                        m_is_initialized(false), m_file_output(true)
+                        m_is_initialized(false), m_file_output(true), m_binary(false), m_buffer_rows(0),
+                        m_num_buffered(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing Logger: " << fname << " " << header_prefix << " " << overwrite << endl;
 
@@ -59,16 +61,18 @@ void Logger::openOutputFiles()
         if (! m_exec_conf->isRoot())
             return;
 #endif
+    ios_base::openmode mode = m_binary ? ios_base::binary : ios_base::openmode(0);
+
     // open the file
     if (filesystem::exists(m_filename) && m_appending)
         {
         m_exec_conf->msg->notice(3) << "analyze.log: Appending log to existing file \"" << m_filename << "\"" << endl;
-        m_file.open(m_filename.c_str(), ios_base::in | ios_base::out | ios_base::ate);
+        m_file.open(m_filename.c_str(), ios_base::in | ios_base::out | ios_base::ate | mode);
         }
     else
         {
         m_exec_conf->msg->notice(3) << "analyze.log: Creating new log in file \"" << m_filename << "\"" << endl;
-        m_file.open(m_filename.c_str(), ios_base::out);
+        m_file.open(m_filename.c_str(), ios_base::out | mode);
         m_appending = false;
         }
 
@@ -77,11 +81,65 @@ void Logger::openOutputFiles()
         m_exec_conf->msg->error() << "analyze.log: Error opening log file " << m_filename << endl;
         throw runtime_error("Error initializing Logger");
         }
+
+    if (m_binary)
+        {
+        char magic[8] = {'H','O','O','M','D','L','O','G'};
+        uint32_t version = 1;
+        uint32_t byte_order = 0x01020304;
+
+        // an existing empty file is treated like a new one
+        if (m_appending)
+            {
+            ifstream f(m_filename.c_str(), ios_base::in | ios_base::binary | ios_base::ate);
+            if (f.tellg() == 0)
+                m_appending = false;
+            }
+
+        if (m_appending)
+            {
+            // check that we are appending to a binary log
+            char file_magic[8];
+            uint32_t file_version = 0;
+            uint32_t file_byte_order = 0;
+            ifstream f(m_filename.c_str(), ios_base::in | ios_base::binary);
+            f.read(file_magic, 8);
+            f.read((char *)&file_version, sizeof(uint32_t));
+            f.read((char *)&file_byte_order, sizeof(uint32_t));
+            if (!f.good() || memcmp(magic, file_magic, 8) != 0 || file_version != version)
+                {
+                m_exec_conf->msg->error() << "analyze.log: " << m_filename << " is not a binary log file" << endl;
+                throw runtime_error("Error initializing Logger");
+                }
+            if (file_byte_order != byte_order)
+                {
+                m_exec_conf->msg->error() << "analyze.log: Cannot append to " << m_filename
+                                          << ", it was written with a different byte order" << endl;
+                throw runtime_error("Error initializing Logger");
+                }
+            }
+        else
+            {
+            m_file.write(magic, 8);
+            m_file.write((char *)&version, sizeof(uint32_t));
+            m_file.write((char *)&byte_order, sizeof(uint32_t));
+            }
+        }
     }
 
 Logger::~Logger()
     {
     m_exec_conf->msg->notice(5) << "Destroying Logger" << endl;
+
+    // write out the remaining buffered rows
+    try
+        {
+        flush();
+        }
+    catch (std::exception& e)
+        {
+        m_exec_conf->msg->error() << "analyze.log: " << e.what() << endl;
+        }
     }
 
 /*! \param compute The Compute to register
@@ -167,6 +225,9 @@ void Logger::removeAll()
 */
 void Logger::setLoggedQuantities(const std::vector< std::string >& quantities)
     {
+    // buffered rows belong to the previous columns
+    flush();
+
     m_logged_quantities = quantities;
 
     // prepare or adjust storage for caching the logger properties.
@@ -186,6 +247,19 @@ void Logger::setLoggedQuantities(const std::vector< std::string >& quantities)
 
     m_is_initialized = true;
 
+    if (m_binary)
+        {
+        m_buffer.resize(quantities.size() * m_buffer_rows);
+
+        // binary files are self describing, always write the header
+        if (m_file_output)
+            writeBinaryHeader();
+
+        if (quantities.size() == 0)
+            m_exec_conf->msg->warning() << "analyze.log: No quantities specified for logging" << endl;
+        return;
+        }
+
     // only write the header if this is a new file
     if (!m_appending && m_file_output)
         {
@@ -225,6 +299,79 @@ void Logger::setDelimiter(const std::string& delimiter)
     m_delimiter = delimiter;
     }
 
+/*! \param buffer_rows Number of rows to buffer in memory before writing them to the file
+
+    Must be called before the first call to setLoggedQuantities().
+*/
+void Logger::setBinary(unsigned int buffer_rows)
+    {
+    if (m_is_initialized)
+        {
+        m_exec_conf->msg->error() << "analyze.log: Binary output must be selected before the log file is opened" << endl;
+        throw runtime_error("Error initializing Logger");
+        }
+    if (buffer_rows == 0)
+        {
+        m_exec_conf->msg->error() << "analyze.log: The binary log buffer must hold at least one row" << endl;
+        throw runtime_error("Error initializing Logger");
+        }
+
+    m_binary = true;
+    m_buffer_rows = buffer_rows;
+    m_buffer_timestep.resize(buffer_rows);
+    }
+
+/*! Writes the header record with the names of the logged quantities to a binary file
+*/
+void Logger::writeBinaryHeader()
+    {
+    uint32_t type = LOG_RECORD_HEADER;
+    uint32_t n_columns = m_logged_quantities.size();
+    m_file.write((char *)&type, sizeof(uint32_t));
+    m_file.write((char *)&n_columns, sizeof(uint32_t));
+
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        {
+        uint32_t len = m_logged_quantities[i].size();
+        m_file.write((char *)&len, sizeof(uint32_t));
+        m_file.write(m_logged_quantities[i].c_str(), len);
+        }
+    m_file.flush();
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.log: I/O error while writing log file" << endl;
+        throw runtime_error("Error writting log file");
+        }
+    }
+
+/*! Writes all rows in the binary buffer to the file as one block. Does nothing for text files, which are written
+    row by row.
+*/
+void Logger::flush()
+    {
+    // only the root processor buffers rows
+    if (!m_binary || m_num_buffered == 0)
+        return;
+
+    uint32_t type = LOG_RECORD_BLOCK;
+    uint32_t n_rows = m_num_buffered;
+    m_file.write((char *)&type, sizeof(uint32_t));
+    m_file.write((char *)&n_rows, sizeof(uint32_t));
+    m_file.write((char *)&m_buffer_timestep[0], sizeof(uint64_t)*n_rows);
+    for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+        m_file.write((char *)&m_buffer[i*m_buffer_rows], sizeof(double)*n_rows);
+    m_file.flush();
+
+    m_num_buffered = 0;
+
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "analyze.log: I/O error while writing log file" << endl;
+        throw runtime_error("Error writting log file");
+        }
+    }
+
 /*! \param timestep Time step to write out data for
 
     Writes a single line of output to the log file with each specified quantity separated by
@@ -254,6 +401,21 @@ void Logger::analyze(unsigned int timestep)
             }
 #endif
 
+    if (m_binary)
+        {
+        // store the row in the buffer and write out full buffers
+        m_buffer_timestep[m_num_buffered] = timestep;
+        for (unsigned int i = 0; i < m_logged_quantities.size(); i++)
+            m_buffer[i*m_buffer_rows + m_num_buffered] = double(m_cached_quantities[i]);
+        m_num_buffered++;
+
+        if (m_num_buffered == m_buffer_rows)
+            flush();
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // The timestep is always output
     m_file << setprecision(10) << timestep;
 
@@ -319,6 +481,29 @@ Scalar Logger::getValue(const std::string &quantity, int timestep)
         {
         return Scalar(double(m_clk.getTime())/1e9);
         }
+    // then the built-in memory quantities, in MiB
+    else if (quantity == "memory_host" || quantity == "memory_host_peak" ||
+             quantity == "memory_device" || quantity == "memory_device_peak")
+        {
+        std::shared_ptr<MemoryTracker> tracker = m_exec_conf->getMemoryTracker();
+        double bytes;
+        if (quantity == "memory_host")
+            bytes = double(tracker->getHostBytes());
+        else if (quantity == "memory_host_peak")
+            bytes = double(tracker->getPeakHostBytes());
+        else if (quantity == "memory_device")
+            bytes = double(tracker->getDeviceBytes());
+        else
+            bytes = double(tracker->getPeakDeviceBytes());
+
+        #ifdef ENABLE_MPI
+        // report the rank that uses the most memory
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &bytes, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        #endif
+
+        return Scalar(bytes/(1024.0*1024.0));
+        }
     // check to see if the quantity exists in the compute list
     else if (m_compute_quantities.count(quantity))
         {
@@ -366,6 +551,8 @@ void export_Logger(py::module& m)
     .def("removeAll", &Logger::removeAll)
     .def("setLoggedQuantities", &Logger::setLoggedQuantities)
     .def("setDelimiter", &Logger::setDelimiter)
+    .def("setBinary", &Logger::setBinary)
+    .def("flush", &Logger::flush)
     .def("getQuantity", &Logger::getQuantity)
     ;
     }
@@ -46,6 +46,16 @@
     As an option, Logger can be initialized with no file. Such a logger will skip doing anything during
     analyze() but is still available for getQuantity() operations.
 
+    When binary output is selected with setBinary() (before setLoggedQuantities()), analyze() stores the values in a
+    columnar memory buffer instead of formatting them. Full buffers are written to the file as one block, and flush()
+    writes out a partially filled buffer. The binary file starts with the magic string "HOOMDLOG", a uint32 version and
+    the uint32 byte order mark 0x01020304, followed by a sequence of records, each starting with a uint32 record type:
+     - LOG_RECORD_HEADER: uint32 number of columns, then for each column a uint32 length and the name (not terminated)
+     - LOG_RECORD_BLOCK: uint32 number of rows n, n uint64 time steps, then n doubles for each column in order
+    A header record is written every time setLoggedQuantities() is called and applies to all following blocks. All
+    values are stored in the native (host) byte order, which readers detect from the byte order mark.
+    hoomd.analyze.convert_binary_log() converts such files to text.
+
     \ingroup analyzers
 */
 class Logger : public Analyzer
@@ -78,6 +88,12 @@ class Logger : public Analyzer
         //! Sets the delimiter to use between fields
         void setDelimiter(const std::string& delimiter);
 
+        //! Selects binary output with a buffer of the given number of rows
+        void setBinary(unsigned int buffer_rows);
+
+        //! Write all buffered rows to the file
+        void flush();
+
         //! Query the current value for a given quantity
         Scalar getQuantity(const std::string& quantity, unsigned int timestep, bool use_cache);
 
@@ -126,6 +142,19 @@ class Logger : public Analyzer
         bool m_is_initialized;
         //! true if we are writing to the output file
         bool m_file_output;
+        //! true if the output file is binary
+        bool m_binary;
+        //! Number of rows that fit in the binary buffer
+        unsigned int m_buffer_rows;
+        //! Number of rows currently in the binary buffer
+        unsigned int m_num_buffered;
+        //! Time steps of the buffered rows
+        std::vector< uint64_t > m_buffer_timestep;
+        //! Buffered values, column major with a stride of m_buffer_rows
+        std::vector< double > m_buffer;
+
+        //! Helper function to write the header record of a binary file
+        void writeBinaryHeader();
 
         //! Helper function to get a value for a given quantity
         Scalar getValue(const std::string &quantity, int timestep);
@@ -134,6 +163,13 @@ class Logger : public Analyzer
         void openOutputFiles();
     };
 
+//! Record types in binary log files
+enum log_record_type
+    {
+    LOG_RECORD_HEADER = 1,  //!< List of column names
+    LOG_RECORD_BLOCK = 2    //!< Block of rows
+    };
+
 //! exports the Logger class to python
 void export_Logger(pybind11::module& m);
 
@@ -0,0 +1,158 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MemoryTracker.cc
+    \brief Defines the MemoryTracker class
+*/
+
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+using namespace std;
+
+void MemoryTracker::Usage::add(const Allocation& a)
+    {
+    host_bytes += a.host_bytes;
+    device_bytes += a.device_bytes;
+    num_allocations++;
+
+    peak_host_bytes = std::max(peak_host_bytes, host_bytes);
+    peak_device_bytes = std::max(peak_device_bytes, device_bytes);
+    }
+
+void MemoryTracker::Usage::remove(const Allocation& a)
+    {
+    host_bytes -= a.host_bytes;
+    device_bytes -= a.device_bytes;
+    num_allocations--;
+    }
+
+MemoryTracker::MemoryTracker()
+    {
+    }
+
+/*! \param ptr Host pointer of the allocation
+    \param host_bytes Number of bytes allocated on the host
+    \param device_bytes Number of bytes allocated on the device
+    \param tag Owner and name of the allocation
+
+    A pointer that is already registered is replaced.
+*/
+void MemoryTracker::registerAllocation(const void *ptr, size_t host_bytes, size_t device_bytes, const std::string& tag)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<const void*, Allocation>::iterator it = m_allocations.find(ptr);
+    if (it != m_allocations.end())
+        {
+        m_usage[it->second.tag].remove(it->second);
+        m_total.remove(it->second);
+        m_allocations.erase(it);
+        }
+
+    Allocation a;
+    a.host_bytes = host_bytes;
+    a.device_bytes = device_bytes;
+    a.tag = tag;
+
+    m_allocations[ptr] = a;
+    m_usage[tag].add(a);
+    m_total.add(a);
+    }
+
+/*! \param ptr Host pointer of the allocation
+
+    Unknown pointers are ignored.
+*/
+void MemoryTracker::unregisterAllocation(const void *ptr)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<const void*, Allocation>::iterator it = m_allocations.find(ptr);
+    if (it == m_allocations.end())
+        return;
+
+    m_usage[it->second.tag].remove(it->second);
+    m_total.remove(it->second);
+    m_allocations.erase(it);
+    }
+
+/*! \param ptr Host pointer of the allocation
+    \param tag New tag
+
+    The allocation is moved from the usage of the old tag to the usage of the new one. The total is unchanged.
+*/
+void MemoryTracker::updateTag(const void *ptr, const std::string& tag)
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<const void*, Allocation>::iterator it = m_allocations.find(ptr);
+    if (it == m_allocations.end() || it->second.tag == tag)
+        return;
+
+    m_usage[it->second.tag].remove(it->second);
+    it->second.tag = tag;
+    m_usage[tag].add(it->second);
+    }
+
+void MemoryTracker::resetPeak()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_total.peak_host_bytes = m_total.host_bytes;
+    m_total.peak_device_bytes = m_total.device_bytes;
+
+    for (std::map<std::string, Usage>::iterator it = m_usage.begin(); it != m_usage.end(); ++it)
+        {
+        it->second.peak_host_bytes = it->second.host_bytes;
+        it->second.peak_device_bytes = it->second.device_bytes;
+        }
+    }
+
+//! Helper to sort the usage table by decreasing peak memory
+static bool compare_peak(const std::pair<std::string, std::pair<size_t, size_t> >& a,
+                         const std::pair<std::string, std::pair<size_t, size_t> >& b)
+    {
+    return a.second.first + a.second.second > b.second.first + b.second.second;
+    }
+
+/*! \param o Stream to write to
+
+    Lists the current and peak host and device memory in MiB for every tag that has allocated memory, ordered by the
+    sum of the peak host and device memory.
+*/
+void MemoryTracker::writeBreakdown(std::ostream& o) const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector< std::pair<std::string, std::pair<size_t, size_t> > > order;
+    for (std::map<std::string, Usage>::const_iterator it = m_usage.begin(); it != m_usage.end(); ++it)
+        {
+        if (it->second.peak_host_bytes + it->second.peak_device_bytes == 0)
+            continue;
+        order.push_back(std::make_pair(it->first,
+            std::make_pair(it->second.peak_host_bytes, it->second.peak_device_bytes)));
+        }
+    std::sort(order.begin(), order.end(), compare_peak);
+
+    const double MiB = 1024.0*1024.0;
+    o << setw(12) << "host MiB" << setw(12) << "peak" << setw(12) << "device MiB" << setw(12) << "peak"
+      << setw(8) << "arrays" << "  allocation" << endl;
+
+    for (unsigned int i = 0; i < order.size(); ++i)
+        {
+        const Usage& u = m_usage.find(order[i].first)->second;
+        o << fixed << setprecision(3)
+          << setw(12) << double(u.host_bytes)/MiB << setw(12) << double(u.peak_host_bytes)/MiB
+          << setw(12) << double(u.device_bytes)/MiB << setw(12) << double(u.peak_device_bytes)/MiB
+          << setw(8) << u.num_allocations << "  " << (order[i].first.empty() ? "(untagged)" : order[i].first) << endl;
+        }
+
+    o << setw(12) << double(m_total.host_bytes)/MiB << setw(12) << double(m_total.peak_host_bytes)/MiB
+      << setw(12) << double(m_total.device_bytes)/MiB << setw(12) << double(m_total.peak_device_bytes)/MiB
+      << setw(8) << m_total.num_allocations << "  total" << endl;
+    o.unsetf(ios_base::floatfield);
+    }
@@ -0,0 +1,114 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MemoryTracker.h
+    \brief Declares the MemoryTracker class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <iostream>
+
+#ifndef __MEMORY_TRACKER_H__
+#define __MEMORY_TRACKER_H__
+
+//! Keeps a registry of the memory allocated by GPUArray and GPUVector
+/*! Every GPUArray registers its host allocation with the MemoryTracker of its ExecutionConfiguration, together with
+    the number of device bytes that mirror it and a tag naming the owning class and member (e.g.
+    "NeighborList::m_nlist"). Allocations that have not been tagged are accounted for under an empty tag.
+
+    The tracker keeps the current and peak number of host and device bytes, both in total and per tag, so that the
+    largest consumers and arrays that keep growing during a run can be identified. All numbers refer to the local rank.
+
+    Allocations are identified by their host pointer. The methods may be called concurrently from several threads.
+
+    \ingroup utils
+*/
+class MemoryTracker
+    {
+    public:
+        //! Constructor
+        MemoryTracker();
+
+        //! Record a new allocation
+        void registerAllocation(const void *ptr, size_t host_bytes, size_t device_bytes, const std::string& tag);
+
+        //! Remove an allocation from the registry
+        void unregisterAllocation(const void *ptr);
+
+        //! Change the tag of a registered allocation
+        void updateTag(const void *ptr, const std::string& tag);
+
+        //! Get the number of host bytes currently allocated
+        size_t getHostBytes() const
+            {
+            return m_total.host_bytes;
+            }
+
+        //! Get the number of device bytes currently allocated
+        size_t getDeviceBytes() const
+            {
+            return m_total.device_bytes;
+            }
+
+        //! Get the largest number of host bytes allocated at any time
+        size_t getPeakHostBytes() const
+            {
+            return m_total.peak_host_bytes;
+            }
+
+        //! Get the largest number of device bytes allocated at any time
+        size_t getPeakDeviceBytes() const
+            {
+            return m_total.peak_device_bytes;
+            }
+
+        //! Reset the peak values to the current usage
+        void resetPeak();
+
+        //! Write a table of the memory usage per tag, largest peak first
+        void writeBreakdown(std::ostream& o) const;
+
+    private:
+        //! A single registered allocation
+        struct Allocation
+            {
+            size_t host_bytes;          //!< Number of host bytes
+            size_t device_bytes;        //!< Number of device bytes
+            std::string tag;            //!< Owner and name of the allocation
+            };
+
+        //! Accumulated usage of a group of allocations
+        struct Usage
+            {
+            //! Default constructor
+            Usage()
+                : host_bytes(0), device_bytes(0), peak_host_bytes(0), peak_device_bytes(0), num_allocations(0)
+                {
+                }
+
+            //! Add an allocation and update the peak values
+            void add(const Allocation& a);
+
+            //! Remove an allocation
+            void remove(const Allocation& a);
+
+            size_t host_bytes;          //!< Current number of host bytes
+            size_t device_bytes;        //!< Current number of device bytes
+            size_t peak_host_bytes;     //!< Peak number of host bytes
+            size_t peak_device_bytes;   //!< Peak number of device bytes
+            unsigned int num_allocations; //!< Current number of allocations
+            };
+
+        std::map<const void*, Allocation> m_allocations;    //!< Registered allocations by host pointer
+        std::map<std::string, Usage> m_usage;               //!< Usage per tag
+        Usage m_total;                                      //!< Total usage
+        mutable std::mutex m_mutex;                         //!< Protects the registry
+    };
+
+#endif
@@ -59,10 +59,13 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
           m_nghosts(0),
           m_max_nparticles(0),
           m_nglobal(0),
+          m_sort_order(NULL),
           m_resize_factor(9./8.)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
+    registerReorderArrays();
+
     // check the input for errors
     if (n_types == 0)
         {
@@ -134,10 +137,13 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
       m_nghosts(0),
       m_max_nparticles(0),
       m_nglobal(0),
+      m_sort_order(NULL),
       m_resize_factor(9./8.)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
+    registerReorderArrays();
+
     #ifdef ENABLE_MPI
     // Set up domain decomposition information
     if (decomposition) setDomainDecomposition(decomposition);
@@ -234,6 +240,65 @@ void ParticleData::notifyParticleSort()
     m_sort_signal.emit();
     }
 
+/*! \param order Permutation of the local particles: new index i takes the data of old index order[i]
+
+    All arrays registered with getParticleReorder() are permuted and the reverse-lookup tags of the local particles
+    are updated. Subscribers to the sort signal can query the permutation with getSortOrder() and
+    getInverseSortOrder() while it is emitted. Ghost particles keep their indices.
+
+    \note The call must be made after calling release()
+*/
+void ParticleData::reorderParticles(const std::vector<unsigned int>& order)
+    {
+    assert(order.size() >= getN());
+    unsigned int N = getN();
+
+    if (N > 0)
+        {
+        m_reorder.apply(&order[0], N);
+
+        // rebuild the reverse-lookup tags of the local particles
+        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            h_rtag.data[h_tag.data[i]] = i;
+
+        m_sort_inverse.resize(N);
+        for (unsigned int i = 0; i < N; i++)
+            m_sort_inverse[order[i]] = i;
+
+        m_sort_order = &order[0];
+        }
+
+    notifyParticleSort();
+
+    m_sort_order = NULL;
+    }
+
+/*! Registers all per-particle arrays of the local particles with m_reorder. The arrays are referenced, so this only
+    needs to be done once at construction.
+*/
+void ParticleData::registerReorderArrays()
+    {
+    m_reorder.addArray(m_pos);
+    m_reorder.addArray(m_vel);
+    m_reorder.addArray(m_accel);
+    m_reorder.addArray(m_charge);
+    m_reorder.addArray(m_diameter);
+    m_reorder.addArray(m_image);
+    m_reorder.addArray(m_tag);
+    m_reorder.addArray(m_body);
+    m_reorder.addArray(m_orientation);
+    m_reorder.addArray(m_angmom);
+    m_reorder.addArray(m_inertia);
+    m_reorder.addArray(m_net_force);
+    m_reorder.addArray(m_net_virial, 6);
+    m_reorder.addArray(m_net_torque);
+    #ifdef ENABLE_MPI
+    m_reorder.addArray(m_comm_flags);
+    #endif
+    }
+
 /*! This function is called any time the ghost particles are removed
  *
  * The rationale is that a subscriber (i.e. the Communicator) can perform clean-up for ghost particles
@@ -370,6 +435,21 @@ void ParticleData::allocate(unsigned int N)
         }
     #endif
 
+    m_pos.setTag("ParticleData::m_pos");
+    m_vel.setTag("ParticleData::m_vel");
+    m_accel.setTag("ParticleData::m_accel");
+    m_charge.setTag("ParticleData::m_charge");
+    m_diameter.setTag("ParticleData::m_diameter");
+    m_image.setTag("ParticleData::m_image");
+    m_tag.setTag("ParticleData::m_tag");
+    m_body.setTag("ParticleData::m_body");
+    m_net_force.setTag("ParticleData::m_net_force");
+    m_net_virial.setTag("ParticleData::m_net_virial");
+    m_net_torque.setTag("ParticleData::m_net_torque");
+    m_orientation.setTag("ParticleData::m_orientation");
+    m_angmom.setTag("ParticleData::m_angmom");
+    m_inertia.setTag("ParticleData::m_inertia");
+
     // allocate alternate particle data arrays (for swapping in-out)
     allocateAlternateArrays(N);
 
@@ -440,8 +520,23 @@ void ParticleData::allocateAlternateArrays(unsigned int N)
     // Net torque
     GPUArray< Scalar4 > net_torque_alt(N, m_exec_conf);
     m_net_torque_alt.swap(net_torque_alt);
-    }
 
+    // the alternate arrays are accounted for together
+    m_pos_alt.setTag("ParticleData::alternate arrays");
+    m_vel_alt.setTag("ParticleData::alternate arrays");
+    m_accel_alt.setTag("ParticleData::alternate arrays");
+    m_charge_alt.setTag("ParticleData::alternate arrays");
+    m_diameter_alt.setTag("ParticleData::alternate arrays");
+    m_image_alt.setTag("ParticleData::alternate arrays");
+    m_tag_alt.setTag("ParticleData::alternate arrays");
+    m_body_alt.setTag("ParticleData::alternate arrays");
+    m_orientation_alt.setTag("ParticleData::alternate arrays");
+    m_angmom_alt.setTag("ParticleData::alternate arrays");
+    m_inertia_alt.setTag("ParticleData::alternate arrays");
+    m_net_force_alt.setTag("ParticleData::alternate arrays");
+    m_net_virial_alt.setTag("ParticleData::alternate arrays");
+    m_net_torque_alt.setTag("ParticleData::alternate arrays");
+    }
 
 //! Set global number of particles
 /*! \param nglobal Global number of particles
@@ -25,6 +25,7 @@
 
 #include "ExecutionConfiguration.h"
 #include "BoxDim.h"
+#include "ParticleReorder.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -252,6 +253,12 @@ struct pdata_element
     changes the order must call notifyParticleSort(). Any class interested in being notified
     can subscribe to the signal by calling connectParticleSort().
 
+    Classes that only permute the local particles should call reorderParticles() instead. It applies the permutation
+    to all per-particle arrays registered with getParticleReorder() (including all of the arrays stored in
+    ParticleData) and then notifies the sort signal. While the signal is emitted, getSortOrder() and
+    getInverseSortOrder() return the permutation, so subscribers can update their per-particle caches in place instead
+    of rebuilding them. Both return NULL for any other rearrangement of the particles.
+
     Some fields in ParticleData are not computed and assigned by default because they require additional processing
     time. PDataFlags is a bitset that lists which flags (enumerated in pdata_flag) are enable/disabled. Computes should
     call getFlags() and compute the requested quantities whenever the corresponding flag is set. Updaters and Analyzers
@@ -637,6 +644,36 @@ class ParticleData
         //! Notify listeners that the particles have been rearranged in memory
         void notifyParticleSort();
 
+        //! Apply a permutation to the local particles and notify listeners
+        void reorderParticles(const std::vector<unsigned int>& order);
+
+        //! Get the service that applies reorderParticles() to per-particle arrays
+        /*! Classes that store their own per-particle arrays may register them here to have them permuted
+            along with the particle data.
+        */
+        ParticleReorder& getParticleReorder()
+            {
+            return m_reorder;
+            }
+
+        //! Get the permutation applied by reorderParticles()
+        /*! \returns The old index of the particle at each new index while the sort signal is emitted by
+            reorderParticles(), NULL otherwise
+        */
+        const unsigned int *getSortOrder() const
+            {
+            return m_sort_order;
+            }
+
+        //! Get the inverse of the permutation applied by reorderParticles()
+        /*! \returns The new index of the particle at each old index while the sort signal is emitted by
+            reorderParticles(), NULL otherwise
+        */
+        const unsigned int *getInverseSortOrder() const
+            {
+            return m_sort_order ? &m_sort_inverse[0] : NULL;
+            }
+
         //! Connects a function to be called every time the box size is changed
         Nano::Signal<void ()>& getBoxChangeSignal()
             {
@@ -1029,6 +1066,10 @@ class ParticleData
         GPUArray<unsigned int> m_comm_flags;        //!< Array of communication flags
         #endif
 
+        ParticleReorder m_reorder;                   //!< Permutes the registered per-particle arrays
+        const unsigned int *m_sort_order;            //!< Permutation being notified (NULL outside of reorderParticles())
+        std::vector<unsigned int> m_sort_inverse;    //!< Inverse of the permutation being notified
+
         std::stack<unsigned int> m_recycled_tags;    //!< Global tags of removed particles
         std::set<unsigned int> m_tag_set;            //!< Lookup table for tags by active index
         GPUVector<unsigned int> m_cached_tag_set;    //!< Cached constant-time lookup table for tags by active index
@@ -1082,6 +1123,9 @@ class ParticleData
         //! Helper function to allocate alternate particle data
         void allocateAlternateArrays(unsigned int N);
 
+        //! Helper function to register the per-particle arrays with m_reorder
+        void registerReorderArrays();
+
         //! Helper function for amortized array resizing
         void resize(unsigned int new_nparticles);
 
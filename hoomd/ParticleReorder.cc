@@ -0,0 +1,36 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file ParticleReorder.cc
+    \brief Defines the ParticleReorder class
+*/
+
+#include "ParticleReorder.h"
+
+/*! \param array Address of the GPUArray passed to addArray()
+
+    Does nothing if \a array is not registered.
+*/
+void ParticleReorder::removeArray(const void *array)
+    {
+    for (unsigned int i = 0; i < m_arrays.size(); i++)
+        {
+        if (m_arrays[i]->get() == array)
+            {
+            m_arrays.erase(m_arrays.begin() + i);
+            return;
+            }
+        }
+    }
+
+/*! \param order Permutation of the local particles: new index i takes the data of old index order[i]
+    \param N Number of local particles
+*/
+void ParticleReorder::apply(const unsigned int *order, unsigned int N)
+    {
+    for (unsigned int i = 0; i < m_arrays.size(); i++)
+        m_arrays[i]->gather(order, N, m_scratch);
+    }
@@ -0,0 +1,125 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file ParticleReorder.h
+    \brief Declares the ParticleReorder class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __PARTICLE_REORDER_H__
+#define __PARTICLE_REORDER_H__
+
+#include "HOOMDMath.h"
+#include "GPUArray.h"
+
+#include <memory>
+#include <vector>
+
+//! Applies one permutation of the local particles to a set of per-particle arrays
+/*! Classes that store data indexed by the local particle index register their arrays with addArray(). apply()
+    then permutes all registered arrays, each in a single gather pass through a scratch buffer that is shared by all
+    arrays and reused between calls.
+
+    The permutation \a order maps new indices to old ones: after apply(), element i of every registered array holds
+    what was element order[i] before. Only the first N elements (the local particles) are permuted, elements of ghost
+    particles keep their indices.
+
+    Arrays that store several rows of per-particle data (such as the net virial) are registered with the number of
+    rows. Each row of length getPitch() is permuted independently.
+
+    Registered arrays are referenced, not copied. Every array must be removed with removeArray() before it is
+    destroyed. Arrays that are null at the time of apply() are skipped.
+
+    \ingroup data_structs
+*/
+class ParticleReorder
+    {
+    public:
+        //! Register a per-particle array
+        /*! \param array Array to permute
+            \param n_rows Number of rows of per-particle data in \a array
+        */
+        template<class T>
+        void addArray(GPUArray<T>& array, unsigned int n_rows=1)
+            {
+            m_arrays.push_back(std::shared_ptr<ArrayBase>(new Array<T>(array, n_rows)));
+            }
+
+        //! Remove a registered array
+        void removeArray(const void *array);
+
+        //! Apply a permutation to all registered arrays
+        void apply(const unsigned int *order, unsigned int N);
+
+    private:
+        //! Type independent interface to a registered array
+        class ArrayBase
+            {
+            public:
+                virtual ~ArrayBase() {}
+
+                //! Get the address of the registered GPUArray
+                virtual const void *get() const = 0;
+
+                //! Permute the first N elements of each row
+                virtual void gather(const unsigned int *order, unsigned int N, std::vector<Scalar4>& scratch) = 0;
+            };
+
+        //! A registered array of elements of type T
+        template<class T>
+        class Array : public ArrayBase
+            {
+            public:
+                Array(GPUArray<T>& array, unsigned int n_rows)
+                    : m_array(array), m_n_rows(n_rows)
+                    {
+                    }
+
+                virtual const void *get() const
+                    {
+                    return &m_array;
+                    }
+
+                virtual void gather(const unsigned int *order, unsigned int N, std::vector<Scalar4>& scratch)
+                    {
+                    if (m_array.isNull())
+                        return;
+
+                    // the scratch buffer is allocated in units of Scalar4, the widest per-particle type
+                    unsigned int n_scratch = (N*sizeof(T) + sizeof(Scalar4) - 1) / sizeof(Scalar4);
+                    if (scratch.size() < n_scratch)
+                        scratch.resize(n_scratch);
+                    T *tmp = reinterpret_cast<T *>(&scratch[0]);
+
+                    ArrayHandle<T> h_array(m_array, access_location::host, access_mode::readwrite);
+                    const unsigned int pitch = m_array.getPitch();
+                    for (unsigned int row = 0; row < m_n_rows; row++)
+                        {
+                        T *data = h_array.data + row*pitch;
+
+                        #pragma omp parallel for schedule(static)
+                        for (int i = 0; i < (int)N; i++)
+                            tmp[i] = data[order[i]];
+
+                        #pragma omp parallel for schedule(static)
+                        for (int i = 0; i < (int)N; i++)
+                            data[i] = tmp[i];
+                        }
+                    }
+
+            private:
+                GPUArray<T>& m_array;       //!< The registered array
+                unsigned int m_n_rows;      //!< Number of rows of per-particle data
+            };
+
+        std::vector< std::shared_ptr<ArrayBase> > m_arrays;    //!< Registered arrays
+        std::vector<Scalar4> m_scratch;                         //!< Scratch buffer shared by all arrays
+    };
+
+#endif
@@ -10,6 +10,11 @@
 
 #include "Profiler.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -191,7 +196,8 @@ void ProfileDataElem::output_line(std::ostream &o,
 ////////////////////////////////////////////////////////////////////
 // Profiler
 
-Profiler::Profiler(const std::string& name) : m_name(name)
+Profiler::Profiler(const std::string& name) : m_name(name), m_trace_enabled(false), m_timestep(0),
+    m_trace_max(1000000), m_trace_next(0), m_trace_dropped(0)
     {
     // push the root onto the top of the stack so that it is the default
     m_stack.push(&m_root);
@@ -217,12 +223,279 @@ void Profiler::output(std::ostream &o)
     #endif
 
     // outputting a profile implicitly calls for a time sample
-    m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+    sampleRoot();
 
     // startup the recursive output process
     m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
     }
 
+void Profiler::sampleRoot()
+    {
+    m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+    }
+
+/*! \param name Name of a profile node
+    \returns The index of \a name in m_trace_names
+*/
+unsigned int Profiler::getTraceNameIndex(const std::string& name)
+    {
+    map<string, unsigned int>::iterator it = m_trace_name_idx.find(name);
+    if (it != m_trace_name_idx.end())
+        return it->second;
+
+    unsigned int idx = (unsigned int)m_trace_names.size();
+    m_trace_names.push_back(name);
+    m_trace_name_idx[name] = idx;
+    return idx;
+    }
+
+namespace
+{
+//! Escape a string for output in a JSON document
+string json_escape(const string& str)
+    {
+    ostringstream o;
+    for (string::const_iterator c = str.begin(); c != str.end(); ++c)
+        {
+        if (*c == '"' || *c == '\\')
+            o << '\\' << *c;
+        else if ((unsigned char)*c < 0x20)
+            o << "\\u" << setw(4) << setfill('0') << hex << int(*c) << dec << setfill(' ');
+        else
+            o << *c;
+        }
+    return o.str();
+    }
+
+//! Profile tree of a single rank, flattened in depth first order
+struct FlatProfile
+    {
+    vector<string> names;           //!< Node names
+    vector<unsigned int> depths;    //!< Depth of the nodes in the tree
+    vector<int64_t> times;          //!< Elapsed time of the nodes (in ns)
+    vector<int64_t> flops;          //!< Flop count of the nodes
+    vector<int64_t> bytes;          //!< Memory byte count of the nodes
+    };
+
+//! Append a profile node and its children to a flattened tree
+void flatten_profile(const ProfileDataElem& elem, const string& name, unsigned int depth, FlatProfile& flat)
+    {
+    flat.names.push_back(name);
+    flat.depths.push_back(depth);
+    flat.times.push_back(elem.m_elapsed_time);
+    flat.flops.push_back(elem.m_flop_count);
+    flat.bytes.push_back(elem.m_mem_byte_count);
+
+    map<string, ProfileDataElem>::const_iterator i;
+    for (i = elem.m_children.begin(); i != elem.m_children.end(); ++i)
+        flatten_profile((*i).second, (*i).first, depth+1, flat);
+    }
+
+//! Statistics of a profile node over all ranks
+struct ProfileStats
+    {
+    ProfileStats() : n_ranks(0), sum_time(0), min_time(0), max_time(0), min_rank(0), max_rank(0), flops(0), bytes(0)
+        {}
+
+    //! Add the sample of one rank
+    void add(unsigned int rank, int64_t time, int64_t flop_count, int64_t byte_count)
+        {
+        if (n_ranks == 0 || time < min_time)
+            {
+            min_time = time;
+            min_rank = rank;
+            }
+        if (n_ranks == 0 || time > max_time)
+            {
+            max_time = time;
+            max_rank = rank;
+            }
+        sum_time += time;
+        flops += flop_count;
+        bytes += byte_count;
+        n_ranks++;
+        }
+
+    //! Recursively write this node and its children as JSON
+    void output(ostream& o, const string& name, unsigned int tab_level) const
+        {
+        string tabs(2*tab_level, ' ');
+        o << tabs << "{\"name\": \"" << json_escape(name) << "\", \"ranks\": " << n_ranks << ", ";
+        o << "\"time\": {\"avg\": " << double(sum_time)/double(n_ranks)/1e9 << ", ";
+        o << "\"min\": " << double(min_time)/1e9 << ", \"min_rank\": " << min_rank << ", ";
+        o << "\"max\": " << double(max_time)/1e9 << ", \"max_rank\": " << max_rank << "}, ";
+        o << "\"flop_count\": " << flops << ", \"byte_count\": " << bytes << ", ";
+        o << "\"children\": [";
+
+        map<string, ProfileStats>::const_iterator i;
+        for (i = children.begin(); i != children.end(); ++i)
+            {
+            o << (i == children.begin() ? "\n" : ",\n");
+            (*i).second.output(o, (*i).first, tab_level+1);
+            }
+
+        if (children.size())
+            o << "\n" << tabs;
+        o << "]}";
+        }
+
+    map<string, ProfileStats> children; //!< Child nodes
+    unsigned int n_ranks;               //!< Number of ranks that recorded this node
+    int64_t sum_time;                   //!< Sum of the elapsed times
+    int64_t min_time;                   //!< Minimum elapsed time
+    int64_t max_time;                   //!< Maximum elapsed time
+    unsigned int min_rank;              //!< Rank with the minimum elapsed time
+    unsigned int max_rank;              //!< Rank with the maximum elapsed time
+    int64_t flops;                      //!< Total flop count over all ranks
+    int64_t bytes;                      //!< Total memory byte count over all ranks
+    };
+
+//! Merge the flattened tree of one rank into the statistics tree
+void merge_profile(const FlatProfile& flat, unsigned int rank, ProfileStats& root)
+    {
+    vector<ProfileStats *> stack;
+    for (unsigned int k = 0; k < flat.names.size(); k++)
+        {
+        unsigned int depth = flat.depths[k];
+        stack.resize(depth);
+
+        ProfileStats *node = (depth == 0) ? &root : &stack.back()->children[flat.names[k]];
+        node->add(rank, flat.times[k], flat.flops[k], flat.bytes[k]);
+        stack.push_back(node);
+        }
+    }
+}
+
+/*! \param o Stream to write the JSON document to (only written on the root rank)
+    \param exec_conf Execution configuration providing the MPI communicator
+
+    This method is collective and must be called on all ranks. Ranks may have recorded different profile nodes, the
+    statistics of every node include only the ranks that recorded it.
+*/
+void Profiler::writeJSON(std::ostream &o, std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    sampleRoot();
+
+    FlatProfile flat;
+    flatten_profile(m_root, m_name, 0, flat);
+
+    ProfileStats stats;
+
+    unsigned int n_ranks = 1;
+    #ifdef ENABLE_MPI
+    n_ranks = exec_conf->getNRanks();
+    if (n_ranks > 1)
+        {
+        MPI_Comm mpi_comm = exec_conf->getMPICommunicator();
+        vector< vector<string> > names;
+        vector< vector<unsigned int> > depths;
+        vector< vector<int64_t> > times, flops, bytes;
+
+        gather_v(flat.names, names, 0, mpi_comm);
+        gather_v(flat.depths, depths, 0, mpi_comm);
+        gather_v(flat.times, times, 0, mpi_comm);
+        gather_v(flat.flops, flops, 0, mpi_comm);
+        gather_v(flat.bytes, bytes, 0, mpi_comm);
+
+        if (exec_conf->isRoot())
+            {
+            for (unsigned int rank = 0; rank < n_ranks; rank++)
+                {
+                FlatProfile rank_flat;
+                rank_flat.names.swap(names[rank]);
+                rank_flat.depths.swap(depths[rank]);
+                rank_flat.times.swap(times[rank]);
+                rank_flat.flops.swap(flops[rank]);
+                rank_flat.bytes.swap(bytes[rank]);
+                merge_profile(rank_flat, rank, stats);
+                }
+            }
+        }
+    else
+    #endif
+        {
+        merge_profile(flat, 0, stats);
+        }
+
+    if (exec_conf->getRank() != 0)
+        return;
+
+    o << setprecision(9);
+    o << "{\"n_ranks\": " << n_ranks << ",\n\"profile\":\n";
+    stats.output(o, m_name, 0);
+    o << "\n}" << endl;
+    }
+
+/*! \param max_events Maximum number of trace events kept on this rank
+
+    Once the limit is reached, every new event overwrites the oldest one. Events recorded so far are discarded.
+*/
+void Profiler::setTraceLimit(unsigned int max_events)
+    {
+    m_trace_max = max_events;
+    m_trace.clear();
+    m_trace.reserve(std::min(max_events, 65536u));
+    m_trace_next = 0;
+    m_trace_dropped = 0;
+    }
+
+/*! \param o Stream to write the trace to (only written on the root rank)
+    \param exec_conf Execution configuration providing the MPI communicator
+
+    This method is collective and must be called on all ranks. The events of rank r are written as process r,
+    timestamps and durations are given in microseconds as required by the format. A warning reports the events
+    that did not fit into the ring buffer.
+*/
+void Profiler::writeTrace(std::ostream &o, std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    unsigned int rank = exec_conf->getRank();
+
+    // format the events of this rank
+    ostringstream s;
+    s << setiosflags(ios::fixed) << setprecision(3);
+    s << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": " << rank << ", \"args\": {\"name\": \"rank " << rank
+      << "\"}}";
+    for (unsigned int i = 0; i < m_trace.size(); i++)
+        {
+        // oldest event first
+        const TraceEvent& ev = m_trace[(m_trace_next + i) % m_trace.size()];
+        s << ",\n{\"name\": \"" << json_escape(m_trace_names[ev.name]) << "\", \"ph\": \"X\", \"pid\": " << rank
+          << ", \"tid\": 0, \"ts\": " << double(ev.start)/1e3 << ", \"dur\": " << double(ev.duration)/1e3
+          << ", \"args\": {\"step\": " << ev.timestep << "}}";
+        }
+
+    string rank_events = s.str();
+    vector<string> events(1, rank_events);
+
+    uint64_t n_dropped = m_trace_dropped;
+
+    #ifdef ENABLE_MPI
+    if (exec_conf->getNRanks() > 1)
+        {
+        gather_v(rank_events, events, 0, exec_conf->getMPICommunicator());
+        MPI_Reduce(&m_trace_dropped, &n_dropped, 1, MPI_UINT64_T, MPI_SUM, 0, exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (rank != 0)
+        return;
+
+    if (n_dropped > 0)
+        {
+        exec_conf->msg->warning() << "The profile trace keeps the last " << m_trace_max << " events per rank, "
+                                  << n_dropped << " earlier events were discarded" << endl;
+        }
+
+    o << "{\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n";
+    for (unsigned int r = 0; r < events.size(); r++)
+        {
+        if (r > 0)
+            o << ",\n";
+        o << events[r];
+        }
+    o << "\n]}" << endl;
+    }
+
 /*! \param o Stream to output to
     \param prof Profiler to print
 */
@@ -26,6 +26,7 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <vector>
 #include <iostream>
 #include <cassert>
 
@@ -118,6 +119,13 @@ class ProfileDataElem
     to provide accurate timing information.
 
     These profiles can of course be output via normal ostream operators.
+
+    For machine-readable output, writeJSON() collects the tree of every MPI rank and writes the min/max/avg time
+    of each node together with the ranks that took the least and the most time. When tracing is enabled with
+    enableTrace(), every pop() additionally records a timed event tagged with the current time step (see
+    setTimestep()), and writeTrace() writes the events of all ranks in the Chrome trace event format, with one
+    process per rank. Timestamps are relative to the construction of the Profiler on each rank. The events are kept in
+    a ring buffer of setTraceLimit() events per rank, so long runs keep only their most recent events.
     \ingroup utils
     */
 class Profiler
@@ -135,12 +143,58 @@ class Profiler
         //! Pops back up to the next super-category & syncs the GPUs
         void pop(std::shared_ptr<const ExecutionConfiguration> exec_conf, uint64_t flop_count = 0, uint64_t byte_count = 0);
 
+        //! Set the time step that recorded trace events are attributed to
+        void setTimestep(unsigned int timestep)
+            {
+            m_timestep = timestep;
+            }
+
+        //! Enable or disable the recording of trace events
+        void enableTrace(bool enable)
+            {
+            m_trace_enabled = enable;
+            }
+
+        //! Set the maximum number of trace events kept on this rank
+        void setTraceLimit(unsigned int max_events);
+
+        //! Write the profile tree with statistics over all ranks as JSON
+        void writeJSON(std::ostream &o, std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+        //! Write the trace events of all ranks in the Chrome trace event format
+        void writeTrace(std::ostream &o, std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
     private:
+        //! A single timed interval between a push() and a pop()
+        struct TraceEvent
+            {
+            unsigned int name;      //!< Index into m_trace_names
+            unsigned int timestep;  //!< Time step during which the event started
+            int64_t start;          //!< Start time relative to the root profile (in ns)
+            int64_t duration;       //!< Duration of the event (in ns)
+            };
+
         ClockSource m_clk;  //!< Clock to provide timing information
         std::string m_name; //!< The name of this profile
         ProfileDataElem m_root; //!< The root profile element
         std::stack<ProfileDataElem *> m_stack;  //!< A stack of data elements for the push/pop structure
 
+        bool m_trace_enabled;                   //!< True if trace events are recorded
+        unsigned int m_timestep;                //!< Current time step for trace events
+        unsigned int m_trace_max;               //!< Maximum number of trace events kept
+        std::vector<TraceEvent> m_trace;        //!< Recorded trace events (ring buffer once m_trace_max is reached)
+        unsigned int m_trace_next;              //!< Index of the oldest event in a full m_trace
+        uint64_t m_trace_dropped;               //!< Number of events overwritten in m_trace
+        std::vector<std::string> m_trace_names; //!< Unique names of the trace events
+        std::map<std::string, unsigned int> m_trace_name_idx; //!< Lookup table from names to m_trace_names
+        std::stack<unsigned int> m_trace_stack; //!< Names of the currently open trace events
+
+        //! Get the index of a name in m_trace_names, adding it if needed
+        unsigned int getTraceNameIndex(const std::string& name);
+
+        //! Sample the elapsed time of the root profile
+        void sampleRoot();
+
         //! Output helper function
         void output(std::ostream &o);
 
@@ -200,6 +254,9 @@ inline void Profiler::push(const std::string& name)
     // and updating the stack
     m_stack.push(&cur->m_children[name]);
 
+    if (m_trace_enabled)
+        m_trace_stack.push(getTraceNameIndex(name));
+
     #ifdef SCOREP_USER_ENABLE
     // log Score-P region
     SCOREP_USER_REGION_BEGIN( cur->m_children[name].m_scorep_region, name.c_str(),SCOREP_USER_REGION_TYPE_COMMON )
@@ -230,6 +287,29 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     cur->m_flop_count += flop_count;
     cur->m_mem_byte_count += byte_count;
 
+    // record the interval for the trace
+    if (m_trace_enabled && !m_trace_stack.empty())
+        {
+        TraceEvent ev;
+        ev.name = m_trace_stack.top();
+        ev.timestep = m_timestep;
+        ev.start = cur->m_start_time - m_root.m_start_time;
+        ev.duration = t - cur->m_start_time;
+        if (m_trace.size() < m_trace_max)
+            m_trace.push_back(ev);
+        else
+            {
+            // overwrite the oldest event
+            if (m_trace_max > 0)
+                {
+                m_trace[m_trace_next] = ev;
+                m_trace_next = (m_trace_next + 1) % m_trace_max;
+                }
+            m_trace_dropped++;
+            }
+        m_trace_stack.pop();
+        }
+
     // and finally popping the stack so that the next pop will access the correct element
     m_stack.pop();
     }
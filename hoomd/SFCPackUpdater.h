@@ -78,7 +78,7 @@ class SFCPackUpdater : public Updater
         //! Helper function that actually performs the sort
         virtual void getSortedOrder3D();
 
-        //! Apply the sorted order to the particle data
+        //! Apply the sorted order to the particle data and notify the subscribers of the particle sort
         virtual void applySortOrder();
 
         //! Helper function to generate traversal order
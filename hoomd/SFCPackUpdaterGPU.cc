@@ -233,6 +233,9 @@ void SFCPackUpdaterGPU::applySortOrder()
     m_pdata->swapNetVirial();
     m_pdata->swapNetForce();
     m_pdata->swapNetTorque();
+
+    // the sort order is only available on the device, subscribers rebuild their per-particle data
+    m_pdata->notifyParticleSort();
     }
 
 void export_SFCPackUpdaterGPU(py::module& m)
@@ -18,6 +18,8 @@
 
 // #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #include <stdexcept>
+#include <fstream>
+#include <sstream>
 #include <time.h>
 
 using namespace std;
@@ -35,7 +37,7 @@ PyObject* walltimeLimitExceptionTypeObj = 0;
 System::System(std::shared_ptr<SystemDefinition> sysdef, unsigned int initial_tstep)
         : m_sysdef(sysdef), m_start_tstep(initial_tstep), m_end_tstep(0), m_cur_tstep(initial_tstep), m_cur_tps(0),
         m_last_status_time(0), m_last_status_tstep(initial_tstep), m_quiet_run(false),
-        m_profile(false), m_stats_period(10)
+        m_profile(false), m_profile_trace_limit(1000000), m_stats_period(10)
     {
     // sanity check
     assert(m_sysdef);
@@ -458,6 +460,9 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
     // handle time steps
     for ( ; m_cur_tstep < m_end_tstep; m_cur_tstep++)
         {
+        if (m_profiler)
+            m_profiler->setTimestep(m_cur_tstep);
+
         // check the clock and output a status line if needed
         uint64_t cur_time = m_clk.getTime();
 
@@ -603,10 +608,16 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
 
     // write out the profile data
     if (m_profiler)
+        {
         m_exec_conf->msg->notice(1) << *m_profiler;
+        writeProfile();
+        }
 
     if (!m_quiet_run)
+        {
         printStats();
+        printMemoryUsage();
+        }
 
     // throw a WalltimeLimitReached exception if we timed out, but only if the user is using the HOOMD_WALLTIME_STOP feature
     if (timeout_end_run && walltime_stop != NULL)
@@ -623,6 +634,60 @@ void System::enableProfiler(bool enable)
     m_profile = enable;
     }
 
+/*! \param json_fname File to write the profile tree with statistics over all ranks to (empty to disable)
+    \param trace_fname File to write the per-rank trace events to (empty to disable)
+    \param trace_limit Maximum number of trace events kept per rank, later events overwrite the oldest ones
+
+    Both files are written by the root rank at the end of every profiled run and overwritten by later runs.
+*/
+void System::setProfileOutput(const std::string& json_fname, const std::string& trace_fname,
+                              unsigned int trace_limit)
+    {
+    m_profile_json_fname = json_fname;
+    m_profile_trace_fname = trace_fname;
+    m_profile_trace_limit = trace_limit;
+    }
+
+void System::writeProfile()
+    {
+    // the profiler collects the data of all ranks, only the root rank opens the files
+    bool root = m_exec_conf->getRank() == 0;
+
+    if (!m_profile_json_fname.empty())
+        {
+        std::ostringstream s;
+        m_profiler->writeJSON(s, m_exec_conf);
+
+        if (root)
+            {
+            std::ofstream f(m_profile_json_fname.c_str());
+            if (!f.good())
+                {
+                m_exec_conf->msg->error() << "Unable to open profile file " << m_profile_json_fname << endl;
+                throw runtime_error("Error writing profile");
+                }
+            f << s.str();
+            }
+        }
+
+    if (!m_profile_trace_fname.empty())
+        {
+        std::ostringstream s;
+        m_profiler->writeTrace(s, m_exec_conf);
+
+        if (root)
+            {
+            std::ofstream f(m_profile_trace_fname.c_str());
+            if (!f.good())
+                {
+                m_exec_conf->msg->error() << "Unable to open profile trace file " << m_profile_trace_fname << endl;
+                throw runtime_error("Error writing profile trace");
+                }
+            f << s.str();
+            }
+        }
+    }
+
 /*! \param logger Logger to register computes and updaters with
     All computes and updaters registered with the system are also registerd with the logger.
 */
@@ -685,7 +750,17 @@ void System::setAutotunerParams(bool enabled, unsigned int period)
 void System::setupProfiling()
     {
     if (m_profile)
+        {
+        #ifdef ENABLE_MPI
+        // start the profiles of all ranks together so that their trace timestamps line up
+        if (m_comm)
+            MPI_Barrier(m_exec_conf->getMPICommunicator());
+        #endif
+
         m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation"));
+        m_profiler->enableTrace(!m_profile_trace_fname.empty());
+        m_profiler->setTraceLimit(m_profile_trace_limit);
+        }
     else
         m_profiler = std::shared_ptr<Profiler>();
 
@@ -740,6 +815,42 @@ void System::printStats()
         compute->second->printStats();
     }
 
+/*! The peak memory is reported for the rank that uses the most, followed by the breakdown per allocation on the root
+    rank at notice level 2.
+*/
+void System::printMemoryUsage()
+    {
+    std::shared_ptr<MemoryTracker> tracker = m_exec_conf->getMemoryTracker();
+    const double MiB = 1024.0*1024.0;
+
+    // value and rank, laid out for MPI_DOUBLE_INT
+    struct
+        {
+        double value;
+        int rank;
+        } peak_host, peak_device;
+
+    peak_host.value = double(tracker->getPeakHostBytes())/MiB;
+    peak_host.rank = m_exec_conf->getRank();
+    peak_device.value = double(tracker->getPeakDeviceBytes())/MiB;
+    peak_device.rank = m_exec_conf->getRank();
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &peak_host, 1, MPI_DOUBLE_INT, MPI_MAXLOC, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &peak_device, 1, MPI_DOUBLE_INT, MPI_MAXLOC, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    m_exec_conf->msg->notice(1) << "Peak memory: " << peak_host.value << " MiB host (rank " << peak_host.rank << "), "
+                                << peak_device.value << " MiB device (rank " << peak_device.rank << ")" << endl;
+
+    ostringstream s;
+    tracker->writeBreakdown(s);
+    m_exec_conf->msg->notice(2) << "Memory usage on rank " << m_exec_conf->getRank() << ":" << endl << s.str();
+    }
+
 void System::resetStats()
     {
     if (m_integrator)
@@ -863,6 +974,7 @@ void export_System(py::module& m)
     .def("setStatsPeriod", &System::setStatsPeriod)
     .def("setAutotunerParams", &System::setAutotunerParams)
     .def("enableProfiler", &System::enableProfiler)
+    .def("setProfileOutput", &System::setProfileOutput)
     .def("enableQuietRun", &System::enableQuietRun)
     .def("run", &System::run)
 
@@ -147,6 +147,10 @@ class System
         //! Configures profiling of runs
         void enableProfiler(bool enable);
 
+        //! Set the files the profile is written to at the end of each run
+        void setProfileOutput(const std::string& json_fname, const std::string& trace_fname,
+                              unsigned int trace_limit);
+
         //! Toggle whether or not to print the status line and TPS for each run
         void enableQuietRun(bool enable)
             {
@@ -401,6 +405,8 @@ class System
         std::shared_ptr<Integrator> m_integrator;     //!< Integrator that advances time in this System
         std::shared_ptr<SystemDefinition> m_sysdef;   //!< SystemDefinition for this System
         std::shared_ptr<Profiler> m_profiler;         //!< Profiler to profile runs
+        std::string m_profile_json_fname;             //!< File to write the JSON profile to (if not empty)
+        std::string m_profile_trace_fname;            //!< File to write the profile trace to (if not empty)
 
 #ifdef ENABLE_MPI
         std::shared_ptr<Communicator> m_comm;         //!< Communicator to use
@@ -416,18 +422,25 @@ class System
 
         bool m_quiet_run;       //!< True to suppress the status line and TPS from being printed to stdout for each run
         bool m_profile;         //!< True if runs should be profiled
+        unsigned int m_profile_trace_limit; //!< Maximum number of trace events kept per rank
         unsigned int m_stats_period; //!< Number of seconds between statistics output lines
 
         // --------- Steps in the simulation run implemented in helper functions
         //! Sets up m_profiler and attaches/detaches to/from all computes, updaters, and analyzers
         void setupProfiling();
 
+        //! Writes the profile to the files set by setProfileOutput()
+        void writeProfile();
+
         //! Prints detailed statistics for all attached computes, updaters, and integrators
         void printStats();
 
         //! Resets stats for all contained classes
         void resetStats();
 
+        //! Prints the memory held by GPUArrays
+        void printMemoryUsage();
+
         //! Prints out a formatted status line
         void generateStatusLine();
 
@@ -85,7 +85,8 @@ sys.excepthook = _hoomd_sys_excepthook
 
 __version__ = "{0}.{1}.{2}".format(*_hoomd.__version__)
 
-def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_period=0, callback=None, quiet=False):
+def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_period=0, callback=None, quiet=False,
+        profile_json=None, profile_trace=None, profile_trace_limit=1000000):
     """ Runs the simulation for a given number of time steps.
 
     Args:
@@ -98,12 +99,17 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
         callback (python callable): Sets a Python function to be called regularly during a run.
         callback_period (int): Sets the period, in time steps, between calls made to ``callback``.
         quiet (bool): Set to True to disable the status information printed to the screen by the run.
+        profile_json (str): File name to write the profile tree with statistics over all MPI ranks to (implies *profile*).
+        profile_trace (str): File name to write a per-rank timeline of the profile in Chrome trace event format to
+                             (implies *profile*).
+        profile_trace_limit (int): Maximum number of trace events kept per rank.
 
     Example::
 
             hoomd.run(10)
             hoomd.run(10e6, limit_hours=1.0/3600.0, limit_multiple=10)
             hoomd.run(10, profile=True)
+            hoomd.run(10, profile_json='profile.json', profile_trace='trace.json')
             hoomd.run(10, quiet=True)
             hoomd.run(10, callback_period=2, callback=lambda step: print(step))
 
@@ -124,6 +130,15 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
     portion of the calculation is printed at the end of the run. Collecting this timing information
     slows the simulation.
 
+    ``profile_json`` writes the same profile tree as a JSON document. For every node, it lists the average, minimum
+    and maximum time over all MPI ranks, together with the ranks that took the least and the most time.
+    ``profile_trace`` records every profiled interval with its time step on every rank and writes them in the Chrome
+    trace event format, which can be opened in trace viewers such as ``chrome://tracing`` or Perfetto. Each rank
+    appears as a separate process. Each rank keeps at most ``profile_trace_limit`` events (about 24 bytes each). In
+    longer runs, new events overwrite the oldest ones, so the trace covers the end of the run, and a warning reports
+    the number of discarded events.
+    Both files are written at the end of the run and overwritten by subsequent runs.
+
     **Wallclock limited runs:**
 
     There are a number of mechanisms to limit the time of a running hoomd script. Use these in a job
@@ -175,12 +190,22 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
         context.current.integrator.update_methods();
         context.current.integrator.update_thermos();
 
+        # restore the integrator state of a checkpoint read by init.read_gsd
+        if context.current.checkpoint_reader is not None:
+            context.current.checkpoint_reader.restoreIntegrator(context.current.integrator.cpp_integrator);
+            context.current.checkpoint_reader = None;
+
     # update autotuner parameters
     context.current.system.setAutotunerParams(context.options.autotuner_enable, int(context.options.autotuner_period));
 
     for logger in context.current.loggers:
         logger.update_quantities();
+    if profile_json is not None or profile_trace is not None:
+        profile = True;
     context.current.system.enableProfiler(profile);
+    context.current.system.setProfileOutput(profile_json if profile_json is not None else '',
+                                            profile_trace if profile_trace is not None else '',
+                                            int(profile_trace_limit));
     context.current.system.enableQuietRun(quiet);
 
     # update all user-defined neighbor lists
@@ -188,6 +213,16 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
         nl.update_rcut()
         nl.update_exclusions_defaults()
 
+    # update the force computes measured by time weighted load balancing
+    for updater in context.current.updaters:
+        if isinstance(updater, update.balance):
+            updater.update_cost_computes()
+
+    # store the state of the current integrator in checkpoints
+    for analyzer in context.current.analyzers:
+        if isinstance(analyzer, dump.checkpoint):
+            analyzer.update_integrator()
+
     # detect 0 hours remaining properly
     if limit_hours == 0.0:
         context.msg.warning("Requesting a run() with a 0 time limit, doing nothing.\n");
@@ -198,6 +233,11 @@ def run(tsteps, profile=False, limit_hours=None, limit_multiple=1, callback_peri
     if not quiet:
         context.msg.notice(1, "** starting run **\n");
     context.current.system.run(int(tsteps), callback_period, callback, limit_hours, int(limit_multiple));
+
+    # write out rows buffered by binary loggers
+    for logger in context.current.loggers:
+        logger.cpp_analyzer.flush();
+
     if not quiet:
         context.msg.notice(1, "** run complete **\n");
 
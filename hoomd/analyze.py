@@ -242,6 +242,8 @@ class log(_analyzer):
         header_prefix (str):  Specify a string to print before the header.
         overwrite (bool): When False (the default) an existing log will be appended to. When True, an existing log file will be overwritten instead.
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        binary (bool): When True, write a binary log file (see below).
+        buffer_rows (int): Number of rows to buffer in memory before writing them to a binary log file.
 
     :py:class:`hoomd.analyze.log` reads a variety of calculated values, like energy and temperature, from
     specified forces, integrators, and updaters. It writes a single line to the specified
@@ -261,6 +263,12 @@ class log(_analyzer):
     - **yz** - Box tilt factor in yz plane (dimensionless)
     - **momentum** - Magnitude of the average momentum of all particles (in momentum units)
     - **time** - Wall-clock running time from the start of the log (in seconds)
+    - **memory_host** - Host memory currently held by particle data and compute arrays (in MiB)
+    - **memory_host_peak** - Largest host memory held at any time (in MiB)
+    - **memory_device** - Device memory currently held by particle data and compute arrays (in MiB)
+    - **memory_device_peak** - Largest device memory held at any time (in MiB)
+
+    The memory quantities are the maximum over all MPI ranks.
 
     Thermodynamic properties:
     - The following quantities are always available and computed over all particles in the system (see :py:class:`hoomd.compute.thermo` for detailed definitions):
@@ -396,9 +404,20 @@ class log(_analyzer):
         When an existing log is appended to, the header is not printed. For the log to
         remain consistent with the header already in the file, you must specify the same quantities
         to log and in the same order for all runs of hoomd that append to the same log.
+
+    With *binary=True*, values are stored in a memory buffer of *buffer_rows* rows instead of being formatted as text
+    on every logged step. Full buffers are written to the file as one block, and the remaining rows are written at the
+    end of every :py:func:`hoomd.run()`. Binary files record the names of the logged quantities, so *header_prefix* and
+    the delimiter are not used. Convert binary log files to text with :py:func:`convert_binary_log()`.
+
+    Example::
+
+        analyze.log(filename='thermo.bin', quantities=['potential_energy', 'temperature'], period=10,
+                    binary=True, buffer_rows=10000)
     """
 
-    def __init__(self, filename, quantities, period, header_prefix='', overwrite=False, phase=0):
+    def __init__(self, filename, quantities, period, header_prefix='', overwrite=False, phase=0, binary=False,
+                 buffer_rows=1024):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -410,6 +429,8 @@ class log(_analyzer):
 
         # create the c++ mirror class
         self.cpp_analyzer = _hoomd.Logger(hoomd.context.current.system_definition, filename, header_prefix, overwrite);
+        if binary:
+            self.cpp_analyzer.setBinary(int(buffer_rows));
         self.setupAnalyzer(period, phase);
 
         # set the logged quantities
@@ -525,6 +546,7 @@ class log(_analyzer):
         _analyzer.disable(self)
         hoomd.util.unquiet_status()
 
+        self.cpp_analyzer.flush();
         hoomd.context.current.loggers.remove(self)
 
     def enable(self):
@@ -544,6 +566,63 @@ class log(_analyzer):
 
         hoomd.context.current.loggers.append(self)
 
+def convert_binary_log(filename, output, delimiter='\t'):
+    R""" Convert a binary log file to a delimited text file.
+
+    Args:
+        filename (str): Binary log file written by :py:class:`log` with *binary=True*.
+        output (str): Text file to write.
+        delimiter (str): Delimiter between columns.
+
+    :py:func:`convert_binary_log()` does not need a simulation context and can be used offline. The text file has the
+    same format as a text log written by :py:class:`log`. A header line is written every time the logged quantities
+    were set.
+
+    Example::
+
+        analyze.convert_binary_log('thermo.bin', 'thermo.log')
+    """
+    import struct;
+
+    with open(filename, 'rb') as f, open(output, 'w') as out:
+        magic = f.read(8);
+        order = f.read(8);
+        if magic != b'HOOMDLOG' or len(order) != 8:
+            raise RuntimeError('{} is not a binary log file'.format(filename));
+
+        # the file is written in the byte order of the host, detect it from the byte order mark
+        endian = None;
+        for e in ['<', '>']:
+            if struct.unpack(e + 'II', order) == (1, 0x01020304):
+                endian = e;
+        if endian is None:
+            raise RuntimeError('{} is not a binary log file'.format(filename));
+
+        columns = [];
+        while True:
+            record = f.read(4);
+            if len(record) < 4:
+                break;
+            record_type = struct.unpack(endian + 'I', record)[0];
+
+            if record_type == 1:
+                # header record
+                n_columns = struct.unpack(endian + 'I', f.read(4))[0];
+                columns = [];
+                for i in range(n_columns):
+                    length = struct.unpack(endian + 'I', f.read(4))[0];
+                    columns.append(f.read(length).decode('utf-8'));
+                out.write(delimiter.join(['timestep'] + columns) + '\n');
+            elif record_type == 2:
+                # block of rows, stored column by column
+                n_rows = struct.unpack(endian + 'I', f.read(4))[0];
+                timesteps = struct.unpack(endian + '{}Q'.format(n_rows), f.read(8*n_rows));
+                values = [struct.unpack(endian + '{}d'.format(n_rows), f.read(8*n_rows)) for c in columns];
+                for i in range(n_rows):
+                    out.write(delimiter.join([str(timesteps[i])] + ['{:.10g}'.format(v[i]) for v in values]) + '\n');
+            else:
+                raise RuntimeError('Invalid record in binary log file {}'.format(filename));
+
 class callback(_analyzer):
     R""" Callback analyzer.
 
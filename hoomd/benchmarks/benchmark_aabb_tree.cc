@@ -0,0 +1,53 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/AABBTree.h"
+#include "hoomd/GPUArray.h"
+
+#include "hoomd_benchmark.h"
+
+/*! \file benchmark_aabb_tree.cc
+    \brief Benchmarks AABBTree::buildTree()
+    \ingroup benchmarks
+*/
+
+using namespace hpmc::detail;
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Time building a tree of point AABBs, as NeighborListTree does
+HOOMD_BENCHMARK(aabb_tree)
+    {
+    const std::string name("AABBTree::buildTree");
+    if (!runner.enabled(name))
+        return;
+
+    for (Scalar density : hoomd_benchmark::system_densities)
+        for (unsigned int N : hoomd_benchmark::system_sizes)
+            {
+            std::shared_ptr<SystemDefinition> sysdef = hoomd_benchmark::make_random_system(runner.getExecConf(), N, density);
+            std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+            const unsigned int N_local = pdata->getN();
+
+            GPUArray<AABB> aabbs(N_local, runner.getExecConf());
+                {
+                ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+                ArrayHandle<AABB> h_aabbs(aabbs, access_location::host, access_mode::overwrite);
+                for (unsigned int i = 0; i < N_local; i++)
+                    h_aabbs.data[i] = AABB(vec3<Scalar>(h_pos.data[i]), i);
+                }
+
+            AABBTree tree;
+            ArrayHandle<AABB> h_aabbs(aabbs, access_location::host, access_mode::readwrite);
+            runner.measure(name, hoomd_benchmark::system_params(N, density), N,
+                           [&](unsigned int n)
+                               {
+                               return hoomd_benchmark::time_loop(runner.getExecConf(), n,
+                                                                 [&]() { tree.buildTree(h_aabbs.data, N_local); });
+                               });
+            }
+    }
@@ -0,0 +1,54 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/CellList.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/CellListGPU.h"
+#endif
+
+#include "hoomd_benchmark.h"
+
+/*! \file benchmark_cell_list.cc
+    \brief Benchmarks CellList::computeCellList()
+    \ingroup benchmarks
+*/
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Time computeCellList() with the cell width of a LJ neighbor list
+template <class CL>
+void benchmark_cell_list(hoomd_benchmark::Runner& runner, const std::string& name)
+    {
+    if (!runner.enabled(name))
+        return;
+
+    for (Scalar density : hoomd_benchmark::system_densities)
+        for (unsigned int N : hoomd_benchmark::system_sizes)
+            {
+            std::shared_ptr<SystemDefinition> sysdef = hoomd_benchmark::make_random_system(runner.getExecConf(), N, density);
+
+            std::shared_ptr<CellList> cl(new CL(sysdef));
+            cl->setNominalWidth(Scalar(2.8));
+            cl->setRadius(1);
+
+            runner.measure(name, hoomd_benchmark::system_params(N, density), N,
+                           [&](unsigned int n) { return cl->benchmark(n); });
+            }
+    }
+
+HOOMD_BENCHMARK(cell_list)
+    {
+    #ifdef ENABLE_CUDA
+    if (runner.getExecConf()->isCUDAEnabled())
+        {
+        benchmark_cell_list<CellListGPU>(runner, "CellListGPU");
+        return;
+        }
+    #endif
+    benchmark_cell_list<CellList>(runner, "CellList");
+    }
@@ -0,0 +1,91 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/Communicator.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/CommunicatorGPU.h"
+#endif
+
+#include "hoomd_benchmark.h"
+
+/*! \file benchmark_communicator.cc
+    \brief Benchmarks Communicator::exchangeGhosts()
+    \ingroup benchmarks
+*/
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Requests a fixed ghost layer width
+struct ghost_layer_width
+    {
+    ghost_layer_width(Scalar width)
+        : w(width)
+        {
+        }
+
+    Scalar get(unsigned int type)
+        {
+        return w;
+        }
+
+    Scalar w;
+    };
+
+//! Time the ghost exchange with the ghost layer of a LJ neighbor list
+template <class Comm>
+void benchmark_exchange_ghosts(hoomd_benchmark::Runner& runner, const std::string& name)
+    {
+    if (!runner.enabled(name))
+        return;
+
+    if (runner.getExecConf()->getNRanks() == 1)
+        {
+        runner.getExecConf()->msg->warning() << name << " needs more than one rank, skipping" << std::endl;
+        return;
+        }
+
+    for (Scalar density : hoomd_benchmark::system_densities)
+        for (unsigned int N : hoomd_benchmark::system_sizes)
+            {
+            std::shared_ptr<SystemDefinition> sysdef = hoomd_benchmark::make_random_system(runner.getExecConf(), N, density);
+            std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+            std::shared_ptr<Communicator> comm(new Comm(sysdef, pdata->getDomainDecomposition()));
+            ghost_layer_width g(Scalar(2.8));
+            comm->getGhostLayerWidthRequestSignal().connect<ghost_layer_width, &ghost_layer_width::get>(g);
+
+            CommFlags flags(0);
+            flags[comm_flag::position] = 1;
+            flags[comm_flag::tag] = 1;
+            comm->setFlags(flags);
+            comm->migrateParticles();
+
+            runner.measure(name, hoomd_benchmark::system_params(N, density), N,
+                           [&](unsigned int n)
+                               {
+                               return hoomd_benchmark::time_loop(runner.getExecConf(), n,
+                                   [&]()
+                                       {
+                                       pdata->removeAllGhostParticles();
+                                       comm->exchangeGhosts();
+                                       });
+                               });
+            }
+    }
+
+HOOMD_BENCHMARK(exchange_ghosts)
+    {
+    #ifdef ENABLE_CUDA
+    if (runner.getExecConf()->isCUDAEnabled())
+        {
+        benchmark_exchange_ghosts<CommunicatorGPU>(runner, "CommunicatorGPU::exchangeGhosts");
+        return;
+        }
+    #endif
+    benchmark_exchange_ghosts<Communicator>(runner, "Communicator::exchangeGhosts");
+    }
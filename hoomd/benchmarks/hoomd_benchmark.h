@@ -0,0 +1,451 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file hoomd_benchmark.h
+    \brief Minimal framework for the C++ microbenchmarks
+    \details Every benchmark executable includes this file once, defines its benchmarks with HOOMD_BENCHMARK(), and
+        adds HOOMD_BENCHMARK_MAIN(). The executables accept the following options:
+
+        - `--mode=cpu|gpu` execution mode (default: cpu)
+        - `--filter=<text>` only run the cases whose name contains text
+        - `--min-time=<s>` minimum time spent in each sample (default: 0.2)
+        - `--repeat=<n>` number of samples per case, the median is reported (default: 5)
+        - `--json=<file>` write the results to file
+        - `--baseline=<file>` compare the results to those in file, written by an earlier `--json` run
+        - `--tolerance=<x>` relative slowdown reported as a regression (default: 0.1)
+
+        With `--baseline`, the executable exits with a non-zero status when any case is slower than its baseline by
+        more than the tolerance.
+
+    \note This file should be included only once and by a file that will compile into a benchmark executable
+*/
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDMPI.h"
+#include "hoomd/SystemDefinition.h"
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/ClockSource.h"
+#include "hoomd/extern/saruprng.h"
+#include "HOOMDVersion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace hoomd_benchmark
+{
+
+//! Timing of one benchmark case
+struct Result
+    {
+    std::string name;           //!< Name of the benchmarked kernel
+    std::string params;         //!< Parameters of the synthetic input
+    unsigned int N;             //!< Number of particles (or objects) processed per iteration
+    unsigned int iterations;    //!< Number of iterations per sample
+    double time_ms;             //!< Median time per iteration in milliseconds
+    double min_ms;              //!< Fastest sample
+    double max_ms;              //!< Slowest sample
+    };
+
+//! Find the value of "key": in a line of a JSON file written by Runner
+inline bool json_find(const std::string& line, const std::string& key, std::string& value)
+    {
+    std::string pattern = "\"" + key + "\": ";
+    size_t pos = line.find(pattern);
+    if (pos == std::string::npos)
+        return false;
+    pos += pattern.size();
+
+    if (line[pos] == '"')
+        {
+        size_t end = line.find('"', pos+1);
+        value = line.substr(pos+1, end-pos-1);
+        }
+    else
+        {
+        size_t end = line.find_first_of(",}", pos);
+        value = line.substr(pos, end-pos);
+        }
+    return true;
+    }
+
+//! Measures benchmark cases and reports the results
+class Runner
+    {
+    public:
+        //! Parse the command line
+        Runner(int argc, char **argv)
+            : m_mode("cpu"), m_min_time(0.2), m_repeat(5), m_tolerance(0.1)
+            {
+            std::string exe(argv[0]);
+            m_executable = exe.substr(exe.find_last_of('/') + 1);
+
+            for (int i = 1; i < argc; i++)
+                {
+                std::string arg(argv[i]);
+                std::string key = arg.substr(0, arg.find('='));
+                std::string value = (arg.find('=') != std::string::npos) ? arg.substr(arg.find('=')+1) : "";
+
+                if (key == "--mode")
+                    m_mode = value;
+                else if (key == "--filter")
+                    m_filter = value;
+                else if (key == "--min-time")
+                    m_min_time = atof(value.c_str());
+                else if (key == "--repeat")
+                    m_repeat = std::max(1, atoi(value.c_str()));
+                else if (key == "--json")
+                    m_json = value;
+                else if (key == "--baseline")
+                    m_baseline = value;
+                else if (key == "--tolerance")
+                    m_tolerance = atof(value.c_str());
+                else
+                    {
+                    std::cerr << "Unknown option " << arg << std::endl;
+                    throw std::runtime_error("Error parsing command line");
+                    }
+                }
+
+            ExecutionConfiguration::executionMode mode = ExecutionConfiguration::CPU;
+            if (m_mode == "gpu")
+                mode = ExecutionConfiguration::GPU;
+            else if (m_mode != "cpu")
+                {
+                std::cerr << "Unknown mode " << m_mode << std::endl;
+                throw std::runtime_error("Error parsing command line");
+                }
+            m_exec_conf = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(mode));
+            m_exec_conf->msg->setNoticeLevel(1);
+            }
+
+        //! Get the execution configuration to run the benchmarks with
+        std::shared_ptr<ExecutionConfiguration> getExecConf()
+            {
+            return m_exec_conf;
+            }
+
+        //! Test if a case is selected by --filter
+        bool enabled(const std::string& name) const
+            {
+            return name.find(m_filter) != std::string::npos;
+            }
+
+        //! Measure a benchmark case
+        /*! \param name Name of the benchmarked kernel
+            \param params Parameters of the synthetic input
+            \param N Number of particles (or objects) processed per iteration
+            \param run Function that executes the kernel n times and returns the time per execution in milliseconds
+
+            The number of iterations per sample is chosen so that each sample takes about --min-time seconds. The
+            median of --repeat samples is reported. In MPI runs, each sample is the time of the slowest rank.
+        */
+        void measure(const std::string& name, const std::string& params, unsigned int N,
+                     std::function<double (unsigned int)> run)
+            {
+            if (!enabled(name))
+                return;
+
+            // calibrate the number of iterations
+            double t_one = reduceMax(run(1));
+            unsigned int iterations = 1;
+            if (t_one > 0.0)
+                iterations = std::max(1u, (unsigned int)std::min(1e6, m_min_time * 1e3 / t_one));
+
+            std::vector<double> samples(m_repeat);
+            for (unsigned int i = 0; i < m_repeat; i++)
+                samples[i] = reduceMax(run(iterations));
+            std::sort(samples.begin(), samples.end());
+
+            Result r;
+            r.name = name;
+            r.params = params;
+            r.N = N;
+            r.iterations = iterations;
+            r.time_ms = samples[m_repeat/2];
+            r.min_ms = samples.front();
+            r.max_ms = samples.back();
+            m_results.push_back(r);
+
+            if (m_exec_conf->getRank() == 0)
+                {
+                std::cout << std::left << std::setw(40) << name << std::setw(32) << params
+                          << std::right << std::setw(12) << std::setprecision(4) << r.time_ms << " ms" << std::endl;
+                }
+            }
+
+        //! Write the results and compare them to the baseline
+        /*! \returns 1 if a case is slower than the baseline by more than the tolerance, 0 otherwise
+        */
+        int finish()
+            {
+            int status = 0;
+            if (m_exec_conf->getRank() == 0)
+                {
+                if (!m_json.empty())
+                    writeJSON();
+                if (!m_baseline.empty())
+                    status = compareBaseline();
+                }
+
+            #ifdef ENABLE_MPI
+            bcast(status, 0, m_exec_conf->getMPICommunicator());
+            #endif
+            return status;
+            }
+
+    private:
+        std::shared_ptr<ExecutionConfiguration> m_exec_conf;   //!< Execution configuration
+        std::string m_executable;       //!< Name of the benchmark executable
+        std::string m_mode;             //!< Execution mode
+        std::string m_filter;           //!< Only run cases whose name contains this string
+        double m_min_time;              //!< Minimum time per sample in seconds
+        unsigned int m_repeat;          //!< Number of samples per case
+        std::string m_json;             //!< File to write the results to
+        std::string m_baseline;         //!< File to compare the results to
+        double m_tolerance;             //!< Relative slowdown that is reported as a regression
+        std::vector<Result> m_results;  //!< Results of all cases
+
+        //! Get the maximum of a time over all ranks
+        double reduceMax(double t)
+            {
+            #ifdef ENABLE_MPI
+            MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+            #endif
+            return t;
+            }
+
+        //! Write all results, one case per line
+        void writeJSON()
+            {
+            unsigned int n_ranks = 1;
+            #ifdef ENABLE_MPI
+            n_ranks = m_exec_conf->getNRanks();
+            #endif
+
+            unsigned int n_threads = 1;
+            #ifdef ENABLE_OPENMP
+            n_threads = omp_get_max_threads();
+            #endif
+
+            std::ofstream out(m_json.c_str());
+            out << std::setprecision(8);
+            out << "{" << std::endl;
+            out << "    \"hoomd_version\": \"" << HOOMD_VERSION << "\"," << std::endl;
+            out << "    \"executable\": \"" << m_executable << "\"," << std::endl;
+            out << "    \"mode\": \"" << m_mode << "\"," << std::endl;
+            out << "    \"precision\": \"" << ((sizeof(Scalar) == sizeof(double)) ? "double" : "single") << "\"," << std::endl;
+            out << "    \"ranks\": " << n_ranks << "," << std::endl;
+            out << "    \"threads\": " << n_threads << "," << std::endl;
+            out << "    \"results\": [" << std::endl;
+            for (unsigned int i = 0; i < m_results.size(); i++)
+                {
+                const Result& r = m_results[i];
+                out << "        {\"name\": \"" << r.name << "\", \"params\": \"" << r.params << "\", \"N\": " << r.N
+                    << ", \"iterations\": " << r.iterations << ", \"time_ms\": " << r.time_ms
+                    << ", \"min_ms\": " << r.min_ms << ", \"max_ms\": " << r.max_ms << "}"
+                    << ((i+1 < m_results.size()) ? "," : "") << std::endl;
+                }
+            out << "    ]" << std::endl;
+            out << "}" << std::endl;
+
+            if (!out.good())
+                {
+                std::cerr << "Error writing " << m_json << std::endl;
+                throw std::runtime_error("Error writing benchmark results");
+                }
+            }
+
+        //! Compare the results to the baseline file
+        int compareBaseline()
+            {
+            std::ifstream in(m_baseline.c_str());
+            if (!in.good())
+                {
+                std::cerr << "Unable to open baseline " << m_baseline << std::endl;
+                throw std::runtime_error("Error reading benchmark baseline");
+                }
+
+            std::map<std::string, double> baseline;
+            std::string line;
+            while (std::getline(in, line))
+                {
+                std::string name, params, time_ms;
+                if (json_find(line, "name", name) && json_find(line, "params", params)
+                    && json_find(line, "time_ms", time_ms))
+                    baseline[name + " " + params] = atof(time_ms.c_str());
+                }
+
+            std::cout << std::endl << "Comparison to " << m_baseline << " (tolerance "
+                      << m_tolerance*100.0 << "%)" << std::endl;
+
+            int status = 0;
+            for (unsigned int i = 0; i < m_results.size(); i++)
+                {
+                const Result& r = m_results[i];
+                std::cout << std::left << std::setw(40) << r.name << std::setw(32) << r.params << std::right;
+
+                std::map<std::string, double>::const_iterator it = baseline.find(r.name + " " + r.params);
+                if (it == baseline.end() || it->second <= 0.0)
+                    {
+                    std::cout << std::setw(12) << "new" << std::endl;
+                    continue;
+                    }
+
+                double change = r.time_ms / it->second - 1.0;
+                std::cout << std::setw(11) << std::showpos << std::fixed << std::setprecision(1) << change*100.0
+                          << "%" << std::noshowpos << std::defaultfloat;
+                if (change > m_tolerance)
+                    {
+                    std::cout << "  REGRESSION";
+                    status = 1;
+                    }
+                std::cout << std::endl;
+                }
+            return status;
+            }
+    };
+
+//! Time n executions of a function
+/*! \param exec_conf Execution configuration
+    \param n Number of executions
+    \param body Function to execute
+    \returns Time per execution in milliseconds
+*/
+inline double time_loop(std::shared_ptr<const ExecutionConfiguration> exec_conf, unsigned int n,
+                        std::function<void ()> body)
+    {
+    ClockSource t;
+    int64_t start_time = t.getTime();
+    for (unsigned int i = 0; i < n; i++)
+        body();
+
+    #ifdef ENABLE_CUDA
+    if (exec_conf->isCUDAEnabled())
+        cudaDeviceSynchronize();
+    #endif
+
+    return double(t.getTime() - start_time) / 1e6 / double(n);
+    }
+
+//! Create a system of N particles at random positions in a cubic box
+/*! \param exec_conf Execution configuration
+    \param N Number of particles
+    \param density Number density
+    \param seed Seed for the positions
+
+    The particles are placed with the Saru generator, so the input is the same on every platform. The particles are
+    of a single type "A" and carry alternating unit charges. In MPI runs, the system is decomposed on all ranks.
+*/
+inline std::shared_ptr<SystemDefinition> make_random_system(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                                            unsigned int N, Scalar density, unsigned int seed=12345)
+    {
+    Scalar L = pow(Scalar(N) / density, Scalar(1.0/3.0));
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(L);
+    snap->particle_data.type_mapping.push_back("A");
+
+    if (exec_conf->getRank() == 0)
+        {
+        snap->particle_data.resize(N);
+        Saru saru(seed);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            snap->particle_data.pos[i] = vec3<Scalar>(saru.s<Scalar>(-L/2, L/2),
+                                                      saru.s<Scalar>(-L/2, L/2),
+                                                      saru.s<Scalar>(-L/2, L/2));
+            snap->particle_data.charge[i] = (i % 2) ? Scalar(-1.0) : Scalar(1.0);
+            }
+        }
+
+    std::shared_ptr<DomainDecomposition> decomposition;
+    #ifdef ENABLE_MPI
+    if (exec_conf->getNRanks() > 1)
+        decomposition = std::shared_ptr<DomainDecomposition>(
+            new DomainDecomposition(exec_conf, snap->global_box.getL()));
+    #endif
+
+    return std::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf, decomposition));
+    }
+
+//! Format the standard parameters of a random system
+inline std::string system_params(unsigned int N, Scalar density)
+    {
+    std::ostringstream s;
+    s << "N=" << N << " density=" << density;
+    return s.str();
+    }
+
+//! Particle numbers of the synthetic systems
+const unsigned int system_sizes[] = {4096, 32768};
+
+//! Number densities of the synthetic systems
+const Scalar system_densities[] = {Scalar(0.3), Scalar(0.85)};
+
+//! A registered benchmark function
+typedef void (*benchmark_function)(Runner& runner);
+
+//! Get the list of registered benchmarks
+inline std::vector< std::pair<std::string, benchmark_function> >& registry()
+    {
+    static std::vector< std::pair<std::string, benchmark_function> > benchmarks;
+    return benchmarks;
+    }
+
+//! Registers a benchmark function at static initialization
+struct Registrar
+    {
+    Registrar(const std::string& name, benchmark_function f)
+        {
+        registry().push_back(std::make_pair(name, f));
+        }
+    };
+
+//! Run all registered benchmarks
+inline int main(int argc, char **argv)
+    {
+    Runner runner(argc, argv);
+    for (unsigned int i = 0; i < registry().size(); i++)
+        registry()[i].second(runner);
+    return runner.finish();
+    }
+
+} // end namespace hoomd_benchmark
+
+//! Define a benchmark function that is run by HOOMD_BENCHMARK_MAIN()
+#define HOOMD_BENCHMARK(name) \
+static void name(hoomd_benchmark::Runner& runner); \
+static hoomd_benchmark::Registrar name##_registrar(#name, name); \
+static void name(hoomd_benchmark::Runner& runner)
+
+#ifdef ENABLE_MPI
+#define HOOMD_BENCHMARK_MAIN() \
+int main(int argc, char **argv) \
+    { \
+    MPI_Init(&argc, &argv); \
+    int val = hoomd_benchmark::main(argc, argv); \
+    MPI_Finalize(); \
+    return val; \
+    }
+#else
+#define HOOMD_BENCHMARK_MAIN() \
+int main(int argc, char **argv) \
+    { \
+    return hoomd_benchmark::main(argc, argv); \
+    }
+#endif
@@ -144,6 +144,9 @@ class SimulationContext(object):
         ## Cached all group
         self.group_all = None;
 
+        ## Checkpoint read by init.read_gsd whose integrator state is restored at the first run
+        self.checkpoint_reader = None;
+
     def set_current(self):
         R""" Force this to be the current context
         """
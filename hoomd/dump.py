@@ -451,6 +451,7 @@ class gsd(hoomd.analyze._analyzer):
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
         time_step (int): Time step to write to the file (only used when period is None)
         static (list): A list of quantity categories that are static.
+        async_write (bool): When True, write frames to the file in a background thread.
 
     Write a simulation snapshot to the specified GSD file at regular intervals.
     GSD is capable of storing all particle and bond data fields that hoomd stores,
@@ -507,6 +508,11 @@ class gsd(hoomd.analyze._analyzer):
     To write restart files with gsd, set `truncate=True`. This will cause :py:class:`dump.gsd` to write a new frame 0
     to the file every period steps.
 
+    With `async_write=True`, :py:class:`dump.gsd` copies the data of each frame into a buffer and returns, while a
+    background thread on the root rank writes the buffer to the file. The simulation continues while the frame is
+    written. The file may lag behind the simulation by one frame until :py:meth:`write_restart` is called or the
+    writer is destroyed.
+
     dump.gsd writes static quantities from frame 0 only. Even if they change, it will not write them to subsequent
     frames. Quantity categories **not** listed in *static* are dynamic. :py:class:`dump.gsd` writes dynamic quantities to every frame.
     The default is only to write particle properties (position, orientation) on each frame, and hold all others fixed.
@@ -530,7 +536,8 @@ class gsd(hoomd.analyze._analyzer):
                  truncate=False,
                  phase=0,
                  time_step=None,
-                 static=['attribute', 'momentum', 'topology']):
+                 static=['attribute', 'momentum', 'topology'],
+                 async_write=False):
         hoomd.util.print_status_line();
 
         for v in static:
@@ -546,6 +553,7 @@ class gsd(hoomd.analyze._analyzer):
         self.cpp_analyzer.setWriteProperty('property' not in static);
         self.cpp_analyzer.setWriteMomentum('momentum' not in static);
         self.cpp_analyzer.setWriteTopology('topology' not in static);
+        self.cpp_analyzer.setAsync(async_write);
 
         if period is not None:
             self.setupAnalyzer(period, phase);
@@ -553,6 +561,7 @@ class gsd(hoomd.analyze._analyzer):
             if time_step is None:
                 time_step = hoomd.context.current.system.getCurrentTimeStep()
             self.cpp_analyzer.analyze(time_step);
+            self.cpp_analyzer.flush();
 
         # store metadata
         self.filename = filename
@@ -571,3 +580,77 @@ class gsd(hoomd.analyze._analyzer):
 
         time_step = hoomd.context.current.system.getCurrentTimeStep()
         self.cpp_analyzer.analyze(time_step);
+        self.cpp_analyzer.flush();
+
+class checkpoint(hoomd.analyze._analyzer):
+    R""" Writes binary checkpoints for exact restarts
+
+    Args:
+        filename (str): File name to write
+        period (int): Number of time steps between checkpoints, or None to write a single checkpoint immediately.
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+
+    :py:class:`dump.checkpoint` periodically writes the complete dynamic state of the simulation in a compact binary
+    format: particle positions, velocities, accelerations, images, orientations, angular momenta, and the other
+    per-particle quantities in the precision of the build, the box, the time step, the integrator variables (such as
+    the thermostat variables of :py:class:`hoomd.md.integrate.nvt`), and the additional state of the integrator (such
+    as the move sizes of an HPMC integrator). Restore a checkpoint with the *checkpoint* argument of
+    :py:func:`hoomd.init.read_gsd`. Because all random number streams in HOOMD are seeded by the time step, a restored
+    simulation continues bit for bit like a simulation that ends its :py:func:`hoomd.run()` at the checkpoint and
+    starts a new one.
+
+    Each MPI rank writes the particles it owns to its own file, *filename*.<rank>. With a single rank, the file name is
+    *filename*. A checkpoint must be restored on the same number of ranks with the same processor grid. Every file is
+    first written to a temporary file and then renamed, so that an interrupted write does not destroy the previous
+    checkpoint. With several ranks, the files are renamed only after all ranks have written them, and the marker file
+    *filename*.commit exists while they are renamed. If a job is killed during the renames,
+    :py:func:`hoomd.init.read_gsd` completes them. Restoring fails if the files of the ranks are from different time
+    steps.
+
+    Checkpoints do not store the topology or any parameters. The job script must read the same GSD file and set up the
+    same forces and integration methods as the one that wrote the checkpoint.
+
+    Examples::
+
+        system = init.read_gsd(filename="init.gsd", checkpoint="restart.ckp")
+        ...
+        ckp = dump.checkpoint(filename="restart.ckp", period=10000)
+        run(1e6)
+        ckp.write()
+
+    """
+    def __init__(self, filename, period, phase=0):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        hoomd.analyze._analyzer.__init__(self);
+
+        self.cpp_analyzer = _hoomd.CheckpointWriter(hoomd.context.current.system_definition, filename);
+
+        if period is not None:
+            self.setupAnalyzer(period, phase);
+        else:
+            self.write();
+
+        # store metadata
+        self.filename = filename
+        self.period = period
+        self.phase = phase
+        self.metadata_fields = ['filename','period','phase']
+
+    def write(self):
+        """ Write a checkpoint at the current time step.
+
+        Call :py:meth:`write` at the end of a job script to store the final state of the simulation.
+        """
+        self.update_integrator();
+
+        time_step = hoomd.context.current.system.getCurrentTimeStep()
+        self.cpp_analyzer.analyze(time_step);
+
+    ## \internal
+    # \brief Sets the integrator whose state is written
+    # \details This method is triggered every time the run command is called
+    def update_integrator(self):
+        if hoomd.context.current.integrator is not None:
+            self.cpp_analyzer.setIntegrator(hoomd.context.current.integrator.cpp_integrator);
@@ -0,0 +1,309 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+#include "HPMCPrecisionSetup.h"
+#include "hoomd/VectorMath.h"
+#include "MinkowskiMath.h"
+
+#ifndef __GJK_RAYCAST_3D_H__
+#define __GJK_RAYCAST_3D_H__
+
+/*! \file GJKRayCast3D.h
+    \brief Implements the GJK ray cast in 3D
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+namespace hpmc
+{
+
+namespace detail
+{
+
+const unsigned int GJK_RAYCAST_3D_MAX_ITERATIONS = 128;
+
+//! Closest point to the origin on the segment (a,b)
+/*! \param a First vertex
+    \param b Second vertex
+    \param mask Set to the bit mask of the vertices whose hull contains the closest point
+*/
+DEVICE inline vec3<OverlapReal> gjk_closest_segment(const vec3<OverlapReal>& a, const vec3<OverlapReal>& b,
+    unsigned int& mask)
+    {
+    vec3<OverlapReal> ab = b - a;
+    OverlapReal t = -dot(a, ab);
+    if (t <= OverlapReal(0.0))
+        {
+        mask = 1;
+        return a;
+        }
+
+    OverlapReal denom = dot(ab, ab);
+    if (t >= denom)
+        {
+        mask = 2;
+        return b;
+        }
+
+    mask = 3;
+    return a + (t/denom)*ab;
+    }
+
+//! Closest point to the origin on the triangle (a,b,c)
+/*! \param a First vertex
+    \param b Second vertex
+    \param c Third vertex
+    \param mask Set to the bit mask of the vertices whose hull contains the closest point
+
+    The Voronoi region test follows C. Ericson, Real-Time Collision Detection, section 5.1.5.
+*/
+DEVICE inline vec3<OverlapReal> gjk_closest_triangle(const vec3<OverlapReal>& a, const vec3<OverlapReal>& b,
+    const vec3<OverlapReal>& c, unsigned int& mask)
+    {
+    vec3<OverlapReal> ab = b - a;
+    vec3<OverlapReal> ac = c - a;
+
+    OverlapReal d1 = -dot(ab, a);
+    OverlapReal d2 = -dot(ac, a);
+    if (d1 <= OverlapReal(0.0) && d2 <= OverlapReal(0.0))
+        {
+        mask = 1;
+        return a;
+        }
+
+    OverlapReal d3 = -dot(ab, b);
+    OverlapReal d4 = -dot(ac, b);
+    if (d3 >= OverlapReal(0.0) && d4 <= d3)
+        {
+        mask = 2;
+        return b;
+        }
+
+    OverlapReal vc = d1*d4 - d3*d2;
+    if (vc <= OverlapReal(0.0) && d1 >= OverlapReal(0.0) && d3 <= OverlapReal(0.0))
+        {
+        mask = 3;
+        return a + (d1/(d1 - d3))*ab;
+        }
+
+    OverlapReal d5 = -dot(ab, c);
+    OverlapReal d6 = -dot(ac, c);
+    if (d6 >= OverlapReal(0.0) && d5 <= d6)
+        {
+        mask = 4;
+        return c;
+        }
+
+    OverlapReal vb = d5*d2 - d1*d6;
+    if (vb <= OverlapReal(0.0) && d2 >= OverlapReal(0.0) && d6 <= OverlapReal(0.0))
+        {
+        mask = 5;
+        return a + (d2/(d2 - d6))*ac;
+        }
+
+    OverlapReal va = d3*d6 - d5*d4;
+    if (va <= OverlapReal(0.0) && (d4 - d3) >= OverlapReal(0.0) && (d5 - d6) >= OverlapReal(0.0))
+        {
+        mask = 6;
+        return b + ((d4 - d3)/((d4 - d3) + (d5 - d6)))*(c - b);
+        }
+
+    OverlapReal denom = va + vb + vc;
+    if (denom <= OverlapReal(0.0))
+        {
+        // degenerate triangle, the closest point is on one of the edges
+        unsigned int mask_ab, mask_ac;
+        vec3<OverlapReal> p_ab = gjk_closest_segment(a, b, mask_ab);
+        vec3<OverlapReal> p_ac = gjk_closest_segment(a, c, mask_ac);
+        if (dot(p_ab, p_ab) <= dot(p_ac, p_ac))
+            {
+            mask = mask_ab;
+            return p_ab;
+            }
+        mask = (mask_ac & 1) | ((mask_ac & 2) << 1);
+        return p_ac;
+        }
+
+    mask = 7;
+    return a + (vb/denom)*ab + (vc/denom)*ac;
+    }
+
+//! Closest point to the origin on the tetrahedron (a,b,c,d)
+/*! \param y Vertices of the tetrahedron
+    \param mask Set to the bit mask of the vertices whose hull contains the closest point
+
+    The origin is tested against every face, and the closest point is searched on the faces that have the origin on
+    the outside. When the origin is inside, it is its own closest point and all four vertices are kept.
+*/
+DEVICE inline vec3<OverlapReal> gjk_closest_tetrahedron(const vec3<OverlapReal> *y, unsigned int& mask)
+    {
+    // faces as vertex indices, the fourth index is the opposite vertex
+    const unsigned int faces[4][4] = {{0,1,2,3}, {0,2,3,1}, {0,3,1,2}, {1,3,2,0}};
+
+    vec3<OverlapReal> closest(0,0,0);
+    OverlapReal closest_sq(-1.0);
+    mask = 15;
+
+    for (unsigned int f = 0; f < 4; ++f)
+        {
+        const vec3<OverlapReal>& a = y[faces[f][0]];
+        const vec3<OverlapReal>& b = y[faces[f][1]];
+        const vec3<OverlapReal>& c = y[faces[f][2]];
+        const vec3<OverlapReal>& d = y[faces[f][3]];
+
+        vec3<OverlapReal> n = cross(b - a, c - a);
+        OverlapReal side_origin = -dot(a, n);
+        OverlapReal side_d = dot(d - a, n);
+
+        // skip faces with the origin on the inside, flat tetrahedra test all faces
+        if (side_origin*side_d > OverlapReal(0.0))
+            continue;
+
+        unsigned int face_mask;
+        vec3<OverlapReal> p = gjk_closest_triangle(a, b, c, face_mask);
+        OverlapReal p_sq = dot(p, p);
+
+        if (closest_sq < OverlapReal(0.0) || p_sq < closest_sq)
+            {
+            closest = p;
+            closest_sq = p_sq;
+            mask = 0;
+            for (unsigned int i = 0; i < 3; ++i)
+                if (face_mask & (1 << i))
+                    mask |= 1 << faces[f][i];
+            }
+        }
+
+    return closest;
+    }
+
+//! GJK ray cast in 3D
+/*! \tparam SupportFuncA Support function class type for shape A
+    \tparam SupportFuncB Support function class type for shape B
+    \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param dir Unit vector along which shape A moves, in frame A
+    \param R Approximate radius of Minkowski difference for scaling tolerance value
+    \param err_count Error counter to increment whenever an infinite loop is encountered
+    \returns The distance that A can move along *dir* before it touches B, or a negative value if A never touches B.
+
+    Moving A by s *dir* makes the shapes overlap when s *dir* lies in the Minkowski difference C = (B + ab_t) - A.
+    The collision distance is found by casting a ray from the origin along *dir* against C with the algorithm of
+
+    G. van den Bergen, "Ray Casting against General Convex Objects with Application to Continuous Collision
+    Detection", 2004.
+
+    The ray is advanced to successive support planes of C, so the returned distance never exceeds the true collision
+    distance and the shapes do not overlap after the move. Like XenoCollide, only the support functions of the shapes
+    are used, and the coordinate system is that of test_overlap(): A is at the origin with orientation (1,0,0,0),
+    and B is at *ab_t* with orientation *q*. Shapes that are already overlapping return 0.
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline OverlapReal gjk_raycast_3d(const SupportFuncA& sa,
+                                         const SupportFuncB& sb,
+                                         const vec3<OverlapReal>& ab_t,
+                                         const quat<OverlapReal>& q,
+                                         const vec3<OverlapReal>& dir,
+                                         const OverlapReal R,
+                                         unsigned int& err_count)
+    {
+    CompositeSupportFunc3D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, q);
+    const OverlapReal precision_tol = 1e-6;
+    const OverlapReal tol_sq = precision_tol*R*precision_tol*R;
+
+    OverlapReal lambda(0.0);
+    vec3<OverlapReal> x(0,0,0);
+
+    // ab_t lies inside C, as both shapes contain their centers
+    vec3<OverlapReal> v = x - ab_t;
+
+    // support points of C spanning the current simplex
+    vec3<OverlapReal> p[4];
+    unsigned int n = 0;
+
+    unsigned int count = 0;
+    while (dot(v, v) > tol_sq)
+        {
+        count++;
+        if (count > GJK_RAYCAST_3D_MAX_ITERATIONS)
+            {
+            err_count++;
+            return lambda;
+            }
+
+        vec3<OverlapReal> s = S(v);
+        vec3<OverlapReal> w = x - s;
+        OverlapReal vw = dot(v, w);
+
+        bool advanced = false;
+        if (vw > OverlapReal(0.0))
+            {
+            // x is outside of the support plane, advance the ray to it
+            OverlapReal vr = dot(v, dir);
+            if (vr >= OverlapReal(0.0))
+                return OverlapReal(-1.0);
+
+            lambda -= vw/vr;
+            x = lambda*dir;
+            advanced = true;
+            }
+
+        // a support point that is already part of the simplex only helps when the ray has moved
+        bool known = false;
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            vec3<OverlapReal> delta = p[i] - s;
+            if (dot(delta, delta) <= tol_sq)
+                known = true;
+            }
+        if (known && !advanced)
+            break;
+
+        if (!known)
+            p[n++] = s;
+
+        vec3<OverlapReal> y[4];
+        for (unsigned int i = 0; i < n; ++i)
+            y[i] = x - p[i];
+
+        // find the point of the simplex closest to the origin and reduce the simplex to the vertices supporting it
+        unsigned int mask = 1;
+        if (n == 1)
+            v = y[0];
+        else if (n == 2)
+            v = gjk_closest_segment(y[0], y[1], mask);
+        else if (n == 3)
+            v = gjk_closest_triangle(y[0], y[1], y[2], mask);
+        else
+            v = gjk_closest_tetrahedron(y, mask);
+
+        unsigned int m = 0;
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            if (mask & (1 << i))
+                p[m++] = p[i];
+            }
+        n = m;
+
+        // the origin is inside the tetrahedron
+        if (n == 4)
+            break;
+        }
+
+    return lambda;
+    }
+
+}; // end namespace detail
+
+}; // end namespace hpmc
+
+#endif // __GJK_RAYCAST_3D_H__
@@ -89,6 +89,19 @@ DEVICE inline hpmc_counters_t operator-(const hpmc_counters_t& a, const hpmc_cou
     }
 
 
+//! Sum two sets of counters
+DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_counters_t& b)
+    {
+    hpmc_counters_t result;
+    result.translate_accept_count = a.translate_accept_count + b.translate_accept_count;
+    result.rotate_accept_count = a.rotate_accept_count + b.rotate_accept_count;
+    result.translate_reject_count = a.translate_reject_count + b.translate_reject_count;
+    result.rotate_reject_count = a.rotate_reject_count + b.rotate_reject_count;
+    result.overlap_checks = a.overlap_checks + b.overlap_checks;
+    result.overlap_err_count = a.overlap_err_count + b.overlap_err_count;
+    return result;
+    }
+
 //! Storage for NPT acceptance counters
 /*! \ingroup hpmc_data_structs */
 struct hpmc_boxmc_counters_t
@@ -307,6 +320,81 @@ struct hpmc_muvt_counters_t
 
     };
 
+//! Storage for cluster move counters
+/*! \ingroup hpmc_data_structs */
+struct hpmc_clusters_counters_t
+    {
+    unsigned long long int pivot_count;              //!< Count of point reflection moves
+    unsigned long long int rotation_count;           //!< Count of rotation moves
+    unsigned long long int particle_count;           //!< Total number of particles moved in clusters
+
+    //! Construct a zero set of counters
+    hpmc_clusters_counters_t()
+        {
+        pivot_count = 0;
+        rotation_count = 0;
+        particle_count = 0;
+        }
+
+    //! Get the number of cluster moves
+    /*! \returns The total number of moves
+    */
+    DEVICE unsigned long long int getNMoves()
+        {
+        return pivot_count + rotation_count;
+        }
+
+    //! Get the average cluster size
+    /*! \returns The average number of particles moved in one cluster move, or 0 if there are no moves
+    */
+    DEVICE double getAverageClusterSize()
+        {
+        if (getNMoves() == 0)
+            return 0.0;
+        else
+            return double(particle_count) / double(getNMoves());
+        }
+    };
+
+//! Storage for event chain counters
+/*! \ingroup hpmc_data_structs */
+struct hpmc_event_chain_counters_t
+    {
+    unsigned long long int chain_count;              //!< Count of event chains
+    unsigned long long int event_count;              //!< Count of chain segments (events)
+    unsigned long long int collision_count;          //!< Count of events that ended in a collision
+
+    //! Construct a zero set of counters
+    hpmc_event_chain_counters_t()
+        {
+        chain_count = 0;
+        event_count = 0;
+        collision_count = 0;
+        }
+
+    //! Get the average number of collisions per chain
+    /*! \returns The number of collisions divided by the number of chains, or 0 if there are no chains
+    */
+    DEVICE double getCollisionsPerChain()
+        {
+        if (chain_count == 0)
+            return 0.0;
+        else
+            return double(collision_count) / double(chain_count);
+        }
+
+    //! Get the fraction of events that end in a collision
+    /*! \returns The ratio of collisions to events, or 0 if there are no events
+    */
+    DEVICE double getCollisionFraction()
+        {
+        if (event_count == 0)
+            return 0.0;
+        else
+            return double(collision_count) / double(event_count);
+        }
+    };
+
 //! Take the difference of two sets of counters
 DEVICE inline hpmc_implicit_counters_t operator-(const hpmc_implicit_counters_t& a, const hpmc_implicit_counters_t& b)
     {
@@ -332,6 +420,24 @@ DEVICE inline hpmc_muvt_counters_t operator-(const hpmc_muvt_counters_t& a, cons
     return result;
     }
 
+DEVICE inline hpmc_clusters_counters_t operator-(const hpmc_clusters_counters_t& a, const hpmc_clusters_counters_t& b)
+    {
+    hpmc_clusters_counters_t result;
+    result.pivot_count = a.pivot_count - b.pivot_count;
+    result.rotation_count = a.rotation_count - b.rotation_count;
+    result.particle_count = a.particle_count - b.particle_count;
+    return result;
+    }
+
+DEVICE inline hpmc_event_chain_counters_t operator-(const hpmc_event_chain_counters_t& a, const hpmc_event_chain_counters_t& b)
+    {
+    hpmc_event_chain_counters_t result;
+    result.chain_count = a.chain_count - b.chain_count;
+    result.event_count = a.event_count - b.event_count;
+    result.collision_count = a.collision_count - b.collision_count;
+    return result;
+    }
+
 } // end namespace hpmc
 
 #endif // _HPMC_COUNTERS_H_
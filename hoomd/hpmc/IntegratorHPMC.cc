@@ -6,8 +6,13 @@
 namespace py = pybind11;
 
 #include "hoomd/VectorMath.h"
+#include "hoomd/Checkpoint.h"
 #include <sstream>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 /*! \file IntegratorHPMC.cc
@@ -234,6 +239,7 @@ bool IntegratorHPMC::attemptBoxResize(unsigned int timestep, const BoxDim& new_b
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
 
         // move the particles to be inside the new box
+        #pragma omp parallel for schedule(static)
         for (unsigned int i = 0; i < N; i++)
             {
             Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -255,7 +261,7 @@ bool IntegratorHPMC::attemptBoxResize(unsigned int timestep, const BoxDim& new_b
     this->communicate(false);
 
     // check overlaps
-    return !this->countOverlaps(timestep, true);
+    return !this->hasOverlaps(timestep);
     }
 
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the last executed step
@@ -292,6 +298,57 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
     return result;
     }
 
+/*! \param out Checkpoint stream
+
+    The move sizes are usually changed by tuners during the run, so they are part of the state needed to continue
+    a simulation exactly.
+*/
+void IntegratorHPMC::writeCheckpoint(std::ostream& out)
+    {
+    std::vector<Scalar> d(m_d.size()), a(m_a.size());
+        {
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+        std::copy(h_d.data, h_d.data + m_d.size(), d.begin());
+        std::copy(h_a.data, h_a.data + m_a.size(), a.begin());
+        }
+    checkpoint_write_vector(out, d);
+    checkpoint_write_vector(out, a);
+
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::read);
+    checkpoint_write(out, h_counters.data[0]);
+    checkpoint_write(out, m_count_run_start);
+    checkpoint_write(out, m_count_step_start);
+    }
+
+/*! \param in Checkpoint stream
+
+    Sets the failbit of \a in if the checkpoint was written with a different number of types.
+*/
+void IntegratorHPMC::readCheckpoint(std::istream& in)
+    {
+    std::vector<Scalar> d, a;
+    checkpoint_read_vector(in, d);
+    checkpoint_read_vector(in, a);
+    if (!in.good() || d.size() != m_d.size() || a.size() != m_a.size())
+        {
+        in.setstate(std::ios::failbit);
+        return;
+        }
+
+        {
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::overwrite);
+        std::copy(d.begin(), d.end(), h_d.data);
+        std::copy(a.begin(), a.end(), h_a.data);
+        }
+
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total, access_location::host, access_mode::readwrite);
+    checkpoint_read(in, h_counters.data[0]);
+    checkpoint_read(in, m_count_run_start);
+    checkpoint_read(in, m_count_step_start);
+    }
+
 void export_IntegratorHPMC(py::module& m)
     {
    py::class_<IntegratorHPMC, std::shared_ptr< IntegratorHPMC > >(m, "IntegratorHPMC", py::base<Integrator>())
@@ -198,6 +198,17 @@ class IntegratorHPMC : public Integrator
             return 0;
             }
 
+        //! Test if there is any particle overlap
+        /*! \param timestep current step
+            \returns true if at least one overlap was found on any rank
+
+            Integrators may override this with a faster test than countOverlaps(timestep, true).
+        */
+        virtual bool hasOverlaps(unsigned int timestep)
+            {
+            return countOverlaps(timestep, true) > 0;
+            }
+
         //! Get the number of degrees of freedom granted to a given group
         /*! \param group Group over which to count degrees of freedom.
             \return a non-zero dummy value to suppress warnings.
@@ -221,6 +232,12 @@ class IntegratorHPMC : public Integrator
         //! Get the current counter values
         hpmc_counters_t getCounters(unsigned int mode=0);
 
+        //! Write the move sizes and counters to a checkpoint
+        virtual void writeCheckpoint(std::ostream& out);
+
+        //! Read the move sizes and counters from a checkpoint
+        virtual void readCheckpoint(std::istream& in);
+
         //! Communicate particles
         /*! \param migrate Set to true to both migrate and exchange, set to false to only exchange
 
@@ -11,6 +11,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <limits>
 
 #include "hoomd/Integrator.h"
 #include "HPMCPrecisionSetup.h"
@@ -40,6 +42,10 @@
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #endif
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 namespace hpmc
 {
 
@@ -119,6 +125,19 @@ class UpdateOrder
 
     TODO: I need better documentation
 
+    <b>Checkerboard mode</b>
+
+    By default, every sweep visits the local particles serially in a shuffled order. When checkerboard mode is enabled
+    with setCheckerboard(), the local box is instead divided into cells that are at least as wide as the largest
+    particle, with an even number of cells along every periodic direction. The cells are grouped into 4 (2D) or 8 (3D)
+    sets so that no two cells in the same set are adjacent. Within one set, all cells are processed concurrently
+    (using OpenMP threads when HOOMD is compiled with ENABLE_OPENMP), as particles in non-adjacent cells cannot
+    overlap. Trial moves that leave the particle's cell are counted as rejected. The cell grid is randomly shifted every
+    step and the set order is shuffled every sweep to preserve detailed balance, as on the GPU. Every trial move uses
+    the same per-particle random number stream as the serial path, so the result does not depend on the number of
+    threads. Counters are accumulated per thread and summed at the end of the step. The AABB tree is read only during
+    a set, and moved particles are updated in the tree after the set is complete.
+
     \ingroup hpmc_integrators
 */
 template < class Shape >
@@ -156,6 +175,18 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Set elements of the interaction matrix
         virtual void setOverlapChecks(unsigned int typi, unsigned int typj, bool check_overlaps);
 
+        //! Enable or disable checkerboard mode for CPU sweeps
+        void setCheckerboard(bool checkerboard)
+            {
+            m_checkerboard = checkerboard;
+            }
+
+        //! Get the checkerboard mode flag
+        bool getCheckerboard()
+            {
+            return m_checkerboard;
+            }
+
         //! Set the external field for the integrator
         void setExternalField(std::shared_ptr< ExternalFieldMono<Shape> > external)
             {
@@ -184,6 +215,9 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Count overlaps with the option to exit early at the first detected overlap
         virtual unsigned int countOverlaps(unsigned int timestep, bool early_exit);
 
+        //! Test for any overlap, checking the most compressed particles first
+        virtual bool hasOverlaps(unsigned int timestep);
+
         //! Return a vector that is an unwrapped overlap map
         virtual std::vector<bool> mapOverlaps();
 
@@ -261,6 +295,23 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
 
+        //! Set the SAH cost ratio above which a refit AABB tree is rebuilt (0 disables refits)
+        void setAABBTreeRefitThreshold(Scalar threshold)
+            {
+            if (threshold != Scalar(0.0) && threshold < Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "integrate.*: AABB tree refit threshold must be 0 or >= 1" << std::endl;
+                throw std::runtime_error("Error setting HPMC parameters");
+                }
+            m_aabb_tree_refit_threshold = threshold;
+            }
+
+        //! Get the SAH cost of the current AABB tree
+        Scalar getAABBTreeCost()
+            {
+            return m_aabb_tree.getSAHCost();
+            }
+
     protected:
         GPUArray<param_type> m_params;              //!< Parameters for each particle type
         GPUArray<unsigned int> m_overlaps;          //!< Interaction matrix (0/1) for overlap checks
@@ -278,11 +329,29 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_moved;                     //!< Flag if particles moved since the aabb tree was last fit
+        Scalar m_aabb_tree_refit_threshold;         //!< Rebuild when the SAH cost exceeds this multiple of the built cost
+        Scalar m_aabb_tree_build_cost;              //!< SAH cost of the aabb tree after the last full build
 
         bool m_past_first_run;                      //!< Flag to test if the first run() has started
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
+        bool m_checkerboard;                                      //!< True if sweeps are performed on a checkerboard
+        uint3 m_checkerboard_dim;                                 //!< Number of checkerboard cells along each direction
+        Scalar3 m_checkerboard_shift;                             //!< Fractional shift of the cell grid
+        std::vector<unsigned int> m_checkerboard_cell;            //!< Cell of each local particle
+        std::vector<unsigned int> m_checkerboard_cell_start;      //!< First entry of each cell in the particle list
+        std::vector<unsigned int> m_checkerboard_cell_particles;  //!< Local particles sorted by cell
+        std::vector<unsigned int> m_checkerboard_set_start;       //!< First entry of each set in the cell list
+        std::vector<unsigned int> m_checkerboard_set_cells;       //!< Non-empty cells sorted by set
+        std::vector< std::vector<unsigned int> > m_checkerboard_moved; //!< Particles moved by each thread in a set
+        detail::UpdateOrder m_checkerboard_set_order;             //!< Update order for cell sets
+
+        bool m_contact_valid;                       //!< True if m_contact_ratio is indexed by the current particle order
+        std::vector<float> m_contact_ratio;         //!< Nearest contact distance of each particle relative to contact
+        std::vector<unsigned int> m_contact_order;  //!< Order in which hasOverlaps() checks the local particles
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -292,20 +361,30 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        //! Assign the local particles to checkerboard cells
+        bool initializeCheckerboard(unsigned int timestep);
+
+        //! Get the checkerboard cell of a position
+        unsigned int getCheckerboardCell(const BoxDim& box, const vec3<Scalar>& pos);
+
+        //! Perform the nselect sweeps on a checkerboard of cells
+        void updateCheckerboard(unsigned int timestep, hpmc_counters_t& counters);
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
             m_image_list_valid = false;
             // changing the box does not necessarily invalidate the AABB tree - however, practically
             // anything that changes the box (i.e. NPT, box_resize) is also moving the particles,
-            // so use it as a sign to rebuild the AABB tree
-            m_aabb_tree_invalid = true;
+            // so use it as a sign to refit or rebuild the AABB tree
+            m_aabb_tree_moved = true;
             }
 
         //! callback so that the particle sort signal can invalidate the AABB tree
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+            m_contact_valid = false;
             }
     };
 
@@ -317,7 +396,10 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
               m_hasOrientation(true),
-              m_past_first_run(false)
+              m_past_first_run(false),
+              m_checkerboard(false),
+              m_checkerboard_set_order(seed+m_exec_conf->getRank()),
+              m_contact_valid(false)
     {
     // allocate the parameter storage
     GPUArray<param_type> params(m_pdata->getNTypes(), m_exec_conf);
@@ -338,6 +420,9 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_moved = false;
+    m_aabb_tree_refit_threshold = Scalar(0.0);
+    m_aabb_tree_build_cost = Scalar(0.0);
     }
 
 template <class Shape>
@@ -424,11 +509,16 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         m_external->compute(timestep);
         }
 
+    // perform the sweeps on a checkerboard of cells if requested and possible with the current box
+    bool checkerboard = m_checkerboard && initializeCheckerboard(timestep);
+    if (checkerboard)
+        updateCheckerboard(timestep, counters);
+
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
     // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect && !checkerboard; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -661,8 +751,9 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // migrate and exchange particles
     communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
-    m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit (communicate() invalidates it if the particle
+    // order changed)
+    m_aabb_tree_moved = true;
     }
 
 /*! \param timestep current step
@@ -799,6 +890,196 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(unsigned int timestep, boo
     return overlap_count;
     }
 
+/*! \param timestep current step
+    \returns true if at least one overlap was found on any rank
+
+    Box resize trials only need to know whether there is any overlap, and an overlap is by far most likely between
+    the particles that were closest to contact. Every scanned particle records the distance to its nearest neighbor
+    relative to the sum of the circumsphere radii. The next call checks the particles with the smallest ratios first
+    and the remaining ones in index order. The scan is threaded and all threads stop at the first overlap found.
+
+    After a scan without overlaps (an accepted trial), the ratios of all particles are up to date. The ratios are
+    discarded when the particles are sorted.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::hasOverlaps(unsigned int timestep)
+    {
+    m_exec_conf->msg->notice(10) << "HPMCMono check overlaps: " << timestep << std::endl;
+
+    if (!m_past_first_run)
+        {
+        m_exec_conf->msg->error() << "count_overlaps only works after a run() command" << std::endl;
+        throw std::runtime_error("Error communicating in count_overlaps");
+        }
+
+    // build an up to date AABB tree
+    buildAABBTree();
+    // update the image list
+    updateImageList();
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC check overlaps");
+
+    const unsigned int N = m_pdata->getN();
+
+    if (!m_contact_valid || m_contact_ratio.size() != N)
+        {
+        m_contact_ratio.assign(N, std::numeric_limits<float>::max());
+        m_contact_valid = true;
+        }
+
+    // order by contact ratio, ties broken by index
+    const std::vector<float>& ratio = m_contact_ratio;
+    auto closer = [&ratio](unsigned int a, unsigned int b)
+        {
+        return ratio[a] < ratio[b] || (ratio[a] == ratio[b] && a < b);
+        };
+
+    // the closest particles go first, sorted by ratio, followed by all others in index order for memory locality
+    m_contact_order.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+        m_contact_order[i] = i;
+
+    unsigned int n_first = std::min(N, std::max(N/16, (unsigned int)64));
+    if (n_first < N)
+        {
+        std::nth_element(m_contact_order.begin(), m_contact_order.begin() + n_first, m_contact_order.end(), closer);
+        std::sort(m_contact_order.begin(), m_contact_order.begin() + n_first, closer);
+        unsigned int pivot = m_contact_order[n_first];
+        unsigned int k = n_first;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            if (!closer(i, pivot))
+                m_contact_order[k++] = i;
+            }
+        }
+    else
+        {
+        std::sort(m_contact_order.begin(), m_contact_order.end(), closer);
+        }
+
+    // access particle data and system box
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    // access parameters and interaction matrix
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    int found = 0;
+    unsigned int err_count = 0;
+
+    #pragma omp parallel for schedule(dynamic, 16) reduction(+:err_count) if (n_threads > 1)
+    for (unsigned int k = 0; k < N; k++)
+        {
+        // another thread found an overlap, skip the remaining particles
+        int stop;
+        #pragma omp atomic read
+        stop = found;
+        if (stop)
+            continue;
+
+        unsigned int i = m_contact_order[k];
+
+        // read in the current position and orientation
+        Scalar4 postype_i = h_postype.data[i];
+        Scalar4 orientation_i = h_orientation.data[i];
+        unsigned int typ_i = __scalar_as_int(postype_i.w);
+        Shape shape_i(quat<Scalar>(orientation_i), h_params.data[typ_i]);
+        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+        OverlapReal d_i = shape_i.getCircumsphereDiameter();
+
+        // Check particle against AABB tree for neighbors
+        detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+
+        float min_ratio = std::numeric_limits<float>::max();
+        bool overlap = false;
+        unsigned int err = 0;
+
+        const unsigned int n_images = m_image_list.size();
+        for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
+            {
+            vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+            detail::AABB aabb = aabb_i_local;
+            aabb.translate(pos_i_image);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes() && !overlap; cur_node_idx++)
+                {
+                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    {
+                    if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            {
+                            // read in its position and orientation
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            // skip i==j in the 0 image
+                            if (cur_image == 0 && i == j)
+                                continue;
+
+                            Scalar4 postype_j = h_postype.data[j];
+                            Scalar4 orientation_j = h_orientation.data[j];
+
+                            // put particles in coordinate system of particle i
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Shape shape_j(quat<Scalar>(orientation_j), h_params.data[typ_j]);
+
+                            // record the nearest contact
+                            OverlapReal contact = OverlapReal(0.5)*(d_i + shape_j.getCircumsphereDiameter());
+                            if (contact > OverlapReal(0.0))
+                                min_ratio = std::min(min_ratio, float(sqrt(dot(r_ij,r_ij))/contact));
+
+                            if (h_tag.data[i] <= h_tag.data[j]
+                                && h_overlaps.data[m_overlap_idx(typ_i,typ_j)]
+                                && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                && test_overlap(r_ij, shape_i, shape_j, err)
+                                && test_overlap(-r_ij, shape_j, shape_i, err))
+                                {
+                                overlap = true;
+                                break;
+                                }
+                            }
+                        }
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                    }
+                } // end loop over AABB nodes
+            } // end loop over images
+
+        m_contact_ratio[i] = min_ratio;
+        err_count += err;
+
+        if (overlap)
+            {
+            #pragma omp atomic write
+            found = 1;
+            }
+        } // end loop over particles
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    return found != 0;
+    }
+
 template <class Shape>
 Scalar IntegratorHPMCMono<Shape>::getMaxDiameter()
     {
@@ -1053,6 +1334,10 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
     this is on the next timestep. But in same cases (i.e. NPT), the tree may need to be rebuilt several times in a
     single step because of box volume moves.
 
+    When particles only moved and the particle list kept its order, it is sufficient to set m_aabb_tree_moved. If
+    m_aabb_tree_refit_threshold is non-zero, the existing tree is then refit to the new AABBs in O(N) time and only
+    rebuilt once its SAH cost exceeds m_aabb_tree_refit_threshold times the cost right after the last full build.
+
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
@@ -1061,7 +1346,7 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
 template <class Shape>
 const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
-    if (m_aabb_tree_invalid)
+    if (m_aabb_tree_invalid || m_aabb_tree_moved)
         {
         m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
         if (this->m_prof) this->m_prof->push(this->m_exec_conf, "AABB tree build");
@@ -1082,7 +1367,25 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                     Shape shape(quat<Scalar>(h_orientation.data[i]), h_params.data[__scalar_as_int(h_postype.data[i].w)]);
                     m_aabbs[i] = shape.getAABB(vec3<Scalar>(h_postype.data[i]));
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the tree when only positions changed, as long as its quality is acceptable
+                bool rebuild = true;
+                if (!m_aabb_tree_invalid && m_aabb_tree_refit_threshold > Scalar(0.0)
+                    && m_aabb_tree.getNumParticles() == n_aabb)
+                    {
+                    m_aabb_tree.refit(m_aabbs, n_aabb);
+                    Scalar cost = m_aabb_tree.getSAHCost();
+                    rebuild = cost > m_aabb_tree_refit_threshold * m_aabb_tree_build_cost;
+                    m_exec_conf->msg->notice(8) << "Refit AABB tree, SAH cost " << cost << " (built "
+                                                << m_aabb_tree_build_cost << ")" << std::endl;
+                    }
+
+                if (rebuild)
+                    {
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    if (m_aabb_tree_refit_threshold > Scalar(0.0))
+                        m_aabb_tree_build_cost = m_aabb_tree.getSAHCost();
+                    }
                 }
             }
 
@@ -1090,6 +1393,7 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
         }
 
     m_aabb_tree_invalid = false;
+    m_aabb_tree_moved = false;
     return m_aabb_tree;
     }
 
@@ -1128,6 +1432,412 @@ void IntegratorHPMCMono<Shape>::limitMoveDistances()
         }
     }
 
+/*! \param box Local simulation box
+    \param pos Position to locate
+    \returns Index of the checkerboard cell that contains \a pos
+
+    Positions outside of the box are wrapped back along periodic directions and clamped to the outermost cell along
+    non-periodic ones.
+*/
+template <class Shape>
+unsigned int IntegratorHPMCMono<Shape>::getCheckerboardCell(const BoxDim& box, const vec3<Scalar>& pos)
+    {
+    Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + m_checkerboard_shift;
+    uchar3 periodic = box.getPeriodic();
+
+    int3 c = make_int3(int(floor(f.x * Scalar(m_checkerboard_dim.x))),
+                       int(floor(f.y * Scalar(m_checkerboard_dim.y))),
+                       int(floor(f.z * Scalar(m_checkerboard_dim.z))));
+    int3 dim = make_int3(m_checkerboard_dim.x, m_checkerboard_dim.y, m_checkerboard_dim.z);
+
+    if (periodic.x)
+        c.x = ((c.x % dim.x) + dim.x) % dim.x;
+    else
+        c.x = std::max(0, std::min(c.x, dim.x-1));
+    if (periodic.y)
+        c.y = ((c.y % dim.y) + dim.y) % dim.y;
+    else
+        c.y = std::max(0, std::min(c.y, dim.y-1));
+    if (periodic.z)
+        c.z = ((c.z % dim.z) + dim.z) % dim.z;
+    else
+        c.z = std::max(0, std::min(c.z, dim.z-1));
+
+    return Index3D(dim.x, dim.y, dim.z)(c.x, c.y, c.z);
+    }
+
+/*! \param timestep Current time step
+    \returns false if the local box is too small to hold a checkerboard of cells
+
+    Sets up a randomly shifted grid of cells over the local box, sorts the local particles into the cells (keeping the
+    shuffled update order within each cell) and groups the non-empty cells into sets of non-adjacent cells.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::initializeCheckerboard(unsigned int timestep)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = m_sysdef->getNDimensions();
+    uchar3 periodic = box.getPeriodic();
+    Scalar3 npd = box.getNearestPlaneDistance();
+    unsigned int N = m_pdata->getN();
+
+    if (m_nominal_width <= Scalar(0.0))
+        return false;
+
+    // cells must be at least as wide as the largest particle, there is no need for more cells than particles
+    Scalar width = m_nominal_width;
+    Scalar volume = npd.x * npd.y * ((ndim == 3) ? npd.z : Scalar(1.0));
+    if (N > 0)
+        width = std::max(width, Scalar(pow(volume / Scalar(N), Scalar(1.0) / Scalar(ndim))));
+
+    m_checkerboard_dim = make_uint3(1, 1, 1);
+    m_checkerboard_dim.x = (unsigned int)(npd.x / width);
+    m_checkerboard_dim.y = (unsigned int)(npd.y / width);
+    if (ndim == 3)
+        m_checkerboard_dim.z = (unsigned int)(npd.z / width);
+
+    // cells of the same set must not be adjacent across a periodic boundary
+    if (periodic.x)
+        m_checkerboard_dim.x &= ~1u;
+    if (periodic.y)
+        m_checkerboard_dim.y &= ~1u;
+    if (periodic.z && ndim == 3)
+        m_checkerboard_dim.z &= ~1u;
+
+    if (m_checkerboard_dim.x < 2 || m_checkerboard_dim.y < 2 || (ndim == 3 && m_checkerboard_dim.z < 2))
+        {
+        m_exec_conf->msg->notice(4) << "HPMCMono: box too small for checkerboard sweeps, using serial sweeps" << std::endl;
+        return false;
+        }
+
+    // randomly shift the cell grid every step
+    Saru rng(timestep, m_seed, 0x2a3c8b51);
+    m_checkerboard_shift = make_scalar3(0,0,0);
+    m_checkerboard_shift.x = rng.s(Scalar(0.0), Scalar(1.0)) / Scalar(m_checkerboard_dim.x);
+    m_checkerboard_shift.y = rng.s(Scalar(0.0), Scalar(1.0)) / Scalar(m_checkerboard_dim.y);
+    if (ndim == 3)
+        m_checkerboard_shift.z = rng.s(Scalar(0.0), Scalar(1.0)) / Scalar(m_checkerboard_dim.z);
+
+    unsigned int n_cells = m_checkerboard_dim.x * m_checkerboard_dim.y * m_checkerboard_dim.z;
+    Index3D cell_idx(m_checkerboard_dim.x, m_checkerboard_dim.y, m_checkerboard_dim.z);
+
+    // count the particles in each cell
+    m_checkerboard_cell.resize(N);
+    m_checkerboard_cell_start.assign(n_cells+1, 0);
+    m_checkerboard_cell_particles.resize(N);
+
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int cell = getCheckerboardCell(box, vec3<Scalar>(h_postype.data[i]));
+            m_checkerboard_cell[i] = cell;
+            m_checkerboard_cell_start[cell+1]++;
+            }
+        }
+
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_cell_start[cell+1] += m_checkerboard_cell_start[cell];
+
+    // fill the cells in the shuffled update order
+    std::vector<unsigned int> cell_fill(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end()-1);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        m_checkerboard_cell_particles[cell_fill[m_checkerboard_cell[i]]++] = i;
+        }
+
+    // group the non-empty cells into sets of non-adjacent cells
+    unsigned int n_sets = (ndim == 3) ? 8 : 4;
+    m_checkerboard_set_start.assign(n_sets+1, 0);
+    m_checkerboard_set_cells.clear();
+    for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+        {
+        m_checkerboard_set_start[cur_set] = m_checkerboard_set_cells.size();
+        for (unsigned int k = (cur_set >> 2) & 1; k < m_checkerboard_dim.z; k += 2)
+            for (unsigned int j = (cur_set >> 1) & 1; j < m_checkerboard_dim.y; j += 2)
+                for (unsigned int i = cur_set & 1; i < m_checkerboard_dim.x; i += 2)
+                    {
+                    unsigned int cell = cell_idx(i, j, k);
+                    if (m_checkerboard_cell_start[cell+1] > m_checkerboard_cell_start[cell])
+                        m_checkerboard_set_cells.push_back(cell);
+                    }
+        }
+    m_checkerboard_set_start[n_sets] = m_checkerboard_set_cells.size();
+    m_checkerboard_set_order.resize(n_sets);
+
+    return true;
+    }
+
+/*! \param timestep Current time step
+    \param counters Counters to add the statistics of all trial moves to
+
+    initializeCheckerboard() must have been called for this step. See the class documentation for a description of the
+    algorithm.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCheckerboard(unsigned int timestep, hpmc_counters_t& counters)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    unsigned int n_sets = m_checkerboard_set_start.size() - 1;
+
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = m_nominal_width / npd;
+    #endif
+
+    // external fields are evaluated serially
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    if (!m_external)
+        n_threads = omp_get_max_threads();
+    #endif
+
+    std::vector<hpmc_counters_t> thread_counters(n_threads);
+    m_checkerboard_moved.resize(n_threads);
+
+    // access interaction matrix
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        // access particle data
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+
+        // access parameters
+        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+
+        //access move sizes
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+        // loop over cell sets in a shuffled order
+        m_checkerboard_set_order.shuffle(timestep, i_nselect);
+        for (unsigned int cur_set_idx = 0; cur_set_idx < n_sets; cur_set_idx++)
+            {
+            unsigned int cur_set = m_checkerboard_set_order[cur_set_idx];
+
+            // all cells in a set are independent
+            #pragma omp parallel for schedule(dynamic) if (n_threads > 1)
+            for (int cur_cell = m_checkerboard_set_start[cur_set]; cur_cell < (int)m_checkerboard_set_start[cur_set+1];
+                 cur_cell++)
+                {
+                unsigned int thread_idx = 0;
+                #ifdef ENABLE_OPENMP
+                thread_idx = omp_get_thread_num();
+                #endif
+                hpmc_counters_t& thread_counter = thread_counters[thread_idx];
+
+                unsigned int cell = m_checkerboard_set_cells[cur_cell];
+                for (unsigned int cur_p = m_checkerboard_cell_start[cell]; cur_p < m_checkerboard_cell_start[cell+1];
+                     cur_p++)
+                    {
+                    unsigned int i = m_checkerboard_cell_particles[cur_p];
+
+                    // read in the current position and orientation
+                    Scalar4 postype_i = h_postype.data[i];
+                    Scalar4 orientation_i = h_orientation.data[i];
+                    vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                    #ifdef ENABLE_MPI
+                    if (m_comm)
+                        {
+                        // only move particle if active
+                        if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                            continue;
+                        }
+                    #endif
+
+                    // make a trial move for i, using the same random number stream as the serial sweep
+                    Saru rng_i(i, m_seed + m_exec_conf->getRank()*m_nselect + i_nselect, timestep);
+                    int typ_i = __scalar_as_int(postype_i.w);
+                    Shape shape_i(quat<Scalar>(orientation_i), h_params.data[typ_i]);
+                    unsigned int move_type_select = rng_i.u32() & 0xffff;
+                    bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_move_ratio);
+
+                    Shape shape_old(quat<Scalar>(orientation_i), h_params.data[typ_i]);
+                    vec3<Scalar> pos_old = pos_i;
+
+                    if (move_type_translate)
+                        {
+                        move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                        #ifdef ENABLE_MPI
+                        if (m_comm)
+                            {
+                            // check if particle has moved into the ghost layer, and skip if it is
+                            if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                                continue;
+                            }
+                        #endif
+
+                        // particles may not leave their cell, such moves count as rejected
+                        if (getCheckerboardCell(box, pos_i) != cell)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                thread_counter.translate_reject_count++;
+                            continue;
+                            }
+                        }
+                    else
+                        {
+                        move_rotate(shape_i.orientation, rng_i, h_a.data[typ_i], ndim);
+                        }
+
+                    bool reject_external = false;
+                    if(m_external && !m_external->accept(i, pos_old, shape_old, pos_i, shape_i, rng_i))
+                        {
+                        reject_external = true;
+                        }
+
+                    bool overlap = false;
+
+                    // check against the particles in the same cell, which are only moved by this thread
+                    for (unsigned int cur_q = m_checkerboard_cell_start[cell];
+                         cur_q < m_checkerboard_cell_start[cell+1] && !reject_external; cur_q++)
+                        {
+                        unsigned int j = m_checkerboard_cell_particles[cur_q];
+                        if (j == i)
+                            continue;
+
+                        Scalar4 postype_j = h_postype.data[j];
+                        Scalar4 orientation_j = h_orientation.data[j];
+
+                        // cells are at most half a box wide, so the minimum image is the only candidate
+                        vec3<Scalar> r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_i)));
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), h_params.data[typ_j]);
+
+                        thread_counter.overlap_checks++;
+                        if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, thread_counter.overlap_err_count))
+                            {
+                            overlap = true;
+                            break;
+                            }
+                        }
+
+                    // check against the particles in the neighboring cells, which do not move during this set
+                    detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+                    const unsigned int n_images = m_image_list.size();
+                    for (unsigned int cur_image = 0; cur_image < n_images && !overlap && !reject_external; cur_image++)
+                        {
+                        vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                        detail::AABB aabb = aabb_i_local;
+                        aabb.translate(pos_i_image);
+
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                            {
+                            if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                                {
+                                if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                    {
+                                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                        {
+                                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                        // skip particles in the same cell (checked above) and in the other cells of
+                                        // this set, which are too far away to overlap and may be moved concurrently
+                                        if (j < m_pdata->getN())
+                                            {
+                                            Index3D cell_idx(m_checkerboard_dim.x, m_checkerboard_dim.y, m_checkerboard_dim.z);
+                                            uint3 c = cell_idx.getTriple(m_checkerboard_cell[j]);
+                                            if ((c.x & 1) + 2*(c.y & 1) + 4*(c.z & 1) == cur_set)
+                                                continue;
+                                            }
+
+                                        Scalar4 postype_j = h_postype.data[j];
+                                        Scalar4 orientation_j = h_orientation.data[j];
+
+                                        // put particles in coordinate system of particle i
+                                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                        Shape shape_j(quat<Scalar>(orientation_j), h_params.data[typ_j]);
+
+                                        thread_counter.overlap_checks++;
+                                        if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                            && test_overlap(r_ij, shape_i, shape_j, thread_counter.overlap_err_count))
+                                            {
+                                            overlap = true;
+                                            break;
+                                            }
+                                        }
+                                    }
+                                }
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                                }
+
+                            if (overlap)
+                                break;
+                            }  // end loop over AABB nodes
+                        } // end loop over images
+
+                    // if the move is accepted
+                    if (!overlap && !reject_external)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            {
+                            if (move_type_translate)
+                                thread_counter.translate_accept_count++;
+                            else
+                                thread_counter.rotate_accept_count++;
+                            }
+
+                        // update position of particle
+                        h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+                        if (shape_i.hasOrientation())
+                            {
+                            h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                            }
+
+                        // the tree is updated after the set is complete
+                        m_checkerboard_moved[thread_idx].push_back(i);
+                        }
+                    else
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            {
+                            // increment reject counter
+                            if (move_type_translate)
+                                thread_counter.translate_reject_count++;
+                            else
+                                thread_counter.rotate_reject_count++;
+                            }
+                        }
+                    } // end loop over particles in the cell
+                } // end loop over cells in the set
+
+            // update the positions of the moved particles in the tree for the next set
+            for (unsigned int t = 0; t < n_threads; t++)
+                {
+                for (unsigned int k = 0; k < m_checkerboard_moved[t].size(); k++)
+                    {
+                    unsigned int i = m_checkerboard_moved[t][k];
+                    Shape shape_i(quat<Scalar>(h_orientation.data[i]), h_params.data[__scalar_as_int(h_postype.data[i].w)]);
+                    m_aabb_tree.update(i, shape_i.getAABB(vec3<Scalar>(h_postype.data[i])));
+                    }
+                m_checkerboard_moved[t].clear();
+                }
+            } // end loop over cell sets
+        } // end loop over nselect
+
+    // sum the per-thread counters
+    for (unsigned int t = 0; t < n_threads; t++)
+        counters = counters + thread_counters[t];
+    }
+
 /*! Function for finding all overlaps in a system by particle tag. returns an unraveled form of an NxN matrix
  * with true/false indicating the overlap status of the ith and jth particle
  */
@@ -1235,6 +1945,10 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("setOverlapChecks", &IntegratorHPMCMono<Shape>::setOverlapChecks)
           .def("setExternalField", &IntegratorHPMCMono<Shape>::setExternalField)
           .def("mapOverlaps", &IntegratorHPMCMono<Shape>::mapOverlaps)
+          .def("setAABBTreeRefitThreshold", &IntegratorHPMCMono<Shape>::setAABBTreeRefitThreshold)
+          .def("getAABBTreeCost", &IntegratorHPMCMono<Shape>::getAABBTreeCost)
+          .def("setCheckerboard", &IntegratorHPMCMono<Shape>::setCheckerboard)
+          .def("getCheckerboard", &IntegratorHPMCMono<Shape>::getCheckerboard)
           ;
     }
 
@@ -0,0 +1,443 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __HPMC_MONO_EVENT_CHAIN__H__
+#define __HPMC_MONO_EVENT_CHAIN__H__
+
+#include "IntegratorHPMCMono.h"
+
+#include <climits>
+
+/*! \file IntegratorHPMCMonoEventChain.h
+    \brief Defines the template class for event-chain Monte Carlo of hard shapes
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+namespace hpmc
+{
+
+//! Template class for event-chain Monte Carlo of hard shapes
+/*! Instead of trial displacements that are accepted or rejected, every chain picks a random positive axis e and
+    moves one particle along e until it collides with another one. The particle that was hit continues the chain in
+    the same direction, until the total displacement of the chain equals the chain length. Restarting every chain
+    with a random particle and a random positive axis satisfies global balance (E. P. Bernard, W. Krauth, and
+    D. B. Wilson, Phys. Rev. E 80, 056704, 2009).
+
+    The collision distance between two shapes is given by sweep_distance(), which is defined next to test_overlap()
+    in the shape headers. Shapes that do not implement it fall back to the generic version and never move.
+
+    Each event moves the active particle by at most d of its type, so that the AABB tree search for collision
+    partners only needs the swept AABB over one segment and the image list stays valid. Chains start nselect times
+    from each particle per step. Event chains are rejection free, so every event counts as an accepted translation.
+    The numbers of chains, events and collisions are tracked separately in hpmc_event_chain_counters_t.
+
+    Anisotropic shapes sample their orientations with the rotation moves of IntegratorHPMCMono, which are performed
+    before the chains whenever move_ratio is less than 1.
+
+    MPI domain decomposition and external fields are not supported.
+
+    \ingroup hpmc_integrators
+*/
+template< class Shape >
+class IntegratorHPMCMonoEventChain : public IntegratorHPMCMono<Shape>
+    {
+    public:
+        //! Param type from the shape
+        typedef typename Shape::param_type param_type;
+
+        //! Construct the integrator
+        IntegratorHPMCMonoEventChain(std::shared_ptr<SystemDefinition> sysdef,
+                                     unsigned int seed);
+        //! Destructor
+        virtual ~IntegratorHPMCMonoEventChain();
+
+        //! Set the total displacement of one chain
+        void setChainLength(Scalar chain_length)
+            {
+            if (chain_length <= Scalar(0.0))
+                {
+                this->m_exec_conf->msg->error() << "integrate.mode_hpmc: chain_length must be positive" << std::endl;
+                throw std::runtime_error("Error setting event chain parameters");
+                }
+            m_chain_length = chain_length;
+            }
+
+        //! Get the total displacement of one chain
+        Scalar getChainLength()
+            {
+            return m_chain_length;
+            }
+
+        //! Prepare for the run
+        virtual void prepRun(unsigned int timestep);
+
+        //! Take one timestep forward
+        virtual void update(unsigned int timestep);
+
+        //! Reset statistics counters
+        virtual void resetStats()
+            {
+            IntegratorHPMCMono<Shape>::resetStats();
+            m_chain_count_run_start = m_chain_count;
+            }
+
+        //! Print statistics about the hpmc steps taken
+        virtual void printStats()
+            {
+            IntegratorHPMCMono<Shape>::printStats();
+
+            hpmc_event_chain_counters_t result = getEventChainCounters(1);
+
+            double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
+
+            this->m_exec_conf->msg->notice(2) << "-- Event chain stats:" << "\n";
+            this->m_exec_conf->msg->notice(2) << "Events per second:                        "
+                << double(result.event_count)/cur_time << "\n";
+            this->m_exec_conf->msg->notice(2) << "Average number of collisions per chain:   "
+                << result.getCollisionsPerChain() << "\n";
+            this->m_exec_conf->msg->notice(2) << "Fraction of events ending in a collision: "
+                << result.getCollisionFraction() << "\n";
+            }
+
+        //! Get the current counter values
+        hpmc_event_chain_counters_t getEventChainCounters(unsigned int mode=0);
+
+        /* \returns a list of provided quantities
+        */
+        std::vector< std::string > getProvidedLogQuantities()
+            {
+            // start with the integrator provided quantities
+            std::vector< std::string > result = IntegratorHPMCMono<Shape>::getProvidedLogQuantities();
+
+            // then add ours
+            result.push_back("hpmc_chain_collisions");
+            result.push_back("hpmc_chain_collision_fraction");
+
+            return result;
+            }
+
+        //! Get the value of a logged quantity
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+    protected:
+        Scalar m_chain_length;              //!< Total displacement of one chain
+        bool m_chain_warning_issued;        //!< True if the warning about chains without progress has been issued
+
+        hpmc_event_chain_counters_t m_chain_count;              //!< Counter of chains, events and collisions
+        hpmc_event_chain_counters_t m_chain_count_run_start;    //!< Counter of chains at run start
+        hpmc_event_chain_counters_t m_chain_count_step_start;   //!< Counter of chains at the start of the last step
+    };
+
+/*! \param sysdef System definition
+    \param seed Random number generator seed
+*/
+template< class Shape >
+IntegratorHPMCMonoEventChain< Shape >::IntegratorHPMCMonoEventChain(std::shared_ptr<SystemDefinition> sysdef,
+                                                                     unsigned int seed)
+    : IntegratorHPMCMono<Shape>(sysdef, seed), m_chain_length(1.0), m_chain_warning_issued(false)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMCMonoEventChain" << std::endl;
+    }
+
+//! Destructor
+template< class Shape >
+IntegratorHPMCMonoEventChain< Shape >::~IntegratorHPMCMonoEventChain()
+    {
+    this->m_exec_conf->msg->notice(5) << "Destroying IntegratorHPMCMonoEventChain" << std::endl;
+    }
+
+template< class Shape >
+void IntegratorHPMCMonoEventChain< Shape >::prepRun(unsigned int timestep)
+    {
+    #ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        this->m_exec_conf->msg->error() << "integrate.mode_hpmc: event chains do not support MPI domain decomposition"
+            << std::endl;
+        throw std::runtime_error("Error initializing event chain integrator");
+        }
+    #endif
+
+    if (this->m_external)
+        {
+        this->m_exec_conf->msg->error() << "integrate.mode_hpmc: event chains do not support external fields"
+            << std::endl;
+        throw std::runtime_error("Error initializing event chain integrator");
+        }
+
+    IntegratorHPMCMono<Shape>::prepRun(timestep);
+    }
+
+template< class Shape >
+void IntegratorHPMCMonoEventChain< Shape >::update(unsigned int timestep)
+    {
+    this->m_exec_conf->msg->notice(10) << "HPMCMonoEventChain update: " << timestep << std::endl;
+
+    if (this->m_hasOrientation && this->m_move_ratio < 65536)
+        {
+        // sample the orientations with rotation moves of the base class
+        unsigned int move_ratio = this->m_move_ratio;
+        this->m_move_ratio = 0;
+        IntegratorHPMCMono<Shape>::update(timestep);
+        this->m_move_ratio = move_ratio;
+        }
+    else
+        {
+        IntegratorHPMC::update(timestep);
+        }
+
+    // update the AABB Tree
+    this->buildAABBTree();
+    // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
+    this->limitMoveDistances();
+    // update the image list
+    this->updateImageList();
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC event chain");
+
+    m_chain_count_step_start = m_chain_count;
+
+        {
+        ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total, access_location::host, access_mode::readwrite);
+        hpmc_counters_t& counters = h_counters.data[0];
+        const BoxDim& box = this->m_pdata->getBox();
+        unsigned int ndim = this->m_sysdef->getNDimensions();
+
+        // access particle data
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+        // access parameters, move sizes and the interaction matrix
+        ArrayHandle<param_type> h_params(this->m_params, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(this->m_overlaps, access_location::host, access_mode::read);
+
+        const unsigned int N = this->m_pdata->getN();
+        const unsigned int n_images = this->m_image_list.size();
+        this->m_update_order.resize(N);
+
+        Saru rng(timestep, this->m_seed + this->m_exec_conf->getRank(), 0x8b4e5c2d);
+        bool chain_stuck = false;
+
+        for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+            {
+            this->m_update_order.shuffle(timestep, i_nselect);
+
+            // start one chain from every particle
+            for (unsigned int cur_chain = 0; cur_chain < N; cur_chain++)
+                {
+                unsigned int active = this->m_update_order[cur_chain];
+                unsigned int previous = UINT_MAX;
+
+                // chains move along a random positive axis
+                unsigned int axis = rng.u32() % ndim;
+                vec3<Scalar> e(Scalar(axis == 0), Scalar(axis == 1), Scalar(axis == 2));
+
+                Scalar remaining = m_chain_length;
+                unsigned int n_stuck = 0;
+                m_chain_count.chain_count++;
+
+                while (remaining > Scalar(0.0))
+                    {
+                    Scalar4 postype_i = h_postype.data[active];
+                    vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+                    unsigned int typ_i = __scalar_as_int(postype_i.w);
+                    Shape shape_i(quat<Scalar>(h_orientation.data[active]), h_params.data[typ_i]);
+
+                    Scalar step = std::min(remaining, h_d.data[typ_i]);
+                    if (step <= Scalar(0.0))
+                        break;
+
+                    // search for collision partners within the volume swept by the segment
+                    detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+                    detail::AABB aabb_sweep_local = aabb_i_local;
+                    aabb_sweep_local.translate(step*e);
+                    aabb_sweep_local = detail::merge(aabb_i_local, aabb_sweep_local);
+
+                    Scalar t_min = step;
+                    unsigned int next = UINT_MAX;
+
+                    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                        {
+                        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+                        detail::AABB aabb = aabb_sweep_local;
+                        aabb.translate(pos_i_image);
+
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes(); cur_node_idx++)
+                            {
+                            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                                {
+                                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                    {
+                                    for (unsigned int cur_p = 0; cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                        {
+                                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                        // images of the active particle move along with it, and the particle that
+                                        // was just hit lies behind the active one
+                                        if (j == active || j == previous)
+                                            continue;
+
+                                        Scalar4 postype_j = h_postype.data[j];
+                                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                                        counters.overlap_checks++;
+                                        if (!h_overlaps.data[this->m_overlap_idx(typ_i, typ_j)])
+                                            continue;
+
+                                        // put particles in coordinate system of particle i
+                                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                                        Shape shape_j(quat<Scalar>(h_orientation.data[j]), h_params.data[typ_j]);
+
+                                        OverlapReal t = sweep_distance(r_ij, e, shape_i, shape_j, counters.overlap_err_count);
+                                        if (t >= OverlapReal(0.0) && Scalar(t) < t_min)
+                                            {
+                                            t_min = t;
+                                            next = j;
+                                            }
+                                        }
+                                    }
+                                }
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                                }
+                            } // end loop over AABB nodes
+                        } // end loop over images
+
+                    // stop a small distance short of the collision so that round off cannot create an overlap
+                    Scalar move = t_min;
+                    if (next != UINT_MAX)
+                        move = std::max(Scalar(0.0), t_min - Scalar(1e-5)*shape_i.getCircumsphereDiameter());
+
+                    if (move > Scalar(0.0))
+                        {
+                        pos_i += move*e;
+                        postype_i = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                        box.wrap(postype_i, h_image.data[active]);
+                        h_postype.data[active] = postype_i;
+
+                        // update the position of the particle in the tree for future events
+                        detail::AABB aabb = aabb_i_local;
+                        aabb.translate(vec3<Scalar>(postype_i));
+                        this->m_aabb_tree.update(active, aabb);
+
+                        n_stuck = 0;
+                        }
+                    else if (++n_stuck > N)
+                        {
+                        // the chain is passed around a jammed cluster without any displacement
+                        chain_stuck = true;
+                        break;
+                        }
+
+                    remaining -= t_min;
+
+                    m_chain_count.event_count++;
+                    if (!shape_i.ignoreStatistics())
+                        counters.translate_accept_count++;
+
+                    if (next != UINT_MAX)
+                        {
+                        m_chain_count.collision_count++;
+
+                        // lift the chain to the particle that was hit
+                        previous = active;
+                        active = next;
+                        }
+                    } // end loop over events
+                } // end loop over chains
+            } // end loop over nselect
+
+        if (chain_stuck && !m_chain_warning_issued)
+            {
+            this->m_exec_conf->msg->warning() << "integrate.mode_hpmc: Event chains stopped without making progress,"
+                << " the system may be jammed" << std::endl;
+            m_chain_warning_issued = true;
+            }
+        }
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
+    this->communicate(true);
+
+    // all particle have been moved, the aabb tree needs to be refit
+    this->m_aabb_tree_moved = true;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+    \return the requested log quantity.
+*/
+template< class Shape >
+Scalar IntegratorHPMCMonoEventChain< Shape >::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    hpmc_event_chain_counters_t chain_counters = getEventChainCounters(2);
+
+    if (quantity == "hpmc_chain_collisions")
+        {
+        // return the average number of collisions per chain
+        return (Scalar) chain_counters.getCollisionsPerChain();
+        }
+    if (quantity == "hpmc_chain_collision_fraction")
+        {
+        // return the fraction of events that ended in a collision
+        return (Scalar) chain_counters.getCollisionFraction();
+        }
+
+    //nothing found -> pass on to base class
+    return IntegratorHPMCMono<Shape>::getLogValue(quantity, timestep);
+    }
+
+/*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the last executed step
+    \return The current state of the event chain counters
+*/
+template< class Shape >
+hpmc_event_chain_counters_t IntegratorHPMCMonoEventChain< Shape >::getEventChainCounters(unsigned int mode)
+    {
+    if (mode == 0)
+        return m_chain_count;
+    else if (mode == 1)
+        return m_chain_count - m_chain_count_run_start;
+    else
+        return m_chain_count - m_chain_count_step_start;
+    }
+
+//! Export the IntegratorHPMCMonoEventChain class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of IntegratorHPMCMonoEventChain<Shape> will be exported
+*/
+template < class Shape > void export_IntegratorHPMCMonoEventChain(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<IntegratorHPMCMonoEventChain<Shape>, std::shared_ptr< IntegratorHPMCMonoEventChain<Shape> > >(m, name.c_str(),  pybind11::base< IntegratorHPMCMono<Shape> >())
+        .def(pybind11::init< std::shared_ptr<SystemDefinition>, unsigned int >())
+        .def("setChainLength", &IntegratorHPMCMonoEventChain<Shape>::setChainLength)
+        .def("getChainLength", &IntegratorHPMCMonoEventChain<Shape>::getChainLength)
+        .def("getEventChainCounters", &IntegratorHPMCMonoEventChain<Shape>::getEventChainCounters)
+        ;
+    }
+
+//! Export the counters for event chains
+inline void export_hpmc_event_chain_counters(pybind11::module& m)
+    {
+    pybind11::class_< hpmc_event_chain_counters_t >(m, "hpmc_event_chain_counters_t")
+    .def_readwrite("chain_count", &hpmc_event_chain_counters_t::chain_count)
+    .def_readwrite("event_count", &hpmc_event_chain_counters_t::event_count)
+    .def_readwrite("collision_count", &hpmc_event_chain_counters_t::collision_count)
+    .def("getCollisionsPerChain", &hpmc_event_chain_counters_t::getCollisionsPerChain)
+    .def("getCollisionFraction", &hpmc_event_chain_counters_t::getCollisionFraction)
+    ;
+    }
+
+} // end namespace hpmc
+
+#endif // __HPMC_MONO_EVENT_CHAIN__H__
@@ -896,8 +896,9 @@ void IntegratorHPMCMonoImplicit< Shape >::update(unsigned int timestep)
     // migrate and exchange particles
     this->communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
-    this->m_aabb_tree_invalid = true;
+    // all particle have been moved, the aabb tree needs to be refit (communicate() invalidates it if the particle
+    // order changed)
+    this->m_aabb_tree_moved = true;
     }
 
 /* \param rng The random number generator
@@ -6,6 +6,7 @@
 #include "hoomd/VectorMath.h"
 #include "ShapeSphere.h"    //< For the base template of test_overlap
 #include "XenoCollide3D.h"
+#include "GJKRayCast3D.h"
 
 #ifndef __SHAPE_CONVEX_POLYHEDRON_H__
 #define __SHAPE_CONVEX_POLYHEDRON_H__
@@ -391,6 +392,47 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Convex polyhedron collision distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param dir Unit vector along which shape a moves
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur
+    \returns The distance that *a* can move along *dir* before it touches *b*, or a negative value if *a* never
+              touches *b* when moving along *dir*
+
+    Pairs whose circumspheres never touch along the path are rejected early, the others are resolved with a GJK ray
+    cast on the Minkowski difference.
+
+    \ingroup shape
+*/
+template<unsigned int max_verts>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const vec3<Scalar>& dir,
+                                         const ShapeConvexPolyhedron<max_verts>& a,
+                                         const ShapeConvexPolyhedron<max_verts>& b,
+                                         unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    vec3<OverlapReal> e(dir);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    // the circumspheres never touch
+    OverlapReal b_dot = dot(dr,e);
+    OverlapReal disc = b_dot*b_dot - dot(dr,dr) + DaDb*DaDb/OverlapReal(4.0);
+    if (disc < OverlapReal(0.0) || b_dot + fast::sqrt(disc) < OverlapReal(0.0))
+        return OverlapReal(-1.0);
+
+    quat<OverlapReal> q_a_inv = conj(quat<OverlapReal>(a.orientation));
+    return detail::gjk_raycast_3d(detail::SupportFuncConvexPolyhedron<max_verts>(a.verts),
+                                  detail::SupportFuncConvexPolyhedron<max_verts>(b.verts),
+                                  rotate(q_a_inv, dr),
+                                  q_a_inv * quat<OverlapReal>(b.orientation),
+                                  rotate(q_a_inv, e),
+                                  DaDb/2.0,
+                                  err);
+    }
+
 }; // end namespace hpmc
 
 #endif //__SHAPE_CONVEX_POLYHEDRON_H__
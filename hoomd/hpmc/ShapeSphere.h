@@ -217,6 +217,66 @@ DEVICE inline bool test_overlap<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_
         }
     }
 
+//! Define the general collision distance function
+/*! This is just a convenient spot to put this to make sure it is defined early
+    \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param dir Unit vector along which shape a moves
+    \param a first shape
+    \param b second shape
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \returns The distance that *a* can move along *dir* before it touches *b*, or a negative value if *a* never
+              touches *b* when moving along *dir*
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab, const vec3<Scalar>& dir, const ShapeA &a,
+    const ShapeB& b, unsigned int& err)
+    {
+    // default implementation returns 0, particles of shapes without a collision query never move
+    return OverlapReal(0.0);
+    }
+
+//! Sphere-Sphere collision distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param dir Unit vector along which shape a moves
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur
+    \returns The distance that *a* can move along *dir* before it touches *b*, or a negative value if *a* never
+              touches *b* when moving along *dir*
+
+    The distance is the smaller root of |r_ab - s dir| = R_a + R_b.
+
+    \ingroup shape
+*/
+template <>
+DEVICE inline OverlapReal sweep_distance<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_ab, const vec3<Scalar>& dir,
+    const ShapeSphere& a, const ShapeSphere& b, unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    vec3<OverlapReal> e(dir);
+
+    OverlapReal sigma = a.params.radius + b.params.radius;
+    OverlapReal b_dot = dot(dr,e);
+
+    // b is behind a
+    if (b_dot <= OverlapReal(0.0))
+        return OverlapReal(-1.0);
+
+    OverlapReal disc = b_dot*b_dot - dot(dr,dr) + sigma*sigma;
+
+    // a passes by b
+    if (disc < OverlapReal(0.0))
+        return OverlapReal(-1.0);
+
+    OverlapReal s = b_dot - fast::sqrt(disc);
+
+    // a and b are already in contact
+    if (s < OverlapReal(0.0))
+        return OverlapReal(0.0);
+
+    return s;
+    }
+
 }; // end namespace hpmc
 
 #endif //__SHAPE_SPHERE_H__
@@ -3,6 +3,10 @@
 
 #include "UpdaterBoxMC.h"
 
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
 namespace py = pybind11;
 
 /*! \file UpdaterBoxMC.cc
@@ -261,12 +265,38 @@ inline bool UpdaterBoxMC::remove_overshear()
                 }
             } // end lexical scope
 
-        // To get particles into the right domain in MPI, we will store and then reload a snapshot
-        SnapshotParticleData<Scalar> snap;
-        m_pdata->takeSnapshot(snap);
-
-        // loading from snapshot will load particles into the proper MPI domain
-        m_pdata->initializeFromSnapshot(snap);
+        #ifdef ENABLE_MPI
+        if (m_comm)
+            {
+            // Wrapping into the new box can move a particle by several domains, but the communicator migrates
+            // particles only to neighboring domains. Migrate in place until every particle is in its domain.
+            const Index3D& di = m_pdata->getDomainDecomposition()->getDomainIndexer();
+            while (true)
+                {
+                unsigned int n_outside = 0;
+                    {
+                    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+                    const BoxDim& local_box = m_pdata->getBox();
+                    unsigned int N = m_pdata->getN();
+
+                    for (unsigned int i = 0; i < N; i++)
+                        {
+                        Scalar3 f = local_box.makeFraction(make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z));
+                        if ((di.getW() > 1 && (f.x < Scalar(0.0) || f.x >= Scalar(1.0)))
+                            || (di.getH() > 1 && (f.y < Scalar(0.0) || f.y >= Scalar(1.0)))
+                            || (di.getD() > 1 && (f.z < Scalar(0.0) || f.z >= Scalar(1.0))))
+                            n_outside++;
+                        }
+                    }
+
+                MPI_Allreduce(MPI_IN_PLACE, &n_outside, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+                if (n_outside == 0)
+                    break;
+
+                m_comm->migrateParticles();
+                }
+            }
+        #endif
 
         // we've moved the particles, communicate those changes
         m_mc->communicate(true);
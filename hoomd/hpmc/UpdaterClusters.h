@@ -0,0 +1,463 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __UPDATER_CLUSTERS_H__
+#define __UPDATER_CLUSTERS_H__
+
+/*! \file UpdaterClusters.h
+    \brief Declaration of UpdaterClusters
+*/
+
+#include "hoomd/Updater.h"
+#include "hoomd/VectorMath.h"
+#include "hoomd/extern/saruprng.h"
+
+#include "HPMCCounters.h"
+#include "Moves.h"
+#include "IntegratorHPMCMono.h"
+
+#ifndef NVCC
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+#endif
+
+namespace hpmc
+{
+
+/*! Geometric cluster moves (Liu and Luijten, Phys. Rev. Lett. 92, 035504 (2004))
+
+    Each call to update() performs one cluster move. It chooses a random transformation T that is its own inverse and
+    maps the periodic box onto itself, and a random seed particle. The seed particle is transformed. Every particle
+    that overlaps with a transformed particle in its old configuration is added to the cluster and transformed as
+    well, until no more particles are added. Because T is an isometry and its own inverse, the move is accepted
+    without a further test and the new configuration is free of overlaps. Overlap checks use the AABB tree and the
+    interaction matrix of the integrator, so pairs of types that do not overlap (e.g. explicit depletants) never
+    link particles into a cluster.
+
+    Two transformations are used:
+     - pivot moves reflect the positions through a random point and leave the orientations unchanged. These are
+       valid only for shapes that are symmetric under inversion.
+     - rotation moves rotate the particles by pi around a line through a random point. The line is parallel to the z
+       axis (the only choice in 2D) or, in an orthorhombic box, to the x, y or z axis. In a 3D box with non-zero
+       tilt factors xz or yz, no such line maps the box onto itself and rotation moves are skipped.
+
+    In 3D, a fraction move_ratio of the moves are pivot moves. It is 0 by default, since not every shape is symmetric
+    under inversion, and update.clusters sets it to 0.5 for spheres and ellipsoids. The transformations are computed in fractional
+    coordinates, where both flip the sign of some of the coordinates relative to the random point.
+
+    MPI domain decomposition, implicit depletants and external fields are not supported.
+*/
+template<class Shape>
+class UpdaterClusters : public Updater
+    {
+    public:
+        //! Constructor
+        UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef,
+                        std::shared_ptr<IntegratorHPMCMono<Shape> > mc,
+                        unsigned int seed);
+        virtual ~UpdaterClusters();
+
+        //! Take one timestep forward
+        /*! \param timestep timestep at which update is being evaluated
+        */
+        virtual void update(unsigned int timestep);
+
+        //! Set the fraction of pivot moves (3D only)
+        void setMoveRatio(Scalar move_ratio)
+            {
+            if (move_ratio < Scalar(0.0) || move_ratio > Scalar(1.0))
+                {
+                m_exec_conf->msg->error() << "update.clusters: move_ratio has to be between 0 and 1" << std::endl;
+                throw std::runtime_error("Error setting cluster move parameters");
+                }
+            m_move_ratio = move_ratio;
+            }
+
+        //! Get the fraction of pivot moves
+        Scalar getMoveRatio()
+            {
+            return m_move_ratio;
+            }
+
+        //! Print statistics about the cluster moves
+        virtual void printStats()
+            {
+            hpmc_clusters_counters_t counters = getCounters(1);
+            m_exec_conf->msg->notice(2) << "-- HPMC cluster move stats:" << std::endl;
+            m_exec_conf->msg->notice(2) << "Pivot moves:            " << counters.pivot_count << std::endl;
+            m_exec_conf->msg->notice(2) << "Rotation moves:         " << counters.rotation_count << std::endl;
+            m_exec_conf->msg->notice(2) << "Average cluster size:   " << counters.getAverageClusterSize() << std::endl;
+            }
+
+        //! Reset statistics counters
+        virtual void resetStats()
+            {
+            m_count_run_start = m_count_total;
+            }
+
+        //! Get a list of logged quantities
+        virtual std::vector< std::string > getProvidedLogQuantities()
+            {
+            std::vector< std::string > result;
+            result.push_back("hpmc_clusters_avg_size");
+            result.push_back("hpmc_clusters_pivot_moves");
+            result.push_back("hpmc_clusters_rotation_moves");
+            return result;
+            }
+
+        //! Get the value of a logged quantity
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+        //! Get the current counter values
+        hpmc_clusters_counters_t getCounters(unsigned int mode=0);
+
+    protected:
+        std::shared_ptr< IntegratorHPMCMono<Shape> > m_mc; //!< HPMC integrator
+        unsigned int m_seed;                                //!< RNG seed
+        Scalar m_move_ratio;                                //!< Fraction of pivot moves in 3D
+
+        std::vector<unsigned char> m_in_cluster;            //!< Flag for every particle that was added to the cluster
+        std::vector<unsigned int> m_cluster;                //!< Particles in the cluster
+        std::vector<Scalar4> m_postype_new;                 //!< New position and type of the cluster particles
+        std::vector<Scalar4> m_orientation_new;             //!< New orientation of the cluster particles
+        std::vector<int3> m_image_new;                      //!< New image flags of the cluster particles
+
+        hpmc_clusters_counters_t m_count_total;             //!< Total count
+        hpmc_clusters_counters_t m_count_run_start;         //!< Count saved at run() start
+        hpmc_clusters_counters_t m_count_step_start;        //!< Count saved at the start of the last step
+    };
+
+/*! \param sysdef System definition
+    \param mc HPMC integrator
+    \param seed PRNG seed
+*/
+template<class Shape>
+UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef,
+                                        std::shared_ptr<IntegratorHPMCMono<Shape> > mc,
+                                        unsigned int seed)
+        : Updater(sysdef), m_mc(mc), m_seed(seed), m_move_ratio(0.0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
+    }
+
+template<class Shape>
+UpdaterClusters<Shape>::~UpdaterClusters()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying UpdaterClusters" << std::endl;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+    \return the requested log quantity.
+*/
+template<class Shape>
+Scalar UpdaterClusters<Shape>::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    hpmc_clusters_counters_t counters = getCounters(1);
+
+    if (quantity == "hpmc_clusters_avg_size")
+        {
+        return counters.getAverageClusterSize();
+        }
+    else if (quantity == "hpmc_clusters_pivot_moves")
+        {
+        return Scalar(counters.pivot_count);
+        }
+    else if (quantity == "hpmc_clusters_rotation_moves")
+        {
+        return Scalar(counters.rotation_count);
+        }
+    else
+        {
+        m_exec_conf->msg->error() << "update.clusters: " << quantity << " is not a valid log quantity" << std::endl;
+        throw std::runtime_error("Error getting log value");
+        }
+    }
+
+/*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the last executed step
+    \return The current state of the cluster move counters
+*/
+template<class Shape>
+hpmc_clusters_counters_t UpdaterClusters<Shape>::getCounters(unsigned int mode)
+    {
+    hpmc_clusters_counters_t result;
+
+    if (mode == 0)
+        result = m_count_total;
+    else if (mode == 1)
+        result = m_count_total - m_count_run_start;
+    else
+        result = m_count_total - m_count_step_start;
+
+    return result;
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+template<class Shape>
+void UpdaterClusters<Shape>::update(unsigned int timestep)
+    {
+    m_exec_conf->msg->notice(10) << "UpdaterClusters update: " << timestep << std::endl;
+
+    #ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        m_exec_conf->msg->error() << "update.clusters: MPI domain decomposition is not supported" << std::endl;
+        throw std::runtime_error("Error performing cluster moves");
+        }
+    #endif
+
+    if (m_mc->getExternalField())
+        {
+        m_exec_conf->msg->error() << "update.clusters: external fields are not supported" << std::endl;
+        throw std::runtime_error("Error performing cluster moves");
+        }
+
+    m_count_step_start = m_count_total;
+
+    const unsigned int N = m_pdata->getN();
+    if (N == 0)
+        return;
+
+    if (m_prof) m_prof->push(m_exec_conf, "HPMC clusters");
+
+    Saru rng(timestep, m_seed, 0x8a1f05d3);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const unsigned int ndim = m_sysdef->getNDimensions();
+
+    // choose the transformation, flip[k] is true if it negates fractional coordinate k relative to the pivot
+    bool pivot = false;
+    bool flip[3] = {true, true, false};
+    vec3<Scalar> axis(0,0,1);
+    if (ndim == 3)
+        {
+        bool orthorhombic = box.getTiltFactorXY() == Scalar(0.0) && box.getTiltFactorXZ() == Scalar(0.0)
+            && box.getTiltFactorYZ() == Scalar(0.0);
+        bool z_allowed = box.getTiltFactorXZ() == Scalar(0.0) && box.getTiltFactorYZ() == Scalar(0.0);
+
+        if (rng.template s<Scalar>() < m_move_ratio)
+            {
+            pivot = true;
+            flip[2] = true;
+            }
+        else if (orthorhombic)
+            {
+            // rotate around a line parallel to x, y or z
+            unsigned int k = rand_select(rng, 2);
+            flip[0] = flip[1] = flip[2] = true;
+            flip[k] = false;
+            axis = vec3<Scalar>(k == 0, k == 1, k == 2);
+            }
+        else if (!z_allowed)
+            {
+            // no rotation maps this box onto itself
+            if (m_prof) m_prof->pop(m_exec_conf);
+            return;
+            }
+        }
+
+    quat<Scalar> q_rot = quat<Scalar>::fromAxisAngle(axis, Scalar(M_PI));
+
+    Scalar3 f_pivot = make_scalar3(rng.template s<Scalar>(), rng.template s<Scalar>(), rng.template s<Scalar>());
+    if (ndim == 2)
+        f_pivot.z = Scalar(0.5);
+
+    unsigned int seed_idx = rand_select(rng, N-1);
+
+    // the tree holds the old configuration, which is not modified until the cluster is complete
+    const detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
+    const std::vector<vec3<Scalar> >& image_list = m_mc->updateImageList();
+    const unsigned int n_images = image_list.size();
+
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+
+        ArrayHandle<typename Shape::param_type> h_params(m_mc->getParams(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
+        const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+
+        m_in_cluster.assign(N, 0);
+        m_cluster.clear();
+        m_postype_new.clear();
+        m_orientation_new.clear();
+        m_image_new.clear();
+
+        m_cluster.push_back(seed_idx);
+        m_in_cluster[seed_idx] = 1;
+
+        unsigned int err_count = 0;
+
+        // grow the cluster breadth first, m_cluster doubles as the queue
+        for (unsigned int cur = 0; cur < m_cluster.size(); cur++)
+            {
+            unsigned int i = m_cluster[cur];
+            Scalar4 postype_i = h_postype.data[i];
+            unsigned int typ_i = __scalar_as_int(postype_i.w);
+
+            // transform particle i and wrap it back into the box
+            Scalar3 f = box.makeFraction(make_scalar3(postype_i.x, postype_i.y, postype_i.z));
+            int3 image = h_image.data[i];
+            if (flip[0])
+                {
+                f.x = Scalar(2.0)*f_pivot.x - f.x;
+                image.x = -image.x;
+                if (f.x >= Scalar(1.0))
+                    {
+                    f.x -= Scalar(1.0);
+                    image.x++;
+                    }
+                else if (f.x < Scalar(0.0))
+                    {
+                    f.x += Scalar(1.0);
+                    image.x--;
+                    }
+                }
+            if (flip[1])
+                {
+                f.y = Scalar(2.0)*f_pivot.y - f.y;
+                image.y = -image.y;
+                if (f.y >= Scalar(1.0))
+                    {
+                    f.y -= Scalar(1.0);
+                    image.y++;
+                    }
+                else if (f.y < Scalar(0.0))
+                    {
+                    f.y += Scalar(1.0);
+                    image.y--;
+                    }
+                }
+            if (flip[2])
+                {
+                f.z = Scalar(2.0)*f_pivot.z - f.z;
+                image.z = -image.z;
+                if (f.z >= Scalar(1.0))
+                    {
+                    f.z -= Scalar(1.0);
+                    image.z++;
+                    }
+                else if (f.z < Scalar(0.0))
+                    {
+                    f.z += Scalar(1.0);
+                    image.z--;
+                    }
+                }
+            Scalar3 pos = box.makeCoordinates(f);
+
+            // guard against round off
+            box.wrap(pos, image);
+
+            quat<Scalar> orientation_i(h_orientation.data[i]);
+            if (!pivot && Shape(orientation_i, h_params.data[typ_i]).hasOrientation())
+                orientation_i = q_rot * orientation_i;
+            Shape shape_i(orientation_i, h_params.data[typ_i]);
+
+            m_postype_new.push_back(make_scalar4(pos.x, pos.y, pos.z, postype_i.w));
+            m_orientation_new.push_back(quat_to_scalar4(orientation_i));
+            m_image_new.push_back(image);
+
+            // add all particles that overlap with the transformed particle in their old configuration
+            vec3<Scalar> pos_i(pos);
+            detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+
+            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                {
+                vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
+                detail::AABB aabb = aabb_i_local;
+                aabb.translate(pos_i_image);
+
+                // stackless search
+                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes(); cur_node_idx++)
+                    {
+                    if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        {
+                        if (aabb_tree.isNodeLeaf(cur_node_idx))
+                            {
+                            for (unsigned int cur_p = 0; cur_p < aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                {
+                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                if (m_in_cluster[j])
+                                    continue;
+
+                                Scalar4 postype_j = h_postype.data[j];
+                                Scalar4 orientation_j = h_orientation.data[j];
+
+                                // put particles in coordinate system of particle i
+                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                Shape shape_j(quat<Scalar>(orientation_j), h_params.data[typ_j]);
+
+                                if (h_overlaps.data[overlap_idx(typ_i,typ_j)]
+                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                    && test_overlap(r_ij, shape_i, shape_j, err_count)
+                                    && test_overlap(-r_ij, shape_j, shape_i, err_count))
+                                    {
+                                    m_in_cluster[j] = 1;
+                                    m_cluster.push_back(j);
+                                    }
+                                }
+                            }
+                        }
+                    else
+                        {
+                        // skip ahead
+                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
+                        }
+                    } // end loop over AABB nodes
+                } // end loop over images
+            } // end loop over cluster particles
+
+        // move the cluster
+        for (unsigned int k = 0; k < m_cluster.size(); k++)
+            {
+            unsigned int i = m_cluster[k];
+            h_postype.data[i] = m_postype_new[k];
+            h_orientation.data[i] = m_orientation_new[k];
+            h_image.data[i] = m_image_new[k];
+            }
+        }
+
+    if (pivot)
+        m_count_total.pivot_count++;
+    else
+        m_count_total.rotation_count++;
+    m_count_total.particle_count += m_cluster.size();
+
+    m_mc->invalidateAABBTree();
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+    }
+
+//! Export the UpdaterClusters class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of UpdaterClusters<Shape> will be exported
+*/
+template < class Shape > void export_UpdaterClusters(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_< UpdaterClusters<Shape>, std::shared_ptr< UpdaterClusters<Shape> > >(m, name.c_str(), pybind11::base<Updater>())
+          .def( pybind11::init< std::shared_ptr<SystemDefinition>, std::shared_ptr< IntegratorHPMCMono<Shape> >, unsigned int >())
+          .def("setMoveRatio", &UpdaterClusters<Shape>::setMoveRatio)
+          .def("getMoveRatio", &UpdaterClusters<Shape>::getMoveRatio)
+          .def("getCounters", &UpdaterClusters<Shape>::getCounters)
+          ;
+    }
+
+//! Export the cluster move counters to python
+inline void export_hpmc_clusters_counters(pybind11::module& m)
+    {
+    pybind11::class_< hpmc_clusters_counters_t >(m, "hpmc_clusters_counters_t")
+    .def_readwrite("pivot_count", &hpmc_clusters_counters_t::pivot_count)
+    .def_readwrite("rotation_count", &hpmc_clusters_counters_t::rotation_count)
+    .def_readwrite("particle_count", &hpmc_clusters_counters_t::particle_count)
+    .def("getAverageClusterSize", &hpmc_clusters_counters_t::getAverageClusterSize)
+    .def("getNMoves", &hpmc_clusters_counters_t::getNMoves)
+    ;
+    }
+
+} // end namespace hpmc
+
+#endif // __UPDATER_CLUSTERS_H__
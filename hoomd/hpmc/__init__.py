@@ -17,6 +17,7 @@ HPMC implements hard particle Monte Carlo in HOOMD-blue. It supports:
     - Implicit depletants
     - Grand canonical ensemble (:py:class:`update.muvt`)
     - Gibbs ensemble (:py:class:`update.muvt`)
+- Cluster moves (:py:class:`update.clusters`)
 - Shapes:
     - Spheres / disks (:py:class:`integrate.sphere`)
     - Union of spheres (:py:class:`integrate.sphere_union`)
@@ -62,6 +63,12 @@ With non-interacting depletant (**implicit=True**), the following log quantities
 - ``hpmc_overlap_fraction`` - Fraction of deplatants in excluded volume after trial move to depletants in free volume before move
 - ``hpmc_configurational_bias_ratio`` - Ratio of configurational bias attempts to depletant insertions
 
+With event chains (**event_chain=True**), every event counts as an accepted translation move. Collisions are logged
+separately:
+
+- ``hpmc_chain_collisions`` - Average number of collisions per event chain (averaged only over the last time step)
+- ``hpmc_chain_collision_fraction`` - Fraction of events that end in a collision (averaged only over the last time step)
+
 :py:class:`compute.free_volume` provides the following loggable quantities:
 - ``hpmc_free_volume`` - The free volume estimate in the simulation box obtained by MC sampling (in volume units)
 
@@ -79,6 +86,12 @@ With non-interacting depletant (**implicit=True**), the following log quantities
 - ``hpmc_muvt_remove_acceptance`` - Fraction of particle removals accepted (averaged from start of run)
 - ``hpmc_muvt_volume_acceptance`` - Fraction of particle removals accepted (averaged from start of run)
 
+:py:class:`update.clusters` provides the following loggable quantities.
+
+- ``hpmc_clusters_avg_size`` - Average number of particles moved in one cluster move (averaged from start of run)
+- ``hpmc_clusters_pivot_moves`` - Number of pivot moves since the start of the run
+- ``hpmc_clusters_rotation_moves`` - Number of rotation moves since the start of the run
+
 .. rubric:: Timestep definition
 
 HOOMD-blue started as an MD code where **timestep** has a clear meaning. MC simulations are run
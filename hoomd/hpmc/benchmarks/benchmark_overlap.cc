@@ -0,0 +1,296 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeEllipsoid.h"
+#include "hoomd/hpmc/ShapeConvexPolygon.h"
+#include "hoomd/hpmc/ShapeSimplePolygon.h"
+#include "hoomd/hpmc/ShapeSpheropolygon.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+#include "hoomd/hpmc/ShapePolyhedron.h"
+#include "hoomd/hpmc/ShapeFacetedSphere.h"
+#include "hoomd/hpmc/ShapeSphinx.h"
+#include "hoomd/hpmc/ShapeUnion.h"
+#include "hoomd/hpmc/Moves.h"
+
+#include "hoomd/benchmarks/hoomd_benchmark.h"
+
+#include <vector>
+
+/*! \file benchmark_overlap.cc
+    \brief Benchmarks the test_overlap() functions of the HPMC shapes
+    \ingroup benchmarks
+*/
+
+using namespace hpmc;
+using namespace hpmc::detail;
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Number of pairs tested per iteration
+const unsigned int n_pairs = 4096;
+
+//! Time test_overlap() on a fixed set of random pairs
+/*! The separations are drawn uniformly inside the circumsphere diameter, so that close pairs which need the full
+    overlap check and pairs rejected early are both present. In 2D, all separations lie in the plane and the
+    orientations are rotations about z.
+*/
+template <class Shape>
+void benchmark_overlap(hoomd_benchmark::Runner& runner, const std::string& name,
+                       const typename Shape::param_type& params, bool two_d)
+    {
+    if (!runner.enabled(name))
+        return;
+
+    Shape probe(quat<Scalar>(), params);
+    Scalar d = probe.getCircumsphereDiameter();
+
+    std::vector< vec3<Scalar> > r_ij(n_pairs);
+    std::vector< quat<Scalar> > o_i(n_pairs);
+    std::vector< quat<Scalar> > o_j(n_pairs);
+
+    Saru rng(12345);
+    for (unsigned int i = 0; i < n_pairs; i++)
+        {
+        vec3<Scalar> r;
+        do
+            {
+            r = vec3<Scalar>(rng.s<Scalar>(-d, d), rng.s<Scalar>(-d, d), two_d ? Scalar(0.0) : rng.s<Scalar>(-d, d));
+            } while (dot(r,r) > d*d);
+        r_ij[i] = r;
+
+        if (two_d)
+            {
+            o_i[i] = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), rng.s<Scalar>(0, Scalar(2.0*M_PI)));
+            o_j[i] = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), rng.s<Scalar>(0, Scalar(2.0*M_PI)));
+            }
+        else
+            {
+            o_i[i] = generateRandomOrientation(rng);
+            o_j[i] = generateRandomOrientation(rng);
+            }
+        }
+
+    // the overlap count is stored so that the compiler cannot drop the loop
+    volatile unsigned int n_overlap = 0;
+    runner.measure(name, "pairs=4096", n_pairs,
+                   [&](unsigned int n)
+                       {
+                       return hoomd_benchmark::time_loop(runner.getExecConf(), n,
+                           [&]()
+                               {
+                               unsigned int err_count = 0;
+                               unsigned int count = 0;
+                               for (unsigned int i = 0; i < n_pairs; i++)
+                                   {
+                                   Shape a(o_i[i], params);
+                                   Shape b(o_j[i], params);
+                                   if (test_overlap(r_ij[i], a, b, err_count))
+                                       count++;
+                                   }
+                               n_overlap = count;
+                               });
+                       });
+    }
+
+//! Set the circumsphere diameter of a 2D vertex list
+void set_diameter(poly2d_verts& verts)
+    {
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < verts.N; i++)
+        radius_sq = std::max(radius_sq, verts.x[i]*verts.x[i] + verts.y[i]*verts.y[i]);
+    verts.diameter = 2*(sqrt(radius_sq) + verts.sweep_radius);
+    }
+
+//! Make a square with the given sweep radius
+poly2d_verts make_square(OverlapReal sweep_radius)
+    {
+    poly2d_verts verts;
+    verts.N = 4;
+    verts.sweep_radius = sweep_radius;
+    verts.x[0] = -0.5; verts.y[0] = -0.5;
+    verts.x[1] = 0.5; verts.y[1] = -0.5;
+    verts.x[2] = 0.5; verts.y[2] = 0.5;
+    verts.x[3] = -0.5; verts.y[3] = 0.5;
+    set_diameter(verts);
+    return verts;
+    }
+
+//! Make a cube with the given sweep radius
+poly3d_verts<8> make_cube(OverlapReal sweep_radius)
+    {
+    poly3d_verts<8> verts;
+    verts.N = 8;
+    verts.sweep_radius = sweep_radius;
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        verts.x[i] = (i & 1) ? 0.5 : -0.5;
+        verts.y[i] = (i & 2) ? 0.5 : -0.5;
+        verts.z[i] = (i & 4) ? 0.5 : -0.5;
+        }
+    verts.diameter = 2*(sqrt(OverlapReal(0.75)) + sweep_radius);
+    return verts;
+    }
+
+//! Make an octahedron with its face tree, as the python API does
+ShapePolyhedron::param_type make_octahedron()
+    {
+    poly3d_data data;
+    data.verts.N = 6;
+    data.verts.sweep_radius = 0;
+    const OverlapReal v[6][3] = {{-0.5,0,0}, {0.5,0,0}, {0,-0.5,0}, {0,0.5,0}, {0,0,-0.5}, {0,0,0.5}};
+    for (unsigned int i = 0; i < 6; i++)
+        {
+        data.verts.x[i] = v[i][0]; data.verts.y[i] = v[i][1]; data.verts.z[i] = v[i][2];
+        }
+    data.verts.diameter = 1.0;
+
+    // faces are listed counterclockwise when viewed from outside
+    const unsigned int f[8][3] = {{1,3,5}, {3,0,5}, {0,2,5}, {2,1,5}, {3,1,4}, {0,3,4}, {2,0,4}, {1,2,4}};
+    data.n_faces = 8;
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        data.face_offs[i] = 3*i;
+        for (unsigned int j = 0; j < 3; j++)
+            data.face_verts[3*i+j] = f[i][j];
+        }
+    data.face_offs[8] = 24;
+    data.ignore = 0;
+
+    ShapePolyhedron::gpu_tree_type::obb_tree_type tree;
+    OBB *obbs;
+    int retval = posix_memalign((void**)&obbs, 32, sizeof(OBB)*data.n_faces);
+    if (retval != 0)
+        throw std::runtime_error("Error allocating aligned OBB memory.");
+
+    std::vector<std::vector<vec3<OverlapReal> > > internal_coordinates;
+    for (unsigned int i = 0; i < data.n_faces; ++i)
+        {
+        std::vector< vec3<OverlapReal> > face_vec;
+        for (unsigned int j = data.face_offs[i]; j < data.face_offs[i+1]; ++j)
+            face_vec.push_back(vec3<OverlapReal>(data.verts.x[data.face_verts[j]],
+                                                 data.verts.y[data.face_verts[j]],
+                                                 data.verts.z[data.face_verts[j]]));
+        obbs[i] = compute_obb(face_vec, data.verts.sweep_radius);
+        internal_coordinates.push_back(face_vec);
+        }
+    tree.buildTree(obbs, internal_coordinates, data.verts.sweep_radius, data.n_faces);
+    free(obbs);
+
+    ShapePolyhedron::param_type p;
+    p.data = data;
+    p.tree = ShapePolyhedron::gpu_tree_type(tree);
+    return p;
+    }
+
+//! Make a sphere cut by the six planes of a cube
+faceted_sphere_params make_faceted_sphere()
+    {
+    faceted_sphere_params p;
+    p.N = 6;
+    p.diameter = 1.0;
+    p.insphere_radius = 0.4;
+    p.origin = vec3<OverlapReal>(0,0,0);
+    p.ignore = 0;
+    p.n[0] = vec3<OverlapReal>(1,0,0); p.n[1] = vec3<OverlapReal>(-1,0,0);
+    p.n[2] = vec3<OverlapReal>(0,1,0); p.n[3] = vec3<OverlapReal>(0,-1,0);
+    p.n[4] = vec3<OverlapReal>(0,0,1); p.n[5] = vec3<OverlapReal>(0,0,-1);
+    for (unsigned int i = 0; i < 6; i++)
+        p.offset[i] = -0.4;
+
+    // the cube corners lie outside of the sphere
+    p.verts.N = 0;
+    p.verts.diameter = p.diameter;
+    p.verts.sweep_radius = 0;
+    p.verts.ignore = 0;
+    ShapeFacetedSphere::initializeVertices(p);
+    return p;
+    }
+
+//! Make a sphinx with two concave sphere cuts
+sphinx3d_params make_sphinx()
+    {
+    sphinx3d_params p;
+    p.N = 3;
+    p.diameter[0] = 2.0;
+    p.diameter[1] = -2.2;
+    p.diameter[2] = -2.2;
+    p.center[0] = vec3<OverlapReal>(0,0,0);
+    p.center[1] = vec3<OverlapReal>(0,0,1.15);
+    p.center[2] = vec3<OverlapReal>(0,0,-1.15);
+    p.circumsphereDiameter = 2.0;
+    p.ignore = 0;
+    return p;
+    }
+
+//! Make a union of eight spheres on the corners of a cube
+union_params<ShapeSphere> make_sphere_union()
+    {
+    union_params<ShapeSphere> p;
+    p.N = 8;
+    p.ignore = 0;
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        p.mpos[i] = vec3<Scalar>((i & 1) ? 0.25 : -0.25, (i & 2) ? 0.25 : -0.25, (i & 4) ? 0.25 : -0.25);
+        p.morientation[i] = quat<Scalar>();
+        p.mparams[i].radius = 0.25;
+        p.mparams[i].ignore = 0;
+        }
+    p.diameter = 2*(sqrt(OverlapReal(3.0*0.25*0.25)) + 0.25);
+
+    union_gpu_tree_type::obb_tree_type tree;
+    OBB *obbs;
+    int retval = posix_memalign((void**)&obbs, 32, sizeof(OBB)*p.N);
+    if (retval != 0)
+        throw std::runtime_error("Error allocating aligned OBB memory.");
+
+    for (unsigned int i = 0; i < p.N; ++i)
+        {
+        ShapeSphere member(p.morientation[i], p.mparams[i]);
+        obbs[i] = OBB(member.getAABB(p.mpos[i]));
+        }
+    tree.buildTree(obbs, p.N);
+    free(obbs);
+    p.tree = union_gpu_tree_type(tree);
+    return p;
+    }
+
+HOOMD_BENCHMARK(overlap)
+    {
+    sph_params sphere;
+    sphere.radius = 0.5;
+    sphere.ignore = 0;
+    benchmark_overlap<ShapeSphere>(runner, "ShapeSphere", sphere, false);
+
+    ell_params ellipsoid;
+    ellipsoid.x = 0.5;
+    ellipsoid.y = 0.25;
+    ellipsoid.z = 0.15;
+    ellipsoid.ignore = 0;
+    benchmark_overlap<ShapeEllipsoid>(runner, "ShapeEllipsoid", ellipsoid, false);
+
+    benchmark_overlap<ShapeConvexPolygon>(runner, "ShapeConvexPolygon", make_square(0), true);
+    benchmark_overlap<ShapeSpheropolygon>(runner, "ShapeSpheropolygon", make_square(0.1), true);
+
+    // an arrow head, which is concave
+    poly2d_verts arrow;
+    arrow.N = 4;
+    arrow.x[0] = -0.5; arrow.y[0] = -0.5;
+    arrow.x[1] = 0.5; arrow.y[1] = 0;
+    arrow.x[2] = -0.5; arrow.y[2] = 0.5;
+    arrow.x[3] = -0.2; arrow.y[3] = 0;
+    set_diameter(arrow);
+    benchmark_overlap<ShapeSimplePolygon>(runner, "ShapeSimplePolygon", arrow, true);
+
+    benchmark_overlap< ShapeConvexPolyhedron<8> >(runner, "ShapeConvexPolyhedron", make_cube(0), false);
+    benchmark_overlap< ShapeSpheropolyhedron<8> >(runner, "ShapeSpheropolyhedron", make_cube(0.1), false);
+    benchmark_overlap<ShapePolyhedron>(runner, "ShapePolyhedron", make_octahedron(), false);
+    benchmark_overlap<ShapeFacetedSphere>(runner, "ShapeFacetedSphere", make_faceted_sphere(), false);
+    benchmark_overlap<ShapeSphinx>(runner, "ShapeSphinx", make_sphinx(), false);
+    benchmark_overlap< ShapeUnion<ShapeSphere> >(runner, "ShapeUnion<ShapeSphere>", make_sphere_union(), false);
+    }
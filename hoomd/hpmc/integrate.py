@@ -177,6 +177,7 @@ class mode_hpmc(_integrator):
     def __init__(self, implicit):
         _integrator.__init__(self);
         self.implicit=implicit
+        self.event_chain=False
 
         # setup the shape parameters
         self.shape_param = data.param_dict(self); # must call initialize_shape_params() after the cpp_integrator is created.
@@ -355,7 +356,10 @@ class mode_hpmc(_integrator):
                    nselect=None,
                    nR=None,
                    depletant_type=None,
-                   ntrial=None):
+                   ntrial=None,
+                   checkerboard=None,
+                   aabb_refit_threshold=None,
+                   chain_length=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
@@ -366,6 +370,13 @@ class mode_hpmc(_integrator):
             nR (int): (if set) **Implicit depletants only**: Number density of implicit depletants in free volume.
             depletant_type (str): (if set) **Implicit depletants only**: Particle type to use as implicit depletant.
             ntrial (int): (if set) **Implicit depletants only**: Number of re-insertion attempts per overlapping depletant.
+            checkerboard (bool): (if set) **CPU only**: Perform trial moves on a randomly shifted checkerboard of cells.
+                Cells of the same color are processed in parallel when HOOMD is compiled with ENABLE_OPENMP.
+                Trial moves that leave their cell are rejected, which lowers the translate acceptance slightly.
+            aabb_refit_threshold (float): (if set) **CPU only**: When non-zero, refit the AABB tree to the moved particles
+                instead of rebuilding it every step, and rebuild only when the surface area heuristic cost of the tree
+                exceeds this multiple of its cost after the last rebuild. Must be 0 (always rebuild, the default) or >= 1.
+            chain_length (float): (if set) **Event chains only**: Total displacement of one event chain (distance units).
         """
 
         hoomd.util.print_status_line();
@@ -397,6 +408,21 @@ class mode_hpmc(_integrator):
         if nselect is not None:
             self.cpp_integrator.setNSelect(nselect);
 
+        if checkerboard is not None:
+            if self.implicit or hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.warning("Checkerboard sweeps are only supported by CPU integrators without implicit depletants, ignoring.\n")
+            else:
+                self.cpp_integrator.setCheckerboard(checkerboard);
+
+        if aabb_refit_threshold is not None:
+            self.cpp_integrator.setAABBTreeRefitThreshold(aabb_refit_threshold);
+
+        if chain_length is not None:
+            if self.event_chain:
+                self.cpp_integrator.setChainLength(chain_length);
+            else:
+                hoomd.context.msg.warning("Event chain parameters not supported by this integrator.\n")
+
         if self.implicit:
             if nR is not None:
                 self.implicit_params.append('nR')
@@ -597,6 +623,30 @@ class mode_hpmc(_integrator):
         counters = self.cpp_integrator.getImplicitCounters(1);
         return counters.getConfigurationalBiasRatio();
 
+    def get_chain_collisions(self):
+        R""" Get the average number of collisions per event chain.
+
+        Returns:
+            The average number of collisions per event chain during the last :py:func:`hoomd.run()`.
+
+        Event chains are rejection free, so every event counts as an accepted translation move and
+        :py:meth:`get_translate_acceptance` does not measure how often chains are lifted to another particle.
+
+        Example::
+
+            mc = hpmc.integrate.sphere(..,event_chain=True);
+            mc.shape_param.set(....);
+            run(100)
+            collisions = mc.get_chain_collisions();
+
+        """
+        if not self.event_chain:
+            hoomd.context.msg.warning("Quantity only available with event chains. Returning 0.\n")
+            return 0;
+
+        counters = self.cpp_integrator.getEventChainCounters(1);
+        return counters.getCollisionsPerChain();
+
     ## Check that the required implicit depletant parameters have been supplied
     # \returns Nothing
     #
@@ -630,9 +680,15 @@ class sphere(mode_hpmc):
         d (float): Maximum move displacement, Scalar to set for all types, or a dict containing {type:size} to set by type.
         nselect (int): The number of trial moves to perform in each cell.
         implicit (bool): Flag to enable implicit depletants.
+        event_chain (bool): **CPU only**: Move the spheres with event chains instead of trial displacements.
 
     Hard particle Monte Carlo integration method for spheres.
 
+    With *event_chain=True*, every particle starts *nselect* event chains per step along a random positive axis. The
+    chain moves one sphere until it hits another one, which then continues the chain, until the total displacement
+    equals *chain_length* (see :py:meth:`mode_hpmc.set_params`). Each segment of a chain is at most *d* long. Event chains
+    are not supported with implicit depletants, external fields, or MPI domain decomposition.
+
     Sphere parameters:
 
     * *diameter* (**required**) - diameter of the sphere (distance units)
@@ -656,17 +712,30 @@ class sphere(mode_hpmc):
         mc.set_param(nselect=8,nR=3,depletant_type='B')
         mc.shape_param.set('A', diameter=1.0)
         mc.shape_param.set('B', diameter=.1)
+
+    Event chain Example::
+
+        mc = hpmc.integrate.sphere(seed=415236, d=0.5, event_chain=True)
+        mc.set_params(chain_length=2.0)
+        mc.shape_param.set('A', diameter=1.0)
     """
 
-    def __init__(self, seed, d=0.1, nselect=4, implicit=False):
+    def __init__(self, seed, d=0.1, nselect=4, implicit=False, event_chain=False):
         hoomd.util.print_status_line();
 
         # initialize base class
         mode_hpmc.__init__(self,implicit);
 
+        if event_chain and (implicit or hoomd.context.exec_conf.isCUDAEnabled()):
+            hoomd.context.msg.error("hpmc.integrate.sphere: event chains are only supported on the CPU without implicit depletants\n");
+            raise RuntimeError("Error initializing hpmc.integrate.sphere");
+
         # initialize the reflected c++ class
         if not hoomd.context.exec_conf.isCUDAEnabled():
-            if(implicit):
+            if event_chain:
+                self.cpp_integrator = _hpmc.IntegratorHPMCMonoEventChainSphere(hoomd.context.current.system_definition, seed);
+                self.event_chain = True;
+            elif(implicit):
                 self.cpp_integrator = _hpmc.IntegratorHPMCMonoImplicitSphere(hoomd.context.current.system_definition, seed)
             else:
                 self.cpp_integrator = _hpmc.IntegratorHPMCMonoSphere(hoomd.context.current.system_definition, seed);
@@ -1048,6 +1117,10 @@ class convex_polyhedron(mode_hpmc):
         nselect (int): (Override the automatic choice for the number of trial moves to perform in each cell.
         implicit (bool): Flag to enable implicit depletants.
         max_verts (int): Set the maximum number of vertices in a polyhedron.
+        event_chain (bool): **CPU only**: Translate the polyhedra with event chains instead of trial displacements.
+
+    With *event_chain=True*, translations are performed with event chains as described in :py:class:`sphere`.
+    Rotation trial moves are performed in separate sweeps before the chains whenever *move_ratio* is less than 1.
 
     Convex polyhedron parameters:
 
@@ -1081,15 +1154,22 @@ class convex_polyhedron(mode_hpmc):
         mc.shape_param.set('A', vertices=[(0.5, 0.5, 0.5), (0.5, -0.5, -0.5), (-0.5, 0.5, -0.5), (-0.5, -0.5, 0.5)]);
         mc.shape_param.set('B', vertices=[(0.05, 0.05, 0.05), (0.05, -0.05, -0.05), (-0.05, 0.05, -0.05), (-0.05, -0.05, 0.05)]);
     """
-    def __init__(self, seed, d=0.1, a=0.1, move_ratio=0.5, nselect=4, implicit=False, max_verts=8):
+    def __init__(self, seed, d=0.1, a=0.1, move_ratio=0.5, nselect=4, implicit=False, max_verts=8, event_chain=False):
         hoomd.util.print_status_line();
 
         # initialize base class
         mode_hpmc.__init__(self,implicit);
 
+        if event_chain and (implicit or hoomd.context.exec_conf.isCUDAEnabled()):
+            hoomd.context.msg.error("hpmc.integrate.convex_polyhedron: event chains are only supported on the CPU without implicit depletants\n");
+            raise RuntimeError("Error initializing hpmc.integrate.convex_polyhedron");
+
         # initialize the reflected c++ class
         if not hoomd.context.exec_conf.isCUDAEnabled():
-            if(implicit):
+            if event_chain:
+                self.cpp_integrator = _get_sized_entry('IntegratorHPMCMonoEventChainConvexPolyhedron', max_verts)(hoomd.context.current.system_definition, seed);
+                self.event_chain = True;
+            elif(implicit):
                 self.cpp_integrator = _get_sized_entry('IntegratorHPMCMonoImplicitConvexPolyhedron', max_verts)(hoomd.context.current.system_definition, seed);
             else:
                 self.cpp_integrator = _get_sized_entry('IntegratorHPMCMonoConvexPolyhedron', max_verts)(hoomd.context.current.system_definition, seed);
@@ -5,6 +5,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 #include "IntegratorHPMCMonoImplicit.h"
+#include "IntegratorHPMCMonoEventChain.h"
 
 #include "ShapeSphere.h"
 #include "ShapeConvexPolygon.h"
@@ -19,6 +20,7 @@
 #include "ShapeUnion.h"
 #include "AnalyzerSDF.h"
 #include "UpdaterBoxMC.h"
+#include "UpdaterClusters.h"
 
 #include "ShapeProxy.h"
 
@@ -118,6 +120,8 @@ PYBIND11_PLUGIN(_hpmc)
 
     // export counters
     export_hpmc_implicit_counters(m);
+    export_hpmc_clusters_counters(m);
+    export_hpmc_event_chain_counters(m);
 
     return m.ptr();
     }
@@ -5,6 +5,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 #include "IntegratorHPMCMonoImplicit.h"
+#include "IntegratorHPMCMonoEventChain.h"
 #include "ComputeFreeVolume.h"
 
 #include "ShapeSphere.h"
@@ -29,6 +30,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -52,10 +54,12 @@ void export_convex_polyhedron128(py::module& m)
     {
     export_IntegratorHPMCMono< ShapeConvexPolyhedron<128> >(m, "IntegratorHPMCMonoConvexPolyhedron128");
     export_IntegratorHPMCMonoImplicit< ShapeConvexPolyhedron<128> >(m, "IntegratorHPMCMonoImplicitConvexPolyhedron128");
+    export_IntegratorHPMCMonoEventChain< ShapeConvexPolyhedron<128> >(m, "IntegratorHPMCMonoEventChainConvexPolyhedron128");
     export_ComputeFreeVolume< ShapeConvexPolyhedron<128> >(m, "ComputeFreeVolumeConvexPolyhedron128");
     export_AnalyzerSDF< ShapeConvexPolyhedron<128> >(m, "AnalyzerSDFConvexPolyhedron128");
     export_UpdaterMuVT< ShapeConvexPolyhedron<128> >(m, "UpdaterMuVTConvexPolyhedron128");
     export_UpdaterMuVTImplicit< ShapeConvexPolyhedron<128> >(m, "UpdaterMuVTImplicitConvexPolyhedron128");
+    export_UpdaterClusters< ShapeConvexPolyhedron<128> >(m, "UpdaterClustersConvexPolyhedron128");
 
     export_ExternalFieldInterface<ShapeConvexPolyhedron<128> >(m, "ExternalFieldConvexPolyhedron128");
     export_LatticeField<ShapeConvexPolyhedron<128> >(m, "ExternalFieldLatticeConvexPolyhedron128");
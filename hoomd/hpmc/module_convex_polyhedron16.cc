@@ -5,6 +5,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 #include "IntegratorHPMCMonoImplicit.h"
+#include "IntegratorHPMCMonoEventChain.h"
 #include "ComputeFreeVolume.h"
 
 #include "ShapeSphere.h"
@@ -29,6 +30,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -52,10 +54,12 @@ void export_convex_polyhedron16(py::module& m)
     {
     export_IntegratorHPMCMono< ShapeConvexPolyhedron<16> >(m, "IntegratorHPMCMonoConvexPolyhedron16");
     export_IntegratorHPMCMonoImplicit< ShapeConvexPolyhedron<16> >(m, "IntegratorHPMCMonoImplicitConvexPolyhedron16");
+    export_IntegratorHPMCMonoEventChain< ShapeConvexPolyhedron<16> >(m, "IntegratorHPMCMonoEventChainConvexPolyhedron16");
     export_ComputeFreeVolume< ShapeConvexPolyhedron<16> >(m, "ComputeFreeVolumeConvexPolyhedron16");
     export_AnalyzerSDF< ShapeConvexPolyhedron<16> >(m, "AnalyzerSDFConvexPolyhedron16");
     export_UpdaterMuVT< ShapeConvexPolyhedron<16> >(m, "UpdaterMuVTConvexPolyhedron16");
     export_UpdaterMuVTImplicit< ShapeConvexPolyhedron<16> >(m, "UpdaterMuVTImplicitConvexPolyhedron16");
+    export_UpdaterClusters< ShapeConvexPolyhedron<16> >(m, "UpdaterClustersConvexPolyhedron16");
 
     export_ExternalFieldInterface<ShapeConvexPolyhedron<16> >(m, "ExternalFieldConvexPolyhedron16");
     export_LatticeField<ShapeConvexPolyhedron<16> >(m, "ExternalFieldLatticeConvexPolyhedron16");
@@ -5,6 +5,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 #include "IntegratorHPMCMonoImplicit.h"
+#include "IntegratorHPMCMonoEventChain.h"
 #include "ComputeFreeVolume.h"
 
 #include "ShapeSphere.h"
@@ -29,6 +30,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -52,10 +54,12 @@ void export_convex_polyhedron32(py::module& m)
     {
     export_IntegratorHPMCMono< ShapeConvexPolyhedron<32> >(m, "IntegratorHPMCMonoConvexPolyhedron32");
     export_IntegratorHPMCMonoImplicit< ShapeConvexPolyhedron<32> >(m, "IntegratorHPMCMonoImplicitConvexPolyhedron32");
+    export_IntegratorHPMCMonoEventChain< ShapeConvexPolyhedron<32> >(m, "IntegratorHPMCMonoEventChainConvexPolyhedron32");
     export_ComputeFreeVolume< ShapeConvexPolyhedron<32> >(m, "ComputeFreeVolumeConvexPolyhedron32");
     export_AnalyzerSDF< ShapeConvexPolyhedron<32> >(m, "AnalyzerSDFConvexPolyhedron32");
     export_UpdaterMuVT< ShapeConvexPolyhedron<32> >(m, "UpdaterMuVTConvexPolyhedron32");
     export_UpdaterMuVTImplicit< ShapeConvexPolyhedron<32> >(m, "UpdaterMuVTImplicitConvexPolyhedron32");
+    export_UpdaterClusters< ShapeConvexPolyhedron<32> >(m, "UpdaterClustersConvexPolyhedron32");
 
     export_ExternalFieldInterface<ShapeConvexPolyhedron<32> >(m, "ExternalFieldConvexPolyhedron32");
     export_LatticeField<ShapeConvexPolyhedron<32> >(m, "ExternalFieldLatticeConvexPolyhedron32");
@@ -5,6 +5,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 #include "IntegratorHPMCMonoImplicit.h"
+#include "IntegratorHPMCMonoEventChain.h"
 #include "ComputeFreeVolume.h"
 
 #include "ShapeSphere.h"
@@ -29,6 +30,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -52,10 +54,12 @@ void export_convex_polyhedron64(py::module& m)
     {
     export_IntegratorHPMCMono< ShapeConvexPolyhedron<64> >(m, "IntegratorHPMCMonoConvexPolyhedron64");
     export_IntegratorHPMCMonoImplicit< ShapeConvexPolyhedron<64> >(m, "IntegratorHPMCMonoImplicitConvexPolyhedron64");
+    export_IntegratorHPMCMonoEventChain< ShapeConvexPolyhedron<64> >(m, "IntegratorHPMCMonoEventChainConvexPolyhedron64");
     export_ComputeFreeVolume< ShapeConvexPolyhedron<64> >(m, "ComputeFreeVolumeConvexPolyhedron64");
     export_AnalyzerSDF< ShapeConvexPolyhedron<64> >(m, "AnalyzerSDFConvexPolyhedron64");
     export_UpdaterMuVT< ShapeConvexPolyhedron<64> >(m, "UpdaterMuVTConvexPolyhedron64");
     export_UpdaterMuVTImplicit< ShapeConvexPolyhedron<64> >(m, "UpdaterMuVTImplicitConvexPolyhedron64");
+    export_UpdaterClusters< ShapeConvexPolyhedron<64> >(m, "UpdaterClustersConvexPolyhedron64");
 
     export_ExternalFieldInterface<ShapeConvexPolyhedron<64> >(m, "ExternalFieldConvexPolyhedron64");
     export_LatticeField<ShapeConvexPolyhedron<64> >(m, "ExternalFieldLatticeConvexPolyhedron64");
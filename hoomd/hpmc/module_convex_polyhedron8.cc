@@ -5,6 +5,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 #include "IntegratorHPMCMonoImplicit.h"
+#include "IntegratorHPMCMonoEventChain.h"
 #include "ComputeFreeVolume.h"
 
 #include "ShapeSphere.h"
@@ -29,6 +30,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -52,10 +54,12 @@ void export_convex_polyhedron8(py::module& m)
     {
     export_IntegratorHPMCMono< ShapeConvexPolyhedron<8> >(m, "IntegratorHPMCMonoConvexPolyhedron8");
     export_IntegratorHPMCMonoImplicit< ShapeConvexPolyhedron<8> >(m, "IntegratorHPMCMonoImplicitConvexPolyhedron8");
+    export_IntegratorHPMCMonoEventChain< ShapeConvexPolyhedron<8> >(m, "IntegratorHPMCMonoEventChainConvexPolyhedron8");
     export_ComputeFreeVolume< ShapeConvexPolyhedron<8> >(m, "ComputeFreeVolumeConvexPolyhedron8");
     export_AnalyzerSDF< ShapeConvexPolyhedron<8> >(m, "AnalyzerSDFConvexPolyhedron8");
     export_UpdaterMuVT< ShapeConvexPolyhedron<8> >(m, "UpdaterMuVTConvexPolyhedron8");
     export_UpdaterMuVTImplicit< ShapeConvexPolyhedron<8> >(m, "UpdaterMuVTImplicitConvexPolyhedron8");
+    export_UpdaterClusters< ShapeConvexPolyhedron<8> >(m, "UpdaterClustersConvexPolyhedron8");
 
     export_ExternalFieldInterface<ShapeConvexPolyhedron<8> >(m, "ExternalFieldConvexPolyhedron8");
     export_LatticeField<ShapeConvexPolyhedron<8> >(m, "ExternalFieldLatticeConvexPolyhedron8");
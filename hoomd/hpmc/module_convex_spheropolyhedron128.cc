@@ -29,6 +29,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -56,6 +57,7 @@ void export_convex_spheropolyhedron128(py::module& m)
     export_AnalyzerSDF< ShapeSpheropolyhedron<128> >(m, "AnalyzerSDFSpheropolyhedron128");
     export_UpdaterMuVT< ShapeSpheropolyhedron<128> >(m, "UpdaterMuVTSpheropolyhedron128");
     export_UpdaterMuVTImplicit< ShapeSpheropolyhedron<128> >(m, "UpdaterMuVTImplicitSpheropolyhedron128");
+    export_UpdaterClusters< ShapeSpheropolyhedron<128> >(m, "UpdaterClustersSpheropolyhedron128");
 
     export_ExternalFieldInterface<ShapeSpheropolyhedron<128> >(m, "ExternalFieldSpheropolyhedron128");
     export_LatticeField<ShapeSpheropolyhedron<128> >(m, "ExternalFieldLatticeSpheropolyhedron128");
@@ -29,6 +29,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -56,6 +57,7 @@ void export_convex_spheropolyhedron16(py::module& m)
     export_AnalyzerSDF< ShapeSpheropolyhedron<16> >(m, "AnalyzerSDFSpheropolyhedron16");
     export_UpdaterMuVT< ShapeSpheropolyhedron<16> >(m, "UpdaterMuVTSpheropolyhedron16");
     export_UpdaterMuVTImplicit< ShapeSpheropolyhedron<16> >(m, "UpdaterMuVTImplicitSpheropolyhedron16");
+    export_UpdaterClusters< ShapeSpheropolyhedron<16> >(m, "UpdaterClustersSpheropolyhedron16");
 
     export_ExternalFieldInterface<ShapeSpheropolyhedron<16> >(m, "ExternalFieldSpheropolyhedron16");
     export_LatticeField<ShapeSpheropolyhedron<16> >(m, "ExternalFieldLatticeSpheropolyhedron16");
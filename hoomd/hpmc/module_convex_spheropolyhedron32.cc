@@ -29,6 +29,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -56,6 +57,7 @@ void export_convex_spheropolyhedron32(py::module& m)
     export_AnalyzerSDF< ShapeSpheropolyhedron<32> >(m, "AnalyzerSDFSpheropolyhedron32");
     export_UpdaterMuVT< ShapeSpheropolyhedron<32> >(m, "UpdaterMuVTSpheropolyhedron32");
     export_UpdaterMuVTImplicit< ShapeSpheropolyhedron<32> >(m, "UpdaterMuVTImplicitSpheropolyhedron32");
+    export_UpdaterClusters< ShapeSpheropolyhedron<32> >(m, "UpdaterClustersSpheropolyhedron32");
 
     export_ExternalFieldInterface<ShapeSpheropolyhedron<32> >(m, "ExternalFieldSpheropolyhedron32");
     export_LatticeField<ShapeSpheropolyhedron<32> >(m, "ExternalFieldLatticeSpheropolyhedron32");
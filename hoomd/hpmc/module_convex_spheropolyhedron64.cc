@@ -29,6 +29,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -56,6 +57,7 @@ void export_convex_spheropolyhedron64(py::module& m)
     export_AnalyzerSDF< ShapeSpheropolyhedron<64> >(m, "AnalyzerSDFSpheropolyhedron64");
     export_UpdaterMuVT< ShapeSpheropolyhedron<64> >(m, "UpdaterMuVTSpheropolyhedron64");
     export_UpdaterMuVTImplicit< ShapeSpheropolyhedron<64> >(m, "UpdaterMuVTImplicitSpheropolyhedron64");
+    export_UpdaterClusters< ShapeSpheropolyhedron<64> >(m, "UpdaterClustersSpheropolyhedron64");
 
     export_ExternalFieldInterface<ShapeSpheropolyhedron<64> >(m, "ExternalFieldSpheropolyhedron64");
     export_LatticeField<ShapeSpheropolyhedron<64> >(m, "ExternalFieldLatticeSpheropolyhedron64");
@@ -29,6 +29,7 @@
 #include "UpdaterRemoveDrift.h"
 #include "UpdaterMuVT.h"
 #include "UpdaterMuVTImplicit.h"
+#include "UpdaterClusters.h"
 
 #ifdef ENABLE_CUDA
 #include "IntegratorHPMCMonoGPU.h"
@@ -56,6 +57,7 @@ void export_convex_spheropolyhedron8(py::module& m)
     export_AnalyzerSDF< ShapeSpheropolyhedron<8> >(m, "AnalyzerSDFSpheropolyhedron8");
     export_UpdaterMuVT< ShapeSpheropolyhedron<8> >(m, "UpdaterMuVTSpheropolyhedron8");
     export_UpdaterMuVTImplicit< ShapeSpheropolyhedron<8> >(m, "UpdaterMuVTImplicitSpheropolyhedron8");
+    export_UpdaterClusters< ShapeSpheropolyhedron<8> >(m, "UpdaterClustersSpheropolyhedron8");
 
     export_ExternalFieldInterface<ShapeSpheropolyhedron<8> >(m, "ExternalFieldSpheropolyhedron8");
     export_LatticeField<ShapeSpheropolyhedron<8> >(m, "ExternalFieldLatticeSpheropolyhedron8");
@@ -0,0 +1,95 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import hoomd
+import unittest
+import os
+import numpy
+
+context.initialize()
+
+# Test that checkerboard sweeps do not produce overlaps and that trial moves are accepted
+class checkerboard_sweep(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=10);
+
+    def test_sphere(self):
+        mc = hpmc.integrate.sphere(seed=123, d=0.1);
+        mc.shape_param.set('A', diameter=1.0);
+        mc.set_params(checkerboard=True);
+
+        run(100);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertGreater(mc.get_translate_acceptance(), 0);
+
+        del mc
+
+    def test_convex_polyhedron(self):
+        mc = hpmc.integrate.convex_polyhedron(seed=456, d=0.1, a=0.1, max_verts=8);
+        mc.shape_param.set('A', vertices=[(-0.5,-0.5,-0.5), (-0.5,-0.5,0.5), (-0.5,0.5,-0.5), (-0.5,0.5,0.5),
+                                          (0.5,-0.5,-0.5), (0.5,-0.5,0.5), (0.5,0.5,-0.5), (0.5,0.5,0.5)]);
+        mc.set_params(checkerboard=True);
+
+        run(100);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertGreater(mc.get_translate_acceptance(), 0);
+        self.assertGreater(mc.get_rotate_acceptance(), 0);
+
+        del mc
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
+# Test that checkerboard sweeps sample the same ensemble as the standard sweeps for hard spheres
+class checkerboard_statistics(unittest.TestCase):
+    def sample(self, checkerboard, d, betaP=None, nsteps=1000):
+        context.initialize();
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=6);
+
+        mc = hpmc.integrate.sphere(seed=123, d=d);
+        mc.shape_param.set('A', diameter=1.0);
+        mc.set_params(checkerboard=checkerboard);
+
+        rho = [];
+        if betaP is not None:
+            boxmc = hpmc.update.boxmc(mc, betaP=betaP, seed=456);
+            boxmc.volume(delta=2.0, weight=1);
+            run(2000);
+            record = lambda step: rho.append(len(self.system.particles) / self.system.box.get_volume());
+            analyze.callback(callback=record, period=10);
+
+        run(nsteps);
+        self.assertEqual(mc.count_overlaps(), 0);
+        return mc.get_translate_acceptance(), numpy.array(rho);
+
+    # moves that leave their cell are rejected, which lowers the acceptance by about (9/8) d/w for cells of width w
+    def test_acceptance(self):
+        acc_standard, rho = self.sample(checkerboard=False, d=0.02);
+        acc_checkerboard, rho = self.sample(checkerboard=True, d=0.02);
+
+        self.assertLess(acc_checkerboard, acc_standard);
+        self.assertLess(acc_standard - acc_checkerboard, 0.03);
+
+    # the equilibrium density at constant pressure must agree within the statistical error
+    def test_density(self):
+        def block_average(x, nblocks=10):
+            blocks = numpy.array_split(x, nblocks);
+            means = numpy.array([b.mean() for b in blocks]);
+            return means.mean(), means.std(ddof=1) / numpy.sqrt(nblocks);
+
+        acc, rho = self.sample(checkerboard=False, d=0.1, betaP=3.5, nsteps=10000);
+        rho_standard, err_standard = block_average(rho);
+        acc, rho = self.sample(checkerboard=True, d=0.1, betaP=3.5, nsteps=10000);
+        rho_checkerboard, err_checkerboard = block_average(rho);
+
+        self.assertLess(abs(rho_standard - rho_checkerboard), 3*numpy.sqrt(err_standard**2 + err_checkerboard**2));
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,135 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import hoomd
+import unittest
+import os
+
+context.initialize()
+
+# Test that geometric cluster moves move the particles without producing overlaps
+class clusters_3d(unittest.TestCase):
+    def setUp(self):
+        uc = lattice.unitcell(N=2,
+                              a1=[1.5,0,0], a2=[0,1.5,0], a3=[0,0,1.5],
+                              position=[[0,0,0], [0.75,0.75,0.75]],
+                              type_name=['A','B']);
+        self.system = init.create_lattice(unitcell=uc, n=5);
+        self.pos_start = [p.position for p in self.system.particles];
+
+    def displaced(self):
+        return sum(1 for p,r in zip(self.system.particles, self.pos_start) if p.position != r);
+
+    def test_mixture(self):
+        mc = hpmc.integrate.sphere(seed=123, d=0.1);
+        mc.shape_param.set('A', diameter=1.0);
+        mc.shape_param.set('B', diameter=0.5);
+        mc.overlap_checks.set('B', 'B', False);
+
+        cl = hpmc.update.clusters(mc=mc, seed=456);
+        run(100);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertGreaterEqual(cl.get_average_cluster_size(), 1);
+        self.assertGreater(self.displaced(), 0);
+        counters = cl.cpp_updater.getCounters(1);
+        self.assertEqual(counters.getNMoves(), 100);
+        self.assertGreater(counters.pivot_count, 0);
+        self.assertGreater(counters.rotation_count, 0);
+
+        del cl
+        del mc
+
+    def test_convex_polyhedron(self):
+        mc = hpmc.integrate.convex_polyhedron(seed=123, d=0.1, a=0.1, max_verts=8);
+        mc.shape_param.set(['A','B'], vertices=[(-0.4,-0.4,-0.4), (-0.4,-0.4,0.4), (-0.4,0.4,-0.4), (-0.4,0.4,0.4),
+                                                (0.4,-0.4,-0.4), (0.4,-0.4,0.4), (0.4,0.4,-0.4), (0.4,0.4,0.4)]);
+
+        cl = hpmc.update.clusters(mc=mc, seed=456);
+        cl.set_params(move_ratio=0);
+        run(100);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertEqual(cl.cpp_updater.getCounters(1).pivot_count, 0);
+        self.assertGreater(self.displaced(), 0);
+
+        del cl
+        del mc
+
+    def test_tetrahedra(self):
+        # tetrahedra are not symmetric under inversion, pivot moves would create overlaps
+        mc = hpmc.integrate.convex_polyhedron(seed=123, d=0.1, a=0.1, max_verts=4);
+        mc.shape_param.set(['A','B'], vertices=[(0.3,0.3,0.3), (0.3,-0.3,-0.3), (-0.3,0.3,-0.3), (-0.3,-0.3,0.3)]);
+        self.assertEqual(mc.count_overlaps(), 0);
+
+        cl = hpmc.update.clusters(mc=mc, seed=456);
+        self.assertEqual(cl.move_ratio, 0);
+        self.assertEqual(cl.cpp_updater.getMoveRatio(), 0);
+        run(200);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        counters = cl.cpp_updater.getCounters(1);
+        self.assertEqual(counters.pivot_count, 0);
+        self.assertEqual(counters.rotation_count, 200);
+        self.assertGreater(self.displaced(), 0);
+
+        del cl
+        del mc
+
+    def test_default_move_ratio(self):
+        mc = hpmc.integrate.ellipsoid(seed=123);
+        mc.shape_param.set(['A','B'], a=0.5, b=0.4, c=0.3);
+
+        cl = hpmc.update.clusters(mc=mc, seed=456);
+        self.assertAlmostEqual(cl.move_ratio, 0.5);
+        self.assertAlmostEqual(cl.cpp_updater.getMoveRatio(), 0.5);
+
+        del cl
+        del mc
+
+    def test_params(self):
+        mc = hpmc.integrate.sphere(seed=123);
+        mc.shape_param.set(['A','B'], diameter=1.0);
+
+        cl = hpmc.update.clusters(mc=mc, seed=456, period=10);
+        cl.set_params(move_ratio=0.25);
+        self.assertAlmostEqual(cl.move_ratio, 0.25);
+        self.assertRaises(RuntimeError, cl.set_params, move_ratio=1.5);
+
+        del cl
+        del mc
+
+    def test_implicit(self):
+        mc = hpmc.integrate.sphere(seed=123, implicit=True);
+        mc.shape_param.set(['A','B'], diameter=1.0);
+        self.assertRaises(RuntimeError, hpmc.update.clusters, mc=mc, seed=456);
+
+        del mc
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
+class clusters_2d(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sq(a=1.1), n=10);
+
+    def test_convex_polygon(self):
+        mc = hpmc.integrate.convex_polygon(seed=123, d=0.1, a=0.1);
+        mc.shape_param.set('A', vertices=[(-0.5,-0.25), (0.5,-0.25), (0,0.5)]);
+
+        cl = hpmc.update.clusters(mc=mc, seed=456);
+        run(100);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertEqual(cl.cpp_updater.getCounters(1).rotation_count, 100);
+
+        del cl
+        del mc
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
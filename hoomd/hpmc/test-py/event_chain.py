@@ -0,0 +1,66 @@
+from __future__ import division, print_function
+from hoomd import *
+from hoomd import hpmc
+import hoomd
+import unittest
+import os
+
+context.initialize()
+
+# Test that event chains move the particles without producing overlaps
+class event_chain(unittest.TestCase):
+    def setUp(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=8);
+        self.pos_start = [p.position for p in self.system.particles];
+
+    def displaced(self):
+        return sum(1 for p,r in zip(self.system.particles, self.pos_start) if p.position != r);
+
+    def test_sphere(self):
+        mc = hpmc.integrate.sphere(seed=123, d=0.5, event_chain=True);
+        mc.shape_param.set('A', diameter=1.0);
+        mc.set_params(chain_length=2.0);
+        self.assertAlmostEqual(mc.cpp_integrator.getChainLength(), 2.0);
+
+        log = analyze.log(filename=None, quantities=['hpmc_chain_collisions', 'hpmc_chain_collision_fraction'], period=1);
+        run(50);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertAlmostEqual(mc.get_translate_acceptance(), 1.0);
+        self.assertGreater(mc.get_chain_collisions(), 0);
+        self.assertGreater(log.query('hpmc_chain_collisions'), 0);
+        self.assertGreater(log.query('hpmc_chain_collision_fraction'), 0);
+        self.assertLessEqual(log.query('hpmc_chain_collision_fraction'), 1);
+        self.assertGreater(self.displaced(), 0);
+
+        del log
+        del mc
+
+    def test_convex_polyhedron(self):
+        mc = hpmc.integrate.convex_polyhedron(seed=456, d=0.3, a=0.1, max_verts=8, event_chain=True);
+        mc.shape_param.set('A', vertices=[(-0.5,-0.5,-0.5), (-0.5,-0.5,0.5), (-0.5,0.5,-0.5), (-0.5,0.5,0.5),
+                                          (0.5,-0.5,-0.5), (0.5,-0.5,0.5), (0.5,0.5,-0.5), (0.5,0.5,0.5)]);
+
+        run(50);
+
+        self.assertEqual(mc.count_overlaps(), 0);
+        self.assertAlmostEqual(mc.get_translate_acceptance(), 1.0);
+        self.assertGreater(mc.get_chain_collisions(), 0);
+        self.assertGreater(mc.get_rotate_acceptance(), 0);
+        self.assertGreater(self.displaced(), 0);
+
+        del mc
+
+    def test_chain_length(self):
+        mc = hpmc.integrate.sphere(seed=123, event_chain=True);
+        mc.shape_param.set('A', diameter=1.0);
+        self.assertRaises(RuntimeError, mc.set_params, chain_length=0.0);
+
+        del mc
+
+    def tearDown(self):
+        del self.system
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
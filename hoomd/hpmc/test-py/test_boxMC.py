@@ -77,6 +77,27 @@ class boxMC_sanity_checks (unittest.TestCase):
         del self.snapshot
         context.initialize()
 
+    # This test performs shear moves large enough to trigger the lattice reduction many times
+    # and checks that the particles are redistributed without losses or overlaps.
+    def test_lattice_reduction(self):
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.2), n=4)
+        self.mc = hpmc.integrate.sphere(seed=1, d=0.1)
+        self.mc.shape_param.set('A', diameter=1.0)
+        self.boxMC = hpmc.update.boxmc(self.mc, betaP=1, seed=1)
+        self.boxMC.shear(delta=(0.5,0.5,0.5), weight=1, reduce=0.6)
+
+        run(0)
+        self.assertEqual(self.mc.count_overlaps(), 0)
+        run(200)
+        self.assertGreater(self.boxMC.get_shear_acceptance(), 0)
+        self.assertEqual(len(self.system.particles), 64)
+        self.assertEqual(self.mc.count_overlaps(), 0)
+
+        del self.boxMC
+        del self.mc
+        del self.system
+        context.initialize()
+
     # This test runs a single-particle NPT system to test whether NPT allows the box to invert.
     def test_VolumeMove_box_inversion(self):
         for i in range(5):
@@ -101,3 +101,52 @@ UP_TEST( bigger )
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST( refit )
+    {
+    const unsigned int N = 1000;
+    Saru rng(2);
+
+    // build a test AABB tree big enough to exercise the node splitting
+    std::vector< vec3<Scalar> > points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(rng.f(), rng.f(), rng.f()) * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    Scalar build_cost = tree.getSAHCost();
+    UP_ASSERT(build_cost > Scalar(0.0));
+
+    // refitting to the same AABBs does not change the cost (buildTree reorders the list, so regenerate it)
+    for (unsigned int i = 0; i < N; i++)
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+    tree.refit(aabbs, N);
+    MY_CHECK_CLOSE(tree.getSAHCost(), build_cost, tol);
+
+    // move all the points and refit, every particle must still be found
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(rng.f(), rng.f(), rng.f()) * Scalar(10);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    tree.refit(aabbs, N);
+
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    // the stretched tree is worse than a fresh build
+    Scalar refit_cost = tree.getSAHCost();
+    for (unsigned int i = 0; i < N; i++)
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+    tree.buildTree(aabbs, N);
+    UP_ASSERT(refit_cost > tree.getSAHCost());
+    }
@@ -625,3 +625,109 @@ UP_TEST( overlap_cube_rot3 )
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
 
     }
+
+UP_TEST( sweep_distance_cubes )
+    {
+    quat<Scalar> o;
+
+    // unit cubes
+    vector< vec3<OverlapReal> > vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,-0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,0.5,0.5));
+    poly3d_verts<max_verts> verts = setup_verts(vlist);
+
+    ShapeConvexPolyhedron<max_verts> a(o, verts);
+    ShapeConvexPolyhedron<max_verts> b(o, verts);
+    vec3<Scalar> e(1,0,0);
+
+    // face to face, head on and with the faces partially overlapping
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), e, a, b, err_count), 2.0, tol_small);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0.5,-0.3), e, a, b, err_count), 2.0, tol_small);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(0,0,-4), vec3<Scalar>(0,0,-1), a, b, err_count), 3.0, tol_small);
+
+    // a passes by b
+    UP_ASSERT(sweep_distance(vec3<Scalar>(3,1.2,0), e, a, b, err_count) < 0);
+
+    // b is behind a
+    UP_ASSERT(sweep_distance(vec3<Scalar>(-3,0,0), e, a, b, err_count) < 0);
+
+    // overlapping cubes cannot move
+    MY_CHECK_SMALL(sweep_distance(vec3<Scalar>(0.5,0,0), e, a, b, err_count), tol_small);
+
+    // an edge of b rotated by 45 degrees about z hits the face of a: s = 3 - 1/2 - sqrt(2)/2
+    quat<Scalar> q_z = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), M_PI/4);
+    ShapeConvexPolyhedron<max_verts> c(q_z, verts);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), e, a, c, err_count), 2.5 - sqrt(0.5), tol_small);
+
+    // the same with the rotated cube moving, the result does not depend on the frame of a
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), e, c, a, err_count), 2.5 - sqrt(0.5), tol_small);
+
+    // a vertex of b rotated about z and y points towards a: s = 3 - 1/2 - sqrt(3)/2
+    quat<Scalar> q_diag = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,1,0), atan(sqrt(0.5))) * q_z;
+    ShapeConvexPolyhedron<max_verts> d(q_diag, verts);
+    vec3<Scalar> tip = rotate(q_diag, vec3<Scalar>(-0.5,0.5,-0.5));
+    vec3<Scalar> r_ad(3,-tip.y,-tip.z);
+    Scalar s = sweep_distance(r_ad, e, a, d, err_count);
+    MY_CHECK_CLOSE(tip.x, -sqrt(0.75), tol_small);
+    MY_CHECK_CLOSE(s, 2.5 - sqrt(0.75), tol_small);
+
+    // no overlap just before the collision distance, and overlap just beyond it
+    UP_ASSERT(!test_overlap(r_ad - (s - 1e-3)*e, a, d, err_count));
+    UP_ASSERT(test_overlap(r_ad - (s + 1e-2)*e, a, d, err_count));
+
+    UP_ASSERT_EQUAL(err_count, 0);
+    }
+
+UP_TEST( sweep_distance_octahedron_cube )
+    {
+    quat<Scalar> o;
+
+    // octahedron |x| + |y| + |z| <= 1
+    vector< vec3<OverlapReal> > vlist_a;
+    vlist_a.push_back(vec3<OverlapReal>(1,0,0));
+    vlist_a.push_back(vec3<OverlapReal>(-1,0,0));
+    vlist_a.push_back(vec3<OverlapReal>(0,1,0));
+    vlist_a.push_back(vec3<OverlapReal>(0,-1,0));
+    vlist_a.push_back(vec3<OverlapReal>(0,0,1));
+    vlist_a.push_back(vec3<OverlapReal>(0,0,-1));
+    poly3d_verts<max_verts> verts_a = setup_verts(vlist_a);
+
+    // unit cube
+    vector< vec3<OverlapReal> > vlist_b;
+    vlist_b.push_back(vec3<OverlapReal>(-0.5,-0.5,-0.5));
+    vlist_b.push_back(vec3<OverlapReal>(-0.5,-0.5,0.5));
+    vlist_b.push_back(vec3<OverlapReal>(-0.5,0.5,-0.5));
+    vlist_b.push_back(vec3<OverlapReal>(-0.5,0.5,0.5));
+    vlist_b.push_back(vec3<OverlapReal>(0.5,-0.5,-0.5));
+    vlist_b.push_back(vec3<OverlapReal>(0.5,-0.5,0.5));
+    vlist_b.push_back(vec3<OverlapReal>(0.5,0.5,-0.5));
+    vlist_b.push_back(vec3<OverlapReal>(0.5,0.5,0.5));
+    poly3d_verts<max_verts> verts_b = setup_verts(vlist_b);
+
+    ShapeConvexPolyhedron<max_verts> a(o, verts_a);
+    ShapeConvexPolyhedron<max_verts> b(o, verts_b);
+    vec3<Scalar> e(1,0,0);
+
+    // the tip of the octahedron hits the center of a face
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(4,0,0), e, a, b, err_count), 2.5, tol_small);
+
+    // the face of the octahedron hits the lower edge of the cube at y = 0.4: s = 3.5 - (1 - 0.4)
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(4,0.9,0), e, a, b, err_count), 2.9, tol_small);
+
+    // the edge of the octahedron hits the corner of the cube at y = z = 0.3: s = 3.5 - (1 - 0.6)
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(4,0.8,0.8), e, a, b, err_count), 3.1, tol_small);
+
+    // the cube moving towards the octahedron sees the same distances
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(4,-0.9,0), e, b, a, err_count), 2.9, tol_small);
+
+    // a passes by b
+    UP_ASSERT(sweep_distance(vec3<Scalar>(4,1.6,0), e, a, b, err_count) < 0);
+
+    UP_ASSERT_EQUAL(err_count, 0);
+    }
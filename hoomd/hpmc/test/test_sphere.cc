@@ -107,3 +107,45 @@ UP_TEST( overlap_boundaries )
     UP_ASSERT(test_overlap(rij,a,c,err_count));
     UP_ASSERT(test_overlap(-rij,c,a,err_count));
     }
+
+UP_TEST( sweep_distance_analytic )
+    {
+    // parameters
+    quat<Scalar> o;
+    sph_params par;
+    par.radius = 0.5;
+    par.ignore = 0;
+    ShapeSphere a(o, par);
+    ShapeSphere b(o, par);
+    vec3<Scalar> e(1,0,0);
+
+    // head on collision: the spheres touch after moving |r_ab| - (R_a + R_b)
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,0), e, a, b, err_count), 2.0, tol_small);
+
+    // off center collision: s = r_ab.e - sqrt((R_a + R_b)^2 - h^2) with impact parameter h
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0.6,0), e, a, b, err_count), 3.0 - 0.8, tol_small);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3,0,-0.6), e, a, b, err_count), 3.0 - 0.8, tol_small);
+
+    // a passes by b
+    UP_ASSERT(sweep_distance(vec3<Scalar>(3,1.1,0), e, a, b, err_count) < 0);
+
+    // b is behind a
+    UP_ASSERT(sweep_distance(vec3<Scalar>(-3,0,0), e, a, b, err_count) < 0);
+
+    // spheres in contact cannot move towards each other
+    UP_ASSERT_EQUAL(sweep_distance(vec3<Scalar>(0.9,0,0), e, a, b, err_count), 0);
+
+    // different radii and a different direction
+    par.radius = 0.25;
+    ShapeSphere c(o, par);
+    par.radius = 1.0;
+    ShapeSphere d(o, par);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(0,0,5), vec3<Scalar>(0,0,1), c, d, err_count), 5.0 - 1.25, tol_small);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(0,5,-0.75), vec3<Scalar>(0,1,0), d, c, err_count),
+                   5.0 - sqrt(1.25*1.25 - 0.75*0.75), tol_small);
+
+    // after the move, the spheres touch
+    vec3<Scalar> r_ab(2.5,0.3,-0.4);
+    Scalar s = sweep_distance(r_ab, e, a, b, err_count);
+    MY_CHECK_CLOSE(sqrt(dot(r_ab - s*e, r_ab - s*e)), 1.0, tol_small);
+    }
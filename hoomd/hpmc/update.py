@@ -653,6 +653,142 @@ class muvt(_updater):
         if transfer_ratio is not None:
             self.cpp_updater.setTransferRatio(float(transfer_ratio))
 
+class clusters(_updater):
+    R""" Move clusters of particles with the geometric cluster algorithm.
+
+    Args:
+        mc (:py:mod:`hoomd.hpmc.integrate`): MC integrator.
+        seed (int): The seed of the pseudo-random number generator
+        period (int): Number of timesteps between cluster moves.
+
+    The geometric cluster algorithm (J. Liu and E. Luijten, Phys. Rev. Lett. 92, 035504 (2004)) moves clusters of
+    particles without rejections. Each cluster move picks a random transformation and a random particle, and
+    transforms it. Every particle that overlaps with a transformed particle is added to the cluster and transformed
+    as well. The transformations are:
+
+    * **pivot moves**, which reflect the particle positions through a random point and keep the orientations. They
+      are only valid for shapes that are symmetric under inversion (e.g. spheres, ellipsoids, cubes). Pivot moves are
+      enabled by default only for :py:class:`hoomd.hpmc.integrate.sphere` and
+      :py:class:`hoomd.hpmc.integrate.ellipsoid`. For other shapes, *move_ratio* defaults to 0, and setting it to a
+      positive value is only valid when every shape is symmetric under inversion (e.g. cubes, but not tetrahedra).
+    * **rotation moves**, which rotate the particles by :math:`\pi` around a line through a random point. The line is
+      parallel to the z axis, or in an orthorhombic 3D box, to the x, y or z axis. In 3D, rotation moves are skipped
+      when the box tilt factors *xz* or *yz* are not zero.
+
+    In 2D, only rotation moves are performed. Pairs of types that do not overlap according to
+    :py:class:`hoomd.hpmc.integrate.interaction_matrix` are never linked into a cluster. Cluster moves decorrelate
+    size-asymmetric mixtures and colloids with explicit depletants much faster than local moves.
+
+    One cluster move is performed every *period* steps.
+
+    Note:
+        :py:class:`clusters` does not support MPI domain decomposition, implicit depletants or external fields.
+
+    Example::
+
+        mc = hpmc.integrate.sphere(seed=415236)
+        mc.shape_param.set('A', diameter=1.0)
+        mc.shape_param.set('B', diameter=0.1)
+        hpmc.update.clusters(mc=mc, seed=123)
+
+    """
+    def __init__(self, mc, seed, period=1):
+        hoomd.util.print_status_line();
+
+        if not isinstance(mc, integrate.mode_hpmc):
+            hoomd.context.msg.warning("update.clusters: Must have a handle to an HPMC integrator.\n");
+            return;
+
+        if mc.implicit:
+            hoomd.context.msg.error("update.clusters: Implicit depletants are not supported.\n");
+            raise RuntimeError("Error initializing update.clusters");
+
+        # initialize base class
+        _updater.__init__(self);
+
+        cls = None;
+        if isinstance(mc, integrate.sphere):
+            cls = _hpmc.UpdaterClustersSphere;
+        elif isinstance(mc, integrate.convex_polygon):
+            cls = _hpmc.UpdaterClustersConvexPolygon;
+        elif isinstance(mc, integrate.simple_polygon):
+            cls = _hpmc.UpdaterClustersSimplePolygon;
+        elif isinstance(mc, integrate.convex_polyhedron):
+            cls = integrate._get_sized_entry('UpdaterClustersConvexPolyhedron', mc.max_verts);
+        elif isinstance(mc, integrate.convex_spheropolyhedron):
+            cls = integrate._get_sized_entry('UpdaterClustersSpheropolyhedron', mc.max_verts);
+        elif isinstance(mc, integrate.ellipsoid):
+            cls = _hpmc.UpdaterClustersEllipsoid;
+        elif isinstance(mc, integrate.convex_spheropolygon):
+            cls =_hpmc.UpdaterClustersSpheropolygon;
+        elif isinstance(mc, integrate.faceted_sphere):
+            cls =_hpmc.UpdaterClustersFacetedSphere;
+        elif isinstance(mc, integrate.sphere_union):
+            cls =_hpmc.UpdaterClustersSphereUnion;
+        elif isinstance(mc, integrate.polyhedron):
+            cls =_hpmc.UpdaterClustersPolyhedron;
+        else:
+            hoomd.context.msg.error("update.clusters: Unsupported integrator.\n");
+            raise RuntimeError("Error initializing update.clusters");
+
+        self.cpp_updater = cls(hoomd.context.current.system_definition,
+                               mc.cpp_integrator,
+                               int(seed));
+
+        self.setupUpdater(period);
+
+        self.mc = mc;
+        self.seed = seed;
+
+        # pivot moves keep the orientations, which is only valid for shapes that are symmetric under inversion
+        self.pivot_safe = isinstance(mc, (integrate.sphere, integrate.ellipsoid));
+        self.move_ratio = 0.5 if self.pivot_safe else 0.0;
+        self.cpp_updater.setMoveRatio(self.move_ratio);
+
+        self.metadata_fields = ['seed', 'move_ratio'];
+
+    def set_params(self, move_ratio=None):
+        R""" Set cluster move parameters.
+
+        Args:
+            move_ratio (float): (if set) Set the fraction of pivot moves among all cluster moves in 3D
+
+        Warning:
+            Pivot moves keep the particle orientations. Only set *move_ratio* to a positive value for shapes other
+            than spheres and ellipsoids when every shape is symmetric under inversion, otherwise the cluster moves
+            create overlaps.
+
+        Example::
+
+            cl = hpmc.update.clusters(mc, seed=123)
+            cl.set_params(move_ratio=0)
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        if move_ratio is not None:
+            if move_ratio > 0 and not self.pivot_safe:
+                hoomd.context.msg.warning("update.clusters: Pivot moves are only valid for shapes that are symmetric under inversion.\n");
+            self.cpp_updater.setMoveRatio(float(move_ratio));
+            self.move_ratio = float(move_ratio);
+
+    def get_average_cluster_size(self):
+        R""" Get the average number of particles moved in one cluster move.
+
+        Returns:
+            The average cluster size in the last run
+
+        Example::
+
+            cl = hpmc.update.clusters(mc, seed=123)
+            run(100)
+            size = cl.get_average_cluster_size()
+
+        """
+        counters = self.cpp_updater.getCounters(1);
+        return counters.getAverageClusterSize();
+
 class remove_drift(_updater):
     R""" Remove the center of mass drift from a system restrained on a lattice.
 
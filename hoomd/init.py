@@ -253,7 +253,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, checkpoint = None):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -261,6 +261,8 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        checkpoint (str): If it exists, restore the state stored in the checkpoint *checkpoint* (written by
+                          :py:class:`hoomd.dump.checkpoint`) after reading the GSD file.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -272,11 +274,18 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     If *time_step* is specified, its value will be used as the initial time
     step of the simulation instead of the one read from the GSD file.
 
+    For restarts that continue a simulation exactly, specify the checkpoint written by :py:class:`hoomd.dump.checkpoint`
+    in *checkpoint*. The GSD file still provides the types, bonds, and other topology, and then the particles, box,
+    time step, and integrator variables are overwritten with the values stored in the checkpoint. The state of the
+    integration methods is restored at the first :py:func:`hoomd.run()`. The job script must set up the same forces
+    and integration methods as the one that wrote the checkpoint, and run on the same number of ranks. *time_step*
+    is ignored when a checkpoint is restored.
+
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
     See Also:
-        :py:class:`hoomd.dump.gsd`
+        :py:class:`hoomd.dump.gsd`, :py:class:`hoomd.dump.checkpoint`
     """
     hoomd.util.print_status_line();
 
@@ -295,6 +304,11 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     if time_step is None:
         time_step = reader.getTimeStep();
 
+    checkpoint_reader = None;
+    if checkpoint is not None and _hoomd.CheckpointReader.exists(hoomd.context.exec_conf, checkpoint):
+        checkpoint_reader = _hoomd.CheckpointReader(hoomd.context.exec_conf, checkpoint);
+        time_step = checkpoint_reader.getTimeStep();
+
     # broadcast snapshot metadata so that all ranks have _global_box (the user may have set box only on rank 0)
     snapshot._broadcast(hoomd.context.exec_conf);
     my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
@@ -308,6 +322,11 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, time_step);
 
     _perform_common_init_tasks();
+
+    if checkpoint_reader is not None:
+        checkpoint_reader.restoreSystem(hoomd.context.current.system_definition);
+        hoomd.context.current.checkpoint_reader = checkpoint_reader;
+
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
 def restore_getar(filename, modes={'any': 'any'}):
@@ -11,6 +11,10 @@ namespace py = pybind11;
 
 #include <stdexcept>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 /*! \file BondTablePotential.cc
     \brief Defines the BondTablePotential class
 */
@@ -143,8 +147,66 @@ Scalar BondTablePotential::getLogValue(const std::string& quantity, unsigned int
         }
     }
 
+/*! \param dx Vector from particle a to particle b
+    \param h_tables Tabulated potential and force of all bond types
+    \param table_value Indexer into the tables
+    \param params rmin, rmax and delta_r of the table of this bond type
+    \param type Type of the bond
+    \param force_divr Set to the magnitude of the force divided by r
+    \param bond_eng Set to the energy of each member, 1/2 of the bond energy
+    \returns false if the bond length is outside of the table
+*/
+static inline bool eval_table_bond(const Scalar3& dx, const Scalar2 *h_tables, const Index2D& table_value,
+    const Scalar4& params, unsigned int type, Scalar& force_divr, Scalar& bond_eng)
+    {
+    // access needed parameters
+    Scalar rmin = params.x;
+    Scalar rmax = params.y;
+    Scalar delta_r = params.z;
+
+    // start computing the force
+    Scalar rsq = dot(dx,dx);
+    Scalar r = sqrt(rsq);
+
+    // only compute the force if the particles are within the region defined by V
+    if (!(r < rmax && r >= rmin))
+        return false;
+
+    // precomputed term
+    Scalar value_f = (r - rmin) / delta_r;
+
+    // compute index into the table and read in values
+
+    /// Here we use the table!!
+    unsigned int value_i = (unsigned int)floor(value_f);
+    Scalar2 VF0 = h_tables[table_value(value_i, type)];
+    Scalar2 VF1 = h_tables[table_value(value_i+1, type)];
+    // unpack the data
+    Scalar V0 = VF0.x;
+    Scalar V1 = VF1.x;
+    Scalar F0 = VF0.y;
+    Scalar F1 = VF1.y;
+
+    // compute the linear interpolation coefficient
+    Scalar f = value_f - Scalar(value_i);
+
+    // interpolate to get V and F;
+    Scalar V = V0 + f * (V1 - V0);
+    Scalar F = F0 + f * (F1 - F0);
+
+    // convert to standard variables used by the other pair computes in HOOMD-blue
+    force_divr = Scalar(0.0);
+    if (r > Scalar(0.0))
+        force_divr = F / r;
+    bond_eng = Scalar(0.5) * V;
+    return true;
+    }
+
 /*! \post The table based forces are computed for the given timestep.
 \param timestep specifies the current time step of the simulation
+
+With more than one OpenMP thread, every local particle gathers the bonds it is part of from the per-particle table of
+the BondData (as on the GPU), so that the threads never write to the same particle.
 */
 void BondTablePotential::computeForces(unsigned int timestep)
     {
@@ -176,6 +238,74 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    if (n_threads > 1)
+        {
+        // the table is rebuilt on access if needed, and reports incomplete bonds
+        ArrayHandle<BondData::members_t> h_table(m_bond_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_table_pos(m_bond_data->getGPUPosTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_bonds(m_bond_data->getNGroupsArray(), access_location::host, access_mode::read);
+        const Index2D& table_indexer = m_bond_data->getGPUTableIndexer();
+
+        unsigned int n_out_of_bounds = 0;
+
+        #pragma omp parallel for schedule(static) reduction(+:n_out_of_bounds)
+        for (int idx = 0; idx < (int)m_pdata->getN(); idx++)
+            {
+            for (unsigned int k = 0; k < h_n_bonds.data[idx]; k++)
+                {
+                const BondData::members_t& entry = h_table.data[table_indexer(idx, k)];
+                unsigned int cur_pos = h_table_pos.data[table_indexer(idx, k)];
+
+                unsigned int member_idx[2];
+                get_group_members<2>(entry, cur_pos, idx, member_idx);
+
+                Scalar4 postype_a = h_pos.data[member_idx[0]];
+                Scalar4 postype_b = h_pos.data[member_idx[1]];
+                Scalar3 dx = make_scalar3(postype_b.x - postype_a.x,
+                                          postype_b.y - postype_a.y,
+                                          postype_b.z - postype_a.z);
+                dx = box.minImage(dx);
+
+                unsigned int type = entry.idx[1];
+                Scalar force_divr, bond_eng;
+                if (!eval_table_bond(dx, h_tables.data, m_table_value, h_params.data[type], type, force_divr, bond_eng))
+                    {
+                    n_out_of_bounds++;
+                    continue;
+                    }
+
+                // the force on b is along dx, the force on a opposite to it
+                Scalar sign = (cur_pos == 0) ? Scalar(-1.0) : Scalar(1.0);
+                h_force.data[idx].x += sign * force_divr * dx.x;
+                h_force.data[idx].y += sign * force_divr * dx.y;
+                h_force.data[idx].z += sign * force_divr * dx.z;
+                h_force.data[idx].w += bond_eng;
+
+                Scalar force_div2r = Scalar(0.5) * force_divr;
+                h_virial.data[0*m_virial_pitch+idx] += dx.x * dx.x * force_div2r; // xx
+                h_virial.data[1*m_virial_pitch+idx] += dx.x * dx.y * force_div2r; // xy
+                h_virial.data[2*m_virial_pitch+idx] += dx.x * dx.z * force_div2r; // xz
+                h_virial.data[3*m_virial_pitch+idx] += dx.y * dx.y * force_div2r; // yy
+                h_virial.data[4*m_virial_pitch+idx] += dx.y * dx.z * force_div2r; // yz
+                h_virial.data[5*m_virial_pitch+idx] += dx.z * dx.z * force_div2r; // zz
+                }
+            }
+
+        if (n_out_of_bounds)
+            {
+            m_exec_conf->msg->error() << "Table bond out of bounds" << endl;
+            throw std::runtime_error("Error in bond calculation");
+            }
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -210,82 +340,39 @@ void BondTablePotential::computeForces(unsigned int timestep)
         // apply periodic boundary conditions
         dx = box.minImage(dx);
 
-        // access needed parameters
         unsigned int type = m_bond_data->getTypeByIndex(i);
-        Scalar4 params = h_params.data[type];
-        Scalar rmin = params.x;
-        Scalar rmax = params.y;
-        Scalar delta_r = params.z;
-
-        // start computing the force
-        Scalar rsq = dot(dx,dx);
-        Scalar r = sqrt(rsq);
-
-        // only compute the force if the particles are within the region defined by V
-
-        if (r < rmax && r >= rmin)
-            {
-            // precomputed term
-            Scalar value_f = (r - rmin) / delta_r;
-
-            // compute index into the table and read in values
-
-            /// Here we use the table!!
-            unsigned int value_i = (unsigned int)floor(value_f);
-            Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
-            Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
-            Scalar f = value_f - Scalar(value_i);
-
-            // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
-
-            // convert to standard variables used by the other pair computes in HOOMD-blue
-            Scalar force_divr = Scalar(0.0);
-            if (r > Scalar(0.0))
-                force_divr = F / r;
-            Scalar bond_eng = Scalar(0.5) * V;
-
-            // compute the virial
-            Scalar bond_virial[6];
-            Scalar force_div2r = Scalar(0.5) * force_divr;
-            bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-            bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-            bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-            bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-            bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-            bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-
-            // add the force to the particles
-            // (MEM TRANSFER: 20 Scalars / FLOPS 16)
-            h_force.data[idx_b].x += force_divr * dx.x;
-            h_force.data[idx_b].y += force_divr * dx.y;
-            h_force.data[idx_b].z += force_divr * dx.z;
-            h_force.data[idx_b].w += bond_eng;
-            for (unsigned int i = 0; i < 6; i++)
-                h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
-
-            h_force.data[idx_a].x -= force_divr * dx.x;
-            h_force.data[idx_a].y -= force_divr * dx.y;
-            h_force.data[idx_a].z -= force_divr * dx.z;
-            h_force.data[idx_a].w += bond_eng;
-            for (unsigned int i = 0; i < 6; i++)
-                h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
-
-            }
-        else
+        Scalar force_divr, bond_eng;
+        if (!eval_table_bond(dx, h_tables.data, m_table_value, h_params.data[type], type, force_divr, bond_eng))
             {
             m_exec_conf->msg->error() << "Table bond out of bounds" << endl;
             throw std::runtime_error("Error in bond calculation");
             }
 
+        // compute the virial
+        Scalar bond_virial[6];
+        Scalar force_div2r = Scalar(0.5) * force_divr;
+        bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+        bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+        bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+        bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+        bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+        bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+
+        // add the force to the particles
+        // (MEM TRANSFER: 20 Scalars / FLOPS 16)
+        h_force.data[idx_b].x += force_divr * dx.x;
+        h_force.data[idx_b].y += force_divr * dx.y;
+        h_force.data[idx_b].z += force_divr * dx.z;
+        h_force.data[idx_b].w += bond_eng;
+        for (unsigned int i = 0; i < 6; i++)
+            h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
+
+        h_force.data[idx_a].x -= force_divr * dx.x;
+        h_force.data[idx_a].y -= force_divr * dx.y;
+        h_force.data[idx_a].z -= force_divr * dx.z;
+        h_force.data[idx_a].w += bond_eng;
+        for (unsigned int i = 0; i < 6; i++)
+            h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
         }
     if (m_prof) m_prof->pop();
     }
@@ -0,0 +1,86 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "CGEnergyMinimizer.h"
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file CGEnergyMinimizer.cc
+    \brief Contains code for the CGEnergyMinimizer class
+*/
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param group The group of particles to minimize the energy of
+    \param max_step Maximum displacement of a particle in one line search
+
+    The line search of the conjugate gradient method needs to locate the minimum more accurately than that of
+    quasi-Newton methods, so the curvature parameter is set to 0.4.
+*/
+CGEnergyMinimizer::CGEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef,
+                                     std::shared_ptr<ParticleGroup> group,
+                                     Scalar max_step)
+    : LineSearchEnergyMinimizer(sysdef, group, max_step, Scalar(0.4))
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CGEnergyMinimizer" << endl;
+    }
+
+CGEnergyMinimizer::~CGEnergyMinimizer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CGEnergyMinimizer" << endl;
+    }
+
+/*! \param alpha Step from the start of the previous search to the current point
+*/
+void CGEnergyMinimizer::computeDirection(Scalar alpha)
+    {
+    unsigned int group_size = m_group->getNumMembers();
+
+    ArrayHandle<Scalar3> h_g(m_g, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_g0(m_g0, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+
+    // g.(g - g_old) and g_old.g_old
+    double sums[2];
+    sums[0] = 0.0;
+    sums[1] = 0.0;
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        Scalar3 g = h_g.data[j];
+        Scalar3 g0 = h_g0.data[j];
+        sums[0] += g.x*(g.x - g0.x) + g.y*(g.y - g0.y) + g.z*(g.z - g0.z);
+        sums[1] += g0.x*g0.x + g0.y*g0.y + g0.z*g0.z;
+        }
+    reduceSum(sums, 2);
+
+    Scalar beta = Scalar(0.0);
+    if (sums[1] > 0.0)
+        beta = std::max(Scalar(sums[0]/sums[1]), Scalar(0.0));
+
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        h_d.data[j] = beta*h_d.data[j] - h_g.data[j];
+        }
+    }
+
+/*! \param dE0 Slope of the energy along the new direction
+    \returns The step that gives the same first order change of the energy as the previous accepted step
+*/
+Scalar CGEnergyMinimizer::getInitialStep(Scalar dE0)
+    {
+    if (!(m_alpha_prev > Scalar(0.0)) || !(dE0 < Scalar(0.0)))
+        return Scalar(0.0);
+    return m_alpha_prev*m_dE0_prev/dE0;
+    }
+
+void export_CGEnergyMinimizer(py::module& m)
+    {
+    py::class_<CGEnergyMinimizer, std::shared_ptr<CGEnergyMinimizer> >(m, "CGEnergyMinimizer", py::base<LineSearchEnergyMinimizer>())
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<ParticleGroup>, Scalar >())
+        ;
+    }
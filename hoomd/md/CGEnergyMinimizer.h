@@ -0,0 +1,48 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "LineSearchEnergyMinimizer.h"
+
+#ifndef __CG_ENERGY_MINIMIZER_H__
+#define __CG_ENERGY_MINIMIZER_H__
+
+/*! \file CGEnergyMinimizer.h
+    \brief Declares the CGEnergyMinimizer class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Minimizes the energy with the nonlinear conjugate gradient method
+/*! The search direction is d = -g + beta d_old with the Polak-Ribiere parameter
+    beta = max(0, g.(g - g_old) / g_old.g_old), which restarts with the steepest descent whenever beta would be
+    negative. The first trial step of each line search assumes that the change of the energy to first order is the same
+    as in the previous search.
+
+    \ingroup updaters
+*/
+class CGEnergyMinimizer : public LineSearchEnergyMinimizer
+    {
+    public:
+        //! Constructs the minimizer and associates it with the system
+        CGEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef,
+                          std::shared_ptr<ParticleGroup> group,
+                          Scalar max_step);
+        virtual ~CGEnergyMinimizer();
+
+    protected:
+        //! Compute the conjugate search direction
+        virtual void computeDirection(Scalar alpha);
+
+        //! Get the first step to try along a new search direction
+        virtual Scalar getInitialStep(Scalar dE0);
+    };
+
+//! Exports the CGEnergyMinimizer class to python
+void export_CGEnergyMinimizer(pybind11::module& m);
+
+#endif // #ifndef __CG_ENERGY_MINIMIZER_H__
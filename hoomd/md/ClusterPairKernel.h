@@ -0,0 +1,433 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#ifndef __CLUSTER_PAIR_KERNEL_H__
+#define __CLUSTER_PAIR_KERNEL_H__
+
+#include "hoomd/HOOMDMath.h"
+#include "EvaluatorPairLJ.h"
+
+#include <stdint.h>
+#include <vector>
+
+#if (defined(__AVX2__) && !defined(SINGLE_PRECISION)) || (defined(__SSE4_1__) && defined(SINGLE_PRECISION))
+#include <immintrin.h>
+#endif
+
+/*! \file ClusterPairKernel.h
+    \brief Defines the vectorized kernels for the cluster pairs of NeighborListCluster
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Per-lane force, energy and virial sums of a cluster pair kernel
+/*! \tparam L Number of lanes
+
+    The kernels add the contribution of particle pair (a, b) of a cluster pair to lane a*M + b of the i cluster sums
+    and to lane b of the j cluster sums. Every lane is only updated by its own pair, so consecutive members of cluster
+    j map to consecutive lanes without any reduction inside the kernel.
+*/
+template<unsigned int L>
+struct ClusterPairSums
+    {
+    Scalar fx[L];           //!< x components of the force
+    Scalar fy[L];           //!< y components of the force
+    Scalar fz[L];           //!< z components of the force
+    Scalar e[L];            //!< Half of the pair energies
+    Scalar virial[6][L];    //!< Half of the pair virials
+
+    //! Set all sums to zero
+    void zero()
+        {
+        for (unsigned int k = 0; k < L; k++)
+            {
+            fx[k] = fy[k] = fz[k] = e[k] = Scalar(0.0);
+            for (unsigned int l = 0; l < 6; l++)
+                virial[l][k] = Scalar(0.0);
+            }
+        }
+    };
+
+#if defined(__AVX2__) && !defined(SINGLE_PRECISION)
+//! 4 SIMD lanes of Scalar for the cluster pair kernels (AVX2, double precision)
+struct ClusterPairLanes
+    {
+    typedef __m256d vec;    //!< Vector of 4 Scalars
+
+    static vec zero() { return _mm256_setzero_pd(); }
+    static vec set1(Scalar x) { return _mm256_set1_pd(x); }
+    static vec load(const Scalar *p) { return _mm256_loadu_pd(p); }
+    static void store(Scalar *p, vec a) { _mm256_storeu_pd(p, a); }
+    static vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+    static vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+    static vec mul(vec a, vec b) { return _mm256_mul_pd(a, b); }
+    static vec div(vec a, vec b) { return _mm256_div_pd(a, b); }
+    static vec lt(vec a, vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static vec bit_and(vec a, vec b) { return _mm256_and_pd(a, b); }
+
+    //! Lanes of the condition \a c are \a a, the other lanes are 0
+    static vec select(vec c, vec a) { return _mm256_and_pd(c, a); }
+
+    //! Set lane k to all ones if bit k of \a bits is set
+    static vec lane_mask(unsigned int bits)
+        {
+        const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+        return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits),
+                                                      lane_bits));
+        }
+
+    //! Load table[offset + idx[k]] into lane k
+    static vec gather(const Scalar *table, unsigned int offset, const unsigned int *idx)
+        {
+        __m128i i = _mm_add_epi32(_mm_set1_epi32(offset), _mm_loadu_si128((const __m128i *)idx));
+        return _mm256_i32gather_pd(table, i, 8);
+        }
+    };
+#elif defined(__SSE4_1__) && defined(SINGLE_PRECISION)
+//! 4 SIMD lanes of Scalar for the cluster pair kernels (SSE4.1, single precision)
+struct ClusterPairLanes
+    {
+    typedef __m128 vec;     //!< Vector of 4 Scalars
+
+    static vec zero() { return _mm_setzero_ps(); }
+    static vec set1(Scalar x) { return _mm_set1_ps(x); }
+    static vec load(const Scalar *p) { return _mm_loadu_ps(p); }
+    static void store(Scalar *p, vec a) { _mm_storeu_ps(p, a); }
+    static vec add(vec a, vec b) { return _mm_add_ps(a, b); }
+    static vec sub(vec a, vec b) { return _mm_sub_ps(a, b); }
+    static vec mul(vec a, vec b) { return _mm_mul_ps(a, b); }
+    static vec div(vec a, vec b) { return _mm_div_ps(a, b); }
+    static vec lt(vec a, vec b) { return _mm_cmplt_ps(a, b); }
+    static vec bit_and(vec a, vec b) { return _mm_and_ps(a, b); }
+
+    //! Lanes of the condition \a c are \a a, the other lanes are 0
+    static vec select(vec c, vec a) { return _mm_and_ps(c, a); }
+
+    //! Set lane k to all ones if bit k of \a bits is set
+    static vec lane_mask(unsigned int bits)
+        {
+        const __m128i lane_bits = _mm_set_epi32(8, 4, 2, 1);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits), lane_bits), lane_bits));
+        }
+
+    //! Load table[offset + idx[k]] into lane k
+    static vec gather(const Scalar *table, unsigned int offset, const unsigned int *idx)
+        {
+        return _mm_set_ps(table[offset + idx[3]], table[offset + idx[2]], table[offset + idx[1]],
+                          table[offset + idx[0]]);
+        }
+    };
+#endif
+
+//! Vectorized cluster pair kernel of an evaluator
+/*! PotentialPair::computeClusterPairs() evaluates the M*M particle pairs of a cluster pair with this kernel when
+    setup() returns true. The generic template has no kernel, and the particle pairs are evaluated one by one with
+    the evaluator instead. Evaluators that can be written without branches specialize this template (see the
+    specialization for EvaluatorPairLJ).
+
+    A specialization provides per type pair tables (Tables), setup() to fill them from the parameters of the
+    potential, and compute<M, compute_virial>() to evaluate a cluster pair. Masked pairs and pairs beyond the cutoff
+    must contribute exact zeros without branching on the individual pairs.
+
+    \tparam evaluator Pair evaluator
+*/
+template<class evaluator>
+struct ClusterPairKernel
+    {
+    //! Per type pair tables of the kernel
+    struct Tables
+        {
+        };
+
+    //! Fill the tables
+    /*! \returns false, there is no vectorized kernel for this evaluator
+    */
+    static bool setup(Tables& tables,
+                      const typename evaluator::param_type *params,
+                      const Scalar *rcutsq,
+                      unsigned int n_typpair,
+                      bool energy_shift)
+        {
+        return false;
+        }
+
+    //! Evaluate the particle pairs of a cluster pair
+    template<unsigned int M, bool compute_virial>
+    static void compute(const Tables& tables, uint64_t mask, unsigned int ntypes, const Scalar3& shift,
+                        const Scalar *xi, const Scalar *yi, const Scalar *zi, const unsigned int *typei,
+                        const Scalar *xj, const Scalar *yj, const Scalar *zj, const unsigned int *typej,
+                        ClusterPairSums<M*M>& sums_i, ClusterPairSums<M>& sums_j)
+        {
+        }
+    };
+
+//! Vectorized cluster pair kernel of the Lennard-Jones potential
+/*! The pairs that are not in the interaction mask or beyond the cutoff get 1/r^2 = 0 and no energy shift, so that
+    their force and energy vanish. Type pairs with lj1 = 0 are skipped by EvaluatorPairLJ, their cutoff is set to 0 in
+    the tables. The energy shift at the cutoff is tabulated.
+
+    When HOOMD is compiled with AVX2 (double precision) or SSE4.1 (single precision), the members of cluster j are
+    processed 4 at a time in SIMD lanes, as in select_cell_candidates() of NeighborListBinned. The mask and the cutoff
+    are applied as a lane mask, and the sums of the j members stay in registers over the members of cluster i.
+    Without these instruction sets, the same evaluation is written as a loop over the members of cluster j.
+*/
+template<>
+struct ClusterPairKernel<EvaluatorPairLJ>
+    {
+    //! Per type pair tables of the kernel
+    struct Tables
+        {
+        std::vector<Scalar> lj1;        //!< lj1 parameter
+        std::vector<Scalar> lj2;        //!< lj2 parameter
+        std::vector<Scalar> rcutsq;     //!< Squared cutoff, 0 for pairs that do not interact
+        std::vector<Scalar> ecut;       //!< Energy at the cutoff if the energy is shifted, 0 otherwise
+        };
+
+    //! Fill the tables
+    /*! \param tables Tables to fill
+        \param params Per type pair parameters
+        \param rcutsq Per type pair squared cutoffs
+        \param n_typpair Number of type pairs
+        \param energy_shift True if the energy is shifted to zero at the cutoff
+        \returns true
+    */
+    static bool setup(Tables& tables,
+                      const Scalar2 *params,
+                      const Scalar *rcutsq,
+                      unsigned int n_typpair,
+                      bool energy_shift)
+        {
+        tables.lj1.resize(n_typpair);
+        tables.lj2.resize(n_typpair);
+        tables.rcutsq.resize(n_typpair);
+        tables.ecut.resize(n_typpair);
+        for (unsigned int k = 0; k < n_typpair; k++)
+            {
+            tables.lj1[k] = params[k].x;
+            tables.lj2[k] = params[k].y;
+            tables.rcutsq[k] = (params[k].x != Scalar(0.0)) ? rcutsq[k] : Scalar(0.0);
+            tables.ecut[k] = Scalar(0.0);
+            if (energy_shift && rcutsq[k] > Scalar(0.0))
+                {
+                Scalar rcut2inv = Scalar(1.0) / rcutsq[k];
+                Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                tables.ecut[k] = rcut6inv * (params[k].x * rcut6inv - params[k].y);
+                }
+            }
+        return true;
+        }
+
+    //! Evaluate the particle pairs of a cluster pair
+    /*! \param tables Per type pair tables
+        \param mask Interaction mask of the cluster pair
+        \param ntypes Number of particle types
+        \param shift Shift of the periodic image of cluster j
+        \param xi x coordinates of the members of cluster i
+        \param yi y coordinates of the members of cluster i
+        \param zi z coordinates of the members of cluster i
+        \param typei Types of the members of cluster i
+        \param xj x coordinates of the members of cluster j
+        \param yj y coordinates of the members of cluster j
+        \param zj z coordinates of the members of cluster j
+        \param typej Types of the members of cluster j
+        \param sums_i Sums of the members of cluster i, lane a*M + b
+        \param sums_j Sums of the members of cluster j, lane b
+    */
+    template<unsigned int M, bool compute_virial>
+    static inline void compute(const Tables& tables, uint64_t mask, unsigned int ntypes, const Scalar3& shift,
+                               const Scalar * __restrict__ xi, const Scalar * __restrict__ yi,
+                               const Scalar * __restrict__ zi, const unsigned int * __restrict__ typei,
+                               const Scalar * __restrict__ xj, const Scalar * __restrict__ yj,
+                               const Scalar * __restrict__ zj, const unsigned int * __restrict__ typej,
+                               ClusterPairSums<M*M>& sums_i, ClusterPairSums<M>& sums_j)
+        {
+        const Scalar * __restrict__ lj1 = &tables.lj1[0];
+        const Scalar * __restrict__ lj2 = &tables.lj2[0];
+        const Scalar * __restrict__ rcutsq = &tables.rcutsq[0];
+        const Scalar * __restrict__ ecut = &tables.ecut[0];
+
+        #if (defined(__AVX2__) && !defined(SINGLE_PRECISION)) || (defined(__SSE4_1__) && defined(SINGLE_PRECISION))
+        typedef ClusterPairLanes V;
+        typedef ClusterPairLanes::vec vec;
+
+        // with a single type, the parameters are the same in all lanes
+        const vec lj1_single = V::set1(lj1[0]);
+        const vec lj2_single = V::set1(lj2[0]);
+        const vec rcutsq_single = V::set1(rcutsq[0]);
+        const vec ecut_single = V::set1(ecut[0]);
+        const vec half = V::set1(Scalar(0.5));
+        const vec one = V::set1(Scalar(1.0));
+        const vec six = V::set1(Scalar(6.0));
+        const vec twelve = V::set1(Scalar(12.0));
+
+        // NeighborListCluster only supports cluster sizes that are multiples of 4
+        for (unsigned int jb = 0; jb < M; jb += 4)
+            {
+            const vec xjv = V::load(xj + jb);
+            const vec yjv = V::load(yj + jb);
+            const vec zjv = V::load(zj + jb);
+
+            vec fxj = V::zero(), fyj = V::zero(), fzj = V::zero(), ej = V::zero();
+            vec vj[6] = {V::zero(), V::zero(), V::zero(), V::zero(), V::zero(), V::zero()};
+
+            for (unsigned int a = 0; a < M; a++)
+                {
+                const unsigned int bits = (unsigned int)(mask >> (a*M + jb)) & 0xfu;
+                if (!bits)
+                    continue;
+
+                const vec dx = V::sub(V::set1(xi[a] - shift.x), xjv);
+                const vec dy = V::sub(V::set1(yi[a] - shift.y), yjv);
+                const vec dz = V::sub(V::set1(zi[a] - shift.z), zjv);
+                const vec rsq = V::add(V::add(V::mul(dx, dx), V::mul(dy, dy)), V::mul(dz, dz));
+
+                vec lj1v = lj1_single, lj2v = lj2_single, rcutsqv = rcutsq_single, ecutv = ecut_single;
+                if (ntypes > 1)
+                    {
+                    const unsigned int row_offset = typei[a] * ntypes;
+                    lj1v = V::gather(lj1, row_offset, typej + jb);
+                    lj2v = V::gather(lj2, row_offset, typej + jb);
+                    rcutsqv = V::gather(rcutsq, row_offset, typej + jb);
+                    ecutv = V::gather(ecut, row_offset, typej + jb);
+                    }
+
+                // 1/r^2 of the masked lanes may be infinite (r = 0 for padding), it is discarded by the select
+                const vec in_range = V::bit_and(V::lt(rsq, rcutsqv), V::lane_mask(bits));
+                const vec r2inv = V::select(in_range, V::div(one, rsq));
+                const vec r6inv = V::mul(V::mul(r2inv, r2inv), r2inv);
+                const vec force_divr = V::mul(V::mul(r2inv, r6inv),
+                                              V::sub(V::mul(V::mul(twelve, lj1v), r6inv), V::mul(six, lj2v)));
+                const vec half_eng = V::mul(half, V::sub(V::mul(r6inv, V::sub(V::mul(lj1v, r6inv), lj2v)),
+                                                         V::select(in_range, ecutv)));
+
+                const vec fx = V::mul(dx, force_divr);
+                const vec fy = V::mul(dy, force_divr);
+                const vec fz = V::mul(dz, force_divr);
+
+                Scalar *lane_i = sums_i.fx + a*M + jb;
+                V::store(lane_i, V::add(V::load(lane_i), fx));
+                lane_i = sums_i.fy + a*M + jb;
+                V::store(lane_i, V::add(V::load(lane_i), fy));
+                lane_i = sums_i.fz + a*M + jb;
+                V::store(lane_i, V::add(V::load(lane_i), fz));
+                lane_i = sums_i.e + a*M + jb;
+                V::store(lane_i, V::add(V::load(lane_i), half_eng));
+                fxj = V::sub(fxj, fx);
+                fyj = V::sub(fyj, fy);
+                fzj = V::sub(fzj, fz);
+                ej = V::add(ej, half_eng);
+
+                if (compute_virial)
+                    {
+                    const vec force_div2r = V::mul(half, force_divr);
+                    const vec v[6] = {V::mul(V::mul(force_div2r, dx), dx), V::mul(V::mul(force_div2r, dx), dy),
+                                      V::mul(V::mul(force_div2r, dx), dz), V::mul(V::mul(force_div2r, dy), dy),
+                                      V::mul(V::mul(force_div2r, dy), dz), V::mul(V::mul(force_div2r, dz), dz)};
+                    for (unsigned int l = 0; l < 6; l++)
+                        {
+                        lane_i = sums_i.virial[l] + a*M + jb;
+                        V::store(lane_i, V::add(V::load(lane_i), v[l]));
+                        vj[l] = V::add(vj[l], v[l]);
+                        }
+                    }
+                }
+
+            V::store(sums_j.fx + jb, V::add(V::load(sums_j.fx + jb), fxj));
+            V::store(sums_j.fy + jb, V::add(V::load(sums_j.fy + jb), fyj));
+            V::store(sums_j.fz + jb, V::add(V::load(sums_j.fz + jb), fzj));
+            V::store(sums_j.e + jb, V::add(V::load(sums_j.e + jb), ej));
+            if (compute_virial)
+                {
+                for (unsigned int l = 0; l < 6; l++)
+                    V::store(sums_j.virial[l] + jb, V::add(V::load(sums_j.virial[l] + jb), vj[l]));
+                }
+            }
+        #else
+        for (unsigned int a = 0; a < M; a++)
+            {
+            const unsigned int row = (unsigned int)(mask >> (a*M)) & ((1u << M) - 1);
+            if (!row)
+                continue;
+
+            const Scalar xa = xi[a] - shift.x;
+            const Scalar ya = yi[a] - shift.y;
+            const Scalar za = zi[a] - shift.z;
+            const unsigned int row_offset = typei[a] * ntypes;
+
+            // gather the parameters of the row first, the pairs that are not in the mask get a zero cutoff
+            Scalar lj1_b[M], lj2_b[M], rcutsq_b[M], ecut_b[M];
+            for (unsigned int b = 0; b < M; b++)
+                {
+                const unsigned int typpair = row_offset + typej[b];
+                lj1_b[b] = lj1[typpair];
+                lj2_b[b] = lj2[typpair];
+                rcutsq_b[b] = ((row >> b) & 1u) ? rcutsq[typpair] : Scalar(0.0);
+                ecut_b[b] = ecut[typpair];
+                }
+
+            Scalar *fx_i = sums_i.fx + a*M;
+            Scalar *fy_i = sums_i.fy + a*M;
+            Scalar *fz_i = sums_i.fz + a*M;
+            Scalar *e_i = sums_i.e + a*M;
+
+            for (unsigned int b = 0; b < M; b++)
+                {
+                const Scalar dx = xa - xj[b];
+                const Scalar dy = ya - yj[b];
+                const Scalar dz = za - zj[b];
+                const Scalar rsq = dx*dx + dy*dy + dz*dz;
+
+                // 1/r^2 and the energy shift vanish for the pairs beyond the cutoff
+                const bool in_range = rsq < rcutsq_b[b];
+                const Scalar rsq_safe = in_range ? rsq : Scalar(1.0);
+                const Scalar r2inv_safe = Scalar(1.0) / rsq_safe;
+                const Scalar r2inv = in_range ? r2inv_safe : Scalar(0.0);
+                const Scalar ecut_pair = in_range ? ecut_b[b] : Scalar(0.0);
+
+                const Scalar r6inv = r2inv * r2inv * r2inv;
+                const Scalar force_divr = r2inv * r6inv * (Scalar(12.0)*lj1_b[b]*r6inv - Scalar(6.0)*lj2_b[b]);
+                const Scalar half_eng = Scalar(0.5) * (r6inv * (lj1_b[b]*r6inv - lj2_b[b]) - ecut_pair);
+
+                fx_i[b] += dx*force_divr;
+                fy_i[b] += dy*force_divr;
+                fz_i[b] += dz*force_divr;
+                e_i[b] += half_eng;
+                sums_j.fx[b] -= dx*force_divr;
+                sums_j.fy[b] -= dy*force_divr;
+                sums_j.fz[b] -= dz*force_divr;
+                sums_j.e[b] += half_eng;
+
+                if (compute_virial)
+                    {
+                    const Scalar force_div2r = Scalar(0.5) * force_divr;
+                    const Scalar vxx = force_div2r*dx*dx;
+                    const Scalar vxy = force_div2r*dx*dy;
+                    const Scalar vxz = force_div2r*dx*dz;
+                    const Scalar vyy = force_div2r*dy*dy;
+                    const Scalar vyz = force_div2r*dy*dz;
+                    const Scalar vzz = force_div2r*dz*dz;
+                    sums_i.virial[0][a*M + b] += vxx;
+                    sums_i.virial[1][a*M + b] += vxy;
+                    sums_i.virial[2][a*M + b] += vxz;
+                    sums_i.virial[3][a*M + b] += vyy;
+                    sums_i.virial[4][a*M + b] += vyz;
+                    sums_i.virial[5][a*M + b] += vzz;
+                    sums_j.virial[0][b] += vxx;
+                    sums_j.virial[1][b] += vxy;
+                    sums_j.virial[2][b] += vxz;
+                    sums_j.virial[3][b] += vyy;
+                    sums_j.virial[4][b] += vyz;
+                    sums_j.virial[5][b] += vzz;
+                    }
+                }
+            }
+        #endif
+        }
+    };
+
+#endif
@@ -7,6 +7,12 @@
 #include "ForceDistanceConstraint.h"
 
 #include <string.h>
+#include <map>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -21,7 +27,7 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
           m_cmatrix(m_exec_conf), m_cvec(m_exec_conf), m_lagrange(m_exec_conf),
           m_rel_tol(1e-3), m_constraint_violated(m_exec_conf), m_condition(m_exec_conf),
           m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true), m_constraints_added_removed(true),
-          m_d_max(0.0)
+          m_d_max(0.0), m_iterative(false), m_solver_tol(1e-8), m_max_iter(100)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -61,19 +67,30 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
         throw std::runtime_error("Error computing constraints.\n");
         }
 
-    // reallocate through amortized resizin
-    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
-    m_cvec.resize(n_constraint);
+    if (m_iterative)
+        {
+        // solve molecule by molecule, the dense matrix is never filled
+        solveMolecules(timestep);
 
-    // populate the terms in the matrix vector equation
-    fillMatrixVector(timestep);
+        // check violations
+        checkConstraints(timestep);
+        }
+    else
+        {
+        // reallocate through amortized resizin
+        unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+        m_cmatrix.resize(n_constraint*n_constraint);
+        m_cvec.resize(n_constraint);
 
-    // check violations
-    checkConstraints(timestep);
+        // populate the terms in the matrix vector equation
+        fillMatrixVector(timestep);
 
-    // solve the matrix vector equation
-    solveConstraints(timestep);
+        // check violations
+        checkConstraints(timestep);
+
+        // solve the matrix vector equation
+        solveConstraints(timestep);
+        }
 
     // compute forces
     computeConstraintForces(timestep);
@@ -375,6 +392,257 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
         m_prof->pop();
     }
 
+/*! Constraints in different molecules share no particles, so the constraint matrix is block diagonal in the
+    molecules. The sparse block of every molecule is assembled directly from the constraints that share a particle,
+    with the same coefficients as in fillMatrixVector(), and solved with a Jacobi preconditioned BiCGSTAB starting
+    from the Lagrange multipliers of the previous step. The matrix is not symmetric, so conjugate gradients are not
+    applicable. Blocks that do not converge within m_max_iter iterations are solved with a sparse LU decomposition.
+
+    The molecules are distributed among the OpenMP threads.
+
+    \param timestep Current timestep
+*/
+void ForceDistanceConstraint::solveMolecules(unsigned int timestep)
+    {
+    typedef SparseMatrix<double, ColMajor> sparse_matrix_t;
+    typedef Matrix<double, Dynamic, 1> vec_t;
+
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0) return;
+
+    // without a communicator, the molecule tags are not assigned by askGhostLayerWidth()
+    if (m_constraints_added_removed)
+        {
+        assignMoleculeTags();
+        m_constraints_added_removed = false;
+        }
+
+    if (m_prof)
+        m_prof->push("solve molecules");
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
+    // the warm start is indexed by constraint tag, which is stable under reordering and migration
+    unsigned int max_tag = m_cdata->getMaximumTag();
+    if (m_lagrange_tag.size() < max_tag+1)
+        m_lagrange_tag.resize(max_tag+1, 0.0);
+
+    // access particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_tag(m_cdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_molecule_tag(m_molecule_tag, access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    std::vector<unsigned int> idx_a(n_constraint), idx_b(n_constraint);
+    std::vector< vec3<Scalar> > rn(n_constraint), qn(n_constraint);
+    std::vector<Scalar> inv_ma(n_constraint), inv_mb(n_constraint);
+    std::vector<double> cvec(n_constraint);
+    std::vector<unsigned int> block(n_constraint);
+
+    // local block index per molecule tag
+    std::map<unsigned int, unsigned int> molecule_block;
+
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        // lookup the tag of each of the particles participating in the constraint
+        const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
+        assert(constraint.tag[0] < m_pdata->getMaximumTag());
+        assert(constraint.tag[1] < m_pdata->getMaximumTag());
+
+        idx_a[n] = h_rtag.data[constraint.tag[0]];
+        idx_b[n] = h_rtag.data[constraint.tag[1]];
+
+        if (idx_a[n] >= max_local || idx_b[n] >= max_local)
+            {
+            this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
+                constraint.tag[0] << " " << constraint.tag[1] << " incomplete." << std::endl << std::endl;
+            throw std::runtime_error("Error in constraint calculation");
+            }
+
+        vec3<Scalar> ra(h_pos.data[idx_a[n]]);
+        vec3<Scalar> rb(h_pos.data[idx_b[n]]);
+
+        // apply minimum image
+        rn[n] = box.minImage(ra-rb);
+
+        vec3<Scalar> va(h_vel.data[idx_a[n]]);
+        Scalar ma(h_vel.data[idx_a[n]].w);
+        vec3<Scalar> vb(h_vel.data[idx_b[n]]);
+        Scalar mb(h_vel.data[idx_b[n]].w);
+
+        inv_ma[n] = Scalar(1.0)/ma;
+        inv_mb[n] = Scalar(1.0)/mb;
+        qn[n] = rn[n]+(va-vb)*m_deltaT;
+
+        // get constraint distance
+        Scalar d = m_cdata->getValueByIndex(n);
+
+        // check distance violation
+        if (fast::sqrt(dot(rn[n],rn[n]))-d >= m_rel_tol*d || std::isnan(dot(rn[n],rn[n])))
+            {
+            m_constraint_violated.resetFlags(n+1);
+            }
+
+        // right hand side of the constraint equation
+        cvec[n] = (dot(qn[n],qn[n])-d*d)/m_deltaT/m_deltaT;
+        cvec[n] += double(2.0)*dot(qn[n],vec3<Scalar>(h_netforce.data[idx_a[n]])/ma
+              -vec3<Scalar>(h_netforce.data[idx_b[n]])/mb);
+
+        // both particles belong to the same molecule
+        unsigned int mol_tag = h_molecule_tag.data[constraint.tag[0]];
+        std::map<unsigned int, unsigned int>::iterator it = molecule_block.find(mol_tag);
+        if (it == molecule_block.end())
+            {
+            unsigned int new_block = molecule_block.size();
+            it = molecule_block.insert(std::make_pair(mol_tag, new_block)).first;
+            }
+        block[n] = it->second;
+        }
+
+    // sort the constraints by block
+    unsigned int n_blocks = molecule_block.size();
+    std::vector<unsigned int> block_offset(n_blocks+1, 0);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        block_offset[block[n]+1]++;
+    for (unsigned int b = 0; b < n_blocks; ++b)
+        block_offset[b+1] += block_offset[b];
+
+    std::vector<unsigned int> block_constraints(n_constraint);
+    std::vector<unsigned int> pos_in_block(n_constraint);
+    std::vector<unsigned int> block_fill(block_offset.begin(), block_offset.end()-1);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        unsigned int pos = block_fill[block[n]]++;
+        block_constraints[pos] = n;
+        pos_in_block[n] = pos - block_offset[block[n]];
+        }
+
+    // list the constraints of every particle
+    std::vector<unsigned int> ptl_offset(max_local+1, 0);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        ptl_offset[idx_a[n]+1]++;
+        ptl_offset[idx_b[n]+1]++;
+        }
+    for (unsigned int i = 0; i < max_local; ++i)
+        ptl_offset[i+1] += ptl_offset[i];
+
+    std::vector<unsigned int> ptl_constraints(2*n_constraint);
+    std::vector<unsigned int> ptl_fill(ptl_offset.begin(), ptl_offset.end()-1);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        ptl_constraints[ptl_fill[idx_a[n]]++] = n;
+        ptl_constraints[ptl_fill[idx_b[n]]++] = n;
+        }
+
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+
+    // 0: converged, 1: solved directly, 2: failed
+    std::vector<unsigned char> status(n_blocks, 0);
+
+    #pragma omp parallel
+        {
+        std::vector< Triplet<double> > triplets;
+        sparse_matrix_t A;
+        BiCGSTAB<sparse_matrix_t, DiagonalPreconditioner<double> > solver;
+        solver.setTolerance(m_solver_tol);
+        solver.setMaxIterations(m_max_iter);
+
+        #pragma omp for schedule(dynamic)
+        for (int b = 0; b < (int)n_blocks; ++b)
+            {
+            unsigned int first = block_offset[b];
+            unsigned int k = block_offset[b+1] - first;
+
+            vec_t c(k);
+            vec_t guess(k);
+            triplets.clear();
+
+            for (unsigned int i = 0; i < k; ++i)
+                {
+                unsigned int n = block_constraints[first+i];
+                c(i) = cvec[n];
+                guess(i) = m_lagrange_tag[h_group_tag.data[n]];
+
+                // constraints sharing particle a
+                for (unsigned int j = ptl_offset[idx_a[n]]; j < ptl_offset[idx_a[n]+1]; ++j)
+                    {
+                    unsigned int m = ptl_constraints[j];
+                    double s = (idx_a[m] == idx_a[n]) ? inv_ma[n] : -inv_ma[n];
+                    triplets.push_back(Triplet<double>(i, pos_in_block[m], double(4.0)*s*dot(qn[n],rn[m])));
+                    }
+
+                // constraints sharing particle b
+                for (unsigned int j = ptl_offset[idx_b[n]]; j < ptl_offset[idx_b[n]+1]; ++j)
+                    {
+                    unsigned int m = ptl_constraints[j];
+                    double s = (idx_b[m] == idx_b[n]) ? inv_mb[n] : -inv_mb[n];
+                    triplets.push_back(Triplet<double>(i, pos_in_block[m], double(4.0)*s*dot(qn[n],rn[m])));
+                    }
+                }
+
+            A.resize(k,k);
+            A.setFromTriplets(triplets.begin(), triplets.end());
+
+            solver.compute(A);
+            vec_t x = solver.solveWithGuess(c, guess);
+
+            if (solver.info() != Success)
+                {
+                // tightly coupled constraints, use the direct solver
+                SparseLU<sparse_matrix_t, COLAMDOrdering<int> > lu;
+                A.makeCompressed();
+                lu.analyzePattern(A);
+                lu.factorize(A);
+
+                if (lu.info() != Success)
+                    {
+                    status[b] = 2;
+                    continue;
+                    }
+
+                x = lu.solve(c);
+                status[b] = 1;
+                }
+
+            for (unsigned int i = 0; i < k; ++i)
+                {
+                unsigned int n = block_constraints[first+i];
+                h_lagrange.data[n] = x(i);
+                m_lagrange_tag[h_group_tag.data[n]] = x(i);
+                }
+            }
+        }
+
+    unsigned int n_direct = 0;
+    for (unsigned int b = 0; b < n_blocks; ++b)
+        {
+        if (status[b] == 2)
+            {
+            m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+            throw std::runtime_error("Error evaluating constraint forces.\n");
+            }
+        if (status[b] == 1)
+            n_direct++;
+        }
+
+    if (n_direct)
+        m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: " << n_direct << " of " << n_blocks
+            << " molecules did not converge, solved directly" << std::endl;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void ForceDistanceConstraint::computeConstraintForces(unsigned int timestep)
     {
     ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::read);
@@ -599,5 +867,8 @@ void export_ForceDistanceConstraint(py::module& m)
     py::class_< ForceDistanceConstraint, std::shared_ptr<ForceDistanceConstraint> >(m, "ForceDistanceConstraint", py::base<MolecularForceCompute>())
         .def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def("setIterative", &ForceDistanceConstraint::setIterative)
+        .def("setSolverTolerance", &ForceDistanceConstraint::setSolverTolerance)
+        .def("setMaxIterations", &ForceDistanceConstraint::setMaxIterations)
     ;
     }
@@ -24,6 +24,9 @@
 
 #include "hoomd/extern/Eigen/Dense"
 #include "hoomd/extern/Eigen/SparseLU"
+#include "hoomd/extern/Eigen/IterativeLinearSolvers"
+
+#include <vector>
 
 /*! Implements a pairwise distance constraint using the algorithm of
 
@@ -31,6 +34,11 @@
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
     See Integrator for detailed documentation on constraint force implementation.
+
+    By default, the constraint matrix of all local constraints is filled and solved with a sparse LU decomposition.
+    In iterative mode (setIterative()), the constraint equation of every molecule is solved separately by
+    solveMolecules() with a Jacobi preconditioned BiCGSTAB, starting from the Lagrange multipliers of the previous
+    step. Molecules that do not converge fall back to the direct solver.
     \ingroup computes
 */
 class ForceDistanceConstraint : public MolecularForceCompute
@@ -54,6 +62,24 @@ class ForceDistanceConstraint : public MolecularForceCompute
             m_rel_tol = rel_tol;
             }
 
+        //! Choose between the direct solver and the iterative per-molecule solver
+        void setIterative(bool iterative)
+            {
+            m_iterative = iterative;
+            }
+
+        //! Set the relative residual at which the iterative solver has converged
+        void setSolverTolerance(Scalar tol)
+            {
+            m_solver_tol = tol;
+            }
+
+        //! Set the maximum number of iterations before a molecule falls back to the direct solver
+        void setMaxIterations(unsigned int max_iter)
+            {
+            m_max_iter = max_iter;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -83,6 +109,11 @@ class ForceDistanceConstraint : public MolecularForceCompute
 
         Scalar m_d_max;                    //!< Maximum constraint extension
 
+        bool m_iterative;                  //!< True if the molecules are solved iteratively
+        Scalar m_solver_tol;               //!< Relative residual tolerance of the iterative solver
+        unsigned int m_max_iter;           //!< Maximum number of iterations per molecule
+        std::vector<double> m_lagrange_tag; //!< Lagrange multipliers of the last solve, indexed by constraint tag
+
         //! Compute the forces
         virtual void computeForces(unsigned int timestep);
 
@@ -95,6 +126,9 @@ class ForceDistanceConstraint : public MolecularForceCompute
         //! Solve the constraint matrix equation
         virtual void solveConstraints(unsigned int timestep);
 
+        //! Solve the constraint equation of every molecule with the iterative solver
+        virtual void solveMolecules(unsigned int timestep);
+
         //! Solve the linear matrix-vector equation
         virtual void computeConstraintForces(unsigned int timestep);
 
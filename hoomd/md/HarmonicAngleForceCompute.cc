@@ -15,6 +15,10 @@ namespace py = pybind11;
 #include <stdexcept>
 #include <math.h>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 // SMALL a relatively small number
@@ -109,8 +113,98 @@ Scalar HarmonicAngleForceCompute::getLogValue(const std::string& quantity, unsig
         }
     }
 
+/*! \param h_pos Particle positions
+    \param idx Indices of the particles a, b and c
+    \param box Box for the minimum image convention
+    \param K Stiffness of the angle
+    \param t_0 Rest angle
+    \param f Set to the force on a, b and c
+    \param angle_eng Set to the energy of each member, 1/3 of the angle energy
+    \param angle_virial Set to the virial of each member, 1/3 of the angle virial
+*/
+static inline void eval_harmonic_angle(const Scalar4 *h_pos, const unsigned int *idx, const BoxDim& box, Scalar K,
+    Scalar t_0, Scalar3 *f, Scalar& angle_eng, Scalar *angle_virial)
+    {
+    unsigned int idx_a = idx[0];
+    unsigned int idx_b = idx[1];
+    unsigned int idx_c = idx[2];
+
+    // calculate d\vec{r}
+    Scalar3 dab;
+    dab.x = h_pos[idx_a].x - h_pos[idx_b].x;
+    dab.y = h_pos[idx_a].y - h_pos[idx_b].y;
+    dab.z = h_pos[idx_a].z - h_pos[idx_b].z;
+
+    Scalar3 dcb;
+    dcb.x = h_pos[idx_c].x - h_pos[idx_b].x;
+    dcb.y = h_pos[idx_c].y - h_pos[idx_b].y;
+    dcb.z = h_pos[idx_c].z - h_pos[idx_b].z;
+
+    // apply minimum image conventions to both vectors
+    dab = box.minImage(dab);
+    dcb = box.minImage(dcb);
+
+    // on paper, the formula turns out to be: F = K*\vec{r} * (r_0/r - 1)
+    // FLOPS: 14 / MEM TRANSFER: 2 Scalars
+
+
+    // FLOPS: 42 / MEM TRANSFER: 6 Scalars
+    Scalar rsqab = dab.x*dab.x+dab.y*dab.y+dab.z*dab.z;
+    Scalar rab = sqrt(rsqab);
+    Scalar rsqcb = dcb.x*dcb.x+dcb.y*dcb.y+dcb.z*dcb.z;
+    Scalar rcb = sqrt(rsqcb);
+
+    Scalar c_abbc = dab.x*dcb.x+dab.y*dcb.y+dab.z*dcb.z;
+    c_abbc /= rab*rcb;
+
+    if (c_abbc > 1.0) c_abbc = 1.0;
+    if (c_abbc < -1.0) c_abbc = -1.0;
+
+    Scalar s_abbc = sqrt(1.0 - c_abbc*c_abbc);
+    if (s_abbc < SMALL) s_abbc = SMALL;
+    s_abbc = 1.0/s_abbc;
+
+    // actually calculate the force
+    Scalar dth = acos(c_abbc) - t_0;
+    Scalar tk = K*dth;
+
+    Scalar a = -1.0 * tk * s_abbc;
+    Scalar a11 = a*c_abbc/rsqab;
+    Scalar a12 = -a / (rab*rcb);
+    Scalar a22 = a*c_abbc / rsqcb;
+
+    Scalar fab[3], fcb[3];
+
+    fab[0] = a11*dab.x + a12*dcb.x;
+    fab[1] = a11*dab.y + a12*dcb.y;
+    fab[2] = a11*dab.z + a12*dcb.z;
+
+    fcb[0] = a22*dcb.x + a12*dab.x;
+    fcb[1] = a22*dcb.y + a12*dab.y;
+    fcb[2] = a22*dcb.z + a12*dab.z;
+
+    // compute 1/3 of the energy, 1/3 for each atom in the angle
+    angle_eng = (tk*dth)*Scalar(1.0/6.0);
+
+    // compute 1/3 of the virial, 1/3 for each atom in the angle
+    // upper triangular version of virial tensor
+    angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
+    angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
+    angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
+    angle_virial[3] = Scalar(1./3.) * ( dab.y*fab[1] + dcb.y*fcb[1] );
+    angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
+    angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
+
+    f[0] = make_scalar3(fab[0], fab[1], fab[2]);
+    f[1] = make_scalar3(-(fab[0] + fcb[0]), -(fab[1] + fcb[1]), -(fab[2] + fcb[2]));
+    f[2] = make_scalar3(fcb[0], fcb[1], fcb[2]);
+    }
+
 /*! Actually perform the force computation
     \param timestep Current time step
+
+    With more than one OpenMP thread, every local particle gathers the angles it is part of from the per-particle
+    table of the AngleData (as on the GPU), so that the threads never write to the same particle.
  */
 void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     {
@@ -138,6 +232,50 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    if (n_threads > 1)
+        {
+        // the table is rebuilt on access if needed, and reports incomplete angles
+        ArrayHandle<AngleData::members_t> h_table(m_angle_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_table_pos(m_angle_data->getGPUPosTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_angles(m_angle_data->getNGroupsArray(), access_location::host, access_mode::read);
+        const Index2D& table_indexer = m_angle_data->getGPUTableIndexer();
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)m_pdata->getN(); i++)
+            {
+            for (unsigned int k = 0; k < h_n_angles.data[i]; k++)
+                {
+                const AngleData::members_t& entry = h_table.data[table_indexer(i, k)];
+                unsigned int cur_pos = h_table_pos.data[table_indexer(i, k)];
+
+                unsigned int idx[3];
+                get_group_members<3>(entry, cur_pos, i, idx);
+
+                unsigned int angle_type = entry.idx[2];
+                Scalar3 f[3];
+                Scalar angle_eng;
+                Scalar angle_virial[6];
+                eval_harmonic_angle(h_pos.data, idx, box, m_K[angle_type], m_t_0[angle_type], f, angle_eng,
+                    angle_virial);
+
+                h_force.data[i].x += f[cur_pos].x;
+                h_force.data[i].y += f[cur_pos].y;
+                h_force.data[i].z += f[cur_pos].z;
+                h_force.data[i].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j*virial_pitch+i]  += angle_virial[j];
+                }
+            }
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -150,126 +288,41 @@ void HarmonicAngleForceCompute::computeForces(unsigned int timestep)
 
         // transform a, b, and c into indices into the particle data arrays
         // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
+        unsigned int idx[3];
+        for (unsigned int j = 0; j < 3; j++)
+            idx[j] = h_rtag.data[angle.tag[j]];
 
         // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL)
             {
             this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
                 angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
             throw std::runtime_error("Error in angle calculation");
             }
 
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-        // apply minimum image conventions to all 3 vectors
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
-
-        // on paper, the formula turns out to be: F = K*\vec{r} * (r_0/r - 1)
-        // FLOPS: 14 / MEM TRANSFER: 2 Scalars
+        assert(idx[0] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN()+m_pdata->getNGhosts());
 
-
-        // FLOPS: 42 / MEM TRANSFER: 6 Scalars
-        Scalar rsqab = dab.x*dab.x+dab.y*dab.y+dab.z*dab.z;
-        Scalar rab = sqrt(rsqab);
-        Scalar rsqcb = dcb.x*dcb.x+dcb.y*dcb.y+dcb.z*dcb.z;
-        Scalar rcb = sqrt(rsqcb);
-
-        Scalar c_abbc = dab.x*dcb.x+dab.y*dcb.y+dab.z*dcb.z;
-        c_abbc /= rab*rcb;
-
-        if (c_abbc > 1.0) c_abbc = 1.0;
-        if (c_abbc < -1.0) c_abbc = -1.0;
-
-        Scalar s_abbc = sqrt(1.0 - c_abbc*c_abbc);
-        if (s_abbc < SMALL) s_abbc = SMALL;
-        s_abbc = 1.0/s_abbc;
-
-        // actually calculate the force
         unsigned int angle_type = m_angle_data->getTypeByIndex(i);
-        Scalar dth = acos(c_abbc) - m_t_0[angle_type];
-        Scalar tk = m_K[angle_type]*dth;
-
-        Scalar a = -1.0 * tk * s_abbc;
-        Scalar a11 = a*c_abbc/rsqab;
-        Scalar a12 = -a / (rab*rcb);
-        Scalar a22 = a*c_abbc / rsqcb;
-
-        Scalar fab[3], fcb[3];
-
-        fab[0] = a11*dab.x + a12*dcb.x;
-        fab[1] = a11*dab.y + a12*dcb.y;
-        fab[2] = a11*dab.z + a12*dcb.z;
-
-        fcb[0] = a22*dcb.x + a12*dab.x;
-        fcb[1] = a22*dcb.y + a12*dab.y;
-        fcb[2] = a22*dcb.z + a12*dab.z;
-
-        // compute 1/3 of the energy, 1/3 for each atom in the angle
-        Scalar angle_eng = (tk*dth)*Scalar(1.0/6.0);
-
-        // compute 1/3 of the virial, 1/3 for each atom in the angle
-        // upper triangular version of virial tensor
+        Scalar3 f[3];
+        Scalar angle_eng;
         Scalar angle_virial[6];
-        angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
-        angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
-        angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
-        angle_virial[3] = Scalar(1./3.) * ( dab.y*fab[1] + dcb.y*fcb[1] );
-        angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
-        angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
+        eval_harmonic_angle(h_pos.data, idx, box, m_K[angle_type], m_t_0[angle_type], f, angle_eng, angle_virial);
 
         // Now, apply the force to each individual atom a,b,c, and accumlate the energy/virial
         // do not update ghost particles
-        if (idx_a < m_pdata->getN())
+        for (unsigned int m = 0; m < 3; m++)
             {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_a]  += angle_virial[j];
-            }
+            if (idx[m] >= m_pdata->getN())
+                continue;
 
-        if (idx_b < m_pdata->getN())
-            {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_b]  += angle_virial[j];
-            }
-
-        if (idx_c < m_pdata->getN())
-            {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
+            h_force.data[idx[m]].x += f[m].x;
+            h_force.data[idx[m]].y += f[m].y;
+            h_force.data[idx[m]].z += f[m].z;
+            h_force.data[idx[m]].w += angle_eng;
             for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
+                h_virial.data[j*virial_pitch+idx[m]]  += angle_virial[j];
             }
         }
 
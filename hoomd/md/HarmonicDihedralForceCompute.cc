@@ -15,6 +15,10 @@ namespace py = pybind11;
 #include <stdexcept>
 #include <math.h>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 // SMALL a relatively small number
@@ -115,8 +119,170 @@ Scalar HarmonicDihedralForceCompute::getLogValue(const std::string& quantity, un
         }
     }
 
+/*! \param h_pos Particle positions
+    \param idx Indices of the particles a, b, c and d
+    \param box Box for the minimum image convention
+    \param K Stiffness of the dihedral
+    \param sign Sign factor of the dihedral
+    \param multi Multiplicity of the dihedral
+    \param f Set to the force on a, b, c and d
+    \param dihedral_eng Set to the energy of each member, 1/4 of the dihedral energy
+    \param dihedral_virial Set to the virial of each member, 1/4 of the dihedral virial
+*/
+static inline void eval_harmonic_dihedral(const Scalar4 *h_pos, const unsigned int *idx, const BoxDim& box, Scalar K,
+    Scalar sign, int multi, Scalar3 *f, Scalar& dihedral_eng, Scalar *dihedral_virial)
+    {
+    unsigned int idx_a = idx[0];
+    unsigned int idx_b = idx[1];
+    unsigned int idx_c = idx[2];
+    unsigned int idx_d = idx[3];
+
+    // calculate d\vec{r}
+    Scalar3 dab;
+    dab.x = h_pos[idx_a].x - h_pos[idx_b].x;
+    dab.y = h_pos[idx_a].y - h_pos[idx_b].y;
+    dab.z = h_pos[idx_a].z - h_pos[idx_b].z;
+
+    Scalar3 dcb;
+    dcb.x = h_pos[idx_c].x - h_pos[idx_b].x;
+    dcb.y = h_pos[idx_c].y - h_pos[idx_b].y;
+    dcb.z = h_pos[idx_c].z - h_pos[idx_b].z;
+
+    Scalar3 ddc;
+    ddc.x = h_pos[idx_d].x - h_pos[idx_c].x;
+    ddc.y = h_pos[idx_d].y - h_pos[idx_c].y;
+    ddc.z = h_pos[idx_d].z - h_pos[idx_c].z;
+
+    // apply periodic boundary conditions
+    dab = box.minImage(dab);
+    dcb = box.minImage(dcb);
+    ddc = box.minImage(ddc);
+
+    Scalar3 dcbm;
+    dcbm.x = -dcb.x;
+    dcbm.y = -dcb.y;
+    dcbm.z = -dcb.z;
+
+    dcbm = box.minImage(dcbm);
+
+    Scalar aax = dab.y*dcbm.z - dab.z*dcbm.y;
+    Scalar aay = dab.z*dcbm.x - dab.x*dcbm.z;
+    Scalar aaz = dab.x*dcbm.y - dab.y*dcbm.x;
+
+    Scalar bbx = ddc.y*dcbm.z - ddc.z*dcbm.y;
+    Scalar bby = ddc.z*dcbm.x - ddc.x*dcbm.z;
+    Scalar bbz = ddc.x*dcbm.y - ddc.y*dcbm.x;
+
+    Scalar raasq = aax*aax + aay*aay + aaz*aaz;
+    Scalar rbbsq = bbx*bbx + bby*bby + bbz*bbz;
+    Scalar rgsq = dcbm.x*dcbm.x + dcbm.y*dcbm.y + dcbm.z*dcbm.z;
+    Scalar rg = sqrt(rgsq);
+
+    Scalar rginv, raa2inv, rbb2inv;
+    rginv = raa2inv = rbb2inv = Scalar(0.0);
+    if (rg > Scalar(0.0)) rginv = Scalar(1.0)/rg;
+    if (raasq > Scalar(0.0)) raa2inv = Scalar(1.0)/raasq;
+    if (rbbsq > Scalar(0.0)) rbb2inv = Scalar(1.0)/rbbsq;
+    Scalar rabinv = sqrt(raa2inv*rbb2inv);
+
+    Scalar c_abcd = (aax*bbx + aay*bby + aaz*bbz)*rabinv;
+    Scalar s_abcd = rg*rabinv*(aax*ddc.x + aay*ddc.y + aaz*ddc.z);
+
+    if (c_abcd > 1.0) c_abcd = 1.0;
+    if (c_abcd < -1.0) c_abcd = -1.0;
+
+    Scalar p = Scalar(1.0);
+    Scalar dfab = Scalar(0.0);
+    Scalar ddfab;
+
+    for (int j = 0; j < multi; j++)
+        {
+        ddfab = p*c_abcd - dfab*s_abcd;
+        dfab = p*s_abcd + dfab*c_abcd;
+        p = ddfab;
+        }
+
+/////////////////////////
+// FROM LAMMPS: sin_shift is always 0... so dropping all sin_shift terms!!!!
+/////////////////////////
+
+    p = p*sign;
+    dfab = dfab*sign;
+    dfab *= (Scalar)-multi;
+    p += Scalar(1.0);
+
+    if (multi == 0)
+        {
+        p =  Scalar(1.0) + sign;
+        dfab = Scalar(0.0);
+        }
+
+
+    Scalar fg = dab.x*dcbm.x + dab.y*dcbm.y + dab.z*dcbm.z;
+    Scalar hg = ddc.x*dcbm.x + ddc.y*dcbm.y + ddc.z*dcbm.z;
+
+    Scalar fga = fg*raa2inv*rginv;
+    Scalar hgb = hg*rbb2inv*rginv;
+    Scalar gaa = -raa2inv*rg;
+    Scalar gbb = rbb2inv*rg;
+
+    Scalar dtfx = gaa*aax;
+    Scalar dtfy = gaa*aay;
+    Scalar dtfz = gaa*aaz;
+    Scalar dtgx = fga*aax - hgb*bbx;
+    Scalar dtgy = fga*aay - hgb*bby;
+    Scalar dtgz = fga*aaz - hgb*bbz;
+    Scalar dthx = gbb*bbx;
+    Scalar dthy = gbb*bby;
+    Scalar dthz = gbb*bbz;
+
+//      Scalar df = -m_K[dihedral.type] * dfab;
+    Scalar df = -K * dfab * Scalar(0.500); // the 0.5 term is for 1/2K in the forces
+
+    Scalar sx2 = df*dtgx;
+    Scalar sy2 = df*dtgy;
+    Scalar sz2 = df*dtgz;
+
+    Scalar ffax = df*dtfx;
+    Scalar ffay= df*dtfy;
+    Scalar ffaz = df*dtfz;
+
+    Scalar ffbx = sx2 - ffax;
+    Scalar ffby = sy2 - ffay;
+    Scalar ffbz = sz2 - ffaz;
+
+    Scalar ffdx = df*dthx;
+    Scalar ffdy = df*dthy;
+    Scalar ffdz = df*dthz;
+
+    Scalar ffcx = -sx2 - ffdx;
+    Scalar ffcy = -sy2 - ffdy;
+    Scalar ffcz = -sz2 - ffdz;
+
+    // compute 1/4 of the energy, 1/4 for each atom in the dihedral
+    //Scalar dihedral_eng = p*m_K[dihedral.type]*Scalar(1.0/4.0);
+    dihedral_eng = p*K*Scalar(0.125);  // the .125 term is (1/2)K * 1/4
+
+    // compute 1/4 of the virial, 1/4 for each atom in the dihedral
+    // upper triangular version of virial tensor
+    dihedral_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
+    dihedral_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
+    dihedral_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
+    dihedral_virial[3] = (1./4.)*(dab.y*ffay + dcb.y*ffcy + (ddc.y+dcb.y)*ffdy);
+    dihedral_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
+    dihedral_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
+
+    f[0] = make_scalar3(ffax, ffay, ffaz);
+    f[1] = make_scalar3(ffbx, ffby, ffbz);
+    f[2] = make_scalar3(ffcx, ffcy, ffcz);
+    f[3] = make_scalar3(ffdx, ffdy, ffdz);
+    }
+
 /*! Actually perform the force computation
     \param timestep Current time step
+
+    With more than one OpenMP thread, every local particle gathers the dihedrals it is part of from the per-particle
+    table of the DihedralData (as on the GPU), so that the threads never write to the same particle.
  */
 void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     {
@@ -145,6 +311,50 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    if (n_threads > 1)
+        {
+        // the table is rebuilt on access if needed, and reports incomplete dihedrals
+        ArrayHandle<DihedralData::members_t> h_table(m_dihedral_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_table_pos(m_dihedral_data->getGPUPosTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_dihedrals(m_dihedral_data->getNGroupsArray(), access_location::host, access_mode::read);
+        const Index2D& table_indexer = m_dihedral_data->getGPUTableIndexer();
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)m_pdata->getN(); i++)
+            {
+            for (unsigned int k = 0; k < h_n_dihedrals.data[i]; k++)
+                {
+                const DihedralData::members_t& entry = h_table.data[table_indexer(i, k)];
+                unsigned int cur_pos = h_table_pos.data[table_indexer(i, k)];
+
+                unsigned int idx[4];
+                get_group_members<4>(entry, cur_pos, i, idx);
+
+                unsigned int dihedral_type = entry.idx[3];
+                Scalar3 f[4];
+                Scalar dihedral_eng;
+                Scalar dihedral_virial[6];
+                eval_harmonic_dihedral(h_pos.data, idx, box, m_K[dihedral_type], m_sign[dihedral_type],
+                    (int)m_multi[dihedral_type], f, dihedral_eng, dihedral_virial);
+
+                h_force.data[i].x += f[cur_pos].x;
+                h_force.data[i].y += f[cur_pos].y;
+                h_force.data[i].z += f[cur_pos].z;
+                h_force.data[i].w += dihedral_eng;
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[virial_pitch*j+i]  += dihedral_virial[j];
+                }
+            }
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // for each of the dihedrals
     const unsigned int size = (unsigned int)m_dihedral_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -158,13 +368,12 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
 
         // transform a, b, and c into indicies into the particle data arrays
         // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
-        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
-        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
-        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
+        unsigned int idx[4];
+        for (unsigned int j = 0; j < 4; j++)
+            idx[j] = h_rtag.data[dihedral.tag[j]];
 
         // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL || idx[3] == NOT_LOCAL)
             {
             this->m_exec_conf->msg->error() << "dihedral.harmonic: dihedral " <<
                 dihedral.tag[0] << " " << dihedral.tag[1] << " " << dihedral.tag[2] << " " << dihedral.tag[3]
@@ -172,179 +381,29 @@ void HarmonicDihedralForceCompute::computeForces(unsigned int timestep)
             throw std::runtime_error("Error in dihedral calculation");
             }
 
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 ddc;
-        ddc.x = h_pos.data[idx_d].x - h_pos.data[idx_c].x;
-        ddc.y = h_pos.data[idx_d].y - h_pos.data[idx_c].y;
-        ddc.z = h_pos.data[idx_d].z - h_pos.data[idx_c].z;
-
-        // apply periodic boundary conditions
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        ddc = box.minImage(ddc);
-
-        Scalar3 dcbm;
-        dcbm.x = -dcb.x;
-        dcbm.y = -dcb.y;
-        dcbm.z = -dcb.z;
-
-        dcbm = box.minImage(dcbm);
-
-        Scalar aax = dab.y*dcbm.z - dab.z*dcbm.y;
-        Scalar aay = dab.z*dcbm.x - dab.x*dcbm.z;
-        Scalar aaz = dab.x*dcbm.y - dab.y*dcbm.x;
-
-        Scalar bbx = ddc.y*dcbm.z - ddc.z*dcbm.y;
-        Scalar bby = ddc.z*dcbm.x - ddc.x*dcbm.z;
-        Scalar bbz = ddc.x*dcbm.y - ddc.y*dcbm.x;
-
-        Scalar raasq = aax*aax + aay*aay + aaz*aaz;
-        Scalar rbbsq = bbx*bbx + bby*bby + bbz*bbz;
-        Scalar rgsq = dcbm.x*dcbm.x + dcbm.y*dcbm.y + dcbm.z*dcbm.z;
-        Scalar rg = sqrt(rgsq);
-
-        Scalar rginv, raa2inv, rbb2inv;
-        rginv = raa2inv = rbb2inv = Scalar(0.0);
-        if (rg > Scalar(0.0)) rginv = Scalar(1.0)/rg;
-        if (raasq > Scalar(0.0)) raa2inv = Scalar(1.0)/raasq;
-        if (rbbsq > Scalar(0.0)) rbb2inv = Scalar(1.0)/rbbsq;
-        Scalar rabinv = sqrt(raa2inv*rbb2inv);
-
-        Scalar c_abcd = (aax*bbx + aay*bby + aaz*bbz)*rabinv;
-        Scalar s_abcd = rg*rabinv*(aax*ddc.x + aay*ddc.y + aaz*ddc.z);
-
-        if (c_abcd > 1.0) c_abcd = 1.0;
-        if (c_abcd < -1.0) c_abcd = -1.0;
+        assert(idx[0] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[3] < m_pdata->getN() + m_pdata->getNGhosts());
 
         unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
-        int multi = (int)m_multi[dihedral_type];
-        Scalar p = Scalar(1.0);
-        Scalar dfab = Scalar(0.0);
-        Scalar ddfab;
-
-        for (int j = 0; j < multi; j++)
-            {
-            ddfab = p*c_abcd - dfab*s_abcd;
-            dfab = p*s_abcd + dfab*c_abcd;
-            p = ddfab;
-            }
-
-/////////////////////////
-// FROM LAMMPS: sin_shift is always 0... so dropping all sin_shift terms!!!!
-/////////////////////////
-
-        Scalar sign = m_sign[dihedral_type];
-        p = p*sign;
-        dfab = dfab*sign;
-        dfab *= (Scalar)-multi;
-        p += Scalar(1.0);
-
-        if (multi == 0)
-            {
-            p =  Scalar(1.0) + sign;
-            dfab = Scalar(0.0);
-            }
-
-
-        Scalar fg = dab.x*dcbm.x + dab.y*dcbm.y + dab.z*dcbm.z;
-        Scalar hg = ddc.x*dcbm.x + ddc.y*dcbm.y + ddc.z*dcbm.z;
-
-        Scalar fga = fg*raa2inv*rginv;
-        Scalar hgb = hg*rbb2inv*rginv;
-        Scalar gaa = -raa2inv*rg;
-        Scalar gbb = rbb2inv*rg;
-
-        Scalar dtfx = gaa*aax;
-        Scalar dtfy = gaa*aay;
-        Scalar dtfz = gaa*aaz;
-        Scalar dtgx = fga*aax - hgb*bbx;
-        Scalar dtgy = fga*aay - hgb*bby;
-        Scalar dtgz = fga*aaz - hgb*bbz;
-        Scalar dthx = gbb*bbx;
-        Scalar dthy = gbb*bby;
-        Scalar dthz = gbb*bbz;
-
-//      Scalar df = -m_K[dihedral.type] * dfab;
-        Scalar df = -m_K[dihedral_type] * dfab * Scalar(0.500); // the 0.5 term is for 1/2K in the forces
-
-        Scalar sx2 = df*dtgx;
-        Scalar sy2 = df*dtgy;
-        Scalar sz2 = df*dtgz;
-
-        Scalar ffax = df*dtfx;
-        Scalar ffay= df*dtfy;
-        Scalar ffaz = df*dtfz;
-
-        Scalar ffbx = sx2 - ffax;
-        Scalar ffby = sy2 - ffay;
-        Scalar ffbz = sz2 - ffaz;
-
-        Scalar ffdx = df*dthx;
-        Scalar ffdy = df*dthy;
-        Scalar ffdz = df*dthz;
-
-        Scalar ffcx = -sx2 - ffdx;
-        Scalar ffcy = -sy2 - ffdy;
-        Scalar ffcz = -sz2 - ffdz;
+        Scalar3 f[4];
+        Scalar dihedral_eng;
+        Scalar dihedral_virial[6];
+        eval_harmonic_dihedral(h_pos.data, idx, box, m_K[dihedral_type], m_sign[dihedral_type],
+            (int)m_multi[dihedral_type], f, dihedral_eng, dihedral_virial);
 
         // Now, apply the force to each individual atom a,b,c,d
         // and accumlate the energy/virial
-        // compute 1/4 of the energy, 1/4 for each atom in the dihedral
-        //Scalar dihedral_eng = p*m_K[dihedral.type]*Scalar(1.0/4.0);
-        Scalar dihedral_eng = p*m_K[dihedral_type]*Scalar(0.125);  // the .125 term is (1/2)K * 1/4
-
-        // compute 1/4 of the virial, 1/4 for each atom in the dihedral
-        // upper triangular version of virial tensor
-        Scalar dihedral_virial[6];
-        dihedral_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
-        dihedral_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
-        dihedral_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
-        dihedral_virial[3] = (1./4.)*(dab.y*ffay + dcb.y*ffcy + (ddc.y+dcb.y)*ffdy);
-        dihedral_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
-        dihedral_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
-
-        h_force.data[idx_a].x += ffax;
-        h_force.data[idx_a].y += ffay;
-        h_force.data[idx_a].z += ffaz;
-        h_force.data[idx_a].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_a]  += dihedral_virial[k];
-
-        h_force.data[idx_b].x += ffbx;
-        h_force.data[idx_b].y += ffby;
-        h_force.data[idx_b].z += ffbz;
-        h_force.data[idx_b].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_b]  += dihedral_virial[k];
-
-        h_force.data[idx_c].x += ffcx;
-        h_force.data[idx_c].y += ffcy;
-        h_force.data[idx_c].z += ffcz;
-        h_force.data[idx_c].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_c]  += dihedral_virial[k];
-
-        h_force.data[idx_d].x += ffdx;
-        h_force.data[idx_d].y += ffdy;
-        h_force.data[idx_d].z += ffdz;
-        h_force.data[idx_d].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-           h_virial.data[virial_pitch*k+idx_d]  += dihedral_virial[k];
+        for (unsigned int m = 0; m < 4; m++)
+            {
+            h_force.data[idx[m]].x += f[m].x;
+            h_force.data[idx[m]].y += f[m].y;
+            h_force.data[idx[m]].z += f[m].z;
+            h_force.data[idx[m]].w += dihedral_eng;
+            for (int k = 0; k < 6; k++)
+               h_virial.data[virial_pitch*k+idx[m]]  += dihedral_virial[k];
+            }
        }
 
     if (m_prof) m_prof->pop();
@@ -13,6 +13,10 @@
 #include <stdexcept>
 #include <math.h>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -108,8 +112,134 @@ Scalar HarmonicImproperForceCompute::getLogValue(const std::string& quantity, un
         }
     }
 
+/*! \param h_pos Particle positions
+    \param idx Indices of the particles a, b, c and d
+    \param box Box for the minimum image convention
+    \param K Stiffness of the improper
+    \param chi Equilibrium angle of the improper
+    \param f Set to the force on a, b, c and d
+    \param improper_eng Set to the energy of each member, 1/4 of the improper energy
+    \param improper_virial Set to the virial of each member, 1/4 of the improper virial
+*/
+static inline void eval_harmonic_improper(const Scalar4 *h_pos, const unsigned int *idx, const BoxDim& box, Scalar K,
+    Scalar chi, Scalar3 *f, Scalar& improper_eng, Scalar *improper_virial)
+    {
+    unsigned int idx_a = idx[0];
+    unsigned int idx_b = idx[1];
+    unsigned int idx_c = idx[2];
+    unsigned int idx_d = idx[3];
+
+    // calculate d\vec{r}
+    Scalar3 dab;
+    dab.x = h_pos[idx_a].x - h_pos[idx_b].x;
+    dab.y = h_pos[idx_a].y - h_pos[idx_b].y;
+    dab.z = h_pos[idx_a].z - h_pos[idx_b].z;
+
+    Scalar3 dcb;
+    dcb.x = h_pos[idx_c].x - h_pos[idx_b].x;
+    dcb.y = h_pos[idx_c].y - h_pos[idx_b].y;
+    dcb.z = h_pos[idx_c].z - h_pos[idx_b].z;
+
+    Scalar3 ddc;
+    ddc.x = h_pos[idx_d].x - h_pos[idx_c].x;
+    ddc.y = h_pos[idx_d].y - h_pos[idx_c].y;
+    ddc.z = h_pos[idx_d].z - h_pos[idx_c].z;
+
+    // apply periodic boundary conditions
+    dab = box.minImage(dab);
+    dcb = box.minImage(dcb);
+    ddc = box.minImage(ddc);
+
+    Scalar ss1 = 1.0 / (dab.x*dab.x + dab.y*dab.y + dab.z*dab.z);
+    Scalar ss2 = 1.0 / (dcb.x*dcb.x + dcb.y*dcb.y + dcb.z*dcb.z);
+    Scalar ss3 = 1.0 / (ddc.x*ddc.x + ddc.y*ddc.y + ddc.z*ddc.z);
+
+    Scalar r1 = sqrt(ss1);
+    Scalar r2 = sqrt(ss2);
+    Scalar r3 = sqrt(ss3);
+
+    // Cosine and Sin of the angle between the planes
+    Scalar c0 = (dab.x*ddc.x + dab.y*ddc.y + dab.z*ddc.z)* r1 * r3;
+    Scalar c1 = (dab.x*dcb.x + dab.y*dcb.y + dab.z*dcb.z)* r1 * r2;
+    Scalar c2 = -(ddc.x*dcb.x + ddc.y*dcb.y + ddc.z*dcb.z)* r3 * r2;
+
+    Scalar s1 = 1.0 - c1*c1;
+    if (s1 < SMALL) s1 = SMALL;
+    s1 = 1.0 / s1;
+
+    Scalar s2 = 1.0 - c2*c2;
+    if (s2 < SMALL) s2 = SMALL;
+    s2 = 1.0 / s2;
+
+    Scalar s12 = sqrt(s1*s2);
+    Scalar c = (c1*c2 + c0) * s12;
+
+    if (c > 1.0) c = 1.0;
+    if (c < -1.0) c = -1.0;
+
+    Scalar s = sqrt(1.0 - c*c);
+    if (s < SMALL) s = SMALL;
+
+    Scalar domega = acos(c) - chi;
+    Scalar a = K * domega;
+
+    // calculate the energy, 1/4th for each atom
+    //Scalar improper_eng = Scalar(0.25)*a*domega;
+    improper_eng = Scalar(0.125)*a*domega; // the .125 term is 1/2 * 1/4
+    //a = -a * 2.0/s;
+    a = -a / s; // the missing 2.0 factor is to ensure K/2 is factored in for the forces
+    c = c * a;
+
+    s12 = s12 * a;
+    Scalar a11 = c*ss1*s1;
+    Scalar a22 = -ss2 * (2.0*c0*s12 - c*(s1+s2));
+    Scalar a33 = c*ss3*s2;
+
+    Scalar a12 = -r1*r2*(c1*c*s1 + c2*s12);
+    Scalar a13 = -r1*r3*s12;
+    Scalar a23 = r2*r3*(c2*c*s2 + c1*s12);
+
+    Scalar sx2  = a22*dcb.x + a23*ddc.x + a12*dab.x;
+    Scalar sy2  = a22*dcb.y + a23*ddc.y + a12*dab.y;
+    Scalar sz2  = a22*dcb.z + a23*ddc.z + a12*dab.z;
+
+    // calculate the forces for each particle
+    Scalar ffax = a12*dcb.x + a13*ddc.x + a11*dab.x;
+    Scalar ffay = a12*dcb.y + a13*ddc.y + a11*dab.y;
+    Scalar ffaz = a12*dcb.z + a13*ddc.z + a11*dab.z;
+
+    Scalar ffbx = -sx2 - ffax;
+    Scalar ffby = -sy2 - ffay;
+    Scalar ffbz = -sz2 - ffaz;
+
+    Scalar ffdx = a23*dcb.x + a33*ddc.x + a13*dab.x;
+    Scalar ffdy = a23*dcb.y + a33*ddc.y + a13*dab.y;
+    Scalar ffdz = a23*dcb.z + a33*ddc.z + a13*dab.z;
+
+    Scalar ffcx = sx2 - ffdx;
+    Scalar ffcy = sy2 - ffdy;
+    Scalar ffcz = sz2 - ffdz;
+
+    // and calculate the virial (upper triangular version)
+    // compute 1/4 of the virial, 1/4 for each atom in the improper
+    improper_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
+    improper_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
+    improper_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
+    improper_virial[3] = (1./4.)*(dab.y*ffay + dcb.y*ffcy + (ddc.y+dcb.y)*ffdy);
+    improper_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
+    improper_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
+
+    f[0] = make_scalar3(ffax, ffay, ffaz);
+    f[1] = make_scalar3(ffbx, ffby, ffbz);
+    f[2] = make_scalar3(ffcx, ffcy, ffcz);
+    f[3] = make_scalar3(ffdx, ffdy, ffdz);
+    }
+
 /*! Actually perform the force computation
     \param timestep Current time step
+
+    With more than one OpenMP thread, every local particle gathers the impropers it is part of from the per-particle
+    table of the ImproperData (as on the GPU), so that the threads never write to the same particle.
  */
 void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     {
@@ -137,6 +267,50 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    if (n_threads > 1)
+        {
+        // the table is rebuilt on access if needed, and reports incomplete impropers
+        ArrayHandle<ImproperData::members_t> h_table(m_improper_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_table_pos(m_improper_data->getGPUPosTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_impropers(m_improper_data->getNGroupsArray(), access_location::host, access_mode::read);
+        const Index2D& table_indexer = m_improper_data->getGPUTableIndexer();
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)m_pdata->getN(); i++)
+            {
+            for (unsigned int k = 0; k < h_n_impropers.data[i]; k++)
+                {
+                const ImproperData::members_t& entry = h_table.data[table_indexer(i, k)];
+                unsigned int cur_pos = h_table_pos.data[table_indexer(i, k)];
+
+                unsigned int idx[4];
+                get_group_members<4>(entry, cur_pos, i, idx);
+
+                unsigned int improper_type = entry.idx[3];
+                Scalar3 f[4];
+                Scalar improper_eng;
+                Scalar improper_virial[6];
+                eval_harmonic_improper(h_pos.data, idx, box, m_K[improper_type], m_chi[improper_type], f, improper_eng,
+                    improper_virial);
+
+                h_force.data[i].x += f[cur_pos].x;
+                h_force.data[i].y += f[cur_pos].y;
+                h_force.data[i].z += f[cur_pos].z;
+                h_force.data[i].w += improper_eng;
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j*virial_pitch+i]  += improper_virial[j];
+                }
+            }
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // for each of the impropers
     const unsigned int size = (unsigned int)m_improper_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -150,13 +324,12 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
 
         // transform a, b, and c into indicies into the particle data arrays
         // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[improper.tag[0]];
-        unsigned int idx_b = h_rtag.data[improper.tag[1]];
-        unsigned int idx_c = h_rtag.data[improper.tag[2]];
-        unsigned int idx_d = h_rtag.data[improper.tag[3]];
+        unsigned int idx[4];
+        for (unsigned int j = 0; j < 4; j++)
+            idx[j] = h_rtag.data[improper.tag[j]];
 
         // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL || idx[3] == NOT_LOCAL)
             {
             this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
                 improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
@@ -164,152 +337,30 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
             throw std::runtime_error("Error in improper calculation");
             }
 
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 ddc;
-        ddc.x = h_pos.data[idx_d].x - h_pos.data[idx_c].x;
-        ddc.y = h_pos.data[idx_d].y - h_pos.data[idx_c].y;
-        ddc.z = h_pos.data[idx_d].z - h_pos.data[idx_c].z;
-
-        // apply periodic boundary conditions
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        ddc = box.minImage(ddc);
-
-        Scalar ss1 = 1.0 / (dab.x*dab.x + dab.y*dab.y + dab.z*dab.z);
-        Scalar ss2 = 1.0 / (dcb.x*dcb.x + dcb.y*dcb.y + dcb.z*dcb.z);
-        Scalar ss3 = 1.0 / (ddc.x*ddc.x + ddc.y*ddc.y + ddc.z*ddc.z);
-
-        Scalar r1 = sqrt(ss1);
-        Scalar r2 = sqrt(ss2);
-        Scalar r3 = sqrt(ss3);
-
-        // Cosine and Sin of the angle between the planes
-        Scalar c0 = (dab.x*ddc.x + dab.y*ddc.y + dab.z*ddc.z)* r1 * r3;
-        Scalar c1 = (dab.x*dcb.x + dab.y*dcb.y + dab.z*dcb.z)* r1 * r2;
-        Scalar c2 = -(ddc.x*dcb.x + ddc.y*dcb.y + ddc.z*dcb.z)* r3 * r2;
-
-        Scalar s1 = 1.0 - c1*c1;
-        if (s1 < SMALL) s1 = SMALL;
-        s1 = 1.0 / s1;
-
-        Scalar s2 = 1.0 - c2*c2;
-        if (s2 < SMALL) s2 = SMALL;
-        s2 = 1.0 / s2;
-
-        Scalar s12 = sqrt(s1*s2);
-        Scalar c = (c1*c2 + c0) * s12;
-
-        if (c > 1.0) c = 1.0;
-        if (c < -1.0) c = -1.0;
-
-        Scalar s = sqrt(1.0 - c*c);
-        if (s < SMALL) s = SMALL;
+        assert(idx[0] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[3] < m_pdata->getN() + m_pdata->getNGhosts());
 
         unsigned int improper_type = m_improper_data->getTypeByIndex(i);
-        Scalar domega = acos(c) - m_chi[improper_type];
-        Scalar a = m_K[improper_type] * domega;
-
-        // calculate the energy, 1/4th for each atom
-        //Scalar improper_eng = Scalar(0.25)*a*domega;
-        Scalar improper_eng = Scalar(0.125)*a*domega; // the .125 term is 1/2 * 1/4
-        //a = -a * 2.0/s;
-        a = -a / s; // the missing 2.0 factor is to ensure K/2 is factored in for the forces
-        c = c * a;
-
-        s12 = s12 * a;
-        Scalar a11 = c*ss1*s1;
-        Scalar a22 = -ss2 * (2.0*c0*s12 - c*(s1+s2));
-        Scalar a33 = c*ss3*s2;
-
-        Scalar a12 = -r1*r2*(c1*c*s1 + c2*s12);
-        Scalar a13 = -r1*r3*s12;
-        Scalar a23 = r2*r3*(c2*c*s2 + c1*s12);
-
-        Scalar sx2  = a22*dcb.x + a23*ddc.x + a12*dab.x;
-        Scalar sy2  = a22*dcb.y + a23*ddc.y + a12*dab.y;
-        Scalar sz2  = a22*dcb.z + a23*ddc.z + a12*dab.z;
-
-        // calculate the forces for each particle
-        Scalar ffax = a12*dcb.x + a13*ddc.x + a11*dab.x;
-        Scalar ffay = a12*dcb.y + a13*ddc.y + a11*dab.y;
-        Scalar ffaz = a12*dcb.z + a13*ddc.z + a11*dab.z;
-
-        Scalar ffbx = -sx2 - ffax;
-        Scalar ffby = -sy2 - ffay;
-        Scalar ffbz = -sz2 - ffaz;
-
-        Scalar ffdx = a23*dcb.x + a33*ddc.x + a13*dab.x;
-        Scalar ffdy = a23*dcb.y + a33*ddc.y + a13*dab.y;
-        Scalar ffdz = a23*dcb.z + a33*ddc.z + a13*dab.z;
-
-        Scalar ffcx = sx2 - ffdx;
-        Scalar ffcy = sy2 - ffdy;
-        Scalar ffcz = sz2 - ffdz;
-
-        // and calculate the virial (upper triangular version)
-        // compute 1/4 of the virial, 1/4 for each atom in the improper
+        Scalar3 f[4];
+        Scalar improper_eng;
         Scalar improper_virial[6];
-        improper_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
-        improper_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
-        improper_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
-        improper_virial[3] = (1./4.)*(dab.y*ffay + dcb.y*ffcy + (ddc.y+dcb.y)*ffdy);
-        improper_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
-        improper_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
-
-        if (idx_a < m_pdata->getN())
-            {
-            // accumulate the forces
-            h_force.data[idx_a].x += ffax;
-            h_force.data[idx_a].y += ffay;
-            h_force.data[idx_a].z += ffaz;
-            h_force.data[idx_a].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_a]  += improper_virial[k];
-            }
-
-        if (idx_b < m_pdata->getN())
-            {
-            h_force.data[idx_b].x += ffbx;
-            h_force.data[idx_b].y += ffby;
-            h_force.data[idx_b].z += ffbz;
-            h_force.data[idx_b].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_b]  += improper_virial[k];
-            }
+        eval_harmonic_improper(h_pos.data, idx, box, m_K[improper_type], m_chi[improper_type], f, improper_eng,
+            improper_virial);
 
-        if (idx_c < m_pdata->getN())
+        // accumulate the forces, do not update ghost particles
+        for (unsigned int m = 0; m < 4; m++)
             {
-            h_force.data[idx_c].x += ffcx;
-            h_force.data[idx_c].y += ffcy;
-            h_force.data[idx_c].z += ffcz;
-            h_force.data[idx_c].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_c]  += improper_virial[k];
-            }
+            if (idx[m] >= m_pdata->getN())
+                continue;
 
-        if (idx_d < m_pdata->getN())
-            {
-            h_force.data[idx_d].x += ffdx;
-            h_force.data[idx_d].y += ffdy;
-            h_force.data[idx_d].z += ffdz;
-            h_force.data[idx_d].w += improper_eng;
+            h_force.data[idx[m]].x += f[m].x;
+            h_force.data[idx[m]].y += f[m].y;
+            h_force.data[idx[m]].z += f[m].z;
+            h_force.data[idx[m]].w += improper_eng;
             for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_d]  += improper_virial[k];
+                h_virial.data[k*virial_pitch+idx[m]]  += improper_virial[k];
             }
         }
 
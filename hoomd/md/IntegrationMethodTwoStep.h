@@ -8,6 +8,7 @@
 #include "hoomd/ParticleGroup.h"
 #include "hoomd/Profiler.h"
 
+#include <iostream>
 #include <memory>
 
 #ifndef __INTEGRATION_METHOD_TWO_STEP_H__
@@ -185,6 +186,16 @@ class IntegrationMethodTwoStep
         //! Validate that all members in the particle group are valid (throw an exception if they are not)
         virtual void validateGroup();
 
+        //! Write state that is not kept in IntegratorData to a checkpoint
+        virtual void writeCheckpoint(std::ostream& out)
+            {
+            }
+
+        //! Read the state written by writeCheckpoint()
+        virtual void readCheckpoint(std::istream& in)
+            {
+            }
+
 #ifdef ENABLE_MPI
         //! Set the communicator to use
         /*! \param comm MPI communication class
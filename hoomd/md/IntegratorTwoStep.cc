@@ -10,6 +10,7 @@
 
 
 #include "IntegratorTwoStep.h"
+#include "hoomd/Checkpoint.h"
 
 namespace py = pybind11;
 
@@ -92,6 +93,9 @@ Scalar IntegratorTwoStep::getLogValue(const std::string& quantity, unsigned int
     \post All integration methods previously added with addIntegrationMethod() are applied in order to move the system
           state variables forward to \a timestep+1.
     \post Internally, all forces added via Integrator::addForceCompute are evaluated at \a timestep+1
+
+    Forces with an evaluation stride are only evaluated when \a timestep+1 is a multiple of it, scaled by the stride
+    (impulse r-RESPA, see Integrator). The integration methods are unchanged and act as the inner integrator.
 */
 void IntegratorTwoStep::update(unsigned int timestep)
     {
@@ -321,6 +325,18 @@ void IntegratorTwoStep::setAnisotropicMode(AnisotropicMode mode)
 */
 void IntegratorTwoStep::prepRun(unsigned int timestep)
     {
+    // slow forces only enter the virial on their outer steps, a barostat would see the wrong pressure in between
+    if (hasForceStrides())
+        {
+        PDataFlags flags = getRequestedPDataFlags();
+        if (flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial])
+            {
+            m_exec_conf->msg->error() << "integrate.mode_standard: Force strides (RESPA) cannot be used with "
+                                      << "integration methods that control the pressure" << endl;
+            throw std::runtime_error("Error preparing run");
+            }
+        }
+
     bool aniso = false;
 
     // set (an-)isotropic integration mode
@@ -428,6 +444,35 @@ void IntegratorTwoStep::setAutotunerParams(bool enable, unsigned int period)
             (*method)->setAutotunerParams(enable, period);
     }
 
+/*! \param out Checkpoint stream
+
+    Writes the number of integration methods followed by the state of each method, in the order they were added.
+*/
+void IntegratorTwoStep::writeCheckpoint(std::ostream& out)
+    {
+    checkpoint_write(out, (unsigned int)m_methods.size());
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        m_methods[i]->writeCheckpoint(out);
+    }
+
+/*! \param in Checkpoint stream
+
+    Sets the failbit of \a in if the checkpoint was written with a different number of integration methods.
+*/
+void IntegratorTwoStep::readCheckpoint(std::istream& in)
+    {
+    unsigned int n_methods = 0;
+    checkpoint_read(in, n_methods);
+    if (!in.good() || n_methods != m_methods.size())
+        {
+        in.setstate(std::ios::failbit);
+        return;
+        }
+
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        m_methods[i]->readCheckpoint(in);
+    }
+
 void export_IntegratorTwoStep(py::module& m)
     {
     py::class_<IntegratorTwoStep, std::shared_ptr<IntegratorTwoStep> >(m, "IntegratorTwoStep", py::base<Integrator>())
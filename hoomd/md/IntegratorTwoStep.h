@@ -111,6 +111,12 @@ class IntegratorTwoStep : public Integrator
 
         //! Set autotuner parameters
         virtual void setAutotunerParams(bool enable, unsigned int period);
+
+        //! Write the state of the integration methods to a checkpoint
+        virtual void writeCheckpoint(std::ostream& out);
+
+        //! Read the state of the integration methods from a checkpoint
+        virtual void readCheckpoint(std::istream& in);
     protected:
         //! Helper method to test if all added methods have valid restart information
         bool isValidRestart();
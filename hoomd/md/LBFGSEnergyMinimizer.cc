@@ -0,0 +1,196 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "LBFGSEnergyMinimizer.h"
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file LBFGSEnergyMinimizer.cc
+    \brief Contains code for the LBFGSEnergyMinimizer class
+*/
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param group The group of particles to minimize the energy of
+    \param max_step Maximum displacement of a particle in one line search
+    \param history Number of pairs to store
+*/
+LBFGSEnergyMinimizer::LBFGSEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef,
+                                           std::shared_ptr<ParticleGroup> group,
+                                           Scalar max_step,
+                                           unsigned int history)
+    : LineSearchEnergyMinimizer(sysdef, group, max_step, Scalar(0.9)), m_history(history)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LBFGSEnergyMinimizer" << endl;
+
+    if (m_history == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.mode_minimize_lbfgs: history should be > 0" << endl;
+        throw runtime_error("Error initializing LBFGSEnergyMinimizer");
+        }
+
+    GPUArray<Scalar3> s(m_pdata->getMaxN(), m_history, m_exec_conf);
+    m_s.swap(s);
+    GPUArray<Scalar3> y(m_pdata->getMaxN(), m_history, m_exec_conf);
+    m_y.swap(y);
+    m_s.setTag("LBFGSEnergyMinimizer::m_s");
+    m_y.setTag("LBFGSEnergyMinimizer::m_y");
+    m_rho.resize(m_history);
+
+    m_pdata->getParticleReorder().addArray(m_s, m_history);
+    m_pdata->getParticleReorder().addArray(m_y, m_history);
+    m_pdata->getMaxParticleNumberChangeSignal().connect<LBFGSEnergyMinimizer, &LBFGSEnergyMinimizer::reallocate>(this);
+
+    resetHistory();
+    }
+
+LBFGSEnergyMinimizer::~LBFGSEnergyMinimizer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LBFGSEnergyMinimizer" << endl;
+
+    m_pdata->getParticleReorder().removeArray(&m_s);
+    m_pdata->getParticleReorder().removeArray(&m_y);
+    m_pdata->getMaxParticleNumberChangeSignal().disconnect<LBFGSEnergyMinimizer, &LBFGSEnergyMinimizer::reallocate>(this);
+    }
+
+void LBFGSEnergyMinimizer::reallocate()
+    {
+    // the base class invalidates the vectors, which discards the pairs
+    m_s.resize(m_pdata->getMaxN(), m_history);
+    m_y.resize(m_pdata->getMaxN(), m_history);
+    }
+
+void LBFGSEnergyMinimizer::resetHistory()
+    {
+    m_n_pairs = 0;
+    m_head = 0;
+    m_gamma = Scalar(1.0);
+    }
+
+/*! \param alpha Step from the start of the previous search to the current point
+
+    Stores the pair s = alpha d_old, y = g - g_old and applies the two-loop recursion to g.
+*/
+void LBFGSEnergyMinimizer::computeDirection(Scalar alpha)
+    {
+    unsigned int group_size = m_group->getNumMembers();
+
+    // store the new pair if the curvature along it is positive
+        {
+        ArrayHandle<Scalar3> h_g(m_g, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_g0(m_g0, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+
+        // s.y and y.y
+        double sums[2];
+        sums[0] = 0.0;
+        sums[1] = 0.0;
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            Scalar3 s = alpha*h_d.data[j];
+            Scalar3 y = h_g.data[j] - h_g0.data[j];
+            sums[0] += s.x*y.x + s.y*y.y + s.z*y.z;
+            sums[1] += y.x*y.x + y.y*y.y + y.z*y.z;
+            }
+        reduceSum(sums, 2);
+
+        if (sums[0] > 0.0 && sums[1] > 0.0)
+            {
+            ArrayHandle<Scalar3> h_s(m_s, access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar3> h_y(m_y, access_location::host, access_mode::readwrite);
+            Scalar3 *s = h_s.data + m_head*m_s.getPitch();
+            Scalar3 *y = h_y.data + m_head*m_y.getPitch();
+
+            for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+                {
+                unsigned int j = m_group->getMemberIndex(group_idx);
+                s[j] = alpha*h_d.data[j];
+                y[j] = h_g.data[j] - h_g0.data[j];
+                }
+
+            m_rho[m_head] = Scalar(1.0/sums[0]);
+            m_gamma = Scalar(sums[0]/sums[1]);
+            m_head = (m_head + 1) % m_history;
+            m_n_pairs = std::min(m_n_pairs + 1, m_history);
+            }
+
+        // the recursion works on d, starting from the gradient
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_d.data[j] = h_g.data[j];
+            }
+        }
+
+    // first loop, from the newest to the oldest pair
+    std::vector<Scalar> a(m_n_pairs);
+    for (unsigned int k = 0; k < m_n_pairs; k++)
+        {
+        unsigned int row = (m_head + m_history - 1 - k) % m_history;
+        a[k] = m_rho[row]*dot(m_s, row, m_d, 0);
+
+        ArrayHandle<Scalar3> h_y(m_y, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+        const Scalar3 *y = h_y.data + row*m_y.getPitch();
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_d.data[j] -= a[k]*y[j];
+            }
+        }
+
+        {
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_d.data[j] *= m_gamma;
+            }
+        }
+
+    // second loop, from the oldest to the newest pair
+    for (int k = int(m_n_pairs) - 1; k >= 0; k--)
+        {
+        unsigned int row = (m_head + m_history - 1 - k) % m_history;
+        Scalar b = m_rho[row]*dot(m_y, row, m_d, 0);
+
+        ArrayHandle<Scalar3> h_s(m_s, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+        const Scalar3 *s = h_s.data + row*m_s.getPitch();
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_d.data[j] += (a[k] - b)*s[j];
+            }
+        }
+
+    // the search direction is -H g
+        {
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_d.data[j] = -h_d.data[j];
+            }
+        }
+    }
+
+/*! \param dE0 Slope of the energy along the new direction
+    \returns The unit step of the quasi-Newton method
+*/
+Scalar LBFGSEnergyMinimizer::getInitialStep(Scalar dE0)
+    {
+    return Scalar(1.0);
+    }
+
+void export_LBFGSEnergyMinimizer(py::module& m)
+    {
+    py::class_<LBFGSEnergyMinimizer, std::shared_ptr<LBFGSEnergyMinimizer> >(m, "LBFGSEnergyMinimizer", py::base<LineSearchEnergyMinimizer>())
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::shared_ptr<ParticleGroup>, Scalar, unsigned int >())
+        .def("getHistory", &LBFGSEnergyMinimizer::getHistory)
+        ;
+    }
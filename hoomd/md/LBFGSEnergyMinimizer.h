@@ -0,0 +1,74 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "LineSearchEnergyMinimizer.h"
+
+#include <vector>
+
+#ifndef __LBFGS_ENERGY_MINIMIZER_H__
+#define __LBFGS_ENERGY_MINIMIZER_H__
+
+/*! \file LBFGSEnergyMinimizer.h
+    \brief Declares the LBFGSEnergyMinimizer class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Minimizes the energy with the limited memory BFGS method
+/*! The search direction is d = -H g, where the inverse Hessian H is approximated from the displacements s and the
+    changes of the gradient y of the last m accepted steps with the two-loop recursion (Nocedal, Math. Comp. 35, 1980).
+    The initial approximation is H0 = s.y / y.y of the most recent pair, so that the unit step is usually accepted by
+    the line search. Pairs with s.y <= 0 are skipped.
+
+    The pairs are stored in two per-particle arrays with m rows each.
+
+    \ingroup updaters
+*/
+class LBFGSEnergyMinimizer : public LineSearchEnergyMinimizer
+    {
+    public:
+        //! Constructs the minimizer and associates it with the system
+        LBFGSEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<ParticleGroup> group,
+                             Scalar max_step,
+                             unsigned int history);
+        virtual ~LBFGSEnergyMinimizer();
+
+        //! Get the number of stored pairs
+        unsigned int getHistory() const
+            {
+            return m_history;
+            }
+
+    protected:
+        //! Compute the quasi-Newton search direction
+        virtual void computeDirection(Scalar alpha);
+
+        //! Discard the stored pairs
+        virtual void resetHistory();
+
+        //! Get the first step to try along a new search direction
+        virtual Scalar getInitialStep(Scalar dE0);
+
+    private:
+        unsigned int m_history;         //!< Maximum number of stored pairs
+        unsigned int m_n_pairs;         //!< Number of stored pairs
+        unsigned int m_head;            //!< Row the next pair is stored in
+        GPUArray<Scalar3> m_s;          //!< Displacements of the stored pairs, one row per pair
+        GPUArray<Scalar3> m_y;          //!< Gradient changes of the stored pairs, one row per pair
+        std::vector<Scalar> m_rho;      //!< 1/(s.y) of the stored pairs
+        Scalar m_gamma;                 //!< Scale of the initial inverse Hessian
+
+        //! Resize the stored pairs
+        void reallocate();
+    };
+
+//! Exports the LBFGSEnergyMinimizer class to python
+void export_LBFGSEnergyMinimizer(pybind11::module& m);
+
+#endif // #ifndef __LBFGS_ENERGY_MINIMIZER_H__
@@ -0,0 +1,543 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "LineSearchEnergyMinimizer.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \file LineSearchEnergyMinimizer.cc
+    \brief Contains code for the LineSearchEnergyMinimizer class
+*/
+
+//! Maximum number of trial points in one line search
+const unsigned int LINE_SEARCH_MAX_TRIALS = 30;
+
+/*! \param sysdef SystemDefinition this method will act on. Must not be NULL.
+    \param group The group of particles to minimize the energy of
+    \param max_step Maximum displacement of a particle in one line search
+    \param c2 Curvature parameter of the line search, between 0 and 1
+*/
+LineSearchEnergyMinimizer::LineSearchEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef,
+                                                     std::shared_ptr<ParticleGroup> group,
+                                                     Scalar max_step,
+                                                     Scalar c2)
+    :   IntegratorTwoStep(sysdef, max_step),
+        m_group(group),
+        m_c1(Scalar(1e-4)),
+        m_c2(c2),
+        m_ftol(Scalar(1e-1)),
+        m_etol(Scalar(1e-3)),
+        m_run_minsteps(10),
+        m_old_energy(0),
+        m_evaluating(false),
+        m_alpha_prev(0),
+        m_dE0_prev(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LineSearchEnergyMinimizer" << endl;
+
+    // sanity check
+    assert(m_sysdef);
+    assert(m_pdata);
+
+    setMaxStep(max_step);
+
+    // the minimizer moves the particles itself
+    m_gave_warning = true;
+
+    GPUArray<Scalar3> x0(m_pdata->getMaxN(), m_exec_conf);
+    m_x0.swap(x0);
+    GPUArray<int3> image0(m_pdata->getMaxN(), m_exec_conf);
+    m_image0.swap(image0);
+    GPUArray<Scalar3> g0(m_pdata->getMaxN(), m_exec_conf);
+    m_g0.swap(g0);
+    GPUArray<Scalar3> g(m_pdata->getMaxN(), m_exec_conf);
+    m_g.swap(g);
+    GPUArray<Scalar3> d(m_pdata->getMaxN(), m_exec_conf);
+    m_d.swap(d);
+    GPUArray<unsigned int> tag(m_pdata->getMaxN(), m_exec_conf);
+    m_tag.swap(tag);
+    m_n_tag = 0;
+
+    m_x0.setTag("LineSearchEnergyMinimizer::m_x0");
+    m_image0.setTag("LineSearchEnergyMinimizer::m_image0");
+    m_g0.setTag("LineSearchEnergyMinimizer::m_g0");
+    m_g.setTag("LineSearchEnergyMinimizer::m_g");
+    m_d.setTag("LineSearchEnergyMinimizer::m_d");
+    m_tag.setTag("LineSearchEnergyMinimizer::m_tag");
+
+    // the vectors are permuted with the particles, slotParticleSort() checks any other rearrangement
+    ParticleReorder& reorder = m_pdata->getParticleReorder();
+    reorder.addArray(m_x0);
+    reorder.addArray(m_image0);
+    reorder.addArray(m_g0);
+    reorder.addArray(m_g);
+    reorder.addArray(m_d);
+    reorder.addArray(m_tag);
+    m_pdata->getParticleSortSignal().connect<LineSearchEnergyMinimizer, &LineSearchEnergyMinimizer::slotParticleSort>(this);
+    m_pdata->getMaxParticleNumberChangeSignal().connect<LineSearchEnergyMinimizer, &LineSearchEnergyMinimizer::reallocate>(this);
+
+    reset();
+    }
+
+LineSearchEnergyMinimizer::~LineSearchEnergyMinimizer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LineSearchEnergyMinimizer" << endl;
+
+    ParticleReorder& reorder = m_pdata->getParticleReorder();
+    reorder.removeArray(&m_x0);
+    reorder.removeArray(&m_image0);
+    reorder.removeArray(&m_g0);
+    reorder.removeArray(&m_g);
+    reorder.removeArray(&m_d);
+    reorder.removeArray(&m_tag);
+    m_pdata->getParticleSortSignal().disconnect<LineSearchEnergyMinimizer, &LineSearchEnergyMinimizer::slotParticleSort>(this);
+    m_pdata->getMaxParticleNumberChangeSignal().disconnect<LineSearchEnergyMinimizer, &LineSearchEnergyMinimizer::reallocate>(this);
+    }
+
+/*! \param max_step is the new maximum displacement
+*/
+void LineSearchEnergyMinimizer::setMaxStep(Scalar max_step)
+    {
+    if (!(max_step > 0.0))
+        {
+        m_exec_conf->msg->error() << "integrate.mode_minimize: max_step should be > 0" << endl;
+        throw runtime_error("Error setting parameters for LineSearchEnergyMinimizer");
+        }
+    m_max_step = max_step;
+    }
+
+void LineSearchEnergyMinimizer::reset()
+    {
+    m_converged = false;
+    m_was_reset = true;
+    m_invalid = false;
+    m_n_evaluations = 0;
+    m_n_iterations = 0;
+    m_n_restarts = 0;
+    m_searching = false;
+    m_accept_next = false;
+    m_restart_next = false;
+    m_steepest = true;
+    m_alpha_prev = Scalar(0.0);
+    m_dE0 = Scalar(0.0);
+    resetHistory();
+    }
+
+/*! The arrays keep their contents, so the vectors of the local particles remain valid when the ghost layer grows.
+*/
+void LineSearchEnergyMinimizer::reallocate()
+    {
+    m_x0.resize(m_pdata->getMaxN());
+    m_image0.resize(m_pdata->getMaxN());
+    m_g0.resize(m_pdata->getMaxN());
+    m_g.resize(m_pdata->getMaxN());
+    m_d.resize(m_pdata->getMaxN());
+    m_tag.resize(m_pdata->getMaxN());
+    }
+
+/*! A sort without a permutation during a force evaluation comes from particle migration. Migration keeps the order of
+    the particles that stay on the rank and appends the ones that arrive, so the vectors remain valid if the local tags
+    did not change.
+*/
+void LineSearchEnergyMinimizer::slotParticleSort()
+    {
+    if (m_pdata->getSortOrder() != NULL || m_invalid)
+        return;
+
+    if (!m_evaluating || m_pdata->getN() != m_n_tag)
+        {
+        m_invalid = true;
+        return;
+        }
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_stored_tag(m_tag, access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < m_n_tag; i++)
+        {
+        if (h_tag.data[i] != h_stored_tag.data[i])
+            {
+            m_invalid = true;
+            return;
+            }
+        }
+    }
+
+void LineSearchEnergyMinimizer::storeTags()
+    {
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_stored_tag(m_tag, access_location::host, access_mode::overwrite);
+    m_n_tag = m_pdata->getN();
+    memcpy(h_stored_tag.data, h_tag.data, sizeof(unsigned int)*m_n_tag);
+    }
+
+/*! \param values Values to sum, replaced by the sums
+    \param n Number of values
+*/
+void LineSearchEnergyMinimizer::reduceSum(double *values, unsigned int n)
+    {
+#ifdef ENABLE_MPI
+    if (m_comm)
+        MPI_Allreduce(MPI_IN_PLACE, values, n, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
+#endif
+    }
+
+/*! \param a First vector
+    \param row_a Row of \a a to use
+    \param b Second vector
+    \param row_b Row of \a b to use
+    \returns The sum of the dot products of \a a and \a b over all group members on all ranks
+*/
+Scalar LineSearchEnergyMinimizer::dot(const GPUArray<Scalar3>& a, unsigned int row_a,
+    const GPUArray<Scalar3>& b, unsigned int row_b)
+    {
+    ArrayHandle<Scalar3> h_a(a, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_b(b, access_location::host, access_mode::read);
+    const Scalar3 *data_a = h_a.data + row_a*a.getPitch();
+    const Scalar3 *data_b = h_b.data + row_b*b.getPitch();
+
+    double sum = 0.0;
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        sum += data_a[j].x*data_b[j].x + data_a[j].y*data_b[j].y + data_a[j].z*data_b[j].z;
+        }
+
+    reduceSum(&sum, 1);
+    return Scalar(sum);
+    }
+
+void LineSearchEnergyMinimizer::applyTrialStep()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_x0(m_x0, access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image0(m_image0, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int j = m_group->getMemberIndex(group_idx);
+        Scalar3 pos = h_x0.data[j] + m_alpha*h_d.data[j];
+        int3 image = h_image0.data[j];
+        box.wrap(pos, image);
+
+        h_pos.data[j].x = pos.x;
+        h_pos.data[j].y = pos.y;
+        h_pos.data[j].z = pos.z;
+        h_image.data[j] = image;
+        }
+    }
+
+/*! \param energy Total energy of the group at the current point
+    \param alpha Step from the start of the previous search to the current point
+    \param restart Set to true to discard the history and search along the steepest descent
+
+    Stores the gradient, computes the new direction and the first trial step, and saves the current point as the start
+    of the new search.
+*/
+void LineSearchEnergyMinimizer::beginSearch(Scalar energy, Scalar alpha, bool restart)
+    {
+    unsigned int group_size = m_group->getNumMembers();
+
+    // the gradient is the negative net force
+        {
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_g(m_g, access_location::host, access_mode::overwrite);
+
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_g.data[j] = make_scalar3(-h_net_force.data[j].x, -h_net_force.data[j].y, -h_net_force.data[j].z);
+            }
+        }
+
+    if (!restart)
+        computeDirection(alpha);
+
+    // slope along the new direction and the largest displacement per unit step
+    double sums[2];
+        {
+        ArrayHandle<Scalar3> h_g(m_g, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::readwrite);
+
+        sums[0] = 0.0;
+        sums[1] = 0.0;
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            if (restart)
+                h_d.data[j] = -h_g.data[j];
+            sums[0] += h_g.data[j].x*h_d.data[j].x + h_g.data[j].y*h_d.data[j].y + h_g.data[j].z*h_d.data[j].z;
+            }
+        reduceSum(sums, 1);
+
+        // fall back to the steepest descent if the direction does not lead downhill
+        if (!restart && !(sums[0] < 0.0))
+            {
+            m_exec_conf->msg->notice(6) << "integrate.mode_minimize: not a descent direction, restarting" << endl;
+            restart = true;
+            sums[0] = 0.0;
+            for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+                {
+                unsigned int j = m_group->getMemberIndex(group_idx);
+                h_d.data[j] = -h_g.data[j];
+                sums[0] -= h_g.data[j].x*h_g.data[j].x + h_g.data[j].y*h_g.data[j].y + h_g.data[j].z*h_g.data[j].z;
+                }
+            reduceSum(sums, 1);
+            }
+
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            double dsq = h_d.data[j].x*h_d.data[j].x + h_d.data[j].y*h_d.data[j].y + h_d.data[j].z*h_d.data[j].z;
+            sums[1] = std::max(sums[1], dsq);
+            }
+#ifdef ENABLE_MPI
+        if (m_comm)
+            MPI_Allreduce(MPI_IN_PLACE, &sums[1], 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+#endif
+        }
+
+    if (restart)
+        resetHistory();
+    m_steepest = restart;
+
+    Scalar dE0 = Scalar(sums[0]);
+    Scalar dmax = sqrt(Scalar(sums[1]));
+    if (!(dmax > Scalar(0.0)))
+        {
+        // the forces vanish, this is a stationary point
+        m_converged = true;
+        return;
+        }
+
+    m_alpha_prev = alpha;
+    m_dE0_prev = m_dE0;
+    m_dE0 = dE0;
+    m_E0 = energy;
+
+    m_alpha_max = m_max_step / dmax;
+    m_alpha = m_alpha_max;
+    if (!restart)
+        {
+        Scalar alpha_init = getInitialStep(dE0);
+        if (alpha_init > Scalar(0.0))
+            m_alpha = std::min(alpha_init, m_alpha_max);
+        }
+
+    // the current point is the start of the new search
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_x0(m_x0, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image0(m_image0, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_g0(m_g0, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_g(m_g, access_location::host, access_mode::read);
+
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            h_x0.data[j] = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            h_image0.data[j] = h_image.data[j];
+            h_g0.data[j] = h_g.data[j];
+            }
+        }
+    storeTags();
+
+    m_alpha_lo = Scalar(0.0);
+    m_E_lo = energy;
+    m_dE_lo = dE0;
+    m_alpha_hi = Scalar(0.0);
+    m_E_hi = Scalar(0.0);
+    m_n_trials = 0;
+    m_searching = true;
+    m_accept_next = false;
+    m_restart_next = false;
+    m_n_iterations++;
+    }
+
+/*! \param timestep is the current timestep
+
+    Moves the group to the current trial point, evaluates the forces and decides whether the point is accepted. At an
+    accepted point, convergence is tested and a new line search is started. Otherwise, the next trial step is chosen
+    by quadratic interpolation of the energy when the minimum has been bracketed, or by doubling the step.
+*/
+void LineSearchEnergyMinimizer::update(unsigned int timestep)
+    {
+    if (m_converged)
+        return;
+
+    unsigned int group_size = m_group->getNumMembers();
+    unsigned int group_size_global = m_group->getNumMembersGlobal();
+    if (group_size_global == 0)
+        return;
+
+    // invalid vectors restart the minimization from the current positions
+    if (m_searching && !m_invalid)
+        applyTrialStep();
+
+    // particle migration happens during the force evaluation
+    m_evaluating = true;
+    IntegratorTwoStep::update(timestep);
+    m_evaluating = false;
+    m_n_evaluations++;
+
+    if (m_prof)
+        m_prof->push("Minimize");
+
+    // total energy, slope along the search direction, squared force, and whether the vectors are invalid
+    double sums[4];
+    sums[0] = 0.0;
+    sums[1] = 0.0;
+    sums[2] = 0.0;
+    sums[3] = m_invalid ? 1.0 : 0.0;
+        {
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_d(m_d, access_location::host, access_mode::read);
+
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            Scalar4 f = h_net_force.data[j];
+            sums[0] += f.w;
+            sums[1] -= f.x*h_d.data[j].x + f.y*h_d.data[j].y + f.z*h_d.data[j].z;
+            sums[2] += f.x*f.x + f.y*f.y + f.z*f.z;
+            }
+        }
+    reduceSum(sums, 4);
+    m_invalid = false;
+
+    Scalar energy = Scalar(sums[0]);
+    Scalar dE = Scalar(sums[1]);
+
+    bool accept = false;
+    bool restart = false;
+    Scalar alpha = m_alpha;
+    if (!m_searching || sums[3] > 0.0)
+        {
+        if (m_searching)
+            m_n_restarts++;
+        accept = true;
+        restart = true;
+        alpha = Scalar(0.0);
+        }
+    else if (m_accept_next)
+        {
+        accept = true;
+        restart = m_restart_next;
+
+        // no step along the steepest descent lowered the energy
+        if (restart && m_steepest)
+            {
+            m_exec_conf->msg->notice(2) << "integrate.mode_minimize: line search failed along the steepest descent, "
+                                        << "stopping" << endl;
+            m_converged = true;
+            if (m_prof)
+                m_prof->pop();
+            return;
+            }
+        }
+    else
+        {
+        m_n_trials++;
+
+        if (energy > m_E0 + m_c1*m_alpha*m_dE0)
+            {
+            // not enough decrease, the step is too long
+            m_alpha_hi = m_alpha;
+            m_E_hi = energy;
+            }
+        else if (dE < m_c2*m_dE0 && m_alpha < m_alpha_max)
+            {
+            // still going downhill steeply, the step is too short
+            m_alpha_lo = m_alpha;
+            m_E_lo = energy;
+            m_dE_lo = dE;
+            }
+        else
+            {
+            accept = true;
+            }
+
+        if (!accept)
+            {
+            Scalar width = m_alpha_hi - m_alpha_lo;
+            if (m_n_trials >= LINE_SEARCH_MAX_TRIALS
+                || (m_alpha_hi > Scalar(0.0) && width <= Scalar(1e-10)*m_alpha_hi))
+                {
+                // give up and go back to the lowest point found, or to the start along the steepest descent
+                m_alpha = m_alpha_lo;
+                m_accept_next = true;
+                m_restart_next = (m_alpha_lo == Scalar(0.0));
+                }
+            else if (m_alpha_hi > Scalar(0.0))
+                {
+                // minimum of the parabola through E_lo, dE_lo and E_hi, kept away from the ends of the bracket
+                Scalar denom = m_E_hi - m_E_lo - m_dE_lo*width;
+                Scalar t = Scalar(0.5)*width;
+                if (denom > Scalar(0.0))
+                    t = -m_dE_lo*width*width/(Scalar(2.0)*denom);
+                t = std::min(std::max(t, Scalar(0.1)*width), Scalar(0.9)*width);
+                m_alpha = m_alpha_lo + t;
+                }
+            else
+                {
+                m_alpha = std::min(Scalar(2.0)*m_alpha, m_alpha_max);
+                }
+
+            if (m_prof)
+                m_prof->pop();
+            return;
+            }
+        }
+
+    // test for convergence at the accepted point
+    Scalar energy_per_particle = energy/Scalar(group_size_global);
+    Scalar fnorm = sqrt(Scalar(sums[2]));
+    if (m_was_reset)
+        {
+        m_was_reset = false;
+        m_old_energy = energy_per_particle + Scalar(100000)*m_etol;
+        }
+
+    if (fnorm/sqrt(Scalar(m_sysdef->getNDimensions()*group_size_global)) < m_ftol
+        && fabs(energy_per_particle-m_old_energy) < m_etol && m_n_evaluations >= m_run_minsteps)
+        {
+        m_converged = true;
+        m_searching = false;
+        }
+    else
+        {
+        m_old_energy = energy_per_particle;
+        beginSearch(energy, alpha, restart);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_LineSearchEnergyMinimizer(py::module& m)
+    {
+    py::class_<LineSearchEnergyMinimizer, std::shared_ptr<LineSearchEnergyMinimizer> >(m, "LineSearchEnergyMinimizer", py::base<IntegratorTwoStep>())
+        .def("reset", &LineSearchEnergyMinimizer::reset)
+        .def("hasConverged", &LineSearchEnergyMinimizer::hasConverged)
+        .def("setMaxStep", &LineSearchEnergyMinimizer::setMaxStep)
+        .def("setFtol", &LineSearchEnergyMinimizer::setFtol)
+        .def("setEtol", &LineSearchEnergyMinimizer::setEtol)
+        .def("setMinSteps", &LineSearchEnergyMinimizer::setMinSteps)
+        .def("getNumIterations", &LineSearchEnergyMinimizer::getNumIterations)
+        .def("getNumRestarts", &LineSearchEnergyMinimizer::getNumRestarts)
+        ;
+    }
@@ -0,0 +1,188 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "IntegratorTwoStep.h"
+
+#include <memory>
+
+#ifndef __LINE_SEARCH_ENERGY_MINIMIZER_H__
+#define __LINE_SEARCH_ENERGY_MINIMIZER_H__
+
+/*! \file LineSearchEnergyMinimizer.h
+    \brief Declares the LineSearchEnergyMinimizer class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Base class for energy minimizers that search for the minimum along a direction
+/*! \b Overview
+
+    LineSearchEnergyMinimizer moves the particles of a group from a starting point x0 along a search direction d to
+    the point x0 + alpha d, where the step alpha is chosen by a line search that fulfills the weak Wolfe conditions
+    (sufficient decrease of the energy and of the slope along d). Derived classes compute the search direction from
+    the gradient (computeDirection()) and provide the first step that is tried (getInitialStep()).
+
+    Every call to update() evaluates the forces once, at the current trial point, so the number of time steps in a
+    run() is the number of force evaluations. The line search either accepts the trial point, in which case the next
+    search starts from it, or moves the particles to the next trial point. No particle is displaced by more than
+    the maximum step size from the starting point of a search.
+
+    All sums and maxima over the group are reduced over all ranks, so the minimizer works with domain decomposition.
+    The per-particle vectors are permuted along with the particle data when the particles are sorted. Particle
+    migration during a force evaluation keeps them as long as the local particles stay the same, which is checked by
+    comparing their tags. When particles do change their rank, the vectors of those particles are lost and the
+    minimizer restarts with steepest descent from the current point, discarding the history of L-BFGS and CG. Any
+    other rearrangement (such as restoring a snapshot) also restarts the minimization.
+
+    Convergence is tested as in FIREEnergyMinimizer on every accepted point.
+
+    \ingroup updaters
+*/
+class LineSearchEnergyMinimizer : public IntegratorTwoStep
+    {
+    public:
+        //! Constructs the minimizer and associates it with the system
+        LineSearchEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef,
+                                  std::shared_ptr<ParticleGroup> group,
+                                  Scalar max_step,
+                                  Scalar c2);
+        virtual ~LineSearchEnergyMinimizer();
+
+        //! Reset the minimization
+        virtual void reset();
+
+        //! Perform one force evaluation of the minimization
+        virtual void update(unsigned int timestep);
+
+        //! Return whether or not the minimization has converged
+        bool hasConverged() const {return m_converged;}
+
+        //! Set the maximum displacement of a particle in one line search
+        void setMaxStep(Scalar max_step);
+
+        //! Set the stopping criterion based on the total force on all particles in the system
+        /*! \param ftol is the new force tolerance to set
+        */
+        void setFtol(Scalar ftol) {m_ftol = ftol;}
+
+        //! Set the stopping criterion based on the change in energy between successive iterations
+        /*! \param etol is the new energy tolerance to set
+        */
+        void setEtol(Scalar etol) {m_etol = etol;}
+
+        //! Set the a minimum number of force evaluations before the other stopping criteria will be evaluated
+        /*! \param steps is the minimum number of force evaluations
+        */
+        void setMinSteps(unsigned int steps) {m_run_minsteps = steps;}
+
+        //! Get the number of line searches since the last reset
+        unsigned int getNumIterations() const {return m_n_iterations;}
+
+        //! Get the number of restarts caused by invalidated per-particle vectors since the last reset
+        unsigned int getNumRestarts() const {return m_n_restarts;}
+
+        //! Access the group
+        std::shared_ptr<ParticleGroup> getGroup() { return m_group; }
+
+        //! Get needed pdata flags
+        /*! The line search needs the potential energy, so its flag is set
+        */
+        virtual PDataFlags getRequestedPDataFlags()
+            {
+            PDataFlags flags;
+            flags[pdata_flag::potential_energy] = 1;
+            return flags;
+            }
+
+    protected:
+        //! Compute the search direction m_d at an accepted point
+        /*! \param alpha Step from m_x0 along the old m_d to the accepted point
+
+            On entry, m_g holds the gradient at the accepted point and m_g0 and m_d the gradient and search direction
+            at the start of the previous search.
+        */
+        virtual void computeDirection(Scalar alpha) = 0;
+
+        //! Discard all information about previous searches
+        virtual void resetHistory() {}
+
+        //! Get the first step to try along a new search direction
+        /*! \param dE0 Slope of the energy along the new direction
+        */
+        virtual Scalar getInitialStep(Scalar dE0) = 0;
+
+        //! Sum values over all ranks
+        void reduceSum(double *values, unsigned int n);
+
+        //! Compute the dot product of two per-particle vectors over the group and all ranks
+        Scalar dot(const GPUArray<Scalar3>& a, unsigned int row_a, const GPUArray<Scalar3>& b, unsigned int row_b);
+
+        const std::shared_ptr<ParticleGroup> m_group;     //!< The group of particles this method works on
+        Scalar m_max_step;                  //!< maximum displacement of a particle in one line search
+        Scalar m_c1;                        //!< sufficient decrease parameter of the line search
+        Scalar m_c2;                        //!< curvature parameter of the line search
+        Scalar m_ftol;                      //!< stopping tolerance based on total force
+        Scalar m_etol;                      //!< stopping tolerance based on the chance in energy
+        unsigned int m_run_minsteps;        //!< A minimum number of force evaluations the search will use
+        Scalar m_old_energy;                //!< energy per particle at the previous accepted point
+        bool m_converged;                   //!< whether the minimization has converged
+        bool m_was_reset;                   //!< whether or not the minimizer was reset
+        bool m_invalid;                     //!< whether the per-particle vectors were invalidated
+        bool m_evaluating;                  //!< true while the forces are evaluated
+        unsigned int m_n_evaluations;       //!< number of force evaluations since the reset
+        unsigned int m_n_iterations;        //!< number of line searches since the reset
+        unsigned int m_n_restarts;          //!< number of restarts caused by invalidated vectors since the reset
+
+        bool m_searching;                   //!< true while a line search is in progress
+        bool m_accept_next;                 //!< accept the next trial point without testing it
+        bool m_restart_next;                //!< restart with steepest descent at the next accepted point
+        bool m_steepest;                    //!< true if the current direction is the steepest descent
+        unsigned int m_n_trials;            //!< number of trial points in the current line search
+        Scalar m_alpha;                     //!< current trial step
+        Scalar m_alpha_max;                 //!< largest step allowed by m_max_step
+        Scalar m_alpha_lo;                  //!< largest step known to be too short
+        Scalar m_E_lo;                      //!< total energy at m_alpha_lo
+        Scalar m_dE_lo;                     //!< slope at m_alpha_lo
+        Scalar m_alpha_hi;                  //!< smallest step known to be too long, 0 if none
+        Scalar m_E_hi;                      //!< total energy at m_alpha_hi
+        Scalar m_E0;                        //!< total energy at the start of the search
+        Scalar m_dE0;                       //!< slope at the start of the search
+        Scalar m_alpha_prev;                //!< accepted step of the previous search
+        Scalar m_dE0_prev;                  //!< slope at the start of the previous search
+
+        GPUArray<Scalar3> m_x0;             //!< positions at the start of the search
+        GPUArray<int3> m_image0;            //!< images at the start of the search
+        GPUArray<Scalar3> m_g0;             //!< gradient at the start of the search
+        GPUArray<Scalar3> m_g;              //!< gradient at the accepted point
+        GPUArray<Scalar3> m_d;              //!< search direction
+        GPUArray<unsigned int> m_tag;       //!< tags of the particles the vectors were stored for
+        unsigned int m_n_tag;               //!< number of local particles the vectors were stored for
+
+    private:
+        //! Start a new line search from the current point
+        void beginSearch(Scalar energy, Scalar alpha, bool restart);
+
+        //! Move the group to the current trial point
+        void applyTrialStep();
+
+        //! Resize the per-particle vectors
+        void reallocate();
+
+        //! Invalidate the per-particle vectors unless they were permuted with the particles
+        void slotParticleSort();
+
+        //! Record the tags of the local particles the vectors are stored for
+        void storeTags();
+    };
+
+//! Exports the LineSearchEnergyMinimizer class to python
+void export_LineSearchEnergyMinimizer(pybind11::module& m);
+
+#endif // #ifndef __LINE_SEARCH_ENERGY_MINIMIZER_H__
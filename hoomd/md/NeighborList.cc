@@ -15,6 +15,8 @@ namespace py = pybind11;
 
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
@@ -34,7 +36,11 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(_r_cut), m_rcut_min(_r_cut),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false), m_storage_mode(half),
       m_rcut_changed(true), m_updates(0), m_forced_updates(0), m_dangerous_updates(0), m_force_update(true),
-      m_dist_check(true), m_has_been_updated_once(false)
+      m_dist_check(true), m_has_been_updated_once(false), m_tune_buffer(false), m_tune_every(false),
+      m_tune_period(0), m_tune_r_min(0.0), m_tune_r_max(0.0), m_tune_window_open(false),
+      m_tune_window_start(0), m_tune_window_time(0), m_tune_build_time(0),
+      m_tune_min_period(std::numeric_limits<unsigned int>::max()), m_tune_dangerous_start(0),
+      m_tune_best_r_buff(r_buff), m_tune_best_cost(-1.0), m_tune_step(0.2), m_tune_direction(1)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
 
@@ -125,8 +131,18 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar _r_c
     m_ex_list_indexer = Index2D(m_ex_list_idx.getPitch(), 1);
     m_ex_list_indexer_tag = Index2D(m_ex_list_tag.getPitch(), 1);
 
-    // connect to particle sort to force rebuild
-    m_pdata->getParticleSortSignal().connect<NeighborList, &NeighborList::forceUpdate>(this);
+    m_nlist.setTag("NeighborList::m_nlist");
+    m_n_neigh.setTag("NeighborList::m_n_neigh");
+    m_head_list.setTag("NeighborList::m_head_list");
+    m_last_pos.setTag("NeighborList::m_last_pos");
+    m_n_ex_tag.setTag("NeighborList::m_n_ex_tag");
+    m_ex_list_tag.setTag("NeighborList::m_ex_list_tag");
+    m_n_ex_idx.setTag("NeighborList::m_n_ex_idx");
+    m_ex_list_idx.setTag("NeighborList::m_ex_list_idx");
+
+    // connect to particle sort to remap or rebuild the list, the last positions are permuted with the particles
+    m_pdata->getParticleSortSignal().connect<NeighborList, &NeighborList::slotParticleSort>(this);
+    m_pdata->getParticleReorder().addArray(m_last_pos);
 
     // connect to max particle change to resize neighborlist arrays
     m_pdata->getMaxParticleNumberChangeSignal().connect<NeighborList, &NeighborList::reallocate>(this);
@@ -179,7 +195,8 @@ NeighborList::~NeighborList()
     {
     m_exec_conf->msg->notice(5) << "Destroying Neighborlist" << endl;
 
-    m_pdata->getParticleSortSignal().disconnect<NeighborList, &NeighborList::forceUpdate>(this);
+    m_pdata->getParticleSortSignal().disconnect<NeighborList, &NeighborList::slotParticleSort>(this);
+    m_pdata->getParticleReorder().removeArray(&m_last_pos);
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<NeighborList, &NeighborList::reallocate>(this);
     m_pdata->getGlobalParticleNumberChangeSignal().disconnect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 #ifdef ENABLE_MPI
@@ -225,6 +242,12 @@ void NeighborList::compute(unsigned int timestep)
     // check if the list needs to be updated and update it
     if (needsUpdating(timestep))
         {
+        uint64_t build_start = m_tune_buffer ? m_tune_clock.getTime() : 0;
+
+        // the buffer tuning may have changed r_buff in needsUpdating()
+        if (m_rcut_changed)
+            updateRList();
+
         // rebuild the list until there is no overflow
         bool overflowed = false;
         do
@@ -248,6 +271,9 @@ void NeighborList::compute(unsigned int timestep)
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+
+        if (m_tune_buffer)
+            m_tune_build_time += m_tune_clock.getTime() - build_start;
         }
     if (m_prof) m_prof->pop();
     }
@@ -1056,6 +1082,11 @@ bool NeighborList::needsUpdating(unsigned int timestep)
 
     m_last_checked_tstep = timestep;
 
+    // the first check of a time step comes before the particles are migrated, so a new r_buff chosen here is
+    // used for the ghost layer and the (forced) rebuild of this step
+    if (m_tune_buffer)
+        tuneBuffer(timestep);
+
     if (!m_force_update && !shouldCheckDistance(timestep))
         {
         m_last_check_result = false;
@@ -1105,6 +1136,8 @@ bool NeighborList::needsUpdating(unsigned int timestep)
             if (timestep > m_last_updated_tstep)
                 {
                 unsigned int period = timestep - m_last_updated_tstep;
+                if (period < m_tune_min_period)
+                    m_tune_min_period = period;
                 if (period >= m_update_periods.size())
                     period = m_update_periods.size()-1;
                 m_update_periods[period]++;
@@ -1173,6 +1206,11 @@ void NeighborList::resetStats()
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
+
+    // start a new tuning window, and measure the current r_buff again since the system may have changed
+    m_tune_window_open = false;
+    m_tune_best_r_buff = m_r_buff;
+    m_tune_best_cost = -1.0;
     }
 
 unsigned int NeighborList::getSmallestRebuild()
@@ -1185,6 +1223,148 @@ unsigned int NeighborList::getSmallestRebuild()
     return m_update_periods.size();
     }
 
+/*! \param enable Set to true to tune r_buff (and optionally the check period) at runtime
+    \param period Number of time steps in each tuning window
+    \param r_buff_min Smallest r_buff the tuner may set
+    \param r_buff_max Largest r_buff the tuner may set
+    \param tune_every Set to true to also tune the check period
+
+    The current r_buff is the starting point of the search and is clamped to [r_buff_min, r_buff_max].
+*/
+void NeighborList::setBufferTuning(bool enable, unsigned int period, Scalar r_buff_min, Scalar r_buff_max, bool tune_every)
+    {
+    if (enable)
+        {
+        if (period == 0)
+            {
+            m_exec_conf->msg->error() << "nlist: The tuning period must be positive" << endl;
+            throw runtime_error("Error changing NeighborList parameters");
+            }
+        if (r_buff_min < 0.0 || r_buff_max < r_buff_min)
+            {
+            m_exec_conf->msg->error() << "nlist: Invalid r_buff range for tuning: [" << r_buff_min << ", "
+                                      << r_buff_max << "]" << endl;
+            throw runtime_error("Error changing NeighborList parameters");
+            }
+        }
+
+    m_tune_buffer = enable;
+    m_tune_period = period;
+    m_tune_r_min = r_buff_min;
+    m_tune_r_max = r_buff_max;
+    m_tune_every = tune_every;
+
+    m_tune_window_open = false;
+    m_tune_best_cost = -1.0;
+    m_tune_step = Scalar(0.2);
+    m_tune_direction = 1;
+
+    if (enable && (m_r_buff < r_buff_min || m_r_buff > r_buff_max))
+        setRBuff(std::min(std::max(m_r_buff, r_buff_min), r_buff_max));
+    m_tune_best_r_buff = m_r_buff;
+    }
+
+/*! \param timestep Current time step
+
+    Called at the first rebuild check of each time step. When the current window has lasted at least m_tune_period
+    steps, its wall clock time per step is compared against the best one so far to choose the next r_buff, and the
+    rebuild statistics of the window set the next check period. All ranks reduce the measurements so that they make the
+    same choice.
+*/
+void NeighborList::tuneBuffer(unsigned int timestep)
+    {
+    uint64_t now = m_tune_clock.getTime();
+
+    if (!m_tune_window_open || timestep < m_tune_window_start)
+        {
+        m_tune_window_open = true;
+        m_tune_window_start = timestep;
+        m_tune_window_time = now;
+        m_tune_build_time = 0;
+        m_tune_min_period = std::numeric_limits<unsigned int>::max();
+        m_tune_dangerous_start = m_dangerous_updates;
+        return;
+        }
+
+    unsigned int n_steps = timestep - m_tune_window_start;
+    if (n_steps < m_tune_period)
+        return;
+
+    double cost = double(now - m_tune_window_time) / double(n_steps);
+    double build_cost = double(m_tune_build_time) / double(n_steps);
+    unsigned int min_period = m_tune_min_period;
+    unsigned int dangerous = (m_dangerous_updates > m_tune_dangerous_start) ? 1 : 0;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // the slowest rank sets the pace
+        MPI_Allreduce(MPI_IN_PLACE, &cost, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &build_cost, 1, MPI_DOUBLE, MPI_MAX, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &min_period, 1, MPI_UNSIGNED, MPI_MIN, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &dangerous, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    Scalar r_buff = m_r_buff;
+    if (m_tune_best_cost < 0.0 || cost < m_tune_best_cost)
+        {
+        // keep going in the same direction, and take larger steps after repeated improvements
+        if (m_tune_best_cost >= 0.0)
+            m_tune_step = std::min(m_tune_step * Scalar(1.5), Scalar(0.5));
+        m_tune_best_r_buff = r_buff;
+        m_tune_best_cost = cost;
+        }
+    else
+        {
+        // this r_buff was slower, probe the other side of the best one with a smaller step
+        m_tune_direction = -m_tune_direction;
+        m_tune_step = std::max(m_tune_step * Scalar(0.5), Scalar(0.05));
+        }
+
+    // the step is relative to r_buff, but not smaller than relative to a tenth of the range so that r_buff = 0 can grow
+    Scalar delta = m_tune_step * std::max(m_tune_best_r_buff, Scalar(0.1) * m_tune_r_max);
+    Scalar r_buff_new = m_tune_best_r_buff + m_tune_direction * delta;
+    r_buff_new = std::min(std::max(r_buff_new, m_tune_r_min), m_tune_r_max);
+    if (r_buff_new == m_tune_best_r_buff)
+        {
+        // at one end of the range, turn around
+        m_tune_direction = -m_tune_direction;
+        r_buff_new = m_tune_best_r_buff + m_tune_direction * delta;
+        r_buff_new = std::min(std::max(r_buff_new, m_tune_r_min), m_tune_r_max);
+        }
+
+    if (m_tune_every && m_dist_check)
+        {
+        if (dangerous)
+            {
+            m_every = std::max(m_every / 2, 1u);
+            }
+        else if (min_period != std::numeric_limits<unsigned int>::max() && r_buff > Scalar(0.0))
+            {
+            // the rebuild period grows linearly with r_buff for ballistic motion and quadratically for diffusive
+            // motion, take the smaller of the two and keep a safety factor of two
+            Scalar ratio = r_buff_new / r_buff;
+            Scalar scale = std::min(ratio, ratio * ratio);
+            m_every = std::max((unsigned int)(Scalar(0.5) * Scalar(min_period) * scale), 1u);
+            }
+        }
+
+    m_exec_conf->msg->notice(3) << "nlist: tuning window of " << n_steps << " steps at r_buff = " << r_buff << ": "
+                                << cost / 1e3 << " us/step (" << build_cost / 1e3 << " us/step building), next r_buff = "
+                                << r_buff_new << ", check_period = " << m_every << endl;
+
+    if (r_buff_new != r_buff)
+        setRBuff(r_buff_new);
+
+    // start the next window
+    m_tune_window_start = timestep;
+    m_tune_window_time = now;
+    m_tune_build_time = 0;
+    m_tune_min_period = std::numeric_limits<unsigned int>::max();
+    m_tune_dangerous_start = m_dangerous_updates;
+    }
+
 /*! This method is now deprecated, and deriving classes must supply it.
 */
 void NeighborList::buildNlist(unsigned int timestep)
@@ -1320,6 +1500,145 @@ void NeighborList::buildHeadList()
     if (m_prof) m_prof->pop();
     }
 
+/*!
+ * \param order Old index of the particle at each new index
+ * \param inverse New index of the particle at each old index
+ * \returns true if the list has been remapped, false if it needs to be rebuilt
+ *
+ * Moves the neighbors of each particle to the row of its new index and renumbers the local neighbors, ghost particles
+ * keep their indices. In half storage mode, a pair whose new indices are no longer in ascending order is moved to the
+ * row of the other particle, and the rows grow through the usual overflow conditions if needed. m_last_pos has
+ * already been permuted by ParticleData::reorderParticles().
+ *
+ * The remap runs on the host, derived classes that keep the list on the device or in a different layout return false.
+ * With domain decomposition, a sort forces a particle migration that renumbers the ghosts, so the list is rebuilt.
+ */
+bool NeighborList::remapNlist(const unsigned int *order, const unsigned int *inverse)
+    {
+    if (m_exec_conf->isCUDAEnabled())
+        return false;
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        return false;
+    #endif
+
+    if (m_prof) m_prof->push("remap");
+
+    const unsigned int N = m_pdata->getN();
+    const bool half_nlist = (m_storage_mode == half);
+
+    // save the old rows and count the neighbors of each new row
+    m_remap_head.resize(N);
+    m_remap_n_neigh.assign(N, 0);
+        {
+        ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+        std::copy(h_head_list.data, h_head_list.data + N, m_remap_head.begin());
+        m_remap_nlist.assign(h_nlist.data, h_nlist.data + m_nlist.getNumElements());
+
+        for (unsigned int old_i = 0; old_i < N; old_i++)
+            {
+            const unsigned int i = inverse[old_i];
+            if (!half_nlist)
+                {
+                m_remap_n_neigh[i] = h_n_neigh.data[old_i];
+                continue;
+                }
+
+            for (unsigned int k = 0; k < h_n_neigh.data[old_i]; k++)
+                {
+                const unsigned int old_j = h_nlist.data[m_remap_head[old_i] + k];
+                const unsigned int j = (old_j < N) ? inverse[old_j] : old_j;
+                m_remap_n_neigh[(j < i) ? j : i]++;
+                }
+            }
+        }
+
+    // rows of a half list may grow
+    if (half_nlist)
+        {
+            {
+            ArrayHandle<unsigned int> h_conditions(m_conditions, access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+                if (m_remap_n_neigh[i] > h_conditions.data[type_i])
+                    h_conditions.data[type_i] = m_remap_n_neigh[i];
+                }
+            }
+        checkConditions();
+        }
+
+    // the rows follow the particle types
+    buildHeadList();
+
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+
+    if (half_nlist)
+        {
+        // h_n_neigh still holds the old counts, m_remap_n_neigh counts the entries written to each new row
+        std::fill(m_remap_n_neigh.begin(), m_remap_n_neigh.end(), 0);
+        for (unsigned int old_i = 0; old_i < N; old_i++)
+            {
+            const unsigned int i = inverse[old_i];
+            for (unsigned int k = 0; k < h_n_neigh.data[old_i]; k++)
+                {
+                const unsigned int old_j = m_remap_nlist[m_remap_head[old_i] + k];
+                const unsigned int j = (old_j < N) ? inverse[old_j] : old_j;
+                if (j < i)
+                    h_nlist.data[h_head_list.data[j] + m_remap_n_neigh[j]++] = i;
+                else
+                    h_nlist.data[h_head_list.data[i] + m_remap_n_neigh[i]++] = j;
+                }
+            }
+        std::copy(m_remap_n_neigh.begin(), m_remap_n_neigh.end(), h_n_neigh.data);
+        }
+    else
+        {
+        // each new row gathers one old row
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)N; i++)
+            {
+            const unsigned int old_head = m_remap_head[order[i]];
+            const unsigned int head = h_head_list.data[i];
+            const unsigned int n_neigh = m_remap_n_neigh[i];
+            for (unsigned int k = 0; k < n_neigh; k++)
+                {
+                const unsigned int old_j = m_remap_nlist[old_head + k];
+                h_nlist.data[head + k] = (old_j < N) ? inverse[old_j] : old_j;
+                }
+            h_n_neigh.data[i] = n_neigh;
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    return true;
+    }
+
+/*! If the particles have been permuted by ParticleData::reorderParticles(), the list is remapped to the new indices.
+    Otherwise, or if remapNlist() fails, a full rebuild is forced.
+*/
+void NeighborList::slotParticleSort()
+    {
+    const unsigned int *order = m_pdata->getSortOrder();
+
+    if (order != NULL && m_has_been_updated_once && !m_force_update
+        && remapNlist(order, m_pdata->getInverseSortOrder()))
+        {
+        // exclusions are stored by index
+        if (m_exclusions_set)
+            updateExListIdx();
+        return;
+        }
+
+    forceUpdate();
+    }
+
 /*!
  * \param size the requested number of elements in the neighbor list
  *
@@ -1429,6 +1748,10 @@ void export_NeighborList(py::module& m)
         .def("setRCutPair", &NeighborList::setRCutPair)
         .def("setRBuff", &NeighborList::setRBuff)
         .def("setEvery", &NeighborList::setEvery)
+        .def("getEvery", &NeighborList::getEvery)
+        .def("getRBuff", &NeighborList::getRBuff)
+        .def("setBufferTuning", &NeighborList::setBufferTuning)
+        .def("getBufferTuning", &NeighborList::getBufferTuning)
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def("addExclusion", &NeighborList::addExclusion)
         .def("clearExclusions", &NeighborList::clearExclusions)
@@ -9,6 +9,7 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/ClockSource.h"
 
 #include <memory>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
@@ -84,13 +85,27 @@
     only then is the list actually updated. This check can even be avoided for a number of time
     steps by calling setEvery(). If the caller wants to force a full update, forceUpdate()
     can be called before compute() to do so. Note that if the particle data is resorted,
-    an update is automatically forced.
+    an update is automatically forced, unless the sort is a permutation of the local particles
+    (ParticleData::reorderParticles()). In that case, remapNlist() permutes the rows of the list and
+    renumbers the neighbors on the CPU, and the positions of the last update are permuted with the
+    particle data, so the next rebuild happens only when the distance check requests it.
 
     The CUDA profiler expects the exact same sequence of kernels on every run. Due to the non-deterministic cell list,
     a different sequence of calls may be generated with nlist builds at different times. To work around this problem
     setEvery takes a dist_check parameter. When dist_check=True, the above described behavior is followed. When
     dist_check is false, the nlist is built exactly m_every steps. This is intended for use in profiling only.
 
+    <b>Runtime tuning:</b>
+
+    setBufferTuning() enables an online tuner for the buffer radius and the check period. The run is divided into windows
+    of a fixed number of time steps, and the wall clock time per step of each window is the cost of the r_buff that
+    was in effect. After each window, the tuner moves r_buff by a relative step in the current direction: it keeps
+    going (with a growing step) while the cost improves, and returns to the best r_buff and probes the other side
+    (with a shrinking step) when it does not. r_buff is kept within the given bounds. When the check period is tuned
+    as well, it is set to half of the shortest rebuild period seen during the window (scaled to the new r_buff), and
+    halved whenever a dangerous build occurs. A new r_buff is applied at the first rebuild check of a time step,
+    before the particles are migrated, so that the ghost layer and cell list already use it for the forced rebuild.
+
     \b Exclusions:
 
     Exclusions are stored in \a ex_list, a data structure similar in structure to \a nlist, except this time exclusions
@@ -166,6 +181,15 @@ class NeighborList : public Compute
             forceUpdate();
             }
 
+        //! Enable or disable the runtime tuning of r_buff and the check period
+        void setBufferTuning(bool enable, unsigned int period, Scalar r_buff_min, Scalar r_buff_max, bool tune_every);
+
+        //! Get whether the runtime tuning of r_buff is enabled
+        bool getBufferTuning()
+            {
+            return m_tune_buffer;
+            }
+
         // @}
         //! \name Get properties
         // @{
@@ -214,6 +238,12 @@ class NeighborList : public Compute
             return m_r_buff;
             }
 
+        //! Get the number of steps to wait before checking if the list needs to be rebuilt
+        unsigned int getEvery()
+            {
+            return m_every;
+            }
+
         // @}
         //! \name Statistics
         // @{
@@ -234,18 +264,21 @@ class NeighborList : public Compute
         //! Get the number of neighbors array
         const GPUArray<unsigned int>& getNNeighArray()
             {
+            updatePerParticleNlist();
             return m_n_neigh;
             }
 
         //! Get the neighbor list
         const GPUArray<unsigned int>& getNListArray()
             {
+            updatePerParticleNlist();
             return m_nlist;
             }
 
         //! Get the head list
         const GPUArray<unsigned int>& getHeadList()
             {
+            updatePerParticleNlist();
             return m_head_list;
             }
 
@@ -506,6 +539,23 @@ class NeighborList : public Compute
         //! Build the head list to allocated memory
         virtual void buildHeadList();
 
+        //! Apply a permutation of the local particles to the neighbor list
+        virtual bool remapNlist(const unsigned int *order, const unsigned int *inverse);
+
+        //! Fill the per-particle neighbor list from an alternative internal representation
+        /*! Called before the per-particle list data is handed out. Derived classes that do not store their neighbors
+            per particle (NeighborListCluster) override this to fill m_nlist, m_n_neigh, and m_head_list on demand.
+        */
+        virtual void updatePerParticleNlist()
+            {
+            }
+
+        //! Check the status of the conditions
+        bool checkConditions();
+
+        //! Resets the condition status to all zeroes
+        virtual void resetConditions();
+
         //! Amortized resizing of the neighborlist
         void resizeNlist(unsigned int size);
 
@@ -546,21 +596,42 @@ class NeighborList : public Compute
         unsigned int m_every; //!< No update checks will be performed until m_every steps after the last one
         std::vector<unsigned int> m_update_periods;    //!< Steps between updates
 
+        bool m_tune_buffer;                     //!< True if r_buff is tuned at runtime
+        bool m_tune_every;                      //!< True if the check period is tuned along with r_buff
+        unsigned int m_tune_period;             //!< Number of time steps in each tuning window
+        Scalar m_tune_r_min;                    //!< Smallest r_buff the tuner may set
+        Scalar m_tune_r_max;                    //!< Largest r_buff the tuner may set
+        ClockSource m_tune_clock;               //!< Wall clock for measuring the cost of each window
+        bool m_tune_window_open;                //!< True if a tuning window is being measured
+        unsigned int m_tune_window_start;       //!< Time step at which the current window started
+        uint64_t m_tune_window_time;            //!< Wall clock time at which the current window started (ns)
+        uint64_t m_tune_build_time;             //!< Time spent building the list in the current window (ns)
+        unsigned int m_tune_min_period;         //!< Shortest non-forced rebuild period in the current window
+        int64_t m_tune_dangerous_start;         //!< Number of dangerous builds at the start of the current window
+        Scalar m_tune_best_r_buff;              //!< r_buff with the lowest measured cost
+        double m_tune_best_cost;                //!< Lowest measured cost per step (ns), negative if not measured yet
+        Scalar m_tune_step;                     //!< Relative size of the next r_buff change
+        int m_tune_direction;                   //!< Direction of the next r_buff change (+1 or -1)
+
+        //! Finish the current tuning window and choose the next r_buff and check period
+        void tuneBuffer(unsigned int timestep);
+
         //! Test if the list needs updating
         bool needsUpdating(unsigned int timestep);
 
+        std::vector<unsigned int> m_remap_head;     //!< Head list before the permutation (remapNlist() scratch)
+        std::vector<unsigned int> m_remap_n_neigh;  //!< Neighbor counts after the permutation (remapNlist() scratch)
+        std::vector<unsigned int> m_remap_nlist;    //!< Neighbor list before the permutation (remapNlist() scratch)
+
+        //! Remap or invalidate the list after the particles have been rearranged in memory
+        void slotParticleSort();
+
         //! Reallocate internal neighbor list data structures
         void reallocate();
 
         //! Reallocate internal data structures that depend on types
         void reallocateTypes();
 
-        //! Check the status of the conditions
-        bool checkConditions();
-
-        //! Resets the condition status to all zeroes
-        virtual void resetConditions();
-
         //! Grow the exclusions list memory capacity by one row
         void growExclusionList();
 
@@ -14,10 +14,174 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#if defined(__SSE4_1__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 namespace py = pybind11;
 
+//! Select the members of a cell that may lie within a cutoff of a position
+/*! \param xyzf Positions of the cell members
+    \param size Number of cell members
+    \param pos Position to test against
+    \param box Box to apply the minimum image convention in
+    \param rsq Squared cutoff, an upper bound of all the per type pair cutoffs that will be tested later
+    \param candidates Output list of the offsets of the selected members, in increasing order
+    \returns The number of selected members
+
+    This is a prefilter for the exact test in NeighborListBinned::buildNlist(), it may select members that fail the
+    exact test but never rejects members that pass it. When HOOMD is compiled with AVX2 (double precision) or SSE4.1
+    (single precision), several members are tested at once: the Scalar4 entries are transposed into SIMD lanes and
+    the minimum image is applied with rounding in the same order as BoxDim::minImage(). With AVX-512 (F and VL), the
+    survivors are written with a compress store. Without these instruction sets, all members are selected and the
+    exact test is the only one.
+*/
+inline unsigned int select_cell_candidates(const Scalar4 *xyzf,
+                                           unsigned int size,
+                                           const Scalar3& pos,
+                                           const BoxDim& box,
+                                           Scalar rsq,
+                                           unsigned int *candidates)
+    {
+    unsigned int n = 0;
+    unsigned int k = 0;
+
+    #if (defined(__AVX2__) && !defined(SINGLE_PRECISION)) || (defined(__SSE4_1__) && defined(SINGLE_PRECISION))
+    const Scalar3 L = box.getL();
+    const uchar3 periodic = box.getPeriodic();
+
+    // non-periodic directions never shift the image
+    const Scalar Linv_x = periodic.x ? Scalar(1.0)/L.x : Scalar(0.0);
+    const Scalar Linv_y = periodic.y ? Scalar(1.0)/L.y : Scalar(0.0);
+    const Scalar Linv_z = periodic.z ? Scalar(1.0)/L.z : Scalar(0.0);
+    const Scalar Lz_xz = L.z * box.getTiltFactorXZ();
+    const Scalar Lz_yz = L.z * box.getTiltFactorYZ();
+    const Scalar Ly_xy = L.y * box.getTiltFactorXY();
+
+    // the SIMD test uses a different association of the floating point operations, allow for the rounding
+    const Scalar rsq_bound = rsq * Scalar(1.0001);
+    #endif
+
+    #if defined(__AVX512F__) && defined(__AVX512VL__) && !defined(SINGLE_PRECISION)
+    // 8 lanes: gather the x, y and z components of 8 consecutive Scalar4 entries
+    const __m256i gather_idx = _mm256_set_epi32(28, 24, 20, 16, 12, 8, 4, 0);
+    const __m256i lane_offsets = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    for (; k + 8 <= size; k += 8)
+        {
+        const double *base = &xyzf[k].x;
+        __m512d dx = _mm512_sub_pd(_mm512_set1_pd(pos.x), _mm512_i32gather_pd(gather_idx, base, 8));
+        __m512d dy = _mm512_sub_pd(_mm512_set1_pd(pos.y), _mm512_i32gather_pd(gather_idx, base + 1, 8));
+        __m512d dz = _mm512_sub_pd(_mm512_set1_pd(pos.z), _mm512_i32gather_pd(gather_idx, base + 2, 8));
+
+        __m512d img = _mm512_roundscale_pd(_mm512_mul_pd(dz, _mm512_set1_pd(Linv_z)), _MM_FROUND_TO_NEAREST_INT);
+        dz = _mm512_sub_pd(dz, _mm512_mul_pd(img, _mm512_set1_pd(L.z)));
+        dy = _mm512_sub_pd(dy, _mm512_mul_pd(img, _mm512_set1_pd(Lz_yz)));
+        dx = _mm512_sub_pd(dx, _mm512_mul_pd(img, _mm512_set1_pd(Lz_xz)));
+
+        img = _mm512_roundscale_pd(_mm512_mul_pd(dy, _mm512_set1_pd(Linv_y)), _MM_FROUND_TO_NEAREST_INT);
+        dy = _mm512_sub_pd(dy, _mm512_mul_pd(img, _mm512_set1_pd(L.y)));
+        dx = _mm512_sub_pd(dx, _mm512_mul_pd(img, _mm512_set1_pd(Ly_xy)));
+
+        img = _mm512_roundscale_pd(_mm512_mul_pd(dx, _mm512_set1_pd(Linv_x)), _MM_FROUND_TO_NEAREST_INT);
+        dx = _mm512_sub_pd(dx, _mm512_mul_pd(img, _mm512_set1_pd(L.x)));
+
+        __m512d dr_sq = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)),
+                                      _mm512_mul_pd(dz, dz));
+        __mmask8 mask = _mm512_cmp_pd_mask(dr_sq, _mm512_set1_pd(rsq_bound), _CMP_LE_OQ);
+
+        __m256i offsets = _mm256_add_epi32(_mm256_set1_epi32(k), lane_offsets);
+        _mm256_mask_compressstoreu_epi32(candidates + n, mask, offsets);
+        n += __builtin_popcount((unsigned int)mask);
+        }
+    #endif
+
+    #if defined(__AVX2__) && !defined(SINGLE_PRECISION)
+    // 4 lanes: transpose 4 consecutive Scalar4 entries into x, y and z vectors
+    for (; k + 4 <= size; k += 4)
+        {
+        __m256d r0 = _mm256_loadu_pd(&xyzf[k].x);
+        __m256d r1 = _mm256_loadu_pd(&xyzf[k+1].x);
+        __m256d r2 = _mm256_loadu_pd(&xyzf[k+2].x);
+        __m256d r3 = _mm256_loadu_pd(&xyzf[k+3].x);
+        __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+        __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+        __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+        __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+        __m256d dx = _mm256_sub_pd(_mm256_set1_pd(pos.x), _mm256_permute2f128_pd(t0, t2, 0x20));
+        __m256d dy = _mm256_sub_pd(_mm256_set1_pd(pos.y), _mm256_permute2f128_pd(t1, t3, 0x20));
+        __m256d dz = _mm256_sub_pd(_mm256_set1_pd(pos.z), _mm256_permute2f128_pd(t0, t2, 0x31));
+
+        __m256d img = _mm256_round_pd(_mm256_mul_pd(dz, _mm256_set1_pd(Linv_z)),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        dz = _mm256_sub_pd(dz, _mm256_mul_pd(img, _mm256_set1_pd(L.z)));
+        dy = _mm256_sub_pd(dy, _mm256_mul_pd(img, _mm256_set1_pd(Lz_yz)));
+        dx = _mm256_sub_pd(dx, _mm256_mul_pd(img, _mm256_set1_pd(Lz_xz)));
+
+        img = _mm256_round_pd(_mm256_mul_pd(dy, _mm256_set1_pd(Linv_y)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        dy = _mm256_sub_pd(dy, _mm256_mul_pd(img, _mm256_set1_pd(L.y)));
+        dx = _mm256_sub_pd(dx, _mm256_mul_pd(img, _mm256_set1_pd(Ly_xy)));
+
+        img = _mm256_round_pd(_mm256_mul_pd(dx, _mm256_set1_pd(Linv_x)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        dx = _mm256_sub_pd(dx, _mm256_mul_pd(img, _mm256_set1_pd(L.x)));
+
+        __m256d dr_sq = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                      _mm256_mul_pd(dz, dz));
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(dr_sq, _mm256_set1_pd(rsq_bound), _CMP_LE_OQ));
+
+        // emulate the compress store
+        while (mask)
+            {
+            candidates[n++] = k + __builtin_ctz(mask);
+            mask &= mask - 1;
+            }
+        }
+    #elif defined(__SSE4_1__) && defined(SINGLE_PRECISION)
+    // 4 lanes: transpose 4 consecutive Scalar4 entries into x, y and z vectors
+    for (; k + 4 <= size; k += 4)
+        {
+        __m128 x = _mm_loadu_ps(&xyzf[k].x);
+        __m128 y = _mm_loadu_ps(&xyzf[k+1].x);
+        __m128 z = _mm_loadu_ps(&xyzf[k+2].x);
+        __m128 w = _mm_loadu_ps(&xyzf[k+3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        __m128 dx = _mm_sub_ps(_mm_set1_ps(pos.x), x);
+        __m128 dy = _mm_sub_ps(_mm_set1_ps(pos.y), y);
+        __m128 dz = _mm_sub_ps(_mm_set1_ps(pos.z), z);
+
+        __m128 img = _mm_round_ps(_mm_mul_ps(dz, _mm_set1_ps(Linv_z)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        dz = _mm_sub_ps(dz, _mm_mul_ps(img, _mm_set1_ps(L.z)));
+        dy = _mm_sub_ps(dy, _mm_mul_ps(img, _mm_set1_ps(Lz_yz)));
+        dx = _mm_sub_ps(dx, _mm_mul_ps(img, _mm_set1_ps(Lz_xz)));
+
+        img = _mm_round_ps(_mm_mul_ps(dy, _mm_set1_ps(Linv_y)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        dy = _mm_sub_ps(dy, _mm_mul_ps(img, _mm_set1_ps(L.y)));
+        dx = _mm_sub_ps(dx, _mm_mul_ps(img, _mm_set1_ps(Ly_xy)));
+
+        img = _mm_round_ps(_mm_mul_ps(dx, _mm_set1_ps(Linv_x)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        dx = _mm_sub_ps(dx, _mm_mul_ps(img, _mm_set1_ps(L.x)));
+
+        __m128 dr_sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(dr_sq, _mm_set1_ps(rsq_bound)));
+
+        // emulate the compress store
+        while (mask)
+            {
+            candidates[n++] = k + __builtin_ctz(mask);
+            mask &= mask - 1;
+            }
+        }
+    #endif
+
+    // the remaining members are left to the exact test
+    for (; k < size; k++)
+        candidates[n++] = k;
+
+    return n;
+    }
+
 NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
                                        Scalar r_cut,
                                        Scalar r_buff,
@@ -76,6 +240,17 @@ void NeighborListBinned::setMaximumDiameter(Scalar d_max)
     m_cl->setNominalWidth(rmax);
     }
 
+void NeighborListBinned::setRBuff(Scalar r_buff)
+    {
+    NeighborList::setRBuff(r_buff);
+
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
 void NeighborListBinned::buildNlist(unsigned int timestep)
     {
     m_cl->compute(timestep);
@@ -113,6 +288,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
     // access the cell list data arrays
     ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offset(m_cl->getCellOffsetArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(), access_location::host, access_mode::read);
 
@@ -125,12 +301,27 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
     Index2D cadji = m_cl->getCellAdjIndexer();
 
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
+    // the largest list radius of each type bounds the prefilter in select_cell_candidates()
+    const unsigned int ntypes = m_pdata->getNTypes();
+    std::vector<Scalar> r_list_max(ntypes, Scalar(0.0));
+    for (unsigned int cur_type = 0; cur_type < ntypes; cur_type++)
+        {
+        for (unsigned int other_type = 0; other_type < ntypes; other_type++)
+            {
+            Scalar r_cut = h_r_cut.data[m_typpair_idx(cur_type, other_type)];
+            if (r_cut > Scalar(0.0))
+                r_list_max[cur_type] = std::max(r_list_max[cur_type], r_cut + m_r_buff);
+            }
+        }
+
+    // offsets of the members of a neighboring cell that pass the prefilter
+    std::vector<unsigned int> candidates(m_cl->getNmax());
+
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
@@ -163,6 +354,11 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
         // identify the bin
         unsigned int my_cell = ci(ib,jb,kb);
 
+        // bound the list radius of this particle, including the largest possible diameter shift
+        Scalar r_bound = r_list_max[type_i];
+        if (m_diameter_shift)
+            r_bound += std::max((diam_i + m_d_max) * Scalar(0.5) - Scalar(1.0), Scalar(0.0));
+
         // loop through all neighboring bins
         for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
             {
@@ -170,9 +366,17 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            const Scalar4 *neigh_xyzf = &h_cell_xyzf.data[h_cell_offset.data[neigh_cell]];
+            unsigned int n_candidates = select_cell_candidates(neigh_xyzf,
+                                                               size,
+                                                               my_pos,
+                                                               box,
+                                                               r_bound*r_bound,
+                                                               candidates.data());
+            for (unsigned int cur_candidate = 0; cur_candidate < n_candidates; cur_candidate++)
                 {
-                Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                unsigned int cur_offset = candidates[cur_candidate];
+                const Scalar4& cur_xyzf = neigh_xyzf[cur_offset];
                 unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
 
                 // get the current neighbor type from the position data (will use tdb on the GPU)
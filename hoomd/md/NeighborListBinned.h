@@ -43,6 +43,9 @@ class NeighborListBinned : public NeighborList
         //! Set the cutoff radius by pair type
         virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
 
+        //! Change the global buffer radius
+        virtual void setRBuff(Scalar r_buff);
+
         //! Set the maximum diameter to use in computing neighbor lists
         virtual void setMaximumDiameter(Scalar d_max);
 
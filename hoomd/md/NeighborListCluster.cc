@@ -0,0 +1,523 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file NeighborListCluster.cc
+    \brief Defines NeighborListCluster
+*/
+
+#include "NeighborListCluster.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <algorithm>
+#include <bitset>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param r_cut Default cutoff radius
+    \param r_buff Buffer width
+    \param cluster_size Number of particles per cluster (4 or 8)
+*/
+NeighborListCluster::NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef,
+                                         Scalar r_cut,
+                                         Scalar r_buff,
+                                         unsigned int cluster_size)
+    : NeighborList(sysdef, r_cut, r_buff), m_cluster_size(4), m_n_local_clusters(0), m_nlist_expanded(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListCluster" << endl;
+
+    setClusterSize(cluster_size);
+    }
+
+NeighborListCluster::~NeighborListCluster()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListCluster" << endl;
+    }
+
+/*! \param cluster_size Number of particles per cluster, either 4 or 8
+
+    The interaction mask of a cluster pair has cluster_size*cluster_size bits and must fit into 64 bits.
+*/
+void NeighborListCluster::setClusterSize(unsigned int cluster_size)
+    {
+    if (cluster_size != 4 && cluster_size != 8)
+        {
+        m_exec_conf->msg->error() << "nlist.cluster: cluster_size must be 4 or 8, got " << cluster_size << endl;
+        throw runtime_error("Error setting the cluster size in NeighborListCluster");
+        }
+
+    m_cluster_size = cluster_size;
+    m_cluster_members.clear();
+    m_pair_head.clear();
+    m_pairs.clear();
+    m_n_local_clusters = 0;
+    forceUpdate();
+    }
+
+/*! \param h_pos Particle positions
+    \param first Index of the first particle to cluster
+    \param last One past the index of the last particle to cluster
+    \param width Target edge length of a cluster
+
+    The particles are binned into columns of cross section width*width (width in 2D) and sorted along z (y in 2D).
+    Each column is then cut into clusters of up to M particles that are appended to m_cluster_members. A cluster is
+    also closed early when it would span more than two widths along the column, which keeps the clusters compact
+    in sparse regions such as the ghost layer.
+*/
+void NeighborListCluster::buildClusters(const Scalar4 *h_pos, unsigned int first, unsigned int last, Scalar width)
+    {
+    const unsigned int M = m_cluster_size;
+    const bool is_2d = m_sysdef->getNDimensions() == 2;
+
+    if (last <= first)
+        return;
+
+    // bounding box of the particles
+    Scalar3 lo = make_scalar3(h_pos[first].x, h_pos[first].y, h_pos[first].z);
+    Scalar3 hi = lo;
+    for (unsigned int i = first; i < last; i++)
+        {
+        lo.x = std::min(lo.x, h_pos[i].x); hi.x = std::max(hi.x, h_pos[i].x);
+        lo.y = std::min(lo.y, h_pos[i].y); hi.y = std::max(hi.y, h_pos[i].y);
+        lo.z = std::min(lo.z, h_pos[i].z); hi.z = std::max(hi.z, h_pos[i].z);
+        }
+
+    // number of columns in x and y
+    const unsigned int max_columns = 65536;
+    unsigned int ncol_x = std::min((unsigned int)((hi.x - lo.x) / width) + 1, max_columns);
+    unsigned int ncol_y = is_2d ? 1 : std::min((unsigned int)((hi.y - lo.y) / width) + 1, max_columns);
+
+    // column of each particle and the coordinate along the column
+    std::vector<unsigned int> column(last - first);
+    std::vector<Scalar> height(last - first);
+    m_sort_idx.resize(last - first);
+    for (unsigned int i = first; i < last; i++)
+        {
+        unsigned int cx = std::min((unsigned int)((h_pos[i].x - lo.x) / width), ncol_x - 1);
+        unsigned int cy = is_2d ? 0 : std::min((unsigned int)((h_pos[i].y - lo.y) / width), ncol_y - 1);
+        column[i - first] = cy * ncol_x + cx;
+        height[i - first] = is_2d ? h_pos[i].y : h_pos[i].z;
+        m_sort_idx[i - first] = i - first;
+        }
+
+    std::sort(m_sort_idx.begin(), m_sort_idx.end(), [&column, &height](unsigned int a, unsigned int b)
+        {
+        return column[a] < column[b] || (column[a] == column[b] && height[a] < height[b]);
+        });
+
+    // cut the columns into clusters
+    unsigned int n_members = M;
+    unsigned int cur_column = 0;
+    Scalar cur_start = Scalar(0.0);
+    for (unsigned int k = 0; k < m_sort_idx.size(); k++)
+        {
+        unsigned int s = m_sort_idx[k];
+        if (n_members == M || column[s] != cur_column || height[s] - cur_start > Scalar(2.0) * width)
+            {
+            // pad the previous cluster and start a new one
+            while (m_cluster_members.size() % M)
+                m_cluster_members.push_back(NO_PARTICLE);
+
+            n_members = 0;
+            cur_column = column[s];
+            cur_start = height[s];
+            }
+
+        m_cluster_members.push_back(first + s);
+        n_members++;
+        }
+
+    while (m_cluster_members.size() % M)
+        m_cluster_members.push_back(NO_PARTICLE);
+    }
+
+/*! The local and ghost particles are grouped into clusters, the clusters are binned by their centers, and each local
+    cluster is tested against the clusters in the neighboring bins for every periodic image. A cluster pair is stored
+    when at least one particle pair passes the same list radius and exclusion criteria as in NeighborListBinned.
+*/
+void NeighborListCluster::buildNlist(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compute");
+
+    // acquire the particle data and box dimension
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
+    const bool is_2d = m_sysdef->getNDimensions() == 2;
+
+    // validate that the cutoff fits inside the box
+    Scalar rmax = getMaxRList();
+
+    if ((box.getPeriodic().x && nearest_plane_distance.x <= rmax * 2.0) ||
+        (box.getPeriodic().y && nearest_plane_distance.y <= rmax * 2.0) ||
+        (!is_2d && box.getPeriodic().z && nearest_plane_distance.z <= rmax * 2.0))
+        {
+        m_exec_conf->msg->error() << "nlist: Simulation box is too small! Particles would be interacting with themselves." << endl;
+        throw runtime_error("Error updating neighborlist bins");
+        }
+
+    // access the rlist data and the exclusions
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
+
+    const unsigned int M = m_cluster_size;
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_ghosts = m_pdata->getNGhosts();
+
+    // clusters should be about as long as they are wide at the local density
+    Scalar width = Scalar(1.0);
+    if (N > 0)
+        {
+        Scalar volume_per_cluster = box.getVolume(is_2d) * Scalar(M) / Scalar(N);
+        width = is_2d ? sqrt(volume_per_cluster) : pow(volume_per_cluster, Scalar(1.0/3.0));
+        }
+
+    // local clusters first, then the ghost clusters
+    m_cluster_members.clear();
+    buildClusters(h_pos.data, 0, N, width);
+    m_n_local_clusters = m_cluster_members.size() / M;
+    buildClusters(h_pos.data, N, N + n_ghosts, width);
+    const unsigned int n_clusters = m_cluster_members.size() / M;
+
+    // bounding boxes of the clusters
+    m_cluster_lo.resize(n_clusters);
+    m_cluster_hi.resize(n_clusters);
+    m_cluster_center.resize(n_clusters);
+    Scalar max_half_extent = Scalar(0.0);
+    for (unsigned int c = 0; c < n_clusters; c++)
+        {
+        const Scalar4& p0 = h_pos.data[m_cluster_members[c*M]];
+        Scalar3 lo = make_scalar3(p0.x, p0.y, p0.z);
+        Scalar3 hi = lo;
+        for (unsigned int k = 1; k < M; k++)
+            {
+            unsigned int idx = m_cluster_members[c*M + k];
+            if (idx == NO_PARTICLE)
+                break;
+            const Scalar4& p = h_pos.data[idx];
+            lo.x = std::min(lo.x, p.x); hi.x = std::max(hi.x, p.x);
+            lo.y = std::min(lo.y, p.y); hi.y = std::max(hi.y, p.y);
+            lo.z = std::min(lo.z, p.z); hi.z = std::max(hi.z, p.z);
+            }
+        m_cluster_lo[c] = lo;
+        m_cluster_hi[c] = hi;
+        m_cluster_center[c] = (lo + hi) * Scalar(0.5);
+
+        Scalar3 half = (hi - lo) * Scalar(0.5);
+        max_half_extent = std::max(max_half_extent, std::max(half.x, std::max(half.y, half.z)));
+        }
+
+    // bin the cluster centers, so that any two interacting clusters are at most one bin apart
+    Scalar bin_width = rmax + Scalar(2.0) * max_half_extent;
+    Scalar3 bin_lo = make_scalar3(0, 0, 0);
+    Scalar3 bin_size = make_scalar3(bin_width, bin_width, bin_width);
+    uint3 nbins = make_uint3(1, 1, 1);
+    if (n_clusters > 0)
+        {
+        Scalar3 c_lo = m_cluster_center[0];
+        Scalar3 c_hi = c_lo;
+        for (unsigned int c = 1; c < n_clusters; c++)
+            {
+            Scalar3 center = m_cluster_center[c];
+            c_lo.x = std::min(c_lo.x, center.x); c_hi.x = std::max(c_hi.x, center.x);
+            c_lo.y = std::min(c_lo.y, center.y); c_hi.y = std::max(c_hi.y, center.y);
+            c_lo.z = std::min(c_lo.z, center.z); c_hi.z = std::max(c_hi.z, center.z);
+            }
+        bin_lo = c_lo;
+        Scalar3 c_ext = c_hi - c_lo;
+
+        // limit the number of bins to about the number of clusters, widening the bins in sparse systems
+        Scalar n_target = Scalar(std::max(n_clusters, 1024u));
+        unsigned int max_bins = (unsigned int)(is_2d ? sqrt(n_target) : pow(n_target, Scalar(1.0/3.0))) + 1;
+        nbins.x = std::min((unsigned int)(c_ext.x / bin_width) + 1, max_bins);
+        nbins.y = std::min((unsigned int)(c_ext.y / bin_width) + 1, max_bins);
+        nbins.z = is_2d ? 1 : std::min((unsigned int)(c_ext.z / bin_width) + 1, max_bins);
+        bin_size.x = std::max(bin_width, c_ext.x / Scalar(nbins.x) * Scalar(1.0001));
+        bin_size.y = std::max(bin_width, c_ext.y / Scalar(nbins.y) * Scalar(1.0001));
+        bin_size.z = std::max(bin_width, c_ext.z / Scalar(nbins.z) * Scalar(1.0001));
+        }
+    Index3D bin_idx(nbins.x, nbins.y, nbins.z);
+    Scalar3 inv_bin_width = make_scalar3(Scalar(1.0) / bin_size.x, Scalar(1.0) / bin_size.y, Scalar(1.0) / bin_size.z);
+
+    std::vector<unsigned int> cluster_bin(n_clusters);
+    m_bin_head.assign(bin_idx.getNumElements() + 1, 0);
+    for (unsigned int c = 0; c < n_clusters; c++)
+        {
+        Scalar3 center = m_cluster_center[c];
+        unsigned int ib = std::min((unsigned int)((center.x - bin_lo.x) * inv_bin_width.x), nbins.x - 1);
+        unsigned int jb = std::min((unsigned int)((center.y - bin_lo.y) * inv_bin_width.y), nbins.y - 1);
+        unsigned int kb = std::min((unsigned int)((center.z - bin_lo.z) * inv_bin_width.z), nbins.z - 1);
+        cluster_bin[c] = bin_idx(ib, jb, kb);
+        m_bin_head[cluster_bin[c] + 1]++;
+        }
+    for (unsigned int b = 0; b < bin_idx.getNumElements(); b++)
+        m_bin_head[b + 1] += m_bin_head[b];
+    m_bin_clusters.resize(n_clusters);
+        {
+        std::vector<unsigned int> bin_fill(m_bin_head.begin(), m_bin_head.end() - 1);
+        for (unsigned int c = 0; c < n_clusters; c++)
+            m_bin_clusters[bin_fill[cluster_bin[c]]++] = c;
+        }
+
+    // periodic images to test, the first one is the zero image
+    uchar3 periodic = box.getPeriodic();
+    int3 n_images = make_int3(periodic.x ? 1 : 0, periodic.y ? 1 : 0, (!is_2d && periodic.z) ? 1 : 0);
+    m_images.assign(1, make_int3(0, 0, 0));
+    std::vector<Scalar3> shifts(1, make_scalar3(0, 0, 0));
+    std::vector<bool> shift_positive(1, false);
+    for (int k = -n_images.z; k <= n_images.z; k++)
+        for (int j = -n_images.y; j <= n_images.y; j++)
+            for (int i = -n_images.x; i <= n_images.x; i++)
+                {
+                if (i == 0 && j == 0 && k == 0)
+                    continue;
+                m_images.push_back(make_int3(i, j, k));
+                shifts.push_back(Scalar(i) * box.getLatticeVector(0) +
+                                 Scalar(j) * box.getLatticeVector(1) +
+                                 Scalar(k) * box.getLatticeVector(2));
+                // a cluster paired with its own image is only stored for one of the two opposite images
+                shift_positive.push_back(k > 0 || (k == 0 && (j > 0 || (j == 0 && i > 0))));
+                }
+
+    const Scalar rmaxsq = rmax * rmax;
+
+    m_pair_head.resize(m_n_local_clusters + 1);
+    m_pairs.clear();
+
+    for (unsigned int ci = 0; ci < m_n_local_clusters; ci++)
+        {
+        m_pair_head[ci] = m_pairs.size();
+
+        const Scalar3 lo_i = m_cluster_lo[ci];
+        const Scalar3 hi_i = m_cluster_hi[ci];
+        const Scalar3 center_i = m_cluster_center[ci];
+        const Scalar3 half_i = (hi_i - lo_i) * Scalar(0.5);
+
+        for (unsigned int cur_shift = 0; cur_shift < shifts.size(); cur_shift++)
+            {
+            const Scalar3 shift = shifts[cur_shift];
+
+            // clusters j with an image near cluster i are centered near center_i - shift
+            Scalar3 q = center_i - shift - bin_lo;
+            int ib = (int)floor(q.x * inv_bin_width.x);
+            int jb = (int)floor(q.y * inv_bin_width.y);
+            int kb = (int)floor(q.z * inv_bin_width.z);
+
+            for (int kk = std::max(kb - 1, 0); kk <= std::min(kb + 1, (int)nbins.z - 1); kk++)
+                for (int jj = std::max(jb - 1, 0); jj <= std::min(jb + 1, (int)nbins.y - 1); jj++)
+                    for (int ii = std::max(ib - 1, 0); ii <= std::min(ib + 1, (int)nbins.x - 1); ii++)
+                        {
+                        unsigned int cur_bin = bin_idx(ii, jj, kk);
+                        for (unsigned int cur = m_bin_head[cur_bin]; cur < m_bin_head[cur_bin + 1]; cur++)
+                            {
+                            const unsigned int cj = m_bin_clusters[cur];
+
+                            // store each pair of local clusters only once
+                            if (cj < m_n_local_clusters && cj <= ci)
+                                {
+                                if (cj < ci || (cur_shift != 0 && !shift_positive[cur_shift]))
+                                    continue;
+                                }
+
+                            // distance between the bounding boxes
+                            const Scalar3 center_j = m_cluster_center[cj] + shift;
+                            const Scalar3 half_j = (m_cluster_hi[cj] - m_cluster_lo[cj]) * Scalar(0.5);
+                            Scalar3 d = center_i - center_j;
+                            d.x = std::max(fabs(d.x) - half_i.x - half_j.x, Scalar(0.0));
+                            d.y = std::max(fabs(d.y) - half_i.y - half_j.y, Scalar(0.0));
+                            d.z = std::max(fabs(d.z) - half_i.z - half_j.z, Scalar(0.0));
+                            if (dot(d, d) > rmaxsq)
+                                continue;
+
+                            const bool self = (cj == ci && cur_shift == 0);
+
+                            // build the interaction mask
+                            uint64_t mask = 0;
+                            for (unsigned int a = 0; a < M; a++)
+                                {
+                                const unsigned int i = m_cluster_members[ci*M + a];
+                                if (i == NO_PARTICLE)
+                                    break;
+
+                                const Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+                                const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+                                const unsigned int body_i = h_body.data[i];
+                                const Scalar diam_i = h_diameter.data[i];
+                                const unsigned int n_ex = m_exclusions_set ? h_n_ex_idx.data[i] : 0;
+
+                                for (unsigned int b = self ? a + 1 : 0; b < M; b++)
+                                    {
+                                    const unsigned int j = m_cluster_members[cj*M + b];
+                                    if (j == NO_PARTICLE)
+                                        break;
+
+                                    const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+                                    Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, type_j)];
+
+                                    // automatically exclude pairs the same way as NeighborListBinned
+                                    bool excluded = (r_cut <= Scalar(0.0));
+                                    if (m_filter_body && body_i != NO_BODY)
+                                        excluded = excluded | (body_i == h_body.data[j]);
+                                    for (unsigned int cur_ex = 0; cur_ex < n_ex && !excluded; cur_ex++)
+                                        excluded = h_ex_list_idx.data[m_ex_list_indexer(i, cur_ex)] == j;
+                                    if (excluded)
+                                        continue;
+
+                                    Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                                    Scalar3 dx = pi - (pj + shift);
+
+                                    Scalar r_list = r_cut + m_r_buff;
+                                    Scalar sqshift = Scalar(0.0);
+                                    if (m_diameter_shift)
+                                        {
+                                        const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
+                                        sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                                        }
+
+                                    if (dot(dx, dx) <= h_r_listsq.data[m_typpair_idx(type_i, type_j)] + sqshift)
+                                        mask |= uint64_t(1) << (a*M + b);
+                                    }
+                                }
+
+                            if (mask)
+                                {
+                                ClusterPair pair;
+                                pair.mask = mask;
+                                pair.j = cj;
+                                pair.image = cur_shift;
+                                m_pairs.push_back(pair);
+                                }
+                            }
+                        }
+            }
+        }
+    m_pair_head[m_n_local_clusters] = m_pairs.size();
+
+    // the per-particle list is filled on demand
+    m_nlist_expanded = false;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Fills m_nlist, m_n_neigh and m_head_list from the cluster pairs in the requested storage mode, growing Nmax on
+    overflow like NeighborList::compute().
+*/
+void NeighborListCluster::updatePerParticleNlist()
+    {
+    if (m_nlist_expanded)
+        return;
+
+    if (m_prof) m_prof->push("expand");
+
+    const unsigned int M = m_cluster_size;
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_max = N + m_pdata->getNGhosts();
+
+    bool overflowed = false;
+    do
+        {
+            {
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_conditions(m_conditions, access_location::host, access_mode::readwrite);
+            ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+
+            memset((void*)h_n_neigh.data, 0, sizeof(unsigned int)*N);
+
+            // the cluster pairs are stale if the particles were resorted since the last build
+            for (unsigned int ci = 0; ci < m_n_local_clusters && m_pair_head.size() == m_n_local_clusters + 1; ci++)
+                {
+                for (unsigned int cur_pair = m_pair_head[ci]; cur_pair < m_pair_head[ci+1]; cur_pair++)
+                    {
+                    const ClusterPair& pair = m_pairs[cur_pair];
+                    for (unsigned int bit = 0; bit < M*M; bit++)
+                        {
+                        if (!((pair.mask >> bit) & 1))
+                            continue;
+
+                        unsigned int i = m_cluster_members[ci*M + bit / M];
+                        unsigned int j = m_cluster_members[pair.j*M + bit % M];
+                        if (i >= N || j >= n_max)
+                            continue;
+
+                        // list j as a neighbor of i, and i as a neighbor of j if both are local and needed
+                        unsigned int first = i, second = j;
+                        if (j < N && m_storage_mode == half && j < i)
+                            std::swap(first, second);
+
+                        for (unsigned int pass = 0; pass < 2; pass++)
+                            {
+                            unsigned int type = __scalar_as_int(h_pos.data[first].w);
+                            unsigned int n = h_n_neigh.data[first];
+                            if (n < h_Nmax.data[type])
+                                h_nlist.data[h_head_list.data[first] + n] = second;
+                            else
+                                h_conditions.data[type] = max(h_conditions.data[type], n+1);
+                            h_n_neigh.data[first] = n + 1;
+
+                            if (!(m_storage_mode == full && j < N))
+                                break;
+                            std::swap(first, second);
+                            }
+                        }
+                    }
+                }
+            }
+
+        overflowed = checkConditions();
+        if (overflowed)
+            {
+            buildHeadList();
+            resetConditions();
+            }
+        } while (overflowed);
+
+    m_nlist_expanded = true;
+
+    if (m_prof) m_prof->pop();
+    }
+
+void NeighborListCluster::printStats()
+    {
+    // the base class statistics are taken from the per-particle list
+    updatePerParticleNlist();
+    NeighborList::printStats();
+
+    if (m_exec_conf->msg->getNoticeLevel() < 1)
+        return;
+
+    // fraction of the computed particle pairs that are within the list radius
+    const unsigned int M = m_cluster_size;
+    Scalar n_interactions = Scalar(0.0);
+    for (unsigned int cur_pair = 0; cur_pair < m_pairs.size(); cur_pair++)
+        n_interactions += Scalar(std::bitset<64>(m_pairs[cur_pair].mask).count());
+    Scalar fill = m_pairs.size() ? n_interactions / (Scalar(m_pairs.size()) * Scalar(M*M)) : Scalar(0.0);
+
+    m_exec_conf->msg->notice(1) << "n_clusters: " << getNClusters() << " (" << m_n_local_clusters << " local) / "
+                                << "cluster size: " << M << " / n_cluster_pairs: " << m_pairs.size()
+                                << " / mask fill: " << fill << endl;
+    }
+
+void export_NeighborListCluster(py::module& m)
+    {
+    py::class_<NeighborListCluster, std::shared_ptr<NeighborListCluster> >(m, "NeighborListCluster", py::base<NeighborList>())
+    .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, Scalar, unsigned int >())
+    .def("setClusterSize", &NeighborListCluster::setClusterSize)
+                     ;
+    }
@@ -0,0 +1,181 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "NeighborList.h"
+
+#include <stdint.h>
+
+/*! \file NeighborListCluster.h
+    \brief Declares the NeighborListCluster class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTCLUSTER_H__
+#define __NEIGHBORLISTCLUSTER_H__
+
+//! Member index of the padding slots of a cluster
+const unsigned int NO_PARTICLE = 0xffffffff;
+
+//! Cluster pair neighbor list on the CPU
+/*! Instead of storing the neighbors of every particle, NeighborListCluster groups the particles into spatial clusters
+    of M = 4 or 8 particles and stores the pairs of clusters that have at least one particle pair within r_list.
+
+    <b>Clusters:</b>
+
+    The particles are binned into columns in the x-y plane (in x for 2D systems) and sorted along the remaining
+    direction. Each column is cut into clusters of M consecutive particles, padding the last cluster of a column with
+    NO_PARTICLE. The local particles are clustered first, followed by the ghost particles, so that the clusters
+    [0, getNLocalClusters()) contain only local particles and the remaining clusters only ghosts. The members of
+    cluster c are getClusterMembers()[c*M + k] for k < M.
+
+    <b>Cluster pairs:</b>
+
+    For each local cluster i, getClusterPairs() lists the clusters j in the range [getClusterPairHead()[i],
+    getClusterPairHead()[i+1]). Each entry stores an M*M interaction mask. Bit a*M + b of the mask is set when member
+    a of cluster i and member b of cluster j are within r_list(i,j) (including the diameter shift) in any periodic
+    image and the pair is not excluded. Every particle pair appears in at most one mask: pairs of local clusters are
+    only stored for j >= i, and a cluster paired with itself only sets the bits with b > a. The list is a half list
+    irrespective of the storage mode.
+
+    <b>Periodic images:</b>
+
+    Each cluster pair also stores the periodic image of cluster j that it was found in, as an index into getImages().
+    The displacement of member a of cluster i from member b of cluster j is x_a - (x_b + shift), where shift is the
+    combination of the current lattice vectors given by the image, provided that both positions are taken in the frame
+    of the build. Particles wrap across the boundaries between builds, so consumers first map each position back to
+    that frame with the minimum image relative to the center of its cluster at the build (getClusterCenters()). This
+    costs one minimum image per particle instead of one per pair.
+
+    <b>Per-particle data:</b>
+
+    Consumers that read getNListArray() get the same per-particle list as from NeighborListBinned, in the requested
+    storage mode. It is expanded from the cluster pairs on the first access after each build in
+    updatePerParticleNlist(), so it costs nothing for consumers (PotentialPair) that read the cluster pairs directly.
+    Exclusions are applied to the masks during the build and filterNlist() is a no-op.
+
+    \ingroup computes
+*/
+class NeighborListCluster : public NeighborList
+    {
+    public:
+        //! A pair of interacting clusters
+        struct ClusterPair
+            {
+            uint64_t mask;          //!< Interaction mask, bit a*M+b couples member a of cluster i and member b of cluster j
+            unsigned int j;         //!< Index of cluster j
+            unsigned int image;     //!< Index of the periodic image of cluster j in getImages()
+            };
+
+        //! Constructs the compute
+        NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef,
+                            Scalar r_cut,
+                            Scalar r_buff,
+                            unsigned int cluster_size = 4);
+
+        //! Destructor
+        virtual ~NeighborListCluster();
+
+        //! Set the number of particles per cluster
+        void setClusterSize(unsigned int cluster_size);
+
+        //! Get the number of particles per cluster
+        unsigned int getClusterSize() const
+            {
+            return m_cluster_size;
+            }
+
+        //! Get the number of clusters of local particles
+        unsigned int getNLocalClusters() const
+            {
+            return m_n_local_clusters;
+            }
+
+        //! Get the total number of clusters, including the ghost clusters
+        unsigned int getNClusters() const
+            {
+            return m_cluster_members.size() / m_cluster_size;
+            }
+
+        //! Get the particle indices of the cluster members (NO_PARTICLE for padding)
+        const std::vector<unsigned int>& getClusterMembers() const
+            {
+            return m_cluster_members;
+            }
+
+        //! Get the centers of the clusters at the last build
+        const std::vector<Scalar3>& getClusterCenters() const
+            {
+            return m_cluster_center;
+            }
+
+        //! Get the periodic images the cluster pairs refer to, the first one is the zero image
+        const std::vector<int3>& getImages() const
+            {
+            return m_images;
+            }
+
+        //! Get the offset of the first pair of each local cluster in getClusterPairs()
+        const std::vector<unsigned int>& getClusterPairHead() const
+            {
+            return m_pair_head;
+            }
+
+        //! Get the cluster pairs
+        const std::vector<ClusterPair>& getClusterPairs() const
+            {
+            return m_pairs;
+            }
+
+        //! Print statistics on the neighborlist
+        virtual void printStats();
+
+    protected:
+        //! Builds the neighbor list
+        virtual void buildNlist(unsigned int timestep);
+
+        //! Exclusions are already applied to the interaction masks
+        virtual void filterNlist()
+            {
+            }
+
+        //! Expand the cluster pairs into the per-particle neighbor list
+        virtual void updatePerParticleNlist();
+
+        //! The clusters are rebuilt after a particle sort
+        virtual bool remapNlist(const unsigned int *order, const unsigned int *inverse)
+            {
+            return false;
+            }
+
+    private:
+        unsigned int m_cluster_size;                    //!< Number of particles per cluster (M)
+        unsigned int m_n_local_clusters;                //!< Number of clusters of local particles
+        std::vector<unsigned int> m_cluster_members;    //!< Particle indices of the members of each cluster
+        std::vector<Scalar3> m_cluster_lo;              //!< Lower corner of the bounding box of each cluster
+        std::vector<Scalar3> m_cluster_hi;              //!< Upper corner of the bounding box of each cluster
+        std::vector<Scalar3> m_cluster_center;          //!< Center of the bounding box of each cluster
+        std::vector<int3> m_images;                     //!< Periodic images tested in the last build
+        std::vector<unsigned int> m_pair_head;          //!< First pair of each local cluster (size n_local + 1)
+        std::vector<ClusterPair> m_pairs;               //!< Cluster pairs
+        bool m_nlist_expanded;                          //!< True if m_nlist matches the current cluster pairs
+
+        std::vector<unsigned int> m_sort_idx;           //!< Temporary particle order for clustering
+        std::vector<unsigned int> m_bin_head;           //!< Temporary cluster bins (offsets)
+        std::vector<unsigned int> m_bin_clusters;       //!< Temporary cluster bins (cluster indices)
+
+        //! Group a range of particles into clusters
+        void buildClusters(const Scalar4 *h_pos, unsigned int first, unsigned int last, Scalar width);
+    };
+
+//! Exports NeighborListCluster to python
+void export_NeighborListCluster(pybind11::module& m);
+
+#endif
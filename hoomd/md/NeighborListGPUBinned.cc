@@ -101,6 +101,17 @@ void NeighborListGPUBinned::setMaximumDiameter(Scalar d_max)
     m_cl->setNominalWidth(rmax);
     }
 
+void NeighborListGPUBinned::setRBuff(Scalar r_buff)
+    {
+    NeighborListGPU::setRBuff(r_buff);
+
+    Scalar rmax = getMaxRCut() + m_r_buff;
+    if (m_diameter_shift)
+        rmax += m_d_max - Scalar(1.0);
+
+    m_cl->setNominalWidth(rmax);
+    }
+
 void NeighborListGPUBinned::buildNlist(unsigned int timestep)
     {
     if (m_storage_mode != full)
@@ -46,6 +46,9 @@ class NeighborListGPUBinned : public NeighborListGPU
         //! Change the cutoff radius by pair type
         virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
 
+        //! Change the global buffer radius
+        virtual void setRBuff(Scalar r_buff);
+
         //! Set the autotuner period
         void setTuningParam(unsigned int param)
             {
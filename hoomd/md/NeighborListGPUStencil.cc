@@ -145,6 +145,20 @@ void NeighborListGPUStencil::setMaximumDiameter(Scalar d_max)
         }
     }
 
+void NeighborListGPUStencil::setRBuff(Scalar r_buff)
+    {
+    NeighborListGPU::setRBuff(r_buff);
+
+    if (!m_override_cell_width)
+        {
+        Scalar rmin = getMinRCut() + m_r_buff;
+        if (m_diameter_shift)
+            rmin += m_d_max - Scalar(1.0);
+
+        m_cl->setNominalWidth(rmin);
+        }
+    }
+
 void NeighborListGPUStencil::updateRStencil()
     {
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
@@ -48,6 +48,9 @@ class NeighborListGPUStencil : public NeighborListGPU
         //! Change the cutoff radius by pair type
         virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
 
+        //! Change the global buffer radius
+        virtual void setRBuff(Scalar r_buff);
+
         //! Change the underlying cell width
         void setCellWidth(Scalar cell_width)
             {
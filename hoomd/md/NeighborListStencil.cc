@@ -102,6 +102,20 @@ void NeighborListStencil::setMaximumDiameter(Scalar d_max)
         }
     }
 
+void NeighborListStencil::setRBuff(Scalar r_buff)
+    {
+    NeighborList::setRBuff(r_buff);
+
+    if (!m_override_cell_width)
+        {
+        Scalar rmin = getMinRCut() + m_r_buff;
+        if (m_diameter_shift)
+            rmin += m_d_max - Scalar(1.0);
+
+        m_cl->setNominalWidth(rmin);
+        }
+    }
+
 void NeighborListStencil::updateRStencil()
     {
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
@@ -167,6 +181,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
     // access the cell list data arrays
     ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_offset(m_cl->getCellOffsetArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_cell_tdb(m_cl->getTDBArray(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_stencil(m_cls->getStencils(), access_location::host, access_mode::read);
@@ -182,7 +197,6 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
 
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
@@ -266,10 +280,11 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
+            const unsigned int first = h_cell_offset.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
                 // read in the particle type (diameter and body as well while we've got the Scalar4 in)
-                const Scalar4& neigh_tdb = h_cell_tdb.data[cli(cur_offset, neigh_cell)];
+                const Scalar4& neigh_tdb = h_cell_tdb.data[first + cur_offset];
                 const unsigned int type_j = __scalar_as_int(neigh_tdb.x);
                 const Scalar diam_j = neigh_tdb.y;
                 const unsigned int body_j = __scalar_as_int(neigh_tdb.z);
@@ -297,7 +312,7 @@ void NeighborListStencil::buildNlist(unsigned int timestep)
                 if (cell_dist2 > r_listsq) continue;
 
                 // only load in the particle position and id if distance check is satisfied
-                const Scalar4& neigh_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                const Scalar4& neigh_xyzf = h_cell_xyzf.data[first + cur_offset];
                 unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
 
                 // a particle cannot neighbor itself
@@ -3,6 +3,10 @@
 
 #include "PPPMForceCompute.h"
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 namespace py = pybind11;
 
 bool is_pow2(unsigned int n)
@@ -17,6 +21,157 @@ const Scalar cpu_sinc_coeff[] = {Scalar(1.0), Scalar(-1.0/6.0), Scalar(1.0/120.0
                         Scalar(-1.0/5040.0),Scalar(1.0/362880.0),
                         Scalar(-1.0/39916800.0)};
 
+//! Transform two real rows with a single complex FFT
+/*! \param cfg Forward FFT of length \a n
+    \param n Length of the rows
+    \param a First real row
+    \param b Second real row (may be NULL)
+    \param out_a Receives the n/2+1 non-redundant Fourier coefficients of \a a
+    \param out_b Receives the n/2+1 non-redundant Fourier coefficients of \a b (ignored if \a b is NULL)
+    \param buf Scratch space of 2*n elements
+
+    The rows are packed into z = a + i b. Since a and b are real, their transforms are recovered from
+    A[k] = (Z[k] + conj(Z[n-k]))/2 and B[k] = (Z[k] - conj(Z[n-k]))/(2i).
+*/
+static void fft_real_pair(kiss_fft_cfg cfg, unsigned int n, const Scalar *a, const Scalar *b,
+    kiss_fft_cpx *out_a, kiss_fft_cpx *out_b, kiss_fft_cpx *buf)
+    {
+    kiss_fft_cpx *in = buf;
+    kiss_fft_cpx *z = buf + n;
+
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        in[i].r = a[i];
+        in[i].i = b ? b[i] : Scalar(0.0);
+        }
+
+    kiss_fft(cfg, in, z);
+
+    unsigned int nh = n/2 + 1;
+    for (unsigned int k = 0; k < nh; ++k)
+        {
+        kiss_fft_cpx zk = z[k];
+        kiss_fft_cpx zm = z[(n - k) % n];
+
+        if (! b)
+            {
+            out_a[k] = zk;
+            continue;
+            }
+
+        out_a[k].r = Scalar(0.5)*(zk.r + zm.r);
+        out_a[k].i = Scalar(0.5)*(zk.i - zm.i);
+        out_b[k].r = Scalar(0.5)*(zk.i + zm.i);
+        out_b[k].i = Scalar(0.5)*(zm.r - zk.r);
+        }
+    }
+
+//! Transform the non-redundant Fourier coefficients of two real rows back with a single complex FFT
+/*! \param cfg Inverse FFT of length \a n
+    \param n Length of the rows
+    \param a n/2+1 Fourier coefficients of the first row
+    \param b n/2+1 Fourier coefficients of the second row (may be NULL)
+    \param out_a Receives the first real row
+    \param out_b Receives the second real row (ignored if \a b is NULL)
+    \param buf Scratch space of 2*n elements
+
+    The coefficients are extended to all n wave vectors by Hermitian symmetry and packed into Z = A + i B, so that
+    the real and imaginary parts of the transform are the two rows. Only the real parts of the self-conjugate
+    coefficients (k = 0 and k = n/2) contribute to a real row.
+*/
+static void ifft_real_pair(kiss_fft_cfg cfg, unsigned int n, const kiss_fft_cpx *a, const kiss_fft_cpx *b,
+    Scalar *out_a, Scalar *out_b, kiss_fft_cpx *buf)
+    {
+    kiss_fft_cpx *in = buf;
+    kiss_fft_cpx *z = buf + n;
+
+    unsigned int nh = n/2 + 1;
+    for (unsigned int k = 0; k < nh; ++k)
+        {
+        kiss_fft_cpx ak = a[k];
+        kiss_fft_cpx bk;
+        bk.r = b ? b[k].r : Scalar(0.0);
+        bk.i = b ? b[k].i : Scalar(0.0);
+
+        bool self_conjugate = (k == 0 || 2*k == n);
+        if (self_conjugate)
+            {
+            ak.i = Scalar(0.0);
+            bk.i = Scalar(0.0);
+            }
+
+        in[k].r = ak.r - bk.i;
+        in[k].i = ak.i + bk.r;
+
+        if (! self_conjugate)
+            {
+            in[n-k].r = ak.r + bk.i;
+            in[n-k].i = bk.r - ak.i;
+            }
+        }
+
+    kiss_fft(cfg, in, z);
+
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        out_a[i] = z[i].r;
+        if (b)
+            out_b[i] = z[i].i;
+        }
+    }
+
+//! Transform the columns of several complex meshes in place
+/*! \param cfg FFT of length \a n
+    \param data Meshes to transform
+    \param n_data Number of meshes
+    \param n Length of a column
+    \param stride Distance between two consecutive elements of a column
+    \param n_columns Number of columns in every mesh
+
+    Column c starts at element (c % stride) + (c / stride)*stride*n. The columns of all meshes are distributed among
+    the OpenMP threads together.
+*/
+static void fft_columns(kiss_fft_cfg cfg, kiss_fft_cpx **data, unsigned int n_data, unsigned int n,
+    unsigned int stride, unsigned int n_columns)
+    {
+    #pragma omp parallel
+        {
+        std::vector<kiss_fft_cpx> buf(n);
+
+        #pragma omp for schedule(static)
+        for (int task = 0; task < (int)(n_data*n_columns); ++task)
+            {
+            unsigned int c = task % n_columns;
+            kiss_fft_cpx *column = data[task / n_columns] + (c % stride) + (c / stride)*stride*n;
+
+            kiss_fft_stride(cfg, column, &buf.front(), stride);
+            for (unsigned int i = 0; i < n; ++i)
+                column[i*stride] = buf[i];
+            }
+        }
+    }
+
+//! Add the virial coefficients of one wave vector
+/*! \param inf_f Influence function
+    \param k Wave vector
+    \param kappa Screening parameter
+    \param v Six virial coefficients (xx, xy, xz, yy, yz, zz) to add to
+*/
+static void add_mode_virial(Scalar inf_f, Scalar3 k, Scalar kappa, Scalar *v)
+    {
+    Scalar ksq = dot(k,k);
+    if (ksq == Scalar(0.0))
+        return;
+
+    Scalar vterm = -Scalar(2.0)*(Scalar(1.0)/ksq + Scalar(0.25)/(kappa*kappa));
+    v[0] += inf_f*(Scalar(1.0) + vterm*k.x*k.x);
+    v[1] += inf_f*(              vterm*k.x*k.y);
+    v[2] += inf_f*(              vterm*k.x*k.z);
+    v[3] += inf_f*(Scalar(1.0) + vterm*k.y*k.y);
+    v[4] += inf_f*(              vterm*k.y*k.z);
+    v[5] += inf_f*(Scalar(1.0) + vterm*k.z*k.z);
+    }
+
 /*! \param sysdef The system definition
     \param nx Number of cells along first axis
     \param ny Number of cells along second axis
@@ -36,6 +191,7 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_n_cells(0),
       m_radius(1),
       m_n_inner_cells(0),
+      m_n_fourier_cells(0),
       m_need_initialize(true),
       m_params_set(false),
       m_box_changed(false),
@@ -136,19 +292,7 @@ void PPPMForceCompute::setParams(unsigned int nx, unsigned int ny, unsigned int
 
 PPPMForceCompute::~PPPMForceCompute()
     {
-    if (m_kiss_fft_initialized)
-        {
-        free(m_kiss_fft);
-        free(m_kiss_ifft);
-        kiss_fft_cleanup();
-        }
-    #ifdef ENABLE_MPI
-    if (m_dfft_initialized)
-        {
-        dfft_destroy_plan(m_dfft_plan_forward);
-        dfft_destroy_plan(m_dfft_plan_inverse);
-        }
-    #endif
+    destroyFFT();
     m_pdata->getBoxChangeSignal().disconnect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
     }
 
@@ -371,17 +515,20 @@ void PPPMForceCompute::setupMesh()
     m_n_cells = m_grid_dim.x*m_grid_dim.y*m_grid_dim.z;
     m_n_inner_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
 
+    // initializeFFT() reduces the number of stored wave vectors for a real-to-complex transform
+    m_n_fourier_cells = m_n_inner_cells;
+
+    initializeFFT();
+
     // allocate memory for influence function and k values
-    GPUArray<Scalar> inf_f(m_n_inner_cells, m_exec_conf);
+    GPUArray<Scalar> inf_f(m_n_fourier_cells, m_exec_conf);
     m_inf_f.swap(inf_f);
 
-    GPUArray<Scalar3> k(m_n_inner_cells, m_exec_conf);
+    GPUArray<Scalar3> k(m_n_fourier_cells, m_exec_conf);
     m_k.swap(k);
 
-    GPUArray<Scalar> virial_mesh(6*m_n_inner_cells, m_exec_conf);
+    GPUArray<Scalar> virial_mesh(6*m_n_fourier_cells, m_exec_conf);
     m_virial_mesh.swap(virial_mesh);
-
-    initializeFFT();
     }
 
 uint3 PPPMForceCompute::computeGhostCellNum()
@@ -418,6 +565,9 @@ uint3 PPPMForceCompute::computeGhostCellNum()
 
 void PPPMForceCompute::initializeFFT()
     {
+    // the mesh may be re-initialized when the number of ghost cells changes
+    destroyFFT();
+
     bool local_fft = true;
 
     #ifdef ENABLE_MPI
@@ -426,15 +576,15 @@ void PPPMForceCompute::initializeFFT()
     if (! local_fft)
         {
         // ghost cell communicator for charge interpolation
-        m_grid_comm_forward = std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> >(
-            new CommunicatorGrid<kiss_fft_cpx>(m_sysdef,
+        m_grid_comm_forward = std::unique_ptr<CommunicatorGrid<Scalar> >(
+            new CommunicatorGrid<Scalar>(m_sysdef,
                make_uint3(m_mesh_points.x, m_mesh_points.y, m_mesh_points.z),
                make_uint3(m_grid_dim.x, m_grid_dim.y, m_grid_dim.z),
                m_n_ghost_cells,
                true));
         // ghost cell communicator for force mesh
-        m_grid_comm_reverse = std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> >(
-            new CommunicatorGrid<kiss_fft_cpx>(m_sysdef,
+        m_grid_comm_reverse = std::unique_ptr<CommunicatorGrid<Scalar> >(
+            new CommunicatorGrid<Scalar>(m_sysdef,
                make_uint3(m_mesh_points.x, m_mesh_points.y, m_mesh_points.z),
                make_uint3(m_grid_dim.x, m_grid_dim.y, m_grid_dim.z),
                m_n_ghost_cells,
@@ -449,11 +599,6 @@ void PPPMForceCompute::initializeFFT()
         gdim[0] = m_mesh_points.z*pdim[0];
         gdim[1] = m_mesh_points.y*pdim[1];
         gdim[2] = m_mesh_points.x*pdim[2];
-        int embed[3];
-        embed[0] = m_mesh_points.z+2*m_n_ghost_cells.z;
-        embed[1] = m_mesh_points.y+2*m_n_ghost_cells.y;
-        embed[2] = m_mesh_points.x+2*m_n_ghost_cells.x;
-        m_ghost_offset = (m_n_ghost_cells.z*embed[1]+m_n_ghost_cells.y)*embed[2]+m_n_ghost_cells.x;
         uint3 pcoord = m_pdata->getDomainDecomposition()->getGridPos();
         int pidx[3];
         pidx[0] = pcoord.z;
@@ -462,55 +607,181 @@ void PPPMForceCompute::initializeFFT()
         int row_m = 0; /* both local grid and proc grid are row major, no transposition necessary */
         ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
             access_location::host, access_mode::read);
-        dfft_create_plan(&m_dfft_plan_forward, 3, gdim, embed, NULL, pdim, pidx,
+        // the real meshes are copied to and from the complex buffer without ghost cells
+        dfft_create_plan(&m_dfft_plan_forward, 3, gdim, NULL, NULL, pdim, pidx,
             row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
-        dfft_create_plan(&m_dfft_plan_inverse, 3, gdim, NULL, embed, pdim, pidx,
+        dfft_create_plan(&m_dfft_plan_inverse, 3, gdim, NULL, NULL, pdim, pidx,
             row_m, 0, 1, m_exec_conf->getMPICommunicator(), (int *)h_cart_ranks.data);
         m_dfft_initialized = true;
+
+        GPUArray<kiss_fft_cpx> dfft_buf(m_n_inner_cells, m_exec_conf);
+        m_dfft_buf.swap(dfft_buf);
         }
     #endif // ENABLE_MPI
 
     if (local_fft)
         {
-        int dims[3];
-        dims[0] = m_mesh_points.z;
-        dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
-
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+        // one-dimensional transforms for the real-to-complex FFT
+        m_kiss_fft_x = kiss_fft_alloc(m_mesh_points.x, 0, NULL, NULL);
+        m_kiss_fft_y = kiss_fft_alloc(m_mesh_points.y, 0, NULL, NULL);
+        m_kiss_fft_z = kiss_fft_alloc(m_mesh_points.z, 0, NULL, NULL);
+        m_kiss_ifft_x = kiss_fft_alloc(m_mesh_points.x, 1, NULL, NULL);
+        m_kiss_ifft_y = kiss_fft_alloc(m_mesh_points.y, 1, NULL, NULL);
+        m_kiss_ifft_z = kiss_fft_alloc(m_mesh_points.z, 1, NULL, NULL);
 
         m_kiss_fft_initialized = true;
+
+        // only the non-negative wave vectors along x are stored
+        m_n_fourier_cells = (m_mesh_points.x/2+1)*m_mesh_points.y*m_mesh_points.z;
         }
 
     // allocate mesh and transformed mesh
-
-    // pad with offset
-    GPUArray<kiss_fft_cpx> mesh(m_n_cells + m_ghost_offset,m_exec_conf);
+    GPUArray<Scalar> mesh(m_n_cells, m_exec_conf);
     m_mesh.swap(mesh);
 
-    GPUArray<kiss_fft_cpx> fourier_mesh(m_n_inner_cells, m_exec_conf);
+    GPUArray<kiss_fft_cpx> fourier_mesh(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh.swap(fourier_mesh);
 
-    GPUArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_inner_cells, m_exec_conf);
+    GPUArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_x.swap(fourier_mesh_G_x);
 
-    GPUArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_inner_cells, m_exec_conf);
+    GPUArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_y.swap(fourier_mesh_G_y);
 
-    GPUArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_inner_cells, m_exec_conf);
+    GPUArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_z.swap(fourier_mesh_G_z);
 
-    // pad with offset
-
-    GPUArray<kiss_fft_cpx> inv_fourier_mesh_x(m_n_cells+m_ghost_offset, m_exec_conf);
+    GPUArray<Scalar> inv_fourier_mesh_x(m_n_cells, m_exec_conf);
     m_inv_fourier_mesh_x.swap(inv_fourier_mesh_x);
 
-    GPUArray<kiss_fft_cpx> inv_fourier_mesh_y(m_n_cells+m_ghost_offset, m_exec_conf);
+    GPUArray<Scalar> inv_fourier_mesh_y(m_n_cells, m_exec_conf);
     m_inv_fourier_mesh_y.swap(inv_fourier_mesh_y);
 
-    GPUArray<kiss_fft_cpx> inv_fourier_mesh_z(m_n_cells+m_ghost_offset, m_exec_conf);
+    GPUArray<Scalar> inv_fourier_mesh_z(m_n_cells, m_exec_conf);
     m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
+
+    GPUArray<Scalar3> kinf_f(m_n_fourier_cells, m_exec_conf);
+    m_kinf_f.swap(kinf_f);
+    }
+
+void PPPMForceCompute::destroyFFT()
+    {
+    if (m_kiss_fft_initialized)
+        {
+        kiss_fft_free(m_kiss_fft_x);
+        kiss_fft_free(m_kiss_fft_y);
+        kiss_fft_free(m_kiss_fft_z);
+        kiss_fft_free(m_kiss_ifft_x);
+        kiss_fft_free(m_kiss_ifft_y);
+        kiss_fft_free(m_kiss_ifft_z);
+        kiss_fft_cleanup();
+        m_kiss_fft_initialized = false;
+        }
+    #ifdef ENABLE_MPI
+    if (m_dfft_initialized)
+        {
+        dfft_destroy_plan(m_dfft_plan_forward);
+        dfft_destroy_plan(m_dfft_plan_inverse);
+        m_dfft_initialized = false;
+        }
+    #endif
+    }
+
+/*! The charge mesh is transformed along x by packing pairs of rows into one complex FFT (see fft_real_pair()),
+    followed by complex FFTs along y and z on the half mesh. The result in m_fourier_mesh has the layout
+    kx + (m_mesh_points.x/2+1)*(ky + m_mesh_points.y*kz), with 0 <= kx <= m_mesh_points.x/2.
+*/
+void PPPMForceCompute::forwardFFTR2C()
+    {
+    const unsigned int nx = m_mesh_points.x;
+    const unsigned int ny = m_mesh_points.y;
+    const unsigned int nz = m_mesh_points.z;
+    const unsigned int nxh = nx/2+1;
+    const unsigned int n_rows = ny*nz;
+
+    ArrayHandle<Scalar> h_mesh(m_mesh, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
+
+    const Scalar *mesh = h_mesh.data;
+    kiss_fft_cpx *fourier_mesh = h_fourier_mesh.data;
+
+    // real-to-complex transform along x
+    #pragma omp parallel
+        {
+        std::vector<kiss_fft_cpx> buf(2*nx);
+
+        #pragma omp for schedule(static)
+        for (int pair = 0; pair < (int)((n_rows+1)/2); ++pair)
+            {
+            unsigned int row = 2*pair;
+            bool has_second = row+1 < n_rows;
+            fft_real_pair(m_kiss_fft_x, nx,
+                mesh + row*nx,
+                has_second ? mesh + (row+1)*nx : NULL,
+                fourier_mesh + row*nxh,
+                has_second ? fourier_mesh + (row+1)*nxh : NULL,
+                &buf.front());
+            }
+        }
+
+    // complex transforms along y and z
+    fft_columns(m_kiss_fft_y, &fourier_mesh, 1, ny, nxh, nxh*nz);
+    fft_columns(m_kiss_fft_z, &fourier_mesh, 1, nz, nxh*ny, nxh*ny);
+    }
+
+/*! The three components of the force mesh are transformed together: the complex passes along z and y work on the
+    columns of all three meshes at once, and the complex-to-real pass along x packs pairs of rows into one complex
+    FFT (see ifft_real_pair()). The transforms are done in place on m_fourier_mesh_G_x, _y and _z.
+*/
+void PPPMForceCompute::inverseFFTC2R()
+    {
+    const unsigned int nx = m_mesh_points.x;
+    const unsigned int ny = m_mesh_points.y;
+    const unsigned int nz = m_mesh_points.z;
+    const unsigned int nxh = nx/2+1;
+    const unsigned int n_rows = ny*nz;
+
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::readwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::readwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
+
+    kiss_fft_cpx *G[3] = {h_fourier_mesh_G_x.data, h_fourier_mesh_G_y.data, h_fourier_mesh_G_z.data};
+    Scalar *E[3] = {h_inv_fourier_mesh_x.data, h_inv_fourier_mesh_y.data, h_inv_fourier_mesh_z.data};
+
+    // complex transforms along z and y
+    fft_columns(m_kiss_ifft_z, G, 3, nz, nxh*ny, nxh*ny);
+    fft_columns(m_kiss_ifft_y, G, 3, ny, nxh, nxh*nz);
+
+    // complex-to-real transform along x, the rows of all components are paired in sequence
+    const unsigned int n_all_rows = 3*n_rows;
+
+    #pragma omp parallel
+        {
+        std::vector<kiss_fft_cpx> buf(2*nx);
+
+        #pragma omp for schedule(static)
+        for (int pair = 0; pair < (int)((n_all_rows+1)/2); ++pair)
+            {
+            unsigned int first = 2*pair;
+            unsigned int second = first+1;
+            bool has_second = second < n_all_rows;
+
+            unsigned int comp_a = first / n_rows;
+            unsigned int row_a = first % n_rows;
+            unsigned int comp_b = has_second ? second / n_rows : 0;
+            unsigned int row_b = has_second ? second % n_rows : 0;
+
+            ifft_real_pair(m_kiss_ifft_x, nx,
+                G[comp_a] + row_a*nxh,
+                has_second ? G[comp_b] + row_b*nxh : NULL,
+                E[comp_a] + row_a*nx,
+                has_second ? E[comp_b] + row_b*nx : NULL,
+                &buf.front());
+            }
+        }
     }
 
 //! CPU implementation of sinc(x)==sin(x)/x
@@ -535,16 +806,123 @@ inline Scalar sinc(Scalar x)
     return sinc;
     }
 
+/*! \param wave_idx Index of the mode on the global mesh
+    \param nb Number of aliasing images to sum over along every direction
+    \param b1 First reciprocal lattice vector
+    \param b2 Second reciprocal lattice vector
+    \param b3 Third reciprocal lattice vector
+    \param kH Wave number of the mesh spacing along every direction
+    \param inf_f Receives the optimal influence function of the mode
+    \param k Receives the wave vector of the mode
+*/
+void PPPMForceCompute::computeModeInfluence(uint3 wave_idx, int3 nb, Scalar3 b1, Scalar3 b2, Scalar3 b3,
+    Scalar3 kH, Scalar& inf_f, Scalar3& k)
+    {
+    int3 n = make_int3(wave_idx.x,wave_idx.y,wave_idx.z);
+
+    // compute Miller indices
+    if (n.x >= (int)(m_global_dim.x/2 + m_global_dim.x%2))
+        n.x -= (int) m_global_dim.x;
+    if (n.y >= (int)(m_global_dim.y/2 + m_global_dim.y%2))
+        n.y -= (int) m_global_dim.y;
+    if (n.z >= (int)(m_global_dim.z/2 + m_global_dim.z%2))
+        n.z -= (int) m_global_dim.z;
+
+    k = (Scalar)n.x*b1+(Scalar)n.y*b2+(Scalar)n.z*b3;
+
+    Scalar snx = fast::sin(0.5*kH.x*(Scalar)n.x);
+    Scalar sny = fast::sin(0.5*kH.y*(Scalar)n.y);
+    Scalar snz = fast::sin(0.5*kH.z*(Scalar)n.z);
+
+    if (n.x != 0 || n.y != 0 || n.z != 0)
+        {
+        Scalar sum1(0.0);
+        Scalar numerator = Scalar(4.0*M_PI)/dot(k,k);
+
+        Scalar denominator = gf_denom(snx*snx, sny*sny, snz*snz);
+
+        for (int ix = -nb.x; ix <= nb.x; ix++)
+            {
+            Scalar qx = ((Scalar)n.x + (Scalar)ix*m_global_dim.x);
+            Scalar3 knx = qx*b1;
+
+            Scalar argx = Scalar(0.5)*qx*kH.x;
+            Scalar wxs = sinc(argx);
+            Scalar wx(1.0);
+            for (int iorder = 0; iorder < m_order; ++iorder)
+                {
+                wx *= wxs;
+                }
+
+            for (int iy = -nb.y; iy <= nb.y; iy++)
+                {
+                Scalar qy = ((Scalar)n.y + (Scalar)iy*m_global_dim.y);
+                Scalar3 kny = qy*b2;
+
+                Scalar argy = Scalar(0.5)*qy*kH.y;
+                Scalar wys = sinc(argy);
+                Scalar wy(1.0);
+                for (int iorder = 0; iorder < m_order; ++iorder)
+                    {
+                    wy *= wys;
+                    }
+
+                for (int iz = -nb.z; iz <= nb.z; iz++)
+                    {
+                    Scalar qz = ((Scalar)n.z + (Scalar)iz*m_global_dim.z);
+                    Scalar3 knz = qz*b3;
+
+                    Scalar argz = Scalar(0.5)*qz*kH.z;
+                    Scalar wzs = sinc(argz);
+                    Scalar wz(1.0);
+                    for (int iorder = 0; iorder < m_order; ++iorder)
+                        {
+                        wz *= wzs;
+                        }
+
+                    Scalar3 kn = knx + kny + knz;
+                    Scalar dot1 = dot(kn, k);
+                    Scalar dot2 = dot(kn, kn);
+
+                    Scalar arg_gauss = Scalar(0.25)*dot2/m_kappa/m_kappa;
+                    Scalar gauss = exp(-arg_gauss);
+
+                    sum1 += (dot1/dot2) * gauss * wx * wx * wy * wy * wz * wz;
+                    }
+                }
+            }
+        inf_f = numerator*sum1/denominator;
+        }
+    else // q=0
+        {
+        inf_f = Scalar(0.0);
+        }
+    }
+
+/*! For every stored mode, m_inf_f holds the weight of |rho(k)|^2 in the energy, m_kinf_f the vector that multiplies
+    -i rho(k) to give the force mesh, and m_virial_mesh the weights of |rho(k)|^2 in the six virial components (at
+    offset i*m_n_fourier_cells for component i).
+
+    On the half mesh of the real-to-complex transform, a mode with 0 < kx < m_mesh_points.x/2 also stands for its
+    mirror image -k. The energy and virial weights of both are summed. The force mesh is the Hermitian part
+    (G(k) + conj(G(-k)))/2 of the full mesh, which the complex-to-real transform doubles, so m_kinf_f is
+    (k inf_f(k) - k' inf_f(-k))/2 where k' is the wave vector of the mirror image. This reproduces the full complex
+    transform exactly, including the modes at the Nyquist frequency.
+*/
 void PPPMForceCompute::computeInfluenceFunction()
     {
     if (m_prof) m_prof->push("influence function");
 
     ArrayHandle<Scalar> h_inf_f(m_inf_f,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar3> h_k(m_k,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar3> h_kinf_f(m_kinf_f,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial_mesh(m_virial_mesh,access_location::host, access_mode::overwrite);
 
     // reset arrays
     memset(h_inf_f.data, 0, sizeof(Scalar)*m_inf_f.getNumElements());
     memset(h_k.data, 0, sizeof(Scalar3)*m_k.getNumElements());
+    memset(h_kinf_f.data, 0, sizeof(Scalar3)*m_kinf_f.getNumElements());
+    memset(h_virial_mesh.data, 0, sizeof(Scalar)*m_virial_mesh.getNumElements());
 
     const BoxDim& global_box = m_pdata->getGlobalBox();
 
@@ -558,9 +936,9 @@ void PPPMForceCompute::computeInfluenceFunction()
     Scalar3 b2 = Scalar(2.0*M_PI)*make_scalar3(a3.y*a1.z-a3.z*a1.y, a3.z*a1.x-a3.x*a1.z, a3.x*a1.y-a3.y*a1.x)/V_box;
     Scalar3 b3 = Scalar(2.0*M_PI)*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x)/V_box;
 
-    #ifdef ENABLE_MPI
     bool local_fft = m_kiss_fft_initialized;
 
+    #ifdef ENABLE_MPI
     uint3 pdim=make_uint3(0,0,0);
     uint3 pidx=make_uint3(0,0,0);
     if (m_pdata->getDomainDecomposition())
@@ -589,7 +967,12 @@ void PPPMForceCompute::computeInfluenceFunction()
                    pow(-log(EPS_HOC),0.25)));
     int nbz = (int)temp;
 
-    for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+    int3 nb = make_int3(nbx, nby, nbz);
+
+    // number of stored wave vectors along x
+    unsigned int nx = local_fft ? m_mesh_points.x/2+1 : m_mesh_points.x;
+
+    for (unsigned int cell_idx = 0; cell_idx < m_n_fourier_cells; ++cell_idx)
         {
         uint3 wave_idx;
         #ifdef ENABLE_MPI
@@ -597,7 +980,6 @@ void PPPMForceCompute::computeInfluenceFunction()
            {
            // local layout: row major
            int ny = m_mesh_points.y;
-           int nx = m_mesh_points.x;
            int n_local = cell_idx/ny/nx;
            int m_local = (cell_idx-n_local*ny*nx)/nx;
            int l_local = cell_idx % nx;
@@ -609,251 +991,240 @@ void PPPMForceCompute::computeInfluenceFunction()
         else
         #endif
             {
-            // kiss FFT expects data in row major format
-            wave_idx.z = cell_idx / (m_mesh_points.y * m_mesh_points.x);
-            wave_idx.y = (cell_idx - wave_idx.z * m_mesh_points.x * m_mesh_points.y)/ m_mesh_points.x;
-            wave_idx.x = cell_idx % m_mesh_points.x;
+            // row major format of the (half) mesh
+            wave_idx.z = cell_idx / (m_mesh_points.y * nx);
+            wave_idx.y = (cell_idx - wave_idx.z * nx * m_mesh_points.y)/ nx;
+            wave_idx.x = cell_idx % nx;
             }
 
-        int3 n = make_int3(wave_idx.x,wave_idx.y,wave_idx.z);
-
-        // compute Miller indices
-        if (n.x >= (int)(m_global_dim.x/2 + m_global_dim.x%2))
-            n.x -= (int) m_global_dim.x;
-        if (n.y >= (int)(m_global_dim.y/2 + m_global_dim.y%2))
-            n.y -= (int) m_global_dim.y;
-        if (n.z >= (int)(m_global_dim.z/2 + m_global_dim.z%2))
-            n.z -= (int) m_global_dim.z;
-
-        Scalar3 k = (Scalar)n.x*b1+(Scalar)n.y*b2+(Scalar)n.z*b3;
-
-        Scalar snx = fast::sin(0.5*kH.x*(Scalar)n.x);
-        Scalar sny = fast::sin(0.5*kH.y*(Scalar)n.y);
-        Scalar snz = fast::sin(0.5*kH.z*(Scalar)n.z);
+        Scalar inf_f;
+        Scalar3 k;
+        computeModeInfluence(wave_idx, nb, b1, b2, b3, kH, inf_f, k);
 
-        if (n.x != 0 || n.y != 0 || n.z != 0)
-            {
-            Scalar sum1(0.0);
-            Scalar numerator = Scalar(4.0*M_PI)/dot(k,k);
-
-            Scalar denominator = gf_denom(snx*snx, sny*sny, snz*snz);
-
-            for (int ix = -nbx; ix <= nbx; ix++)
-                {
-                Scalar qx = ((Scalar)n.x + (Scalar)ix*m_global_dim.x);
-                Scalar3 knx = qx*b1;
-
-                Scalar argx = Scalar(0.5)*qx*kH.x;
-                Scalar wxs = sinc(argx);
-                Scalar wx(1.0);
-                for (int iorder = 0; iorder < m_order; ++iorder)
-                    {
-                    wx *= wxs;
-                    }
-
-                for (int iy = -nby; iy <= nby; iy++)
-                    {
-                    Scalar qy = ((Scalar)n.y + (Scalar)iy*m_global_dim.y);
-                    Scalar3 kny = qy*b2;
-
-                    Scalar argy = Scalar(0.5)*qy*kH.y;
-                    Scalar wys = sinc(argy);
-                    Scalar wy(1.0);
-                    for (int iorder = 0; iorder < m_order; ++iorder)
-                        {
-                        wy *= wys;
-                        }
-
-                    for (int iz = -nbz; iz <= nbz; iz++)
-                        {
-                        Scalar qz = ((Scalar)n.z + (Scalar)iz*m_global_dim.z);
-                        Scalar3 knz = qz*b3;
-
-                        Scalar argz = Scalar(0.5)*qz*kH.z;
-                        Scalar wzs = sinc(argz);
-                        Scalar wz(1.0);
-                        for (int iorder = 0; iorder < m_order; ++iorder)
-                            {
-                            wz *= wzs;
-                            }
-
-                        Scalar3 kn = knx + kny + knz;
-                        Scalar dot1 = dot(kn, k);
-                        Scalar dot2 = dot(kn, kn);
+        Scalar virial[6];
+        for (unsigned int i = 0; i < 6; ++i)
+            virial[i] = Scalar(0.0);
+        add_mode_virial(inf_f, k, m_kappa, virial);
 
-                        Scalar arg_gauss = Scalar(0.25)*dot2/m_kappa/m_kappa;
-                        Scalar gauss = exp(-arg_gauss);
+        Scalar3 kinf_f = k*inf_f;
 
-                        sum1 += (dot1/dot2) * gauss * wx * wx * wy * wy * wz * wz;
-                        }
-                    }
-                }
-            h_inf_f.data[cell_idx] = numerator*sum1/denominator;
-            }
-        else // q=0
+        // fold in the mirror image of modes that are not stored
+        if (local_fft && wave_idx.x != 0 && 2*wave_idx.x != m_mesh_points.x)
             {
-            h_inf_f.data[cell_idx] = Scalar(0.0);
+            uint3 mirror_idx = make_uint3(m_mesh_points.x - wave_idx.x,
+                                          (m_mesh_points.y - wave_idx.y) % m_mesh_points.y,
+                                          (m_mesh_points.z - wave_idx.z) % m_mesh_points.z);
+            Scalar mirror_inf_f;
+            Scalar3 mirror_k;
+            computeModeInfluence(mirror_idx, nb, b1, b2, b3, kH, mirror_inf_f, mirror_k);
+
+            add_mode_virial(mirror_inf_f, mirror_k, m_kappa, virial);
+            kinf_f = Scalar(0.5)*(kinf_f - mirror_k*mirror_inf_f);
+            inf_f += mirror_inf_f;
             }
 
+        h_inf_f.data[cell_idx] = inf_f;
         h_k.data[cell_idx] = k;
+        h_kinf_f.data[cell_idx] = kinf_f;
+        for (unsigned int i = 0; i < 6; ++i)
+            h_virial_mesh.data[i*m_n_fourier_cells + cell_idx] = virial[i];
         }
 
     if (m_prof) m_prof->pop();
     }
 
 //! Assignment of particles to mesh using variable order interpolation scheme
+/*! With several OpenMP threads, every thread assigns its particles to its own copy of the mesh, and the copies are
+    summed in thread order.
+*/
 void PPPMForceCompute::assignParticles()
     {
     if (m_prof) m_prof->push("assign");
 
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff,access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
 
-    // set mesh to zero
-    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx)*m_mesh.getNumElements());
-
     Scalar V_cell = box.getVolume()/(Scalar)(m_mesh_points.x*m_mesh_points.y*m_mesh_points.z);
 
-    // loop over group
     unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
-
-        Scalar4 postype = h_postype.data[idx];
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    ArrayHandle<unsigned int> h_group_members(m_group->getIndexArray(), access_location::host, access_mode::read);
 
-        // ignore if NaN
-        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
-            {
-            continue;
-            }
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
 
-        Scalar qi = h_charge.data[idx];
+    bool use_thread_meshes = n_threads > 1;
+    if (use_thread_meshes && m_thread_mesh.size() < n_threads*m_n_cells)
+        m_thread_mesh.resize(n_threads*m_n_cells);
 
-        // compute coordinates in units of the mesh size
-        Scalar3 f = box.makeFraction(pos);
-        Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
-                                           f.y * (Scalar) m_mesh_points.y,
-                                           f.z * (Scalar) m_mesh_points.z);
+    #pragma omp parallel if (n_threads > 1)
+        {
+        unsigned int thread_idx = 0;
+        #ifdef ENABLE_OPENMP
+        thread_idx = omp_get_thread_num();
+        #endif
 
-        reduced_pos.x += (Scalar) m_n_ghost_cells.x;
-        reduced_pos.y += (Scalar) m_n_ghost_cells.y;
-        reduced_pos.z += (Scalar) m_n_ghost_cells.z;
+        Scalar *mesh = use_thread_meshes ? &m_thread_mesh[thread_idx*m_n_cells] : h_mesh.data;
 
-        Scalar shift, shiftone;
+        // set mesh to zero
+        memset(mesh, 0, sizeof(Scalar)*m_n_cells);
 
-        if (m_order % 2)
+        // loop over group
+        #pragma omp for schedule(static)
+        for (int group_idx = 0; group_idx < (int)group_size; group_idx++)
             {
-            shift =0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
+            unsigned int idx = h_group_members.data[group_idx];
 
-        // find cell of the mesh the particle is in
-        int ix = (reduced_pos.x + shift);
-        int iy = (reduced_pos.y + shift);
-        int iz = (reduced_pos.z + shift);
+            Scalar4 postype = h_postype.data[idx];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
-        // handle particles on the boundary
-        if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
-            ix = 0;
-        if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
-            iy = 0;
-        if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
-            iz = 0;
+            // ignore if NaN
+            if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+                {
+                continue;
+                }
 
-        if (ix < 0 || ix >= (int)m_grid_dim.x ||
-            iy < 0 || iy >= (int)m_grid_dim.y ||
-            iz < 0 || iz >= (int)m_grid_dim.z)
-            {
-            // ignore, error will be thrown elsewhere (in CellList)
-            continue;
-            }
+            Scalar qi = h_charge.data[idx];
 
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
+            // compute coordinates in units of the mesh size
+            Scalar3 f = box.makeFraction(pos);
+            Scalar3 reduced_pos = make_scalar3(f.x * (Scalar) m_mesh_points.x,
+                                               f.y * (Scalar) m_mesh_points.y,
+                                               f.z * (Scalar) m_mesh_points.z);
 
-        int mult_fact = 2*m_order+1;
-        Scalar Wx, Wy, Wz;
+            reduced_pos.x += (Scalar) m_n_ghost_cells.x;
+            reduced_pos.y += (Scalar) m_n_ghost_cells.y;
+            reduced_pos.z += (Scalar) m_n_ghost_cells.z;
 
-        int nlower = -(m_order-1)/2;
-        int nupper = m_order/2;
+            Scalar shift, shiftone;
 
-        for (int i = nlower; i <= nupper ; ++i)
-            {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order-1; iorder >= 0; iorder--)
+            if (m_order % 2)
                 {
-                Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
+                shift =0.5;
+                shiftone = 0.0;
+                }
+            else
+                {
+                shift = 0.0;
+                shiftone = 0.5;
                 }
 
-            int neighi = (int)ix + i;
-
-            if (! m_n_ghost_cells.x)
+            // find cell of the mesh the particle is in
+            int ix = (reduced_pos.x + shift);
+            int iy = (reduced_pos.y + shift);
+            int iz = (reduced_pos.z + shift);
+
+            // set distance to cell center
+            Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
+            Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
+            Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
+
+            // handle particles on the boundary
+            if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
+                ix = 0;
+            if (iy == (int) m_grid_dim.y && !m_n_ghost_cells.y)
+                iy = 0;
+            if (iz == (int) m_grid_dim.z && !m_n_ghost_cells.z)
+                iz = 0;
+
+            if (ix < 0 || ix >= (int)m_grid_dim.x ||
+                iy < 0 || iy >= (int)m_grid_dim.y ||
+                iz < 0 || iz >= (int)m_grid_dim.z)
                 {
-                if (neighi >= (int)m_grid_dim.x)
-                    neighi -= m_grid_dim.x;
-                else if (neighi < 0)
-                    neighi += m_grid_dim.x;
+                // ignore, error will be thrown elsewhere (in CellList)
+                continue;
                 }
 
+            int mult_fact = 2*m_order+1;
+            Scalar Wx, Wy, Wz;
 
-            for (int j = nlower; j <= nupper; ++j)
+            int nlower = -(m_order-1)/2;
+            int nupper = m_order/2;
+
+            for (int i = nlower; i <= nupper ; ++i)
                 {
-                Wy = Scalar(0.0);
+                Wx = Scalar(0.0);
                 for (int iorder = m_order-1; iorder >= 0; iorder--)
                     {
-                    Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
+                    Wx = h_rho_coeff.data[i - nlower + iorder*mult_fact] + Wx * dx;
                     }
 
-                int neighj = (int)iy + j;
+                int neighi = (int)ix + i;
 
-                if (! m_n_ghost_cells.y)
+                if (! m_n_ghost_cells.x)
                     {
-                    if (neighj >= (int)m_grid_dim.y)
-                        neighj -= m_grid_dim.y;
-                    else if (neighj < 0)
-                        neighj += m_grid_dim.y;
+                    if (neighi >= (int)m_grid_dim.x)
+                        neighi -= m_grid_dim.x;
+                    else if (neighi < 0)
+                        neighi += m_grid_dim.x;
                     }
 
-                for (int k = nlower; k <= nupper; ++k)
+
+                for (int j = nlower; j <= nupper; ++j)
                     {
-                    Wz = Scalar(0.0);
+                    Wy = Scalar(0.0);
                     for (int iorder = m_order-1; iorder >= 0; iorder--)
                         {
-                        Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
+                        Wy = h_rho_coeff.data[j - nlower + iorder*mult_fact] + Wy * dy;
                         }
 
-                    int neighk = (int)iz + k;
-                    if (! m_n_ghost_cells.z)
+                    int neighj = (int)iy + j;
+
+                    if (! m_n_ghost_cells.y)
                         {
-                        if (neighk >= (int)m_grid_dim.z)
-                            neighk -= m_grid_dim.z;
-                        else if (neighk < 0)
-                            neighk += m_grid_dim.z;
+                        if (neighj >= (int)m_grid_dim.y)
+                            neighj -= m_grid_dim.y;
+                        else if (neighj < 0)
+                            neighj += m_grid_dim.y;
                         }
 
-                    Scalar W = Wx*Wy*Wz;
+                    for (int k = nlower; k <= nupper; ++k)
+                        {
+                        Wz = Scalar(0.0);
+                        for (int iorder = m_order-1; iorder >= 0; iorder--)
+                            {
+                            Wz = h_rho_coeff.data[k - nlower + iorder*mult_fact] + Wz * dz;
+                            }
 
-                    // store in row major order
-                    unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
+                        int neighk = (int)iz + k;
+                        if (! m_n_ghost_cells.z)
+                            {
+                            if (neighk >= (int)m_grid_dim.z)
+                                neighk -= m_grid_dim.z;
+                            else if (neighk < 0)
+                                neighk += m_grid_dim.z;
+                            }
+
+                        Scalar W = Wx*Wy*Wz;
+
+                        // store in row major order
+                        unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    h_mesh.data[neigh_idx].r += qi*W/V_cell;
+                        mesh[neigh_idx] += qi*W/V_cell;
+                        }
                     }
                 }
+            } // end loop over particles
+        }
+
+    if (use_thread_meshes)
+        {
+        // sum the per-thread meshes
+        #pragma omp parallel for schedule(static)
+        for (int cell_idx = 0; cell_idx < (int)m_n_cells; cell_idx++)
+            {
+            Scalar rho(0.0);
+            for (unsigned int t = 0; t < n_threads; t++)
+                rho += m_thread_mesh[t*m_n_cells + cell_idx];
+            h_mesh.data[cell_idx] = rho;
             }
-        } // end loop over particles
+        }
 
     if (m_prof) m_prof->pop();
     }
@@ -864,10 +1235,7 @@ void PPPMForceCompute::updateMeshes()
         {
         if (m_prof) m_prof->push("FFT");
         // transform the particle mesh locally (forward transform)
-        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
-
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        forwardFFTR2C();
         if (m_prof) m_prof->pop();
         }
 
@@ -884,10 +1252,24 @@ void PPPMForceCompute::updateMeshes()
         m_exec_conf->msg->notice(8) << "charge.pppm: Distributed FFT mesh" << std::endl;
 
         if (m_prof) m_prof->push("FFT");
-        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_mesh(m_mesh, access_location::host, access_mode::read);
+        ArrayHandle<kiss_fft_cpx> h_dfft_buf(m_dfft_buf, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
 
-        dfft_execute((cpx_t *)(h_mesh.data+m_ghost_offset), (cpx_t *)h_fourier_mesh.data, 0,m_dfft_plan_forward);
+        // copy the inner cells into the complex input
+        for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+            {
+            unsigned int x = cell_idx % m_mesh_points.x;
+            unsigned int y = (cell_idx / m_mesh_points.x) % m_mesh_points.y;
+            unsigned int z = cell_idx / (m_mesh_points.x*m_mesh_points.y);
+            unsigned int ghost_idx = x + m_n_ghost_cells.x
+                + m_grid_dim.x*(y + m_n_ghost_cells.y + m_grid_dim.y*(z + m_n_ghost_cells.z));
+
+            h_dfft_buf.data[cell_idx].r = h_mesh.data[ghost_idx];
+            h_dfft_buf.data[cell_idx].i = Scalar(0.0);
+            }
+
+        dfft_execute((cpx_t *)h_dfft_buf.data, (cpx_t *)h_fourier_mesh.data, 0,m_dfft_plan_forward);
         if (m_prof) m_prof->pop();
         }
     #endif
@@ -895,32 +1277,31 @@ void PPPMForceCompute::updateMeshes()
     if (m_prof) m_prof->push("update");
 
         {
-        ArrayHandle<Scalar3> h_k(m_k, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_kinf_f(m_kinf_f, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::overwrite);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::read);
 
         unsigned int NNN = m_global_dim.x*m_global_dim.y*m_global_dim.z;
+        Scalar scale = Scalar(1.0)/((Scalar)NNN);
 
         // multiply with influence function and I*k
-        for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+        #pragma omp parallel for schedule(static)
+        for (int k = 0; k < (int)m_n_fourier_cells; ++k)
             {
             kiss_fft_cpx f = h_fourier_mesh.data[k];
 
-            Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
+            Scalar3 kinf_f = h_kinf_f.data[k]*scale;
 
-            Scalar3 kvec = h_k.data[k];
+            h_fourier_mesh_G_x.data[k].r = f.i * kinf_f.x;
+            h_fourier_mesh_G_x.data[k].i = -f.r * kinf_f.x;
 
-            h_fourier_mesh_G_x.data[k].r = f.i * kvec.x * scaled_inf_f;
-            h_fourier_mesh_G_x.data[k].i = -f.r * kvec.x * scaled_inf_f;
+            h_fourier_mesh_G_y.data[k].r = f.i * kinf_f.y;
+            h_fourier_mesh_G_y.data[k].i = -f.r * kinf_f.y;
 
-            h_fourier_mesh_G_y.data[k].r = f.i * kvec.y * scaled_inf_f;
-            h_fourier_mesh_G_y.data[k].i = -f.r * kvec.y * scaled_inf_f;
-
-            h_fourier_mesh_G_z.data[k].r = f.i * kvec.z * scaled_inf_f;
-            h_fourier_mesh_G_z.data[k].i = -f.r * kvec.z * scaled_inf_f;
+            h_fourier_mesh_G_z.data[k].r = f.i * kinf_f.z;
+            h_fourier_mesh_G_z.data[k].i = -f.r * kinf_f.z;
             }
         }
 
@@ -929,16 +1310,8 @@ void PPPMForceCompute::updateMeshes()
     if (m_kiss_fft_initialized)
         {
         if (m_prof) m_prof->push("FFT");
-        // do a local inverse transform of the force mesh
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        // do a local inverse transform of the three components of the force mesh
+        inverseFFTC2R();
         if (m_prof) m_prof->pop();
         }
 
@@ -952,19 +1325,34 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y, access_location::host, access_mode::read);
         ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::overwrite);
+        ArrayHandle<kiss_fft_cpx> h_dfft_buf(m_dfft_buf, access_location::host, access_mode::overwrite);
+
+        kiss_fft_cpx *G[3] = {h_fourier_mesh_G_x.data, h_fourier_mesh_G_y.data, h_fourier_mesh_G_z.data};
+        Scalar *E[3] = {h_inv_fourier_mesh_x.data, h_inv_fourier_mesh_y.data, h_inv_fourier_mesh_z.data};
+
+        for (unsigned int comp = 0; comp < 3; ++comp)
+            {
+            dfft_execute((cpx_t *)G[comp], (cpx_t *)h_dfft_buf.data, 1,m_dfft_plan_inverse);
 
-        dfft_execute((cpx_t *)h_fourier_mesh_G_x.data, (cpx_t *)(h_inv_fourier_mesh_x.data+m_ghost_offset), 1,m_dfft_plan_inverse);
-        dfft_execute((cpx_t *)h_fourier_mesh_G_y.data, (cpx_t *)(h_inv_fourier_mesh_y.data+m_ghost_offset), 1,m_dfft_plan_inverse);
-        dfft_execute((cpx_t *)h_fourier_mesh_G_z.data, (cpx_t *)(h_inv_fourier_mesh_z.data+m_ghost_offset), 1,m_dfft_plan_inverse);
+            // the force mesh is real, copy it back to the inner cells
+            for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+                {
+                unsigned int x = cell_idx % m_mesh_points.x;
+                unsigned int y = (cell_idx / m_mesh_points.x) % m_mesh_points.y;
+                unsigned int z = cell_idx / (m_mesh_points.x*m_mesh_points.y);
+                unsigned int ghost_idx = x + m_n_ghost_cells.x
+                    + m_grid_dim.x*(y + m_n_ghost_cells.y + m_grid_dim.y*(z + m_n_ghost_cells.z));
+
+                E[comp][ghost_idx] = h_dfft_buf.data[cell_idx].r;
+                }
+            }
         if (m_prof) m_prof->pop();
         }
     #endif
 
-    // potential optimization: combine vector components into Scalar3
-
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -988,9 +1376,9 @@ void PPPMForceCompute::interpolateForces()
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // access inverse Fourier tranform mesh
-    ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::read);
-    ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::read);
-    ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_inv_fourier_mesh_y(m_inv_fourier_mesh_y, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z, access_location::host, access_mode::read);
 
     // access force array
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
@@ -999,11 +1387,14 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
     unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    ArrayHandle<unsigned int> h_group_members(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+    // loop over group
+    #pragma omp parallel for schedule(static)
+    for (int group_idx = 0; group_idx < (int)group_size; group_idx++)
         {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+        unsigned int idx = h_group_members.data[group_idx];
         Scalar4 postype = h_postype.data[idx];
 
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -1044,6 +1435,11 @@ void PPPMForceCompute::interpolateForces()
         int iy = (reduced_pos.y + shift);
         int iz = (reduced_pos.z + shift);
 
+        // set distance to cell center
+        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
+        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
+        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
+
         // handle particles on the boundary
         if (ix == (int) m_grid_dim.x && !m_n_ghost_cells.x)
             ix = 0;
@@ -1062,10 +1458,6 @@ void PPPMForceCompute::interpolateForces()
 
         Scalar3 force = make_scalar3(0.0,0.0,0.0);
 
-        Scalar dx = shiftone+(Scalar)ix-reduced_pos.x;
-        Scalar dy = shiftone+(Scalar)iy-reduced_pos.y;
-        Scalar dz = shiftone+(Scalar)iz-reduced_pos.z;
-
         int mult_fact = 2*m_order+1;
         Scalar Wx, Wy, Wz;
 
@@ -1129,14 +1521,14 @@ void PPPMForceCompute::interpolateForces()
 
                     unsigned int neigh_idx = neighi + m_grid_dim.x * (neighj + m_grid_dim.y*neighk);
 
-                    kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
-                    kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
-                    kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
+                    Scalar E_x = h_inv_fourier_mesh_x.data[neigh_idx];
+                    Scalar E_y = h_inv_fourier_mesh_y.data[neigh_idx];
+                    Scalar E_z = h_inv_fourier_mesh_z.data[neigh_idx];
 
                     Scalar W = Wx * Wy * Wz;
-                    force.x += qi*W*E_x.r;
-                    force.y += qi*W*E_y.r;
-                    force.z += qi*W*E_z.r;
+                    force.x += qi*W*E_x;
+                    force.y += qi*W*E_y;
+                    force.z += qi*W*E_z;
                     }
                 }
             }
@@ -1156,27 +1548,12 @@ Scalar PPPMForceCompute::computePE()
 
     Scalar sum(0.0);
 
-    bool exclude_dc = true;
-    #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        uint3 my_pos = m_pdata->getDomainDecomposition()->getGridPos();
-        exclude_dc = !my_pos.x && !my_pos.y && !my_pos.z;
-        }
-    #endif
-
-    for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+    // the influence function vanishes for the DC bin
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+    for (int k = 0; k < (int)m_n_fourier_cells; ++k)
         {
-        bool exclude = false;
-        if (exclude_dc)
-            // exclude DC bin
-            exclude = (k == 0);
-
-        if (! exclude)
-            {
-            sum += (h_fourier_mesh.data[k].r * h_fourier_mesh.data[k].r
-                + h_fourier_mesh.data[k].i * h_fourier_mesh.data[k].i)*h_inf_f.data[k];
-            }
+        sum += (h_fourier_mesh.data[k].r * h_fourier_mesh.data[k].r
+            + h_fourier_mesh.data[k].i * h_fourier_mesh.data[k].i)*h_inf_f.data[k];
         }
 
     if (m_prof) m_prof->pop();
@@ -1291,51 +1668,29 @@ void PPPMForceCompute::computeVirial()
     {
     if (m_prof) m_prof->push("virial");
 
-    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::overwrite);
-
-    ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::read);
-    ArrayHandle<Scalar3> h_k(m_k, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_mesh(m_virial_mesh, access_location::host, access_mode::read);
 
+    const unsigned int n = m_n_fourier_cells;
 
-    Scalar virial[6];
-    for (unsigned int i = 0; i < 6; ++i)
-        virial[i] = Scalar(0.0);
+    // the virial coefficients vanish for the DC bin
+    Scalar virial_xx(0.0), virial_xy(0.0), virial_xz(0.0), virial_yy(0.0), virial_yz(0.0), virial_zz(0.0);
 
-    bool exclude_dc = true;
-    #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
+    #pragma omp parallel for schedule(static) reduction(+:virial_xx,virial_xy,virial_xz,virial_yy,virial_yz,virial_zz)
+    for (int kidx = 0; kidx < (int)n; ++kidx)
         {
-        uint3 my_pos = m_pdata->getDomainDecomposition()->getGridPos();
-        exclude_dc = !my_pos.x && !my_pos.y && !my_pos.z;
+        kiss_fft_cpx fourier = h_fourier_mesh.data[kidx];
+        Scalar rhosq = fourier.r * fourier.r + fourier.i * fourier.i;
+
+        virial_xx += rhosq*h_virial_mesh.data[0*n + kidx];
+        virial_xy += rhosq*h_virial_mesh.data[1*n + kidx];
+        virial_xz += rhosq*h_virial_mesh.data[2*n + kidx];
+        virial_yy += rhosq*h_virial_mesh.data[3*n + kidx];
+        virial_yz += rhosq*h_virial_mesh.data[4*n + kidx];
+        virial_zz += rhosq*h_virial_mesh.data[5*n + kidx];
         }
-    #endif
-
-    for (unsigned int kidx = 0; kidx < m_n_inner_cells; ++kidx)
-        {
-        bool exclude = false;
-        if (exclude_dc)
-            // exclude DC bin
-            exclude = (kidx == 0);
-
-        if (! exclude)
-            {
-            // non-zero wave vector
-            kiss_fft_cpx fourier = h_fourier_mesh.data[kidx];
 
-            Scalar3 k = h_k.data[kidx];
-            Scalar ksq = dot(k,k);
-
-            Scalar rhog = (fourier.r * fourier.r + fourier.i * fourier.i)*h_inf_f.data[kidx];
-
-            Scalar vterm = -Scalar(2.0)*(Scalar(1.0)/ksq + Scalar(0.25)/(m_kappa*m_kappa));
-            virial[0] += rhog*(Scalar(1.0) + vterm*k.x*k.x); // xx
-            virial[1] += rhog*(              vterm*k.x*k.y); // xy
-            virial[2] += rhog*(              vterm*k.x*k.z); // xz
-            virial[3] += rhog*(Scalar(1.0) + vterm*k.y*k.y); // yy
-            virial[4] += rhog*(              vterm*k.y*k.z); // yz
-            virial[5] += rhog*(Scalar(1.0) + vterm*k.z*k.z); // zz
-            }
-        }
+    Scalar virial[6] = {virial_xx, virial_xy, virial_xz, virial_yy, virial_yz, virial_zz};
 
     Scalar V = m_pdata->getGlobalBox().getVolume();
     Scalar scale = Scalar(1.0)/((Scalar)(m_global_dim.x*m_global_dim.y*m_global_dim.z));
@@ -1348,7 +1703,6 @@ void PPPMForceCompute::computeVirial()
 
     if (m_prof) m_prof->pop();
     }
-
 void PPPMForceCompute::fixExclusions()
     {
     unsigned int group_size = m_group->getNumMembers();
@@ -13,9 +13,10 @@
 #include "hoomd/extern/dfftlib/src/dfft_host.h"
 #endif
 
-#include "hoomd/extern/kiss_fftnd.h"
+#include "hoomd/extern/kiss_fft.h"
 
 #include <memory>
+#include <vector>
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 
 const Scalar EPS_HOC(1.0e-7);
@@ -23,6 +24,21 @@ const Scalar EPS_HOC(1.0e-7);
 const unsigned int PPPM_MAX_ORDER = 7;
 
 /*! Compute the long-ranged part of the particle-particle particle-mesh Ewald sum (PPPM)
+
+    <b>CPU implementation:</b>
+
+    The charge density and the electric field on the mesh are real. Without domain decomposition, the mesh is
+    transformed with a real-to-complex FFT built from one-dimensional KISS FFTs: pairs of real mesh rows along x are
+    packed into one complex transform, and only the m_mesh_points.x/2+1 non-redundant wave vectors along x are kept.
+    The inverse transforms of the three field components share the y and z passes and are turned back into real rows
+    by the same packing. Every mode stored on the half mesh stands for itself and its mirror image -k, so
+    computeInfluenceFunction() folds the contributions of both into m_inf_f, m_kinf_f and m_virial_mesh, and the
+    results are identical to those of the full complex transform.
+
+    With domain decomposition, the distributed FFT is complex-to-complex, but the charge and field meshes and their
+    ghost cell exchange are real valued. The transform goes through a shared complex buffer of the inner cells.
+
+    Charge assignment, force interpolation and the FFT passes are split among the OpenMP threads.
  */
 class PPPMForceCompute : public ForceCompute
     {
@@ -84,6 +100,7 @@ class PPPMForceCompute : public ForceCompute
         unsigned int m_n_cells;             //!< Total number of inner cells
         unsigned int m_radius;              //!< Stencil radius (in units of mesh size)
         unsigned int m_n_inner_cells;       //!< Number of inner mesh points (without ghost cells)
+        unsigned int m_n_fourier_cells;     //!< Number of stored wave vectors (m_n_inner_cells unless real-to-complex)
         GPUArray<Scalar> m_inf_f;           //!< Fourier representation of the influence function (real part)
         GPUArray<Scalar3> m_k;              //!< Mesh of k values
         Scalar m_qstarsq;                   //!< Short wave length cut-off squared for density harmonics
@@ -140,26 +157,34 @@ class PPPMForceCompute : public ForceCompute
         virtual void setupCoeffs();
 
     private:
-        kiss_fftnd_cfg m_kiss_fft;         //!< The FFT configuration
-        kiss_fftnd_cfg m_kiss_ifft;        //!< Inverse FFT configuration
+        kiss_fft_cfg m_kiss_fft_x;         //!< Forward FFT along x
+        kiss_fft_cfg m_kiss_fft_y;         //!< Forward FFT along y
+        kiss_fft_cfg m_kiss_fft_z;         //!< Forward FFT along z
+        kiss_fft_cfg m_kiss_ifft_x;        //!< Inverse FFT along x
+        kiss_fft_cfg m_kiss_ifft_y;        //!< Inverse FFT along y
+        kiss_fft_cfg m_kiss_ifft_z;        //!< Inverse FFT along z
 
         #ifdef ENABLE_MPI
         dfft_plan m_dfft_plan_forward;     //!< Distributed FFT for forward transform
         dfft_plan m_dfft_plan_inverse;     //!< Distributed FFT for inverse transform
-        std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> > m_grid_comm_forward; //!< Communicator for charge mesh
-        std::unique_ptr<CommunicatorGrid<kiss_fft_cpx> > m_grid_comm_reverse; //!< Communicator for inv fourier mesh
+        std::unique_ptr<CommunicatorGrid<Scalar> > m_grid_comm_forward; //!< Communicator for charge mesh
+        std::unique_ptr<CommunicatorGrid<Scalar> > m_grid_comm_reverse; //!< Communicator for inv fourier mesh
+        GPUArray<kiss_fft_cpx> m_dfft_buf;         //!< Complex inner cells handed to the distributed FFT
         #endif
 
         bool m_kiss_fft_initialized;               //!< True if a local KISS FFT has been set up
 
-        GPUArray<kiss_fft_cpx> m_mesh;             //!< The particle density mesh
+        GPUArray<Scalar> m_mesh;                   //!< The particle density mesh
         GPUArray<kiss_fft_cpx> m_fourier_mesh;     //!< The fourier transformed mesh
         GPUArray<kiss_fft_cpx> m_fourier_mesh_G_x;   //!< Fourier transformed mesh times the influence function, x-component
         GPUArray<kiss_fft_cpx> m_fourier_mesh_G_y;   //!< Fourier transformed mesh times the influence function, y-component
         GPUArray<kiss_fft_cpx> m_fourier_mesh_G_z;   //!< Fourier transformed mesh times the influence function, z-component
-        GPUArray<kiss_fft_cpx> m_inv_fourier_mesh_x;   //!< Fourier transformed mesh times the influence function, x-component
-        GPUArray<kiss_fft_cpx> m_inv_fourier_mesh_y;   //!< Fourier transformed mesh times the influence function, y-component
-        GPUArray<kiss_fft_cpx> m_inv_fourier_mesh_z;   //!< Fourier transformed mesh times the influence function, z-component
+        GPUArray<Scalar> m_inv_fourier_mesh_x;     //!< Inverse transformed force mesh, x-component
+        GPUArray<Scalar> m_inv_fourier_mesh_y;     //!< Inverse transformed force mesh, y-component
+        GPUArray<Scalar> m_inv_fourier_mesh_z;     //!< Inverse transformed force mesh, z-component
+        GPUArray<Scalar3> m_kinf_f;                //!< Wave vector times the influence function
+
+        std::vector<Scalar> m_thread_mesh;         //!< Per-thread charge meshes for the threaded assignment
 
         std::vector<std::string> m_log_names;           //!< Name of the log quantity
 
@@ -168,6 +193,19 @@ class PPPMForceCompute : public ForceCompute
         //! Compute virial on mesh
         void computeVirialMesh();
 
+        //! Free the FFT plans
+        void destroyFFT();
+
+        //! Real-to-complex forward FFT of the charge mesh (local mesh only)
+        void forwardFFTR2C();
+
+        //! Complex-to-real inverse FFT of the three force meshes (local mesh only)
+        void inverseFFTC2R();
+
+        //! Compute the influence function and wave vector of one mode
+        void computeModeInfluence(uint3 wave_idx, int3 nb, Scalar3 b1, Scalar3 b2, Scalar3 b3, Scalar3 kH,
+            Scalar& inf_f, Scalar3& k);
+
         //! Compute number of ghost cellso
         uint3 computeGhostCellNum();
 
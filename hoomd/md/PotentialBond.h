@@ -7,6 +7,10 @@
 
 #include <vector>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 /*! \file PotentialBond.h
     \brief Declares PotentialBond
 */
@@ -60,6 +64,11 @@ class PotentialBond : public ForceCompute
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
+
+        //! Evaluate the force and energy of a single bond
+        inline bool evaluateBond(unsigned int idx_a, unsigned int idx_b, unsigned int type, const Scalar4 *h_pos,
+            const Scalar *h_diameter, const Scalar *h_charge, const param_type *h_params, const BoxDim& box,
+            Scalar3& dx, Scalar& force_divr, Scalar& bond_eng);
     };
 
 /*! \param sysdef System to compute forces on
@@ -137,8 +146,87 @@ Scalar PotentialBond< evaluator >::getLogValue(const std::string& quantity, unsi
         }
     }
 
+/*! \param idx_a Index of the first particle
+    \param idx_b Index of the second particle
+    \param type Bond type
+    \param h_pos Particle positions
+    \param h_diameter Particle diameters
+    \param h_charge Particle charges
+    \param h_params Bond parameters
+    \param box Box for the minimum image convention
+    \param dx Set to the minimum image vector from particle a to particle b
+    \param force_divr Set to the magnitude of the force divided by the distance
+    \param bond_eng Set to half of the bond energy
+    \returns The return value of the evaluator, false if the bond is out of bounds
+*/
+template< class evaluator >
+inline bool PotentialBond< evaluator >::evaluateBond(unsigned int idx_a,
+                                                     unsigned int idx_b,
+                                                     unsigned int type,
+                                                     const Scalar4 *h_pos,
+                                                     const Scalar *h_diameter,
+                                                     const Scalar *h_charge,
+                                                     const param_type *h_params,
+                                                     const BoxDim& box,
+                                                     Scalar3& dx,
+                                                     Scalar& force_divr,
+                                                     Scalar& bond_eng)
+    {
+    // calculate d\vec{r}
+    // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
+    Scalar3 posa = make_scalar3(h_pos[idx_a].x, h_pos[idx_a].y, h_pos[idx_a].z);
+    Scalar3 posb = make_scalar3(h_pos[idx_b].x, h_pos[idx_b].y, h_pos[idx_b].z);
+
+    dx = posb - posa;
+
+    // access diameter (if needed)
+    Scalar diameter_a = Scalar(0.0);
+    Scalar diameter_b = Scalar(0.0);
+    if (evaluator::needsDiameter())
+        {
+        diameter_a = h_diameter[idx_a];
+        diameter_b = h_diameter[idx_b];
+        }
+
+    // acesss charge (if needed)
+    Scalar charge_a = Scalar(0.0);
+    Scalar charge_b = Scalar(0.0);
+    if (evaluator::needsCharge())
+        {
+        charge_a = h_charge[idx_a];
+        charge_b = h_charge[idx_b];
+        }
+
+    // if the vector crosses the box, pull it back
+    dx = box.minImage(dx);
+
+    // calculate r_ab squared
+    Scalar rsq = dot(dx,dx);
+
+    // compute the force and potential energy
+    force_divr = Scalar(0.0);
+    bond_eng = Scalar(0.0);
+    evaluator eval(rsq, h_params[type]);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(diameter_a,diameter_b);
+    if (evaluator::needsCharge())
+        eval.setCharge(charge_a,charge_b);
+
+    bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
+
+    // Bond energy must be halved
+    bond_eng *= Scalar(0.5);
+
+    return evaluated;
+    }
+
 /*! Actually perform the force computation
     \param timestep Current time step
+
+    With more than one OpenMP thread, every local particle gathers the bonds it is part of from the per-particle
+    table of the BondData, which the GPU implementation also uses. Each bond is then evaluated once per member, but
+    the threads never write to the same particle. With a single thread, each bond is evaluated once and its forces are
+    added to both members.
  */
 template< class evaluator >
 void PotentialBond< evaluator >::computeForces(unsigned int timestep)
@@ -159,7 +247,6 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     // access the parameters
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -178,6 +265,82 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    if (n_threads > 1)
+        {
+        // the table is rebuilt on access if needed, and reports incomplete bonds
+        ArrayHandle<typename BondData::members_t> h_table(m_bond_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_table_pos(m_bond_data->getGPUPosTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_bonds(m_bond_data->getNGroupsArray(), access_location::host, access_mode::read);
+        const Index2D& table_indexer = m_bond_data->getGPUTableIndexer();
+
+        const unsigned int N = m_pdata->getN();
+        unsigned int n_out_of_bounds = 0;
+
+        #pragma omp parallel for schedule(static) reduction(+:n_out_of_bounds)
+        for (int idx = 0; idx < (int)N; idx++)
+            {
+            Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+            Scalar virial[6];
+            for (unsigned int i = 0; i < 6; i++)
+                virial[i] = Scalar(0.0);
+
+            for (unsigned int k = 0; k < h_n_bonds.data[idx]; k++)
+                {
+                const typename BondData::members_t& entry = h_table.data[table_indexer(idx, k)];
+                unsigned int cur_pos = h_table_pos.data[table_indexer(idx, k)];
+
+                unsigned int member_idx[2];
+                get_group_members<2>(entry, cur_pos, idx, member_idx);
+
+                Scalar3 dx;
+                Scalar force_divr, bond_eng;
+                if (!evaluateBond(member_idx[0], member_idx[1], entry.idx[1], h_pos.data, h_diameter.data,
+                    h_charge.data, h_params.data, box, dx, force_divr, bond_eng))
+                    {
+                    n_out_of_bounds++;
+                    continue;
+                    }
+
+                // the force on b is along dx, the force on a opposite to it
+                Scalar sign = (cur_pos == 0) ? Scalar(-1.0) : Scalar(1.0);
+                force.x += sign * force_divr * dx.x;
+                force.y += sign * force_divr * dx.y;
+                force.z += sign * force_divr * dx.z;
+                force.w += bond_eng;
+
+                if (compute_virial)
+                    {
+                    Scalar force_div2r = Scalar(1.0/2.0)*force_divr;
+                    virial[0] += dx.x * dx.x * force_div2r; // xx
+                    virial[1] += dx.x * dx.y * force_div2r; // xy
+                    virial[2] += dx.x * dx.z * force_div2r; // xz
+                    virial[3] += dx.y * dx.y * force_div2r; // yy
+                    virial[4] += dx.y * dx.z * force_div2r; // yz
+                    virial[5] += dx.z * dx.z * force_div2r; // zz
+                    }
+                }
+
+            h_force.data[idx] = force;
+            if (compute_virial)
+                for (unsigned int i = 0; i < 6; i++)
+                    h_virial.data[i*m_virial_pitch+idx] = virial[i];
+            }
+
+        if (n_out_of_bounds)
+            {
+            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
+            throw std::runtime_error("Error in bond calculation");
+            }
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     Scalar bond_virial[6];
     for (unsigned int i = 0; i< 6; i++)
         bond_virial[i]=Scalar(0.0);
@@ -209,53 +372,10 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             throw std::runtime_error("Error in bond calculation");
             }
 
-        // calculate d\vec{r}
-        // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
-
-        Scalar3 dx = posb - posa;
-
-        // access diameter (if needed)
-        Scalar diameter_a = Scalar(0.0);
-        Scalar diameter_b = Scalar(0.0);
-        if (evaluator::needsDiameter())
-            {
-            diameter_a = h_diameter.data[idx_a];
-            diameter_b = h_diameter.data[idx_b];
-            }
-
-        // acesss charge (if needed)
-        Scalar charge_a = Scalar(0.0);
-        Scalar charge_b = Scalar(0.0);
-        if (evaluator::needsCharge())
-            {
-            charge_a = h_charge.data[idx_a];
-            charge_b = h_charge.data[idx_b];
-            }
-
-        // if the vector crosses the box, pull it back
-        dx = box.minImage(dx);
-
-        // calculate r_ab squared
-        Scalar rsq = dot(dx,dx);
-
-        // get parameters for this bond type
-        param_type param = h_params.data[h_typeval.data[i].type];
-
-        // compute the force and potential energy
-        Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
-        evaluator eval(rsq, param);
-        if (evaluator::needsDiameter())
-            eval.setDiameter(diameter_a,diameter_b);
-        if (evaluator::needsCharge())
-            eval.setCharge(charge_a,charge_b);
-
-        bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
-
-        // Bond energy must be halved
-        bond_eng *= Scalar(0.5);
+        Scalar3 dx;
+        Scalar force_divr, bond_eng;
+        bool evaluated = evaluateBond(idx_a, idx_b, h_typeval.data[i].type, h_pos.data, h_diameter.data,
+            h_charge.data, h_params.data, box, dx, force_divr, bond_eng);
 
         if (evaluated)
             {
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <vector>
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 #include "hoomd/extern/num_util.h"
 
@@ -18,11 +19,16 @@
 #include "hoomd/GPUArray.h"
 #include "hoomd/ForceCompute.h"
 #include "NeighborList.h"
+#include "NeighborListCluster.h"
+#include "ClusterPairKernel.h"
 
 #ifdef ENABLE_MPI
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
 
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
@@ -77,6 +83,30 @@
     the evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independantly.
 
+    <b>Multithreading</b>
+
+    When HOOMD is compiled with ENABLE_OPENMP, the loop over particles in computeForces() is split among the OpenMP
+    threads. With a full neighbor list, every thread only writes to the particles it owns and no synchronization is
+    needed. With a half neighbor list, the third law contributions to neighbor j are accumulated in a per-thread
+    force and virial buffer (m_thread_force and m_thread_virial) which are summed into the force arrays in a final
+    reduction pass. The loop uses a static schedule and the buffers are reduced in thread order, so the result is
+    bitwise reproducible for a given number of threads.
+
+    <b>Overlap with ghost communication</b>
+
+    With setCommOverlap(), the pair potential subscribes to the Communicator's local compute signal. On time steps
+    without particle migration the neighbor list is not rebuilt, so the particles without any ghost neighbors can be
+    processed in computeInteriorForces() while the ghost positions are still in transit. computeForces() then only
+    processes the remaining boundary particles and adds their contributions on top. Each pair in a half neighbor list
+    is still evaluated exactly once. With a multiple time step stride (Integrator::setForceStride()), the interior pass
+    only runs on the outer steps on which the Integrator computes the force.
+
+    <b>Accumulate mode</b>
+
+    When the Integrator calls accumulate(), both kernels add to the net force and net virial arrays instead of m_force
+    and m_virial. The interior pass needs the per-compute arrays, so it is skipped while they are out of date and all
+    particles are processed in computeForces().
+
     \sa export_PotentialPair()
 */
 template < class evaluator >
@@ -119,9 +149,21 @@ class PotentialPair : public ForceCompute
             m_shift_mode = mode;
             }
 
+        //! Enable or disable the overlap of interior force computation with the ghost update
+        void setCommOverlap(bool overlap);
+
+        //! The CPU kernels can add the pair forces directly to the net force
+        virtual bool supportsAccumulate()
+            {
+            return true;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! Set the communicator to use
+        virtual void setCommunicator(std::shared_ptr<Communicator> comm);
         #endif
 
         //! Calculates the energy between two lists of particles.
@@ -143,9 +185,79 @@ class PotentialPair : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        std::vector<Scalar4> m_thread_force;        //!< Per-thread force buffers for third law contributions
+        std::vector<Scalar> m_thread_virial;        //!< Per-thread virial buffers for third law contributions
+
+        bool m_comm_overlap;                        //!< True if interior forces are computed during the ghost update
+        bool m_interior_valid;                      //!< True if the interior forces for m_interior_timestep are set
+        unsigned int m_interior_timestep;           //!< Time step of the last interior force computation
+        std::vector<unsigned char> m_has_ghost_neighbor; //!< Per-particle flag, non-zero if a neighbor is a ghost
+
+        std::shared_ptr<NeighborListCluster> m_cluster_nlist; //!< The neighbor list, if it is a cluster pair list
+        std::vector<Scalar> m_cluster_x;            //!< x coordinates in cluster order
+        std::vector<Scalar> m_cluster_y;            //!< y coordinates in cluster order
+        std::vector<Scalar> m_cluster_z;            //!< z coordinates in cluster order
+        std::vector<unsigned int> m_cluster_type;   //!< Types in cluster order
+        std::vector<Scalar> m_cluster_diameter;     //!< Diameters in cluster order (if needed by the evaluator)
+        std::vector<Scalar> m_cluster_charge;       //!< Charges in cluster order (if needed by the evaluator)
+        std::vector<Scalar3> m_cluster_shifts;      //!< Shift vectors of the periodic images of the cluster pairs
+        typename ClusterPairKernel<evaluator>::Tables m_cluster_tables; //!< Per type pair tables of the cluster kernel
+
+        //! Subsets of the local particles processed by computePairs()
+        enum particle_subset
+            {
+            all_particles = 0,  //!< All local particles
+            interior_particles, //!< Only particles without ghost neighbors
+            boundary_particles  //!< Only particles with at least one ghost neighbor
+            };
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the pair forces on a subset of the local particles
+        void computePairs(unsigned int timestep, particle_subset subset);
+
+        //! Compute the pair forces from the cluster pairs of a NeighborListCluster
+        void computeClusterPairs();
+
+        //! Evaluate the cluster pairs with the vectorized kernel of the evaluator
+        template<unsigned int M, bool compute_virial>
+        void computeClusterPairsKernel(Scalar4 *h_force, Scalar *h_virial, unsigned int virial_pitch,
+                                       unsigned int n_threads, bool use_thread_buffers);
+
+        //! Evaluate the cluster pairs one particle pair at a time
+        void computeClusterPairsGeneric(Scalar4 *h_force, Scalar *h_virial, unsigned int virial_pitch,
+                                        unsigned int n_threads, bool use_thread_buffers, bool compute_virial);
+
+        //! Evaluate the force and energy of a single pair
+        bool evaluatePair(Scalar rsq,
+                          unsigned int typpair_idx,
+                          Scalar di,
+                          Scalar dj,
+                          Scalar qi,
+                          Scalar qj,
+                          const param_type *h_params,
+                          const Scalar *h_rcutsq,
+                          const Scalar *h_ronsq,
+                          Scalar& force_divr,
+                          Scalar& pair_eng) const;
+
+        #ifdef ENABLE_MPI
+        //! Compute the forces on the interior particles while the ghost update is in flight
+        void computeInteriorForces(unsigned int timestep);
+        #endif
+
+        //! Allocate and zero the per-thread force and virial buffers
+        void resetThreadBuffers(unsigned int n_threads, unsigned int n);
+
+        //! Add the per-thread force and virial buffers to the force arrays
+        void reduceThreadBuffers(Scalar4 *h_force,
+                                 Scalar *h_virial,
+                                 unsigned int virial_pitch,
+                                 unsigned int n_threads,
+                                 unsigned int n,
+                                 bool compute_virial);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -176,13 +288,17 @@ template < class evaluator >
 PotentialPair< evaluator >::PotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                                                 std::shared_ptr<NeighborList> nlist,
                                                 const std::string& log_suffix)
-    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_shift_mode(no_shift), m_typpair_idx(m_pdata->getNTypes()),
+      m_comm_overlap(false), m_interior_valid(false), m_interior_timestep(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
     assert(m_pdata);
     assert(m_nlist);
 
+    // use the cluster kernel when the neighbor list stores cluster pairs
+    m_cluster_nlist = std::dynamic_pointer_cast<NeighborListCluster>(m_nlist);
+
     GPUArray<Scalar> rcutsq(m_typpair_idx.getNumElements(), m_exec_conf);
     m_rcutsq.swap(rcutsq);
     GPUArray<Scalar> ronsq(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -204,6 +320,39 @@ PotentialPair< evaluator >::~PotentialPair()
     m_exec_conf->msg->notice(5) << "Destroying PotentialPair<" << evaluator::getName() << ">" << std::endl;
 
     m_pdata->getNumTypesChangeSignal().template disconnect<PotentialPair<evaluator>, &PotentialPair<evaluator>::slotNumTypesChange>(this);
+
+    #ifdef ENABLE_MPI
+    if (m_comm && m_comm_overlap)
+        m_comm->getLocalComputeCallbackSignal().template disconnect<PotentialPair<evaluator>, &PotentialPair<evaluator>::computeInteriorForces>(this);
+    #endif
+    }
+
+/*! \param overlap True if the forces on interior particles should be computed while the ghost update is in flight
+
+    The overlap is only implemented for the CPU code path, it is ignored on the GPU.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::setCommOverlap(bool overlap)
+    {
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "pair." << evaluator::getName()
+                                    << ": comm_overlap is not supported on the GPU, ignoring" << std::endl;
+        return;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_comm && overlap != m_comm_overlap)
+        {
+        if (overlap)
+            m_comm->getLocalComputeCallbackSignal().template connect<PotentialPair<evaluator>, &PotentialPair<evaluator>::computeInteriorForces>(this);
+        else
+            m_comm->getLocalComputeCallbackSignal().template disconnect<PotentialPair<evaluator>, &PotentialPair<evaluator>::computeInteriorForces>(this);
+        }
+    #endif
+
+    m_comm_overlap = overlap;
+    m_interior_valid = false;
     }
 
 /*! \param typ1 First type index in the pair
@@ -314,6 +463,58 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    // a cluster pair list has its own kernel, and if the interior particles were already processed during the
+    // ghost update, only the boundary remains
+    if (m_cluster_nlist)
+        computeClusterPairs();
+    else if (!m_accumulate && m_interior_valid && m_interior_timestep == timestep && m_has_ghost_neighbor.size() == m_pdata->getN())
+        computePairs(timestep, boundary_particles);
+    else
+        computePairs(timestep, all_particles);
+    m_interior_valid = false;
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    Called by the Communicator between beginUpdateGhosts() and finishUpdateGhosts(). The neighbor list has already
+    passed its distance check for this step and is not rebuilt, so only local particle data is read.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeInteriorForces(unsigned int timestep)
+    {
+    // the cluster kernel does not split the particles, and the interior forces are not needed if the integrator
+    // accumulated the last forces directly in the net force or skips this force between its outer steps
+    if (m_cluster_nlist || !m_arrays_valid || timestep % m_evaluation_stride != 0)
+        return;
+
+    int64_t start_time = m_compute_clock.getTime();
+    m_nlist->compute(timestep);
+
+    if (m_prof) m_prof->push(m_prof_name);
+
+    computePairs(timestep, interior_particles);
+    m_interior_timestep = timestep;
+    m_interior_valid = true;
+
+    if (m_prof) m_prof->pop();
+
+    // the interior forces are part of this compute's cost for load balancing
+    m_compute_time += m_compute_clock.getTime() - start_time;
+    }
+#endif
+
+/*! \param timestep Current time step
+    \param subset Subset of the local particles to process
+
+    Processing interior_particles determines which particles have ghost neighbors and starts from zero forces.
+    Processing boundary_particles must follow it on the same neighbor list and adds to the existing forces.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computePairs(unsigned int timestep, particle_subset subset)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -329,9 +530,14 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
 
-    //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    //force arrays, in accumulate mode the forces are added to the net force
+    const GPUArray<Scalar4>& force_array = m_accumulate ? m_pdata->getNetForce() : m_force;
+    const GPUArray<Scalar>& virial_array = m_accumulate ? m_pdata->getNetVirial() : m_virial;
+    const unsigned int virial_pitch = virial_array.getPitch();
+    const bool add_forces = subset == boundary_particles || m_accumulate;
+    const access_mode::Enum force_mode = add_forces ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<Scalar4> h_force(force_array,access_location::host, force_mode);
+    ArrayHandle<Scalar>  h_virial(virial_array,access_location::host, force_mode);
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
@@ -343,12 +549,63 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    if (!add_forces)
+        {
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    // flag the particles that interact with ghosts, their forces have to wait for the ghost update
+    if (subset == interior_particles)
+        {
+        m_has_ghost_neighbor.resize(N);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const unsigned int myHead = h_head_list.data[i];
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            unsigned char has_ghost = 0;
+            for (unsigned int k = 0; k < size; k++)
+                {
+                if (h_nlist.data[myHead + k] >= N)
+                    {
+                    has_ghost = 1;
+                    break;
+                    }
+                }
+            m_has_ghost_neighbor[i] = has_ghost;
+            }
+        }
+
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    // with a half neighbor list, several threads may add to the same neighbor j: give each thread its own buffer
+    bool use_thread_buffers = third_law && n_threads > 1 && N > 0;
+    if (use_thread_buffers)
+        resetThreadBuffers(n_threads, N);
 
     // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    #pragma omp parallel for schedule(static) if (n_threads > 1)
+    for (int i = 0; i < (int)N; i++)
         {
+        // skip the particles that belong to the other subset
+        if (subset != all_particles && (m_has_ghost_neighbor[i] != 0) != (subset == boundary_particles))
+            continue;
+
+        // select the target for the third law contributions of this thread
+        unsigned int thread_idx = 0;
+        #ifdef ENABLE_OPENMP
+        thread_idx = omp_get_thread_num();
+        #endif
+
+        Scalar4 *force_j = use_thread_buffers ? &m_thread_force[thread_idx*N] : h_force.data;
+        Scalar *virial_j = use_thread_buffers ? &m_thread_virial[thread_idx*6*N] : h_virial.data;
+        const unsigned int virial_j_pitch = use_thread_buffers ? N : virial_pitch;
+
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
@@ -405,65 +662,14 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
             // calculate r_ij squared (FLOPS: 5)
             Scalar rsq = dot(dx, dx);
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
-                {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
-
             // compute the force and potential energy
             Scalar force_divr = Scalar(0.0);
             Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            bool evaluated = evaluatePair(rsq, m_typpair_idx(typei, typej), di, dj, qi, qj,
+                                          h_params.data, h_rcutsq.data, h_ronsq.data, force_divr, pair_eng);
 
             if (evaluated)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv =
-                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
-                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
-                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a +
-                        // But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
-
                 Scalar force_div2r = force_divr * Scalar(0.5);
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
@@ -481,21 +687,21 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
                 // only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                if (third_law && j < N)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force_j[mem_idx].x -= dx.x*force_divr;
+                    force_j[mem_idx].y -= dx.y*force_divr;
+                    force_j[mem_idx].z -= dx.z*force_divr;
+                    force_j[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virial_j[0*virial_j_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                        virial_j[1*virial_j_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                        virial_j[2*virial_j_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                        virial_j[3*virial_j_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                        virial_j[4*virial_j_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                        virial_j[5*virial_j_pitch+mem_idx] += force_div2r*dx.z*dx.z;
                         }
                     }
                 }
@@ -509,16 +715,530 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         h_force.data[mem_idx].w += pei;
         if (compute_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            h_virial.data[0*virial_pitch+mem_idx] += virialxxi;
+            h_virial.data[1*virial_pitch+mem_idx] += virialxyi;
+            h_virial.data[2*virial_pitch+mem_idx] += virialxzi;
+            h_virial.data[3*virial_pitch+mem_idx] += virialyyi;
+            h_virial.data[4*virial_pitch+mem_idx] += virialyzi;
+            h_virial.data[5*virial_pitch+mem_idx] += virialzzi;
             }
         }
 
-    if (m_prof) m_prof->pop();
+    if (use_thread_buffers)
+        reduceThreadBuffers(h_force.data, h_virial.data, virial_pitch, n_threads, N, compute_virial);
+    }
+
+/*! \param rsq Squared distance between the two particles
+    \param typpair_idx Index of the type pair in the parameter arrays
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+    \param h_params Pair parameters
+    \param h_rcutsq Squared cutoff radii
+    \param h_ronsq Squared XPLOR r_on radii
+    \param force_divr Output force divided by r
+    \param pair_eng Output pair energy
+    \returns true if the pair is within the cutoff and force_divr and pair_eng are set
+
+    Applies the energy shift and XPLOR smoothing according to the shift mode.
+*/
+template< class evaluator >
+inline bool PotentialPair< evaluator >::evaluatePair(Scalar rsq,
+                                                     unsigned int typpair_idx,
+                                                     Scalar di,
+                                                     Scalar dj,
+                                                     Scalar qi,
+                                                     Scalar qj,
+                                                     const param_type *h_params,
+                                                     const Scalar *h_rcutsq,
+                                                     const Scalar *h_ronsq,
+                                                     Scalar& force_divr,
+                                                     Scalar& pair_eng) const
+    {
+    // get parameters for this type pair
+    param_type param = h_params[typpair_idx];
+    Scalar rcutsq = h_rcutsq[typpair_idx];
+    Scalar ronsq = Scalar(0.0);
+    if (m_shift_mode == xplor)
+        ronsq = h_ronsq[typpair_idx];
+
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (m_shift_mode == shift)
+        energy_shift = true;
+    else if (m_shift_mode == xplor)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    // compute the force and potential energy
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    // modify the potential for xplor shifting
+    if (evaluated && m_shift_mode == xplor)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing (FLOPS: 16)
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv =
+                Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                       (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            // note: I'm not sure why the minus sign needs to be there: my notes have a +
+            // But this is verified correct via plotting
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+
+    return evaluated;
+    }
+
+/*! Loops over the cluster pairs of a NeighborListCluster instead of the per-particle neighbor list. The positions,
+    types, and (if needed) diameters and charges are first gathered into cluster order (M consecutive slots per
+    cluster, as separate x, y and z arrays), so that the members of a cluster are contiguous in memory. Every particle
+    pair appears in at most one interaction mask, so the third law is always used.
+
+    Particles wrap across the boundaries and the box may change between neighbor list builds. While gathering, each
+    position is mapped back to the frame of the last build with the minimum image relative to the build center of its
+    cluster. The displacement of a particle pair is then the difference of the gathered positions minus the shift of
+    the periodic image stored with the cluster pair, which is computed once per evaluation from the current lattice
+    vectors. No minimum image is needed per pair.
+
+    Evaluators with a vectorized kernel (ClusterPairKernel) evaluate all M*M pairs of a cluster pair without branching
+    on the individual pairs, unless XPLOR smoothing is enabled. All others are evaluated one pair at a time.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeClusterPairs()
+    {
+    const unsigned int M = m_cluster_nlist->getClusterSize();
+    const unsigned int n_slots = m_cluster_nlist->getNClusters() * M;
+    const std::vector<unsigned int>& members = m_cluster_nlist->getClusterMembers();
+    const std::vector<Scalar3>& centers = m_cluster_nlist->getClusterCenters();
+    const std::vector<int3>& images = m_cluster_nlist->getImages();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    const GPUArray<Scalar4>& force_array = m_accumulate ? m_pdata->getNetForce() : m_force;
+    const GPUArray<Scalar>& virial_array = m_accumulate ? m_pdata->getNetVirial() : m_virial;
+    const unsigned int virial_pitch = virial_array.getPitch();
+    const access_mode::Enum force_mode = m_accumulate ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<Scalar4> h_force(force_array,access_location::host, force_mode);
+    ArrayHandle<Scalar>  h_virial(virial_array,access_location::host, force_mode);
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+    // need to start from a zero force, energy and virial, unless adding to the net force
+    if (!m_accumulate)
+        {
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+        }
+
+    const unsigned int N = m_pdata->getN();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const BoxDim& box = m_pdata->getBox();
+
+    // shift vectors of the periodic images in the current box
+    m_cluster_shifts.resize(images.size());
+    for (unsigned int k = 0; k < images.size(); k++)
+        m_cluster_shifts[k] = Scalar(images[k].x) * box.getLatticeVector(0) +
+                              Scalar(images[k].y) * box.getLatticeVector(1) +
+                              Scalar(images[k].z) * box.getLatticeVector(2);
+
+    // gather the particle data into cluster order in the frame of the last build, padding slots are masked out
+    m_cluster_x.resize(n_slots);
+    m_cluster_y.resize(n_slots);
+    m_cluster_z.resize(n_slots);
+    m_cluster_type.resize(n_slots);
+    m_cluster_diameter.resize(evaluator::needsDiameter() ? n_slots : 0);
+    m_cluster_charge.resize(evaluator::needsCharge() ? n_slots : 0);
+
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < (int)n_slots; k++)
+        {
+        unsigned int idx = members[k];
+        if (idx == NO_PARTICLE)
+            {
+            m_cluster_x[k] = m_cluster_y[k] = m_cluster_z[k] = Scalar(0.0);
+            m_cluster_type[k] = 0;
+            continue;
+            }
+
+        const Scalar3 center = centers[k / M];
+        Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
+        pos = center + global_box.minImage(pos - center);
+
+        m_cluster_x[k] = pos.x;
+        m_cluster_y[k] = pos.y;
+        m_cluster_z[k] = pos.z;
+        m_cluster_type[k] = __scalar_as_int(h_pos.data[idx].w);
+        if (evaluator::needsDiameter())
+            m_cluster_diameter[k] = h_diameter.data[idx];
+        if (evaluator::needsCharge())
+            m_cluster_charge[k] = h_charge.data[idx];
+        }
+
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    bool use_thread_buffers = n_threads > 1 && N > 0;
+    if (use_thread_buffers)
+        resetThreadBuffers(n_threads, N);
+
+    bool use_kernel = false;
+    if (m_shift_mode != xplor)
+        {
+        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+        use_kernel = ClusterPairKernel<evaluator>::setup(m_cluster_tables, h_params.data, h_rcutsq.data,
+                                                         m_typpair_idx.getNumElements(), m_shift_mode == shift);
+        }
+
+    if (use_kernel && M == 4 && compute_virial)
+        computeClusterPairsKernel<4, true>(h_force.data, h_virial.data, virial_pitch, n_threads, use_thread_buffers);
+    else if (use_kernel && M == 4)
+        computeClusterPairsKernel<4, false>(h_force.data, h_virial.data, virial_pitch, n_threads, use_thread_buffers);
+    else if (use_kernel && M == 8 && compute_virial)
+        computeClusterPairsKernel<8, true>(h_force.data, h_virial.data, virial_pitch, n_threads, use_thread_buffers);
+    else if (use_kernel && M == 8)
+        computeClusterPairsKernel<8, false>(h_force.data, h_virial.data, virial_pitch, n_threads, use_thread_buffers);
+    else
+        computeClusterPairsGeneric(h_force.data, h_virial.data, virial_pitch, n_threads, use_thread_buffers,
+                                   compute_virial);
+
+    if (use_thread_buffers)
+        reduceThreadBuffers(h_force.data, h_virial.data, virial_pitch, n_threads, N, compute_virial);
+    }
+
+/*! \param h_force Force array to add the forces to
+    \param h_virial Virial array to add the virials to
+    \param virial_pitch Pitch of the virial array
+    \param n_threads Number of threads
+    \param use_thread_buffers True if the third law contributions go to the per-thread buffers
+
+    The forces on the members of cluster i are summed per lane over all of its cluster pairs and reduced at the end,
+    those on the members of local j clusters are summed per cluster pair and added to the per-thread buffers.
+*/
+template< class evaluator >
+template<unsigned int M, bool compute_virial>
+void PotentialPair< evaluator >::computeClusterPairsKernel(Scalar4 *h_force, Scalar *h_virial,
+                                                           unsigned int virial_pitch, unsigned int n_threads,
+                                                           bool use_thread_buffers)
+    {
+    const unsigned int n_local_clusters = m_cluster_nlist->getNLocalClusters();
+    const std::vector<unsigned int>& members = m_cluster_nlist->getClusterMembers();
+    const std::vector<unsigned int>& pair_head = m_cluster_nlist->getClusterPairHead();
+    const std::vector<NeighborListCluster::ClusterPair>& pairs = m_cluster_nlist->getClusterPairs();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
+    #pragma omp parallel for schedule(static) if (n_threads > 1)
+    for (int ci = 0; ci < (int)n_local_clusters; ci++)
+        {
+        unsigned int thread_idx = 0;
+        #ifdef ENABLE_OPENMP
+        thread_idx = omp_get_thread_num();
+        #endif
+
+        Scalar4 *force_j = use_thread_buffers ? &m_thread_force[thread_idx*N] : h_force;
+        Scalar *virial_j = use_thread_buffers ? &m_thread_virial[thread_idx*6*N] : h_virial;
+        const unsigned int virial_j_pitch = use_thread_buffers ? N : virial_pitch;
+
+        ClusterPairSums<M*M> sums_i;
+        ClusterPairSums<M> sums_j;
+        sums_i.zero();
+
+        const unsigned int ibase = ci*M;
+        for (unsigned int cur_pair = pair_head[ci]; cur_pair < pair_head[ci+1]; cur_pair++)
+            {
+            const NeighborListCluster::ClusterPair& pair = pairs[cur_pair];
+            const unsigned int jbase = pair.j*M;
+
+            sums_j.zero();
+            ClusterPairKernel<evaluator>::template compute<M, compute_virial>(m_cluster_tables, pair.mask, ntypes,
+                m_cluster_shifts[pair.image],
+                &m_cluster_x[ibase], &m_cluster_y[ibase], &m_cluster_z[ibase], &m_cluster_type[ibase],
+                &m_cluster_x[jbase], &m_cluster_y[jbase], &m_cluster_z[jbase], &m_cluster_type[jbase],
+                sums_i, sums_j);
+
+            // third law, only add force to local particles
+            if (pair.j >= n_local_clusters)
+                continue;
+
+            for (unsigned int b = 0; b < M; b++)
+                {
+                unsigned int mem_idx = members[jbase + b];
+                if (mem_idx == NO_PARTICLE)
+                    break;
+
+                force_j[mem_idx].x += sums_j.fx[b];
+                force_j[mem_idx].y += sums_j.fy[b];
+                force_j[mem_idx].z += sums_j.fz[b];
+                force_j[mem_idx].w += sums_j.e[b];
+                if (compute_virial)
+                    {
+                    for (unsigned int l = 0; l < 6; l++)
+                        virial_j[l*virial_j_pitch+mem_idx] += sums_j.virial[l][b];
+                    }
+                }
+            }
+
+        // every particle is a member of exactly one cluster, so no other thread writes to these directly
+        for (unsigned int a = 0; a < M; a++)
+            {
+            unsigned int mem_idx = members[ibase + a];
+            if (mem_idx == NO_PARTICLE)
+                break;
+
+            Scalar4 fi = make_scalar4(0, 0, 0, 0);
+            Scalar virial_i[6] = {0, 0, 0, 0, 0, 0};
+            for (unsigned int b = 0; b < M; b++)
+                {
+                fi.x += sums_i.fx[a*M + b];
+                fi.y += sums_i.fy[a*M + b];
+                fi.z += sums_i.fz[a*M + b];
+                fi.w += sums_i.e[a*M + b];
+                if (compute_virial)
+                    {
+                    for (unsigned int l = 0; l < 6; l++)
+                        virial_i[l] += sums_i.virial[l][a*M + b];
+                    }
+                }
+
+            h_force[mem_idx].x += fi.x;
+            h_force[mem_idx].y += fi.y;
+            h_force[mem_idx].z += fi.z;
+            h_force[mem_idx].w += fi.w;
+            if (compute_virial)
+                {
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial[l*virial_pitch+mem_idx] += virial_i[l];
+                }
+            }
+        }
+    }
+
+/*! \param h_force Force array to add the forces to
+    \param h_virial Virial array to add the virials to
+    \param virial_pitch Pitch of the virial array
+    \param n_threads Number of threads
+    \param use_thread_buffers True if the third law contributions go to the per-thread buffers
+    \param compute_virial True if the virial is needed
+
+    Evaluates the pairs set in the interaction masks one by one with evaluatePair(). Forces on the members of cluster i
+    are accumulated in registers and those on the members of local j clusters in the per-thread buffers.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeClusterPairsGeneric(Scalar4 *h_force, Scalar *h_virial,
+                                                            unsigned int virial_pitch, unsigned int n_threads,
+                                                            bool use_thread_buffers, bool compute_virial)
+    {
+    const unsigned int M = m_cluster_nlist->getClusterSize();
+    const unsigned int n_local_clusters = m_cluster_nlist->getNLocalClusters();
+    const std::vector<unsigned int>& members = m_cluster_nlist->getClusterMembers();
+    const std::vector<unsigned int>& pair_head = m_cluster_nlist->getClusterPairHead();
+    const std::vector<NeighborListCluster::ClusterPair>& pairs = m_cluster_nlist->getClusterPairs();
+    const unsigned int N = m_pdata->getN();
+
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+
+    // for each local cluster i
+    #pragma omp parallel for schedule(static) if (n_threads > 1)
+    for (int ci = 0; ci < (int)n_local_clusters; ci++)
+        {
+        unsigned int thread_idx = 0;
+        #ifdef ENABLE_OPENMP
+        thread_idx = omp_get_thread_num();
+        #endif
+
+        Scalar4 *force_j = use_thread_buffers ? &m_thread_force[thread_idx*N] : h_force;
+        Scalar *virial_j = use_thread_buffers ? &m_thread_virial[thread_idx*6*N] : h_virial;
+        const unsigned int virial_j_pitch = use_thread_buffers ? N : virial_pitch;
+
+        // accumulators for the members of cluster i
+        Scalar4 fi[8];
+        Scalar virial_i[6][8];
+        for (unsigned int a = 0; a < M; a++)
+            {
+            fi[a] = make_scalar4(0, 0, 0, 0);
+            for (unsigned int l = 0; l < 6; l++)
+                virial_i[l][a] = Scalar(0.0);
+            }
+
+        const unsigned int ibase = ci*M;
+        for (unsigned int cur_pair = pair_head[ci]; cur_pair < pair_head[ci+1]; cur_pair++)
+            {
+            const NeighborListCluster::ClusterPair& pair = pairs[cur_pair];
+            const unsigned int jbase = pair.j*M;
+            const bool local_j = pair.j < n_local_clusters;
+            const Scalar3 shift = m_cluster_shifts[pair.image];
+
+            for (unsigned int a = 0; a < M; a++)
+                {
+                uint64_t row = (pair.mask >> (a*M)) & ((uint64_t(1) << M) - 1);
+                if (!row)
+                    continue;
+
+                const Scalar xi = m_cluster_x[ibase + a] - shift.x;
+                const Scalar yi = m_cluster_y[ibase + a] - shift.y;
+                const Scalar zi = m_cluster_z[ibase + a] - shift.z;
+                const unsigned int typei = m_cluster_type[ibase + a];
+                const Scalar di = evaluator::needsDiameter() ? m_cluster_diameter[ibase + a] : Scalar(0.0);
+                const Scalar qi = evaluator::needsCharge() ? m_cluster_charge[ibase + a] : Scalar(0.0);
+
+                for (unsigned int b = 0; b < M; b++)
+                    {
+                    if (!((row >> b) & 1))
+                        continue;
+
+                    const unsigned int slot = jbase + b;
+                    Scalar3 dx = make_scalar3(xi - m_cluster_x[slot], yi - m_cluster_y[slot], zi - m_cluster_z[slot]);
+                    Scalar rsq = dot(dx, dx);
+
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar pair_eng = Scalar(0.0);
+                    bool evaluated = evaluatePair(rsq, m_typpair_idx(typei, m_cluster_type[slot]),
+                                                  di, evaluator::needsDiameter() ? m_cluster_diameter[slot] : Scalar(0.0),
+                                                  qi, evaluator::needsCharge() ? m_cluster_charge[slot] : Scalar(0.0),
+                                                  h_params.data, h_rcutsq.data, h_ronsq.data, force_divr, pair_eng);
+                    if (!evaluated)
+                        continue;
+
+                    Scalar force_div2r = force_divr * Scalar(0.5);
+                    fi[a].x += dx.x*force_divr;
+                    fi[a].y += dx.y*force_divr;
+                    fi[a].z += dx.z*force_divr;
+                    fi[a].w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        {
+                        virial_i[0][a] += force_div2r*dx.x*dx.x;
+                        virial_i[1][a] += force_div2r*dx.x*dx.y;
+                        virial_i[2][a] += force_div2r*dx.x*dx.z;
+                        virial_i[3][a] += force_div2r*dx.y*dx.y;
+                        virial_i[4][a] += force_div2r*dx.y*dx.z;
+                        virial_i[5][a] += force_div2r*dx.z*dx.z;
+                        }
+
+                    // third law, only add force to local particles
+                    if (local_j)
+                        {
+                        unsigned int mem_idx = members[slot];
+                        force_j[mem_idx].x -= dx.x*force_divr;
+                        force_j[mem_idx].y -= dx.y*force_divr;
+                        force_j[mem_idx].z -= dx.z*force_divr;
+                        force_j[mem_idx].w += pair_eng * Scalar(0.5);
+                        if (compute_virial)
+                            {
+                            virial_j[0*virial_j_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                            virial_j[1*virial_j_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                            virial_j[2*virial_j_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                            virial_j[3*virial_j_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                            virial_j[4*virial_j_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                            virial_j[5*virial_j_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                            }
+                        }
+                    }
+                }
+            }
+
+        // every particle is a member of exactly one cluster, so no other thread writes to these directly
+        for (unsigned int a = 0; a < M; a++)
+            {
+            unsigned int mem_idx = members[ibase + a];
+            if (mem_idx == NO_PARTICLE)
+                break;
+
+            h_force[mem_idx].x += fi[a].x;
+            h_force[mem_idx].y += fi[a].y;
+            h_force[mem_idx].z += fi[a].z;
+            h_force[mem_idx].w += fi[a].w;
+            if (compute_virial)
+                {
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial[l*virial_pitch+mem_idx] += virial_i[l][a];
+                }
+            }
+        }
+    }
+
+/*! \param n_threads Number of threads that accumulate forces
+    \param n Number of particles in each per-thread buffer
+    \post m_thread_force and m_thread_virial hold \a n_threads zeroed buffers of \a n particles each
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::resetThreadBuffers(unsigned int n_threads, unsigned int n)
+    {
+    m_thread_force.resize(n_threads*n);
+    m_thread_virial.resize(n_threads*6*n);
+
+    if (n == 0)
+        return;
+
+    memset((void*)&m_thread_force[0], 0, sizeof(Scalar4)*n_threads*n);
+    memset((void*)&m_thread_virial[0], 0, sizeof(Scalar)*n_threads*6*n);
+    }
+
+/*! \param h_force Force array to add the per-thread contributions to
+    \param h_virial Virial array to add the per-thread contributions to
+    \param virial_pitch Pitch of the virial array
+    \param n_threads Number of per-thread buffers
+    \param n Number of particles in each per-thread buffer
+    \param compute_virial True if the virial buffers should be reduced as well
+
+    The buffers are always summed in thread order so that the result does not depend on the scheduling.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::reduceThreadBuffers(Scalar4 *h_force,
+                                                     Scalar *h_virial,
+                                                     unsigned int virial_pitch,
+                                                     unsigned int n_threads,
+                                                     unsigned int n,
+                                                     bool compute_virial)
+    {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)n; i++)
+        {
+        for (unsigned int t = 0; t < n_threads; t++)
+            {
+            const Scalar4& f = m_thread_force[t*n + i];
+            h_force[i].x += f.x;
+            h_force[i].y += f.y;
+            h_force[i].z += f.z;
+            h_force[i].w += f.w;
+            if (compute_virial)
+                {
+                for (unsigned int k = 0; k < 6; k++)
+                    h_virial[k*virial_pitch+i] += m_thread_virial[t*6*n + k*n + i];
+                }
+            }
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -539,6 +1259,21 @@ CommFlags PotentialPair< evaluator >::getRequestedCommFlags(unsigned int timeste
 
     return flags;
     }
+
+/*! \param comm Communicator to use
+*/
+template < class evaluator >
+void PotentialPair< evaluator >::setCommunicator(std::shared_ptr<Communicator> comm)
+    {
+    // move the interior force call-back over to the new communicator
+    if (m_comm && m_comm_overlap)
+        m_comm->getLocalComputeCallbackSignal().template disconnect<PotentialPair<evaluator>, &PotentialPair<evaluator>::computeInteriorForces>(this);
+
+    if (comm && m_comm_overlap)
+        comm->getLocalComputeCallbackSignal().template connect<PotentialPair<evaluator>, &PotentialPair<evaluator>::computeInteriorForces>(this);
+
+    ForceCompute::setCommunicator(comm);
+    }
 #endif
 
 
@@ -724,6 +1459,7 @@ template < class T > void export_PotentialPair(pybind11::module& m, const std::s
         .def("setRcut", &T::setRcut)
         .def("setRon", &T::setRon)
         .def("setShiftMode", &T::setShiftMode)
+        .def("setCommOverlap", &T::setCommOverlap)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
     ;
 
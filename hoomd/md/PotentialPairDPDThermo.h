@@ -60,6 +60,12 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         //! Set the temperature
         virtual void setT(std::shared_ptr<Variant> T);
 
+        //! The thermostat kernel writes to the per-compute arrays only
+        virtual bool supportsAccumulate()
+            {
+            return false;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -146,9 +152,36 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     memset((void*)h_force.data,0,sizeof(Scalar4)*this->m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*this->m_virial.getNumElements());
 
+    // Special Potential Pair DPD Requirements
+    const Scalar currentTemp = m_T->getValue(timestep);
+
+    // the third law contributions also go to ghost particles
+    const unsigned int N = this->m_pdata->getN();
+    const unsigned int n_all = N + this->m_pdata->getNGhosts();
+
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    bool use_thread_buffers = third_law && n_threads > 1 && n_all > 0;
+    if (use_thread_buffers)
+        this->resetThreadBuffers(n_threads, n_all);
+
     // for each particle
-    for (int i = 0; i < (int)this->m_pdata->getN(); i++)
+    #pragma omp parallel for schedule(static) if (n_threads > 1)
+    for (int i = 0; i < (int)N; i++)
         {
+        // select the target for the third law contributions of this thread
+        unsigned int thread_idx = 0;
+        #ifdef ENABLE_OPENMP
+        thread_idx = omp_get_thread_num();
+        #endif
+
+        Scalar4 *force_j = use_thread_buffers ? &this->m_thread_force[thread_idx*n_all] : h_force.data;
+        Scalar *virial_j = use_thread_buffers ? &this->m_thread_virial[thread_idx*6*n_all] : h_virial.data;
+        const unsigned int virial_j_pitch = use_thread_buffers ? n_all : this->m_virial_pitch;
+
         // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         Scalar3 vi = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
@@ -212,9 +245,6 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
             Scalar pair_eng = Scalar(0.0);
             evaluator eval(rsq, rcutsq, param);
 
-            // Special Potential Pair DPD Requirements
-            const Scalar currentTemp = m_T->getValue(timestep);
-
             // set seed using global tags
             unsigned int tagi = h_tag.data[i];
             unsigned int tagj = h_tag.data[j];
@@ -248,12 +278,12 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
                 if (third_law)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force_j[mem_idx].x -= dx.x*force_divr;
+                    force_j[mem_idx].y -= dx.y*force_divr;
+                    force_j[mem_idx].z -= dx.z*force_divr;
+                    force_j[mem_idx].w += pair_eng * Scalar(0.5);
                     for (unsigned int l = 0; l < 6; l++)
-                        h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                        virial_j[l * virial_j_pitch + mem_idx] += pair_virial[l];
                     }
                 }
             }
@@ -268,6 +298,9 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
             h_virial.data[l * this->m_virial_pitch + mem_idx] += viriali[l];
         }
 
+    if (use_thread_buffers)
+        this->reduceThreadBuffers(h_force.data, h_virial.data, this->m_virial_pitch, n_threads, n_all, true);
+
     if (this->m_prof) this->m_prof->pop();
     }
 
@@ -78,6 +78,12 @@ class PotentialPairGPU : public PotentialPair<evaluator>
             m_tuner->setEnabled(enable);
             }
 
+        //! The GPU kernel writes to the per-compute arrays only
+        virtual bool supportsAccumulate()
+            {
+            return false;
+            }
+
     protected:
         std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for block size and threads per particle
         unsigned int m_param;                       //!< Kernel tuning parameter
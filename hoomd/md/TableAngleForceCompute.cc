@@ -10,6 +10,10 @@ namespace py = pybind11;
 
 #include <stdexcept>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 /*! \file TableAngleForceCompute.cc
     \brief Defines the TableAngleForceCompute class
 */
@@ -133,8 +137,129 @@ Scalar TableAngleForceCompute::getLogValue(const std::string& quantity, unsigned
         }
     }
 
+/*! \param h_pos Particle positions
+    \param idx Indices of the particles a, b and c
+    \param box Box for the minimum image convention
+    \param h_tables Tabulated potential and torque of all angle types
+    \param table_value Indexer into the tables
+    \param table_width Number of points in each table
+    \param angle_type Type of the angle
+    \param force Set to the force on a, b and c
+    \param angle_eng Set to the energy of each member, 1/3 of the angle energy
+    \param angle_virial Set to the virial of each member, 1/3 of the angle virial
+*/
+static inline void eval_table_angle(const Scalar4 *h_pos, const unsigned int *idx, const BoxDim& box,
+    const Scalar2 *h_tables, const Index2D& table_value, unsigned int table_width, unsigned int angle_type,
+    Scalar3 *force, Scalar& angle_eng, Scalar *angle_virial)
+    {
+    unsigned int idx_a = idx[0];
+    unsigned int idx_b = idx[1];
+    unsigned int idx_c = idx[2];
+
+    // calculate d\vec{r}
+    Scalar3 dab;
+    dab.x = h_pos[idx_a].x - h_pos[idx_b].x;
+    dab.y = h_pos[idx_a].y - h_pos[idx_b].y;
+    dab.z = h_pos[idx_a].z - h_pos[idx_b].z;
+
+    Scalar3 dcb;
+    dcb.x = h_pos[idx_c].x - h_pos[idx_b].x;
+    dcb.y = h_pos[idx_c].y - h_pos[idx_b].y;
+    dcb.z = h_pos[idx_c].z - h_pos[idx_b].z;
+
+    Scalar3 dac;
+    dac.x = h_pos[idx_a].x - h_pos[idx_c].x; // used for the 1-3 JL interaction
+    dac.y = h_pos[idx_a].y - h_pos[idx_c].y;
+    dac.z = h_pos[idx_a].z - h_pos[idx_c].z;
+
+
+    // apply minimum image conventions to all 3 vectors
+    dab = box.minImage(dab);
+    dcb = box.minImage(dcb);
+    dac = box.minImage(dac);
+
+    Scalar delta_th = Scalar(M_PI)/Scalar(table_width - 1);
+
+    // start computing the force
+    Scalar rsqab = dab.x*dab.x+dab.y*dab.y+dab.z*dab.z;
+    Scalar rab = sqrt(rsqab);
+    Scalar rsqcb = dcb.x*dcb.x+dcb.y*dcb.y+dcb.z*dcb.z;
+    Scalar rcb = sqrt(rsqcb);
+
+    // cosine of theta
+    Scalar c_abbc = dab.x*dcb.x+dab.y*dcb.y+dab.z*dcb.z;
+    c_abbc /= rab*rcb;
+
+    if (c_abbc > 1.0) c_abbc = 1.0;
+    if (c_abbc < -1.0) c_abbc = -1.0;
+
+    //1/sine of theta
+    Scalar s_abbc = sqrt(1.0 - c_abbc*c_abbc);
+    if (s_abbc < SMALL) s_abbc = SMALL;
+    s_abbc = 1.0/s_abbc;
+
+    //theta
+    Scalar theta = acos(c_abbc);
+
+    // precomputed term
+    Scalar value_f = theta / delta_th;
+
+    // compute index into the table and read in values
+
+    /// Here we use the table!!
+    unsigned int value_i = floor(value_f);
+    Scalar2 VT0 = h_tables[table_value(value_i, angle_type)];
+    Scalar2 VT1 = h_tables[table_value(value_i+1, angle_type)];
+    // unpack the data
+    Scalar V0 = VT0.x;
+    Scalar V1 = VT1.x;
+    Scalar T0 = VT0.y;
+    Scalar T1 = VT1.y;
+
+    // compute the linear interpolation coefficient
+    Scalar f = value_f - Scalar(value_i);
+
+    // interpolate to get V and T;
+    Scalar V = V0 + f * (V1 - V0);
+    Scalar T = T0 + f * (T1 - T0);
+
+    Scalar a =  T*s_abbc;
+    Scalar a11 = a*c_abbc/rsqab;
+    Scalar a12 = -a / (rab*rcb);
+    Scalar a22 = a*c_abbc / rsqcb;
+
+
+    Scalar fab[3], fcb[3];
+
+    fab[0] = a11*dab.x + a12*dcb.x;
+    fab[1] = a11*dab.y + a12*dcb.y;
+    fab[2] = a11*dab.z + a12*dcb.z;
+
+    fcb[0] = a22*dcb.x + a12*dab.x;
+    fcb[1] = a22*dcb.y + a12*dab.y;
+    fcb[2] = a22*dcb.z + a12*dab.z;
+
+    angle_eng = V*Scalar(1.0/3.0);
+
+    // compute 1/3 of the virial, 1/3 for each atom in the angle
+    // symmetrized version of virial tensor
+    angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
+    angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
+    angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
+    angle_virial[3] = Scalar(1./3.) * ( dab.y*fab[1] + dcb.y*fcb[1] );
+    angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
+    angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
+
+    force[0] = make_scalar3(fab[0], fab[1], fab[2]);
+    force[1] = make_scalar3(-fab[0] - fcb[0], -fab[1] - fcb[1], -fab[2] - fcb[2]);
+    force[2] = make_scalar3(fcb[0], fcb[1], fcb[2]);
+    }
+
 /*! \post The table based forces are computed for the given timestep.
 \param timestep specifies the current time step of the simulation
+
+With more than one OpenMP thread, every local particle gathers the angles it is part of from the per-particle table
+of the AngleData (as on the GPU), so that the threads never write to the same particle.
 */
 void TableAngleForceCompute::computeForces(unsigned int timestep)
     {
@@ -167,6 +292,50 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
 
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    n_threads = omp_get_max_threads();
+    #endif
+
+    if (n_threads > 1)
+        {
+        // the table is rebuilt on access if needed, and reports incomplete angles
+        ArrayHandle<AngleData::members_t> h_table(m_angle_data->getGPUTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_table_pos(m_angle_data->getGPUPosTable(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_n_angles(m_angle_data->getNGroupsArray(), access_location::host, access_mode::read);
+        const Index2D& table_indexer = m_angle_data->getGPUTableIndexer();
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < (int)m_pdata->getN(); i++)
+            {
+            for (unsigned int k = 0; k < h_n_angles.data[i]; k++)
+                {
+                const AngleData::members_t& entry = h_table.data[table_indexer(i, k)];
+                unsigned int cur_pos = h_table_pos.data[table_indexer(i, k)];
+
+                unsigned int idx[3];
+                get_group_members<3>(entry, cur_pos, i, idx);
+
+                unsigned int angle_type = entry.idx[2];
+                Scalar3 f[3];
+                Scalar angle_eng;
+                Scalar angle_virial[6];
+                eval_table_angle(h_pos.data, idx, box, h_tables.data, m_table_value, m_table_width, angle_type, f,
+                    angle_eng, angle_virial);
+
+                h_force.data[i].x += f[cur_pos].x;
+                h_force.data[i].y += f[cur_pos].y;
+                h_force.data[i].z += f[cur_pos].z;
+                h_force.data[i].w += angle_eng;
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j*virial_pitch+i]  += angle_virial[j];
+                }
+            }
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
     for (unsigned int i = 0; i < size; i++)
@@ -179,148 +348,42 @@ void TableAngleForceCompute::computeForces(unsigned int timestep)
 
         // transform a, b, and c into indicies into the particle data arrays
         // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
+        unsigned int idx[3];
+        for (unsigned int j = 0; j < 3; j++)
+            idx[j] = h_rtag.data[angle.tag[j]];
 
         // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL)
             {
             this->m_exec_conf->msg->error() << "angle.table: angle " <<
                 angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
             throw std::runtime_error("Error in angle calculation");
             }
 
-        assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-
-        // apply minimum image conventions to all 3 vectors
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
-
-        Scalar delta_th = Scalar(M_PI)/Scalar(m_table_width - 1);
-
-        // start computing the force
-        Scalar rsqab = dab.x*dab.x+dab.y*dab.y+dab.z*dab.z;
-        Scalar rab = sqrt(rsqab);
-        Scalar rsqcb = dcb.x*dcb.x+dcb.y*dcb.y+dcb.z*dcb.z;
-        Scalar rcb = sqrt(rsqcb);
-
-        // cosine of theta
-        Scalar c_abbc = dab.x*dcb.x+dab.y*dcb.y+dab.z*dcb.z;
-        c_abbc /= rab*rcb;
+        assert(idx[0] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN()+m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN()+m_pdata->getNGhosts());
 
-        if (c_abbc > 1.0) c_abbc = 1.0;
-        if (c_abbc < -1.0) c_abbc = -1.0;
-
-        //1/sine of theta
-        Scalar s_abbc = sqrt(1.0 - c_abbc*c_abbc);
-        if (s_abbc < SMALL) s_abbc = SMALL;
-        s_abbc = 1.0/s_abbc;
-
-        //theta
-        Scalar theta = acos(c_abbc);
-
-        // precomputed term
-        Scalar value_f = theta / delta_th;
-
-        // compute index into the table and read in values
-
-        /// Here we use the table!!
         unsigned int angle_type = m_angle_data->getTypeByIndex(i);
-        unsigned int value_i = floor(value_f);
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i+1, angle_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
-
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
-
-        Scalar a =  T*s_abbc;
-        Scalar a11 = a*c_abbc/rsqab;
-        Scalar a12 = -a / (rab*rcb);
-        Scalar a22 = a*c_abbc / rsqcb;
-
-
-        Scalar fab[3], fcb[3];
-
-        fab[0] = a11*dab.x + a12*dcb.x;
-        fab[1] = a11*dab.y + a12*dcb.y;
-        fab[2] = a11*dab.z + a12*dcb.z;
-
-        fcb[0] = a22*dcb.x + a12*dab.x;
-        fcb[1] = a22*dcb.y + a12*dab.y;
-        fcb[2] = a22*dcb.z + a12*dab.z;
-
-        Scalar angle_eng = V*Scalar(1.0/3.0);
-
-        // compute 1/3 of the virial, 1/3 for each atom in the angle
-        // symmetrized version of virial tensor
+        Scalar3 f[3];
+        Scalar angle_eng;
         Scalar angle_virial[6];
-        angle_virial[0] = Scalar(1./3.) * ( dab.x*fab[0] + dcb.x*fcb[0] );
-        angle_virial[1] = Scalar(1./3.) * ( dab.y*fab[0] + dcb.y*fcb[0] );
-        angle_virial[2] = Scalar(1./3.) * ( dab.z*fab[0] + dcb.z*fcb[0] );
-        angle_virial[3] = Scalar(1./3.) * ( dab.y*fab[1] + dcb.y*fcb[1] );
-        angle_virial[4] = Scalar(1./3.) * ( dab.z*fab[1] + dcb.z*fcb[1] );
-        angle_virial[5] = Scalar(1./3.) * ( dab.z*fab[2] + dcb.z*fcb[2] );
+        eval_table_angle(h_pos.data, idx, box, h_tables.data, m_table_value, m_table_width, angle_type, f, angle_eng,
+            angle_virial);
 
         // Now, apply the force to each individual atom a,b,c, and accumlate the energy/virial
         // only apply force to local atoms
-        if (idx_a < m_pdata->getN())
-            {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_a]  += angle_virial[j];
-            }
-
-        if (idx_b < m_pdata->getN())
+        for (unsigned int m = 0; m < 3; m++)
             {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_b]  += angle_virial[j];
-            }
+            if (idx[m] >= m_pdata->getN())
+                continue;
 
-        if (idx_c < m_pdata->getN())
-            {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
+            h_force.data[idx[m]].x += f[m].x;
+            h_force.data[idx[m]].y += f[m].y;
+            h_force.data[idx[m]].z += f[m].z;
+            h_force.data[idx[m]].w += angle_eng;
             for (int j = 0; j < 6; j++)
-                h_virial.data[j*virial_pitch+idx_c]  += angle_virial[j];
+                h_virial.data[j*virial_pitch+idx[m]]  += angle_virial[j];
             }
         }
 
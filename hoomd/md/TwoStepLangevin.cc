@@ -7,6 +7,7 @@
 #include "TwoStepLangevin.h"
 #include "hoomd/extern/saruprng.h"
 #include "hoomd/VectorMath.h"
+#include "hoomd/Checkpoint.h"
 
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
@@ -425,6 +426,22 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
         m_prof->pop();
     }
 
+/*! \param out Checkpoint stream
+*/
+void TwoStepLangevin::writeCheckpoint(std::ostream& out)
+    {
+    checkpoint_write(out, m_reservoir_energy);
+    checkpoint_write(out, m_extra_energy_overdeltaT);
+    }
+
+/*! \param in Checkpoint stream
+*/
+void TwoStepLangevin::readCheckpoint(std::istream& in)
+    {
+    checkpoint_read(in, m_reservoir_energy);
+    checkpoint_read(in, m_extra_energy_overdeltaT);
+    }
+
 void export_TwoStepLangevin(py::module& m)
     {
     py::class_<TwoStepLangevin, std::shared_ptr<TwoStepLangevin> >(m, "TwoStepLangevin", py::base<TwoStepLangevinBase>())
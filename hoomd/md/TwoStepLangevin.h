@@ -62,6 +62,12 @@ class TwoStepLangevin : public TwoStepLangevinBase
         //! Performs the second step of the integration
         virtual void integrateStepTwo(unsigned int timestep);
 
+        //! Write the reservoir energy to a checkpoint
+        virtual void writeCheckpoint(std::ostream& out);
+
+        //! Read the reservoir energy from a checkpoint
+        virtual void readCheckpoint(std::istream& in);
+
     protected:
         Scalar m_reservoir_energy;         //!< The energy of the reservoir the system is coupled to.
         Scalar m_extra_energy_overdeltaT;  //!< An energy packet that isn't added until the next time step
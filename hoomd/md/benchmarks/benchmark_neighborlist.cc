@@ -0,0 +1,66 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListStencil.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/NeighborListCluster.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/md/NeighborListGPUBinned.h"
+#include "hoomd/md/NeighborListGPUStencil.h"
+#include "hoomd/md/NeighborListGPUTree.h"
+#endif
+
+#include "hoomd/benchmarks/hoomd_benchmark.h"
+
+/*! \file benchmark_neighborlist.cc
+    \brief Benchmarks the neighbor list builds
+    \ingroup benchmarks
+*/
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Time buildNlist() with the cutoff and buffer of a typical LJ simulation
+template <class NL>
+void benchmark_neighborlist(hoomd_benchmark::Runner& runner, const std::string& name,
+                            NeighborList::storageMode mode)
+    {
+    if (!runner.enabled(name))
+        return;
+
+    for (Scalar density : hoomd_benchmark::system_densities)
+        for (unsigned int N : hoomd_benchmark::system_sizes)
+            {
+            std::shared_ptr<SystemDefinition> sysdef = hoomd_benchmark::make_random_system(runner.getExecConf(), N, density);
+
+            std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(2.5), Scalar(0.4)));
+            nlist->setStorageMode(mode);
+
+            runner.measure(name, hoomd_benchmark::system_params(N, density), N,
+                           [&](unsigned int n) { return nlist->benchmark(n); });
+            }
+    }
+
+HOOMD_BENCHMARK(neighborlist)
+    {
+    #ifdef ENABLE_CUDA
+    if (runner.getExecConf()->isCUDAEnabled())
+        {
+        benchmark_neighborlist<NeighborListGPUBinned>(runner, "NeighborListGPUBinned", NeighborList::full);
+        benchmark_neighborlist<NeighborListGPUStencil>(runner, "NeighborListGPUStencil", NeighborList::full);
+        benchmark_neighborlist<NeighborListGPUTree>(runner, "NeighborListGPUTree", NeighborList::full);
+        return;
+        }
+    #endif
+
+    benchmark_neighborlist<NeighborListBinned>(runner, "NeighborListBinned", NeighborList::half);
+    benchmark_neighborlist<NeighborListBinned>(runner, "NeighborListBinned(full)", NeighborList::full);
+    benchmark_neighborlist<NeighborListStencil>(runner, "NeighborListStencil", NeighborList::half);
+    benchmark_neighborlist<NeighborListTree>(runner, "NeighborListTree", NeighborList::half);
+    benchmark_neighborlist<NeighborListCluster>(runner, "NeighborListCluster", NeighborList::half);
+    }
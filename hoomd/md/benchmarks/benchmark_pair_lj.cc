@@ -0,0 +1,66 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListCluster.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/md/NeighborListGPUBinned.h"
+#endif
+
+#include "hoomd/benchmarks/hoomd_benchmark.h"
+
+/*! \file benchmark_pair_lj.cc
+    \brief Benchmarks PotentialPair<EvaluatorPairLJ>
+    \ingroup benchmarks
+*/
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Time the force loop of the LJ pair potential, the neighbor list is built once before timing
+template <class Pair, class NL>
+void benchmark_pair_lj(hoomd_benchmark::Runner& runner, const std::string& name, NeighborList::storageMode mode)
+    {
+    if (!runner.enabled(name))
+        return;
+
+    for (Scalar density : hoomd_benchmark::system_densities)
+        for (unsigned int N : hoomd_benchmark::system_sizes)
+            {
+            std::shared_ptr<SystemDefinition> sysdef = hoomd_benchmark::make_random_system(runner.getExecConf(), N, density);
+
+            std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(2.5), Scalar(0.4)));
+            nlist->setStorageMode(mode);
+
+            std::shared_ptr<Pair> lj(new Pair(sysdef, nlist));
+            Scalar epsilon = Scalar(1.0);
+            Scalar sigma = Scalar(1.0);
+            Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+            Scalar lj2 = Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+            lj->setParams(0, 0, make_scalar2(lj1, lj2));
+            lj->setRcut(0, 0, Scalar(2.5));
+
+            runner.measure(name, hoomd_benchmark::system_params(N, density), N,
+                           [&](unsigned int n) { return lj->benchmark(n); });
+            }
+    }
+
+HOOMD_BENCHMARK(pair_lj)
+    {
+    #ifdef ENABLE_CUDA
+    if (runner.getExecConf()->isCUDAEnabled())
+        {
+        benchmark_pair_lj<PotentialPairLJGPU, NeighborListGPUBinned>(runner, "PotentialPairLJGPU", NeighborList::full);
+        return;
+        }
+    #endif
+
+    benchmark_pair_lj<PotentialPairLJ, NeighborListBinned>(runner, "PotentialPairLJ", NeighborList::half);
+    benchmark_pair_lj<PotentialPairLJ, NeighborListBinned>(runner, "PotentialPairLJ(full)", NeighborList::full);
+    benchmark_pair_lj<PotentialPairLJ, NeighborListCluster>(runner, "PotentialPairLJ(cluster)", NeighborList::half);
+    }
@@ -0,0 +1,67 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/md/PPPMForceCompute.h"
+#include "hoomd/md/NeighborListTree.h"
+
+#ifdef ENABLE_CUDA
+#include "hoomd/md/PPPMForceComputeGPU.h"
+#endif
+
+#include "hoomd/benchmarks/hoomd_benchmark.h"
+
+/*! \file benchmark_pppm.cc
+    \brief Benchmarks the long range part of PPPMForceCompute
+    \ingroup benchmarks
+*/
+
+HOOMD_BENCHMARK_MAIN();
+
+//! Time charge assignment, FFTs, and force interpolation of PPPM
+/*! The mesh has the smallest power of two number of points per direction that gives a spacing of at most one.
+*/
+template <class PPPM>
+void benchmark_pppm(hoomd_benchmark::Runner& runner, const std::string& name)
+    {
+    if (!runner.enabled(name))
+        return;
+
+    for (Scalar density : hoomd_benchmark::system_densities)
+        for (unsigned int N : hoomd_benchmark::system_sizes)
+            {
+            std::shared_ptr<SystemDefinition> sysdef = hoomd_benchmark::make_random_system(runner.getExecConf(), N, density);
+            Scalar L = sysdef->getParticleData()->getGlobalBox().getL().x;
+
+            std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, Scalar(2.5), Scalar(0.4)));
+            std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+            std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+            unsigned int mesh = 8;
+            while (Scalar(mesh) < L)
+                mesh *= 2;
+
+            std::shared_ptr<PPPM> pppm(new PPPM(sysdef, nlist, group_all));
+            pppm->setParams(mesh, mesh, mesh, 5, Scalar(1.2), Scalar(2.5));
+
+            std::ostringstream params;
+            params << hoomd_benchmark::system_params(N, density) << " mesh=" << mesh;
+            runner.measure(name, params.str(), N, [&](unsigned int n) { return pppm->benchmark(n); });
+            }
+    }
+
+HOOMD_BENCHMARK(pppm)
+    {
+    #ifdef ENABLE_CUDA
+    if (runner.getExecConf()->isCUDAEnabled())
+        {
+        benchmark_pppm<PPPMForceComputeGPU>(runner, "PPPMForceComputeGPU");
+        return;
+        }
+    #endif
+
+    benchmark_pppm<PPPMForceCompute>(runner, "PPPMForceCompute");
+    }
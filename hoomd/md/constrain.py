@@ -238,20 +238,42 @@ class distance(_constraint_force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
-    def set_params(self,rel_tol=None):
+    def set_params(self,rel_tol=None,solver=None,solver_tol=None,max_iter=None):
         R""" Set parameters for constraint computation.
 
         Args:
             rel_tol (float): The relative tolerance with which constraint violations are detected (**optional**).
+            solver (str): Solver for the Lagrange multipliers, 'direct' or 'iterative' (**optional**).
+            solver_tol (float): Relative residual at which the iterative solver has converged (**optional**).
+            max_iter (int): Maximum number of iterations per molecule of the iterative solver (**optional**).
+
+        The default 'direct' solver factorizes the matrix of all local constraints with a sparse LU decomposition
+        every step. The 'iterative' solver solves the constraints of every molecule separately with a preconditioned
+        BiCGSTAB, starting from the Lagrange multipliers of the previous step, and distributes the molecules among the
+        OpenMP threads. It is faster for many molecules with many constraints each. Molecules that do not converge within
+        *max_iter* iterations are solved with the direct solver. The iterative solver always runs on the CPU.
 
         Example::
 
             dist = constrain.distance()
             dist.set_params(rel_tol=0.0001)
+            dist.set_params(solver='iterative', solver_tol=1e-8, max_iter=50)
         """
         if rel_tol is not None:
             self.cpp_force.setRelativeTolerance(float(rel_tol))
 
+        if solver is not None:
+            if solver not in ['direct', 'iterative']:
+                hoomd.context.msg.error("constrain.distance: solver must be 'direct' or 'iterative'\n");
+                raise RuntimeError("Error setting constraint parameters");
+            self.cpp_force.setIterative(solver == 'iterative')
+
+        if solver_tol is not None:
+            self.cpp_force.setSolverTolerance(float(solver_tol))
+
+        if max_iter is not None:
+            self.cpp_force.setMaxIterations(int(max_iter))
+
 class rigid(_constraint_force):
     R""" Constrain particles in rigid bodies.
 
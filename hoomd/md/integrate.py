@@ -52,6 +52,7 @@ class mode_standard(_integrator):
     Args:
         dt (float): Each time step of the simulation :py:func:`hoomd.run()` will advance the real time of the system forward by *dt* (in time units).
         aniso (bool): Whether to integrate rotational degrees of freedom (bool), default None (autodetect).
+        accumulate (bool): Set to True to let the forces add directly to the net force (CPU only).
 
     :py:class:`mode_standard` performs a standard time step integration technique to move the system forward. At each time
     step, all of the specified forces are evaluated and used in moving the system forward to the next step.
@@ -72,12 +73,22 @@ class mode_standard(_integrator):
     There can only be one integration mode active at a time. If there are more than one ``integrate.mode_*`` commands in
     a hoomd script, only the most recent before a given :py:func:`run()` will take effect.
 
+    With *accumulate* set to True, pair forces add their contributions directly to the net force of each particle.
+    This saves the memory for the per-force arrays and a pass over all particles each step. The per-force
+    arrays are recomputed on demand, for example when a pair energy is logged or a force is read from Python, which
+    costs an extra force evaluation on those steps. Forces that do not support this mode and all forces on the GPU
+    are summed as usual.
+
+    Slowly varying forces can be evaluated less often with multiple time step (r-RESPA) integration, see
+    :py:meth:`set_respa`.
+
     Examples::
 
         integrate.mode_standard(dt=0.005)
         integrator_mode = integrate.mode_standard(dt=0.001)
+        integrator_mode = integrate.mode_standard(dt=0.005, accumulate=True)
     """
-    def __init__(self, dt, aniso=None):
+    def __init__(self, dt, aniso=None, accumulate=False):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -86,7 +97,11 @@ class mode_standard(_integrator):
         # Store metadata
         self.dt = dt
         self.aniso = aniso
-        self.metadata_fields = ['dt', 'aniso']
+        self.accumulate = accumulate
+        self.metadata_fields = ['dt', 'aniso', 'accumulate']
+
+        # evaluation strides of the forces
+        self.force_strides = {};
 
         # initialize the reflected c++ class
         self.cpp_integrator = _md.IntegratorTwoStep(hoomd.context.current.system_definition, dt);
@@ -97,6 +112,8 @@ class mode_standard(_integrator):
         hoomd.util.quiet_status();
         if aniso is not None:
             self.set_params(aniso=aniso)
+        if accumulate:
+            self.set_params(accumulate=accumulate)
         hoomd.util.unquiet_status();
 
     ## \internal
@@ -106,17 +123,19 @@ class mode_standard(_integrator):
         True: _md.IntegratorAnisotropicMode.Anisotropic,
         False: _md.IntegratorAnisotropicMode.Isotropic}
 
-    def set_params(self, dt=None, aniso=None):
+    def set_params(self, dt=None, aniso=None, accumulate=None):
         R""" Changes parameters of an existing integration mode.
 
         Args:
             dt (float): New time step delta (if set) (in time units).
             aniso (bool): Anisotropic integration mode (bool), default None (autodetect).
+            accumulate (bool): Add forces directly to the net force (if set).
 
         Examples::
 
             integrator_mode.set_params(dt=0.007)
             integrator_mode.set_params(dt=0.005, aniso=False)
+            integrator_mode.set_params(accumulate=True)
 
         """
         hoomd.util.print_status_line();
@@ -136,6 +155,65 @@ class mode_standard(_integrator):
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+        if accumulate is not None:
+            if accumulate and hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.notice(2, "integrate.mode_standard: accumulate has no effect on the GPU\n");
+            self.accumulate = accumulate
+            self.cpp_integrator.setAccumulateForces(accumulate)
+
+    def set_respa(self, force, stride):
+        R""" Evaluates a force only every *stride* time steps.
+
+        Args:
+            force (:py:mod:`hoomd.md.force`): Force to evaluate less often.
+            stride (int): Number of time steps between evaluations of *force*.
+
+        :py:meth:`set_respa` enables impulse multiple time step integration (r-RESPA). The force is evaluated on time
+        steps that are a multiple of *stride* and applied as an impulse of *stride* time steps, while all other forces
+        are integrated with the time step *dt* by the integration methods (:py:class:`nve`, :py:class:`nvt`, ...).
+        This is useful for slowly varying forces, such as the long range part of :py:class:`hoomd.md.charge.pppm`
+        or pair forces with a long cutoff, when the fast bonded forces limit *dt*.
+
+        The outer step (*stride* times *dt*) must remain small compared to the fastest motion the slow force couples
+        to. Strides of 2 to 4 are typical.
+
+        The energy and virial of the force are included in the logged quantities only on time steps that are a
+        multiple of *stride*, so log with a period that is a multiple of *stride*. Integration methods that control
+        the pressure (:py:class:`npt`, :py:class:`nph`) cannot be used with strides larger than 1.
+
+        Set *stride* to 1 to evaluate the force every time step again.
+
+        Examples::
+
+            pppm = md.charge.pppm(group=charged)
+            integrator_mode.set_respa(pppm, stride=4)
+
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+
+        if not isinstance(force, hoomd.md.force._force) or force.cpp_force is None:
+            hoomd.context.msg.error("integrate.mode_standard: set_respa requires a force.\n");
+            raise RuntimeError("Error setting force stride.");
+
+        if int(stride) != stride or stride < 1:
+            hoomd.context.msg.error("integrate.mode_standard: stride must be a positive integer.\n");
+            raise RuntimeError("Error setting force stride.");
+
+        if stride == 1:
+            self.force_strides.pop(force, None);
+        else:
+            self.force_strides[force] = int(stride);
+
+    ## \internal
+    # \brief Updates the forces and their evaluation strides in the reflected c++ class
+    def update_forces(self):
+        _integrator.update_forces(self);
+
+        for f, stride in self.force_strides.items():
+            if f.enabled:
+                self.cpp_integrator.setForceStride(f.cpp_force, stride);
+
 class nvt(_integration_method):
     R""" NVT Integration via the Nosé-Hoover thermostat.
 
@@ -1269,6 +1347,162 @@ class mode_minimize_fire(_integrator):
         self.check_initialization();
         return self.cpp_integrator.hasConverged()
 
+class _mode_minimize_line_search(_integrator):
+    R""" Common code of the line search energy minimizers.
+
+    Derived classes create the C++ minimizer in *self.cpp_integrator* and call :py:meth:`_setup`.
+    """
+    def _setup(self, max_step, ftol, Etol, min_steps):
+        self.supports_methods = False;
+
+        hoomd.context.current.system.setIntegrator(self.cpp_integrator);
+
+        self.max_step = max_step
+        self.metadata_fields = ['max_step']
+
+        self.cpp_integrator.setFtol(ftol);
+        self.ftol = ftol
+        self.metadata_fields.append('ftol')
+
+        self.cpp_integrator.setEtol(Etol);
+        self.Etol = Etol
+        self.metadata_fields.append('Etol')
+
+        self.cpp_integrator.setMinSteps(min_steps);
+        self.min_steps = min_steps
+        self.metadata_fields.append('min_steps')
+
+    def has_converged(self):
+        R""" Test if the energy minimizer has converged.
+
+        Returns:
+            True when the minimizer has converged. Otherwise, return False.
+        """
+        self.check_initialization();
+        return self.cpp_integrator.hasConverged()
+
+    def reset(self):
+        R""" Restart the minimization from the current positions.
+
+        The minimizer discards its search direction and history, and the convergence criteria are tested again.
+        """
+        hoomd.util.print_status_line();
+        self.check_initialization();
+        self.cpp_integrator.reset();
+
+class mode_minimize_cg(_mode_minimize_line_search):
+    R""" Energy Minimizer (nonlinear conjugate gradient).
+
+    Args:
+        group (:py:mod:`hoomd.group`): Particle group to apply minimization to.
+        max_step (float): Maximum displacement of a particle in one line search (in distance units)
+        ftol (float): force convergence criteria (in force units)
+        Etol (float): energy convergence criteria (in energy units)
+        min_steps (int): A minimum number of force evaluations before convergence criteria are considered
+
+    :py:class:`mode_minimize_cg` minimizes the energy of a group of particles with the Polak-Ribière nonlinear
+    conjugate gradient method, while keeping all other particles fixed. The search direction is
+
+    .. math::
+
+        \vec{d}_{k} = \vec{F}_{k} + \beta_k \vec{d}_{k-1}, \;\;
+        \beta_k = \max\left(0, \frac{\vec{F}_{k} \cdot (\vec{F}_{k} - \vec{F}_{k-1})}{\vec{F}_{k-1}^2}\right)
+
+    where :math:`\vec{F}` is the vector of the net forces on all particles in the group. A line search along
+    :math:`\vec{d}` finds a step that lowers the energy sufficiently and reduces the slope (weak Wolfe conditions),
+    no particle is moved by more than *max_step* from the start of the search.
+
+    Each time step of :py:func:`hoomd.run()` is one evaluation of the forces. The line search typically needs
+    one or two evaluations per search direction. Convergence is tested at the end of each line search with the same
+    criteria as :py:class:`mode_minimize_fire`:
+
+    .. math::
+
+        \frac{\sum |F|}{N*\sqrt{N_{dof}}} <ftol \;\; and \;\; \Delta \frac{\sum |E|}{N} < Etol
+
+    :py:class:`mode_minimize_cg` works in MPI parallel simulations. When a particle moves to another domain, the
+    current line search ends and the next search direction is the steepest descent. Only positions are minimized,
+    orientations are kept fixed.
+
+    Example::
+
+        cg = integrate.mode_minimize_cg(group=group.all(), max_step=0.1, ftol=1e-2, Etol=1e-7)
+        while not(cg.has_converged()):
+           run(100)
+
+    Warning:
+        All other integration methods must be disabled before using the energy minimizer.
+
+    """
+    def __init__(self, group, max_step, ftol=1e-1, Etol=1e-5, min_steps=10):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        _integrator.__init__(self);
+
+        # initialize the reflected c++ class
+        self.cpp_integrator = _md.CGEnergyMinimizer(hoomd.context.current.system_definition, group.cpp_group, float(max_step));
+
+        self._setup(max_step, ftol, Etol, min_steps);
+
+class mode_minimize_lbfgs(_mode_minimize_line_search):
+    R""" Energy Minimizer (L-BFGS).
+
+    Args:
+        group (:py:mod:`hoomd.group`): Particle group to apply minimization to.
+        max_step (float): Maximum displacement of a particle in one line search (in distance units)
+        history (int): Number of previous steps used to approximate the inverse Hessian
+        ftol (float): force convergence criteria (in force units)
+        Etol (float): energy convergence criteria (in energy units)
+        min_steps (int): A minimum number of force evaluations before convergence criteria are considered
+
+    :py:class:`mode_minimize_lbfgs` minimizes the energy of a group of particles with the limited memory
+    Broyden-Fletcher-Goldfarb-Shanno quasi-Newton method, while keeping all other particles fixed. The inverse Hessian
+    is approximated from the displacements and force changes of the last *history* steps
+    (`Nocedal, Math. Comp., 1980 <http://dx.doi.org/10.1090/S0025-5718-1980-0572855-7>`_). A line search along the
+    resulting direction finds a step that lowers the energy sufficiently and reduces the slope (weak Wolfe conditions),
+    no particle is moved by more than *max_step* from the start of the search. Near the minimum, the first
+    trial step is usually accepted, so that each search direction costs one evaluation of the forces.
+
+    Each time step of :py:func:`hoomd.run()` is one evaluation of the forces. Convergence is tested at the end of
+    each line search with the same criteria as :py:class:`mode_minimize_fire`:
+
+    .. math::
+
+        \frac{\sum |F|}{N*\sqrt{N_{dof}}} <ftol \;\; and \;\; \Delta \frac{\sum |E|}{N} < Etol
+
+    The minimizer stores 2 *history* vectors per particle. :py:class:`mode_minimize_lbfgs` works in MPI parallel
+    simulations. The history is discarded when a particle moves to another domain, and the minimization continues
+    with steepest descent from the current point. Only positions are minimized, orientations are kept fixed.
+
+    Example::
+
+        lbfgs = integrate.mode_minimize_lbfgs(group=group.all(), max_step=0.1, ftol=1e-2, Etol=1e-7)
+        while not(lbfgs.has_converged()):
+           run(100)
+
+    Warning:
+        All other integration methods must be disabled before using the energy minimizer.
+
+    """
+    def __init__(self, group, max_step, history=10, ftol=1e-1, Etol=1e-5, min_steps=10):
+        hoomd.util.print_status_line();
+
+        if int(history) < 1:
+            hoomd.context.msg.error("integrate.mode_minimize_lbfgs: history must be at least 1.\n");
+            raise RuntimeError("Error setting up integration mode.");
+
+        # initialize base class
+        _integrator.__init__(self);
+
+        # initialize the reflected c++ class
+        self.cpp_integrator = _md.LBFGSEnergyMinimizer(hoomd.context.current.system_definition, group.cpp_group, float(max_step), int(history));
+
+        self._setup(max_step, ftol, Etol, min_steps);
+
+        self.history = int(history)
+        self.metadata_fields.append('history')
+
 class berendsen(_integration_method):
     R""" Applies the Berendsen thermostat.
 
@@ -12,6 +12,7 @@
 #include "AllTripletPotentials.h"
 #include "AnisoPotentialPair.h"
 #include "BondTablePotential.h"
+#include "CGEnergyMinimizer.h"
 #include "ConstExternalFieldDipoleForceCompute.h"
 #include "ConstraintEllipsoid.h"
 #include "ConstraintSphere.h"
@@ -25,11 +26,14 @@
 #include "HarmonicImproperForceCompute.h"
 #include "IntegrationMethodTwoStep.h"
 #include "IntegratorTwoStep.h"
+#include "LBFGSEnergyMinimizer.h"
+#include "LineSearchEnergyMinimizer.h"
 #include "MolecularForceCompute.h"
 #include "NeighborListBinned.h"
 #include "NeighborList.h"
 #include "NeighborListStencil.h"
 #include "NeighborListTree.h"
+#include "NeighborListCluster.h"
 #include "OPLSDihedralForceCompute.h"
 #include "PotentialBond.h"
 #include "PotentialExternal.h"
@@ -224,6 +228,7 @@ PYBIND11_PLUGIN(_md)
     export_NeighborListBinned(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
+    export_NeighborListCluster(m);
     export_ConstraintSphere(m);
     export_MolecularForceCompute(m);
     export_ForceDistanceConstraint(m);
@@ -307,6 +312,9 @@ PYBIND11_PLUGIN(_md)
     export_Enforce2DUpdater(m);
     export_ConstraintEllipsoid(m);
     export_FIREEnergyMinimizer(m);
+    export_LineSearchEnergyMinimizer(m);
+    export_CGEnergyMinimizer(m);
+    export_LBFGSEnergyMinimizer(m);
 
 #ifdef ENABLE_CUDA
     export_TwoStepNVEGPU(m);
@@ -23,7 +23,9 @@ are implemented. The cell list implementation is fastest when the cutoff radius
 when there is large disparity in the pair cutoff radius and a high number fraction of particles with the
 bigger cutoff (at least 30%). The tree implementation is faster when there is large size disparity and
 the number fraction of big objects is low. Because the performance of these algorithms depends sensitively on your
-system and hardware, you should carefully test which option is fastest for your simulation.
+system and hardware, you should carefully test which option is fastest for your simulation. On the CPU, the
+cluster pair implementation stores pairs of small particle clusters instead of per-particle neighbors, and is
+usually fastest for dense systems with short cutoffs.
 
 Particles can be excluded from the neighbor list based on certain criteria. Setting :math:`r_\mathrm{cut}(i,j) \le 0`
 will exclude this cross interaction from the neighbor list on build time. Particles can also be excluded by topology
@@ -404,6 +406,51 @@ class nlist:
         # return the results to the script
         return (fastest_r_buff, self.query_update_period());
 
+    def set_buffer_tuning(self, enable=True, period=2000, r_min=0.05, r_max=1.0, check_period=True):
+        R""" Tune r_buff (and check_period) while the simulation runs.
+
+        Args:
+            enable (bool): Set to False to stop tuning and keep the current values
+            period (int): Number of time steps to measure each r_buff value
+            r_min (float): Smallest value of r_buff to set
+            r_max (float): Largest value of r_buff to set
+            check_period (bool): Set to False to leave check_period unchanged
+
+        Unlike :py:meth:`tune()`, which makes a series of separate runs, :py:meth:`set_buffer_tuning()` tunes *r_buff*
+        during the following :py:func:`hoomd.run()` calls. Every *period* time steps, the wall clock time per step is
+        compared against the fastest *r_buff* so far, and *r_buff* is moved further in the same direction when it
+        improved or to the other side of the fastest value when it did not. The step size grows after repeated
+        improvements and shrinks after each miss, so *r_buff* settles around the optimum and follows it when the
+        system changes. Each change of *r_buff* forces a neighbor list rebuild.
+
+        When *check_period* is True, the check period is set to half of the shortest rebuild period seen during each
+        *period* (scaled to the new *r_buff*) and halved whenever a dangerous build occurs. This overrides the
+        *check_period* given to :py:meth:`set_params()`.
+
+        Set the notice level to 3 or higher to print the measured cost and the chosen values after each *period*.
+
+        Examples::
+
+            nl.set_buffer_tuning()
+            nl.set_buffer_tuning(period=5000, r_min=0.2, r_max=0.6, check_period=False)
+            nl.set_buffer_tuning(enable=False)
+        """
+        hoomd.util.print_status_line();
+
+        if self.cpp_nlist is None:
+            hoomd.context.msg.error('Bug in hoomd_script: cpp_nlist not set, please report\n');
+            raise RuntimeError('Error setting neighbor list parameters');
+
+        if period <= 0:
+            hoomd.context.msg.error('nlist.set_buffer_tuning: period must be positive\n');
+            raise RuntimeError('Error setting neighbor list parameters');
+
+        if r_min < 0 or r_max < r_min:
+            hoomd.context.msg.error('nlist.set_buffer_tuning: r_min must be non-negative and no larger than r_max\n');
+            raise RuntimeError('Error setting neighbor list parameters');
+
+        self.cpp_nlist.setBufferTuning(enable, int(period), float(r_min), float(r_max), check_period);
+
 ## \internal
 # \brief %nlist r_cut matrix
 # \details
@@ -521,6 +568,7 @@ class cell(nlist):
         dist_check (bool): Flag to enable / disable distance checking.
         name (str): Optional name for this neighbor list instance.
         deterministic (bool): When True, enable deterministic runs on the GPU by sorting the cell list.
+        compact (bool): When True, store the cell list with memory proportional to the number of particles (CPU only).
 
     :py:class:`cell` creates a cell list based neighbor list object to which pair potentials can be attached for computing
     non-bonded pairwise interactions. Cell listing allows for *O(N)* construction of the neighbor list. Particles are first
@@ -534,6 +582,10 @@ class cell(nlist):
     Use base class methods to change parameters (:py:meth:`set_params <nlist.set_params>`), reset the exclusion list
     (:py:meth:`reset_exclusions <nlist.reset_exclusions>`) or tune *r_buff* (:py:meth:`tune <nlist.tune>`).
 
+    By default, the cell list reserves the same number of slots for every cell, sized by the most crowded cell. With
+    *compact* set to True, the members of all cells are stored back to back instead. This keeps the memory
+    proportional to the number of particles in strongly inhomogeneous systems such as droplets or interfaces.
+
     Examples::
 
         nl_c = nlist.cell(check_period = 1)
@@ -546,7 +598,7 @@ class cell(nlist):
         is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
         significantly degraded performance or incorrect results.
     """
-    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, deterministic=False):
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, deterministic=False, compact=False):
         hoomd.util.print_status_line()
 
         nlist.__init__(self)
@@ -571,6 +623,8 @@ class cell(nlist):
 
         hoomd.context.current.system.addCompute(self.cpp_nlist, self.name)
         self.cpp_cl.setSortCellList(deterministic)
+        if compact:
+            self.cpp_cl.setCompact(True)
 
         # register this neighbor list with the context
         hoomd.context.current.neighbor_lists += [self]
@@ -593,6 +647,7 @@ class stencil(nlist):
         cell_width (float): The underlying stencil bin width for the cell list
         name (str): Optional name for this neighbor list instance.
         deterministic (bool): When True, enable deterministic runs on the GPU by sorting the cell list.
+        compact (bool): When True, store the cell list with memory proportional to the number of particles (CPU only).
 
     :py:class:`stencil` creates a cell list based neighbor list object to which pair potentials can be attached for computing
     non-bonded pairwise interactions. Cell listing allows for O(N) construction of the neighbor list. Particles are first
@@ -627,7 +682,7 @@ class stencil(nlist):
         is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
         significantly degraded performance or incorrect results.
     """
-    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, cell_width=None, name=None, deterministic=False):
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, cell_width=None, name=None, deterministic=False, compact=False):
         hoomd.util.print_status_line()
 
         # register the citation
@@ -669,6 +724,8 @@ class stencil(nlist):
 
         hoomd.context.current.system.addCompute(self.cpp_nlist, self.name)
         self.cpp_cl.setSortCellList(deterministic)
+        if compact:
+            self.cpp_cl.setCompact(True)
 
         # register this neighbor list with the context
         hoomd.context.current.neighbor_lists += [self]
@@ -860,3 +917,71 @@ class tree(nlist):
         self.set_params(r_buff, check_period, d_max, dist_check)
         hoomd.util.unquiet_status()
 tree.cur_id = 0
+
+class cluster(nlist):
+    R""" Cluster pair neighbor list for the CPU.
+
+    Args:
+        r_buff (float):  Buffer width.
+        check_period (int): How often to attempt to rebuild the neighbor list.
+        d_max (float): The maximum diameter a particle will achieve, only used in conjunction with slj diameter shifting.
+        dist_check (bool): Flag to enable / disable distance checking.
+        cluster_size (int): Number of particles per cluster, 4 or 8.
+        name (str): Optional name for this neighbor list instance.
+
+    :py:class:`cluster` groups spatially close particles into clusters of *cluster_size* particles and stores pairs of
+    clusters instead of a list of neighbors per particle. Each cluster pair carries a mask of the particle pairs within
+    the list radius, so the list is much smaller than a per-particle list. Standard pair potentials evaluate all
+    pairs of two clusters in a tight loop over contiguous memory, which is faster than walking a per-particle list for
+    dense liquids with short cutoffs. Other forces that use the neighbor list still work, they read a per-particle list
+    that is generated from the cluster pairs when needed.
+
+    Use base class methods to change parameters (:py:meth:`set_params <nlist.set_params>`), reset the exclusion list
+    (:py:meth:`reset_exclusions <nlist.reset_exclusions>`) or tune *r_buff* (:py:meth:`tune <nlist.tune>`).
+
+    Examples::
+
+        nl_cl = nlist.cluster(cluster_size = 4)
+        nl_cl.set_params(r_buff=0.4)
+        lj = pair.lj(r_cut = 2.5, nlist=nl_cl)
+
+    Note:
+        *d_max* should only be set when slj diameter shifting is required by a pair potential. Currently, slj
+        is the only pair potential requiring this shifting, and setting *d_max* for other potentials may lead to
+        significantly degraded performance or incorrect results.
+
+    .. attention::
+        Cluster pair neighbor lists are only available on the CPU.
+
+    """
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, cluster_size=4, name=None):
+        hoomd.util.print_status_line()
+
+        nlist.__init__(self)
+
+        # create the C++ mirror class
+        if not hoomd.context.exec_conf.isCUDAEnabled():
+            self.cpp_nlist = _md.NeighborListCluster(hoomd.context.current.system_definition, 0.0, r_buff, int(cluster_size))
+        else:
+            hoomd.context.msg.error("nlist.cluster: not supported on the GPU, use nlist.cell instead\n")
+            raise RuntimeError("Error initializing nlist.cluster")
+
+        self.cpp_nlist.setEvery(check_period, dist_check)
+
+        if name is None:
+            self.name = "cluster_nlist_%d" % cluster.cur_id
+            cluster.cur_id += 1
+        else:
+            self.name = name
+
+        hoomd.context.current.system.addCompute(self.cpp_nlist, self.name)
+
+        # register this neighbor list with the context
+        hoomd.context.current.neighbor_lists += [self]
+
+        # save the user defined parameters
+        hoomd.util.quiet_status()
+        self.set_params(r_buff, check_period, d_max, dist_check)
+        hoomd.util.unquiet_status()
+
+cluster.cur_id = 0
@@ -376,11 +376,13 @@ class pair(force._force):
         self.nlist.subscribe(lambda:self.get_rcut())
         self.nlist.update_rcut()
 
-    def set_params(self, mode=None):
+    def set_params(self, mode=None, comm_overlap=None):
         R""" Set parameters controlling the way forces are computed.
 
         Args:
             mode (str): (if set) Set the mode with which potentials are handled at the cutoff.
+            comm_overlap (bool): (if set) Overlap the force computation on interior particles with the ghost
+                communication (MPI simulations on the CPU only).
 
         Valid values for *mode* are: "none" (the default), "shift", and "xplor":
 
@@ -391,11 +393,18 @@ class pair(force._force):
 
         See :py:class:`pair` for the equations.
 
+        With *comm_overlap* enabled, the forces on particles that have no neighbors in the ghost layer are computed
+        while the ghost particle positions are being exchanged with the neighboring ranks. Only the remaining
+        particles near the domain boundaries wait for the exchange to complete. The overlap takes effect on
+        steps without particle migration and when no rigid bodies are present. The summation order of the forces
+        changes, so results differ from the default in the last bits.
+
         Examples::
 
             mypair.set_params(mode="shift")
             mypair.set_params(mode="no_shift")
             mypair.set_params(mode="xplor")
+            mypair.set_params(comm_overlap=True)
 
         """
         hoomd.util.print_status_line();
@@ -411,6 +420,9 @@ class pair(force._force):
                 hoomd.context.msg.error("Invalid mode\n");
                 raise RuntimeError("Error changing parameters in pair force");
 
+        if comm_overlap is not None:
+            self.cpp_force.setCommOverlap(bool(comm_overlap))
+
     def process_coeff(self, coeff):
         hoomd.context.msg.error("Bug in hoomd_script, please report\n");
         raise RuntimeError("Error processing coefficients");
@@ -785,7 +797,7 @@ class slj(pair):
         lj2 = alpha * 4.0 * epsilon * math.pow(sigma, 6.0);
         return _hoomd.make_scalar2(lj1, lj2);
 
-    def set_params(self, mode=None):
+    def set_params(self, mode=None, comm_overlap=None):
         R""" Set parameters controlling the way forces are computed.
 
         See :py:meth:`pair.set_params()`.
@@ -800,7 +812,7 @@ class slj(pair):
             hoomd.context.msg.error("XPLOR is smoothing is not supported with slj\n");
             raise RuntimeError("Error changing parameters in pair force");
 
-        pair.set_params(self, mode=mode);
+        pair.set_params(self, mode=mode, comm_overlap=comm_overlap);
 
 class yukawa(pair):
     R""" Yukawa pair potential.
@@ -50,6 +50,46 @@ class analyze_log_tests (unittest.TestCase):
         ana = hoomd.analyze.log(quantities = ['test1', 'test2', 'test3'], period = lambda n: n*10, filename=self.tmp_file);
         hoomd.run(100);
 
+    # test binary output and conversion to text
+    def test_binary(self):
+        ana = hoomd.analyze.log(quantities = ['test1', 'test2', 'test3'], period = 10, filename=self.tmp_file, binary=True, buffer_rows=4);
+        hoomd.run(100);
+        ana.set_params(quantities = ['test1']);
+        hoomd.run(100);
+        ana.disable();
+
+        if hoomd.comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.test.txt');
+            hoomd.analyze.convert_binary_log(self.tmp_file, tmp[1]);
+            with open(tmp[1]) as f:
+                lines = f.readlines();
+            os.remove(tmp[1]);
+
+            self.assertEqual(lines[0].split(), ['timestep', 'test1', 'test2', 'test3']);
+            self.assertEqual(len(lines), 1 + 10 + 1 + 10);
+            self.assertEqual(lines[1].split()[0], '0');
+            self.assertEqual(lines[11].split(), ['timestep', 'test1']);
+            self.assertEqual(lines[21].split()[0], '190');
+
+    # test conversion of a binary log written on a big endian host
+    def test_binary_big_endian(self):
+        if hoomd.comm.get_rank() == 0:
+            import struct
+            with open(self.tmp_file, 'wb') as f:
+                f.write(b'HOOMDLOG' + struct.pack('>II', 1, 0x01020304));
+                f.write(struct.pack('>III', 1, 1, 5) + b'test1');
+                f.write(struct.pack('>II2Q2d', 2, 2, 10, 20, 1.5, -2.0));
+
+            tmp = tempfile.mkstemp(suffix='.test.txt');
+            hoomd.analyze.convert_binary_log(self.tmp_file, tmp[1]);
+            with open(tmp[1]) as f:
+                lines = f.readlines();
+            os.remove(tmp[1]);
+
+            self.assertEqual(lines[0].split(), ['timestep', 'test1']);
+            self.assertEqual(lines[1].split(), ['10', '1.5']);
+            self.assertEqual(lines[2].split(), ['20', '-2']);
+
     # test the initialization checks
     def test_init_checks(self):
         ana = hoomd.analyze.log(quantities = ['test1', 'test2', 'test3'], period = 10, filename=self.tmp_file);
@@ -0,0 +1,131 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import md
+context.initialize()
+import unittest
+import os
+import shutil
+import numpy
+
+# unit tests for dump.checkpoint
+class dump_checkpoint_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        init.create_lattice(lattice.sc(a=1.3), n=5);
+        dump.gsd(filename="test_checkpoint.gsd", group=group.all(), period=None, overwrite=True);
+        context.initialize();
+        option.set_autotuner_params(enable=False)
+
+    # set up the same forces and integrator as every job script of a restartable job
+    def setup_integrator(self, method):
+        nl = md.nlist.cell(deterministic=True);
+        lj = md.pair.lj(r_cut=2.5, nlist=nl);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        md.integrate.mode_standard(dt=0.005);
+        if method == 'nvt':
+            md.integrate.nvt(group=group.all(), kT=1.2, tau=0.5);
+        else:
+            md.integrate.langevin(group=group.all(), kT=1.2, seed=5, tally=True);
+
+    # run a simulation split at a checkpoint, and a restart of the checkpoint
+    def check_restart(self, method):
+        system = init.read_gsd(filename="test_checkpoint.gsd");
+        self.setup_integrator(method);
+        run(100);
+        ckp = dump.checkpoint(filename="test.ckp", period=None);
+        run(100);
+        snap_ref = system.take_snapshot();
+        del system, ckp
+        context.initialize();
+
+        system = init.read_gsd(filename="test_checkpoint.gsd", checkpoint="test.ckp");
+        self.assertEqual(get_step(), 100);
+        self.setup_integrator(method);
+        run(100);
+        snap = system.take_snapshot();
+
+        if comm.get_rank() == 0:
+            numpy.testing.assert_array_equal(snap.particles.position, snap_ref.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, snap_ref.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, snap_ref.particles.image);
+
+    def test_nvt(self):
+        self.check_restart('nvt');
+
+    def test_langevin(self):
+        self.check_restart('langevin');
+
+    # the system is unchanged when no checkpoint exists
+    def test_missing(self):
+        system = init.read_gsd(filename="test_checkpoint.gsd", checkpoint="missing.ckp");
+        self.assertEqual(get_step(), 0);
+        self.assert_(context.current.checkpoint_reader is None);
+
+    # write checkpoints at steps 100 and 200 and keep a copy of the files of the first one in test.ckp.old
+    def write_two_checkpoints(self):
+        fname = 'test.ckp.%d' % comm.get_rank();
+        system = init.read_gsd(filename="test_checkpoint.gsd");
+        self.setup_integrator('nvt');
+        run(100);
+        ckp = dump.checkpoint(filename="test.ckp", period=None);
+        shutil.copyfile(fname, fname + '.old');
+        run(100);
+        ckp.write();
+        del system, ckp
+        context.initialize();
+        comm.barrier_all();
+
+    # files of different checkpoints are not restored
+    def test_mixed_files(self):
+        if comm.get_num_ranks() == 1:
+            return;
+
+        self.write_two_checkpoints();
+        if comm.get_rank() == 1:
+            os.rename('test.ckp.1.old', 'test.ckp.1');
+        comm.barrier_all();
+
+        self.assertRaises(RuntimeError, init.read_gsd, filename="test_checkpoint.gsd", checkpoint="test.ckp");
+
+    # a checkpoint interrupted during the renames is completed when it is restored
+    def test_interrupted_commit(self):
+        if comm.get_num_ranks() == 1:
+            return;
+
+        self.write_two_checkpoints();
+        # rank 0 renamed its file, the other ranks still have the previous file and the temporary file
+        fname = 'test.ckp.%d' % comm.get_rank();
+        if comm.get_rank() > 0:
+            os.rename(fname, fname + '.tmp');
+            os.rename(fname + '.old', fname);
+        else:
+            with open('test.ckp.commit', 'w') as f:
+                f.write('200\n');
+        comm.barrier_all();
+
+        system = init.read_gsd(filename="test_checkpoint.gsd", checkpoint="test.ckp");
+        self.assertEqual(get_step(), 200);
+        self.assertFalse(os.path.exists(fname + '.tmp'));
+        if comm.get_rank() == 0:
+            self.assertFalse(os.path.exists('test.ckp.commit'));
+
+    def tearDown(self):
+        comm.barrier_all();
+        if comm.get_num_ranks() == 1:
+            fname = 'test.ckp';
+        else:
+            fname = 'test.ckp.%d' % comm.get_rank();
+        for f in [fname, fname + '.tmp', fname + '.old']:
+            if os.path.exists(f):
+                os.remove(f);
+        if comm.get_rank() == 0:
+            os.remove('test_checkpoint.gsd');
+            if os.path.exists('test.ckp.commit'):
+                os.remove('test.ckp.commit');
+        comm.barrier_all();
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,98 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import deprecated
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+
+# unit tests for md.integrate.mode_minimize_cg and md.integrate.mode_minimize_lbfgs
+class integrate_minimize_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.s = deprecated.init.create_random(N=200, phi_p=0.2);
+        self.nl = md.nlist.cell()
+        self.lj = md.pair.lj(r_cut=2.5, nlist=self.nl)
+        self.lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        self.lj.set_params(mode='shift')
+
+        context.current.sorter.set_params(grid=8)
+
+    # tests that the conjugate gradient minimizer converges
+    def test_cg(self):
+        all = group.all();
+        cg = md.integrate.mode_minimize_cg(group=all, max_step=0.05, ftol=1e-3, Etol=1e-8);
+        log = analyze.log(quantities=['potential_energy'], period=100, filename=None);
+        e_start = None
+        for i in range(50):
+            run(100);
+            if e_start is None:
+                e_start = log.query('potential_energy');
+            if cg.has_converged():
+                break;
+        self.assertTrue(cg.has_converged());
+        self.assertLessEqual(log.query('potential_energy'), e_start);
+
+    # tests that the L-BFGS minimizer converges
+    def test_lbfgs(self):
+        all = group.all();
+        lbfgs = md.integrate.mode_minimize_lbfgs(group=all, max_step=0.05, history=5, ftol=1e-3, Etol=1e-8);
+        for i in range(50):
+            run(100);
+            if lbfgs.has_converged():
+                break;
+        self.assertTrue(lbfgs.has_converged());
+
+        # a reset restarts the search, which converges again right away
+        lbfgs.reset();
+        self.assertFalse(lbfgs.has_converged());
+        run(100);
+        self.assertTrue(lbfgs.has_converged());
+
+    # tests that L-BFGS needs fewer force evaluations than FIRE
+    def test_compare_fire(self):
+        # FIRE does not run with domain decomposition
+        if comm.get_num_ranks() > 1:
+            return;
+
+        all = group.all();
+        snap = self.s.take_snapshot();
+
+        fire = md.integrate.mode_minimize_fire(group=all, dt=0.05, ftol=1e-3, Etol=1e-8);
+        n_fire = 0
+        while not fire.has_converged() and n_fire < 20000:
+            run(100);
+            n_fire += 100;
+
+        self.s.restore_snapshot(snap);
+        lbfgs = md.integrate.mode_minimize_lbfgs(group=all, max_step=0.05, ftol=1e-3, Etol=1e-8);
+        n_lbfgs = 0
+        while not lbfgs.has_converged() and n_lbfgs < 20000:
+            run(100);
+            n_lbfgs += 100;
+
+        self.assertTrue(lbfgs.has_converged());
+        self.assertLessEqual(n_lbfgs, n_fire);
+
+    # tests that a subset of the particles is minimized while the others stay fixed
+    def test_group(self):
+        half = group.tag_list(name='half', tags=range(100));
+        lbfgs = md.integrate.mode_minimize_lbfgs(group=half, max_step=0.05, ftol=1e-3, Etol=1e-8);
+        pos = [p.position for p in context.current.system.particles if p.tag >= 100]
+        run(100);
+        pos_after = [p.position for p in context.current.system.particles if p.tag >= 100]
+        self.assertEqual(pos, pos_after);
+
+    # tests that invalid parameters are rejected
+    def test_bad_params(self):
+        all = group.all();
+        self.assertRaises(RuntimeError, md.integrate.mode_minimize_cg, group=all, max_step=0);
+        self.assertRaises(RuntimeError, md.integrate.mode_minimize_lbfgs, group=all, max_step=0.1, history=0);
+
+    def tearDown(self):
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
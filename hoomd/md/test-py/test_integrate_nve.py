@@ -41,6 +41,20 @@ class integrate_nve_tests (unittest.TestCase):
         nve.set_params(limit=0.1);
         nve.set_params(zero_force=False);
 
+    # test accumulating the forces in the net force, with a pair force and a logged energy
+    def test_accumulate(self):
+        all = group.all();
+        nl = md.nlist.cell()
+        lj = md.pair.lj(r_cut=2.5, nlist=nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        mode = md.integrate.mode_standard(dt=0.005, accumulate=True);
+        md.integrate.nve(all);
+        log = analyze.log(quantities=['pair_lj_energy'], period=10, filename=None);
+        run(100);
+        self.assertEqual(len(lj.forces[0].force), 3);
+        mode.set_params(accumulate=False);
+        run(10);
+
     # test w/ empty group
     def test_empty(self):
         empty = group.cuboid(name="empty", xmin=-100, xmax=-100, ymin=-100, ymax=-100, zmin=-100, zmax=-100)
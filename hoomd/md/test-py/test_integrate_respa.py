@@ -0,0 +1,170 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import deprecated
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+import random
+
+# unit tests for multiple time step integration with md.integrate.mode_standard.set_respa
+class integrate_respa_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        deprecated.init.create_random(N=100, phi_p=0.05);
+        self.nl = md.nlist.cell()
+        self.lj = md.pair.lj(r_cut=2.5, nlist=self.nl)
+        self.lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.force.constant(fx=0.1, fy=0.1, fz=0.1)
+
+        context.current.sorter.set_params(grid=8)
+
+    # tests a run with a slow pair force
+    def test(self):
+        all = group.all();
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(all);
+        mode.set_respa(self.lj, stride=2);
+        log = analyze.log(quantities=['potential_energy', 'pair_lj_energy'], period=10, filename=None);
+        run(100);
+        self.assertEqual(mode.cpp_integrator.getForceStride(self.lj.cpp_force), 2);
+
+    # tests a run with the nvt thermostat and the accumulated net force
+    def test_nvt_accumulate(self):
+        all = group.all();
+        mode = md.integrate.mode_standard(dt=0.005, accumulate=True);
+        md.integrate.nvt(all, kT=1.2, tau=0.5);
+        mode.set_respa(self.lj, stride=3);
+        run(100);
+
+    # tests that a stride of 1 restores the standard integration
+    def test_reset(self):
+        all = group.all();
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(all);
+        mode.set_respa(self.lj, stride=2);
+        run(10);
+        mode.set_respa(self.lj, stride=1);
+        run(10);
+        self.assertEqual(mode.cpp_integrator.getForceStride(self.lj.cpp_force), 1);
+
+    # tests that invalid strides and arguments are rejected
+    def test_bad_stride(self):
+        all = group.all();
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(all);
+        self.assertRaises(RuntimeError, mode.set_respa, self.lj, 0);
+        self.assertRaises(RuntimeError, mode.set_respa, self.lj, 1.5);
+        self.assertRaises(RuntimeError, mode.set_respa, all, 2);
+
+    # tests that barostats are rejected
+    def test_npt(self):
+        all = group.all();
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.npt(all, kT=1.2, tau=0.5, P=1.0, tauP=0.5);
+        mode.set_respa(self.lj, stride=2);
+        self.assertRaises(RuntimeError, run, 1);
+
+    def tearDown(self):
+        context.initialize();
+
+# tests the forces applied on the inner and outer steps and the energy conservation with set_respa
+class integrate_respa_behavior_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.5), n=5);
+
+        # random velocities without net momentum
+        random.seed(4);
+        v = [(random.uniform(-2,2), random.uniform(-2,2), random.uniform(-2,2)) for i in range(len(self.system.particles))];
+        vcm = [sum(vi[d] for vi in v)/len(v) for d in range(3)];
+        for p in self.system.particles:
+            p.velocity = tuple(v[p.tag][d] - vcm[d] for d in range(3));
+
+        self.nl = md.nlist.cell()
+        self.lj = md.pair.lj(r_cut=2.5, nlist=self.nl)
+        self.lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        self.lj.set_params(mode='shift')
+
+    # tests that the slow force enters the net force scaled by its stride on the outer steps only
+    def test_net_force(self):
+        const = md.force.constant(fx=0.1, fy=-0.2, fz=0.3)
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+        mode.set_respa(const, stride=3);
+
+        self.n_checked = 0;
+        def check(timestep):
+            scale = 3.0 if timestep % 3 == 0 else 0.0;
+            for p in self.system.particles:
+                f = self.lj.forces[p.tag].force;
+                for d,fc in enumerate((0.1, -0.2, 0.3)):
+                    self.assertAlmostEqual(p.net_force[d] - f[d], scale*fc, 4);
+            self.n_checked += 1;
+
+        analyze.callback(check, period=1);
+        run(7);
+        self.assertEqual(self.n_checked, 7);
+
+    # tests that the overlapped interior pair forces are not computed between the outer steps
+    def test_comm_overlap(self):
+        self.lj.set_params(comm_overlap=True);
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+        mode.set_respa(self.lj, stride=2);
+
+        # the pair forces of the last outer step stay unchanged on the inner steps
+        self.outer_forces = None;
+        def check(timestep):
+            forces = [self.lj.forces[p.tag].force for p in self.system.particles];
+            if timestep % 2 == 0:
+                self.outer_forces = forces;
+            else:
+                self.assertEqual(forces, self.outer_forces);
+
+        analyze.callback(check, period=1);
+        run(10);
+
+    # runs nve with the pair force at the given stride and returns the largest deviation of the total energy
+    def energy_deviation(self, stride):
+        mode = md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+        mode.set_respa(self.lj, stride=stride);
+
+        # the potential energy includes the slow force on the outer steps only
+        log = analyze.log(quantities=['potential_energy', 'kinetic_energy'], period=stride, filename=None);
+        energies = [];
+        def record(timestep):
+            energies.append(log.query('potential_energy') + log.query('kinetic_energy'));
+
+        analyze.callback(record, period=stride);
+        run(2000);
+        return max(abs(e - energies[0]) for e in energies), abs(energies[0]);
+
+    # tests that the energy fluctuations at stride 2 are comparable to those of the standard integration
+    def test_energy(self):
+        dev_1, e_1 = self.energy_deviation(1);
+
+        # integrate the same initial state again with a slow pair force
+        del self.lj
+        del self.nl
+        del self.system
+        context.initialize();
+        self.setUp();
+        dev_2, e_2 = self.energy_deviation(2);
+
+        self.assertAlmostEqual(e_1, e_2, 6);
+        self.assertGreater(dev_2, 0);
+        self.assertLess(dev_2, 8*dev_1);
+        self.assertLess(dev_2, 0.02*e_1);
+
+    def tearDown(self):
+        del self.lj
+        del self.nl
+        del self.system
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -46,6 +46,32 @@ class nlist_cell_tests (unittest.TestCase):
     def test_tune(self):
         self.nl.tune(warmup=100, r_min=0.1, r_max=0.25, jumps=10, steps=50)
 
+    # test tuning r_buff at runtime
+    def test_set_buffer_tuning(self):
+        lj = md.pair.lj(r_cut = 2.5, nlist = self.nl)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005)
+        md.integrate.nve(group=group.all())
+
+        self.nl.set_params(r_buff=0.4, check_period=1)
+        self.nl.set_buffer_tuning(period=20, r_min=0.1, r_max=0.6)
+        run(200)
+
+        r_buff = self.nl.cpp_nlist.getRBuff()
+        self.assertGreaterEqual(r_buff, 0.1)
+        self.assertLessEqual(r_buff, 0.6)
+        self.assertGreaterEqual(self.nl.cpp_nlist.getEvery(), 1)
+
+        # disabling keeps the tuned values
+        self.nl.set_buffer_tuning(enable=False)
+        run(20)
+        self.assertEqual(self.nl.cpp_nlist.getRBuff(), r_buff)
+
+    # test set_buffer_tuning error messages
+    def test_set_buffer_tuning_nowork(self):
+        self.assertRaises(RuntimeError, self.nl.set_buffer_tuning, period=0)
+        self.assertRaises(RuntimeError, self.nl.set_buffer_tuning, r_min=0.5, r_max=0.2)
+
     # test multiple neighbor lists can coexist with different parameters
     def test_multi(self):
         self.nl.set_params(r_buff = 0.3)
@@ -70,6 +96,15 @@ class nlist_cell_tests (unittest.TestCase):
         self.assertAlmostEqual(self.nl.r_cut.get_pair('A','A'), 5.0)
         self.assertAlmostEqual(nl2.r_cut.get_pair('A','A'), 4.0)
 
+    # test the compact cell list layout
+    def test_compact(self):
+        nl2 = md.nlist.cell(compact=True)
+        lj = md.pair.lj(r_cut = 2.5, nlist = nl2)
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group.all());
+        run(10)
+
     def tearDown(self):
         del self.nl
         context.initialize();
@@ -0,0 +1,167 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import deprecated
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+
+# md.nlist.cluster testing
+class nlist_cluster_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.s = deprecated.init.create_random(N=1000, phi_p=0.2);
+
+        # directly create a neighbor list, it is not available on the GPU
+        try:
+            self.nl = md.nlist.cluster()
+        except RuntimeError:
+            self.nl = None
+
+        context.current.sorter.set_params(grid=8)
+
+    # test set_params
+    def test_set_params(self):
+        if self.nl is not None:
+            self.nl.set_params(r_buff=0.6);
+            self.nl.set_params(check_period = 20);
+            self.nl.set_params(d_max = 2.0, dist_check = False)
+
+    # test reset_exclusions
+    def test_reset_exclusions_works(self):
+        if self.nl is not None:
+            self.nl.reset_exclusions();
+            self.nl.reset_exclusions(exclusions = ['1-2']);
+            self.nl.reset_exclusions(exclusions = ['bond', 'angle']);
+
+    # test an invalid cluster size
+    def test_cluster_size_nowork(self):
+        if self.nl is not None:
+            self.assertRaises(RuntimeError, md.nlist.cluster, cluster_size = 6);
+
+    # test that the cluster pair kernel gives the same forces as the per-particle list
+    def test_forces(self):
+        if self.nl is None:
+            return
+
+        for cluster_size in [4, 8]:
+            nl_cluster = md.nlist.cluster(cluster_size = cluster_size)
+            nl_cell = md.nlist.cell()
+
+            lj_cluster = md.pair.lj(r_cut = 2.5, nlist = nl_cluster)
+            lj_cluster.pair_coeff.set('A', 'A', epsilon = 1.0, sigma = 1.0)
+            lj_cluster.set_params(mode = 'shift')
+            lj_cell = md.pair.lj(r_cut = 2.5, nlist = nl_cell)
+            lj_cell.pair_coeff.set('A', 'A', epsilon = 1.0, sigma = 1.0)
+            lj_cell.set_params(mode = 'shift')
+
+            md.integrate.mode_standard(dt = 0.0)
+            nve = md.integrate.nve(group = group.all())
+
+            lj_cell.disable()
+            run(1)
+            f_cluster = [(p.net_force, p.net_energy) for p in self.s.particles]
+
+            lj_cluster.disable()
+            lj_cell.enable()
+            run(1)
+            f_cell = [(p.net_force, p.net_energy) for p in self.s.particles]
+
+            # the pairs are summed in a different order, compare with a relative tolerance
+            for (fa, ea), (fb, eb) in zip(f_cluster, f_cell):
+                self.assertAlmostEqual(ea, eb, delta = 1e-4 * max(1.0, abs(eb)))
+                for k in range(3):
+                    self.assertAlmostEqual(fa[k], fb[k], delta = 1e-4 * max(1.0, abs(fb[k])))
+
+            nve.disable()
+            lj_cell.disable()
+            del lj_cluster
+            del lj_cell
+
+    # test multiple neighbor lists can coexist with different parameters
+    def test_multi(self):
+        if self.nl is not None:
+            self.nl.set_params(r_buff = 0.3)
+
+            nl2 = md.nlist.cluster(cluster_size = 8)
+            nl2.set_params(r_buff = 0.8)
+
+            self.assertAlmostEqual(self.nl.r_buff, 0.3)
+            self.assertAlmostEqual(nl2.r_buff, 0.8)
+
+            lj1 = md.pair.lj(r_cut = 2.0, nlist = self.nl)
+            lj2 = md.pair.lj(r_cut = 3.0, nlist = nl2)
+
+            # check that each neighbor list has the right cutoff
+            self.assertAlmostEqual(self.nl.r_cut.get_pair('A','A'), 2.0)
+            self.assertAlmostEqual(nl2.r_cut.get_pair('A','A'), 3.0)
+
+    def tearDown(self):
+        del self.nl
+        del self.s
+        context.initialize();
+
+# md.nlist.cluster in a dynamic simulation with particles crossing the boundaries and a changing box
+class nlist_cluster_dynamics_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.s = init.create_lattice(unitcell=lattice.sc(a=1.4), n=8);
+        for i,p in enumerate(self.s.particles):
+            p.velocity = (((i*7) % 11 - 5) * 0.3, ((i*5) % 13 - 6) * 0.25, ((i*3) % 7 - 3) * 0.5);
+
+        context.current.sorter.set_params(grid=8)
+
+    # compare the forces and energies of nlist.cluster and nlist.cell every step of an NPT run
+    def test_npt(self):
+        for cluster_size in [4, 8]:
+            try:
+                nl_cluster = md.nlist.cluster(cluster_size = cluster_size)
+            except RuntimeError:
+                return
+            nl_cell = md.nlist.cell()
+
+            # each potential contributes half of the interaction
+            lj_cluster = md.pair.lj(r_cut = 2.5, nlist = nl_cluster)
+            lj_cluster.pair_coeff.set('A', 'A', epsilon = 0.5, sigma = 1.0)
+            lj_cell = md.pair.lj(r_cut = 2.5, nlist = nl_cell)
+            lj_cell.pair_coeff.set('A', 'A', epsilon = 0.5, sigma = 1.0)
+
+            md.integrate.mode_standard(dt = 0.005)
+            npt = md.integrate.npt(group = group.all(), kT = 1.5, tau = 0.5, P = 2.0, tauP = 0.5)
+
+            errors = []
+            def compare(timestep):
+                err = 0.0
+                for fa, fb in zip(lj_cluster.forces, lj_cell.forces):
+                    err = max(err, abs(fa.energy - fb.energy) / max(1.0, abs(fb.energy)))
+                    for k in range(3):
+                        err = max(err, abs(fa.force[k] - fb.force[k]) / max(1.0, abs(fb.force[k])))
+                errors.append(err)
+            cb = analyze.callback(callback = compare, period = 1)
+
+            V0 = self.s.box.get_volume()
+            image0 = [p.image for p in self.s.particles]
+            run(500)
+
+            # particles crossed the boundaries and the box changed
+            self.assertGreater(sum(1 for p, i in zip(self.s.particles, image0) if p.image != i), 0)
+            self.assertGreater(abs(self.s.box.get_volume() - V0), 0.01 * V0)
+
+            self.assertEqual(len(errors), 500)
+            self.assertLess(max(errors), 1e-4)
+
+            cb.disable()
+            npt.disable()
+            lj_cluster.disable()
+            lj_cell.disable()
+            del lj_cluster
+            del lj_cell
+
+    def tearDown(self):
+        del self.s
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,74 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import md;
+context.initialize()
+import unittest
+import os
+import random
+
+# tests that the pair forces with comm_overlap match the blocking ghost update (MPI only)
+class pair_comm_overlap_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.5), n=10);
+
+        random.seed(11);
+        for p in self.system.particles:
+            p.velocity = (random.uniform(-2,2), random.uniform(-2,2), random.uniform(-2,2));
+
+        self.nl = md.nlist.cell()
+
+        # split the interaction in two halves that share the neighbor list
+        self.lj_on = md.pair.lj(r_cut=2.5, nlist=self.nl, name='on')
+        self.lj_on.pair_coeff.set('A', 'A', epsilon=0.5, sigma=1.0)
+        self.lj_on.set_params(comm_overlap=True)
+        self.lj_off = md.pair.lj(r_cut=2.5, nlist=self.nl, name='off')
+        self.lj_off.pair_coeff.set('A', 'A', epsilon=0.5, sigma=1.0)
+
+    def compare(self, timestep):
+        for p in self.system.particles:
+            f_on = self.lj_on.forces[p.tag];
+            f_off = self.lj_off.forces[p.tag];
+            for a,b in zip(f_on.force, f_off.force):
+                self.assertAlmostEqual(a, b, 5);
+            self.assertAlmostEqual(f_on.energy, f_off.energy, 5);
+        self.n_compared += 1;
+
+    # tests forces and energies with particles crossing the domain boundaries
+    def test_nve(self):
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+
+        self.n_compared = 0;
+        analyze.callback(self.compare, period=1);
+        run(50);
+
+        self.assertEqual(self.n_compared, 50);
+        self.assertGreater(self.nl.cpp_nlist.getNumUpdates(), 1);
+
+    # tests switching the overlap off and on again
+    def test_toggle(self):
+        md.integrate.mode_standard(dt=0.005);
+        md.integrate.nve(group=group.all());
+
+        self.n_compared = 0;
+        analyze.callback(self.compare, period=5);
+        run(20);
+        self.lj_on.set_params(comm_overlap=False);
+        run(20);
+        self.lj_on.set_params(comm_overlap=True);
+        run(20);
+
+        self.assertEqual(self.n_compared, 12);
+
+    def tearDown(self):
+        del self.lj_on
+        del self.lj_off
+        del self.nl
+        del self.system
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,221 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifdef ENABLE_MPI
+
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN()
+
+#include <iostream>
+
+#include <functional>
+#include <memory>
+
+#include "hoomd/md/LBFGSEnergyMinimizer.h"
+#include "hoomd/md/CGEnergyMinimizer.h"
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/CellList.h"
+#include "hoomd/Communicator.h"
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/extern/saruprng.h"
+
+#include <math.h>
+
+using namespace std;
+using namespace std::placeholders;
+
+/*! \file test_line_search_energy_minimizer_mpi.cc
+    \brief Tests the line search energy minimizers with domain decomposition
+    \ingroup unit_tests
+*/
+
+//! Typedef'd LineSearchEnergyMinimizer factory
+typedef std::function<std::shared_ptr<LineSearchEnergyMinimizer> (std::shared_ptr<SystemDefinition> sysdef,
+                                                                  std::shared_ptr<ParticleGroup> group)> minimizer_creator;
+
+//! Result of a minimization
+struct minimize_result
+    {
+    bool converged;             //!< whether the minimizer converged
+    Scalar energy;              //!< total energy at the minimum
+    unsigned int n_restarts;    //!< number of restarts caused by invalidated vectors
+    unsigned int n_builds;      //!< number of neighbor list builds
+    };
+
+//! Minimize the energy of a snapshot, with a domain decomposition if \a decompose is set
+minimize_result minimize(minimizer_creator creator, std::shared_ptr<ExecutionConfiguration> exec_conf,
+    std::shared_ptr<SnapshotSystemData<Scalar> > snap, bool decompose)
+    {
+    std::shared_ptr<DomainDecomposition> decomposition;
+    std::shared_ptr<SystemDefinition> sysdef;
+    if (decompose)
+        {
+        decomposition = std::shared_ptr<DomainDecomposition>(new DomainDecomposition(exec_conf,
+            snap->global_box.getL()));
+        sysdef = std::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf, decomposition));
+        }
+    else
+        sysdef = std::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    unsigned int N = snap->particle_data.size;
+    std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    std::shared_ptr<NeighborListBinned> nlist(new NeighborListBinned(sysdef, Scalar(2.5), Scalar(0.3), cl));
+    std::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+    lj->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+    lj->setRcut(0, 0, Scalar(2.5));
+    lj->setShiftMode(PotentialPairLJ::shift);
+
+    std::shared_ptr<LineSearchEnergyMinimizer> minimizer = creator(sysdef, group_all);
+    minimizer->setFtol(Scalar(1e-3));
+    minimizer->setEtol(Scalar(1e-8));
+    minimizer->addForceCompute(lj);
+
+    if (decompose)
+        {
+        std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+        cl->setCommunicator(comm);
+        nlist->setCommunicator(comm);
+        lj->setCommunicator(comm);
+        minimizer->setCommunicator(comm);
+        }
+
+    PDataFlags flags;
+    flags[pdata_flag::potential_energy] = 1;
+    pdata->setFlags(flags);
+
+    minimizer->prepRun(0);
+    for (unsigned int t = 0; t < 2000 && !minimizer->hasConverged(); t++)
+        minimizer->update(t);
+
+    minimize_result result;
+    result.converged = minimizer->hasConverged();
+    result.n_restarts = minimizer->getNumRestarts();
+    result.n_builds = nlist->getNumUpdates();
+
+    // the net force holds this rank's share of the energy
+    double energy = 0.0;
+        {
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            energy += h_net_force.data[i].w;
+        }
+    if (decompose)
+        MPI_Allreduce(MPI_IN_PLACE, &energy, 1, MPI_DOUBLE, MPI_SUM, exec_conf->getMPICommunicator());
+    result.energy = Scalar(energy);
+    return result;
+    }
+
+//! Relax a perturbed fcc crystal with and without domain decomposition
+/*! \param offset Offset of the lattice sites from the domain boundaries, in units of the lattice constant
+
+    The lattice sites lie 0.25 lattice constants away from the domain boundaries with \a offset = 0.25, so that the
+    particles relax without leaving their domain and the minimizer never restarts. With \a offset = 0, the sites lie on
+    the domain boundaries and the particles that cross them restart the minimization.
+*/
+void line_search_mpi_test(minimizer_creator creator, std::shared_ptr<ExecutionConfiguration> exec_conf,
+    std::shared_ptr<ExecutionConfiguration> exec_conf_serial, Scalar offset)
+    {
+    const unsigned int n = 8;
+    const Scalar a = Scalar(1.55);
+    const Scalar basis[4][3] = {{0, 0, 0}, {0.5, 0.5, 0}, {0.5, 0, 0.5}, {0, 0.5, 0.5}};
+
+    std::shared_ptr<SnapshotSystemData<Scalar> > snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(n*a);
+    snap->particle_data.resize(4*n*n*n);
+    snap->particle_data.type_mapping.push_back("A");
+
+    Saru rng(1, 2, 3);
+    unsigned int m = 0;
+    Scalar L = n*a;
+    for (unsigned int i = 0; i < n; i++)
+        for (unsigned int j = 0; j < n; j++)
+            for (unsigned int k = 0; k < n; k++)
+                for (unsigned int b = 0; b < 4; b++)
+                    {
+                    Scalar x = -L/Scalar(2.0) + (i + offset + basis[b][0])*a + rng.s<Scalar>(-0.15, 0.15);
+                    Scalar y = -L/Scalar(2.0) + (j + offset + basis[b][1])*a + rng.s<Scalar>(-0.15, 0.15);
+                    Scalar z = -L/Scalar(2.0) + (k + offset + basis[b][2])*a + rng.s<Scalar>(-0.15, 0.15);
+                    Scalar3 pos = make_scalar3(x, y, z);
+                    int3 img = make_int3(0, 0, 0);
+                    snap->global_box.wrap(pos, img);
+                    snap->particle_data.pos[m++] = vec3<Scalar>(pos);
+                    }
+
+    minimize_result result = minimize(creator, exec_conf, snap, true);
+    minimize_result result_serial = minimize(creator, exec_conf_serial, snap, false);
+
+    UP_ASSERT(result.converged);
+    UP_ASSERT(result_serial.converged);
+    MY_CHECK_CLOSE(result.energy, result_serial.energy, tol_small);
+    UP_ASSERT_EQUAL(result_serial.n_restarts, (unsigned int)0);
+
+    // the particles have been migrated while minimizing
+    UP_ASSERT(result.n_builds > 1);
+
+    if (offset > Scalar(0.0))
+        UP_ASSERT_EQUAL(result.n_restarts, (unsigned int)0);
+    else
+        UP_ASSERT(result.n_restarts > 0);
+    }
+
+//! LBFGSEnergyMinimizer creator
+std::shared_ptr<LineSearchEnergyMinimizer> lbfgs_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                         std::shared_ptr<ParticleGroup> group)
+    {
+    return std::shared_ptr<LineSearchEnergyMinimizer>(new LBFGSEnergyMinimizer(sysdef, group, Scalar(0.05), 5));
+    }
+
+//! CGEnergyMinimizer creator
+std::shared_ptr<LineSearchEnergyMinimizer> cg_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                      std::shared_ptr<ParticleGroup> group)
+    {
+    return std::shared_ptr<LineSearchEnergyMinimizer>(new CGEnergyMinimizer(sysdef, group, Scalar(0.05)));
+    }
+
+//! L-BFGS keeps its history while the particles stay on their rank
+UP_TEST( LBFGSEnergyMinimizer_mpi )
+    {
+    line_search_mpi_test(bind(lbfgs_creator, _1, _2),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        Scalar(0.25));
+    }
+
+//! L-BFGS restarts and converges when particles change their rank
+UP_TEST( LBFGSEnergyMinimizer_mpi_migrate )
+    {
+    line_search_mpi_test(bind(lbfgs_creator, _1, _2),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        Scalar(0.0));
+    }
+
+//! CG keeps its search direction while the particles stay on their rank
+UP_TEST( CGEnergyMinimizer_mpi )
+    {
+    line_search_mpi_test(bind(cg_creator, _1, _2),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        Scalar(0.25));
+    }
+
+//! CG restarts and converges when particles change their rank
+UP_TEST( CGEnergyMinimizer_mpi_migrate )
+    {
+    line_search_mpi_test(bind(cg_creator, _1, _2),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        Scalar(0.0));
+    }
+
+#endif //ENABLE_MPI
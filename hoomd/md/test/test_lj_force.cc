@@ -14,10 +14,17 @@
 #include "hoomd/md/AllPairPotentials.h"
 
 #include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListCluster.h"
 #include "hoomd/Initializers.h"
+#include "hoomd/extern/saruprng.h"
 
 #include <math.h>
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace std::placeholders;
 
@@ -531,6 +538,291 @@ void lj_force_shift_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionCo
     }
     }
 
+#ifdef ENABLE_OPENMP
+//! Test that the multithreaded CPU path matches the serial one and is reproducible
+void lj_force_thread_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 5000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // the half neighbor list exercises the per-thread third law buffers
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    nlist->setStorageMode(NeighborList::half);
+
+    std::shared_ptr<PotentialPairLJ> fc = lj_creator(sysdef, nlist);
+    fc->setRcut(0, 0, Scalar(3.0));
+    Scalar lj1 = Scalar(4.0) * pow(Scalar(1.2),Scalar(12.0));
+    Scalar lj2 = Scalar(0.45) * Scalar(4.0) * pow(Scalar(1.2),Scalar(6.0));
+    fc->setParams(0,0,make_scalar2(lj1,lj2));
+
+    int old_num_threads = omp_get_max_threads();
+    unsigned int pitch = fc->getVirialArray().getPitch();
+
+    // reference result on a single thread
+    omp_set_num_threads(1);
+    fc->compute(0);
+    std::vector<Scalar4> ref_force(N);
+    std::vector<Scalar> ref_virial(6*N);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            ref_force[i] = h_force.data[i];
+            for (unsigned int k = 0; k < 6; k++)
+                ref_virial[k*N+i] = h_virial.data[k*pitch+i];
+            }
+        }
+
+    // multithreaded result
+    omp_set_num_threads(4);
+    fc->compute(1);
+    std::vector<Scalar4> thread_force(N);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        // only the summation order differs, compare the average deviation
+        double deltaf2 = 0.0;
+        double deltav2 = 0.0;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            thread_force[i] = h_force.data[i];
+            deltaf2 += double(h_force.data[i].x - ref_force[i].x) * double(h_force.data[i].x - ref_force[i].x);
+            deltaf2 += double(h_force.data[i].y - ref_force[i].y) * double(h_force.data[i].y - ref_force[i].y);
+            deltaf2 += double(h_force.data[i].z - ref_force[i].z) * double(h_force.data[i].z - ref_force[i].z);
+            deltaf2 += double(h_force.data[i].w - ref_force[i].w) * double(h_force.data[i].w - ref_force[i].w);
+            for (unsigned int k = 0; k < 6; k++)
+                deltav2 += double(h_virial.data[k*pitch+i] - ref_virial[k*N+i])
+                           * double(h_virial.data[k*pitch+i] - ref_virial[k*N+i]);
+            }
+        CHECK_SMALL(deltaf2 / double(N), double(tol_small));
+        CHECK_SMALL(deltav2 / double(N), double(tol_small));
+        }
+
+    // a second threaded evaluation must reproduce the first one exactly
+    fc->compute(2);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            UP_ASSERT_EQUAL(h_force.data[i].x, thread_force[i].x);
+            UP_ASSERT_EQUAL(h_force.data[i].y, thread_force[i].y);
+            UP_ASSERT_EQUAL(h_force.data[i].z, thread_force[i].z);
+            UP_ASSERT_EQUAL(h_force.data[i].w, thread_force[i].w);
+            }
+        }
+
+    omp_set_num_threads(old_num_threads);
+    }
+#endif
+
+//! Test that accumulate() adds the forces to the net force and that the per-compute arrays are restored on request
+void lj_force_accumulate_test(ljforce_creator lj_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(3.0), Scalar(0.8)));
+    nlist->setStorageMode(NeighborList::half);
+
+    std::shared_ptr<PotentialPairLJ> fc = lj_creator(sysdef, nlist);
+    fc->setRcut(0, 0, Scalar(3.0));
+    Scalar lj1 = Scalar(4.0) * pow(Scalar(1.2),Scalar(12.0));
+    Scalar lj2 = Scalar(0.45) * Scalar(4.0) * pow(Scalar(1.2),Scalar(6.0));
+    fc->setParams(0,0,make_scalar2(lj1,lj2));
+    UP_ASSERT(fc->supportsAccumulate());
+
+    // reference result in the per-compute arrays
+    fc->compute(0);
+    unsigned int pitch = fc->getVirialArray().getPitch();
+    std::vector<Scalar4> ref_force(N);
+    std::vector<Scalar> ref_virial(6*N);
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            ref_force[i] = h_force.data[i];
+            for (unsigned int k = 0; k < 6; k++)
+                ref_virial[k*N+i] = h_virial.data[k*pitch+i];
+            }
+        }
+    Scalar ref_energy = fc->calcEnergySum();
+
+    // start from a non-zero net force to check that the forces are added
+    unsigned int net_pitch = pdata->getNetVirial().getPitch();
+        {
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial(pdata->getNetVirial(), access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            h_net_force.data[i] = make_scalar4(1.0, 2.0, 3.0, 4.0);
+            for (unsigned int k = 0; k < 6; k++)
+                h_net_virial.data[k*net_pitch+i] = Scalar(0.5);
+            }
+        }
+
+    fc->accumulate(1);
+
+        {
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(pdata->getNetVirial(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            MY_CHECK_CLOSE(h_net_force.data[i].x, ref_force[i].x + Scalar(1.0), tol);
+            MY_CHECK_CLOSE(h_net_force.data[i].y, ref_force[i].y + Scalar(2.0), tol);
+            MY_CHECK_CLOSE(h_net_force.data[i].z, ref_force[i].z + Scalar(3.0), tol);
+            MY_CHECK_CLOSE(h_net_force.data[i].w, ref_force[i].w + Scalar(4.0), tol);
+            for (unsigned int k = 0; k < 6; k++)
+                MY_CHECK_CLOSE(h_net_virial.data[k*net_pitch+i], ref_virial[k*N+i] + Scalar(0.5), tol);
+            }
+        }
+
+    // the per-compute arrays are recomputed when they are requested
+    MY_CHECK_CLOSE(fc->calcEnergySum(), ref_energy, tol);
+    Scalar3 f = fc->getForce(0);
+    unsigned int idx = pdata->getRTag(0);
+    MY_CHECK_CLOSE(f.x, ref_force[idx].x, tol);
+    MY_CHECK_CLOSE(f.y, ref_force[idx].y, tol);
+    MY_CHECK_CLOSE(f.z, ref_force[idx].z, tol);
+
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            MY_CHECK_CLOSE(h_force.data[i].w, ref_force[i].w, tol);
+        }
+    }
+
+//! Test the cluster pair kernel against the per-particle list while particles wrap and the box shrinks
+/*! \param cluster_size Number of particles per cluster
+    \param shift_mode Energy shift mode of both potentials
+    \param exec_conf Execution configuration
+
+    Two particle types with different cutoffs are used, and the B-B interaction has lj1 = 0 so that it is skipped.
+    With the XPLOR shift mode, the cluster pairs are evaluated one pair at a time instead of with the LJ kernel.
+*/
+void lj_force_cluster_dynamics_test(unsigned int cluster_size, PotentialPairLJ::energyShiftMode shift_mode,
+                                    std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // simple cubic lattice with random velocities
+    const unsigned int n = 8;
+    const unsigned int N = n*n*n;
+    const Scalar a = Scalar(1.4);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(n*a), 2, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::vector<Scalar3> vel(N);
+    Saru rng(1, 2, 3);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar3 r = make_scalar3(i % n, (i / n) % n, i / (n*n));
+            h_pos.data[i] = make_scalar4((r.x + Scalar(0.5)) * a - n*a/Scalar(2.0),
+                                         (r.y + Scalar(0.5)) * a - n*a/Scalar(2.0),
+                                         (r.z + Scalar(0.5)) * a - n*a/Scalar(2.0),
+                                         __int_as_scalar(i % 3 == 0 ? 1 : 0));
+            vel[i] = make_scalar3(rng.s<Scalar>(-1.5,1.5), rng.s<Scalar>(-1.5,1.5), rng.s<Scalar>(-1.5,1.5));
+            }
+        }
+
+    std::shared_ptr<NeighborListCluster> nlist_cluster(new NeighborListCluster(sysdef, Scalar(2.5), Scalar(0.4), cluster_size));
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    std::shared_ptr<NeighborListBinned> nlist_binned(new NeighborListBinned(sysdef, Scalar(2.5), Scalar(0.4), cl));
+
+    std::shared_ptr<PotentialPairLJ> fc_cluster(new PotentialPairLJ(sysdef, nlist_cluster));
+    std::shared_ptr<PotentialPairLJ> fc_binned(new PotentialPairLJ(sysdef, nlist_binned));
+    std::shared_ptr<PotentialPairLJ> fcs[2] = {fc_cluster, fc_binned};
+    for (unsigned int k = 0; k < 2; k++)
+        {
+        fcs[k]->setRcut(0, 0, Scalar(2.5));
+        fcs[k]->setRcut(0, 1, Scalar(2.0));
+        fcs[k]->setRcut(1, 1, Scalar(2.5));
+        fcs[k]->setRon(0, 0, Scalar(2.0));
+        fcs[k]->setRon(0, 1, Scalar(1.5));
+        fcs[k]->setRon(1, 1, Scalar(2.0));
+        fcs[k]->setParams(0,0,make_scalar2(Scalar(4.0),Scalar(4.0)));
+        fcs[k]->setParams(0,1,make_scalar2(Scalar(6.0),Scalar(3.0)));
+        fcs[k]->setParams(1,1,make_scalar2(Scalar(0.0),Scalar(2.0)));
+        fcs[k]->setShiftMode(shift_mode);
+        }
+
+    const Scalar dt = Scalar(0.005);
+    const Scalar scale = Scalar(0.99995);
+    unsigned int n_wrapped = 0;
+    unsigned int pitch = fc_binned->getVirialArray().getPitch();
+
+    for (unsigned int timestep = 0; timestep < 1000; timestep++)
+        {
+            {
+            // move the particles, then compress the box and the positions affinely
+            ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+            ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::readwrite);
+            const BoxDim& box = pdata->getGlobalBox();
+            for (unsigned int i = 0; i < N; i++)
+                {
+                h_pos.data[i].x += vel[i].x * dt;
+                h_pos.data[i].y += vel[i].y * dt;
+                h_pos.data[i].z += vel[i].z * dt;
+                int3 image = h_image.data[i];
+                box.wrap(h_pos.data[i], h_image.data[i]);
+                if (image.x != h_image.data[i].x || image.y != h_image.data[i].y || image.z != h_image.data[i].z)
+                    n_wrapped++;
+
+                h_pos.data[i].x *= scale;
+                h_pos.data[i].y *= scale;
+                h_pos.data[i].z *= scale;
+                }
+            }
+        pdata->setGlobalBox(BoxDim(pdata->getGlobalBox().getL() * scale));
+
+        fc_cluster->compute(timestep);
+        fc_binned->compute(timestep);
+
+        ArrayHandle<Scalar4> h_force_cluster(fc_cluster->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_cluster(fc_cluster->getVirialArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_force_binned(fc_binned->getForceArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_binned(fc_binned->getVirialArray(), access_location::host, access_mode::read);
+
+        // only the summation order differs
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const Scalar4 f = h_force_binned.data[i];
+            UP_ASSERT(fabs(h_force_cluster.data[i].x - f.x) <= tol_small * std::max(Scalar(1.0), Scalar(fabs(f.x))));
+            UP_ASSERT(fabs(h_force_cluster.data[i].y - f.y) <= tol_small * std::max(Scalar(1.0), Scalar(fabs(f.y))));
+            UP_ASSERT(fabs(h_force_cluster.data[i].z - f.z) <= tol_small * std::max(Scalar(1.0), Scalar(fabs(f.z))));
+            UP_ASSERT(fabs(h_force_cluster.data[i].w - f.w) <= tol_small * std::max(Scalar(1.0), Scalar(fabs(f.w))));
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                Scalar v = h_virial_binned.data[k*pitch+i];
+                UP_ASSERT(fabs(h_virial_cluster.data[k*pitch+i] - v) <= tol_small * std::max(Scalar(1.0), Scalar(fabs(v))));
+                }
+
+            // integrate with the reference forces (unit mass)
+            vel[i].x += f.x * dt;
+            vel[i].y += f.y * dt;
+            vel[i].z += f.z * dt;
+            }
+        }
+
+    // particles must have crossed the boundaries and the lists must have been rebuilt with the dynamics
+    UP_ASSERT(n_wrapped > N/4);
+    UP_ASSERT(nlist_cluster->getNumUpdates() > 10);
+    }
+
 //! LJForceCompute creator for unit tests
 std::shared_ptr<PotentialPairLJ> base_class_lj_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                   std::shared_ptr<NeighborList> nlist)
@@ -570,6 +862,46 @@ UP_TEST( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for accumulating into the net force on CPU
+UP_TEST( PotentialPairLJ_accumulate )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_accumulate_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the cluster pair kernel with 4 particle clusters in a dynamic simulation
+UP_TEST( PotentialPairLJ_cluster4_dynamics )
+    {
+    lj_force_cluster_dynamics_test(4, PotentialPairLJ::no_shift, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the cluster pair kernel with 8 particle clusters in a dynamic simulation
+UP_TEST( PotentialPairLJ_cluster8_dynamics )
+    {
+    lj_force_cluster_dynamics_test(8, PotentialPairLJ::no_shift, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the cluster pair kernel with a shifted energy
+UP_TEST( PotentialPairLJ_cluster4_shift )
+    {
+    lj_force_cluster_dynamics_test(4, PotentialPairLJ::shift, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the generic cluster pair evaluation with XPLOR smoothing
+UP_TEST( PotentialPairLJ_cluster8_xplor )
+    {
+    lj_force_cluster_dynamics_test(8, PotentialPairLJ::xplor, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_OPENMP
+//! test case for the multithreaded CPU path
+UP_TEST( PotentialPairLJ_threads )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_thread_test(lj_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+#endif
+
 # ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
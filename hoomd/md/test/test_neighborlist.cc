@@ -14,6 +14,7 @@
 #include "hoomd/md/NeighborListBinned.h"
 #include "hoomd/md/NeighborListStencil.h"
 #include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/NeighborListCluster.h"
 #include "hoomd/Initializers.h"
 
 #ifdef ENABLE_CUDA
@@ -935,6 +936,81 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! Collect the pairs in a neighbor list, in ascending order within each pair for half lists
+void neighborlist_collect_pairs(std::shared_ptr<NeighborList> nlist,
+                                unsigned int N,
+                                std::vector< std::pair<unsigned int, unsigned int> >& pairs)
+    {
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(), access_location::host, access_mode::read);
+
+    pairs.clear();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            unsigned int j = h_nlist.data[h_head_list.data[i] + k];
+            if (nlist->getStorageMode() == NeighborList::half)
+                {
+                UP_ASSERT(i < j);
+                }
+            pairs.push_back(std::make_pair(i, j));
+            }
+        }
+    sort(pairs.begin(), pairs.end());
+    }
+
+//! Test that a neighbor list is remapped, not rebuilt, after the particles are permuted
+template <class NL>
+void neighborlist_reorder_test(std::shared_ptr<ExecutionConfiguration> exec_conf, NeighborList::storageMode mode)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const unsigned int N = pdata->getN();
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    nlist->setRCutPair(0,0,3.0);
+    nlist->setStorageMode(mode);
+    for (unsigned int i=0; i < N-2; i++)
+        {
+        nlist->addExclusion(i,i+1);
+        nlist->addExclusion(i,i+2);
+        }
+    nlist->compute(0);
+    unsigned int n_updates = nlist->getNumUpdates();
+
+    // scramble the particles (7919 is coprime to N)
+    std::vector<unsigned int> order(N);
+    for (unsigned int i = 0; i < N; i++)
+        order[i] = (i * 7919) % N;
+    pdata->reorderParticles(order);
+
+    // the particles did not move, so the list is remapped and not rebuilt
+    nlist->compute(1);
+    UP_ASSERT_EQUAL(nlist->getNumUpdates(), n_updates);
+
+    // compare to a list built from the permuted particles
+    std::shared_ptr<NeighborList> nlist_ref(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    nlist_ref->setRCutPair(0,0,3.0);
+    nlist_ref->setStorageMode(mode);
+    for (unsigned int i=0; i < N-2; i++)
+        {
+        nlist_ref->addExclusion(i,i+1);
+        nlist_ref->addExclusion(i,i+2);
+        }
+    nlist_ref->compute(1);
+
+    std::vector< std::pair<unsigned int, unsigned int> > pairs, pairs_ref;
+    neighborlist_collect_pairs(nlist, N, pairs);
+    neighborlist_collect_pairs(nlist_ref, N, pairs_ref);
+    UP_ASSERT(pairs.size() > 0);
+    UP_ASSERT(pairs == pairs_ref);
+    }
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template <class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1218,6 +1294,66 @@ UP_TEST( NeighborListTree_comparison )
     neighborlist_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! reorder test case for binned class with a half list
+UP_TEST( NeighborListBinned_reorder_half )
+    {
+    neighborlist_reorder_test<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)), NeighborList::half);
+    }
+//! reorder test case for binned class with a full list
+UP_TEST( NeighborListBinned_reorder_full )
+    {
+    neighborlist_reorder_test<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)), NeighborList::full);
+    }
+
+///////////////
+// CLUSTER CPU
+///////////////
+//! basic test case for cluster class
+UP_TEST( NeighborListCluster_basic )
+    {
+    neighborlist_basic_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! exclusion test case for cluster class
+UP_TEST( NeighborListCluster_exclusion )
+    {
+    neighborlist_exclusion_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! large exclusion test case for cluster class
+UP_TEST( NeighborListCluster_large_ex )
+    {
+    neighborlist_large_ex_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! body filter test case for cluster class
+UP_TEST( NeighborListCluster_body_filter )
+    {
+    neighborlist_body_filter_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! diameter filter test case for cluster class
+UP_TEST( NeighborListCluster_diameter_shift )
+    {
+    neighborlist_diameter_shift_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! particle asymmetry test case for cluster class
+UP_TEST( NeighborListCluster_particle_asymm )
+    {
+    neighborlist_particle_asymm_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! cutoff exclusion test case for cluster class
+UP_TEST( NeighborListCluster_cutoff_exclude )
+    {
+    neighborlist_cutoff_exclude_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! type test case for cluster class
+UP_TEST( NeighborListCluster_type )
+    {
+    neighborlist_type_tests<NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! comparison test case for cluster class
+UP_TEST( NeighborListCluster_comparison )
+    {
+    neighborlist_comparison_test<NeighborListBinned, NeighborListCluster>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 ///////////////
 // BINNED GPU
@@ -18,6 +18,7 @@
 
 #include "hoomd/md/NeighborListTree.h"
 #include "hoomd/Initializers.h"
+#include "hoomd/extern/saruprng.h"
 
 #include <math.h>
 
@@ -199,6 +200,151 @@ void pppm_force_particle_test_triclinic(pppmforce_creator pppm_creator, std::sha
     }
 
 
+//! Compute the reciprocal space part of the Ewald sum directly
+/*! \param pdata Particle data with the charges
+    \param kappa Splitting parameter
+    \param kmax Maximum index of the reciprocal lattice vectors in each direction
+    \param force Forces on the particles (output)
+    \param virial Upper triangular virial tensor xx, xy, xz, yy, yz, zz (output)
+    \returns The reciprocal space energy minus the self energy, as reported by PPPMForceCompute
+
+    The system needs to be neutral.
+*/
+Scalar ewald_reciprocal_sum(std::shared_ptr<ParticleData> pdata, Scalar kappa, int kmax,
+    std::vector<Scalar3>& force, Scalar *virial)
+    {
+    const BoxDim& box = pdata->getGlobalBox();
+    const unsigned int N = pdata->getN();
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+    Scalar V = box.getVolume();
+    Scalar3 b1 = Scalar(2.0*M_PI)/V*make_scalar3(a2.y*a3.z-a2.z*a3.y, a2.z*a3.x-a2.x*a3.z, a2.x*a3.y-a2.y*a3.x);
+    Scalar3 b2 = Scalar(2.0*M_PI)/V*make_scalar3(a3.y*a1.z-a3.z*a1.y, a3.z*a1.x-a3.x*a1.z, a3.x*a1.y-a3.y*a1.x);
+    Scalar3 b3 = Scalar(2.0*M_PI)/V*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x);
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(pdata->getCharges(), access_location::host, access_mode::read);
+
+    force.assign(N, make_scalar3(0,0,0));
+    for (unsigned int i = 0; i < 6; i++)
+        virial[i] = Scalar(0.0);
+    Scalar energy(0.0);
+    Scalar q2(0.0);
+    for (unsigned int j = 0; j < N; j++)
+        q2 += h_charge.data[j]*h_charge.data[j];
+
+    std::vector<Scalar> c(N), s(N);
+    for (int l = -kmax; l <= kmax; l++)
+        for (int m = -kmax; m <= kmax; m++)
+            for (int n = -kmax; n <= kmax; n++)
+                {
+                if (l == 0 && m == 0 && n == 0)
+                    continue;
+
+                Scalar3 k = Scalar(l)*b1 + Scalar(m)*b2 + Scalar(n)*b3;
+                Scalar ksq = dot(k,k);
+
+                // structure factor
+                Scalar S_re(0.0), S_im(0.0);
+                for (unsigned int j = 0; j < N; j++)
+                    {
+                    Scalar kr = k.x*h_pos.data[j].x + k.y*h_pos.data[j].y + k.z*h_pos.data[j].z;
+                    c[j] = cos(kr);
+                    s[j] = sin(kr);
+                    S_re += h_charge.data[j]*c[j];
+                    S_im += h_charge.data[j]*s[j];
+                    }
+
+                Scalar A = Scalar(2.0*M_PI)/V*exp(-ksq/(Scalar(4.0)*kappa*kappa))/ksq;
+                Scalar E_k = A*(S_re*S_re + S_im*S_im);
+                energy += E_k;
+
+                Scalar f = Scalar(2.0)*(Scalar(1.0)/ksq + Scalar(1.0)/(Scalar(4.0)*kappa*kappa));
+                virial[0] += E_k*(Scalar(1.0) - f*k.x*k.x);
+                virial[1] -= E_k*f*k.x*k.y;
+                virial[2] -= E_k*f*k.x*k.z;
+                virial[3] += E_k*(Scalar(1.0) - f*k.y*k.y);
+                virial[4] -= E_k*f*k.y*k.z;
+                virial[5] += E_k*(Scalar(1.0) - f*k.z*k.z);
+
+                for (unsigned int j = 0; j < N; j++)
+                    {
+                    // Im(conj(S) exp(i k.r_j))
+                    Scalar im = S_re*s[j] - S_im*c[j];
+                    force[j] += Scalar(2.0)*A*h_charge.data[j]*im*k;
+                    }
+                }
+
+    return energy - q2*kappa/sqrt(M_PI);
+    }
+
+//! Compare PPPM with the direct Ewald sum for random charges
+/*! \param box Simulation box
+    \param Nx Number of grid points along the first lattice vector
+    \param Ny Number of grid points along the second lattice vector
+    \param Nz Number of grid points along the third lattice vector
+    \param tol Tolerance relative to the largest force component and the energy
+*/
+void pppm_force_ewald_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf,
+    const BoxDim& box, int Nx, int Ny, int Nz, Scalar tol)
+    {
+    const unsigned int N = 40;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, box, 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(1.0), Scalar(1.0)));
+    std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    // a neutral system of random charges
+    Saru rng(12, 34, 56);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(pdata->getCharges(), access_location::host, access_mode::readwrite);
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar3 f = make_scalar3(rng.s<Scalar>(), rng.s<Scalar>(), rng.s<Scalar>());
+            Scalar3 r = box.makeCoordinates(f);
+            h_pos.data[i] = make_scalar4(r.x, r.y, r.z, 0.0);
+            h_charge.data[i] = (i % 2) ? Scalar(-1.0) : Scalar(1.0);
+            }
+        }
+
+    std::shared_ptr<PPPMForceCompute> fc = pppm_creator(sysdef, nlist, group_all);
+
+    int order = 5;
+    Scalar kappa = 1.0;
+    Scalar rcut = 3.0;
+    fc->setParams(Nx, Ny, Nz, order, kappa, rcut);
+    fc->compute(0);
+
+    std::vector<Scalar3> force;
+    Scalar virial[6];
+    Scalar energy = ewald_reciprocal_sum(pdata, kappa, 12, force, virial);
+
+    Scalar fmax(0.0);
+    for (unsigned int i = 0; i < N; i++)
+        fmax = std::max(fmax, std::max(fabs(force[i].x), std::max(fabs(force[i].y), fabs(force[i].z))));
+    Scalar vmax(0.0);
+    for (unsigned int i = 0; i < 6; i++)
+        vmax = std::max(vmax, fabs(virial[i]));
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        MY_CHECK_SMALL(h_force.data[i].x - force[i].x, tol*fmax);
+        MY_CHECK_SMALL(h_force.data[i].y - force[i].y, tol*fmax);
+        MY_CHECK_SMALL(h_force.data[i].z - force[i].z, tol*fmax);
+        }
+
+    MY_CHECK_CLOSE(fc->getExternalEnergy(), energy, tol);
+    for (unsigned int i = 0; i < 6; i++)
+        MY_CHECK_SMALL(fc->getExternalVirial(i) - virial[i], tol*vmax);
+    }
+
 //! PPPMForceCompute creator for unit tests
 std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                      std::shared_ptr<NeighborList> nlist,
@@ -233,6 +379,31 @@ UP_TEST( PPPMForceCompute_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for odd mesh dimensions on CPU
+UP_TEST( PPPMForceCompute_ewald_odd )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_ewald_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        BoxDim(6.0, 10.0, 14.0), 15, 25, 35, 2e-3);
+    }
+
+//! test case for mesh dimensions that are not powers of two on CPU
+UP_TEST( PPPMForceCompute_ewald_npot )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_ewald_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        BoxDim(6.0, 10.0, 14.0), 12, 20, 28, 2e-3);
+    }
+
+//! test case for a triclinic box on CPU
+UP_TEST( PPPMForceCompute_ewald_triclinic )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    BoxDim box(8.0, 9.0, 10.0);
+    box.setTiltFactors(0.3, -0.2, 0.4);
+    pppm_force_ewald_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        box, 15, 18, 21, 2e-3);
+    }
 
 #ifdef ENABLE_CUDA
 //! test case for bond forces on the GPU
@@ -248,4 +419,27 @@ UP_TEST( PPPMForceComputeGPU_triclinic )
     pppm_force_particle_test_triclinic(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+UP_TEST( PPPMForceComputeGPU_ewald_odd )
+    {
+    pppmforce_creator pppm_creator = bind(gpu_pppm_creator, _1, _2, _3);
+    pppm_force_ewald_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)),
+        BoxDim(6.0, 10.0, 14.0), 15, 25, 35, 2e-3);
+    }
+
+UP_TEST( PPPMForceComputeGPU_ewald_npot )
+    {
+    pppmforce_creator pppm_creator = bind(gpu_pppm_creator, _1, _2, _3);
+    pppm_force_ewald_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)),
+        BoxDim(6.0, 10.0, 14.0), 12, 20, 28, 2e-3);
+    }
+
+UP_TEST( PPPMForceComputeGPU_ewald_triclinic )
+    {
+    pppmforce_creator pppm_creator = bind(gpu_pppm_creator, _1, _2, _3);
+    BoxDim box(8.0, 9.0, 10.0);
+    box.setTiltFactors(0.3, -0.2, 0.4);
+    pppm_force_ewald_test(pppm_creator, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)),
+        box, 15, 18, 21, 2e-3);
+    }
+
 #endif
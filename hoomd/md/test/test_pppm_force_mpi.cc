@@ -0,0 +1,198 @@
+// Copyright (c) 2009-2016 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+#ifdef ENABLE_MPI
+
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN()
+
+#include <iostream>
+
+#include <functional>
+#include <memory>
+
+#include "hoomd/md/PPPMForceCompute.h"
+#ifdef ENABLE_CUDA
+#include "hoomd/md/PPPMForceComputeGPU.h"
+#endif
+
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/Communicator.h"
+#include "hoomd/extern/saruprng.h"
+
+#include <math.h>
+
+using namespace std;
+using namespace std::placeholders;
+
+/*! \file test_pppm_force_mpi.cc
+    \brief Compares the distributed PPPMForceCompute against a single rank
+    \ingroup unit_tests
+*/
+
+//! Typedef'd PPPMForceCompute factory
+typedef std::function<std::shared_ptr<PPPMForceCompute> (std::shared_ptr<SystemDefinition> sysdef,
+                                                      std::shared_ptr<NeighborList> nlist,
+                                                      std::shared_ptr<ParticleGroup> group)> pppmforce_creator;
+
+//! Compare the forces, energy and virial of a domain decomposed system with those of a single rank
+/*! \param box Simulation box
+    \param Nx Number of grid points along the first lattice vector
+    \param Ny Number of grid points along the second lattice vector
+    \param Nz Number of grid points along the third lattice vector
+*/
+void pppm_force_mpi_test(pppmforce_creator pppm_creator, std::shared_ptr<ExecutionConfiguration> exec_conf,
+    std::shared_ptr<ExecutionConfiguration> exec_conf_serial, const BoxDim& box, int Nx, int Ny, int Nz)
+    {
+    const unsigned int N = 500;
+
+    // a neutral system of random charges, the same on every rank
+    SnapshotParticleData<Scalar> snap(N);
+    snap.type_mapping.push_back("A");
+
+    Saru rng(12, 34, 56);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 f = make_scalar3(rng.s<Scalar>(), rng.s<Scalar>(), rng.s<Scalar>());
+        snap.pos[i] = vec3<Scalar>(box.makeCoordinates(f));
+        snap.charge[i] = (i % 2) ? Scalar(-1.0) : Scalar(1.0);
+        }
+
+    // the domain decomposed system
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, box, 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, box.getL()));
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+    pdata->setFlags(~PDataFlags(0));
+
+    // the reference system on a single rank
+    std::shared_ptr<SystemDefinition> sysdef_serial(new SystemDefinition(N, box, 1, 0, 0, 0, 0, exec_conf_serial));
+    std::shared_ptr<ParticleData> pdata_serial = sysdef_serial->getParticleData();
+    pdata_serial->initializeFromSnapshot(snap);
+    pdata_serial->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(1.0), Scalar(1.0)));
+    std::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, N-1));
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::shared_ptr<NeighborListTree> nlist_serial(new NeighborListTree(sysdef_serial, Scalar(1.0), Scalar(1.0)));
+    std::shared_ptr<ParticleSelector> selector_all_serial(new ParticleSelectorTag(sysdef_serial, 0, N-1));
+    std::shared_ptr<ParticleGroup> group_all_serial(new ParticleGroup(sysdef_serial, selector_all_serial));
+
+    std::shared_ptr<PPPMForceCompute> fc = pppm_creator(sysdef, nlist, group_all);
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    nlist->setCommunicator(comm);
+    fc->setCommunicator(comm);
+    std::shared_ptr<PPPMForceCompute> fc_serial = pppm_creator(sysdef_serial, nlist_serial, group_all_serial);
+
+    int order = 5;
+    Scalar kappa = 1.0;
+    Scalar rcut = 3.0;
+    fc->setParams(Nx, Ny, Nz, order, kappa, rcut);
+    fc_serial->setParams(Nx, Ny, Nz, order, kappa, rcut);
+
+    fc->compute(0);
+    fc_serial->compute(0);
+
+    // the energy and the virial are stored as this rank's contribution
+    Scalar energy = fc->getExternalEnergy();
+    Scalar virial[6];
+    for (unsigned int i = 0; i < 6; i++)
+        virial[i] = fc->getExternalVirial(i);
+    MPI_Allreduce(MPI_IN_PLACE, &energy, 1, MPI_HOOMD_SCALAR, MPI_SUM, exec_conf->getMPICommunicator());
+    MPI_Allreduce(MPI_IN_PLACE, virial, 6, MPI_HOOMD_SCALAR, MPI_SUM, exec_conf->getMPICommunicator());
+
+    MY_CHECK_CLOSE(energy, fc_serial->getExternalEnergy(), tol_small);
+    for (unsigned int i = 0; i < 6; i++)
+        MY_CHECK_SMALL(virial[i] - fc_serial->getExternalVirial(i), tol_small);
+
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_serial(fc_serial->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag_serial(pdata_serial->getRTags(), access_location::host, access_mode::read);
+
+    unsigned int n_local = pdata->getN();
+    MPI_Allreduce(MPI_IN_PLACE, &n_local, 1, MPI_UNSIGNED, MPI_SUM, exec_conf->getMPICommunicator());
+    UP_ASSERT_EQUAL(n_local, N);
+
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        unsigned int j = h_rtag_serial.data[h_tag.data[i]];
+        MY_CHECK_SMALL(h_force.data[i].x - h_force_serial.data[j].x, tol_small);
+        MY_CHECK_SMALL(h_force.data[i].y - h_force_serial.data[j].y, tol_small);
+        MY_CHECK_SMALL(h_force.data[i].z - h_force_serial.data[j].z, tol_small);
+        }
+    }
+
+//! PPPMForceCompute creator for unit tests
+std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                     std::shared_ptr<NeighborList> nlist,
+                                                     std::shared_ptr<ParticleGroup> group)
+    {
+    return std::shared_ptr<PPPMForceCompute>(new PPPMForceCompute(sysdef, nlist, group));
+    }
+
+#ifdef ENABLE_CUDA
+//! PPPMForceComputeGPU creator for unit tests
+std::shared_ptr<PPPMForceCompute> gpu_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                              std::shared_ptr<NeighborList> nlist,
+                                              std::shared_ptr<ParticleGroup> group)
+    {
+    nlist->setStorageMode(NeighborList::full);
+    return std::shared_ptr<PPPMForceComputeGPU> (new PPPMForceComputeGPU(sysdef, nlist, group));
+    }
+#endif
+
+//! test case for an orthorhombic box on CPU
+UP_TEST( PPPMForceCompute_mpi )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    pppm_force_mpi_test(pppm_creator,
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        BoxDim(8.0, 10.0, 12.0), 16, 16, 32);
+    }
+
+//! test case for a triclinic box on CPU
+UP_TEST( PPPMForceCompute_mpi_triclinic )
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    BoxDim box(8.0, 9.0, 10.0);
+    box.setTiltFactors(0.3, -0.2, 0.4);
+    pppm_force_mpi_test(pppm_creator,
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        box, 16, 32, 32);
+    }
+
+#ifdef ENABLE_CUDA
+//! test case for an orthorhombic box on the GPU
+UP_TEST( PPPMForceComputeGPU_mpi )
+    {
+    pppmforce_creator pppm_creator = bind(gpu_pppm_creator, _1, _2, _3);
+    pppm_force_mpi_test(pppm_creator,
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        BoxDim(8.0, 10.0, 12.0), 16, 16, 32);
+    }
+
+//! test case for a triclinic box on the GPU
+UP_TEST( PPPMForceComputeGPU_mpi_triclinic )
+    {
+    pppmforce_creator pppm_creator = bind(gpu_pppm_creator, _1, _2, _3);
+    BoxDim box(8.0, 9.0, 10.0);
+    box.setTiltFactors(0.3, -0.2, 0.4);
+    pppm_force_mpi_test(pppm_creator,
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)),
+        std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU,
+            -1, false, false, std::shared_ptr<Messenger>(), 1)),
+        box, 16, 32, 32);
+    }
+#endif
+
+#endif //ENABLE_MPI
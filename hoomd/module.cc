@@ -26,6 +26,7 @@
 #include "DCDDumpWriter.h"
 #include "GetarDumpWriter.h"
 #include "GSDDumpWriter.h"
+#include "Checkpoint.h"
 #include "Logger.h"
 #include "CallbackAnalyzer.h"
 #include "Updater.h"
@@ -70,6 +71,11 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 /*! \file hoomd_module.cc
@@ -116,7 +122,11 @@ string get_hoomd_version()
 //! Layer for omp_get_num_procs()
 int get_num_procs()
     {
+    #ifdef ENABLE_OPENMP
+    return omp_get_num_procs();
+    #else
     return 1;
+    #endif
     }
 
 //! Get the hoomd version as a tuple
@@ -356,6 +366,7 @@ PYBIND11_PLUGIN(_hoomd)
     export_DCDDumpWriter(m);
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
+    export_Checkpoint(m);
     export_Logger(m);
     export_CallbackAnalyzer(m);
     export_ParticleGroup(m);
@@ -143,6 +143,16 @@ class gsd_write_tests (unittest.TestCase):
         if comm.get_rank() == 0:
             self.assertRaises(RuntimeError, init.read_gsd, 'test.gsd', frame=5);
 
+    # tests asynchronous writes
+    def test_async(self):
+        dump.gsd(filename="test.gsd", group=group.all(), period=1, overwrite=True, async_write=True);
+        run(5);
+
+        context.initialize();
+        init.read_gsd(filename='test.gsd', frame=4);
+        if comm.get_rank() == 0:
+            self.assertRaises(RuntimeError, init.read_gsd, 'test.gsd', frame=5);
+
     def tearDown(self):
         if comm.get_rank() == 0:
             os.remove('test.gsd');
@@ -0,0 +1,66 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+import hoomd
+import hoomd.md
+hoomd.context.initialize()
+import unittest
+import json
+import os
+import tempfile
+
+class run_profile_tests(unittest.TestCase):
+
+    def setUp(self):
+        sysdef = hoomd.init.create_lattice(unitcell=hoomd.lattice.sq(a=2.0),
+                                           n=[4,4]);
+
+        if hoomd.comm.get_rank() == 0:
+            tmp = tempfile.mkstemp(suffix='.json');
+            self.tmp_file = tmp[1];
+        else:
+            self.tmp_file = "invalid";
+
+    def test_json(self):
+        hoomd.run(10, profile_json=self.tmp_file);
+
+        if hoomd.comm.get_rank() == 0:
+            with open(self.tmp_file) as f:
+                data = json.load(f);
+            self.assertEqual(data['n_ranks'], hoomd.comm.get_num_ranks());
+            self.assertEqual(data['profile']['name'], 'Simulation');
+            time = data['profile']['time'];
+            self.assertLessEqual(time['min'], time['avg']);
+            self.assertLessEqual(time['avg'], time['max']);
+
+    def test_trace(self):
+        hoomd.run(10, profile_trace=self.tmp_file);
+
+        if hoomd.comm.get_rank() == 0:
+            with open(self.tmp_file) as f:
+                data = json.load(f);
+            pids = set([ev['pid'] for ev in data['traceEvents']]);
+            self.assertEqual(len(pids), hoomd.comm.get_num_ranks());
+
+    # only the most recent events are kept
+    def test_trace_limit(self):
+        hoomd.md.integrate.mode_standard(dt=0.005);
+        hoomd.md.integrate.nve(group=hoomd.group.all());
+        hoomd.run(10, profile_trace=self.tmp_file, profile_trace_limit=5);
+
+        if hoomd.comm.get_rank() == 0:
+            with open(self.tmp_file) as f:
+                data = json.load(f);
+            events = [ev for ev in data['traceEvents'] if ev['ph'] == 'X' and ev['pid'] == 0];
+            self.assertEqual(len(events), 5);
+            steps = [ev['args']['step'] for ev in events];
+            self.assertEqual(steps, sorted(steps));
+            self.assertEqual(steps[-1], 9);
+
+    def tearDown(self):
+        hoomd.context.initialize();
+        if hoomd.comm.get_rank() == 0:
+            os.remove(self.tmp_file);
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -4,6 +4,7 @@
 
 from hoomd import *
 from hoomd import deprecated
+from hoomd import md
 import hoomd;
 context.initialize()
 import unittest
@@ -28,6 +29,29 @@ class load_balance_tests (unittest.TestCase):
             lb = update.balance(x=False, y=False, z=False, tolerance=1.05, maxiter=2, period=4, phase=1)
             lb.set_params(x=True, y=True, z=True, tolerance=0.95, maxiter=1)
 
+    ## Test time weighted balancing during a run
+    def test_time_weight(self):
+        if comm.get_num_ranks() > 1:
+            lb = update.balance(period=10, weight='time', hysteresis=0.05)
+            self.assertTrue(lb.cpp_updater.getCostWeighted())
+            self.assertAlmostEqual(lb.cpp_updater.getHysteresis(), 0.05)
+
+            lj = md.pair.lj(r_cut=2.5, nlist=md.nlist.cell())
+            lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0)
+            md.integrate.mode_standard(dt=0.005)
+            md.integrate.nve(group=group.all())
+            run(50)
+
+            lb.set_params(weight='count')
+            self.assertFalse(lb.cpp_updater.getCostWeighted())
+
+    ## Test error checking of the parameters
+    def test_set_params_nowork(self):
+        if comm.get_num_ranks() > 1:
+            lb = update.balance()
+            self.assertRaises(RuntimeError, lb.set_params, weight='energy')
+            self.assertRaises(RuntimeError, lb.set_params, hysteresis=-1.0)
+
     def tearDown(self):
         if comm.get_num_ranks() > 1:
             context.initialize()
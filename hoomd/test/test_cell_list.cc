@@ -582,3 +582,92 @@ UP_TEST( CellListGPU_large )
     celllist_large_test<CellListGPU>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//! Validate the compact layout against the padded one for a system with a dense droplet
+void celllist_compact_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // half of the particles are packed in a small droplet, the others are spread over the box
+    unsigned int N = 2000;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N, BoxDim(20.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    for (unsigned int n = 0; n < N; n++)
+        {
+        unsigned int m = n/2;
+        if (n % 2 == 0)
+            {
+            h_pos.data[n].x = Scalar(-1.0) + Scalar(0.2)*Scalar(m % 10);
+            h_pos.data[n].y = Scalar(-1.0) + Scalar(0.2)*Scalar((m / 10) % 10);
+            h_pos.data[n].z = Scalar(-1.0) + Scalar(0.2)*Scalar(m / 100);
+            }
+        else
+            {
+            h_pos.data[n].x = Scalar(-9.9) + Scalar(1.9)*Scalar(m % 10);
+            h_pos.data[n].y = Scalar(-9.9) + Scalar(1.9)*Scalar((m / 10) % 10);
+            h_pos.data[n].z = Scalar(-9.9) + Scalar(1.9)*Scalar(m / 100);
+            }
+        }
+    }
+
+    std::shared_ptr<CellList> cl_padded(new CellList(sysdef));
+    cl_padded->setNominalWidth(Scalar(2.0));
+    cl_padded->setFlagIndex();
+    cl_padded->setComputeTDB(true);
+    cl_padded->compute(0);
+
+    std::shared_ptr<CellList> cl_compact(new CellList(sysdef));
+    cl_compact->setNominalWidth(Scalar(2.0));
+    cl_compact->setFlagIndex();
+    cl_compact->setComputeTDB(true);
+    cl_compact->setCompact(true);
+    cl_compact->compute(0);
+
+    UP_ASSERT(cl_compact->getCompact());
+    CHECK_EQUAL_UINT(cl_compact->getNmax(), cl_padded->getNmax());
+
+    // the compact arrays hold one element per particle, not one per slot
+    UP_ASSERT(cl_compact->getXYZFArray().getNumElements() < 2*N);
+    UP_ASSERT(cl_padded->getXYZFArray().getNumElements() > 10*N);
+
+    ArrayHandle<unsigned int> h_size_p(cl_padded->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_offset_p(cl_padded->getCellOffsetArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf_p(cl_padded->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_tdb_p(cl_padded->getTDBArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_size_c(cl_compact->getCellSizeArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_offset_c(cl_compact->getCellOffsetArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf_c(cl_compact->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_tdb_c(cl_compact->getTDBArray(), access_location::host, access_mode::read);
+
+    Index2D cli = cl_padded->getCellListIndexer();
+    unsigned int ncell = cl_padded->getCellIndexer().getNumElements();
+    CHECK_EQUAL_UINT(h_offset_c.data[ncell], N);
+
+    // both layouts list the same members in the same order
+    for (unsigned int cell = 0; cell < ncell; cell++)
+        {
+        CHECK_EQUAL_UINT(h_size_c.data[cell], h_size_p.data[cell]);
+        CHECK_EQUAL_UINT(h_offset_p.data[cell], cli(0, cell));
+        if (cell > 0)
+            CHECK_EQUAL_UINT(h_offset_c.data[cell], h_offset_c.data[cell-1] + h_size_c.data[cell-1]);
+
+        for (unsigned int offset = 0; offset < h_size_c.data[cell]; offset++)
+            {
+            const Scalar4& p = h_xyzf_p.data[cli(offset, cell)];
+            const Scalar4& c = h_xyzf_c.data[h_offset_c.data[cell] + offset];
+            CHECK_EQUAL_UINT(__scalar_as_int(c.w), __scalar_as_int(p.w));
+            MY_CHECK_CLOSE(c.x, p.x, tol);
+            MY_CHECK_CLOSE(c.y, p.y, tol);
+            MY_CHECK_CLOSE(c.z, p.z, tol);
+            MY_CHECK_CLOSE(h_tdb_c.data[h_offset_c.data[cell] + offset].y,
+                           h_tdb_p.data[cli(offset, cell)].y, tol);
+            }
+        }
+    }
+
+//! test case for the compact cell list layout
+UP_TEST( CellList_compact )
+    {
+    celllist_compact_test(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
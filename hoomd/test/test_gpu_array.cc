@@ -6,6 +6,7 @@
 #include "hoomd/ExecutionConfiguration.h"
 
 #include <iostream>
+#include <sstream>
 
 #include <memory>
 
@@ -89,6 +90,43 @@ UP_TEST( GPUArray_basic_tests )
 
     }
 
+//! test case for the memory accounting of GPUArray
+UP_TEST( GPUArray_memory_tracker_tests )
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<MemoryTracker> tracker = exec_conf->getMemoryTracker();
+    size_t base = tracker->getHostBytes();
+
+        {
+        GPUArray<int> a(100, exec_conf);
+        a.setTag("test::a");
+        UP_ASSERT_EQUAL(tracker->getHostBytes(), base + 100*sizeof(int));
+
+        // resizing replaces the allocation
+        a.resize(200);
+        UP_ASSERT_EQUAL(tracker->getHostBytes(), base + 200*sizeof(int));
+
+        // swapping into a temporary keeps the tag with the owner
+        GPUArray<int> tmp(50, exec_conf);
+        UP_ASSERT_EQUAL(tracker->getHostBytes(), base + 250*sizeof(int));
+        a.swap(tmp);
+        UP_ASSERT_EQUAL(a.getTag(), std::string("test::a"));
+        UP_ASSERT(tmp.getTag().empty());
+
+        std::ostringstream o;
+        tracker->writeBreakdown(o);
+        UP_ASSERT(o.str().find("test::a") != std::string::npos);
+        }
+
+    // all memory is released, but the peak remains
+    UP_ASSERT_EQUAL(tracker->getHostBytes(), base);
+    UP_ASSERT(tracker->getPeakHostBytes() >= base + 250*sizeof(int));
+    UP_ASSERT_EQUAL(tracker->getDeviceBytes(), (size_t)0);
+
+    tracker->resetPeak();
+    UP_ASSERT_EQUAL(tracker->getPeakHostBytes(), base);
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for testing device to/from host transfers
 UP_TEST( GPUArray_transfer_tests )
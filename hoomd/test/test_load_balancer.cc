@@ -359,6 +359,109 @@ void test_load_balancer_ghost(std::shared_ptr<ExecutionConfiguration> exec_conf,
     UP_ASSERT_EQUAL(pdata->getOwnerRank(7), di(1,0,1));
     }
 
+//! Load balancer with a fixed cost model for testing
+/*!
+ * Particles on ranks in the upper half of the box along z cost three times as much as the other particles.
+ */
+template<class LB>
+class CostLoadBalancer : public LB
+    {
+    public:
+        CostLoadBalancer(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<DomainDecomposition> decomposition)
+            : LB(sysdef, decomposition), m_decomposition(decomposition)
+            {
+            }
+
+    protected:
+        virtual double measureCost()
+            {
+            const double weight = (m_decomposition->getGridPos().z == 1) ? 3.0 : 1.0;
+            return weight * double(this->m_pdata->getN());
+            }
+
+    private:
+        std::shared_ptr<DomainDecomposition> m_decomposition;
+    };
+
+template<class LB>
+void test_load_balancer_cost(std::shared_ptr<ExecutionConfiguration> exec_conf, const BoxDim& dest_box)
+{
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    UP_ASSERT_EQUAL(size,8);
+
+    // create a system with two particles in each octant
+    BoxDim ref_box = BoxDim(2.0);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(16,          // number of particles
+                                                             dest_box,        // box dimensions
+                                                             1,           // number of particle types
+                                                             0,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    std::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+    for (unsigned int i=0; i < 8; ++i)
+        {
+        const Scalar x = (i & 1) ? Scalar(0.5) : Scalar(-0.5);
+        const Scalar y = (i & 2) ? Scalar(0.5) : Scalar(-0.5);
+        const Scalar z = (i & 4) ? Scalar(1.0) : Scalar(-1.0);
+        pdata->setPosition(2*i, TO_TRICLINIC(make_scalar3(x,y,Scalar(0.5)*z)),false);
+        pdata->setPosition(2*i+1, TO_TRICLINIC(make_scalar3(x,y,Scalar(0.75)*z)),false);
+        }
+
+    SnapshotParticleData<Scalar> snap(16);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition on processor with rank 0
+    std::vector<Scalar> fxs(1), fys(1), fzs(1);
+    fxs[0] = Scalar(0.5);
+    fys[0] = Scalar(0.5);
+    fzs[0] = Scalar(0.5);
+    std::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL(), fxs, fys, fzs));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    pdata->setDomainDecomposition(decomposition);
+
+    pdata->initializeFromSnapshot(snap);
+
+    std::shared_ptr<LoadBalancer> lb(new CostLoadBalancer<LB>(sysdef,decomposition));
+    lb->setCommunicator(comm);
+    comm->migrateParticles();
+    UP_ASSERT_EQUAL(pdata->getN(), 2);
+
+    // the particle count is balanced, so nothing happens without cost weighting
+    lb->update(0);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(2)[1], 0.5, tol);
+
+    // the cost imbalance of 1.5 is within the hysteresis
+    lb->setCostWeighted(true);
+    lb->setHysteresis(Scalar(1.0));
+    lb->update(1);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(2)[1], 0.5, tol);
+
+    // without hysteresis, the expensive upper half shrinks by the maximum of 5%
+    lb->setHysteresis(Scalar(0.0));
+    lb->update(2);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(0)[1], 0.5, tol);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(1)[1], 0.5, tol);
+    MY_CHECK_CLOSE(decomposition->getCumulativeFractions(2)[1], 0.525, tol);
+
+    // no particles changed domains
+    UP_ASSERT_EQUAL(pdata->getN(), 2);
+    }
+
+//! Tests particle redistribution with the cost weighted loads
+UP_TEST( LoadBalancer_test_cost)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    // cubic box
+    test_load_balancer_cost<LoadBalancer>(exec_conf, BoxDim(2.0));
+    // triclinic box 1
+    test_load_balancer_cost<LoadBalancer>(exec_conf, BoxDim(1.0,.1,.2,.3));
+    }
+
 //! Tests basic particle redistribution
 UP_TEST( LoadBalancer_test_basic)
     {
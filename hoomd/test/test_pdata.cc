@@ -617,6 +617,105 @@ UP_TEST( ParticleData_test )
     UP_ASSERT(pdata_type_test.getTypeByName("test") == 1);
     }
 
+//! Records the permutation handed to the subscribers of the particle sort signal
+class SortRecorder
+    {
+    public:
+        SortRecorder(ParticleData& pdata) : m_pdata(pdata), m_n_sorts(0)
+            {
+            }
+
+        void slotParticleSort()
+            {
+            m_n_sorts++;
+            m_order.clear();
+            m_inverse.clear();
+            if (m_pdata.getSortOrder())
+                {
+                m_order.assign(m_pdata.getSortOrder(), m_pdata.getSortOrder() + m_pdata.getN());
+                m_inverse.assign(m_pdata.getInverseSortOrder(), m_pdata.getInverseSortOrder() + m_pdata.getN());
+                }
+            }
+
+        ParticleData& m_pdata;
+        unsigned int m_n_sorts;
+        std::vector<unsigned int> m_order;
+        std::vector<unsigned int> m_inverse;
+    };
+
+//! Test that reorderParticles() permutes all registered per-particle arrays and hands out the permutation
+UP_TEST( ParticleData_reorder_test )
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    const unsigned int N = 5;
+    ParticleData pdata(N, box, 1, exec_conf);
+
+    // a per-particle array owned by another class, with two rows
+    GPUArray<unsigned int> extra(N, 2, exec_conf);
+    pdata.getParticleReorder().addArray(extra, 2);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(pdata.getCharges(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial(pdata.getNetVirial(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_extra(extra, access_location::host, access_mode::overwrite);
+        unsigned int virial_pitch = pdata.getNetVirial().getPitch();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            h_pos.data[i] = make_scalar4(Scalar(i), 0, 0, __int_as_scalar(0));
+            h_charge.data[i] = Scalar(10*i);
+            for (unsigned int j = 0; j < 6; j++)
+                h_net_virial.data[j*virial_pitch + i] = Scalar(100*j + i);
+            h_extra.data[i] = i;
+            h_extra.data[extra.getPitch() + i] = 1000 + i;
+            }
+        }
+
+    SortRecorder recorder(pdata);
+    pdata.getParticleSortSignal().connect<SortRecorder, &SortRecorder::slotParticleSort>(&recorder);
+
+    // a sort that is not a permutation does not hand out an order
+    pdata.notifyParticleSort();
+    UP_ASSERT_EQUAL(recorder.m_n_sorts, (unsigned int)1);
+    UP_ASSERT(recorder.m_order.empty());
+
+    unsigned int order_array[] = {3, 0, 4, 1, 2};
+    std::vector<unsigned int> order(order_array, order_array + N);
+    pdata.reorderParticles(order);
+
+    UP_ASSERT_EQUAL(recorder.m_n_sorts, (unsigned int)2);
+    UP_ASSERT(recorder.m_order == order);
+    UP_ASSERT(pdata.getSortOrder() == NULL);
+    UP_ASSERT(pdata.getInverseSortOrder() == NULL);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(pdata.getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(pdata.getNetVirial(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata.getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata.getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_extra(extra, access_location::host, access_mode::read);
+        unsigned int virial_pitch = pdata.getNetVirial().getPitch();
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int old_i = order[i];
+            UP_ASSERT_EQUAL(recorder.m_inverse[old_i], i);
+            MY_CHECK_CLOSE(h_pos.data[i].x, Scalar(old_i), tol);
+            MY_CHECK_CLOSE(h_charge.data[i], Scalar(10*old_i), tol);
+            for (unsigned int j = 0; j < 6; j++)
+                MY_CHECK_CLOSE(h_net_virial.data[j*virial_pitch + i], Scalar(100*j + old_i), tol);
+            UP_ASSERT_EQUAL(h_tag.data[i], old_i);
+            UP_ASSERT_EQUAL(h_rtag.data[old_i], i);
+            UP_ASSERT_EQUAL(h_extra.data[i], old_i);
+            UP_ASSERT_EQUAL(h_extra.data[extra.getPitch() + i], 1000 + old_i);
+            }
+        }
+
+    pdata.getParticleSortSignal().disconnect<SortRecorder, &SortRecorder::slotParticleSort>(&recorder);
+    pdata.getParticleReorder().removeArray(&extra);
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST( Random_test )
     {
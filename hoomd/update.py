@@ -376,6 +376,8 @@ class balance(_updater):
         maxiter (int): Maximum number of iterations to attempt in a single step.
         period (int): Balancing will be attempted every \a period time steps
         phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+        weight (str): Balance the particle count (``'count'``) or the measured force computation time (``'time'``).
+        hysteresis (float): Balancing starts only when the imbalance exceeds *tolerance* + *hysteresis*.
 
     Every *period* steps, the boundaries of the processor domains are adjusted to distribute the particle load close
     to evenly between them. The load imbalance is defined as the number of particles owned by a rank divided by the
@@ -416,9 +418,27 @@ class balance(_updater):
     either balance infrequently or to balance once in a short test run and then set the decomposition statically in a
     separate initialization.
 
+    When the cost per particle varies across the box (e.g., in interfacial systems or with rigid bodies), balancing the
+    particle count still leaves ranks idle. With *weight* = ``'time'``, each rank measures the wall clock time spent in
+    the force computes (including the neighbor list builds they trigger) since the last balancing step, and the load of
+    a rank becomes the number of particles it owns times its relative cost per particle:
+
+    .. math::
+
+        I = \frac{N(i) c(i)}{\sum_j N(j) c(j) / P}
+
+    where :math:`c(i)` is the time per particle on rank :math:`i` divided by the average time per particle, averaged
+    with its previous value to damp measurement noise. Time weighted balancing measures only the time the CPU spends
+    in the force computes, so it is not useful on the GPU.
+
+    Measured times fluctuate, so a balancing adjustment starts only when the maximum imbalance exceeds
+    *tolerance* + *hysteresis*. Once started, balancing continues on the following balancing steps until the imbalance
+    drops below *tolerance*. This hysteresis keeps the domain boundaries from oscillating. A *hysteresis* of about
+    0.05 is a good starting point with *weight* = ``'time'``.
+
     Balancing is ignored if there is no domain decomposition available (MPI is not built or is running on a single rank).
     """
-    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0):
+    def __init__(self, x=True, y=True, z=True, tolerance=1.02, maxiter=1, period=1000, phase=0, weight='count', hysteresis=0.0):
         hoomd.util.print_status_line();
 
         # initialize base class
@@ -438,16 +458,16 @@ class balance(_updater):
         self.setupUpdater(period,phase)
 
         # stash arguments to metadata
-        self.metadata_fields = ['tolerance','maxiter','period','phase']
+        self.metadata_fields = ['tolerance','maxiter','period','phase','weight','hysteresis']
         self.period = period
         self.phase = phase
 
         # configure the parameters
         hoomd.util.quiet_status()
-        self.set_params(x,y,z,tolerance, maxiter)
+        self.set_params(x,y,z,tolerance, maxiter, weight, hysteresis)
         hoomd.util.unquiet_status()
 
-    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None):
+    def set_params(self, x=None, y=None, z=None, tolerance=None, maxiter=None, weight=None, hysteresis=None):
         R""" Change load balancing parameters.
 
         Args:
@@ -456,12 +476,15 @@ class balance(_updater):
             z (bool): If True, balance in z dimension.
             tolerance (float): Load imbalance tolerance (if <= 1.0, balance every step).
             maxiter (int): Maximum number of iterations to attempt in a single step.
+            weight (str): Balance the particle count (``'count'``) or the measured force computation time (``'time'``).
+            hysteresis (float): Balancing starts only when the imbalance exceeds *tolerance* + *hysteresis*.
 
 
         Examples::
 
             balance.set_params(x=True, y=False)
             balance.set_params(tolerance=0.02, maxiter=5)
+            balance.set_params(weight='time', hysteresis=0.05)
         """
         hoomd.util.print_status_line()
         self.check_initialization()
@@ -478,6 +501,31 @@ class balance(_updater):
         if maxiter is not None:
             self.maxiter = maxiter
             self.cpp_updater.setMaxIterations(self.maxiter)
+        if weight is not None:
+            if weight not in ['count', 'time']:
+                hoomd.context.msg.error("update.balance: weight must be 'count' or 'time'\n")
+                raise RuntimeError('Error setting load balancer parameters')
+            if weight == 'time' and hoomd.context.exec_conf.isCUDAEnabled():
+                hoomd.context.msg.warning("update.balance: time weights do not include the GPU execution time\n")
+            self.weight = weight
+            self.cpp_updater.setCostWeighted(self.weight == 'time')
+            self.update_cost_computes()
+        if hysteresis is not None:
+            self.hysteresis = hysteresis
+            self.cpp_updater.setHysteresis(self.hysteresis)
+
+    ## \internal
+    # \brief Updates the force computes whose time is measured for time weighted balancing
+    # \details This method is triggered every time the run command is called
+    def update_cost_computes(self):
+        if self.cpp_updater is None:
+            return
+
+        self.cpp_updater.removeCostComputes()
+        if self.weight == 'time':
+            for f in hoomd.context.current.forces + hoomd.context.current.constraint_forces:
+                if f.enabled and f.cpp_force is not None:
+                    self.cpp_updater.addCostCompute(f.cpp_force)
 
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;